@@ -0,0 +1,345 @@
+#include "Log.h"
+#include "Streaming/DirtyTextureList.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+// ============================================================
+// DirtyListBench — tile map/unmap collection, full scan vs dirty list
+// ============================================================
+// Runs FeedbackManager::BeginFrame's collection step (Step 6) against a mock
+// tiled texture manager for --frames frames and times it two ways:
+//   scan  — ask every texture for tiles to unmap and map, as before the dirty list
+//   dirty — ask only the textures on the DirtyTextureList
+// Both runs see the same feedback (same seed): --changes textures per frame get
+// new requests and hysteresis timeouts, requests wait for heap tiles when the
+// heap is exhausted, and trimming frees standby tiles of resident textures.
+// Every frame the two runs must collect the same tiles in the same order, or
+// the benchmark fails.
+//
+// Only the collection step is timed; the O(1) MarkDirty calls are part of the
+// feedback and trimming work both runs share.  Without --changes it runs 4, 32
+// and 256 changes per frame.  With the default heap, 256 changes per frame
+// keep it exhausted: the dirty list is never cleared, most textures end up on
+// it and it only has to stay close to the full scan there.
+//
+//   DirtyListBench [options]
+//
+// No window, device or GPU: everything it links is HobbyRendererCore.
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint32_t kTilesPerTexture   = 256;
+    constexpr uint32_t kMaxTilesPerUpdate = 16;
+
+    struct Options
+    {
+        uint32_t              m_NumTextures     = 50000;
+        uint32_t              m_NumFrames       = 600;
+        uint32_t              m_NumHeapTiles    = 8192; // 512 MB of 64 KB tiles
+        uint32_t              m_Seed            = 1;
+        std::vector<uint32_t> m_ChangesPerFrame = { 4, 32, 256 };
+    };
+
+    struct CollectedTile
+    {
+        uint32_t m_Texture = 0;
+        uint32_t m_Tile    = 0;
+        bool     m_bUnmap  = false;
+
+        bool operator==(const CollectedTile&) const = default;
+    };
+
+    // ─── MockTileManager ──────────────────────────────────────────────────────
+    // TTM's per-texture tile lists behind GetTilesToUnmap()/GetTilesToMap().
+    // Textures are heap-allocated like FeedbackManager's, so a full scan pays
+    // for the pointer chase into every one of them.
+    class MockTileManager
+    {
+    public:
+        struct Texture
+        {
+            std::vector<uint32_t> m_Mapped;
+            std::vector<uint32_t> m_ToMap;   // allocated, not collected yet
+            std::vector<uint32_t> m_ToUnmap;
+            uint32_t              m_NumRequested = 0;
+            uint32_t              m_NextTile     = 0;
+        };
+
+        MockTileManager(uint32_t numTextures, uint32_t numHeapTiles)
+            : m_NumFreeHeapTiles(numHeapTiles)
+        {
+            m_Textures.reserve(numTextures);
+            for (uint32_t i = 0; i < numTextures; ++i)
+                m_Textures.push_back(std::make_unique<Texture>());
+        }
+
+        uint32_t GetNumTextures() const      { return (uint32_t)m_Textures.size(); }
+        uint32_t GetNumFreeHeapTiles() const { return m_NumFreeHeapTiles; }
+
+        // UpdateWithSamplerFeedback(): new requests
+        void Request(uint32_t textureIdx, uint32_t numTiles)
+        {
+            Texture& texture = *m_Textures[textureIdx];
+            if (texture.m_NumRequested == 0)
+                m_RequestQueue.push_back(textureIdx);
+            texture.m_NumRequested += numTiles;
+        }
+
+        // Hysteresis timeouts and trimming: the heap tiles come back right away
+        uint32_t Unmap(uint32_t textureIdx, uint32_t numTiles)
+        {
+            Texture& texture = *m_Textures[textureIdx];
+            numTiles = std::min(numTiles, (uint32_t)texture.m_Mapped.size());
+            for (uint32_t i = 0; i < numTiles; ++i)
+            {
+                texture.m_ToUnmap.push_back(texture.m_Mapped.back());
+                texture.m_Mapped.pop_back();
+            }
+            m_NumFreeHeapTiles += numTiles;
+            return numTiles;
+        }
+
+        // TrimStandbyTiles(): frees tiles of the longest-mapped textures first
+        bool TrimStandbyTiles(uint32_t numFreeTilesWanted)
+        {
+            bool bTrimmed = false;
+            while (m_NumFreeHeapTiles < numFreeTilesWanted && !m_MappedOrder.empty())
+            {
+                bTrimmed |= Unmap(m_MappedOrder.front(), kMaxTilesPerUpdate) > 0;
+                m_MappedOrder.pop_front();
+            }
+            return bTrimmed;
+        }
+
+        // Serves requests in order until the heap runs out
+        void AllocateRequestedTiles()
+        {
+            while (!m_RequestQueue.empty() && m_NumFreeHeapTiles > 0)
+            {
+                const uint32_t textureIdx = m_RequestQueue.front();
+                Texture& texture = *m_Textures[textureIdx];
+                const uint32_t numTiles = std::min(texture.m_NumRequested, m_NumFreeHeapTiles);
+                for (uint32_t i = 0; i < numTiles; ++i)
+                    texture.m_ToMap.push_back(texture.m_NextTile++ % kTilesPerTexture);
+                texture.m_NumRequested -= numTiles;
+                m_NumFreeHeapTiles -= numTiles;
+                m_MappedOrder.push_back(textureIdx);
+                if (texture.m_NumRequested == 0)
+                    m_RequestQueue.pop_front();
+            }
+        }
+
+        void GetTilesToUnmap(uint32_t textureIdx, std::vector<uint32_t>& outTiles)
+        {
+            Texture& texture = *m_Textures[textureIdx];
+            outTiles.insert(outTiles.end(), texture.m_ToUnmap.begin(), texture.m_ToUnmap.end());
+            texture.m_ToUnmap.clear();
+        }
+
+        void GetTilesToMap(uint32_t textureIdx, std::vector<uint32_t>& outTiles)
+        {
+            Texture& texture = *m_Textures[textureIdx];
+            outTiles.insert(outTiles.end(), texture.m_ToMap.begin(), texture.m_ToMap.end());
+            texture.m_Mapped.insert(texture.m_Mapped.end(), texture.m_ToMap.begin(), texture.m_ToMap.end());
+            texture.m_ToMap.clear();
+        }
+
+    private:
+        std::vector<std::unique_ptr<Texture>> m_Textures;
+        std::deque<uint32_t>                  m_RequestQueue;
+        std::deque<uint32_t>                  m_MappedOrder;
+        uint32_t                              m_NumFreeHeapTiles = 0;
+    };
+
+    // ─── Run ──────────────────────────────────────────────────────────────────
+    // One FeedbackManager's worth of state: the mock TTM, the dirty list and the
+    // collection scratch vectors
+    struct Run
+    {
+        MockTileManager              m_TileManager;
+        nvfeedback::DirtyTextureList m_DirtyTextures;
+        std::mt19937                 m_Rng;
+        const bool                   m_bUseDirtyList;
+
+        std::vector<uint32_t>        m_TilesToUnmap;
+        std::vector<uint32_t>        m_TilesToMap;
+        std::vector<CollectedTile>   m_Collected;
+        double                       m_CollectSeconds = 0.0;
+        uint64_t                     m_NumVisited     = 0;
+        uint64_t                     m_NumCollected   = 0;
+
+        Run(const Options& options, bool bUseDirtyList)
+            : m_TileManager(options.m_NumTextures, options.m_NumHeapTiles)
+            , m_Rng(options.m_Seed)
+            , m_bUseDirtyList(bUseDirtyList)
+        {
+            for (uint32_t i = 0; i < options.m_NumTextures; ++i)
+                m_DirtyTextures.AddTexture();
+        }
+
+        void Frame(uint32_t numChanges, uint32_t numHeapTiles)
+        {
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            std::uniform_int_distribution<uint32_t> textureDist(0, m_TileManager.GetNumTextures() - 1);
+            std::uniform_int_distribution<uint32_t> tileCountDist(1, kMaxTilesPerUpdate);
+
+            // Feedback (readback decoding) for the textures in view
+            for (uint32_t i = 0; i < numChanges; ++i)
+            {
+                const uint32_t textureIdx = textureDist(m_Rng);
+                if (unit(m_Rng) < 0.6f)
+                    m_TileManager.Request(textureIdx, tileCountDist(m_Rng));
+                if (unit(m_Rng) < 0.3f)
+                    m_TileManager.Unmap(textureIdx, tileCountDist(m_Rng));
+                m_DirtyTextures.MarkDirty(textureIdx);
+            }
+
+            // Standby trimming when the heap runs low
+            if (m_TileManager.GetNumFreeHeapTiles() < numHeapTiles / 16 && m_TileManager.TrimStandbyTiles(numHeapTiles / 8))
+                m_DirtyTextures.MarkResidentDirty();
+
+            m_TileManager.AllocateRequestedTiles();
+
+            // ── Step 6, timed ──
+            m_Collected.clear();
+            const Clock::time_point collectStart = Clock::now();
+            if (m_bUseDirtyList)
+            {
+                const std::span<const uint32_t> dirty = m_DirtyTextures.GetDirtyTextures();
+                m_NumVisited += dirty.size();
+                for (uint32_t textureIdx : dirty)
+                    Collect(textureIdx);
+                if (m_TileManager.GetNumFreeHeapTiles() > 0)
+                    m_DirtyTextures.Clear();
+            }
+            else
+            {
+                m_NumVisited += m_TileManager.GetNumTextures();
+                for (uint32_t textureIdx = 0; textureIdx < m_TileManager.GetNumTextures(); ++textureIdx)
+                    Collect(textureIdx);
+            }
+            m_CollectSeconds += std::chrono::duration<double>(Clock::now() - collectStart).count();
+            m_NumCollected += m_Collected.size();
+        }
+
+        void Collect(uint32_t textureIdx)
+        {
+            m_TilesToUnmap.clear();
+            m_TileManager.GetTilesToUnmap(textureIdx, m_TilesToUnmap);
+            if (!m_TilesToUnmap.empty())
+            {
+                for (uint32_t tile : m_TilesToUnmap)
+                    m_Collected.push_back({ textureIdx, tile, true });
+                m_DirtyTextures.OnTilesUnmapped(textureIdx, (uint32_t)m_TilesToUnmap.size());
+            }
+
+            m_TilesToMap.clear();
+            m_TileManager.GetTilesToMap(textureIdx, m_TilesToMap);
+            if (!m_TilesToMap.empty())
+            {
+                for (uint32_t tile : m_TilesToMap)
+                    m_Collected.push_back({ textureIdx, tile, false });
+                m_DirtyTextures.OnTilesAllocated(textureIdx, (uint32_t)m_TilesToMap.size());
+            }
+        }
+    };
+
+    void PrintUsage()
+    {
+        LOG_INFO("Usage: DirtyListBench [options]");
+        LOG_INFO("  --textures <n>             Streamed textures (default: 50000)");
+        LOG_INFO("  --frames <n>               Frames per run (default: 600)");
+        LOG_INFO("  --changes <n>              Textures with feedback per frame (default: 4, 32 and 256)");
+        LOG_INFO("  --heap-tiles <n>           Heap tiles shared by all textures (default: 8192)");
+        LOG_INFO("  --seed <n>                 Feedback seed (default: 1)");
+        LOG_INFO("  --help, -h                 Show this help message");
+    }
+
+    bool ParseCommandLine(int argc, char* argv[], Options& outOptions)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool bHasValue = (i + 1 < argc);
+
+            if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+            {
+                return false;
+            }
+            else if (std::strcmp(arg, "--textures") == 0 && bHasValue)
+            {
+                outOptions.m_NumTextures = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--frames") == 0 && bHasValue)
+            {
+                outOptions.m_NumFrames = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--changes") == 0 && bHasValue)
+            {
+                outOptions.m_ChangesPerFrame = { std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10)) };
+            }
+            else if (std::strcmp(arg, "--heap-tiles") == 0 && bHasValue)
+            {
+                outOptions.m_NumHeapTiles = std::max(16u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--seed") == 0 && bHasValue)
+            {
+                outOptions.m_Seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else
+            {
+                LOG_ERROR("[DirtyListBench] Unknown or incomplete argument: %s", arg);
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseCommandLine(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    LOG_INFO("[DirtyListBench] %u textures, %u heap tiles, %u frames per run",
+             options.m_NumTextures, options.m_NumHeapTiles, options.m_NumFrames);
+
+    for (uint32_t numChanges : options.m_ChangesPerFrame)
+    {
+        Run scan(options, false);
+        Run dirty(options, true);
+
+        for (uint32_t frame = 0; frame < options.m_NumFrames; ++frame)
+        {
+            scan.Frame(numChanges, options.m_NumHeapTiles);
+            dirty.Frame(numChanges, options.m_NumHeapTiles);
+            if (scan.m_Collected != dirty.m_Collected)
+            {
+                LOG_ERROR("[DirtyListBench] %u changes/frame, frame %u: the dirty list collected %zu tiles, the full scan %zu",
+                          numChanges, frame, dirty.m_Collected.size(), scan.m_Collected.size());
+                return 1;
+            }
+        }
+
+        const double scanMicroseconds  = scan.m_CollectSeconds * 1e6 / options.m_NumFrames;
+        const double dirtyMicroseconds = dirty.m_CollectSeconds * 1e6 / options.m_NumFrames;
+        LOG_INFO("[DirtyListBench] %3u changes/frame: scan %8.2f us/frame, dirty list %7.2f us/frame (%.1f textures visited), %.1fx; %llu tiles collected, identical",
+                 numChanges, scanMicroseconds, dirtyMicroseconds, (double)dirty.m_NumVisited / options.m_NumFrames,
+                 scanMicroseconds / std::max(dirtyMicroseconds, 1e-3), (unsigned long long)dirty.m_NumCollected);
+    }
+    return 0;
+}
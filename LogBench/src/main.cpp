@@ -0,0 +1,255 @@
+#include "Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================
+// LogBench — producer contention on the asynchronous logger
+// ============================================================
+// Runs --threads producers that each log --records records as fast as they can
+// and reports, for two loggers:
+//   async  — LOG_INFO into the per-thread rings of Log, drained by its sink thread
+//   locked — the same records formatted and written under one mutex on the
+//            calling thread (what SDL_Log and most simple loggers do)
+// the producer-side cost per record (percentiles of the logging call) and the
+// total throughput.  For the async logger it also reports the latency
+// from the call to the sink handing the line to the console output, and how
+// many records were dropped because a ring was full.
+//
+// Both loggers write to a counting console output, so the numbers are the
+// logger's own cost, not the terminal's; --file adds the async logger's log file.
+// The run fails if a record of the async logger is neither written nor counted
+// as dropped.
+//
+//   LogBench [options]
+//
+// No window, device or GPU: everything it links is HobbyRendererCore.
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Every call is timed on its own; 1 in kLatencySampleStride calls is kept
+    constexpr uint32_t kLatencySampleStride = 8;
+
+    struct Options
+    {
+        uint32_t    m_NumThreads = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+        uint32_t    m_NumRecords = 100000;
+        std::string m_FilePath;
+    };
+
+    struct BenchResult
+    {
+        double                m_Seconds = 0.0;     // first call to the last producer's return
+        std::vector<uint64_t> m_CallNanoseconds;   // sampled producer-side cost
+        uint64_t              m_NumRecords = 0;
+    };
+
+    // ─── Console output ───────────────────────────────────────────────────────
+    // Counts lines and, for async records, the call-to-output latency from the
+    // timestamp the producer put in the record.  Called by the sink thread (async)
+    // or under g_LockedMutex (locked), so one thread at a time.
+    struct OutputStats
+    {
+        uint64_t              m_NumLines   = 0;
+        uint64_t              m_NumDropped = 0;
+        std::vector<uint64_t> m_LatencyNanoseconds;
+    };
+    OutputStats g_Output;
+
+    uint64_t NowNanoseconds()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    void CountingConsoleOutput(Log::Level, const char* text)
+    {
+        unsigned long long submitted = 0;
+        unsigned int       dropped   = 0;
+        if (std::sscanf(text, "[Log] ring full, dropped %u", &dropped) == 1)
+        {
+            g_Output.m_NumDropped += dropped;
+            return;
+        }
+        g_Output.m_NumLines++;
+        if (std::sscanf(text, "[LogBench] t=%llu", &submitted) == 1 && g_Output.m_NumLines % kLatencySampleStride == 0)
+            g_Output.m_LatencyNanoseconds.push_back(NowNanoseconds() - submitted);
+    }
+
+    // ─── Locked baseline ──────────────────────────────────────────────────────
+    std::mutex g_LockedMutex;
+
+    void LockedWrite(const char* format, unsigned long long submitted, uint32_t thread, uint32_t record, double value)
+    {
+        std::lock_guard<std::mutex> lock(g_LockedMutex);
+        char text[256];
+        std::snprintf(text, sizeof(text), format, submitted, thread, record, value);
+        CountingConsoleOutput(Log::Level::Info, text);
+    }
+
+    void PrintUsage()
+    {
+        LOG_INFO("Usage: LogBench [options]");
+        LOG_INFO("  --threads <n>              Producer threads (default: hardware threads, 2 to 8)");
+        LOG_INFO("  --records <n>              Records per producer (default: 100000)");
+        LOG_INFO("  --file <path>              Also write the async logger's log file");
+        LOG_INFO("  --help, -h                 Show this help message");
+    }
+
+    bool ParseCommandLine(int argc, char* argv[], Options& outOptions)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool bHasValue = (i + 1 < argc);
+
+            if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+            {
+                return false;
+            }
+            else if (std::strcmp(arg, "--threads") == 0 && bHasValue)
+            {
+                outOptions.m_NumThreads = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--records") == 0 && bHasValue)
+            {
+                outOptions.m_NumRecords = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--file") == 0 && bHasValue)
+            {
+                outOptions.m_FilePath = argv[++i];
+            }
+            else
+            {
+                LOG_ERROR("[LogBench] Unknown or incomplete argument: %s", arg);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Starts every producer at once and times each call
+    BenchResult RunProducers(const Options& options, bool bAsync)
+    {
+        BenchResult result;
+        std::vector<std::vector<uint64_t>> samples(options.m_NumThreads);
+        std::atomic<uint32_t> numReady{ 0 };
+        std::atomic<bool>     bGo{ false };
+
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < options.m_NumThreads; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                std::vector<uint64_t>& threadSamples = samples[t];
+                threadSamples.reserve(options.m_NumRecords / kLatencySampleStride + 1);
+                numReady.fetch_add(1);
+                while (!bGo.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                for (uint32_t i = 0; i < options.m_NumRecords; ++i)
+                {
+                    const uint64_t begin = NowNanoseconds();
+                    if (bAsync)
+                        LOG_INFO("[LogBench] t=%llu thread %u record %u value %.3f", (unsigned long long)begin, t, i, i * 0.5);
+                    else
+                        LockedWrite("[LogBench] t=%llu thread %u record %u value %.3f", (unsigned long long)begin, t, i, i * 0.5);
+                    const uint64_t end = NowNanoseconds();
+                    if (i % kLatencySampleStride == 0)
+                        threadSamples.push_back(end - begin);
+                }
+            });
+        }
+
+        while (numReady.load() < options.m_NumThreads)
+            std::this_thread::yield();
+        const Clock::time_point start = Clock::now();
+        bGo.store(true, std::memory_order_release);
+        for (std::thread& thread : threads)
+            thread.join();
+        result.m_Seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        for (const std::vector<uint64_t>& threadSamples : samples)
+            result.m_CallNanoseconds.insert(result.m_CallNanoseconds.end(), threadSamples.begin(), threadSamples.end());
+        result.m_NumRecords = (uint64_t)options.m_NumThreads * options.m_NumRecords;
+        return result;
+    }
+
+    uint64_t Percentile(std::vector<uint64_t>& values, double fraction)
+    {
+        if (values.empty())
+            return 0;
+        const size_t index = std::min(values.size() - 1, (size_t)(fraction * (double)values.size()));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    void ReportCalls(const char* name, BenchResult& result)
+    {
+        LOG_INFO("[LogBench] %s: %llu records in %.3f s: %.2f M records/s; call p50 %llu ns, p99 %llu ns, p99.9 %llu ns, max %llu ns",
+                 name, (unsigned long long)result.m_NumRecords, result.m_Seconds,
+                 (double)result.m_NumRecords / std::max(result.m_Seconds, 1e-9) * 1e-6,
+                 (unsigned long long)Percentile(result.m_CallNanoseconds, 0.5),
+                 (unsigned long long)Percentile(result.m_CallNanoseconds, 0.99),
+                 (unsigned long long)Percentile(result.m_CallNanoseconds, 0.999),
+                 (unsigned long long)Percentile(result.m_CallNanoseconds, 1.0));
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseCommandLine(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    LOG_INFO("[LogBench] %u producer thread(s), %u records each, %u-byte rings%s%s",
+             options.m_NumThreads, options.m_NumRecords, Log::kRingBufferBytes,
+             options.m_FilePath.empty() ? "" : ", log file ", options.m_FilePath.c_str());
+
+    // Async: the console output only runs on the sink thread while the logger runs
+    Log::SetConsoleOutput(&CountingConsoleOutput);
+    Log::Initialize(options.m_FilePath);
+    BenchResult asyncResult = RunProducers(options, true);
+    const Clock::time_point drainStart = Clock::now();
+    Log::Shutdown();
+    const double drainSeconds = std::chrono::duration<double>(Clock::now() - drainStart).count();
+    Log::SetConsoleOutput(nullptr);
+    const OutputStats asyncOutput = std::move(g_Output);
+    g_Output = {};
+
+    BenchResult lockedResult = RunProducers(options, false);
+
+    ReportCalls("async ", asyncResult);
+    ReportCalls("locked", lockedResult);
+
+    std::vector<uint64_t> latencies = asyncOutput.m_LatencyNanoseconds;
+    LOG_INFO("[LogBench] async: %llu written, %llu dropped (%.2f%%), %.1f ms to drain at shutdown; call to output p50 %.3f ms, p99 %.3f ms, max %.3f ms",
+             (unsigned long long)asyncOutput.m_NumLines, (unsigned long long)asyncOutput.m_NumDropped,
+             (double)asyncOutput.m_NumDropped * 100.0 / (double)asyncResult.m_NumRecords, drainSeconds * 1e3,
+             Percentile(latencies, 0.5) * 1e-6, Percentile(latencies, 0.99) * 1e-6, Percentile(latencies, 1.0) * 1e-6);
+    // Dropped records are cheap to "log", so compare what reached the output too
+    const double asyncDelivered  = (double)asyncOutput.m_NumLines / std::max(asyncResult.m_Seconds + drainSeconds, 1e-9);
+    const double lockedDelivered = (double)lockedResult.m_NumRecords / std::max(lockedResult.m_Seconds, 1e-9);
+    LOG_INFO("[LogBench] async vs locked: %.2fx lower p99 call cost, %.2fx the delivered records/s (%.2f M vs %.2f M)",
+             (double)Percentile(lockedResult.m_CallNanoseconds, 0.99) / (double)std::max<uint64_t>(Percentile(asyncResult.m_CallNanoseconds, 0.99), 1),
+             asyncDelivered / std::max(lockedDelivered, 1e-9), asyncDelivered * 1e-6, lockedDelivered * 1e-6);
+
+    if (asyncOutput.m_NumLines + asyncOutput.m_NumDropped != asyncResult.m_NumRecords)
+    {
+        LOG_ERROR("[LogBench] %llu async records were neither written nor counted as dropped",
+                  (unsigned long long)(asyncResult.m_NumRecords - asyncOutput.m_NumLines - asyncOutput.m_NumDropped));
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include "Log.h"
+#include "Streaming/StreamingTrace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// ============================================================
+// StreamingSim — replays a streaming trace on the CPU
+// ============================================================
+// Runs nvfeedback::SimulateStreamingTrace on a trace recorded by the renderer
+// with --record-streaming-trace and logs residency hit rate and churn.  No
+// window, device or GPU: everything it links is HobbyRendererCore.
+//
+//   StreamingSim <trace.strace> [options]
+//
+// --scheduler compare replays the trace twice, with the TileScheduler's
+// priorities and in plain request order, and logs the hit-rate difference.
+
+namespace
+{
+    enum class SchedulerMode
+    {
+        Priority,
+        Fifo,
+        Compare,
+    };
+
+    struct Options
+    {
+        std::string                    m_TracePath;
+        nvfeedback::StreamingSimConfig m_SimConfig;
+        uint32_t                       m_TileCacheMB = 256;
+        SchedulerMode                  m_Scheduler   = SchedulerMode::Priority;
+    };
+
+    void PrintUsage()
+    {
+        LOG_INFO("Usage: StreamingSim <trace.strace> [options]");
+        LOG_INFO("  --heap-tiles <n>           Tiles per streaming heap (default: as recorded)");
+        LOG_INFO("  --fixed-budgets            Use the default streaming budgets instead of the recorded ones");
+        LOG_INFO("  --io-latency <frames>      Frames from tile submit to mapped (default: 1)");
+        LOG_INFO("  --io-tiles-per-frame <n>   Tile I/O bandwidth (default: 0 = unlimited)");
+        LOG_INFO("  --tile-cache-mb <n>        Host-memory tile cache (default: 256, 0 = disabled)");
+        LOG_INFO("  --scheduler <mode>         priority, fifo or compare (default: priority)");
+        LOG_INFO("  --help, -h                 Show this help message");
+    }
+
+    bool ParseCommandLine(int argc, char* argv[], Options& outOptions)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool bHasValue = (i + 1 < argc);
+
+            if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+            {
+                return false;
+            }
+            else if (std::strcmp(arg, "--fixed-budgets") == 0)
+            {
+                outOptions.m_SimConfig.m_bRecordedBudgets = false;
+            }
+            else if (std::strcmp(arg, "--heap-tiles") == 0 && bHasValue)
+            {
+                outOptions.m_SimConfig.m_HeapSizeInTiles = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else if (std::strcmp(arg, "--io-latency") == 0 && bHasValue)
+            {
+                outOptions.m_SimConfig.m_IOLatencyFrames = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--io-tiles-per-frame") == 0 && bHasValue)
+            {
+                outOptions.m_SimConfig.m_IOTilesPerFrame = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else if (std::strcmp(arg, "--tile-cache-mb") == 0 && bHasValue)
+            {
+                outOptions.m_TileCacheMB = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else if (std::strcmp(arg, "--scheduler") == 0 && bHasValue)
+            {
+                const char* mode = argv[++i];
+                if (std::strcmp(mode, "priority") == 0)     outOptions.m_Scheduler = SchedulerMode::Priority;
+                else if (std::strcmp(mode, "fifo") == 0)    outOptions.m_Scheduler = SchedulerMode::Fifo;
+                else if (std::strcmp(mode, "compare") == 0) outOptions.m_Scheduler = SchedulerMode::Compare;
+                else
+                {
+                    LOG_ERROR("[StreamingSim] Unknown scheduler '%s'", mode);
+                    return false;
+                }
+            }
+            else if (arg[0] != '-' && outOptions.m_TracePath.empty())
+            {
+                outOptions.m_TracePath = arg;
+            }
+            else
+            {
+                LOG_ERROR("[StreamingSim] Unknown or incomplete argument: %s", arg);
+                return false;
+            }
+        }
+
+        if (outOptions.m_TracePath.empty())
+        {
+            LOG_ERROR("[StreamingSim] No trace file given");
+            return false;
+        }
+
+        outOptions.m_SimConfig.m_TileCacheBytes = (uint64_t)outOptions.m_TileCacheMB * 1024 * 1024;
+        return true;
+    }
+
+    bool Simulate(const Options& options, bool bFifo, nvfeedback::StreamingSimStats& outStats)
+    {
+        nvfeedback::StreamingSimConfig simConfig = options.m_SimConfig;
+        simConfig.m_bFifoScheduling = bFifo;
+
+        LOG_INFO("[StreamingSim] Replaying '%s': %s scheduling, heap %u tiles, %s budgets, I/O latency %u frame(s), %u tiles/frame, tile cache %u MB",
+                 options.m_TracePath.c_str(), bFifo ? "FIFO" : "priority", simConfig.m_HeapSizeInTiles, simConfig.m_bRecordedBudgets ? "recorded" : "fixed",
+                 simConfig.m_IOLatencyFrames, simConfig.m_IOTilesPerFrame, options.m_TileCacheMB);
+
+        if (!nvfeedback::SimulateStreamingTrace(options.m_TracePath, simConfig, outStats))
+        {
+            LOG_ERROR("[StreamingSim] Simulation failed");
+            return false;
+        }
+
+        const nvfeedback::StreamingSimStats& stats = outStats;
+        LOG_INFO("[StreamingSim] %u frames, residency hit rate %.2f%% (%llu of %llu sampled regions)",
+                 stats.m_NumFrames, stats.GetHitRate() * 100.0,
+                 (unsigned long long)stats.m_RegionsResident, (unsigned long long)stats.m_RegionsSampled);
+        LOG_INFO("[StreamingSim] Tiles: %llu requested, %llu loaded (%llu recorded), %llu cancelled, %llu unmapped",
+                 (unsigned long long)stats.m_TilesRequested, (unsigned long long)stats.m_TilesLoaded,
+                 (unsigned long long)stats.m_RecordedTilesMapped, (unsigned long long)stats.m_TilesCancelled,
+                 (unsigned long long)stats.m_TilesUnmapped);
+        LOG_INFO("[StreamingSim] Reads: %.2f MB from disk, %.2f MB (%llu tiles) from the tile cache",
+                 (double)stats.m_BytesRead / (1024.0 * 1024.0), (double)stats.m_BytesFromCache / (1024.0 * 1024.0),
+                 (unsigned long long)stats.m_TilesFromCache);
+        LOG_INFO("[StreamingSim] Heaps: %u added, %u removed, peak %u, %llu tiles moved by defragmentation",
+                 stats.m_HeapsAdded, stats.m_HeapsRemoved, stats.m_PeakHeaps, (unsigned long long)stats.m_TilesMoved);
+        return true;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseCommandLine(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    nvfeedback::StreamingSimStats priorityStats;
+    nvfeedback::StreamingSimStats fifoStats;
+
+    if (options.m_Scheduler != SchedulerMode::Fifo && !Simulate(options, false, priorityStats))
+        return 1;
+    if (options.m_Scheduler != SchedulerMode::Priority && !Simulate(options, true, fifoStats))
+        return 1;
+
+    if (options.m_Scheduler == SchedulerMode::Compare)
+    {
+        LOG_INFO("[StreamingSim] Priority vs FIFO: hit rate %.2f%% vs %.2f%% (%+.2f points), %llu vs %llu tiles loaded",
+                 priorityStats.GetHitRate() * 100.0, fifoStats.GetHitRate() * 100.0,
+                 (priorityStats.GetHitRate() - fifoStats.GetHitRate()) * 100.0,
+                 (unsigned long long)priorityStats.m_TilesLoaded, (unsigned long long)fifoStats.m_TilesLoaded);
+    }
+    return 0;
+}
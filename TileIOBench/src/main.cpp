@@ -0,0 +1,640 @@
+#include "Log.h"
+#include "MemoryMappedDataReader.h"
+#include "Streaming/StreamingTrace.h"
+#include "Streaming/TileReadCoalescer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================
+// TileIOBench — tile source reads, mmap vs explicit reads
+// ============================================================
+// Reads the tiles of a tile trace out of generated texture files the way the
+// two AsyncTileIO source backends do, and logs throughput, read counts and read
+// amplification for each:
+//   mmap — one tile at a time, row memcpys out of the mapping (page faults)
+//   read — batches of --queue-depth tiles, rows coalesced by TileReadCoalescer
+//          into positional reads (--tile-io read)
+// Both backends copy every tile into a packed buffer; their checksums must match.
+//
+// The trace is either a .strace recorded with --record-streaming-trace (every
+// TilesMapped record, in order: the uploads the renderer actually made) or a
+// synthetic one (--synthetic: every standard tile of N square textures, in
+// clusters of up to 4x4 tiles the way feedback requests them).  The source
+// files are linear BC mip chains of random bytes with a DDS-sized header,
+// written to --dir on first use and reused while their size matches, so put
+// --dir on the storage under test (local NVMe, a network share, ...).
+//
+// Before each backend runs, the files' pages are dropped from the OS page cache
+// (MemoryMappedDataReader::DropCachedPages) so both start cold; --warm skips
+// that.  Windows has no unprivileged way to do it: there, runs on files that
+// were just written or read are warm, so use files larger than RAM or a fresh
+// boot for cold numbers.
+//
+//   TileIOBench (<trace.strace> | --synthetic <n>) --dir <path> [options]
+//
+// No window, device or GPU: everything it links is HobbyRendererCore.
+
+namespace
+{
+    // DDS header plus the DX10 extension: where the top mip starts in a BC7 .dds
+    constexpr size_t   kSourceHeaderBytes = 4 + 124 + 20;
+    // D3D12 standard tiles are 64 KB
+    constexpr uint32_t kTileBytes         = 64 * 1024;
+
+    enum class Backend
+    {
+        Mmap,
+        Read,
+        Both,
+    };
+
+    struct Options
+    {
+        std::string           m_TracePath;
+        std::filesystem::path m_Dir;
+        uint32_t              m_NumSyntheticTextures = 0;
+        uint32_t              m_TextureSize          = 4096;
+        uint32_t              m_BytesPerBlock        = 16;
+        uint32_t              m_NumThreads           = std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2)); // TaskScheduler's I/O lane
+        uint32_t              m_QueueDepth           = 32; // AsyncTileIO::kDefaultQueueDepth
+        uint32_t              m_MaxTiles             = 0;
+        uint32_t              m_Seed                 = 1;
+        Backend               m_Backend              = Backend::Both;
+        bool                  m_bWarm                = false;
+    };
+
+    // One texture of the trace and its source file
+    struct BenchTexture
+    {
+        nvfeedback::StreamingTraceTexture m_Desc;
+        uint32_t              m_BlockSize     = 4;
+        uint32_t              m_BytesPerBlock = 16;
+        std::vector<size_t>   m_MipOffsets;       // relative to the end of the header
+        std::vector<uint32_t> m_FirstTileOfMip;   // standard mips, plus the tile count at the end
+        size_t                m_DataSize      = 0;
+        std::filesystem::path m_Path;
+    };
+
+    struct BenchTile
+    {
+        uint32_t m_Texture = 0;
+        uint32_t m_Mip     = 0;
+        uint32_t m_X       = 0; // texels
+        uint32_t m_Y       = 0;
+        uint32_t m_Width   = 0; // clipped to the mip
+        uint32_t m_Height  = 0;
+    };
+
+    struct BenchResult
+    {
+        double   m_Seconds   = 0.0;
+        uint64_t m_NumReads  = 0; // mmap: row ranges copied
+        uint64_t m_ReadBytes = 0; // bytes read from the sources, gaps included
+        uint64_t m_TileBytes = 0;
+        uint64_t m_Checksum  = 0;
+    };
+
+    void PrintUsage()
+    {
+        LOG_INFO("Usage: TileIOBench (<trace.strace> | --synthetic <n>) --dir <path> [options]");
+        LOG_INFO("  --dir <path>               Where the source files are written and read (required)");
+        LOG_INFO("  --synthetic <n>            Read every tile of n synthetic textures instead of a trace");
+        LOG_INFO("  --texture-size <texels>    Synthetic texture width and height (default: 4096)");
+        LOG_INFO("  --bytes-per-block <8|16>   Synthetic texture format: BC1 or BC7 (default: 16)");
+        LOG_INFO("  --backend <mode>           mmap, read or both (default: both)");
+        LOG_INFO("  --threads <n>              I/O worker threads (default: as the renderer's I/O lane)");
+        LOG_INFO("  --queue-depth <n>          Tiles per explicit-read batch (default: 32)");
+        LOG_INFO("  --max-tiles <n>            Stop after n tiles (default: 0 = all)");
+        LOG_INFO("  --seed <n>                 Synthetic trace and file contents seed (default: 1)");
+        LOG_INFO("  --warm                     Leave the page cache alone between runs");
+        LOG_INFO("  --help, -h                 Show this help message");
+    }
+
+    bool ParseCommandLine(int argc, char* argv[], Options& outOptions)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool bHasValue = (i + 1 < argc);
+
+            if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+            {
+                return false;
+            }
+            else if (std::strcmp(arg, "--warm") == 0)
+            {
+                outOptions.m_bWarm = true;
+            }
+            else if (std::strcmp(arg, "--dir") == 0 && bHasValue)
+            {
+                outOptions.m_Dir = argv[++i];
+            }
+            else if (std::strcmp(arg, "--synthetic") == 0 && bHasValue)
+            {
+                outOptions.m_NumSyntheticTextures = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else if (std::strcmp(arg, "--texture-size") == 0 && bHasValue)
+            {
+                outOptions.m_TextureSize = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else if (std::strcmp(arg, "--bytes-per-block") == 0 && bHasValue)
+            {
+                outOptions.m_BytesPerBlock = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+                if (outOptions.m_BytesPerBlock != 8 && outOptions.m_BytesPerBlock != 16)
+                {
+                    LOG_ERROR("[TileIOBench] --bytes-per-block must be 8 or 16");
+                    return false;
+                }
+            }
+            else if (std::strcmp(arg, "--backend") == 0 && bHasValue)
+            {
+                const char* mode = argv[++i];
+                if (std::strcmp(mode, "mmap") == 0)      outOptions.m_Backend = Backend::Mmap;
+                else if (std::strcmp(mode, "read") == 0) outOptions.m_Backend = Backend::Read;
+                else if (std::strcmp(mode, "both") == 0) outOptions.m_Backend = Backend::Both;
+                else
+                {
+                    LOG_ERROR("[TileIOBench] Unknown backend '%s'", mode);
+                    return false;
+                }
+            }
+            else if (std::strcmp(arg, "--threads") == 0 && bHasValue)
+            {
+                outOptions.m_NumThreads = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--queue-depth") == 0 && bHasValue)
+            {
+                outOptions.m_QueueDepth = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--max-tiles") == 0 && bHasValue)
+            {
+                outOptions.m_MaxTiles = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else if (std::strcmp(arg, "--seed") == 0 && bHasValue)
+            {
+                outOptions.m_Seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else if (arg[0] != '-' && outOptions.m_TracePath.empty())
+            {
+                outOptions.m_TracePath = arg;
+            }
+            else
+            {
+                LOG_ERROR("[TileIOBench] Unknown or incomplete argument: %s", arg);
+                return false;
+            }
+        }
+
+        if (outOptions.m_TracePath.empty() == (outOptions.m_NumSyntheticTextures == 0))
+        {
+            LOG_ERROR("[TileIOBench] Give either a trace file or --synthetic <n>");
+            return false;
+        }
+        if (outOptions.m_NumSyntheticTextures > 0 && outOptions.m_TextureSize < (outOptions.m_BytesPerBlock == 8 ? 512u : 256u))
+        {
+            LOG_ERROR("[TileIOBench] --texture-size must be at least one tile");
+            return false;
+        }
+        if (outOptions.m_Dir.empty())
+        {
+            LOG_ERROR("[TileIOBench] No --dir given");
+            return false;
+        }
+        return true;
+    }
+
+    // Lays out the mip chain and standard tiles of desc.  The format is not
+    // recorded in traces: 64 KB tiles of 512x256 or 256x256 texels are BC1 or
+    // BC7, anything else is taken as uncompressed.
+    BenchTexture MakeBenchTexture(const nvfeedback::StreamingTraceTexture& desc)
+    {
+        BenchTexture texture;
+        texture.m_Desc = desc;
+
+        const uint32_t tileTexels = desc.m_TileWidthInTexels * desc.m_TileHeightInTexels;
+        const uint32_t bcBytesPerBlock = tileTexels ? kTileBytes * 16 / tileTexels : 0;
+        if (bcBytesPerBlock == 8 || bcBytesPerBlock == 16)
+        {
+            texture.m_BlockSize     = 4;
+            texture.m_BytesPerBlock = bcBytesPerBlock;
+        }
+        else
+        {
+            texture.m_BlockSize     = 1;
+            texture.m_BytesPerBlock = std::max(1u, tileTexels ? kTileBytes / tileTexels : 4u);
+        }
+
+        const uint32_t numMips = desc.m_NumStandardMips + desc.m_NumPackedMips;
+        for (uint32_t mip = 0; mip < numMips; ++mip)
+        {
+            const uint32_t mipWidth  = std::max(desc.m_Width >> mip, 1u);
+            const uint32_t mipHeight = std::max(desc.m_Height >> mip, 1u);
+            texture.m_MipOffsets.push_back(texture.m_DataSize);
+            texture.m_DataSize += (size_t)DivideAndRoundUp(mipWidth, texture.m_BlockSize) * DivideAndRoundUp(mipHeight, texture.m_BlockSize) * texture.m_BytesPerBlock;
+        }
+
+        uint32_t numTiles = 0;
+        for (uint32_t mip = 0; mip < desc.m_NumStandardMips; ++mip)
+        {
+            texture.m_FirstTileOfMip.push_back(numTiles);
+            numTiles += DivideAndRoundUp(std::max(desc.m_Width >> mip, 1u), desc.m_TileWidthInTexels) *
+                        DivideAndRoundUp(std::max(desc.m_Height >> mip, 1u), desc.m_TileHeightInTexels);
+        }
+        texture.m_FirstTileOfMip.push_back(numTiles);
+        return texture;
+    }
+
+    uint32_t GetNumStandardTiles(const BenchTexture& texture)
+    {
+        return texture.m_FirstTileOfMip.back();
+    }
+
+    // TTM tile index -> texel rectangle: standard mips in order, row-major tiles
+    bool GetBenchTile(const std::vector<BenchTexture>& textures, uint32_t textureIdx, uint32_t tileIndex, BenchTile& outTile)
+    {
+        const BenchTexture& texture = textures[textureIdx];
+        if (tileIndex >= GetNumStandardTiles(texture))
+            return false; // packed
+
+        uint32_t mip = 0;
+        while (tileIndex >= texture.m_FirstTileOfMip[mip + 1])
+            mip++;
+
+        const nvfeedback::StreamingTraceTexture& desc = texture.m_Desc;
+        const uint32_t mipWidth  = std::max(desc.m_Width >> mip, 1u);
+        const uint32_t mipHeight = std::max(desc.m_Height >> mip, 1u);
+        const uint32_t tilesX    = DivideAndRoundUp(mipWidth, desc.m_TileWidthInTexels);
+        const uint32_t index     = tileIndex - texture.m_FirstTileOfMip[mip];
+
+        outTile.m_Texture = textureIdx;
+        outTile.m_Mip     = mip;
+        outTile.m_X       = (index % tilesX) * desc.m_TileWidthInTexels;
+        outTile.m_Y       = (index / tilesX) * desc.m_TileHeightInTexels;
+        outTile.m_Width   = std::min(desc.m_TileWidthInTexels, mipWidth - outTile.m_X);
+        outTile.m_Height  = std::min(desc.m_TileHeightInTexels, mipHeight - outTile.m_Y);
+        return true;
+    }
+
+    // Every TilesMapped record, in order.  Removed textures keep their file; the
+    // indices of later ones shift down as in FeedbackManager.
+    bool LoadTraceTiles(const std::string& tracePath, std::vector<BenchTexture>& outTextures, std::vector<BenchTile>& outTiles)
+    {
+        nvfeedback::StreamingTraceReader reader;
+        if (!reader.Open(tracePath))
+        {
+            LOG_ERROR("[TileIOBench] Failed to open trace '%s'", tracePath.c_str());
+            return false;
+        }
+
+        std::vector<uint32_t> liveTextures; // trace index -> outTextures index
+        nvfeedback::StreamingTraceEvent event;
+        while (reader.Next(event))
+        {
+            switch (event.m_Type)
+            {
+            case nvfeedback::StreamingTraceRecord::AddTexture:
+                if (event.m_TextureIdx != liveTextures.size())
+                {
+                    LOG_ERROR("[TileIOBench] AddTexture index %u out of order (expected %zu)", event.m_TextureIdx, liveTextures.size());
+                    return false;
+                }
+                liveTextures.push_back((uint32_t)outTextures.size());
+                outTextures.push_back(MakeBenchTexture(event.m_Texture));
+                break;
+            case nvfeedback::StreamingTraceRecord::RemoveTexture:
+                if (event.m_TextureIdx < liveTextures.size())
+                    liveTextures.erase(liveTextures.begin() + event.m_TextureIdx);
+                break;
+            case nvfeedback::StreamingTraceRecord::TilesMapped:
+                if (event.m_TextureIdx >= liveTextures.size())
+                    break;
+                for (uint32_t tileIndex : event.m_TileIndices)
+                {
+                    BenchTile tile;
+                    if (GetBenchTile(outTextures, liveTextures[event.m_TextureIdx], tileIndex, tile))
+                        outTiles.push_back(tile);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (reader.HasError())
+        {
+            LOG_ERROR("[TileIOBench] Malformed trace '%s'", tracePath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Every standard tile of each texture once, requested in clusters of up to 4x4
+    // tiles of one mip at random textures and positions
+    void MakeSyntheticTiles(const Options& options, std::vector<BenchTexture>& outTextures, std::vector<BenchTile>& outTiles)
+    {
+        const uint32_t tileWidth = options.m_BytesPerBlock == 8 ? 512 : 256;
+
+        nvfeedback::StreamingTraceTexture desc;
+        desc.m_Width              = options.m_TextureSize;
+        desc.m_Height             = options.m_TextureSize;
+        desc.m_TileWidthInTexels  = tileWidth;
+        desc.m_TileHeightInTexels = 256;
+        uint32_t numMips = 1;
+        while ((options.m_TextureSize >> numMips) > 0)
+            numMips++;
+        while (desc.m_NumStandardMips < numMips && (options.m_TextureSize >> desc.m_NumStandardMips) >= tileWidth)
+            desc.m_NumStandardMips++;
+        desc.m_NumPackedMips = numMips - desc.m_NumStandardMips;
+
+        std::vector<std::vector<bool>> bRequested;
+        uint64_t numRemaining = 0;
+        for (uint32_t i = 0; i < options.m_NumSyntheticTextures; ++i)
+        {
+            outTextures.push_back(MakeBenchTexture(desc));
+            bRequested.emplace_back(GetNumStandardTiles(outTextures.back()), false);
+            numRemaining += bRequested.back().size();
+        }
+
+        std::mt19937 rng(options.m_Seed);
+        while (numRemaining > 0)
+        {
+            const uint32_t textureIdx = rng() % (uint32_t)outTextures.size();
+            const BenchTexture& texture = outTextures[textureIdx];
+            const uint32_t mip = rng() % desc.m_NumStandardMips;
+            const uint32_t tilesX = DivideAndRoundUp(std::max(desc.m_Width >> mip, 1u), desc.m_TileWidthInTexels);
+            const uint32_t tilesY = DivideAndRoundUp(std::max(desc.m_Height >> mip, 1u), desc.m_TileHeightInTexels);
+            const uint32_t clusterX = rng() % tilesX;
+            const uint32_t clusterY = rng() % tilesY;
+            const uint32_t clusterSize = 1 + rng() % 4;
+
+            for (uint32_t y = clusterY; y < std::min(clusterY + clusterSize, tilesY); ++y)
+            {
+                for (uint32_t x = clusterX; x < std::min(clusterX + clusterSize, tilesX); ++x)
+                {
+                    const uint32_t tileIndex = texture.m_FirstTileOfMip[mip] + y * tilesX + x;
+                    if (bRequested[textureIdx][tileIndex])
+                        continue;
+
+                    bRequested[textureIdx][tileIndex] = true;
+                    numRemaining--;
+                    BenchTile tile;
+                    GetBenchTile(outTextures, textureIdx, tileIndex, tile);
+                    outTiles.push_back(tile);
+                }
+            }
+        }
+    }
+
+    // Writes texture's source file unless one of the right size is already there
+    bool PrepareSourceFile(const std::filesystem::path& dir, uint32_t textureIdx, uint32_t seed, BenchTexture& texture, bool& outWritten)
+    {
+        const nvfeedback::StreamingTraceTexture& desc = texture.m_Desc;
+        texture.m_Path = dir / ("TileIOBench_" + std::to_string(textureIdx) + "_" + std::to_string(desc.m_Width) + "x" +
+                                std::to_string(desc.m_Height) + "_" + std::to_string(texture.m_BytesPerBlock) + ".bin");
+
+        const uintmax_t fileSize = kSourceHeaderBytes + texture.m_DataSize;
+        std::error_code ec;
+        outWritten = false;
+        if (std::filesystem::file_size(texture.m_Path, ec) == fileSize && !ec)
+            return true;
+
+        std::ofstream os(texture.m_Path, std::ios::binary | std::ios::trunc);
+        std::mt19937_64 rng(((uint64_t)seed << 32) | textureIdx);
+        std::vector<uint64_t> chunk(512 * 1024 / sizeof(uint64_t));
+        for (uintmax_t written = 0; written < fileSize && os;)
+        {
+            for (uint64_t& value : chunk)
+                value = rng();
+            const size_t size = (size_t)std::min<uintmax_t>(chunk.size() * sizeof(uint64_t), fileSize - written);
+            os.write(reinterpret_cast<const char*>(chunk.data()), (std::streamsize)size);
+            written += size;
+        }
+        if (!os)
+        {
+            LOG_ERROR("[TileIOBench] Failed to write '%s'", texture.m_Path.string().c_str());
+            return false;
+        }
+        outWritten = true;
+        return true;
+    }
+
+    nvfeedback::TileRowLayout GetBenchTileLayout(const BenchTexture& texture, const BenchTile& tile)
+    {
+        const uint32_t mipWidth = std::max(texture.m_Desc.m_Width >> tile.m_Mip, 1u);
+        return nvfeedback::GetLinearTileRowLayout(texture.m_MipOffsets[tile.m_Mip], mipWidth, tile.m_X, tile.m_Y,
+                                                  tile.m_Width, tile.m_Height, texture.m_BlockSize, texture.m_BytesPerBlock);
+    }
+
+    // FNV-1a; summed over tiles so that completion order does not matter
+    uint64_t HashTile(const uint8_t* data, size_t size)
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ data[i]) * 0x100000001b3ull;
+        return hash;
+    }
+
+    bool RunBackend(const Options& options, bool bExplicitReads, const std::vector<BenchTexture>& textures,
+                    const std::vector<BenchTile>& tiles, BenchResult& outResult)
+    {
+        std::vector<std::unique_ptr<MemoryMappedDataReader>> sources;
+        bool bCold = !options.m_bWarm;
+        for (const BenchTexture& texture : textures)
+        {
+            sources.push_back(std::make_unique<MemoryMappedDataReader>(texture.m_Path.string(), MemoryMappedDataReader::AccessHint::Random));
+            if (!sources.back()->IsValid())
+                return false;
+            sources.back()->SetOffset(kSourceHeaderBytes);
+            if (!options.m_bWarm && !sources.back()->DropCachedPages())
+                bCold = false;
+        }
+        if (!options.m_bWarm && !bCold)
+            LOG_WARN("[TileIOBench] Could not drop the page cache on this platform: cached pages make this run (partly) warm");
+
+        std::atomic<size_t>   nextTile{ 0 };
+        std::atomic<uint64_t> numReads{ 0 };
+        std::atomic<uint64_t> readBytes{ 0 };
+        std::atomic<uint64_t> tileBytes{ 0 };
+        std::atomic<uint64_t> checksum{ 0 };
+        const uint32_t batchSize = bExplicitReads ? options.m_QueueDepth : 1u;
+
+        auto worker = [&]()
+        {
+            std::vector<uint8_t> dst((size_t)batchSize * kTileBytes);
+            std::vector<uint32_t> dstSizes(batchSize);
+            std::vector<nvfeedback::TileReadSpan> spans;
+            std::vector<nvfeedback::TileRead> reads;
+            std::vector<uint8_t> readBuffer;
+            uint64_t workerReads = 0, workerReadBytes = 0, workerTileBytes = 0, workerChecksum = 0;
+
+            for (;;)
+            {
+                const size_t first = nextTile.fetch_add(batchSize, std::memory_order_relaxed);
+                if (first >= tiles.size())
+                    break;
+                const uint32_t count = (uint32_t)std::min<size_t>(batchSize, tiles.size() - first);
+
+                spans.clear();
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const BenchTile& tile = tiles[first + i];
+                    const MemoryMappedDataReader* source = sources[tile.m_Texture].get();
+                    const nvfeedback::TileRowLayout layout = GetBenchTileLayout(textures[tile.m_Texture], tile);
+                    dstSizes[i] = layout.m_RowBytes * layout.m_NumRows;
+
+                    if (bExplicitReads)
+                    {
+                        nvfeedback::AppendTileReadSpans(source, layout, layout.m_RowBytes, i, spans);
+                        continue;
+                    }
+
+                    // As AsyncTileIO::ProcessBatchMapped
+                    const uint8_t* src = static_cast<const uint8_t*>(source->GetData()) + layout.m_FirstRowOffset;
+                    uint8_t* tileDst = dst.data() + (size_t)i * kTileBytes;
+                    for (uint32_t row = 0; row < layout.m_NumRows; ++row)
+                        memcpy(tileDst + (size_t)row * layout.m_RowBytes, src + (size_t)row * layout.m_RowPitch, layout.m_RowBytes);
+                    workerReads     += (layout.m_RowPitch == layout.m_RowBytes) ? 1 : layout.m_NumRows;
+                    workerReadBytes += dstSizes[i];
+                }
+
+                // As AsyncTileIO::ProcessBatchExplicit
+                if (bExplicitReads)
+                {
+                    nvfeedback::CoalesceTileReads(spans, nvfeedback::kTileReadMaxGapBytes, nvfeedback::kTileReadMaxBytes, reads);
+                    for (const nvfeedback::TileRead& read : reads)
+                    {
+                        if (readBuffer.size() < read.m_Size)
+                            readBuffer.resize(read.m_Size);
+
+                        const uint8_t* src = readBuffer.data();
+                        if (read.m_Source->ReadAt(read.m_Offset, readBuffer.data(), read.m_Size) != read.m_Size)
+                            src = static_cast<const uint8_t*>(read.m_Source->GetData()) + read.m_Offset;
+
+                        for (uint32_t i = read.m_FirstSpan; i < read.m_EndSpan; ++i)
+                        {
+                            const nvfeedback::TileReadSpan& span = spans[i];
+                            memcpy(dst.data() + (size_t)span.m_BatchIndex * kTileBytes + span.m_DstOffset, src + (span.m_SrcOffset - read.m_Offset), span.m_Size);
+                        }
+                    }
+                    workerReads += reads.size();
+                    for (const nvfeedback::TileRead& read : reads)
+                        workerReadBytes += read.m_Size;
+                }
+
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    workerTileBytes += dstSizes[i];
+                    workerChecksum  += HashTile(dst.data() + (size_t)i * kTileBytes, dstSizes[i]);
+                }
+            }
+
+            numReads.fetch_add(workerReads, std::memory_order_relaxed);
+            readBytes.fetch_add(workerReadBytes, std::memory_order_relaxed);
+            tileBytes.fetch_add(workerTileBytes, std::memory_order_relaxed);
+            checksum.fetch_add(workerChecksum, std::memory_order_relaxed);
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < options.m_NumThreads; ++i)
+            threads.emplace_back(worker);
+        for (std::thread& thread : threads)
+            thread.join();
+
+        outResult.m_Seconds   = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        outResult.m_NumReads  = numReads.load();
+        outResult.m_ReadBytes = readBytes.load();
+        outResult.m_TileBytes = tileBytes.load();
+        outResult.m_Checksum  = checksum.load();
+
+        const double tileMB = (double)outResult.m_TileBytes / (1024.0 * 1024.0);
+        LOG_INFO("[TileIOBench] %s: %zu tiles, %.2f MB in %.3f s: %.1f MB/s, %.0f tiles/s",
+                 bExplicitReads ? "read" : "mmap", tiles.size(), tileMB, outResult.m_Seconds,
+                 tileMB / std::max(outResult.m_Seconds, 1e-9), tiles.size() / std::max(outResult.m_Seconds, 1e-9));
+        LOG_INFO("[TileIOBench] %s: %llu %s, %.2f MB read (%.2fx the tile bytes)%s",
+                 bExplicitReads ? "read" : "mmap", (unsigned long long)outResult.m_NumReads,
+                 bExplicitReads ? "reads" : "row copies", (double)outResult.m_ReadBytes / (1024.0 * 1024.0),
+                 (double)outResult.m_ReadBytes / std::max<uint64_t>(outResult.m_TileBytes, 1),
+                 bExplicitReads ? "" : "; page faults read whole pages, not counted");
+        return true;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseCommandLine(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<BenchTexture> textures;
+    std::vector<BenchTile> tiles;
+    if (options.m_NumSyntheticTextures > 0)
+        MakeSyntheticTiles(options, textures, tiles);
+    else if (!LoadTraceTiles(options.m_TracePath, textures, tiles))
+        return 1;
+
+    if (options.m_MaxTiles > 0 && tiles.size() > options.m_MaxTiles)
+        tiles.resize(options.m_MaxTiles);
+    if (tiles.empty())
+    {
+        LOG_ERROR("[TileIOBench] The trace maps no standard tiles");
+        return 1;
+    }
+
+    // Only the textures the tiles read from need a file
+    std::vector<bool> bUsed(textures.size(), false);
+    for (const BenchTile& tile : tiles)
+        bUsed[tile.m_Texture] = true;
+
+    std::error_code ec;
+    std::filesystem::create_directories(options.m_Dir, ec);
+    uint64_t sourceBytes = 0;
+    uint32_t numWritten = 0;
+    for (uint32_t i = 0; i < (uint32_t)textures.size(); ++i)
+    {
+        bool bWritten = false;
+        if (bUsed[i] && !PrepareSourceFile(options.m_Dir, i, options.m_Seed, textures[i], bWritten))
+            return 1;
+        sourceBytes += bUsed[i] ? kSourceHeaderBytes + textures[i].m_DataSize : 0;
+        numWritten  += bWritten ? 1 : 0;
+    }
+
+    LOG_INFO("[TileIOBench] %zu tiles from %zu textures, %.2f MB of source files in '%s' (%u written), %u thread(s), queue depth %u, %s cache",
+             tiles.size(), textures.size(), (double)sourceBytes / (1024.0 * 1024.0), options.m_Dir.string().c_str(), numWritten,
+             options.m_NumThreads, options.m_QueueDepth, options.m_bWarm ? "warm" : "cold");
+
+    BenchResult mmapResult;
+    BenchResult readResult;
+    if (options.m_Backend != Backend::Read && !RunBackend(options, false, textures, tiles, mmapResult))
+        return 1;
+    if (options.m_Backend != Backend::Mmap && !RunBackend(options, true, textures, tiles, readResult))
+        return 1;
+
+    if (options.m_Backend == Backend::Both)
+    {
+        if (mmapResult.m_Checksum != readResult.m_Checksum)
+        {
+            LOG_ERROR("[TileIOBench] The backends read different tile data (checksums %016llx and %016llx)",
+                      (unsigned long long)mmapResult.m_Checksum, (unsigned long long)readResult.m_Checksum);
+            return 1;
+        }
+        LOG_INFO("[TileIOBench] read vs mmap: %.2fx the throughput, %llu vs %llu I/Os",
+                 mmapResult.m_Seconds / std::max(readResult.m_Seconds, 1e-9),
+                 (unsigned long long)readResult.m_NumReads, (unsigned long long)mmapResult.m_NumReads);
+    }
+    return 0;
+}
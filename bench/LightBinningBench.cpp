@@ -0,0 +1,210 @@
+#include "LightClusterBinner.h"
+#include "Log.h"
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+// ============================================================
+// LightBinningBench — LightClusterBinner::Bin at scene scale
+// ============================================================
+// Bins --lights local lights, scattered over a city-sized block around the
+// camera, into the froxel grid once per frame while the camera turns a full
+// circle over --frames frames, and logs the time per Bin (median, p90, min),
+// the lights binned per second and the grid's fill (visible lights, indices,
+// longest cluster list).  Lights are mostly spot lights with a few point
+// lights (skipped by the binner, as in Scene::m_GPULights) and directional
+// lights; ranges are 2-12 m.
+//
+// Every frame's output is checked for consistency: each cluster range lies
+// inside the index list and every index names a light.  The brute-force
+// comparison is the LightClusterBinner engine test group.
+//
+//   HobbyRenderer --bench-light-binning [options]
+//
+// No window or device: it runs before either exists (see main in Renderer.cpp).
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint32_t kWarmUpFrames = 3; // the first Bin sizes its buffers
+    constexpr float    kBlockSize    = 400.0f;
+    constexpr float    kBlockHeight  = 60.0f;
+
+    struct Options
+    {
+        uint32_t m_NumLights  = 65536;
+        uint32_t m_NumFrames  = 120;
+        uint32_t m_NumThreads = TaskScheduler::kRuntimeThreadCount;
+        uint32_t m_Seed       = 1;
+    };
+
+    std::vector<srrhi::GPULight> MakeLights(const Options& options)
+    {
+        std::mt19937 rng(options.m_Seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        std::vector<srrhi::GPULight> lights(options.m_NumLights);
+        for (uint32_t i = 0; i < options.m_NumLights; ++i)
+        {
+            srrhi::GPULight& light = lights[i];
+            light.m_Type = (i < 4) ? 0u : (unit(rng) < 0.1f ? 1u : 2u);
+            light.m_Intensity = 1.0f;
+            light.m_Position = Vector3{ (unit(rng) - 0.5f) * kBlockSize, unit(rng) * kBlockHeight, (unit(rng) - 0.5f) * kBlockSize };
+            light.m_Range = 2.0f + unit(rng) * 10.0f;
+
+            // Mostly pointing down, like street and ceiling lights
+            XMFLOAT3 direction{ unit(rng) - 0.5f, -1.0f - unit(rng), unit(rng) - 0.5f };
+            XMStoreFloat3(&direction, XMVector3Normalize(XMLoadFloat3(&direction)));
+            light.m_Direction = direction;
+            light.m_SpotOuterConeAngle = 0.3f + unit(rng) * 0.9f;
+            light.m_SpotInnerConeAngle = light.m_SpotOuterConeAngle * 0.5f;
+        }
+        return lights;
+    }
+
+    // 16:9, 60 degrees vertical, from head height in the middle of the block
+    LightClusterView MakeView(uint32_t frame, uint32_t numFrames)
+    {
+        const float yaw = XM_2PI * frame / numFrames;
+        const XMVECTOR eye = XMVectorSet(0.0f, 1.7f, 0.0f, 1.0f);
+        const XMVECTOR forward = XMVectorSet(std::sin(yaw), -0.1f, std::cos(yaw), 0.0f);
+
+        LightClusterView view;
+        XMStoreFloat4x4(&view.m_WorldToView, XMMatrixLookToLH(eye, forward, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+        view.m_TanHalfFovY = std::tan(XM_PI / 6.0f);
+        view.m_TanHalfFovX = view.m_TanHalfFovY * 16.0f / 9.0f;
+        view.m_NearZ       = 0.1f;
+        return view;
+    }
+
+    bool IsConsistent(const LightClusterBinner& binner, uint32_t numLights)
+    {
+        const std::vector<uint32_t>& indices = binner.GetLightIndices();
+        if (indices.size() != binner.GetStats().m_NumIndices || binner.GetClusters().size() != LightClusterBinner::kNumClusters)
+            return false;
+        for (const LightClusterBinner::ClusterRange& cluster : binner.GetClusters())
+        {
+            if ((uint64_t)cluster.m_Offset + cluster.m_Count > indices.size())
+                return false;
+        }
+        return std::all_of(indices.begin(), indices.end(), [numLights](uint32_t index) { return index < numLights; });
+    }
+
+    double Percentile(std::vector<double> values, double fraction)
+    {
+        std::sort(values.begin(), values.end());
+        return values[std::min<size_t>((size_t)(fraction * values.size()), values.size() - 1)];
+    }
+
+    void PrintUsage()
+    {
+        LOG_INFO("Usage: HobbyRenderer --bench-light-binning [options]");
+        LOG_INFO("  --lights <n>               Lights in the scene (default: 65536)");
+        LOG_INFO("  --frames <n>               Timed frames, one camera turn (default: 120)");
+        LOG_INFO("  --threads <n>              Worker threads (default: as the renderer's, %u)", TaskScheduler::kRuntimeThreadCount);
+        LOG_INFO("  --seed <n>                 Light placement seed (default: 1)");
+        LOG_INFO("  --help, -h                 Show this help message");
+    }
+
+    bool ParseCommandLine(int argc, char* argv[], Options& outOptions)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool bHasValue = (i + 1 < argc);
+
+            if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+            {
+                return false;
+            }
+            else if (std::strcmp(arg, "--lights") == 0 && bHasValue)
+            {
+                outOptions.m_NumLights = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--frames") == 0 && bHasValue)
+            {
+                outOptions.m_NumFrames = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--threads") == 0 && bHasValue)
+            {
+                outOptions.m_NumThreads = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--seed") == 0 && bHasValue)
+            {
+                outOptions.m_Seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else
+            {
+                LOG_ERROR("[LightBinningBench] Unknown or incomplete argument: %s", arg);
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+int RunLightBinningBench(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseCommandLine(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    TaskScheduler scheduler;
+    scheduler.SetThreadCount(options.m_NumThreads);
+    const std::vector<srrhi::GPULight> lights = MakeLights(options);
+    LightClusterBinner binner;
+
+    LOG_INFO("[LightBinningBench] %u lights, %ux%ux%u clusters, %u worker thread(s), %u frames",
+             options.m_NumLights, LightClusterBinner::kGridX, LightClusterBinner::kGridY, LightClusterBinner::kGridZ,
+             scheduler.GetThreadCount(), options.m_NumFrames);
+
+    for (uint32_t frame = 0; frame < kWarmUpFrames; ++frame)
+        binner.Bin(lights, MakeView(frame, options.m_NumFrames), scheduler);
+
+    std::vector<double> frameMs;
+    uint64_t numVisible = 0;
+    uint64_t numIndices = 0;
+    uint32_t maxPerCluster = 0;
+    for (uint32_t frame = 0; frame < options.m_NumFrames; ++frame)
+    {
+        const LightClusterView view = MakeView(frame, options.m_NumFrames);
+        const Clock::time_point start = Clock::now();
+        binner.Bin(lights, view, scheduler);
+        frameMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+        if (!IsConsistent(binner, options.m_NumLights))
+        {
+            LOG_ERROR("[LightBinningBench] Frame %u: a cluster range or light index is out of bounds", frame);
+            return 1;
+        }
+        const LightClusterStats& stats = binner.GetStats();
+        numVisible += stats.m_NumVisibleLights;
+        numIndices += stats.m_NumIndices;
+        maxPerCluster = std::max(maxPerCluster, stats.m_MaxLightsPerCluster);
+    }
+
+    const double medianMs = Percentile(frameMs, 0.5);
+    LOG_INFO("[LightBinningBench] Bin: median %.3f ms, p90 %.3f ms, min %.3f ms; %.2f M lights/s",
+             medianMs, Percentile(frameMs, 0.9), Percentile(frameMs, 0.0), options.m_NumLights / (medianMs * 1e3));
+    LOG_INFO("[LightBinningBench] per frame: %.0f visible local lights, %.0f indices; longest cluster list %u",
+             (double)numVisible / options.m_NumFrames, (double)numIndices / options.m_NumFrames, maxPerCluster);
+
+    if (numVisible == 0)
+    {
+        LOG_ERROR("[LightBinningBench] No light was ever visible");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,403 @@
+#include "CPURayQuery.h"
+#include "Log.h"
+#include "Scene.h"
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+// ============================================================
+// RayQueryBench — CPUSceneRayQuery rays per second
+// ============================================================
+// Builds CPUSceneRayQuery over a synthetic scene in the cooked-geometry layout
+// (a 400 m height-field terrain and --instances rotated, scaled copies of a
+// bumpy rock, every eighth one alpha-tested) and logs the build time and
+// memory, then the throughput of the batch queries over the worker threads
+// for three kinds of rays:
+//   primary — closest hit, one ray per pixel of a --width x --height camera
+//   shadow  — any hit, from the primary hits towards the sun
+//   random  — closest hit, from the primary hits in random upward directions,
+//             up to 50 m (incoherent, like AO or GI rays)
+// Each batch runs --repeats times; the fastest run counts.
+//
+// As a smoke check, the single-ray TraceClosest/TraceAny must agree with the
+// batches on a sample of the rays, and most primary rays must hit.  The
+// brute-force comparison is the CPURayQuery engine test group.
+//
+//   HobbyRenderer --bench-ray-query [options]
+//
+// No window or device: it runs before either exists (see main in Renderer.cpp).
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint32_t kTerrainQuads   = 256;  // per side
+    constexpr float    kTerrainSize    = 400.0f;
+    constexpr uint32_t kRockSegments   = 64;
+    constexpr uint32_t kRockRings      = 32;
+    constexpr float    kRandomRayRange = 50.0f;
+    constexpr uint32_t kCheckStride    = 97;   // every kCheckStride-th ray is traced alone too
+
+    enum Materials : uint32_t
+    {
+        kMaterialOpaque,
+        kMaterialMasked,
+        kNumMaterials
+    };
+
+    struct Options
+    {
+        uint32_t m_NumInstances = 512;
+        uint32_t m_Width        = 640;
+        uint32_t m_Height       = 360;
+        uint32_t m_NumRepeats   = 3;
+        uint32_t m_NumThreads   = TaskScheduler::kRuntimeThreadCount;
+        uint32_t m_Seed         = 1;
+    };
+
+    struct BenchGeometry
+    {
+        std::vector<srrhi::VertexQuantized> m_Vertices;
+        std::vector<uint32_t>               m_Indices;
+    };
+
+    float GetTerrainHeight(float x, float z)
+    {
+        return 6.0f * std::sin(x * 0.031f) * std::cos(z * 0.027f) + 1.5f * std::sin(x * 0.17f + z * 0.11f);
+    }
+
+    void AddMeshData(Scene& scene, BenchGeometry& geometry, const std::vector<uint32_t>& indices)
+    {
+        srrhi::MeshData& meshData = scene.m_MeshData.emplace_back();
+        meshData.m_IndexOffsets[0] = (uint32_t)geometry.m_Indices.size();
+        meshData.m_IndexCounts[0] = (uint32_t)indices.size();
+        meshData.m_LODCount = 1;
+        geometry.m_Indices.insert(geometry.m_Indices.end(), indices.begin(), indices.end());
+    }
+
+    void BuildBenchScene(const Options& options, Scene& scene, BenchGeometry& geometry)
+    {
+        std::mt19937 rng(options.m_Seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        auto addVertex = [&](float x, float y, float z) {
+            srrhi::VertexQuantized& vertex = geometry.m_Vertices.emplace_back();
+            vertex.m_Pos = Vector3{ x, y, z };
+            return (uint32_t)geometry.m_Vertices.size() - 1;
+        };
+
+        // MeshData 0: the terrain, in world space
+        {
+            const uint32_t firstVertex = (uint32_t)geometry.m_Vertices.size();
+            for (uint32_t z = 0; z <= kTerrainQuads; ++z)
+            {
+                for (uint32_t x = 0; x <= kTerrainQuads; ++x)
+                {
+                    const float wx = (float(x) / kTerrainQuads - 0.5f) * kTerrainSize;
+                    const float wz = (float(z) / kTerrainQuads - 0.5f) * kTerrainSize;
+                    addVertex(wx, GetTerrainHeight(wx, wz), wz);
+                }
+            }
+            std::vector<uint32_t> indices;
+            for (uint32_t z = 0; z < kTerrainQuads; ++z)
+            {
+                for (uint32_t x = 0; x < kTerrainQuads; ++x)
+                {
+                    const uint32_t v = firstVertex + z * (kTerrainQuads + 1) + x;
+                    indices.insert(indices.end(), { v, v + kTerrainQuads + 1, v + 1, v + 1, v + kTerrainQuads + 1, v + kTerrainQuads + 2 });
+                }
+            }
+            AddMeshData(scene, geometry, indices);
+        }
+
+        // MeshData 1: a unit rock, a sphere with a noisy radius
+        {
+            const uint32_t firstVertex = (uint32_t)geometry.m_Vertices.size();
+            for (uint32_t ring = 0; ring <= kRockRings; ++ring)
+            {
+                const float theta = XM_PI * ring / kRockRings;
+                for (uint32_t segment = 0; segment <= kRockSegments; ++segment)
+                {
+                    const float phi = XM_2PI * segment / kRockSegments;
+                    const float radius = 0.85f + 0.15f * unit(rng);
+                    addVertex(radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta), radius * std::sin(theta) * std::sin(phi));
+                }
+            }
+            std::vector<uint32_t> indices;
+            for (uint32_t ring = 0; ring < kRockRings; ++ring)
+            {
+                for (uint32_t segment = 0; segment < kRockSegments; ++segment)
+                {
+                    const uint32_t v = firstVertex + ring * (kRockSegments + 1) + segment;
+                    indices.insert(indices.end(), { v, v + 1, v + kRockSegments + 1, v + 1, v + kRockSegments + 2, v + kRockSegments + 1 });
+                }
+            }
+            AddMeshData(scene, geometry, indices);
+        }
+
+        scene.m_Materials.resize(kNumMaterials);
+        scene.m_Materials[kMaterialOpaque].m_GPU.m_AlphaMode = (uint32_t)srrhi::CommonConsts::ALPHA_MODE_OPAQUE;
+        srrhi::MaterialConstants& masked = scene.m_Materials[kMaterialMasked].m_GPU;
+        masked.m_AlphaMode = (uint32_t)srrhi::CommonConsts::ALPHA_MODE_MASK;
+        masked.m_AlphaCutoff = 0.5f;
+        masked.m_TextureFlags = 0;
+        masked.m_BaseColor.w = 1.0f;
+
+        // Instance 0 is the terrain, the rest are rocks sitting on it
+        scene.m_InstanceData.resize(options.m_NumInstances + 1);
+        XMStoreFloat4x4(&scene.m_InstanceData[0].m_World, XMMatrixIdentity());
+        scene.m_InstanceData[0].m_MeshDataIndex = 0;
+        scene.m_InstanceData[0].m_MaterialIndex = kMaterialOpaque;
+        for (uint32_t i = 1; i <= options.m_NumInstances; ++i)
+        {
+            srrhi::PerInstanceData& instance = scene.m_InstanceData[i];
+            instance.m_MeshDataIndex = 1;
+            instance.m_MaterialIndex = (i % 8 == 0) ? kMaterialMasked : kMaterialOpaque;
+
+            const float x = (unit(rng) - 0.5f) * kTerrainSize * 0.9f;
+            const float z = (unit(rng) - 0.5f) * kTerrainSize * 0.9f;
+            const float scale = 1.0f + unit(rng) * 5.0f;
+            const XMMATRIX world = XMMatrixScaling(scale, scale * (0.4f + unit(rng) * 0.6f), scale) *
+                                   XMMatrixRotationRollPitchYaw(unit(rng) * 0.5f, unit(rng) * XM_2PI, unit(rng) * 0.5f) *
+                                   XMMatrixTranslation(x, GetTerrainHeight(x, z), z);
+            XMStoreFloat4x4(&instance.m_World, world);
+        }
+    }
+
+    // A pinhole camera above the terrain's edge, looking across it
+    std::vector<CPURay> MakePrimaryRays(const Options& options)
+    {
+        const float tanHalfFovY = std::tan(XM_PI / 6.0f);
+        const float aspect = float(options.m_Width) / float(options.m_Height);
+        std::vector<CPURay> rays(options.m_Width * options.m_Height);
+        for (uint32_t y = 0; y < options.m_Height; ++y)
+        {
+            for (uint32_t x = 0; x < options.m_Width; ++x)
+            {
+                const float ndcX = ((x + 0.5f) / options.m_Width * 2.0f - 1.0f) * tanHalfFovY * aspect;
+                const float ndcY = (1.0f - (y + 0.5f) / options.m_Height * 2.0f) * tanHalfFovY;
+                CPURay& ray = rays[y * options.m_Width + x];
+                ray.m_Origin = Vector3{ 0.0f, 30.0f, -kTerrainSize * 0.45f };
+                ray.m_Direction = Vector3{ ndcX, ndcY - 0.35f, 1.0f };
+            }
+        }
+        return rays;
+    }
+
+    // From each primary hit: towards the sun (shadow) or anywhere above it within kRandomRayRange (random).
+    // Hits are mostly on the terrain or the upper side of a rock, so up is roughly the surface's side.
+    void MakeSecondaryRays(const std::vector<CPURay>& primaryRays, const std::vector<CPURayHit>& primaryHits, uint32_t seed,
+                           std::vector<CPURay>& outShadowRays, std::vector<CPURay>& outRandomRays)
+    {
+        std::mt19937 rng(seed);
+        std::normal_distribution<float> normal(0.0f, 1.0f);
+        for (size_t i = 0; i < primaryRays.size(); ++i)
+        {
+            if (!primaryHits[i].IsHit())
+                continue;
+
+            const CPURay& primary = primaryRays[i];
+            const float t = primaryHits[i].m_RayT * 0.999f; // just off the surface
+            const Vector3 hitPoint{ primary.m_Origin.x + primary.m_Direction.x * t,
+                                    primary.m_Origin.y + primary.m_Direction.y * t,
+                                    primary.m_Origin.z + primary.m_Direction.z * t };
+
+            CPURay& shadow = outShadowRays.emplace_back();
+            shadow.m_Origin = hitPoint;
+            shadow.m_Direction = Vector3{ 0.3f, 0.8f, 0.2f };
+
+            XMFLOAT3 direction{ normal(rng), std::abs(normal(rng)), normal(rng) };
+            XMStoreFloat3(&direction, XMVector3Normalize(XMLoadFloat3(&direction)));
+            CPURay& random = outRandomRays.emplace_back();
+            random.m_Origin = hitPoint;
+            random.m_Direction = direction;
+            random.m_TMax = kRandomRayRange;
+        }
+    }
+
+    struct BatchResult
+    {
+        double   m_Seconds = 0.0; // fastest run
+        uint32_t m_NumHits = 0;
+        uint32_t m_NumMismatches = 0;
+    };
+
+    BatchResult RunClosest(const CPUSceneRayQuery& rayQuery, const std::vector<CPURay>& rays, std::vector<CPURayHit>& outHits,
+                           uint32_t numRepeats, TaskScheduler& scheduler)
+    {
+        BatchResult result;
+        result.m_Seconds = 1e30;
+        outHits.assign(rays.size(), CPURayHit{});
+        for (uint32_t repeat = 0; repeat < numRepeats; ++repeat)
+        {
+            const Clock::time_point start = Clock::now();
+            rayQuery.TraceClosest(rays, outHits, scheduler);
+            result.m_Seconds = std::min(result.m_Seconds, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            result.m_NumHits += outHits[i].IsHit() ? 1 : 0;
+            if (i % kCheckStride != 0)
+                continue;
+            CPURayHit single;
+            if (rayQuery.TraceClosest(rays[i], single) != outHits[i].IsHit() || single.m_InstanceIndex != outHits[i].m_InstanceIndex ||
+                single.m_RayT != outHits[i].m_RayT)
+            {
+                result.m_NumMismatches++;
+            }
+        }
+        return result;
+    }
+
+    BatchResult RunAny(const CPUSceneRayQuery& rayQuery, const std::vector<CPURay>& rays, uint32_t numRepeats, TaskScheduler& scheduler)
+    {
+        BatchResult result;
+        result.m_Seconds = 1e30;
+        std::vector<uint8_t> occluded(rays.size());
+        for (uint32_t repeat = 0; repeat < numRepeats; ++repeat)
+        {
+            const Clock::time_point start = Clock::now();
+            rayQuery.TraceAny(rays, occluded, scheduler);
+            result.m_Seconds = std::min(result.m_Seconds, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            result.m_NumHits += occluded[i] ? 1 : 0;
+            if (i % kCheckStride == 0 && rayQuery.TraceAny(rays[i]) != (occluded[i] != 0))
+                result.m_NumMismatches++;
+        }
+        return result;
+    }
+
+    void ReportBatch(const char* name, size_t numRays, const BatchResult& result)
+    {
+        LOG_INFO("[RayQueryBench] %-7s %8zu rays, %5.1f%% hit: %8.2f ms, %6.2f M rays/s",
+                 name, numRays, numRays ? result.m_NumHits * 100.0 / numRays : 0.0, result.m_Seconds * 1e3,
+                 numRays / std::max(result.m_Seconds, 1e-9) * 1e-6);
+    }
+
+    void PrintUsage()
+    {
+        LOG_INFO("Usage: HobbyRenderer --bench-ray-query [options]");
+        LOG_INFO("  --instances <n>            Rock instances on the terrain (default: 512)");
+        LOG_INFO("  --width <pixels>           Primary ray grid width (default: 640)");
+        LOG_INFO("  --height <pixels>          Primary ray grid height (default: 360)");
+        LOG_INFO("  --repeats <n>              Runs of each batch, the fastest counts (default: 3)");
+        LOG_INFO("  --threads <n>              Worker threads (default: as the renderer's, %u)", TaskScheduler::kRuntimeThreadCount);
+        LOG_INFO("  --seed <n>                 Scene and random ray seed (default: 1)");
+        LOG_INFO("  --help, -h                 Show this help message");
+    }
+
+    bool ParseCommandLine(int argc, char* argv[], Options& outOptions)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool bHasValue = (i + 1 < argc);
+
+            if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+            {
+                return false;
+            }
+            else if (std::strcmp(arg, "--instances") == 0 && bHasValue)
+            {
+                outOptions.m_NumInstances = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else if (std::strcmp(arg, "--width") == 0 && bHasValue)
+            {
+                outOptions.m_Width = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--height") == 0 && bHasValue)
+            {
+                outOptions.m_Height = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--repeats") == 0 && bHasValue)
+            {
+                outOptions.m_NumRepeats = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--threads") == 0 && bHasValue)
+            {
+                outOptions.m_NumThreads = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--seed") == 0 && bHasValue)
+            {
+                outOptions.m_Seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            }
+            else
+            {
+                LOG_ERROR("[RayQueryBench] Unknown or incomplete argument: %s", arg);
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+int RunRayQueryBench(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseCommandLine(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    TaskScheduler scheduler;
+    scheduler.SetThreadCount(options.m_NumThreads);
+
+    Scene scene;
+    BenchGeometry geometry;
+    BuildBenchScene(options, scene, geometry);
+
+    Scene::CPUGeometryView view;
+    view.m_MeshData = scene.m_MeshData;
+    view.m_VerticesQuantized = geometry.m_Vertices;
+    view.m_Indices = geometry.m_Indices;
+
+    CPUSceneRayQuery rayQuery;
+    if (!rayQuery.Build(scene, view, scheduler))
+    {
+        LOG_ERROR("[RayQueryBench] CPUSceneRayQuery::Build failed");
+        return 1;
+    }
+    const CPUSceneRayQueryStats& stats = rayQuery.GetStats();
+    LOG_INFO("[RayQueryBench] %u meshes (%llu triangles), %u instances, %u worker thread(s): built in %.1f ms, %.1f MB",
+             stats.m_NumMeshes, (unsigned long long)stats.m_NumTriangles, stats.m_NumInstances, scheduler.GetThreadCount(),
+             stats.m_BuildMs, stats.m_MemoryBytes / (1024.0 * 1024.0));
+
+    const std::vector<CPURay> primaryRays = MakePrimaryRays(options);
+    std::vector<CPURayHit> primaryHits;
+    const BatchResult primary = RunClosest(rayQuery, primaryRays, primaryHits, options.m_NumRepeats, scheduler);
+    ReportBatch("primary", primaryRays.size(), primary);
+
+    std::vector<CPURay> shadowRays;
+    std::vector<CPURay> randomRays;
+    MakeSecondaryRays(primaryRays, primaryHits, options.m_Seed, shadowRays, randomRays);
+    const BatchResult shadow = RunAny(rayQuery, shadowRays, options.m_NumRepeats, scheduler);
+    ReportBatch("shadow", shadowRays.size(), shadow);
+    std::vector<CPURayHit> randomHits;
+    const BatchResult random = RunClosest(rayQuery, randomRays, randomHits, options.m_NumRepeats, scheduler);
+    ReportBatch("random", randomRays.size(), random);
+
+    const uint32_t numMismatches = primary.m_NumMismatches + shadow.m_NumMismatches + random.m_NumMismatches;
+    if (numMismatches > 0)
+    {
+        LOG_ERROR("[RayQueryBench] %u sampled rays traced alone disagree with their batch", numMismatches);
+        return 1;
+    }
+    if (primary.m_NumHits < primaryRays.size() / 2)
+    {
+        LOG_ERROR("[RayQueryBench] Only %u of %zu primary rays hit the scene", primary.m_NumHits, primaryRays.size());
+        return 1;
+    }
+    return 0;
+}
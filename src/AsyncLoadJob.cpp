@@ -0,0 +1,93 @@
+#include "AsyncLoadJob.h"
+#include "Log.h"
+
+#include <cassert>
+
+AsyncLoadJob::~AsyncLoadJob()
+{
+    assert(!m_Thread.joinable() && "AsyncLoadJob::Shutdown was not called");
+}
+
+void AsyncLoadJob::Start(Desc desc)
+{
+    assert(GetState() == State::Idle && "An AsyncLoadJob runs once");
+    assert(desc.m_Load && desc.m_SubmitUploads && desc.m_PollUploads);
+
+    m_Desc = std::move(desc);
+    m_StartTime = Clock::now();
+    m_State.store(State::Loading, std::memory_order_release);
+    m_Thread = std::thread([this]() {
+        LOG_INFO("[SceneLoad] Loading on the loader thread");
+        m_Desc.m_Load();
+        m_LoadSeconds = GetElapsedSeconds();
+        m_State.store(State::Loaded, std::memory_order_release);
+    });
+}
+
+bool AsyncLoadJob::Update()
+{
+    switch (GetState())
+    {
+    case State::Loaded:
+    {
+        // The thread stored State::Loaded as its last action
+        m_Thread.join();
+
+        const uint32_t numCommandLists = m_Desc.m_SubmitUploads();
+        m_State.store(State::Uploading, std::memory_order_release);
+
+        LOG_INFO("[SceneLoad] Scene loaded in %.2f s, submitted %u command lists", m_LoadSeconds, numCommandLists);
+        return false;
+    }
+    case State::Uploading:
+        if (!m_Desc.m_PollUploads())
+            return false;
+
+        m_State.store(State::Ready, std::memory_order_release);
+
+        LOG_INFO("[SceneLoad] GPU uploads done %.2f s after load start", GetElapsedSeconds());
+        return true;
+    case State::Ready:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void AsyncLoadJob::MarkTaken()
+{
+    assert(GetState() == State::Ready && "MarkTaken before the GPU work is done");
+    m_State.store(State::Taken, std::memory_order_release);
+}
+
+bool AsyncLoadJob::Shutdown()
+{
+    if (!m_Thread.joinable())
+        return false;
+
+    // m_Load has no cancellation points
+    LOG_INFO("[SceneLoad] Waiting for the loader thread to finish");
+    m_Thread.join();
+    return true;
+}
+
+const char* AsyncLoadJob::GetStateName() const
+{
+    switch (GetState())
+    {
+    case State::Idle:      return "Idle";
+    case State::Loading:   return "Loading scene data";
+    case State::Loaded:    return "Submitting GPU uploads";
+    case State::Uploading: return "Uploading to GPU";
+    case State::Ready:     return "Ready";
+    case State::Taken:     return "Done";
+    }
+    return "Unknown";
+}
+
+double AsyncLoadJob::GetElapsedSeconds() const
+{
+    if (GetState() == State::Idle)
+        return 0.0;
+    return std::chrono::duration<double>(Clock::now() - m_StartTime).count();
+}
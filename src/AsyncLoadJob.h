@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+// ─── AsyncLoadJob ────────────────────────────────────────────────────────────
+// The thread and state machine behind AsyncSceneLoader, without the scene or
+// the device (part of HobbyRendererCore, tested with a scripted load and a
+// stub GPU):
+//
+//   Start()   runs Desc::m_Load on a dedicated thread              Loading
+//   Update()  main thread, once per frame; never blocks:
+//               - once m_Load returned, joins the thread and calls
+//                 m_SubmitUploads                                  Loaded -> Uploading
+//               - then m_PollUploads until it returns true         Uploading -> Ready
+//   MarkTaken()  the result has been handed over                   Ready -> Taken
+//
+// The main thread only waits in Shutdown(), which joins a load that is still
+// running (m_Load has no cancellation points).
+// ─────────────────────────────────────────────────────────────────────────────
+
+class AsyncLoadJob
+{
+public:
+    enum class State : uint32_t
+    {
+        Idle,
+        Loading,   // loader thread running
+        Loaded,    // loader thread done, its GPU work not submitted yet
+        Uploading, // GPU work submitted, not finished yet
+        Ready,     // GPU work done, the result can be handed over
+        Taken,
+    };
+
+    struct Desc
+    {
+        // Loader thread.
+        std::function<void()> m_Load = nullptr;
+        // Main thread, once m_Load returned.  Submits the GPU work it recorded and
+        // returns the number of command lists submitted (for the log).
+        std::function<uint32_t()> m_SubmitUploads = nullptr;
+        // Main thread, every Update() after m_SubmitUploads.  True once the GPU
+        // work is done; must not wait for it.
+        std::function<bool()> m_PollUploads = nullptr;
+    };
+
+    AsyncLoadJob() = default;
+    ~AsyncLoadJob();
+
+    AsyncLoadJob(const AsyncLoadJob&) = delete;
+    AsyncLoadJob& operator=(const AsyncLoadJob&) = delete;
+
+    void Start(Desc desc);
+
+    // Main thread, once per frame.  Returns true once State::Ready is reached.
+    bool Update();
+
+    void MarkTaken();
+
+    // Waits for the loader thread.  Returns false if there was none to wait for.
+    bool Shutdown();
+
+    // Started and not taken yet
+    bool IsActive() const { const State state = GetState(); return state != State::Idle && state != State::Taken; }
+    State GetState() const { return m_State.load(std::memory_order_acquire); }
+    const char* GetStateName() const;
+    double GetElapsedSeconds() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Desc               m_Desc;
+    std::thread        m_Thread;
+    std::atomic<State> m_State{ State::Idle };
+    Clock::time_point  m_StartTime;
+    double             m_LoadSeconds = 0.0; // written by the loader thread before State::Loaded
+};
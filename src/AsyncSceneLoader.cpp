@@ -0,0 +1,97 @@
+#include "AsyncSceneLoader.h"
+#include "Renderer.h"
+#include "Streaming/GeometryStreamer.h"
+#include "Streaming/SceneCellStreamer.h"
+
+void AsyncSceneLoader::Start(nvrhi::IDevice* device, std::unique_ptr<nvfeedback::GeometryStreamer> geometryStreamer,
+                             std::unique_ptr<nvfeedback::SceneCellStreamer> cellStreamer)
+{
+    SDL_assert(GetState() == State::Idle && "The scene is loaded once");
+
+    m_Device = device;
+    m_Scene = std::make_unique<Scene>();
+    m_GeometryStreamer = std::move(geometryStreamer);
+    m_SceneCellStreamer = std::move(cellStreamer);
+    m_Job.Start({
+        .m_Load          = [this]() { LoaderThread(); },
+        .m_SubmitUploads = [this]() { return SubmitUploads(); },
+        .m_PollUploads   = [this]() { return PollUploads(); },
+    });
+}
+
+void AsyncSceneLoader::LoaderThread()
+{
+    PROFILE_FUNCTION();
+
+    Renderer::GetCommandListSinkForCurrentThread() = &m_CommandLists;
+    m_Scene->LoadScene(m_GeometryStreamer.get(), m_SceneCellStreamer.get());
+    Renderer::GetCommandListSinkForCurrentThread() = nullptr;
+}
+
+bool AsyncSceneLoader::Update()
+{
+    PROFILE_FUNCTION();
+
+    return m_Job.Update();
+}
+
+uint32_t AsyncSceneLoader::SubmitUploads()
+{
+    // Submission order matters to microprofile, as in Renderer::ExecutePendingCommandLists
+    std::vector<nvrhi::ICommandList*> rawLists;
+    rawLists.reserve(m_CommandLists.size());
+    for (const nvrhi::CommandListHandle& handle : m_CommandLists)
+    {
+        if (handle->m_GPULog != ULLONG_MAX)
+        {
+            MicroProfileGpuSubmit((uint32_t)nvrhi::CommandQueue::Graphics, handle->m_GPULog);
+            handle->m_GPULog = ULLONG_MAX;
+        }
+        rawLists.push_back(handle.Get());
+    }
+
+    if (!rawLists.empty())
+    {
+        m_Device->executeCommandLists(rawLists.data(), rawLists.size());
+    }
+
+    m_UploadQuery = m_Device->createEventQuery();
+    m_Device->setEventQuery(m_UploadQuery, nvrhi::CommandQueue::Graphics);
+    return (uint32_t)rawLists.size();
+}
+
+bool AsyncSceneLoader::PollUploads()
+{
+    if (!m_Device->pollEventQuery(m_UploadQuery))
+        return false;
+
+    m_UploadQuery = nullptr;
+    m_CommandLists.clear();
+    return true;
+}
+
+std::unique_ptr<Scene> AsyncSceneLoader::TakeScene(std::unique_ptr<nvfeedback::GeometryStreamer>& outGeometryStreamer,
+                                                   std::unique_ptr<nvfeedback::SceneCellStreamer>& outCellStreamer)
+{
+    SDL_assert(GetState() == State::Ready && "TakeScene before the scene's GPU work is done");
+
+    m_Job.MarkTaken();
+    outGeometryStreamer = std::move(m_GeometryStreamer);
+    outCellStreamer = std::move(m_SceneCellStreamer);
+    return std::move(m_Scene);
+}
+
+void AsyncSceneLoader::Shutdown()
+{
+    // Joins the loader thread if it is still running: LoadScene has no cancellation points
+    m_Job.Shutdown();
+
+    // Unsubmitted work is dropped; submitted work keeps what it references alive until it
+    // retires.  A scene that never became m_Scene is dropped without Scene::Shutdown, which
+    // would save its default camera.
+    m_UploadQuery = nullptr;
+    m_CommandLists.clear();
+    m_GeometryStreamer.reset();
+    m_SceneCellStreamer.reset();
+    m_Scene.reset();
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "AsyncLoadJob.h"
+#include "Scene.h"
+#include "Utilities.h"
+
+namespace nvfeedback { class GeometryStreamer; class SceneCellStreamer; }
+
+// ─── AsyncSceneLoader ────────────────────────────────────────────────────────
+// Loads the configured scene off the main thread, so the render loop keeps
+// presenting (a loading screen) while the scene is parsed, cooked, decoded
+// and uploaded.
+//
+//   1. Start() runs Scene::LoadScene on a dedicated thread into a staging
+//      Scene, handing it the streamers to initialize.  Command lists acquired on that thread are created for it and
+//      collected here (Renderer::AcquireCommandList's per-thread sink), so
+//      nothing it records reaches the main loop's pending lists.
+//   2. Update() (main thread, once per frame) executes those command lists
+//      once the thread is done (buffer, texture and meshlet uploads, BLAS and
+//      TLAS builds) and signals an event query behind them.
+//   3. Once Update() sees the query pass, TakeScene() hands the staging scene
+//      and the streamers back; the renderer moves it into m_Scene at the top
+//      of a frame.
+// The main thread never waits on the loader thread or the GPU to get there.
+// The thread and the state machine are AsyncLoadJob (HobbyRendererCore); this
+// class supplies the scene load and the nvrhi submission and event query.
+//
+// A dedicated thread, not a TaskScheduler task: ExecuteAllScheduledTasks waits
+// for every queued task, and the load itself blocks in ParallelFor and on the
+// I/O lane.  While the thread runs, the main thread must not touch what the
+// load writes: the bindless tables, FeedbackManager and m_FrameNumber.  The
+// streamers are owned by the loader meanwhile (Renderer's pointers are null),
+// and the loader only calls TaskScheduler::ParallelFor, which the main thread
+// does not wait on: it skips ExecuteAllScheduledTasks until the swap.
+//
+// Startup only.  Switching scenes at runtime, presenting the old scene while
+// the next one loads, would need two scenes registered at once: bindless
+// slots reclaimed from the old one, FeedbackManager textures re-registered,
+// and the streamers' pools (sized for one scene) split or recreated.  None of
+// that exists, so Start() is called once.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class AsyncSceneLoader
+{
+public:
+    using State = AsyncLoadJob::State;
+
+    AsyncSceneLoader() = default;
+
+    AsyncSceneLoader(const AsyncSceneLoader&) = delete;
+    AsyncSceneLoader& operator=(const AsyncSceneLoader&) = delete;
+
+    // The streamers (either may be null) belong to the loader until TakeScene()
+    void Start(nvrhi::IDevice* device, std::unique_ptr<nvfeedback::GeometryStreamer> geometryStreamer,
+               std::unique_ptr<nvfeedback::SceneCellStreamer> cellStreamer);
+
+    // Main thread, once per frame.  Submits the loader's command lists once its thread
+    // is done and returns true once the GPU has finished them.
+    bool Update();
+
+    // Main thread, once Update() returned true.  Returns the streamers given to Start().
+    std::unique_ptr<Scene> TakeScene(std::unique_ptr<nvfeedback::GeometryStreamer>& outGeometryStreamer,
+                                     std::unique_ptr<nvfeedback::SceneCellStreamer>& outCellStreamer);
+
+    // Waits for the loader thread and drops the staging scene, the streamers it still owns
+    // and its unsubmitted work.  Call before FeedbackManager and the device go away.
+    void Shutdown();
+
+    // Started and not taken yet
+    bool IsActive() const { return m_Job.IsActive(); }
+    State GetState() const { return m_Job.GetState(); }
+    const char* GetStateName() const { return m_Job.GetStateName(); }
+    double GetElapsedSeconds() const { return m_Job.GetElapsedSeconds(); }
+
+private:
+    void LoaderThread();
+    uint32_t SubmitUploads();
+    bool PollUploads();
+
+    nvrhi::IDevice*                       m_Device = nullptr;
+    AsyncLoadJob                          m_Job;
+    std::unique_ptr<Scene>                m_Scene;
+    std::unique_ptr<nvfeedback::GeometryStreamer>  m_GeometryStreamer;  // until TakeScene()
+    std::unique_ptr<nvfeedback::SceneCellStreamer> m_SceneCellStreamer; // until TakeScene()
+    std::vector<nvrhi::CommandListHandle> m_CommandLists; // written by the loader thread until State::Loaded
+    nvrhi::EventQueryHandle               m_UploadQuery;
+};
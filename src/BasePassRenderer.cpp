@@ -222,6 +222,7 @@ protected:
         cullData.SetP11(projectionMatrix.m[1][1]);
         cullData.SetForcedLOD(g_Renderer.m_ForcedLOD);
         cullData.SetInstanceBaseIndex(args.m_InstanceBaseIndex);
+        cullData.SetRecordLODRequests(g_Renderer.m_GeometryStreamer ? 1 : 0);
         commandList->writeBuffer(cullCB, &cullData, sizeof(cullData), 0);
 
         srrhi::GPUCullingInputs inputs;
@@ -238,6 +239,7 @@ protected:
         inputs.SetMeshletJobCount(handles.meshletJobCount ? handles.meshletJobCount : CommonResources::GetInstance().DummyUAVStructuredBuffer);
         inputs.SetMeshletIndirectArgs(handles.meshletIndirect ? handles.meshletIndirect : CommonResources::GetInstance().DummyUAVStructuredBuffer);
         inputs.SetInstanceLOD(g_Renderer.m_Scene.m_InstanceLODBuffer);
+        inputs.SetLODRequests(g_Renderer.m_GeometryStreamer ? g_Renderer.m_GeometryStreamer->GetLODRequestBuffer() : CommonResources::GetInstance().DummyUAVStructuredBuffer);
 
         nvrhi::BindingSetDesc cullBset = Renderer::CreateBindingSetDesc(inputs);
 
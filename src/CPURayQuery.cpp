@@ -0,0 +1,1221 @@
+#include "CPURayQuery.h"
+#include "TaskScheduler.h"
+#include "Utilities.h"
+#include "Log.h"
+#include "meshoptimizer.h"
+
+#include <bit>
+#include <cstdarg>
+
+using namespace DirectX;
+
+namespace
+{
+    // SAH bins per axis
+    constexpr uint32_t kNumBins = 16;
+    // Binary tree depth past which ranges are split at the median instead, which bounds the
+    // depth (and so the traversal stack) by kMaxSAHDepth + log2(primitives)
+    constexpr uint32_t kMaxSAHDepth = 40;
+    // Fewer primitives than this build as one task
+    constexpr uint32_t kMinParallelPrimitives = 16 * 1024;
+    // At most 3 entries pushed per level of a tree at most kMaxSAHDepth + 32 deep
+    constexpr uint32_t kTraversalStackSize = 256;
+    // Rays per ParallelFor task in the batch queries
+    constexpr uint32_t kRaysPerTask = 1024;
+
+    // Ray directions below this are nudged to it, so 1/d stays finite
+    constexpr float kMinDirection = 1e-20f;
+    // Box exit distances are scaled by this, so rounding never loses a hit (1 + 2 gamma(3),
+    // PBRT "Robust Ray-Bounds Intersections")
+    constexpr float kRobustExitScale = 1.0f + 2.0f * 3.0f * FLT_EPSILON * 0.5f / (1.0f - 3.0f * FLT_EPSILON * 0.5f);
+
+    // One bit per lane of an XMVectorLessOrEqual & co. result
+    uint32_t MoveMask(FXMVECTOR mask)
+    {
+#if defined(_XM_SSE_INTRINSICS_)
+        return (uint32_t)_mm_movemask_ps(mask);
+#else
+        return (XMVectorGetIntX(mask) ? 1u : 0u) | (XMVectorGetIntY(mask) ? 2u : 0u) |
+               (XMVectorGetIntZ(mask) ? 4u : 0u) | (XMVectorGetIntW(mask) ? 8u : 0u);
+#endif
+    }
+
+    XMVECTOR Load4(const float* lanes)
+    {
+        return XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(lanes));
+    }
+
+    float GetAxis(const Vector3& v, uint32_t axis)
+    {
+        return (&v.x)[axis];
+    }
+
+    // SAH leaf cost: leaves are tested four primitives at a time
+    float GetQuadCount(uint32_t numPrimitives)
+    {
+        return float((numPrimitives + 3) / 4);
+    }
+
+    bool IsFinite(const Vector3& v)
+    {
+        return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+    }
+
+    // A ray in the space of the BVH it traverses, splatted for the 4-wide tests
+    struct TraversalRay
+    {
+        XMVECTOR m_OriginX, m_OriginY, m_OriginZ;
+        XMVECTOR m_DirX, m_DirY, m_DirZ;
+        XMVECTOR m_InvDirX, m_InvDirY, m_InvDirZ;
+        XMVECTOR m_TMin;
+        // Float offsets in CPUBVH4::Node of the near and far planes on each axis
+        uint32_t m_NearX, m_NearY, m_NearZ;
+        uint32_t m_FarX, m_FarY, m_FarZ;
+
+        TraversalRay(FXMVECTOR origin, FXMVECTOR direction, float tMin)
+        {
+            Vector3 d;
+            XMStoreFloat3(&d, direction);
+            d.x = std::abs(d.x) < kMinDirection ? std::copysign(kMinDirection, d.x) : d.x;
+            d.y = std::abs(d.y) < kMinDirection ? std::copysign(kMinDirection, d.y) : d.y;
+            d.z = std::abs(d.z) < kMinDirection ? std::copysign(kMinDirection, d.z) : d.z;
+
+            m_OriginX = XMVectorSplatX(origin);
+            m_OriginY = XMVectorSplatY(origin);
+            m_OriginZ = XMVectorSplatZ(origin);
+            m_DirX = XMVectorReplicate(d.x);
+            m_DirY = XMVectorReplicate(d.y);
+            m_DirZ = XMVectorReplicate(d.z);
+            m_InvDirX = XMVectorReplicate(1.0f / d.x);
+            m_InvDirY = XMVectorReplicate(1.0f / d.y);
+            m_InvDirZ = XMVectorReplicate(1.0f / d.z);
+            m_TMin = XMVectorReplicate(tMin);
+
+            // Node layout: m_MinX, m_MinY, m_MinZ, m_MaxX, m_MaxY, m_MaxZ, 4 floats each
+            m_NearX = d.x >= 0.0f ? 0 : 12;
+            m_NearY = d.y >= 0.0f ? 4 : 16;
+            m_NearZ = d.z >= 0.0f ? 8 : 20;
+            m_FarX = 12 - m_NearX;
+            m_FarY = 20 - m_NearY;
+            m_FarZ = 28 - m_NearZ;
+        }
+    };
+
+    // Slab test of the ray against the node's 4 children boxes.  Empty children have
+    // min = +inf and max = -inf, whose entry distance is +inf whatever the direction.
+    uint32_t IntersectNode(const CPUBVH4::Node& node, const TraversalRay& ray, float tMax, XMVECTOR& outTNear)
+    {
+        const float* planes = node.m_MinX;
+        const XMVECTOR nearX = XMVectorMultiply(XMVectorSubtract(Load4(planes + ray.m_NearX), ray.m_OriginX), ray.m_InvDirX);
+        const XMVECTOR nearY = XMVectorMultiply(XMVectorSubtract(Load4(planes + ray.m_NearY), ray.m_OriginY), ray.m_InvDirY);
+        const XMVECTOR nearZ = XMVectorMultiply(XMVectorSubtract(Load4(planes + ray.m_NearZ), ray.m_OriginZ), ray.m_InvDirZ);
+        const XMVECTOR farX = XMVectorMultiply(XMVectorSubtract(Load4(planes + ray.m_FarX), ray.m_OriginX), ray.m_InvDirX);
+        const XMVECTOR farY = XMVectorMultiply(XMVectorSubtract(Load4(planes + ray.m_FarY), ray.m_OriginY), ray.m_InvDirY);
+        const XMVECTOR farZ = XMVectorMultiply(XMVectorSubtract(Load4(planes + ray.m_FarZ), ray.m_OriginZ), ray.m_InvDirZ);
+
+        const XMVECTOR tNear = XMVectorMax(XMVectorMax(nearX, nearY), XMVectorMax(nearZ, ray.m_TMin));
+        const XMVECTOR tFar = XMVectorMin(XMVectorMin(farX, farY), XMVectorMin(farZ, XMVectorReplicate(tMax)));
+
+        outTNear = tNear;
+        return MoveMask(XMVectorLessOrEqual(tNear, XMVectorScale(tFar, kRobustExitScale)));
+    }
+
+    // Möller-Trumbore against the quad's 4 triangles; no face culling
+    uint32_t IntersectQuad(const CPUMeshBVH::TriangleQuad& quad, const TraversalRay& ray, float tMax, XMFLOAT4A& outT, XMFLOAT4A& outU, XMFLOAT4A& outV)
+    {
+        const XMVECTOR e1x = Load4(quad.m_E1X), e1y = Load4(quad.m_E1Y), e1z = Load4(quad.m_E1Z);
+        const XMVECTOR e2x = Load4(quad.m_E2X), e2y = Load4(quad.m_E2Y), e2z = Load4(quad.m_E2Z);
+
+        // p = d x e2
+        const XMVECTOR px = XMVectorSubtract(XMVectorMultiply(ray.m_DirY, e2z), XMVectorMultiply(ray.m_DirZ, e2y));
+        const XMVECTOR py = XMVectorSubtract(XMVectorMultiply(ray.m_DirZ, e2x), XMVectorMultiply(ray.m_DirX, e2z));
+        const XMVECTOR pz = XMVectorSubtract(XMVectorMultiply(ray.m_DirX, e2y), XMVectorMultiply(ray.m_DirY, e2x));
+        const XMVECTOR det = XMVectorMultiplyAdd(e1x, px, XMVectorMultiplyAdd(e1y, py, XMVectorMultiply(e1z, pz)));
+        const XMVECTOR invDet = XMVectorReciprocal(det);
+
+        // s = o - v0, q = s x e1
+        const XMVECTOR sx = XMVectorSubtract(ray.m_OriginX, Load4(quad.m_V0X));
+        const XMVECTOR sy = XMVectorSubtract(ray.m_OriginY, Load4(quad.m_V0Y));
+        const XMVECTOR sz = XMVectorSubtract(ray.m_OriginZ, Load4(quad.m_V0Z));
+        const XMVECTOR qx = XMVectorSubtract(XMVectorMultiply(sy, e1z), XMVectorMultiply(sz, e1y));
+        const XMVECTOR qy = XMVectorSubtract(XMVectorMultiply(sz, e1x), XMVectorMultiply(sx, e1z));
+        const XMVECTOR qz = XMVectorSubtract(XMVectorMultiply(sx, e1y), XMVectorMultiply(sy, e1x));
+
+        const XMVECTOR u = XMVectorMultiply(XMVectorMultiplyAdd(sx, px, XMVectorMultiplyAdd(sy, py, XMVectorMultiply(sz, pz))), invDet);
+        const XMVECTOR v = XMVectorMultiply(XMVectorMultiplyAdd(ray.m_DirX, qx, XMVectorMultiplyAdd(ray.m_DirY, qy, XMVectorMultiply(ray.m_DirZ, qz))), invDet);
+        const XMVECTOR t = XMVectorMultiply(XMVectorMultiplyAdd(e2x, qx, XMVectorMultiplyAdd(e2y, qy, XMVectorMultiply(e2z, qz))), invDet);
+
+        // Degenerate triangles (and the unused lanes) have det == 0, so NaN or infinite
+        // u, v and t, which fail these
+        const XMVECTOR zero = XMVectorZero();
+        XMVECTOR mask = XMVectorNotEqual(det, zero);
+        mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(u, zero));
+        mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(v, zero));
+        mask = XMVectorAndInt(mask, XMVectorLessOrEqual(XMVectorAdd(u, v), XMVectorSplatOne()));
+        mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(t, ray.m_TMin));
+        mask = XMVectorAndInt(mask, XMVectorLess(t, XMVectorReplicate(tMax)));
+
+        XMStoreFloat4A(&outT, t);
+        XMStoreFloat4A(&outU, u);
+        XMStoreFloat4A(&outV, v);
+        return MoveMask(mask);
+    }
+
+    // Depth-first traversal, nearest child first unless bAnyHit.  leafFunc(leafChild) tests
+    // a leaf, lowering tMax on hits; returning true ends the traversal.
+    template <bool bAnyHit, typename LeafFunc>
+    bool TraverseBVH(const std::vector<CPUBVH4::Node>& nodes, const TraversalRay& ray, float& tMax, LeafFunc&& leafFunc)
+    {
+        if (nodes.empty())
+            return false;
+
+        uint32_t stack[kTraversalStackSize];
+        float    stackTNear[kTraversalStackSize];
+        uint32_t stackSize = 0;
+
+        uint32_t current = 0;
+        for (;;)
+        {
+            bool bDescend = false;
+            if (current & CPUBVH4::kLeafBit)
+            {
+                if (leafFunc(current))
+                    return true;
+            }
+            else
+            {
+                const CPUBVH4::Node& node = nodes[current];
+                XMVECTOR tNearVector;
+                const uint32_t mask = IntersectNode(node, ray, tMax, tNearVector);
+                if (mask != 0)
+                {
+                    XMFLOAT4A tNear;
+                    XMStoreFloat4A(&tNear, tNearVector);
+                    const float* tNearLanes = &tNear.x;
+
+                    // Hit children, sorted by entry distance for closest-hit queries
+                    uint32_t hits[4];
+                    float    hitTNear[4];
+                    uint32_t numHits = 0;
+                    for (uint32_t bits = mask; bits != 0; bits &= bits - 1)
+                    {
+                        const uint32_t lane = std::countr_zero(bits);
+                        uint32_t slot = numHits++;
+                        if constexpr (!bAnyHit)
+                        {
+                            for (; slot > 0 && hitTNear[slot - 1] > tNearLanes[lane]; --slot)
+                            {
+                                hits[slot] = hits[slot - 1];
+                                hitTNear[slot] = hitTNear[slot - 1];
+                            }
+                        }
+                        hits[slot] = node.m_Children[lane];
+                        hitTNear[slot] = tNearLanes[lane];
+                    }
+
+                    // Continue with the first, the others farthest first onto the stack
+                    SDL_assert(stackSize + numHits - 1 <= kTraversalStackSize);
+                    for (uint32_t i = numHits - 1; i > 0; --i)
+                    {
+                        stack[stackSize] = hits[i];
+                        stackTNear[stackSize] = hitTNear[i];
+                        ++stackSize;
+                    }
+                    current = hits[0];
+                    bDescend = true;
+                }
+            }
+
+            if (bDescend)
+                continue;
+
+            // Pop, skipping subtrees that start past the closest hit so far
+            for (;;)
+            {
+                if (stackSize == 0)
+                    return false;
+                --stackSize;
+                if (bAnyHit || stackTNear[stackSize] <= tMax)
+                {
+                    current = stack[stackSize];
+                    break;
+                }
+            }
+        }
+    }
+
+    // Collects problems by kind for ValidateRayTracingInputs
+    class ProblemLog
+    {
+    public:
+        // format describes the first case of the kind; printf-checked like LOG_*
+        void Report(const char* kind, LOG_PRINTF_FORMAT_STRING const char* format, ...) LOG_PRINTF_VARARG_FUNC(3)
+        {
+            auto it = std::find_if(m_Kinds.begin(), m_Kinds.end(), [kind](const Kind& k) { return std::strcmp(k.m_Name, kind) == 0; });
+            if (it == m_Kinds.end())
+            {
+                Kind& k = m_Kinds.emplace_back();
+                k.m_Name = kind;
+                char first[256];
+                va_list args;
+                va_start(args, format);
+                std::vsnprintf(first, sizeof(first), format, args);
+                va_end(args);
+                k.m_First = first;
+                it = m_Kinds.end() - 1;
+            }
+            ++it->m_Count;
+        }
+
+        uint32_t Flush() const
+        {
+            uint32_t total = 0;
+            for (const Kind& kind : m_Kinds)
+            {
+                LOG_WARN("[CPURayQuery] %s: %u (first: %s)", kind.m_Name, kind.m_Count, kind.m_First.c_str());
+                total += kind.m_Count;
+            }
+            return total;
+        }
+
+    private:
+        struct Kind
+        {
+            const char* m_Name = nullptr;
+            uint32_t    m_Count = 0;
+            std::string m_First;
+        };
+        std::vector<Kind> m_Kinds;
+    };
+}
+
+// ─── CPUBounds ───────────────────────────────────────────────────────────────
+
+void CPUBounds::Grow(const Vector3& p)
+{
+    m_Min = { std::min(m_Min.x, p.x), std::min(m_Min.y, p.y), std::min(m_Min.z, p.z) };
+    m_Max = { std::max(m_Max.x, p.x), std::max(m_Max.y, p.y), std::max(m_Max.z, p.z) };
+}
+
+void CPUBounds::Grow(const CPUBounds& b)
+{
+    m_Min = { std::min(m_Min.x, b.m_Min.x), std::min(m_Min.y, b.m_Min.y), std::min(m_Min.z, b.m_Min.z) };
+    m_Max = { std::max(m_Max.x, b.m_Max.x), std::max(m_Max.y, b.m_Max.y), std::max(m_Max.z, b.m_Max.z) };
+}
+
+float CPUBounds::GetHalfArea() const
+{
+    if (IsEmpty())
+        return 0.0f;
+    const float dx = m_Max.x - m_Min.x;
+    const float dy = m_Max.y - m_Min.y;
+    const float dz = m_Max.z - m_Min.z;
+    return dx * dy + dy * dz + dz * dx;
+}
+
+// ─── CPUBVH4 ─────────────────────────────────────────────────────────────────
+
+void CPUBVH4::Build(std::span<const CPUBounds> primitiveBounds, TaskScheduler* scheduler)
+{
+    PROFILE_FUNCTION();
+
+    m_PrimitiveBounds = primitiveBounds;
+    m_Nodes.clear();
+    m_PrimitiveOrder.clear();
+    m_Bounds = {};
+
+    m_Centroids.resize(primitiveBounds.size());
+    for (uint32_t i = 0; i < (uint32_t)primitiveBounds.size(); ++i)
+    {
+        const CPUBounds& b = primitiveBounds[i];
+        if (b.IsEmpty())
+            continue;
+        m_Centroids[i] = { 0.5f * (b.m_Min.x + b.m_Max.x), 0.5f * (b.m_Min.y + b.m_Max.y), 0.5f * (b.m_Min.z + b.m_Max.z) };
+        m_PrimitiveOrder.push_back(i);
+        m_Bounds.Grow(b);
+    }
+
+    const uint32_t numPrimitives = (uint32_t)m_PrimitiveOrder.size();
+    if (numPrimitives > 0)
+    {
+        SDL_assert(numPrimitives < (1u << 29) && "Leaf references hold 29 bits of primitive offset");
+
+        const BuildRange root{ 0, numPrimitives, 0, m_Bounds };
+        std::vector<BinaryNode> binaryNodes;
+
+        if (!scheduler || numPrimitives < kMinParallelPrimitives)
+        {
+            BuildSubtree(root, binaryNodes);
+        }
+        else
+        {
+            // Split the top levels one ParallelFor per level, until every range is small enough
+            // for the workers to share, then build those subtrees in parallel
+            struct OpenRange
+            {
+                BuildRange m_Range;
+                uint32_t   m_Node = 0;
+            };
+
+            const uint32_t subtreeSize = std::max(numPrimitives / (4 * std::max(1u, scheduler->GetThreadCount())), 1024u);
+
+            binaryNodes.emplace_back().m_Bounds = m_Bounds;
+            std::vector<OpenRange> open{ { root, 0 } };
+            std::vector<OpenRange> next;
+            std::vector<OpenRange> subtrees;
+            std::vector<SplitResult> splits;
+            while (!open.empty())
+            {
+                splits.resize(open.size());
+                scheduler->ParallelFor((uint32_t)open.size(), [this, &open, &splits](uint32_t i, uint32_t) { splits[i] = Split(open[i].m_Range); });
+
+                next.clear();
+                for (uint32_t i = 0; i < (uint32_t)open.size(); ++i)
+                {
+                    const BuildRange& range = open[i].m_Range;
+                    const SplitResult& split = splits[i];
+                    SDL_assert(split.m_Mid != range.m_Begin && "Open ranges are larger than a leaf");
+
+                    const uint32_t left = (uint32_t)binaryNodes.size();
+                    binaryNodes.resize(left + 2);
+                    binaryNodes[open[i].m_Node].m_Left = left;
+                    binaryNodes[open[i].m_Node].m_Right = left + 1;
+                    binaryNodes[left].m_Bounds = split.m_LeftBounds;
+                    binaryNodes[left + 1].m_Bounds = split.m_RightBounds;
+
+                    const OpenRange children[2] = {
+                        { { range.m_Begin, split.m_Mid, range.m_Depth + 1, split.m_LeftBounds }, left },
+                        { { split.m_Mid, range.m_End, range.m_Depth + 1, split.m_RightBounds }, left + 1 },
+                    };
+                    for (const OpenRange& child : children)
+                    {
+                        (child.m_Range.m_End - child.m_Range.m_Begin > subtreeSize ? next : subtrees).push_back(child);
+                    }
+                }
+                open.swap(next);
+            }
+
+            std::vector<std::vector<BinaryNode>> subtreeNodes(subtrees.size());
+            scheduler->ParallelFor((uint32_t)subtrees.size(), [this, &subtrees, &subtreeNodes](uint32_t i, uint32_t) { BuildSubtree(subtrees[i].m_Range, subtreeNodes[i]); });
+
+            // Each subtree's root replaces its placeholder; the rest is appended
+            for (uint32_t i = 0; i < (uint32_t)subtrees.size(); ++i)
+            {
+                const uint32_t base = (uint32_t)binaryNodes.size();
+                auto rebase = [base](BinaryNode node) {
+                    if (node.m_Count == 0)
+                    {
+                        node.m_Left = base + node.m_Left - 1;
+                        node.m_Right = base + node.m_Right - 1;
+                    }
+                    return node;
+                };
+
+                const std::vector<BinaryNode>& nodes = subtreeNodes[i];
+                binaryNodes[subtrees[i].m_Node] = rebase(nodes[0]);
+                for (size_t k = 1; k < nodes.size(); ++k)
+                {
+                    binaryNodes.push_back(rebase(nodes[k]));
+                }
+            }
+        }
+
+        Collapse(binaryNodes);
+    }
+
+    m_PrimitiveBounds = {};
+    std::vector<Vector3>().swap(m_Centroids);
+}
+
+CPUBVH4::SplitResult CPUBVH4::Split(const BuildRange& range)
+{
+    SplitResult result;
+    result.m_Mid = range.m_Begin;
+
+    const uint32_t count = range.m_End - range.m_Begin;
+    if (count <= kMaxLeafSize)
+        return result;
+
+    uint32_t* begin = m_PrimitiveOrder.data() + range.m_Begin;
+    uint32_t* end = m_PrimitiveOrder.data() + range.m_End;
+
+    CPUBounds centroidBounds;
+    for (const uint32_t* p = begin; p != end; ++p)
+    {
+        centroidBounds.Grow(m_Centroids[*p]);
+    }
+
+    uint32_t* mid = nullptr;
+    if (range.m_Depth < kMaxSAHDepth)
+    {
+        struct Bin
+        {
+            CPUBounds m_Bounds;
+            uint32_t  m_Count = 0;
+        };
+        Bin bins[3][kNumBins];
+
+        float binScale[3];
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            const float extent = GetAxis(centroidBounds.m_Max, axis) - GetAxis(centroidBounds.m_Min, axis);
+            binScale[axis] = extent > 0.0f ? kNumBins * (1.0f - 1e-6f) / extent : 0.0f;
+        }
+        auto getBin = [&](uint32_t primitive, uint32_t axis) {
+            const float offset = GetAxis(m_Centroids[primitive], axis) - GetAxis(centroidBounds.m_Min, axis);
+            return std::min((uint32_t)(offset * binScale[axis]), kNumBins - 1);
+        };
+
+        for (const uint32_t* p = begin; p != end; ++p)
+        {
+            for (uint32_t axis = 0; axis < 3; ++axis)
+            {
+                if (binScale[axis] == 0.0f)
+                    continue;
+                Bin& bin = bins[axis][getBin(*p, axis)];
+                bin.m_Bounds.Grow(m_PrimitiveBounds[*p]);
+                ++bin.m_Count;
+            }
+        }
+
+        // Sweep the split planes between bins: cost = area x quads on each side
+        float bestCost = FLT_MAX;
+        uint32_t bestAxis = UINT32_MAX;
+        uint32_t bestBin = 0;
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            if (binScale[axis] == 0.0f)
+                continue;
+
+            float rightCost[kNumBins] = {};
+            CPUBounds accumulated;
+            uint32_t accumulatedCount = 0;
+            for (uint32_t b = kNumBins - 1; b > 0; --b)
+            {
+                accumulated.Grow(bins[axis][b].m_Bounds);
+                accumulatedCount += bins[axis][b].m_Count;
+                rightCost[b] = accumulated.GetHalfArea() * GetQuadCount(accumulatedCount);
+            }
+
+            accumulated = {};
+            accumulatedCount = 0;
+            for (uint32_t b = 0; b < kNumBins - 1; ++b)
+            {
+                accumulated.Grow(bins[axis][b].m_Bounds);
+                accumulatedCount += bins[axis][b].m_Count;
+                if (accumulatedCount == 0 || accumulatedCount == count)
+                    continue;
+
+                const float cost = accumulated.GetHalfArea() * GetQuadCount(accumulatedCount) + rightCost[b + 1];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = b;
+                }
+            }
+        }
+
+        if (bestAxis != UINT32_MAX)
+        {
+            mid = std::partition(begin, end, [&](uint32_t primitive) { return getBin(primitive, bestAxis) <= bestBin; });
+        }
+    }
+
+    // Median on the widest centroid axis: past kMaxSAHDepth, or when the centroids coincide
+    if (!mid || mid == begin || mid == end)
+    {
+        uint32_t axis = 0;
+        float widest = -1.0f;
+        for (uint32_t a = 0; a < 3; ++a)
+        {
+            const float extent = GetAxis(centroidBounds.m_Max, a) - GetAxis(centroidBounds.m_Min, a);
+            if (extent > widest)
+            {
+                widest = extent;
+                axis = a;
+            }
+        }
+        mid = begin + count / 2;
+        std::nth_element(begin, mid, end, [this, axis](uint32_t a, uint32_t b) { return GetAxis(m_Centroids[a], axis) < GetAxis(m_Centroids[b], axis); });
+    }
+
+    for (const uint32_t* p = begin; p != mid; ++p)
+    {
+        result.m_LeftBounds.Grow(m_PrimitiveBounds[*p]);
+    }
+    for (const uint32_t* p = mid; p != end; ++p)
+    {
+        result.m_RightBounds.Grow(m_PrimitiveBounds[*p]);
+    }
+    result.m_Mid = (uint32_t)(mid - m_PrimitiveOrder.data());
+    return result;
+}
+
+void CPUBVH4::BuildSubtree(const BuildRange& range, std::vector<BinaryNode>& outNodes)
+{
+    outNodes.clear();
+    outNodes.emplace_back().m_Bounds = range.m_Bounds;
+
+    std::vector<std::pair<BuildRange, uint32_t>> stack{ { range, 0 } };
+    while (!stack.empty())
+    {
+        const auto [current, node] = stack.back();
+        stack.pop_back();
+
+        const SplitResult split = Split(current);
+        if (split.m_Mid == current.m_Begin)
+        {
+            outNodes[node].m_Left = current.m_Begin;
+            outNodes[node].m_Count = current.m_End - current.m_Begin;
+            continue;
+        }
+
+        const uint32_t left = (uint32_t)outNodes.size();
+        outNodes.resize(left + 2);
+        outNodes[node].m_Left = left;
+        outNodes[node].m_Right = left + 1;
+        outNodes[left].m_Bounds = split.m_LeftBounds;
+        outNodes[left + 1].m_Bounds = split.m_RightBounds;
+
+        stack.push_back({ { split.m_Mid, current.m_End, current.m_Depth + 1, split.m_RightBounds }, left + 1 });
+        stack.push_back({ { current.m_Begin, split.m_Mid, current.m_Depth + 1, split.m_LeftBounds }, left });
+    }
+}
+
+void CPUBVH4::Collapse(const std::vector<BinaryNode>& binaryNodes)
+{
+    // Every 4-wide node takes a binary node's children, then opens its largest interior
+    // children until it has 4
+    m_Nodes.reserve(binaryNodes.size() / 2 + 1);
+    m_Nodes.emplace_back();
+
+    std::vector<std::pair<uint32_t, uint32_t>> stack; // binary node, 4-wide node
+    if (binaryNodes[0].m_Count != 0)
+    {
+        // A single leaf: the root holds it alone
+        stack.push_back({ UINT32_MAX, 0 });
+    }
+    else
+    {
+        stack.push_back({ 0, 0 });
+    }
+
+    while (!stack.empty())
+    {
+        const auto [binary, node] = stack.back();
+        stack.pop_back();
+
+        uint32_t children[4];
+        uint32_t numChildren = 0;
+        if (binary == UINT32_MAX)
+        {
+            children[numChildren++] = 0;
+        }
+        else
+        {
+            children[numChildren++] = binaryNodes[binary].m_Left;
+            children[numChildren++] = binaryNodes[binary].m_Right;
+            while (numChildren < 4)
+            {
+                uint32_t largest = UINT32_MAX;
+                float largestArea = -1.0f;
+                for (uint32_t i = 0; i < numChildren; ++i)
+                {
+                    const BinaryNode& child = binaryNodes[children[i]];
+                    if (child.m_Count == 0 && child.m_Bounds.GetHalfArea() > largestArea)
+                    {
+                        largestArea = child.m_Bounds.GetHalfArea();
+                        largest = i;
+                    }
+                }
+                if (largest == UINT32_MAX)
+                    break;
+
+                const BinaryNode& opened = binaryNodes[children[largest]];
+                children[largest] = opened.m_Left;
+                children[numChildren++] = opened.m_Right;
+            }
+        }
+
+        uint32_t references[4];
+        for (uint32_t i = 0; i < numChildren; ++i)
+        {
+            const BinaryNode& child = binaryNodes[children[i]];
+            if (child.m_Count != 0)
+            {
+                SDL_assert(child.m_Count <= kMaxLeafSize);
+                references[i] = kLeafBit | (child.m_Left << 2) | (child.m_Count - 1);
+            }
+            else
+            {
+                references[i] = (uint32_t)m_Nodes.size();
+                m_Nodes.emplace_back();
+                stack.push_back({ children[i], references[i] });
+            }
+        }
+
+        Node& out = m_Nodes[node];
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            if (lane < numChildren)
+            {
+                const CPUBounds& b = binaryNodes[children[lane]].m_Bounds;
+                out.m_MinX[lane] = b.m_Min.x;
+                out.m_MinY[lane] = b.m_Min.y;
+                out.m_MinZ[lane] = b.m_Min.z;
+                out.m_MaxX[lane] = b.m_Max.x;
+                out.m_MaxY[lane] = b.m_Max.y;
+                out.m_MaxZ[lane] = b.m_Max.z;
+                out.m_Children[lane] = references[lane];
+            }
+            else
+            {
+                out.m_MinX[lane] = out.m_MinY[lane] = out.m_MinZ[lane] = INFINITY;
+                out.m_MaxX[lane] = out.m_MaxY[lane] = out.m_MaxZ[lane] = -INFINITY;
+                out.m_Children[lane] = kEmptyChild;
+            }
+        }
+    }
+}
+
+// ─── CPUMeshBVH ──────────────────────────────────────────────────────────────
+
+void CPUMeshBVH::Build(std::span<const uint32_t> indices, std::span<const srrhi::VertexQuantized> vertices, bool bKeepUVs, TaskScheduler* scheduler)
+{
+    PROFILE_FUNCTION();
+
+    m_Quads.clear();
+    m_QuadUVs.clear();
+    m_NumTriangles = 0;
+
+    const uint32_t numTriangles = (uint32_t)(indices.size() / 3);
+    std::vector<CPUBounds> triangleBounds(numTriangles);
+    for (uint32_t tri = 0; tri < numTriangles; ++tri)
+    {
+        CPUBounds& bounds = triangleBounds[tri];
+        for (uint32_t corner = 0; corner < 3; ++corner)
+        {
+            const uint32_t index = indices[tri * 3 + corner];
+            if (index >= vertices.size() || !IsFinite(vertices[index].m_Pos))
+            {
+                bounds = {};
+                break;
+            }
+            bounds.Grow(vertices[index].m_Pos);
+        }
+    }
+
+    m_BVH.Build(triangleBounds, scheduler);
+
+    // One quad per leaf, in node order
+    const std::vector<uint32_t>& order = m_BVH.GetPrimitiveOrder();
+    for (CPUBVH4::Node& node : m_BVH.GetNodes())
+    {
+        for (uint32_t& child : node.m_Children)
+        {
+            if (child == CPUBVH4::kEmptyChild || !(child & CPUBVH4::kLeafBit))
+                continue;
+
+            const uint32_t first = CPUBVH4::GetLeafFirst(child);
+            const uint32_t count = CPUBVH4::GetLeafCount(child);
+            child = CPUBVH4::kLeafBit | ((uint32_t)m_Quads.size() << 2);
+
+            TriangleQuad& quad = m_Quads.emplace_back();
+            TriangleQuadUVs* uvs = bKeepUVs ? &m_QuadUVs.emplace_back() : nullptr;
+            for (uint32_t lane = 0; lane < 4; ++lane)
+            {
+                if (lane >= count)
+                {
+                    quad.m_V0X[lane] = quad.m_V0Y[lane] = quad.m_V0Z[lane] = 0.0f;
+                    quad.m_E1X[lane] = quad.m_E1Y[lane] = quad.m_E1Z[lane] = 0.0f;
+                    quad.m_E2X[lane] = quad.m_E2Y[lane] = quad.m_E2Z[lane] = 0.0f;
+                    quad.m_PrimitiveIndex[lane] = UINT32_MAX;
+                    if (uvs)
+                        uvs->m_UV[lane][0] = uvs->m_UV[lane][1] = uvs->m_UV[lane][2] = {};
+                    continue;
+                }
+
+                const uint32_t tri = order[first + lane];
+                const srrhi::VertexQuantized& v0 = vertices[indices[tri * 3 + 0]];
+                const srrhi::VertexQuantized& v1 = vertices[indices[tri * 3 + 1]];
+                const srrhi::VertexQuantized& v2 = vertices[indices[tri * 3 + 2]];
+                quad.m_V0X[lane] = v0.m_Pos.x;
+                quad.m_V0Y[lane] = v0.m_Pos.y;
+                quad.m_V0Z[lane] = v0.m_Pos.z;
+                quad.m_E1X[lane] = v1.m_Pos.x - v0.m_Pos.x;
+                quad.m_E1Y[lane] = v1.m_Pos.y - v0.m_Pos.y;
+                quad.m_E1Z[lane] = v1.m_Pos.z - v0.m_Pos.z;
+                quad.m_E2X[lane] = v2.m_Pos.x - v0.m_Pos.x;
+                quad.m_E2Y[lane] = v2.m_Pos.y - v0.m_Pos.y;
+                quad.m_E2Z[lane] = v2.m_Pos.z - v0.m_Pos.z;
+                quad.m_PrimitiveIndex[lane] = tri;
+
+                if (uvs)
+                {
+                    const srrhi::VertexQuantized* corners[3] = { &v0, &v1, &v2 };
+                    for (uint32_t corner = 0; corner < 3; ++corner)
+                    {
+                        uvs->m_UV[lane][corner] = { meshopt_dequantizeHalf((unsigned short)(corners[corner]->m_Uv & 0xFFFF)),
+                                                    meshopt_dequantizeHalf((unsigned short)(corners[corner]->m_Uv >> 16)) };
+                    }
+                }
+            }
+            m_NumTriangles += count;
+        }
+    }
+}
+
+size_t CPUMeshBVH::GetMemoryBytes() const
+{
+    return m_BVH.GetNodes().size() * sizeof(CPUBVH4::Node) + m_BVH.GetPrimitiveOrder().size() * sizeof(uint32_t) +
+           m_Quads.size() * sizeof(TriangleQuad) + m_QuadUVs.size() * sizeof(TriangleQuadUVs);
+}
+
+// ─── CPUSceneRayQuery ────────────────────────────────────────────────────────
+
+bool CPUSceneRayQuery::Build(const Scene& scene, const Scene::CPUGeometryView& geometry, TaskScheduler& scheduler, uint32_t lod)
+{
+    PROFILE_FUNCTION();
+
+    SimpleTimer timer;
+
+    m_Meshes.clear();
+    m_Instances.clear();
+    m_AlphaMaterials.clear();
+    m_Stats = {};
+
+    if (geometry.m_Indices.empty() || geometry.m_VerticesQuantized.empty())
+        return false;
+
+    // Alpha-tested materials, and the meshes the instances use; a mesh keeps its UVs if
+    // any of its instances is alpha tested
+    std::vector<uint32_t> alphaOfMaterial(scene.m_Materials.size(), UINT32_MAX);
+    for (uint32_t i = 0; i < (uint32_t)scene.m_Materials.size(); ++i)
+    {
+        const srrhi::MaterialConstants& material = scene.m_Materials[i].m_GPU;
+        if (material.m_AlphaMode != (uint32_t)srrhi::CommonConsts::ALPHA_MODE_MASK)
+            continue;
+
+        alphaOfMaterial[i] = (uint32_t)m_AlphaMaterials.size();
+        AlphaMaterial& alpha = m_AlphaMaterials.emplace_back();
+        alpha.m_MaterialIndex = i;
+        alpha.m_BaseAlpha = material.m_BaseColor.w;
+        alpha.m_Cutoff = material.m_AlphaCutoff;
+        alpha.m_bSampleTexture = (material.m_TextureFlags & srrhi::CommonConsts::TEXFLAG_ALBEDO) != 0;
+    }
+
+    std::vector<uint32_t> meshOfMeshData(scene.m_MeshData.size(), UINT32_MAX);
+    std::vector<uint32_t> meshDataOfMesh;
+    std::vector<uint8_t> bKeepUVs;
+    m_Instances.resize(scene.m_InstanceData.size());
+    for (uint32_t i = 0; i < (uint32_t)scene.m_InstanceData.size(); ++i)
+    {
+        const srrhi::PerInstanceData& instanceData = scene.m_InstanceData[i];
+        if (instanceData.m_MeshDataIndex >= scene.m_MeshData.size())
+            continue;
+
+        uint32_t& mesh = meshOfMeshData[instanceData.m_MeshDataIndex];
+        if (mesh == UINT32_MAX)
+        {
+            mesh = (uint32_t)meshDataOfMesh.size();
+            meshDataOfMesh.push_back(instanceData.m_MeshDataIndex);
+            bKeepUVs.push_back(0);
+        }
+
+        Instance& instance = m_Instances[i];
+        instance.m_Mesh = mesh;
+        if (instanceData.m_MaterialIndex < alphaOfMaterial.size())
+        {
+            instance.m_AlphaMaterial = alphaOfMaterial[instanceData.m_MaterialIndex];
+            bKeepUVs[mesh] |= instance.m_AlphaMaterial != UINT32_MAX ? 1 : 0;
+        }
+    }
+
+    // The same LOD range BuildPrimitiveBLAS gives the GPU, in the cooked layout
+    m_Meshes.resize(meshDataOfMesh.size());
+    auto getIndices = [&](uint32_t mesh) -> std::span<const uint32_t> {
+        const srrhi::MeshData& meshData = scene.m_MeshData[meshDataOfMesh[mesh]];
+        if (meshData.m_LODCount == 0)
+            return {};
+        const uint32_t meshLOD = std::min(lod, meshData.m_LODCount - 1);
+        const size_t offset = meshData.m_IndexOffsets[meshLOD];
+        const size_t count = meshData.m_IndexCounts[meshLOD];
+        if (offset + count > geometry.m_Indices.size())
+        {
+            LOG_ERROR("[CPURayQuery] MeshData %u: LOD %u indices [%zu, %zu) past the cooked index array (%zu)",
+                      meshDataOfMesh[mesh], meshLOD, offset, offset + count, geometry.m_Indices.size());
+            return {};
+        }
+        return geometry.m_Indices.subspan(offset, count);
+    };
+
+    // Small meshes one per task; large ones one at a time, each building in parallel
+    std::vector<uint32_t> smallMeshes;
+    std::vector<uint32_t> largeMeshes;
+    for (uint32_t mesh = 0; mesh < (uint32_t)m_Meshes.size(); ++mesh)
+    {
+        const srrhi::MeshData& meshData = scene.m_MeshData[meshDataOfMesh[mesh]];
+        const uint32_t numTriangles = meshData.m_LODCount > 0 ? meshData.m_IndexCounts[std::min(lod, meshData.m_LODCount - 1)] / 3 : 0;
+        (numTriangles >= kMinParallelPrimitives ? largeMeshes : smallMeshes).push_back(mesh);
+    }
+    scheduler.ParallelFor((uint32_t)smallMeshes.size(), [&](uint32_t i, uint32_t) {
+        const uint32_t mesh = smallMeshes[i];
+        m_Meshes[mesh].Build(getIndices(mesh), geometry.m_VerticesQuantized, bKeepUVs[mesh] != 0, nullptr);
+    });
+    for (uint32_t mesh : largeMeshes)
+    {
+        m_Meshes[mesh].Build(getIndices(mesh), geometry.m_VerticesQuantized, bKeepUVs[mesh] != 0, &scheduler);
+    }
+
+    UpdateInstances(scene);
+
+    m_Stats.m_NumMeshes = (uint32_t)m_Meshes.size();
+    m_Stats.m_MemoryBytes = m_TopLevel.GetNodes().size() * sizeof(CPUBVH4::Node) + m_Instances.size() * sizeof(Instance);
+    for (const CPUMeshBVH& mesh : m_Meshes)
+    {
+        m_Stats.m_NumTriangles += mesh.GetNumTriangles();
+        m_Stats.m_MemoryBytes += mesh.GetMemoryBytes();
+    }
+    m_Stats.m_BuildMs = timer.TotalMilliseconds();
+
+    return true;
+}
+
+void CPUSceneRayQuery::UpdateInstances(const Scene& scene)
+{
+    PROFILE_FUNCTION();
+
+    SDL_assert(scene.m_InstanceData.size() == m_Instances.size());
+
+    // Instances without geometry or with a singular transform keep an empty box: the
+    // top level leaves them out
+    m_InstanceBounds.assign(m_Instances.size(), CPUBounds{});
+    m_Stats.m_NumInstances = 0;
+    for (uint32_t i = 0; i < (uint32_t)m_Instances.size(); ++i)
+    {
+        Instance& instance = m_Instances[i];
+        if (instance.m_Mesh == UINT32_MAX || m_Meshes[instance.m_Mesh].GetNumTriangles() == 0)
+            continue;
+
+        const XMMATRIX world = XMLoadFloat4x4(&scene.m_InstanceData[i].m_World);
+        XMVECTOR determinant;
+        const XMMATRIX worldToObject = XMMatrixInverse(&determinant, world);
+        if (XMVectorGetX(determinant) == 0.0f)
+            continue;
+        XMStoreFloat4x4(&instance.m_WorldToObject, worldToObject);
+
+        const CPUBounds& local = m_Meshes[instance.m_Mesh].GetBounds();
+        CPUBounds& bounds = m_InstanceBounds[i];
+        for (uint32_t corner = 0; corner < 8; ++corner)
+        {
+            const XMVECTOR p = XMVectorSet(corner & 1 ? local.m_Max.x : local.m_Min.x,
+                                           corner & 2 ? local.m_Max.y : local.m_Min.y,
+                                           corner & 4 ? local.m_Max.z : local.m_Min.z, 1.0f);
+            Vector3 worldCorner;
+            XMStoreFloat3(&worldCorner, XMVector3Transform(p, world));
+            bounds.Grow(worldCorner);
+        }
+        ++m_Stats.m_NumInstances;
+    }
+
+    m_TopLevel.Build(m_InstanceBounds, nullptr);
+}
+
+bool CPUSceneRayQuery::AlphaTest(const AlphaMaterial& alpha, const CPUMeshBVH& mesh, uint32_t quad, uint32_t lane, float u, float v) const
+{
+    float a = alpha.m_BaseAlpha;
+    if (alpha.m_bSampleTexture && m_AlphaTextureSampler && mesh.HasUVs())
+    {
+        const Vector2 (&uv)[3] = mesh.GetQuadUVs()[quad].m_UV[lane];
+        const float w = 1.0f - u - v;
+        a *= m_AlphaTextureSampler(alpha.m_MaterialIndex, uv[0].x * w + uv[1].x * u + uv[2].x * v, uv[0].y * w + uv[1].y * u + uv[2].y * v);
+    }
+    return a >= alpha.m_Cutoff;
+}
+
+template <bool bAnyHit>
+bool CPUSceneRayQuery::Trace(const CPURay& ray, CPURayHit& hit) const
+{
+    hit = {};
+    float tMax = ray.m_TMax;
+
+    const XMVECTOR origin = XMLoadFloat3(&ray.m_Origin);
+    const XMVECTOR direction = XMLoadFloat3(&ray.m_Direction);
+    const TraversalRay worldRay(origin, direction, ray.m_TMin);
+    const std::vector<uint32_t>& instanceOrder = m_TopLevel.GetPrimitiveOrder();
+
+    return TraverseBVH<bAnyHit>(m_TopLevel.GetNodes(), worldRay, tMax, [&](uint32_t instanceLeaf) {
+        const uint32_t first = CPUBVH4::GetLeafFirst(instanceLeaf);
+        const uint32_t count = CPUBVH4::GetLeafCount(instanceLeaf);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint32_t instanceIndex = instanceOrder[first + i];
+            const Instance& instance = m_Instances[instanceIndex];
+            const CPUMeshBVH& mesh = m_Meshes[instance.m_Mesh];
+            const AlphaMaterial* alpha = instance.m_AlphaMaterial != UINT32_MAX ? &m_AlphaMaterials[instance.m_AlphaMaterial] : nullptr;
+
+            // Unnormalized object-space direction: t is the same in both spaces
+            const XMMATRIX worldToObject = XMLoadFloat4x4(&instance.m_WorldToObject);
+            const TraversalRay objectRay(XMVector3Transform(origin, worldToObject), XMVector3TransformNormal(direction, worldToObject), ray.m_TMin);
+
+            const bool bDone = TraverseBVH<bAnyHit>(mesh.GetBVH().GetNodes(), objectRay, tMax, [&](uint32_t quadLeaf) {
+                const uint32_t quadIndex = CPUBVH4::GetLeafFirst(quadLeaf);
+                const CPUMeshBVH::TriangleQuad& quad = mesh.GetQuads()[quadIndex];
+
+                XMFLOAT4A t, u, v;
+                for (uint32_t bits = IntersectQuad(quad, objectRay, tMax, t, u, v); bits != 0; bits &= bits - 1)
+                {
+                    const uint32_t lane = std::countr_zero(bits);
+                    const float laneT = (&t.x)[lane];
+                    const float laneU = (&u.x)[lane];
+                    const float laneV = (&v.x)[lane];
+                    if (laneT >= tMax)
+                        continue;
+                    if (alpha && !AlphaTest(*alpha, mesh, quadIndex, lane, laneU, laneV))
+                        continue;
+
+                    tMax = laneT;
+                    hit.m_InstanceIndex = instanceIndex;
+                    hit.m_PrimitiveIndex = quad.m_PrimitiveIndex[lane];
+                    hit.m_Barycentrics = { laneU, laneV };
+                    hit.m_RayT = laneT;
+                    if constexpr (bAnyHit)
+                        return true;
+                }
+                return false;
+            });
+            if (bDone)
+                return true;
+        }
+        return false;
+    }) || hit.IsHit();
+}
+
+bool CPUSceneRayQuery::TraceClosest(const CPURay& ray, CPURayHit& outHit) const
+{
+    return Trace<false>(ray, outHit);
+}
+
+bool CPUSceneRayQuery::TraceAny(const CPURay& ray) const
+{
+    CPURayHit hit;
+    return Trace<true>(ray, hit);
+}
+
+void CPUSceneRayQuery::TraceClosest(std::span<const CPURay> rays, std::span<CPURayHit> outHits, TaskScheduler& scheduler) const
+{
+    PROFILE_FUNCTION();
+    SDL_assert(outHits.size() >= rays.size());
+
+    const uint32_t numRays = (uint32_t)rays.size();
+    scheduler.ParallelFor((numRays + kRaysPerTask - 1) / kRaysPerTask, [&](uint32_t task, uint32_t) {
+        for (uint32_t i = task * kRaysPerTask; i < std::min(numRays, (task + 1) * kRaysPerTask); ++i)
+        {
+            Trace<false>(rays[i], outHits[i]);
+        }
+    });
+}
+
+void CPUSceneRayQuery::TraceAny(std::span<const CPURay> rays, std::span<uint8_t> outOccluded, TaskScheduler& scheduler) const
+{
+    PROFILE_FUNCTION();
+    SDL_assert(outOccluded.size() >= rays.size());
+
+    const uint32_t numRays = (uint32_t)rays.size();
+    scheduler.ParallelFor((numRays + kRaysPerTask - 1) / kRaysPerTask, [&](uint32_t task, uint32_t) {
+        for (uint32_t i = task * kRaysPerTask; i < std::min(numRays, (task + 1) * kRaysPerTask); ++i)
+        {
+            CPURayHit hit;
+            outOccluded[i] = Trace<true>(rays[i], hit) ? 1 : 0;
+        }
+    });
+}
+
+// ─── ValidateRayTracingInputs ────────────────────────────────────────────────
+
+uint32_t ValidateRayTracingInputs(const Scene& scene, const Scene::CPUGeometryView& geometry)
+{
+    PROFILE_FUNCTION();
+
+    ProblemLog problems;
+    const std::span<const srrhi::VertexQuantized> vertices = geometry.m_VerticesQuantized;
+    const std::span<const uint32_t> indices = geometry.m_Indices;
+
+    // BLAS inputs: every LOD with a BLAS
+    std::vector<const Scene::Primitive*> primitiveOfMeshData(scene.m_MeshData.size(), nullptr);
+    uint32_t numPrimitives = 0;
+    uint32_t numBLAS = 0;
+    uint64_t numTriangles = 0;
+    uint64_t numDegenerateTriangles = 0;
+    for (uint32_t meshIndex = 0; meshIndex < (uint32_t)scene.m_Meshes.size(); ++meshIndex)
+    {
+        const Scene::Mesh& mesh = scene.m_Meshes[meshIndex];
+        for (const Scene::Primitive& primitive : mesh.m_Primitives)
+        {
+            ++numPrimitives;
+            if (primitive.m_MeshDataIndex >= scene.m_MeshData.size())
+            {
+                problems.Report("Primitive MeshData index out of range", "mesh %u: MeshData %u of %zu", meshIndex, primitive.m_MeshDataIndex, scene.m_MeshData.size());
+                continue;
+            }
+            primitiveOfMeshData[primitive.m_MeshDataIndex] = &primitive;
+
+            const uint64_t vertexEnd = (uint64_t)primitive.m_VertexOffset + primitive.m_VertexCount;
+            if (vertexEnd > vertices.size())
+            {
+                problems.Report("Primitive vertices past the cooked vertex array", "mesh %u: [%u, %llu) of %zu", meshIndex, primitive.m_VertexOffset, (unsigned long long)vertexEnd, vertices.size());
+                continue;
+            }
+
+            // The culling and TLAS instance spheres derive from the mesh's local sphere
+            const XMVECTOR center = XMLoadFloat3(&mesh.m_Center);
+            const float maxDistance = mesh.m_Radius * 1.001f + 1e-4f;
+            for (uint32_t v = primitive.m_VertexOffset; v < vertexEnd; ++v)
+            {
+                const Vector3& position = vertices[v].m_Pos;
+                if (!IsFinite(position))
+                {
+                    problems.Report("Non-finite vertex position", "mesh %u: vertex %u", meshIndex, v);
+                    continue;
+                }
+                const float distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&position), center)));
+                if (distance > maxDistance)
+                {
+                    problems.Report("Vertex outside its mesh's bounding sphere", "mesh %u: vertex %u at %.4f, radius %.4f", meshIndex, v, distance, mesh.m_Radius);
+                }
+            }
+
+            const srrhi::MeshData& meshData = scene.m_MeshData[primitive.m_MeshDataIndex];
+            for (uint32_t lod = 0; lod < std::min(meshData.m_LODCount, (uint32_t)primitive.m_BLAS.size()); ++lod)
+            {
+                if (!primitive.m_BLAS[lod])
+                    continue;
+                ++numBLAS;
+
+                const nvrhi::rt::GeometryDesc desc = scene.GetBLASGeometryDesc(primitive, lod);
+                const nvrhi::rt::GeometryTriangles& triangles = desc.geometryData.triangles;
+                if (triangles.indexFormat != nvrhi::Format::R32_UINT || triangles.vertexFormat != nvrhi::Format::RGB32_FLOAT ||
+                    triangles.vertexStride != sizeof(srrhi::VertexQuantized))
+                {
+                    problems.Report("Unexpected BLAS index or vertex format", "MeshData %u LOD %u", primitive.m_MeshDataIndex, lod);
+                }
+                if (triangles.indexCount != meshData.m_IndexCounts[lod])
+                {
+                    problems.Report("BLAS index count differs from the cooked LOD", "MeshData %u LOD %u: %u, cooked %u",
+                                    primitive.m_MeshDataIndex, lod, triangles.indexCount, meshData.m_IndexCounts[lod]);
+                }
+                if (meshData.m_IndexCounts[lod] % 3 != 0)
+                {
+                    problems.Report("LOD index count not a multiple of 3", "MeshData %u LOD %u: %u", primitive.m_MeshDataIndex, lod, meshData.m_IndexCounts[lod]);
+                }
+
+                const uint64_t indexBegin = meshData.m_IndexOffsets[lod];
+                const uint64_t indexEnd = indexBegin + meshData.m_IndexCounts[lod] / 3 * 3;
+                if (indexEnd > indices.size())
+                {
+                    problems.Report("LOD indices past the cooked index array", "MeshData %u LOD %u: [%llu, %llu) of %zu",
+                                    primitive.m_MeshDataIndex, lod, (unsigned long long)indexBegin, (unsigned long long)indexEnd, indices.size());
+                    continue;
+                }
+
+                for (uint64_t i = indexBegin; i < indexEnd; i += 3)
+                {
+                    bool bInRange = true;
+                    for (uint32_t corner = 0; corner < 3; ++corner)
+                    {
+                        const uint32_t index = indices[i + corner];
+                        if (index < primitive.m_VertexOffset || index >= vertexEnd)
+                        {
+                            problems.Report("Index outside its primitive's vertices", "MeshData %u LOD %u: index %u, vertices [%u, %llu)",
+                                            primitive.m_MeshDataIndex, lod, index, primitive.m_VertexOffset, vertexEnd);
+                            bInRange = false;
+                        }
+                        if (index >= triangles.vertexCount)
+                        {
+                            problems.Report("Index past the BLAS vertex count", "MeshData %u LOD %u: index %u, vertex count %u",
+                                            primitive.m_MeshDataIndex, lod, index, triangles.vertexCount);
+                        }
+                    }
+                    ++numTriangles;
+                    if (!bInRange)
+                        continue;
+
+                    // Zero-area triangles are inactive on the GPU: legal, but wasted
+                    const XMVECTOR p0 = XMLoadFloat3(&vertices[indices[i + 0]].m_Pos);
+                    const XMVECTOR p1 = XMLoadFloat3(&vertices[indices[i + 1]].m_Pos);
+                    const XMVECTOR p2 = XMLoadFloat3(&vertices[indices[i + 2]].m_Pos);
+                    if (XMVector3Equal(XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0)), XMVectorZero()))
+                        ++numDegenerateTriangles;
+                }
+            }
+        }
+    }
+
+    // TLAS inputs: the instance descs as first uploaded (TLASPatch_CS only rewrites the BLAS addresses)
+    const uint32_t numInstances = (uint32_t)scene.m_RTInstanceDescs.size();
+    if (numInstances != 0 && numInstances != scene.m_InstanceData.size())
+    {
+        problems.Report("Instance desc count differs from the instance count", "%u descs, %zu instances", numInstances, scene.m_InstanceData.size());
+    }
+    for (uint32_t i = 0; i < std::min(numInstances, (uint32_t)scene.m_InstanceData.size()); ++i)
+    {
+        const nvrhi::rt::InstanceDesc& desc = scene.m_RTInstanceDescs[i];
+        const srrhi::PerInstanceData& instanceData = scene.m_InstanceData[i];
+
+        if (desc.instanceID != i)
+        {
+            problems.Report("Instance ID differs from its instance index", "instance %u: ID %u", i, (uint32_t)desc.instanceID);
+        }
+        if (desc.instanceMask == 0)
+        {
+            problems.Report("Instance mask is zero", "instance %u", i);
+        }
+
+        // Row-vector world matrix, transposed into the 3x4 transform
+        const Matrix& world = instanceData.m_World;
+        const float expected[12] = { world._11, world._21, world._31, world._41,
+                                     world._12, world._22, world._32, world._42,
+                                     world._13, world._23, world._33, world._43 };
+        if (std::memcmp(expected, desc.transform, sizeof(expected)) != 0)
+        {
+            problems.Report("Instance transform differs from its world matrix", "instance %u", i);
+        }
+        XMVECTOR determinant = XMMatrixDeterminant(XMLoadFloat4x4(&world));
+        if (!std::isfinite(XMVectorGetX(determinant)) || XMVectorGetX(determinant) == 0.0f)
+        {
+            problems.Report("Instance transform is singular or not finite", "instance %u", i);
+        }
+
+        // Opacity: the shaders alpha test with the instance's material
+        const bool bOpaque = instanceData.m_MaterialIndex >= scene.m_Materials.size() ||
+                             scene.m_Materials[instanceData.m_MaterialIndex].m_GPU.m_AlphaMode == (uint32_t)srrhi::CommonConsts::ALPHA_MODE_OPAQUE;
+        const bool bForceOpaque = (desc.flags & nvrhi::rt::InstanceFlags::ForceOpaque) != nvrhi::rt::InstanceFlags::None;
+        if (bOpaque != bForceOpaque)
+        {
+            problems.Report("Instance opacity flag disagrees with its material", "instance %u: material %u, ForceOpaque %d", i, instanceData.m_MaterialIndex, bForceOpaque ? 1 : 0);
+        }
+
+        const Scene::Primitive* primitive = instanceData.m_MeshDataIndex < primitiveOfMeshData.size() ? primitiveOfMeshData[instanceData.m_MeshDataIndex] : nullptr;
+        if (!primitive)
+        {
+            problems.Report("Instance MeshData has no primitive", "instance %u: MeshData %u", i, instanceData.m_MeshDataIndex);
+            continue;
+        }
+        if ((primitive->m_ResidentLODMask != 0) != (desc.blasDeviceAddress != 0))
+        {
+            problems.Report("Instance BLAS address disagrees with its residency", "instance %u: resident LODs 0x%02x, address 0x%llx",
+                            i, primitive->m_ResidentLODMask, (unsigned long long)desc.blasDeviceAddress);
+        }
+        else if (desc.blasDeviceAddress != 0 &&
+                 std::none_of(primitive->m_BLAS.begin(), primitive->m_BLAS.end(), [&desc](const nvrhi::rt::AccelStructHandle& blas) { return blas && blas->getDeviceAddress() == desc.blasDeviceAddress; }))
+        {
+            problems.Report("Instance BLAS address is not one of its primitive's BLASes", "instance %u: address 0x%llx", i, (unsigned long long)desc.blasDeviceAddress);
+        }
+    }
+
+    const uint32_t numProblems = problems.Flush();
+    LOG_INFO("[CPURayQuery] Validated %u primitives (%u BLASes, %llu triangles, %llu degenerate) and %u instance descs: %u problems",
+             numPrimitives, numBLAS, (unsigned long long)numTriangles, (unsigned long long)numDegenerateTriangles, numInstances, numProblems);
+    return numProblems;
+}
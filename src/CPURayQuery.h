@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Scene.h"
+
+class TaskScheduler;
+
+// ─── CPU ray queries ─────────────────────────────────────────────────────────
+// Closest-hit and any-hit ray queries against the scene on the CPU, for tools
+// that should not need the GPU (baking, visibility precompute, reference
+// renders) and for checking the ray tracing inputs.
+//
+// CPUSceneRayQuery builds, from the cooked mesh cache (Scene::MapCPUGeometry):
+//   - one bottom-level BVH per primitive, over the triangles of one LOD, the
+//     same index range BuildPrimitiveBLAS hands the GPU,
+//   - one top-level BVH over the instances of Scene::m_InstanceData.
+//
+// Both are 4-wide BVHs: binned SAH binary trees (built with ParallelFor)
+// collapsed so that every node holds 4 children boxes, tested with one
+// DirectXMath ray-vs-4-boxes test.  Leaves hold up to 4 triangles, tested
+// together, or up to 4 instances.
+//
+// Hits follow the GPU conventions (RayHitInfo in RaytracingCommon.hlsli):
+// no face culling, barycentrics of vertices 1 and 2, primitive index within
+// the LOD's index range.  Materials with ALPHA_MODE_MASK are alpha tested
+// like AlphaTest(): base colour alpha times the albedo texture's, if any,
+// against the cutoff.  Blended materials are treated as opaque.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct CPURay
+{
+    Vector3 m_Origin{};
+    float   m_TMin = 0.0f;
+    Vector3 m_Direction{ 0.0f, 0.0f, 1.0f }; // need not be normalized; t is in its units
+    float   m_TMax = FLT_MAX;
+};
+
+struct CPURayHit
+{
+    uint32_t m_InstanceIndex  = UINT32_MAX; // into Scene::m_InstanceData; UINT32_MAX on a miss
+    uint32_t m_PrimitiveIndex = 0;          // triangle within the LOD's index range
+    Vector2  m_Barycentrics{};              // weights of vertices 1 and 2
+    float    m_RayT = FLT_MAX;
+
+    bool IsHit() const { return m_InstanceIndex != UINT32_MAX; }
+};
+
+// Axis-aligned box, empty when m_Min > m_Max
+struct CPUBounds
+{
+    Vector3 m_Min{ FLT_MAX, FLT_MAX, FLT_MAX };
+    Vector3 m_Max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    void Grow(const Vector3& p);
+    void Grow(const CPUBounds& b);
+    float GetHalfArea() const;
+    bool IsEmpty() const { return m_Min.x > m_Max.x; }
+};
+
+// ─── CPUBVH4 ─────────────────────────────────────────────────────────────────
+// 4-wide BVH over primitive boxes.  Leaves reference runs of GetPrimitiveOrder().
+class CPUBVH4
+{
+public:
+    static constexpr uint32_t kMaxLeafSize = 4;
+
+    // Child references
+    static constexpr uint32_t kEmptyChild = UINT32_MAX;
+    static constexpr uint32_t kLeafBit    = 0x80000000u;
+    // Leaf: kLeafBit | (first << 2) | (count - 1), first indexing GetPrimitiveOrder()
+    static uint32_t GetLeafFirst(uint32_t child) { return (child & ~kLeafBit) >> 2; }
+    static uint32_t GetLeafCount(uint32_t child) { return (child & 3u) + 1; }
+
+    // Children boxes one per lane; empty children have an inverted infinite box, which
+    // no ray hits
+    struct alignas(16) Node
+    {
+        float    m_MinX[4], m_MinY[4], m_MinZ[4];
+        float    m_MaxX[4], m_MaxY[4], m_MaxZ[4];
+        uint32_t m_Children[4];
+    };
+
+    // Parallel over the top subtrees when scheduler is set and there are enough primitives.
+    // Primitives with empty bounds are left out.
+    void Build(std::span<const CPUBounds> primitiveBounds, TaskScheduler* scheduler);
+
+    const std::vector<Node>& GetNodes() const { return m_Nodes; }
+    std::vector<Node>& GetNodes() { return m_Nodes; }
+    const std::vector<uint32_t>& GetPrimitiveOrder() const { return m_PrimitiveOrder; }
+    const CPUBounds& GetBounds() const { return m_Bounds; }
+    bool IsEmpty() const { return m_Nodes.empty(); }
+
+private:
+    struct BinaryNode
+    {
+        CPUBounds m_Bounds;
+        uint32_t  m_Left  = 0; // interior: child nodes; leaf: first primitive and count
+        uint32_t  m_Right = 0;
+        uint32_t  m_Count = 0; // 0 for interior nodes
+    };
+
+    struct BuildRange
+    {
+        uint32_t  m_Begin = 0;
+        uint32_t  m_End   = 0;
+        uint32_t  m_Depth = 0;
+        CPUBounds m_Bounds;
+    };
+
+    struct SplitResult
+    {
+        uint32_t  m_Mid = 0; // == m_Begin: make a leaf
+        CPUBounds m_LeftBounds;
+        CPUBounds m_RightBounds;
+    };
+
+    SplitResult Split(const BuildRange& range);
+    void BuildSubtree(const BuildRange& range, std::vector<BinaryNode>& outNodes);
+    void Collapse(const std::vector<BinaryNode>& binaryNodes);
+
+    std::span<const CPUBounds> m_PrimitiveBounds;
+    std::vector<Vector3>       m_Centroids;
+    std::vector<uint32_t>      m_PrimitiveOrder;
+    std::vector<Node>          m_Nodes;
+    CPUBounds                  m_Bounds;
+};
+
+// ─── CPUMeshBVH ──────────────────────────────────────────────────────────────
+// Triangles of one primitive LOD, in mesh space.
+class CPUMeshBVH
+{
+public:
+    // Four triangles, one per lane, as vertex 0 and the two edges from it.  Unused lanes
+    // are degenerate and never hit.
+    struct alignas(16) TriangleQuad
+    {
+        float    m_V0X[4], m_V0Y[4], m_V0Z[4];
+        float    m_E1X[4], m_E1Y[4], m_E1Z[4];
+        float    m_E2X[4], m_E2Y[4], m_E2Z[4];
+        uint32_t m_PrimitiveIndex[4];
+    };
+
+    // Vertex UVs of a quad's triangles, for alpha testing
+    struct TriangleQuadUVs
+    {
+        Vector2 m_UV[4][3];
+    };
+
+    // indices are the LOD's index range, into vertices.  Triangles with non-finite
+    // vertices are left out, as the GPU builders treat them as inactive.
+    void Build(std::span<const uint32_t> indices, std::span<const srrhi::VertexQuantized> vertices, bool bKeepUVs, TaskScheduler* scheduler);
+
+    const CPUBounds& GetBounds() const { return m_BVH.GetBounds(); }
+    uint32_t GetNumTriangles() const { return m_NumTriangles; }
+    bool HasUVs() const { return !m_QuadUVs.empty(); }
+    size_t GetMemoryBytes() const;
+
+    const CPUBVH4& GetBVH() const { return m_BVH; }
+    const std::vector<TriangleQuad>& GetQuads() const { return m_Quads; }
+    const std::vector<TriangleQuadUVs>& GetQuadUVs() const { return m_QuadUVs; }
+
+private:
+    // The BVH's leaves reference quads: kLeafBit | (quad << 2) | 0
+    CPUBVH4                      m_BVH;
+    std::vector<TriangleQuad>    m_Quads;
+    std::vector<TriangleQuadUVs> m_QuadUVs;
+    uint32_t                     m_NumTriangles = 0;
+};
+
+struct CPUSceneRayQueryStats
+{
+    uint32_t m_NumMeshes     = 0;
+    uint32_t m_NumInstances  = 0; // in the top-level BVH
+    uint64_t m_NumTriangles  = 0; // over the meshes, not instanced
+    uint64_t m_MemoryBytes   = 0;
+    double   m_BuildMs       = 0.0;
+};
+
+// ─── CPUSceneRayQuery ────────────────────────────────────────────────────────
+class CPUSceneRayQuery
+{
+public:
+    // Albedo alpha of a material at uv.  The CPU has no copies of the textures: without a
+    // sampler, alpha-tested materials use their base colour alpha alone.  Called from the
+    // threads that run the queries.
+    using AlphaTextureSampler = std::function<float(uint32_t materialIndex, float u, float v)>;
+
+    // Builds the meshes of the scene's instances at lod (clamped to each primitive's LOD
+    // count) and the top-level BVH.  Returns false if the geometry is unavailable.
+    bool Build(const Scene& scene, const Scene::CPUGeometryView& geometry, TaskScheduler& scheduler, uint32_t lod = 0);
+
+    // Refits to the current Scene::m_InstanceData transforms (rebuilds the top level only)
+    void UpdateInstances(const Scene& scene);
+
+    void SetAlphaTextureSampler(AlphaTextureSampler sampler) { m_AlphaTextureSampler = std::move(sampler); }
+
+    // Thread-safe
+    bool TraceClosest(const CPURay& ray, CPURayHit& outHit) const;
+    bool TraceAny(const CPURay& ray) const;
+
+    // Batches, ParallelFor over chunks of rays
+    void TraceClosest(std::span<const CPURay> rays, std::span<CPURayHit> outHits, TaskScheduler& scheduler) const;
+    void TraceAny(std::span<const CPURay> rays, std::span<uint8_t> outOccluded, TaskScheduler& scheduler) const;
+
+    const CPUSceneRayQueryStats& GetStats() const { return m_Stats; }
+    bool IsEmpty() const { return m_TopLevel.IsEmpty(); }
+
+private:
+    struct AlphaMaterial
+    {
+        uint32_t m_MaterialIndex  = 0;
+        float    m_BaseAlpha      = 1.0f;
+        float    m_Cutoff         = 0.5f;
+        bool     m_bSampleTexture = false; // TEXFLAG_ALBEDO
+    };
+
+    struct Instance
+    {
+        Matrix   m_WorldToObject;
+        uint32_t m_Mesh          = UINT32_MAX; // into m_Meshes
+        uint32_t m_AlphaMaterial = UINT32_MAX; // into m_AlphaMaterials, UINT32_MAX if opaque
+    };
+
+    template <bool bAnyHit>
+    bool Trace(const CPURay& ray, CPURayHit& hit) const;
+    bool AlphaTest(const AlphaMaterial& alpha, const CPUMeshBVH& mesh, uint32_t quad, uint32_t lane, float u, float v) const;
+
+    std::vector<CPUMeshBVH>    m_Meshes;
+    std::vector<Instance>      m_Instances;      // by Scene::m_InstanceData index
+    std::vector<AlphaMaterial> m_AlphaMaterials;
+    CPUBVH4                    m_TopLevel;       // over m_Instances
+    std::vector<CPUBounds>     m_InstanceBounds; // top-level build input
+
+    AlphaTextureSampler   m_AlphaTextureSampler;
+    CPUSceneRayQueryStats m_Stats;
+};
+
+// Checks the inputs BuildAccelerationStructures gave the GPU builders against the cooked
+// geometry: BLAS index ranges, vertex ranges and positions, mesh bounds, and the TLAS
+// instance descs (IDs, transforms, opacity flags, BLAS addresses).  Logs each kind of
+// problem with a count and its first occurrence; returns the number of problems.
+uint32_t ValidateRayTracingInputs(const Scene& scene, const Scene::CPUGeometryView& geometry);
@@ -1,5 +1,6 @@
 #include "Config.h"
 #include "Renderer.h"
+#include "Log.h"
 
 void Config::ParseCommandLine(int argc, char* argv[])
 {
@@ -12,19 +13,19 @@ void Config::ParseCommandLine(int argc, char* argv[])
         if (std::strcmp(arg, "--rhidebug") == 0)
         {
             s_Instance.m_EnableValidation = true;
-            SDL_Log("[Config] Validation enabled via command line");
+            LOG_INFO("[Config] Validation enabled via command line");
         }
         else if (std::strcmp(arg, "--rhidebug-gpu") == 0)
         {
             s_Instance.m_EnableGPUAssistedValidation = true;
-            SDL_Log("[Config] GPU-assisted validation enabled via command line");
+            LOG_INFO("[Config] GPU-assisted validation enabled via command line");
         }
         else if (std::strcmp(arg, "--scene") == 0)
         {
             if (i + 1 < argc)
             {
                 s_Instance.m_ScenePath = argv[++i];
-                SDL_Log("[Config] Scene set via command line: %s", s_Instance.m_ScenePath.c_str());
+                LOG_INFO("[Config] Scene set via command line: %s", s_Instance.m_ScenePath.c_str());
             }
             else
             {
@@ -36,7 +37,7 @@ void Config::ParseCommandLine(int argc, char* argv[])
             if (i + 1 < argc)
             {
                 g_Renderer.m_IrradianceTexturePath = argv[++i];
-                SDL_Log("[Config] Irradiance texture set via command line: %s", g_Renderer.m_IrradianceTexturePath.c_str());
+                LOG_INFO("[Config] Irradiance texture set via command line: %s", g_Renderer.m_IrradianceTexturePath.c_str());
             }
             else
             {
@@ -48,7 +49,7 @@ void Config::ParseCommandLine(int argc, char* argv[])
             if (i + 1 < argc)
             {
                 g_Renderer.m_RadianceTexturePath = argv[++i];
-                SDL_Log("[Config] Radiance texture set via command line: %s", g_Renderer.m_RadianceTexturePath.c_str());
+                LOG_INFO("[Config] Radiance texture set via command line: %s", g_Renderer.m_RadianceTexturePath.c_str());
             }
             else
             {
@@ -65,9 +66,9 @@ void Config::ParseCommandLine(int argc, char* argv[])
                 g_Renderer.m_IrradianceTexturePath = (parent / (stem + "_irradiance.dds")).string();
                 g_Renderer.m_RadianceTexturePath = (parent / (stem + "_radiance.dds")).string();
 
-                SDL_Log("[Config] Environment map set via command line: %s", envMapPath.string().c_str());
-                SDL_Log("[Config] Irradiance: %s", g_Renderer.m_IrradianceTexturePath.c_str());
-                SDL_Log("[Config] Radiance: %s", g_Renderer.m_RadianceTexturePath.c_str());
+                LOG_INFO("[Config] Environment map set via command line: %s", envMapPath.string().c_str());
+                LOG_INFO("[Config] Irradiance: %s", g_Renderer.m_IrradianceTexturePath.c_str());
+                LOG_INFO("[Config] Radiance: %s", g_Renderer.m_RadianceTexturePath.c_str());
 
                 if (!std::filesystem::exists(g_Renderer.m_IrradianceTexturePath)) {
                     SDL_LOG_ASSERT_FAIL("Irradiance map not found", "Irradiance map not found: %s", g_Renderer.m_IrradianceTexturePath.c_str());
@@ -86,7 +87,7 @@ void Config::ParseCommandLine(int argc, char* argv[])
             if (i + 1 < argc)
             {
                 g_Renderer.m_BRDFLutTexture = argv[++i];
-                SDL_Log("[Config] BRDF LUT texture set via command line: %s", g_Renderer.m_BRDFLutTexture.c_str());
+                LOG_INFO("[Config] BRDF LUT texture set via command line: %s", g_Renderer.m_BRDFLutTexture.c_str());
                 
                 if (!std::filesystem::exists(g_Renderer.m_BRDFLutTexture)) {
                     SDL_LOG_ASSERT_FAIL("BRDF LUT not found", "BRDF LUT not found: %s", g_Renderer.m_BRDFLutTexture.c_str());
@@ -100,37 +101,285 @@ void Config::ParseCommandLine(int argc, char* argv[])
         else if (std::strcmp(arg, "--execute-per-pass") == 0)
         {
             s_Instance.ExecutePerPass = true;
-            SDL_Log("[Config] Execute per pass enabled via command line");
+            LOG_INFO("[Config] Execute per pass enabled via command line");
         }
         else if (std::strcmp(arg, "--execute-per-pass-and-wait") == 0)
         {
             s_Instance.ExecutePerPassAndWait = true;
-            SDL_Log("[Config] Execute per pass and wait enabled via command line");
+            LOG_INFO("[Config] Execute per pass and wait enabled via command line");
         }
         else if (std::strcmp(arg, "--disable-rendergraph-aliasing") == 0)
         {
             s_Instance.m_EnableRenderGraphAliasing = false;
-            SDL_Log("[Config] Render graph aliasing disabled via command line");
+            LOG_INFO("[Config] Render graph aliasing disabled via command line");
+        }
+        else if (std::strcmp(arg, "--keep-cpu-geometry") == 0)
+        {
+            s_Instance.m_KeepCPUGeometry = true;
+            LOG_INFO("[Config] CPU geometry copies kept resident via command line");
+        }
+        else if (std::strcmp(arg, "--disable-geometry-streaming") == 0)
+        {
+            s_Instance.m_EnableGeometryStreaming = false;
+            LOG_INFO("[Config] Geometry LOD streaming disabled via command line");
+        }
+        else if (std::strcmp(arg, "--geometry-pool-mb") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_GeometryPoolMB = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+                LOG_INFO("[Config] Geometry streaming pool size set via command line: %u MB", s_Instance.m_GeometryPoolMB);
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --geometry-pool-mb", "[Config] Missing value for --geometry-pool-mb");
+            }
+        }
+        else if (std::strcmp(arg, "--disable-scene-cell-streaming") == 0)
+        {
+            s_Instance.m_EnableSceneCellStreaming = false;
+            LOG_INFO("[Config] Scene cell streaming disabled via command line");
+        }
+        else if (std::strcmp(arg, "--scene-cell-pool-mb") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_SceneCellPoolMB = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+                LOG_INFO("[Config] Scene cell streaming pool size set via command line: %u MB", s_Instance.m_SceneCellPoolMB);
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --scene-cell-pool-mb", "[Config] Missing value for --scene-cell-pool-mb");
+            }
+        }
+        else if (std::strcmp(arg, "--vram-budget") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_VRAMBudgetMB = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+                LOG_INFO("[Config] VRAM budget set via command line: %u MB", s_Instance.m_VRAMBudgetMB);
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --vram-budget", "[Config] Missing value for --vram-budget");
+            }
+        }
+        else if (std::strcmp(arg, "--tile-io") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                const char* backend = argv[++i];
+                if (std::strcmp(backend, "read") == 0 || std::strcmp(backend, "mmap") == 0)
+                {
+                    s_Instance.m_TileIOExplicitReads = (std::strcmp(backend, "read") == 0);
+                    LOG_INFO("[Config] Streaming tile I/O backend set via command line: %s", backend);
+                }
+                else
+                {
+                    LOG_WARN("[Config] Unknown --tile-io backend: %s (expected mmap or read)", backend);
+                }
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --tile-io", "[Config] Missing value for --tile-io");
+            }
+        }
+        else if (std::strcmp(arg, "--tile-io-queue-depth") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_TileIOQueueDepth = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+                LOG_INFO("[Config] Streaming tile I/O queue depth set via command line: %u", s_Instance.m_TileIOQueueDepth);
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --tile-io-queue-depth", "[Config] Missing value for --tile-io-queue-depth");
+            }
+        }
+        else if (std::strcmp(arg, "--tile-cache-mb") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_TileCacheMB = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+                LOG_INFO("[Config] Streaming tile cache size set via command line: %u MB", s_Instance.m_TileCacheMB);
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --tile-cache-mb", "[Config] Missing value for --tile-cache-mb");
+            }
+        }
+        else if (std::strcmp(arg, "--cook-tdds") == 0)
+        {
+            s_Instance.m_CookTiledDDS = true;
+            LOG_INFO("[Config] .tdds cooking enabled via command line");
+        }
+        else if (std::strcmp(arg, "--tdds-compression") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                const char* codec = argv[++i];
+                static const char* const kCodecs[] = { "none", "lz4", "zstd" };
+                auto it = std::find_if(std::begin(kCodecs), std::end(kCodecs), [codec](const char* name) { return std::strcmp(codec, name) == 0; });
+                if (it != std::end(kCodecs))
+                {
+                    s_Instance.m_TiledDDSCompression = (uint32_t)(it - std::begin(kCodecs));
+                    LOG_INFO("[Config] .tdds tile compression set via command line: %s", codec);
+                }
+                else
+                {
+                    LOG_WARN("[Config] Unknown --tdds-compression codec: %s (expected none, lz4 or zstd)", codec);
+                }
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --tdds-compression", "[Config] Missing value for --tdds-compression");
+            }
+        }
+        else if (std::strcmp(arg, "--verify-tdds") == 0)
+        {
+            s_Instance.m_VerifyTiledDDS = true;
+            LOG_INFO("[Config] .tdds verification enabled via command line");
+        }
+        else if (std::strcmp(arg, "--validate-rt-inputs") == 0)
+        {
+            s_Instance.m_ValidateRTInputs = true;
+            LOG_INFO("[Config] Ray tracing input validation enabled via command line");
+        }
+        else if (std::strcmp(arg, "--disable-tile-prefetch") == 0)
+        {
+            s_Instance.m_EnableTilePrefetch = false;
+            LOG_INFO("[Config] Predictive tile prefetch disabled via command line");
+        }
+        else if (std::strcmp(arg, "--record-camera-path") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_RecordCameraPath = argv[++i];
+                LOG_INFO("[Config] Camera path recording set via command line: %s", s_Instance.m_RecordCameraPath.c_str());
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --record-camera-path", "[Config] Missing value for --record-camera-path");
+            }
+        }
+        else if (std::strcmp(arg, "--prefetch-replay") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_PrefetchReplayPath = argv[++i];
+                LOG_INFO("[Config] Prefetch replay camera path set via command line: %s", s_Instance.m_PrefetchReplayPath.c_str());
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --prefetch-replay", "[Config] Missing value for --prefetch-replay");
+            }
+        }
+        else if (std::strcmp(arg, "--fixed-streaming-budgets") == 0)
+        {
+            s_Instance.m_AdaptiveStreamingBudgets = false;
+            LOG_INFO("[Config] Adaptive streaming budgets disabled via command line");
+        }
+        else if (std::strcmp(arg, "--streaming-heap-tiles") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_StreamingHeapSizeInTiles = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+                LOG_INFO("[Config] Streaming heap size set via command line: %u tiles", s_Instance.m_StreamingHeapSizeInTiles);
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --streaming-heap-tiles", "[Config] Missing value for --streaming-heap-tiles");
+            }
+        }
+        else if (std::strcmp(arg, "--record-streaming-trace") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_RecordStreamingTracePath = argv[++i];
+                LOG_INFO("[Config] Streaming trace recording set via command line: %s", s_Instance.m_RecordStreamingTracePath.c_str());
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --record-streaming-trace", "[Config] Missing value for --record-streaming-trace");
+            }
+        }
+        else if (std::strcmp(arg, "--streaming-stats") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_StreamingStatsPath = argv[++i];
+                LOG_INFO("[Config] Texture streaming stats export set via command line: %s", s_Instance.m_StreamingStatsPath.c_str());
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --streaming-stats", "[Config] Missing value for --streaming-stats");
+            }
+        }
+        else if (std::strcmp(arg, "--capture-sequence") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_CaptureSequenceDirectory = argv[++i];
+                LOG_INFO("[Config] Sequence capture directory set via command line: %s", s_Instance.m_CaptureSequenceDirectory.c_str());
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --capture-sequence", "[Config] Missing value for --capture-sequence");
+            }
+        }
+        else if (std::strcmp(arg, "--capture-frames") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                s_Instance.m_CaptureSequenceFrameCount = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+                LOG_INFO("[Config] Sequence capture frame count set via command line: %u", s_Instance.m_CaptureSequenceFrameCount);
+            }
+            else
+            {
+                SDL_LOG_ASSERT_FAIL("Missing value for --capture-frames", "[Config] Missing value for --capture-frames");
+            }
         }
         else if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
         {
-            SDL_Log("Agentic Renderer - Command Line Options:");
-            SDL_Log("  --rhidebug                       Enable graphics API validation layers");
-            SDL_Log("  --rhidebug-gpu                   Enable GPU-assisted validation (requires --rhidebug)");
-            SDL_Log("  --execute-per-pass               Execute command lists per pass");
-            SDL_Log("  --execute-per-pass-and-wait      Wait for idle after each pass execution");
-            SDL_Log("  --disable-rendergraph-aliasing   Disable render graph aliasing");
-            SDL_Log("  --normalbasic                   Start in NormalBasic mode (RT features disabled, no BLAS/TLAS)");
-            SDL_Log("  --scene <path>                   Load the specified scene file");
-            SDL_Log("  --irradiance <path>              Path to irradiance cubemap texture (DDS)");
-            SDL_Log("  --radiance <path>                Path to radiance cubemap texture (DDS)");
-            SDL_Log("  --envmap <path>                  Path to environment map (.hdr/.exr for auto-inference of DDS)");
-            SDL_Log("  --brdflut <path>                 Path to BRDF LUT texture (DDS)");
-            SDL_Log("  --help, -h                       Show this help message");
+            LOG_INFO("Agentic Renderer - Command Line Options:");
+            LOG_INFO("  --rhidebug                       Enable graphics API validation layers");
+            LOG_INFO("  --rhidebug-gpu                   Enable GPU-assisted validation (requires --rhidebug)");
+            LOG_INFO("  --execute-per-pass               Execute command lists per pass");
+            LOG_INFO("  --execute-per-pass-and-wait      Wait for idle after each pass execution");
+            LOG_INFO("  --disable-rendergraph-aliasing   Disable render graph aliasing");
+            LOG_INFO("  --normalbasic                   Start in NormalBasic mode (RT features disabled, no BLAS/TLAS)");
+            LOG_INFO("  --scene <path>                   Load the specified scene file");
+            LOG_INFO("  --irradiance <path>              Path to irradiance cubemap texture (DDS)");
+            LOG_INFO("  --radiance <path>                Path to radiance cubemap texture (DDS)");
+            LOG_INFO("  --envmap <path>                  Path to environment map (.hdr/.exr for auto-inference of DDS)");
+            LOG_INFO("  --brdflut <path>                 Path to BRDF LUT texture (DDS)");
+            LOG_INFO("  --keep-cpu-geometry              Keep CPU copies of meshlet data after GPU upload");
+            LOG_INFO("  --disable-geometry-streaming     Keep every mesh LOD resident instead of streaming the finer ones");
+            LOG_INFO("  --geometry-pool-mb <n>           GPU pool for streamed mesh LODs (default: 256)");
+            LOG_INFO("  --disable-scene-cell-streaming   Load every model of a \"cellStreaming\" JSON scene up front");
+            LOG_INFO("  --scene-cell-pool-mb <n>         GPU pool for cell-streamed models (default: 512)");
+            LOG_INFO("  --vram-budget <MB>               Cap the VRAM budget (default: driver-reported budget)");
+            LOG_INFO("  --tile-io <mmap|read>            Streaming tile I/O backend (default: mmap)");
+            LOG_INFO("  --tile-io-queue-depth <n>        Tile requests batched per I/O worker with --tile-io read (default: 32)");
+            LOG_INFO("  --tile-cache-mb <n>              Host-memory cache of decoded streaming tiles (default: 256, 0 = disabled)");
+            LOG_INFO("  --cook-tdds                      Cook tile-contiguous .tdds files for streamed DDS textures");
+            LOG_INFO("  --tdds-compression <codec>       Per-tile codec for --cook-tdds: none, lz4 or zstd (default: none)");
+            LOG_INFO("  --verify-tdds                    Check every .tdds against its DDS (bit-exact) at load");
+            LOG_INFO("  --validate-rt-inputs             Check the BLAS/TLAS inputs and trace camera rays on the CPU at load");
+            LOG_INFO("  --disable-tile-prefetch          Only stream tiles sampler feedback has requested");
+            LOG_INFO("  --record-camera-path <file>      Record the camera path to <file> (written at exit)");
+            LOG_INFO("  --prefetch-replay <file>         Log the tile prefetcher's hit rate on a recorded camera path");
+            LOG_INFO("  --fixed-streaming-budgets        Keep the default per-frame streaming budgets instead of adapting them");
+            LOG_INFO("  --streaming-heap-tiles <n>       Tiles per streaming heap (64 KB each, default: 256)");
+            LOG_INFO("  --record-streaming-trace <file>  Record feedback and tile completions to <file> (written at exit)");
+            LOG_INFO("  --streaming-stats <file>         Write per-texture streaming stats to <file> (JSON, at exit)");
+            LOG_INFO("  --capture-sequence <dir>         Capture every frame to <dir> (PNG, or EXR for HDR swapchains)");
+            LOG_INFO("  --capture-frames <n>             Stop sequence capture after <n> frames (default: until Ctrl+Shift+P)");
+            LOG_INFO("  --help, -h                       Show this help message");
         }
         else
         {
-            SDL_Log("[Config] Unknown command line argument: %s", arg);
+            LOG_WARN("[Config] Unknown command line argument: %s", arg);
         }
     }
 }
@@ -16,6 +16,56 @@ struct Config
     // Enable render graph aliasing
     bool m_EnableRenderGraphAliasing = true;
 
+    // Keep CPU copies of meshlet data after GPU upload (default: release when the cooked mesh cache can restore them)
+    bool m_KeepCPUGeometry = false;
+
+    // Keep only the coarsest mesh LOD resident and stream finer LODs from the cooked mesh cache
+    bool m_EnableGeometryStreaming = true;
+    // GPU pool for streamed mesh LODs (indices and meshlets), in MB
+    uint32_t m_GeometryPoolMB = 256;
+
+    // Load and unload the models of JSON scenes with a "cellStreaming" object by camera distance
+    bool m_EnableSceneCellStreaming = true;
+    // GPU pool for the geometry of cell-streamed models, in MB
+    uint32_t m_SceneCellPoolMB = 512;
+
+    // VRAM budget cap in MB for the budget governor (0 = use the driver-reported budget)
+    uint32_t m_VRAMBudgetMB = 0;
+
+    // Read streaming tiles with batched positional reads instead of copying out of the mmap
+    bool m_TileIOExplicitReads = false;
+    // Tile requests a streaming I/O worker gathers into one batch (explicit reads only)
+    uint32_t m_TileIOQueueDepth = 32;
+    // Host-memory cache of decoded streaming tiles, consulted before reading a tile (0 = disabled)
+    uint32_t m_TileCacheMB = 256;
+    // Cook a tile-contiguous .tdds next to every streamed DDS that lacks an up-to-date one
+    bool m_CookTiledDDS = false;
+    // Per-tile codec used when cooking .tdds files (nvfeedback::TiledDDSCompression: 0 = none, 1 = LZ4, 2 = Zstd)
+    uint32_t m_TiledDDSCompression = 0;
+    // De-tile every .tdds used for streaming and compare it with its DDS at load
+    bool m_VerifyTiledDDS = false;
+    // Check the BLAS/TLAS inputs against the cooked geometry and probe a CPU BVH at scene load
+    bool m_ValidateRTInputs = false;
+    // Request streaming tiles the camera is predicted to need before feedback sees them
+    bool m_EnableTilePrefetch = true;
+    // Record the camera path to this file (saved at shutdown, empty = disabled)
+    std::string m_RecordCameraPath = "";
+    // Score the tile prefetcher against this recorded camera path after scene load (empty = disabled)
+    std::string m_PrefetchReplayPath = "";
+    // Adapt the per-frame streaming budgets to measured I/O and upload cost (false = fixed defaults)
+    bool m_AdaptiveStreamingBudgets = true;
+    // Tiles per streaming heap (fixed for the session)
+    uint32_t m_StreamingHeapSizeInTiles = 256;
+    // Record a streaming trace to this file (empty = disabled)
+    std::string m_RecordStreamingTracePath = "";
+    // Write per-texture streaming stats to this JSON file at exit (empty = disabled)
+    std::string m_StreamingStatsPath = "";
+
+    // Capture every frame into this directory from startup (empty = disabled)
+    std::string m_CaptureSequenceDirectory = "";
+    // Number of frames to capture in sequence mode (0 = until stopped)
+    uint32_t m_CaptureSequenceFrameCount = 0;
+
     // Add more configuration options here as needed
     // int renderWidth = 1920;
     // int renderHeight = 1080;
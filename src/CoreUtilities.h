@@ -0,0 +1,24 @@
+#pragma once
+
+// ─── CoreUtilities ───────────────────────────────────────────────────────────
+// Helpers shared by the renderer and the platform-neutral HobbyRendererCore
+// library (streaming policies, logging, allocators).  Core code is built
+// without pch.h, so this header must only depend on the standard library.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cstdint>
+
+static constexpr uint32_t NextLowerPow2(uint32_t v)
+{
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+    return v - (v >> 1);
+}
+
+static constexpr uint32_t DivideAndRoundUp(uint32_t dividend, uint32_t divisor)
+{
+    return (dividend + divisor - 1) / divisor;
+}
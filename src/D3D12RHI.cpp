@@ -433,6 +433,22 @@ public:
         return 0.0f;
     }
 
+    float GetVRAMBudgetMB() const override
+    {
+        if (!m_Adapter) return 0.0f;
+
+        ComPtr<IDXGIAdapter3> adapter3;
+        if (SUCCEEDED(m_Adapter.As(&adapter3)))
+        {
+            DXGI_QUERY_VIDEO_MEMORY_INFO info;
+            if (SUCCEEDED(adapter3->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info)))
+            {
+                return static_cast<float>(BYTES_TO_MB(info.Budget));
+            }
+        }
+        return 0.0f;
+    }
+
     nvrhi::GraphicsAPI GetGraphicsAPI() const override { return nvrhi::GraphicsAPI::D3D12; }
 
     void SetCommandListDebugName(const nvrhi::CommandListHandle& commandList, std::string_view name) override
@@ -87,6 +87,27 @@ public:
         dcb.SetUseReSTIRDIDenoised(0u); // compositing is done by CompositingPass
         dcb.SetIndirectLightingMode(g_Renderer.m_IndirectLightingTechnique);
         dcb.SetCSMDebugMode(g_Renderer.m_CSMDebugMode);
+
+        // Clustered direct lighting, when UpdateLightClusters binned the lights for this frame
+        const bool bUseLightClusters = g_Renderer.m_bLightClustersValid;
+        const LightClusterBinner& lightClusters = g_Renderer.m_LightClusterBinner;
+        if (bUseLightClusters)
+        {
+            const Matrix& viewToClip = g_Renderer.m_Scene.m_View.m_MatViewToClipNoOffset;
+            dcb.SetUseLightClusters(1u);
+            dcb.SetNumGlobalLights(lightClusters.GetStats().m_NumGlobalLights);
+            dcb.SetLightClusterCountX(LightClusterBinner::kGridX);
+            dcb.SetLightClusterCountY(LightClusterBinner::kGridY);
+            dcb.SetLightClusterCountZ(LightClusterBinner::kGridZ);
+            dcb.SetLightClusterScaleX(0.5f * LightClusterBinner::kGridX * viewToClip._11);
+            dcb.SetLightClusterScaleY(0.5f * LightClusterBinner::kGridY * viewToClip._22);
+            dcb.SetLightClusterZScale(lightClusters.GetZScale());
+            dcb.SetLightClusterZBias(lightClusters.GetZBias());
+        }
+        else
+        {
+            dcb.SetUseLightClusters(0u);
+        }
         commandList->writeBuffer(deferredCB, &dcb, sizeof(dcb), 0);
 
         // t8: RTXDI composited output (DI + emissive, already remodulated by CompositingPass)
@@ -132,6 +153,10 @@ public:
             : CommonResources::GetInstance().DefaultTextureBlack;
         dlInputs.SetCSMDebugOutput(csmDebugOutput);
 
+        // t17/t18: light clusters (any bound buffer when clustering is off; the shader does not read them)
+        dlInputs.SetLightClusters(bUseLightClusters ? g_Renderer.m_LightClusterBuffer : CommonResources::GetInstance().DummySRVStructuredBuffer);
+        dlInputs.SetLightClusterIndices(bUseLightClusters ? g_Renderer.m_LightClusterIndexBuffer : CommonResources::GetInstance().DummySRVStructuredBuffer);
+
         nvrhi::BindingSetDesc bset = Renderer::CreateBindingSetDesc(dlInputs);
 
         nvrhi::FramebufferDesc fbDesc;
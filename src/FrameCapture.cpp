@@ -0,0 +1,170 @@
+#include "FrameCapture.h"
+#include "Log.h"
+
+// ─── Helpers ─────────────────────────────────────────────────────────────────
+
+static FrameCaptureQueue::PixelFormat GetCapturePixelFormat(nvrhi::Format format)
+{
+    switch (format)
+    {
+    case nvrhi::Format::RGBA8_UNORM:
+    case nvrhi::Format::SRGBA8_UNORM:
+        return FrameCaptureQueue::PixelFormat::RGBA8;
+    case nvrhi::Format::BGRA8_UNORM:
+    case nvrhi::Format::SBGRA8_UNORM:
+        return FrameCaptureQueue::PixelFormat::BGRA8;
+    case nvrhi::Format::RGBA16_FLOAT:
+        return FrameCaptureQueue::PixelFormat::RGBA16_FLOAT;
+    case nvrhi::Format::RGBA32_FLOAT:
+        return FrameCaptureQueue::PixelFormat::RGBA32_FLOAT;
+    default:
+        return FrameCaptureQueue::PixelFormat::Unknown;
+    }
+}
+
+// ─── FrameCapture ────────────────────────────────────────────────────────────
+
+FrameCapture::~FrameCapture()
+{
+    SDL_assert(!m_Device && "FrameCapture::Shutdown must be called before destruction");
+}
+
+void FrameCapture::Initialize(nvrhi::IDevice* device)
+{
+    SDL_assert(device);
+    m_Device = device;
+
+    // PNG/EXR encoding is CPU-bound; two encoders keep up with sequence capture
+    // at typical resolutions without competing with the TaskScheduler workers.
+    const uint32_t hw = std::thread::hardware_concurrency();
+    const uint32_t numEncoders = std::max(1u, std::min(2u, hw / 4));
+
+    m_Queue.Start(numEncoders, SDL_GetBasePath());
+}
+
+void FrameCapture::Shutdown()
+{
+    if (m_Device)
+    {
+        RetireAllSlots();
+    }
+
+    m_Queue.Stop();
+
+    for (StagingSlot& slot : m_Staging)
+    {
+        slot = StagingSlot{};
+    }
+    m_Device = nullptr;
+}
+
+void FrameCapture::RecordFrame(nvrhi::ICommandList* commandList, nvrhi::ITexture* source, uint32_t frameNumber)
+{
+    PROFILE_FUNCTION();
+
+    if (!IsCapturePending())
+        return;
+
+    SDL_assert(commandList && source);
+
+    const nvrhi::TextureDesc& srcDesc = source->getDesc();
+    const FrameCaptureQueue::PixelFormat pixelFormat = GetCapturePixelFormat(srcDesc.format);
+    if (pixelFormat == FrameCaptureQueue::PixelFormat::Unknown)
+    {
+        LOG_ERROR("[FrameCapture] Unsupported capture format '%s'", nvrhi::getFormatInfo(srcDesc.format).name);
+        m_Queue.CancelRequests();
+        return;
+    }
+
+    // Only reachable when frames are captured faster than the ring retires
+    // them: retiring the oldest slot now waits for its copy, which paces the
+    // frame loop to the readback instead of dropping the frame.
+    while (!m_Queue.HasFreeSlot())
+    {
+        PROFILE_SCOPED("FrameCapture Readback Ring Full");
+        RetireSlot(m_Queue.GetOldestInFlightSlot());
+    }
+
+    const uint32_t slotIndex = m_Queue.BeginCapture(frameNumber, srcDesc.width, srcDesc.height, pixelFormat);
+    if (slotIndex == FrameCaptureQueue::kInvalidSlot)
+        return;
+
+    // (Re)create the staging texture when the source size or format changed
+    StagingSlot& slot = m_Staging[slotIndex];
+    if (!slot.m_Staging || slot.m_Width != srcDesc.width || slot.m_Height != srcDesc.height || slot.m_Format != srcDesc.format)
+    {
+        nvrhi::TextureDesc stagingDesc;
+        stagingDesc.width = srcDesc.width;
+        stagingDesc.height = srcDesc.height;
+        stagingDesc.format = srcDesc.format;
+        stagingDesc.debugName = "Frame Capture Staging Texture";
+
+        slot.m_Staging = m_Device->createStagingTexture(stagingDesc, nvrhi::CpuAccessMode::Read);
+        SDL_assert(slot.m_Staging && "Failed to create frame capture staging texture");
+
+        slot.m_Width = srcDesc.width;
+        slot.m_Height = srcDesc.height;
+        slot.m_Format = srcDesc.format;
+    }
+
+    commandList->copyTexture(slot.m_Staging, nvrhi::TextureSlice{}, source, nvrhi::TextureSlice{});
+}
+
+void FrameCapture::RetireCompletedSlots(uint32_t frameNumber)
+{
+    uint32_t slots[kNumReadbackSlots];
+    const uint32_t numSlots = m_Queue.GetRetirableSlots(frameNumber, slots);
+    for (uint32_t i = 0; i < numSlots; ++i)
+    {
+        RetireSlot(slots[i]);
+    }
+}
+
+void FrameCapture::RetireAllSlots()
+{
+    if (m_Queue.GetOldestInFlightSlot() == FrameCaptureQueue::kInvalidSlot)
+        return;
+
+    m_Device->waitForIdle();
+
+    // Retire oldest first so sequence frames are queued in order
+    for (uint32_t slot = m_Queue.GetOldestInFlightSlot(); slot != FrameCaptureQueue::kInvalidSlot; slot = m_Queue.GetOldestInFlightSlot())
+    {
+        RetireSlot(slot);
+    }
+}
+
+void FrameCapture::RetireSlot(uint32_t slotIndex)
+{
+    PROFILE_FUNCTION();
+
+    const FrameCaptureQueue::Slot& queueSlot = m_Queue.GetSlot(slotIndex);
+    StagingSlot& slot = m_Staging[slotIndex];
+    SDL_assert(queueSlot.m_bInFlight && slot.m_Width == queueSlot.m_Width && slot.m_Height == queueSlot.m_Height);
+
+    const nvrhi::FormatInfo& fmtInfo = nvrhi::getFormatInfo(slot.m_Format);
+    const size_t packedRowPitch = (size_t)slot.m_Width * fmtInfo.bytesPerBlock;
+
+    // mapStagingTexture waits on the copy's fence; by the time a slot is
+    // retired (kReadbackLatencyFrames later) the copy has long completed.
+    size_t rowPitch = 0;
+    const uint8_t* mapped = static_cast<const uint8_t*>(m_Device->mapStagingTexture(slot.m_Staging, nvrhi::TextureSlice{}, nvrhi::CpuAccessMode::Read, &rowPitch));
+    SDL_assert(mapped && "Failed to map frame capture staging texture");
+
+    if (!mapped)
+    {
+        m_Queue.AbandonSlot(slotIndex);
+        return;
+    }
+
+    std::vector<uint8_t> pixels(packedRowPitch * slot.m_Height);
+    for (uint32_t y = 0; y < slot.m_Height; ++y)
+    {
+        memcpy(pixels.data() + y * packedRowPitch, mapped + y * rowPitch, packedRowPitch);
+    }
+    m_Device->unmapStagingTexture(slot.m_Staging);
+
+    // Blocks while the encoder queue is full (back-pressure)
+    PROFILE_SCOPED("FrameCapture Back-Pressure");
+    m_Queue.RetireSlot(slotIndex, std::move(pixels));
+}
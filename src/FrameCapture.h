@@ -0,0 +1,90 @@
+#pragma once
+
+#include "FrameCaptureQueue.h"
+
+// ─── FrameCapture ────────────────────────────────────────────────────────────
+// Non-blocking back buffer capture (single screenshots and image sequences).
+// The request state, readback slot ring and encoder threads are
+// FrameCaptureQueue (HobbyRendererCore); this class owns one staging texture
+// per slot and does the GPU side.
+//
+// Per frame (main thread):
+//   1. RetireCompletedSlots() maps the slots whose copy was recorded at least
+//      kReadbackLatencyFrames ago, copies their rows into a tightly-packed CPU
+//      buffer and hands it to the encoder threads.
+//   2. If IsCapturePending(), RecordFrame() records a copyTexture from the
+//      source texture into a free slot.  Nothing waits on the GPU unless the
+//      ring is full, and no requested frame is dropped: a full ring or encoder
+//      queue paces the frame loop instead (see FrameCaptureQueue).
+//
+// Encoding (PNG/JPG via stb_image_write, EXR for float formats) runs on
+// dedicated encoder threads, so the render loop never pays for compression.
+// 8-bit back buffers are written as lossless PNG by default; HDR (scRGB
+// RGBA16_FLOAT) back buffers are written as half-float EXR.
+//
+// Sequence mode captures every frame until stopped (or until the requested
+// frame count is reached) and writes <dir>/frame_<N>.<ext>.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class FrameCapture
+{
+public:
+    using FileFormat = FrameCaptureQueue::FileFormat;
+
+    static constexpr uint32_t kNumReadbackSlots      = FrameCaptureQueue::kNumReadbackSlots;
+    static constexpr uint32_t kReadbackLatencyFrames = FrameCaptureQueue::kReadbackLatencyFrames;
+
+    FrameCapture() = default;
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    void Initialize(nvrhi::IDevice* device);
+
+    // Retires every outstanding slot (waits for the GPU) and drains the encoder.
+    void Shutdown();
+
+    // Queue a single capture of the next recorded frame.  Empty path writes
+    // "screenshot.<ext>" next to the executable.
+    void RequestScreenshot(std::string path = {}, FileFormat fileFormat = FileFormat::Auto) { m_Queue.RequestScreenshot(std::move(path), fileFormat); }
+
+    // Capture every recorded frame into directory.  frameCount == 0 records
+    // until StopSequence() is called.
+    void StartSequence(const std::string& directory, uint32_t frameCount = 0, FileFormat fileFormat = FileFormat::Auto) { m_Queue.StartSequence(directory, frameCount, fileFormat); }
+    void StopSequence() { m_Queue.StopSequence(); }
+    bool IsSequenceActive() const { return m_Queue.IsSequenceActive(); }
+
+    // True when the next RecordFrame() call will capture.
+    bool IsCapturePending() const { return m_Queue.IsCapturePending(); }
+
+    // Main thread, once per frame.  Hands slots recorded kReadbackLatencyFrames
+    // (or more) frames ago to the encoder threads.
+    void RetireCompletedSlots(uint32_t frameNumber);
+
+    // Main thread, after all passes writing `source` have been recorded and
+    // before the pending command lists are executed.
+    void RecordFrame(nvrhi::ICommandList* commandList, nvrhi::ITexture* source, uint32_t frameNumber);
+
+    // Number of images that have been read back but not yet written to disk.
+    uint32_t PendingEncodeCount() const { return m_Queue.GetPendingEncodeCount(); }
+
+private:
+    struct StagingSlot
+    {
+        nvrhi::StagingTextureHandle m_Staging;
+        uint32_t      m_Width  = 0;
+        uint32_t      m_Height = 0;
+        nvrhi::Format m_Format = nvrhi::Format::UNKNOWN;
+    };
+
+    // Map and copy out one in-flight slot, then hand it to the queue.  Waits for
+    // the slot's copy and, when the encoder queue is full, for the encoders.
+    void RetireSlot(uint32_t slot);
+    void RetireAllSlots();
+
+    nvrhi::IDevice* m_Device = nullptr;
+
+    FrameCaptureQueue m_Queue;
+    StagingSlot       m_Staging[kNumReadbackSlots];
+};
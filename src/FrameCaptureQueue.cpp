@@ -0,0 +1,485 @@
+#include "FrameCaptureQueue.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if HOBBY_RENDERER_HAS_STB_IMAGE_WRITE
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "../external/microprofile/stb/stb_image_write.h"
+#endif
+
+// ─── Helpers ─────────────────────────────────────────────────────────────────
+
+static bool IsFloatFormat(FrameCaptureQueue::PixelFormat format)
+{
+    return format == FrameCaptureQueue::PixelFormat::RGBA16_FLOAT || format == FrameCaptureQueue::PixelFormat::RGBA32_FLOAT;
+}
+
+FrameCaptureQueue::FileFormat FrameCaptureQueue::ResolveFileFormat(FileFormat requested, PixelFormat format)
+{
+    if (IsFloatFormat(format))
+    {
+        // stb cannot write float data losslessly - always fall back to EXR
+        return FileFormat::EXR;
+    }
+    if (requested == FileFormat::Auto || requested == FileFormat::EXR)
+    {
+        return FileFormat::PNG;
+    }
+    return requested;
+}
+
+const char* FrameCaptureQueue::GetFileExtension(FileFormat fileFormat)
+{
+    switch (fileFormat)
+    {
+    case FileFormat::JPG: return ".jpg";
+    case FileFormat::EXR: return ".exr";
+    default:              return ".png";
+    }
+}
+
+bool FrameCaptureQueue::CanEncode(FileFormat fileFormat)
+{
+#if HOBBY_RENDERER_HAS_STB_IMAGE_WRITE
+    (void)fileFormat;
+    return true;
+#else
+    return fileFormat == FileFormat::EXR;
+#endif
+}
+
+// ─── Minimal OpenEXR writer ──────────────────────────────────────────────────
+// Single-part scanline image, NO_COMPRESSION, one scanline per chunk.
+// Channels are stored alphabetically (A, B, G, R) as the spec requires, each
+// scanline holding all samples of one channel before the next.
+
+namespace
+{
+    struct EXRWriter
+    {
+        std::vector<uint8_t> m_Bytes;
+
+        template <typename T>
+        void Write(const T& v)
+        {
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
+            m_Bytes.insert(m_Bytes.end(), p, p + sizeof(T));
+        }
+
+        void WriteString(const char* s)
+        {
+            m_Bytes.insert(m_Bytes.end(), s, s + std::strlen(s) + 1);
+        }
+
+        void BeginAttribute(const char* name, const char* type, int32_t size)
+        {
+            WriteString(name);
+            WriteString(type);
+            Write(size);
+        }
+    };
+}
+
+bool FrameCaptureQueue::WriteEXR(const char* path, uint32_t width, uint32_t height, const void* rgbaPixels, uint32_t bytesPerComponent)
+{
+    assert((bytesPerComponent == 2 || bytesPerComponent == 4) && "WriteEXR supports HALF and FLOAT components only");
+    assert(width > 0 && height > 0);
+
+    static const char* kChannelNames[] = { "A", "B", "G", "R" };
+    static const uint32_t kChannelSourceIndex[] = { 3, 2, 1, 0 };
+    const int32_t pixelType = (bytesPerComponent == 2) ? 1 /*HALF*/ : 2 /*FLOAT*/;
+
+    EXRWriter w;
+
+    // Magic number + version 2, single-part scanline
+    w.Write<uint32_t>(20000630);
+    w.Write<uint32_t>(2);
+
+    // channels (chlist): per channel name, pixelType, pLinear + 3 reserved, xSampling, ySampling
+    int32_t chlistSize = 1;
+    for (const char* name : kChannelNames)
+        chlistSize += (int32_t)std::strlen(name) + 1 + 16;
+    w.BeginAttribute("channels", "chlist", chlistSize);
+    for (const char* name : kChannelNames)
+    {
+        w.WriteString(name);
+        w.Write<int32_t>(pixelType);
+        w.Write<uint32_t>(0);
+        w.Write<int32_t>(1);
+        w.Write<int32_t>(1);
+    }
+    w.Write<uint8_t>(0);
+
+    w.BeginAttribute("compression", "compression", 1);
+    w.Write<uint8_t>(0); // NO_COMPRESSION
+
+    const int32_t box[4] = { 0, 0, (int32_t)width - 1, (int32_t)height - 1 };
+    w.BeginAttribute("dataWindow", "box2i", sizeof(box));
+    w.Write(box);
+    w.BeginAttribute("displayWindow", "box2i", sizeof(box));
+    w.Write(box);
+
+    w.BeginAttribute("lineOrder", "lineOrder", 1);
+    w.Write<uint8_t>(0); // INCREASING_Y
+
+    w.BeginAttribute("pixelAspectRatio", "float", 4);
+    w.Write<float>(1.0f);
+
+    w.BeginAttribute("screenWindowCenter", "v2f", 8);
+    w.Write<float>(0.0f);
+    w.Write<float>(0.0f);
+
+    w.BeginAttribute("screenWindowWidth", "float", 4);
+    w.Write<float>(1.0f);
+
+    w.Write<uint8_t>(0); // end of header
+
+    // Line offset table
+    const uint32_t scanlineDataSize = width * 4 * bytesPerComponent;
+    const uint64_t chunkSize = sizeof(int32_t) * 2 + scanlineDataSize;
+    const uint64_t firstChunkOffset = w.m_Bytes.size() + (uint64_t)height * sizeof(uint64_t);
+    for (uint32_t y = 0; y < height; ++y)
+        w.Write<uint64_t>(firstChunkOffset + y * chunkSize);
+
+    w.m_Bytes.reserve(w.m_Bytes.size() + (size_t)chunkSize * height);
+
+    const uint8_t* src = static_cast<const uint8_t*>(rgbaPixels);
+    const size_t srcRowPitch = (size_t)width * 4 * bytesPerComponent;
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        w.Write<int32_t>((int32_t)y);
+        w.Write<int32_t>((int32_t)scanlineDataSize);
+
+        const uint8_t* row = src + y * srcRowPitch;
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            const uint32_t srcChannel = kChannelSourceIndex[c];
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                const uint8_t* sample = row + ((size_t)x * 4 + srcChannel) * bytesPerComponent;
+                w.m_Bytes.insert(w.m_Bytes.end(), sample, sample + bytesPerComponent);
+            }
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(w.m_Bytes.data()), (std::streamsize)w.m_Bytes.size());
+    return file.good();
+}
+
+bool FrameCaptureQueue::Encode(const EncodeJob& job)
+{
+    assert(job.m_Format != PixelFormat::Unknown);
+    assert(job.m_Width > 0 && job.m_Height > 0);
+
+    const FileFormat fileFormat = ResolveFileFormat(job.m_FileFormat, job.m_Format);
+
+    if (fileFormat == FileFormat::EXR)
+    {
+        const uint32_t bytesPerComponent = (job.m_Format == PixelFormat::RGBA16_FLOAT) ? 2 : 4;
+        return WriteEXR(job.m_Path.c_str(), job.m_Width, job.m_Height, job.m_Pixels.data(), bytesPerComponent);
+    }
+
+#if HOBBY_RENDERER_HAS_STB_IMAGE_WRITE
+    // stb expects RGBA - swizzle BGRA back buffers in place on a private copy
+    const uint8_t* pixels = job.m_Pixels.data();
+    std::vector<uint8_t> swizzled;
+    if (job.m_Format == PixelFormat::BGRA8)
+    {
+        swizzled = job.m_Pixels;
+        for (size_t i = 0; i + 3 < swizzled.size(); i += 4)
+        {
+            std::swap(swizzled[i + 0], swizzled[i + 2]);
+        }
+        pixels = swizzled.data();
+    }
+
+    const int w = (int)job.m_Width;
+    const int h = (int)job.m_Height;
+    if (fileFormat == FileFormat::JPG)
+    {
+        return stbi_write_jpg(job.m_Path.c_str(), w, h, 4, pixels, 95) != 0;
+    }
+    return stbi_write_png(job.m_Path.c_str(), w, h, 4, pixels, w * 4) != 0;
+#else
+    LOG_ERROR("[FrameCapture] Built without stb_image_write, cannot write '%s'", job.m_Path.c_str());
+    return false;
+#endif
+}
+
+// ─── FrameCaptureQueue ───────────────────────────────────────────────────────
+
+FrameCaptureQueue::~FrameCaptureQueue()
+{
+    assert(m_Encoders.empty() && "FrameCaptureQueue::Stop must be called before destruction");
+}
+
+void FrameCaptureQueue::Start(uint32_t numEncoders, std::string screenshotDirectory, EncodeFn encodeFn)
+{
+    assert(m_Encoders.empty());
+
+    m_ScreenshotDirectory = std::move(screenshotDirectory);
+    m_EncodeFn = encodeFn ? std::move(encodeFn) : EncodeFn{ &FrameCaptureQueue::Encode };
+
+    m_bShutdown = false;
+    m_Encoders.reserve(numEncoders);
+    for (uint32_t i = 0; i < std::max(1u, numEncoders); i++)
+    {
+        m_Encoders.emplace_back([this]() { EncoderLoop(); });
+    }
+}
+
+void FrameCaptureQueue::Stop()
+{
+    for ([[maybe_unused]] const Slot& slot : m_Slots)
+        assert(!slot.m_bInFlight && "FrameCaptureQueue::Stop with a readback slot still in flight");
+
+    Drain();
+
+    {
+        std::lock_guard<std::mutex> lock(m_EncodeMutex);
+        m_bShutdown = true;
+    }
+    m_EncodeCV.notify_all();
+
+    for (std::thread& t : m_Encoders)
+    {
+        if (t.joinable())
+            t.join();
+    }
+    m_Encoders.clear();
+
+    if (m_NumBackPressureStalls > 0)
+    {
+        LOG_INFO("[FrameCapture] Waited for the encoders %u time(s), %.1f ms in total",
+                 m_NumBackPressureStalls, m_BackPressureStallSeconds * 1e3);
+    }
+}
+
+void FrameCaptureQueue::RequestScreenshot(std::string path, FileFormat fileFormat)
+{
+    m_bScreenshotRequested = true;
+    m_ScreenshotPath = std::move(path);
+    m_ScreenshotFormat = fileFormat;
+}
+
+bool FrameCaptureQueue::StartSequence(const std::string& directory, uint32_t frameCount, FileFormat fileFormat)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec)
+    {
+        LOG_ERROR("[FrameCapture] Failed to create sequence directory '%s': %s", directory.c_str(), ec.message().c_str());
+        return false;
+    }
+
+    m_bSequenceActive = true;
+    m_SequenceDirectory = directory;
+    m_SequenceFormat = fileFormat;
+    m_SequenceFrameIndex = 0;
+    m_SequenceFrameCount = frameCount;
+
+    LOG_INFO("[FrameCapture] Sequence capture started: '%s' (%u frames)", directory.c_str(), frameCount);
+    return true;
+}
+
+void FrameCaptureQueue::StopSequence()
+{
+    if (!m_bSequenceActive)
+        return;
+
+    m_bSequenceActive = false;
+    LOG_INFO("[FrameCapture] Sequence capture stopped after %u frames (%u encoder stall(s))", m_SequenceFrameIndex, m_NumBackPressureStalls);
+}
+
+void FrameCaptureQueue::CancelRequests()
+{
+    m_bScreenshotRequested = false;
+    StopSequence();
+}
+
+bool FrameCaptureQueue::HasFreeSlot() const
+{
+    for (const Slot& slot : m_Slots)
+    {
+        if (!slot.m_bInFlight)
+            return true;
+    }
+    return false;
+}
+
+uint32_t FrameCaptureQueue::GetOldestInFlightSlot() const
+{
+    uint32_t oldest = kInvalidSlot;
+    for (uint32_t i = 0; i < kNumReadbackSlots; ++i)
+    {
+        // Age rather than frame number, so the order survives wrap-around
+        if (m_Slots[i].m_bInFlight && (oldest == kInvalidSlot || (int32_t)(m_Slots[i].m_RecordedFrame - m_Slots[oldest].m_RecordedFrame) < 0))
+            oldest = i;
+    }
+    return oldest;
+}
+
+uint32_t FrameCaptureQueue::GetRetirableSlots(uint32_t frameNumber, uint32_t (&outSlots)[kNumReadbackSlots]) const
+{
+    uint32_t numSlots = 0;
+    for (uint32_t i = 0; i < kNumReadbackSlots; ++i)
+    {
+        if (m_Slots[i].m_bInFlight && frameNumber - m_Slots[i].m_RecordedFrame >= kReadbackLatencyFrames)
+            outSlots[numSlots++] = i;
+    }
+
+    // Oldest first so sequence frames are queued in order
+    std::sort(outSlots, outSlots + numSlots, [this, frameNumber](uint32_t a, uint32_t b) {
+        return frameNumber - m_Slots[a].m_RecordedFrame > frameNumber - m_Slots[b].m_RecordedFrame;
+    });
+    return numSlots;
+}
+
+uint32_t FrameCaptureQueue::BeginCapture(uint32_t frameNumber, uint32_t width, uint32_t height, PixelFormat format)
+{
+    if (!IsCapturePending())
+        return kInvalidSlot;
+
+    assert(format != PixelFormat::Unknown && width > 0 && height > 0);
+
+    uint32_t slotIndex = kInvalidSlot;
+    for (uint32_t i = 0; i < kNumReadbackSlots && slotIndex == kInvalidSlot; ++i)
+    {
+        if (!m_Slots[i].m_bInFlight)
+            slotIndex = i;
+    }
+    assert(slotIndex != kInvalidSlot && "BeginCapture without a free slot; retire GetOldestInFlightSlot() first");
+    if (slotIndex == kInvalidSlot)
+        return kInvalidSlot;
+
+    Slot& slot = m_Slots[slotIndex];
+    slot.m_bInFlight = true;
+    slot.m_RecordedFrame = frameNumber;
+    slot.m_Width = width;
+    slot.m_Height = height;
+    slot.m_Format = format;
+
+    if (m_bScreenshotRequested)
+    {
+        slot.m_FileFormat = ResolveFileFormat(m_ScreenshotFormat, format);
+        slot.m_Path = m_ScreenshotPath;
+        if (slot.m_Path.empty())
+        {
+            slot.m_Path = m_ScreenshotDirectory + "screenshot" + GetFileExtension(slot.m_FileFormat);
+        }
+        m_bScreenshotRequested = false;
+    }
+    else
+    {
+        char fileName[32];
+        slot.m_FileFormat = ResolveFileFormat(m_SequenceFormat, format);
+        std::snprintf(fileName, sizeof(fileName), "frame_%05u%s", m_SequenceFrameIndex, GetFileExtension(slot.m_FileFormat));
+        slot.m_Path = (std::filesystem::path{ m_SequenceDirectory } / fileName).string();
+
+        ++m_SequenceFrameIndex;
+        if (m_SequenceFrameCount != 0 && m_SequenceFrameIndex >= m_SequenceFrameCount)
+        {
+            StopSequence();
+        }
+    }
+
+    return slotIndex;
+}
+
+void FrameCaptureQueue::RetireSlot(uint32_t slotIndex, std::vector<uint8_t> pixels)
+{
+    Slot& slot = m_Slots[slotIndex];
+    assert(slot.m_bInFlight);
+
+    EncodeJob job;
+    job.m_Pixels = std::move(pixels);
+    job.m_Width = slot.m_Width;
+    job.m_Height = slot.m_Height;
+    job.m_Format = slot.m_Format;
+    job.m_FileFormat = slot.m_FileFormat;
+    job.m_Path = std::move(slot.m_Path);
+
+    slot.m_bInFlight = false;
+    slot.m_Path.clear();
+
+    {
+        std::unique_lock<std::mutex> lock(m_EncodeMutex);
+        if (m_EncodeQueue.size() >= kMaxQueuedEncodeJobs)
+        {
+            // The render thread waits for the encoders rather than dropping a requested frame
+            const auto stallStart = std::chrono::steady_clock::now();
+            m_EncodeDoneCV.wait(lock, [this]() { return m_EncodeQueue.size() < kMaxQueuedEncodeJobs; });
+            m_BackPressureStallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - stallStart).count();
+            m_NumBackPressureStalls++;
+            LOG_INFO_RATE_LIMITED(1000, "[FrameCapture] Encoder queue full (%u jobs), waited for the encoders (%u stall(s))",
+                                  kMaxQueuedEncodeJobs, m_NumBackPressureStalls);
+        }
+
+        m_PendingEncodeCount.fetch_add(1, std::memory_order_relaxed);
+        m_EncodeQueue.push(std::move(job));
+    }
+    m_EncodeCV.notify_one();
+}
+
+void FrameCaptureQueue::AbandonSlot(uint32_t slotIndex)
+{
+    Slot& slot = m_Slots[slotIndex];
+    assert(slot.m_bInFlight);
+    LOG_ERROR("[FrameCapture] Readback failed, '%s' not written", slot.m_Path.c_str());
+    slot.m_bInFlight = false;
+    slot.m_Path.clear();
+}
+
+// ─── Encoder threads ─────────────────────────────────────────────────────────
+
+void FrameCaptureQueue::Drain()
+{
+    std::unique_lock<std::mutex> lock(m_EncodeMutex);
+    m_EncodeDoneCV.wait(lock, [this]() { return m_PendingEncodeCount.load(std::memory_order_relaxed) == 0; });
+}
+
+void FrameCaptureQueue::EncoderLoop()
+{
+    while (true)
+    {
+        EncodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_EncodeMutex);
+            m_EncodeCV.wait(lock, [this]() { return m_bShutdown || !m_EncodeQueue.empty(); });
+
+            if (m_EncodeQueue.empty())
+                return; // shutdown with nothing left to do
+
+            job = std::move(m_EncodeQueue.front());
+            m_EncodeQueue.pop();
+        }
+        m_EncodeDoneCV.notify_all(); // a queue slot was freed
+
+        if (m_EncodeFn(job))
+        {
+            LOG_INFO("[FrameCapture] Wrote '%s'", job.m_Path.c_str());
+        }
+        else
+        {
+            LOG_ERROR("[FrameCapture] Failed to write '%s'", job.m_Path.c_str());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_EncodeMutex);
+            m_PendingEncodeCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+        m_EncodeDoneCV.notify_all();
+    }
+}
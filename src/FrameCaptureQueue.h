@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ─── FrameCaptureQueue ───────────────────────────────────────────────────────
+// The device-independent half of FrameCapture: capture requests, the readback
+// slot ring and the encoder threads.  FrameCapture owns one staging texture
+// per slot and does the GPU copy, map and unmap; everything else lives here
+// (part of HobbyRendererCore, tested without a device).
+//
+// Per frame (main thread, through FrameCapture):
+//   1. GetRetirableSlots() lists the slots whose copy was recorded at least
+//      kReadbackLatencyFrames ago, oldest first.  FrameCapture maps each one
+//      and hands its rows to RetireSlot(), which frees the slot and queues an
+//      EncodeJob.
+//   2. If IsCapturePending(), BeginCapture() picks the file for this frame
+//      and a free slot for its copy.  When every slot is still in flight,
+//      FrameCapture retires GetOldestInFlightSlot() first; mapping it waits
+//      for that copy, which paces the frame loop to the readback.
+//
+// Nothing requested is ever dropped.  RetireSlot() blocks while
+// kMaxQueuedEncodeJobs jobs are queued, so a sequence (or a replay being
+// captured) runs at the speed of the encoders and the disk instead of losing
+// frames, and memory stays bounded.  Stalls are counted.
+//
+// PNG and JPG are written with stb_image_write, which comes with the
+// microprofile submodule; without it (HOBBY_RENDERER_HAS_STB_IMAGE_WRITE
+// undefined) only EXR is available and CanEncode() says so.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class FrameCaptureQueue
+{
+public:
+    // A slot is re-used only after it has been retired, so this must be
+    // > kReadbackLatencyFrames for a sequence to never wait on the GPU.
+    static constexpr uint32_t kNumReadbackSlots      = 3;
+    static constexpr uint32_t kReadbackLatencyFrames = 2;
+    static constexpr uint32_t kMaxQueuedEncodeJobs   = 16;
+    static constexpr uint32_t kInvalidSlot           = UINT32_MAX;
+
+    enum class FileFormat : uint8_t
+    {
+        Auto, // PNG for 8-bit formats, EXR for float formats
+        PNG,
+        JPG,
+        EXR,
+    };
+
+    enum class PixelFormat : uint8_t
+    {
+        Unknown, // not capturable
+        RGBA8,
+        BGRA8,
+        RGBA16_FLOAT,
+        RGBA32_FLOAT,
+    };
+
+    // CPU-side image handed to the encoder threads.  Rows are tightly packed
+    // (rowPitch == width * bytes per pixel).
+    struct EncodeJob
+    {
+        std::vector<uint8_t> m_Pixels;
+        uint32_t             m_Width      = 0;
+        uint32_t             m_Height     = 0;
+        PixelFormat          m_Format     = PixelFormat::Unknown;
+        FileFormat           m_FileFormat = FileFormat::Auto;
+        std::string          m_Path;
+    };
+
+    // Writes one job; returns false on failure.  Replaceable for tests.
+    using EncodeFn = std::function<bool(const EncodeJob& job)>;
+
+    struct Slot
+    {
+        bool        m_bInFlight     = false;
+        uint32_t    m_RecordedFrame = 0;
+        uint32_t    m_Width         = 0;
+        uint32_t    m_Height        = 0;
+        PixelFormat m_Format        = PixelFormat::Unknown;
+        FileFormat  m_FileFormat    = FileFormat::Auto;
+        std::string m_Path;
+    };
+
+    FrameCaptureQueue() = default;
+    ~FrameCaptureQueue();
+
+    FrameCaptureQueue(const FrameCaptureQueue&) = delete;
+    FrameCaptureQueue& operator=(const FrameCaptureQueue&) = delete;
+
+    // Screenshots requested without a path are written to
+    // <screenshotDirectory>screenshot.<ext>.  encodeFn defaults to Encode().
+    void Start(uint32_t numEncoders, std::string screenshotDirectory = {}, EncodeFn encodeFn = nullptr);
+    // Waits for every queued job, then joins the encoders.  Slots still in
+    // flight must have been retired first.
+    void Stop();
+
+    // ─── Requests ────────────────────────────────────────────────────────────
+    // A screenshot stays pending until a frame is captured for it.
+    void RequestScreenshot(std::string path = {}, FileFormat fileFormat = FileFormat::Auto);
+    // Capture every frame into <directory>/frame_<N>.<ext>.  frameCount == 0
+    // records until StopSequence().
+    bool StartSequence(const std::string& directory, uint32_t frameCount = 0, FileFormat fileFormat = FileFormat::Auto);
+    void StopSequence();
+    // Forgets the pending screenshot and stops the sequence (e.g. the source
+    // cannot be captured).
+    void CancelRequests();
+
+    bool IsSequenceActive() const { return m_bSequenceActive; }
+    bool IsCapturePending() const { return m_bScreenshotRequested || m_bSequenceActive; }
+
+    // ─── Slots (main thread) ─────────────────────────────────────────────────
+    bool     HasFreeSlot() const;
+    uint32_t GetOldestInFlightSlot() const;
+    // Slots recorded kReadbackLatencyFrames or more frames before frameNumber,
+    // oldest first.  Frame numbers may wrap.
+    uint32_t GetRetirableSlots(uint32_t frameNumber, uint32_t (&outSlots)[kNumReadbackSlots]) const;
+    const Slot& GetSlot(uint32_t slot) const { return m_Slots[slot]; }
+
+    // Takes a free slot for the frame's capture and names its file.  The
+    // screenshot is served before the sequence.  Returns kInvalidSlot if
+    // nothing is pending; asserts HasFreeSlot().
+    uint32_t BeginCapture(uint32_t frameNumber, uint32_t width, uint32_t height, PixelFormat format);
+
+    // Frees the slot and queues its pixels (tightly packed) for encoding.
+    // Blocks while the encoder queue is full.
+    void RetireSlot(uint32_t slot, std::vector<uint8_t> pixels);
+    // Frees the slot without encoding (the readback failed).
+    void AbandonSlot(uint32_t slot);
+
+    // ─── Encoder ─────────────────────────────────────────────────────────────
+    // Waits until every queued job has been written.
+    void Drain();
+
+    // Images that have been read back but not yet written to disk.
+    uint32_t GetPendingEncodeCount() const { return m_PendingEncodeCount.load(std::memory_order_relaxed); }
+    // Times RetireSlot() had to wait for the encoders, and for how long in total.
+    uint32_t GetNumBackPressureStalls() const { return m_NumBackPressureStalls; }
+    double   GetBackPressureStallSeconds() const { return m_BackPressureStallSeconds; }
+
+    static FileFormat  ResolveFileFormat(FileFormat requested, PixelFormat format);
+    static const char* GetFileExtension(FileFormat fileFormat);
+    static bool        CanEncode(FileFormat fileFormat);
+
+    // Encode one image synchronously.  Used by the encoder threads; exposed so
+    // offline tools can share the exact same writer.
+    static bool Encode(const EncodeJob& job);
+
+    // Writes an uncompressed scanline OpenEXR file with HALF (2-byte components)
+    // or FLOAT (4-byte components) RGBA channels.
+    static bool WriteEXR(const char* path, uint32_t width, uint32_t height, const void* rgbaPixels, uint32_t bytesPerComponent);
+
+private:
+    void EncoderLoop();
+
+    Slot m_Slots[kNumReadbackSlots];
+
+    std::string m_ScreenshotDirectory;
+
+    // Pending single-shot request
+    bool        m_bScreenshotRequested = false;
+    std::string m_ScreenshotPath;
+    FileFormat  m_ScreenshotFormat = FileFormat::Auto;
+
+    // Sequence state
+    bool        m_bSequenceActive    = false;
+    std::string m_SequenceDirectory;
+    FileFormat  m_SequenceFormat     = FileFormat::Auto;
+    uint32_t    m_SequenceFrameIndex = 0;
+    uint32_t    m_SequenceFrameCount = 0;
+
+    uint32_t    m_NumBackPressureStalls    = 0;
+    double      m_BackPressureStallSeconds = 0.0;
+
+    // Encoder threads (main thread → encoders)
+    EncodeFn                 m_EncodeFn;
+    std::queue<EncodeJob>    m_EncodeQueue;
+    std::mutex               m_EncodeMutex;
+    std::condition_variable  m_EncodeCV;       // wakes encoders
+    std::condition_variable  m_EncodeDoneCV;   // wakes producers waiting on back-pressure / drain
+    std::vector<std::thread> m_Encoders;
+    bool                     m_bShutdown = false;
+    std::atomic<uint32_t>    m_PendingEncodeCount{ 0 };
+};
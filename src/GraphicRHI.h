@@ -59,6 +59,8 @@ public:
     virtual bool PresentSwapchain(uint32_t imageIndex) = 0;
 
     virtual float GetVRAMUsageMB() const = 0;
+    // OS-assigned budget for this process's local video memory (0 if unknown)
+    virtual float GetVRAMBudgetMB() const = 0;
 
     virtual nvrhi::GraphicsAPI GetGraphicsAPI() const = 0;
 
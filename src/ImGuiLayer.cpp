@@ -1,5 +1,6 @@
 ﻿#include "Renderer.h"
 #include "CommonResources.h"
+#include "Config.h"
 #include "Streaming/FeedbackManager.h"
 
 #include <imgui.h>
@@ -38,6 +39,35 @@ void ImGuiLayer::ProcessEvent(const SDL_Event& event)
     ImGui_ImplSDL3_ProcessEvent(&event);
 }
 
+void ImGuiLayer::UpdateLoadingFrame()
+{
+    PROFILE_FUNCTION();
+
+    // g_Renderer.m_Scene is still empty and the loader thread owns the streaming state,
+    // so this only reads AsyncSceneLoader's progress
+    const AsyncSceneLoader& loader = g_Renderer.m_SceneLoader;
+    ImGui_ImplSDL3_NewFrame();
+    ImGui::NewFrame();
+
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(viewport->GetCenter(), ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+
+    const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+                                   ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoNav;
+    if (ImGui::Begin("Loading", nullptr, flags))
+    {
+        static const char kSpinner[] = { '|', '/', '-', '\\' };
+        const std::string sceneName = std::filesystem::path{ Config::Get().m_ScenePath }.filename().string();
+
+        ImGui::Text("Loading %s", sceneName.empty() ? "(no scene)" : sceneName.c_str());
+        ImGui::Separator();
+        ImGui::Text("%c %s... %.1f s", kSpinner[(int)(ImGui::GetTime() * 8.0) % 4], loader.GetStateName(), loader.GetElapsedSeconds());
+    }
+    ImGui::End();
+
+    ImGui::Render();
+}
+
 void ImGuiLayer::UpdateFrame()
 {
     PROFILE_FUNCTION();
@@ -62,7 +92,14 @@ void ImGuiLayer::UpdateFrame()
         ImGui::Separator();
         ImGui::Text("CPU Time: %.3f ms", g_Renderer.m_FrameTime);
         ImGui::Separator();
-        ImGui::Text("VRAM: %.1f MB", g_Renderer.m_RHI->GetVRAMUsageMB());
+        ImGui::Text("VRAM: %.1f / %.0f MB%s", g_Renderer.m_RHI->GetVRAMUsageMB(), BYTES_TO_MB(g_Renderer.m_VRAMBudget.GetBudget()),
+                    g_Renderer.m_VRAMBudget.IsUnderPressure() ? " (over budget)" : "");
+        ImGui::Separator();
+        ImGui::Text("Frame Alloc: %.2f / %.0f MB", BYTES_TO_MB(g_Renderer.m_FrameAllocator.GetHighWaterMark()), BYTES_TO_MB(g_Renderer.m_FrameAllocator.GetCapacity()));
+#if ENABLE_ALLOCATION_COUNTING
+        ImGui::Separator();
+        ImGui::Text("Heap Allocs: %llu", g_Renderer.m_HeapAllocationsLastFrame);
+#endif
         ImGui::EndMainMenuBar();
     }
 
@@ -182,6 +219,19 @@ void ImGuiLayer::UpdateFrame()
                 RTXDIIMGUISettings();
             }
 
+            ImGui::Checkbox("Clustered Lighting", &g_Renderer.m_EnableClusteredLighting);
+            if (g_Renderer.m_bLightClustersValid)
+            {
+                const LightClusterStats& stats = g_Renderer.m_LightClusterBinner.GetStats();
+                ImGui::Text("Lights: %u (%u global, %u visible)", stats.m_NumLights, stats.m_NumGlobalLights, stats.m_NumVisibleLights);
+                ImGui::Text("Clusters: %u / %u non-empty, max %u lights", stats.m_NumNonEmptyClusters, LightClusterBinner::kNumClusters, stats.m_MaxLightsPerCluster);
+                ImGui::Text("Indices: %u, far %.1f, bin %.2f ms", stats.m_NumIndices, stats.m_FarZ, g_Renderer.m_LightClusterBinMs);
+            }
+            else if (g_Renderer.m_EnableClusteredLighting)
+            {
+                ImGui::TextDisabled("Inactive (ReSTIR DI, IBL or path tracer)");
+            }
+
             ImGui::Separator();
 
             // ── Indirect Lighting Technique ─────────────────────────────────
@@ -577,6 +627,47 @@ void ImGuiLayer::UpdateFrame()
                 ? (stats.m_TilesAllocated * 100u / stats.m_TilesTotal) : 0u;
             ImGui::Text("Tiles Allocated: %u (%u%%)", stats.m_TilesAllocated, pct);
             ImGui::Text("Tiles Standby:   %u", stats.m_TilesStandby);
+            ImGui::Text("Tiles Pending:   %u (cancelled %u, stale %u)", stats.m_TilesPending, stats.m_TilesCancelled, stats.m_TilesStaleLoaded);
+            ImGui::Text("Prefetching:     %u textures", stats.m_TexturesPrefetched);
+            ImGui::Text("Tile Collection: %u of %u textures (%u resident)",
+                        stats.m_TexturesScanned, g_Renderer.m_FeedbackManager->GetNumTextures(), stats.m_TexturesResident);
+            ImGui::Text("Defrag:          %u tiles moved", stats.m_TilesMoved);
+            {
+                const nvfeedback::AsyncTileIO::IOStats ioStats = g_Renderer.m_AsyncTileIO->GetIOStats();
+                const uint64_t tilesRead = ioStats.m_NumTiles - ioStats.m_NumCachedTiles;
+                ImGui::Text("Reads per Tile:  %.2f (%llu reads, %.1f MB)",
+                    tilesRead > 0 ? (double)ioStats.m_NumReads / (double)tilesRead : 0.0,
+                    (unsigned long long)ioStats.m_NumReads, BYTES_TO_MB(ioStats.m_BytesRead));
+                // Per-core throughput: worker seconds are summed across threads
+                ImGui::Text("Read Throughput: %.2f GB/s per core",
+                    ioStats.m_ReadSeconds > 0.0 ? (double)ioStats.m_BytesRead / ioStats.m_ReadSeconds / 1e9 : 0.0);
+                if (ioStats.m_NumCompressedTiles > 0)
+                {
+                    ImGui::Text("Decode:          %.2f GB/s per core (%llu tiles, %.1f MB)",
+                        ioStats.m_DecodeSeconds > 0.0 ? (double)ioStats.m_BytesDecoded / ioStats.m_DecodeSeconds / 1e9 : 0.0,
+                        (unsigned long long)ioStats.m_NumCompressedTiles, BYTES_TO_MB(ioStats.m_BytesDecoded));
+                }
+                if (const nvfeedback::TileCache* tileCache = g_Renderer.m_AsyncTileIO->GetTileCache())
+                {
+                    const nvfeedback::TileCache::Stats cacheStats = tileCache->GetStats();
+                    const uint64_t lookups = cacheStats.m_NumHits + cacheStats.m_NumMisses;
+                    ImGui::Text("Tile Cache:      %.1f / %.1f MB, %u tiles, %.1f%% hits (%llu evicted)",
+                        BYTES_TO_MB(cacheStats.m_SizeInBytes), BYTES_TO_MB(cacheStats.m_CapacityBytes), cacheStats.m_NumEntries,
+                        lookups > 0 ? (double)cacheStats.m_NumHits * 100.0 / (double)lookups : 0.0,
+                        (unsigned long long)cacheStats.m_NumEvictions);
+                }
+            }
+
+            ImGui::SeparatorText(Config::Get().m_AdaptiveStreamingBudgets ? "Budgets (adaptive)" : "Budgets (fixed)");
+            {
+                const nvfeedback::StreamingBudgets& budgets = g_Renderer.m_FeedbackManager->GetBudgets();
+                const nvfeedback::StreamingBudgetController& controller = g_Renderer.m_StreamingBudgetController;
+                ImGui::Text("Tiles per Frame: %u (I/O capacity %.0f tiles/s)", budgets.m_MaxTilesPerFrame, controller.GetIOCapacityTilesPerSecond());
+                ImGui::Text("Resolves/Frame:  %u", budgets.m_FeedbackTexturesToResolvePerFrame);
+                ImGui::Text("Standby Tiles:   %u", budgets.m_NumExtraStandbyTiles);
+                ImGui::Text("Hysteresis:      %.2f s", budgets.m_TileHysteresisSeconds);
+                ImGui::Text("I/O Latency:     %.1f ms", controller.GetMeanLatencySeconds() * 1000.0);
+            }
 
             // ── Bandwidth moving average graph ──
             ImGui::SeparatorText("Bandwidth (MB/s)");
@@ -648,6 +739,13 @@ void ImGuiLayer::UpdateFrame()
             ImGui::Text("UpdateMappings:   %.3f ms", stats.m_CpuTimeUpdateTileMappings * 1000.0);
             ImGui::Text("ResolveFeedback:  %.3f ms", stats.m_CpuTimeResolve * 1000.0);
 
+            // Per-texture stats: writes the JSON report and logs the worst textures
+            if (ImGui::Button("Export Texture Stats"))
+            {
+                const std::string& statsPath = Config::Get().m_StreamingStatsPath;
+                g_Renderer.ReportTextureStreamingStats(statsPath.empty() ? "streaming_stats.json" : statsPath);
+            }
+
             ImGui::SeparatorText("Tile Residency Debug");
             {
                 const uint32_t numTex = g_Renderer.m_FeedbackManager->GetNumTextures();
@@ -696,6 +794,43 @@ void ImGuiLayer::UpdateFrame()
 
             ImGui::TreePop();
         }
+
+        if (g_Renderer.m_GeometryStreamer && ImGui::TreeNode("Geometry Streaming"))
+        {
+            const nvfeedback::GeometryStreamerStats stats = g_Renderer.m_GeometryStreamer->GetStats();
+
+            ImGui::SeparatorText("Memory");
+            ImGui::Text("Pool:            %.1f / %.1f MB", BYTES_TO_MB(stats.m_PoolBytesUsed), BYTES_TO_MB(stats.m_PoolBytesCapacity));
+            ImGui::Text("Pinned LODs:     %.1f MB", BYTES_TO_MB(stats.m_ResidentBytes));
+            ImGui::Text("Streamed LODs:   %.1f MB if all resident", BYTES_TO_MB(stats.m_StreamedBytes));
+            ImGui::Text("BLAS:            %.1f MB", BYTES_TO_MB(g_Renderer.m_Scene.m_BLASMemoryBytes));
+
+            ImGui::SeparatorText("Activity");
+            ImGui::Text("Resident:        %u of %u streamed LODs (%u primitives)", stats.m_NumResidentLODs, stats.m_NumStreamedLODs, stats.m_NumPrimitives);
+            ImGui::Text("Pending:         %u", stats.m_NumPendingLODs);
+            ImGui::Text("Loads:           %llu (%.1f MB)", (unsigned long long)stats.m_NumLoads, BYTES_TO_MB(stats.m_BytesLoaded));
+            ImGui::Text("Evictions:       %llu (pool full %llu times)", (unsigned long long)stats.m_NumEvictions, (unsigned long long)stats.m_NumFailedAllocations);
+
+            ImGui::TreePop();
+        }
+
+        if (g_Renderer.m_SceneCellStreamer && ImGui::TreeNode("Scene Cell Streaming"))
+        {
+            const nvfeedback::SceneCellStreamerStats stats = g_Renderer.m_SceneCellStreamer->GetStats();
+
+            ImGui::SeparatorText("Memory");
+            ImGui::Text("Pool:            %.1f / %.1f MB", BYTES_TO_MB(stats.m_PoolBytesUsed), BYTES_TO_MB(stats.m_PoolBytesCapacity));
+            ImGui::Text("Pinned models:   %.1f MB (%u models)", BYTES_TO_MB(stats.m_PinnedBytes), stats.m_NumPinnedModels);
+            ImGui::Text("Streamed models: %.1f MB if all loaded (%u models)", BYTES_TO_MB(stats.m_StreamedBytes), stats.m_NumModels - stats.m_NumPinnedModels);
+
+            ImGui::SeparatorText("Activity");
+            ImGui::Text("Loaded:          %u of %u cells", stats.m_NumLoadedCells, stats.m_NumCells);
+            ImGui::Text("Pending:         %u", stats.m_NumPendingCells);
+            ImGui::Text("Loads:           %llu (%.1f MB)", (unsigned long long)stats.m_NumLoads, BYTES_TO_MB(stats.m_BytesLoaded));
+            ImGui::Text("Unloads:         %llu (pool full %llu times)", (unsigned long long)stats.m_NumUnloads, (unsigned long long)stats.m_NumFailedAllocations);
+
+            ImGui::TreePop();
+        }
     }
     ImGui::End();
 
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CoreUtilities.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// ─── InplaceFunction ─────────────────────────────────────────────────────────
+// Move-only std::function replacement whose callable lives in a fixed inline
+// buffer, so storing and moving it never touches the heap.  A callable larger
+// than Capacity bytes is a compile error rather than a silent allocation:
+// capture pointers or indices, not containers.
+// ─────────────────────────────────────────────────────────────────────────────
+
+template <typename Signature, size_t Capacity = 64>
+class InplaceFunction;
+
+template <typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity>
+{
+public:
+    InplaceFunction() = default;
+
+    template <typename F, typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<Fn, InplaceFunction> && std::is_invocable_r_v<R, Fn&, Args...>>>
+    InplaceFunction(F&& f)
+    {
+        static_assert(sizeof(Fn) <= Capacity, "Callable does not fit in the InplaceFunction buffer");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "Callable is over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "Callable must be nothrow movable");
+
+        ::new (static_cast<void*>(m_Storage)) Fn(std::forward<F>(f));
+        m_Ops = &kOps<Fn>;
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept { MoveFrom(other); }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction() { Reset(); }
+
+    R operator()(Args... args) { return m_Ops->m_Invoke(m_Storage, std::forward<Args>(args)...); }
+
+    explicit operator bool() const { return m_Ops != nullptr; }
+
+    void Reset()
+    {
+        if (m_Ops)
+        {
+            m_Ops->m_Destroy(m_Storage);
+            m_Ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops
+    {
+        R    (*m_Invoke)(void* storage, Args&&... args);
+        void (*m_Move)(void* dst, void* src);   // move-constructs dst, destroys src
+        void (*m_Destroy)(void* storage);
+    };
+
+    template <typename Fn>
+    static constexpr Ops kOps =
+    {
+        [](void* storage, Args&&... args) -> R { return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...); },
+        [](void* dst, void* src) { ::new (dst) Fn(std::move(*static_cast<Fn*>(src))); static_cast<Fn*>(src)->~Fn(); },
+        [](void* storage) { static_cast<Fn*>(storage)->~Fn(); },
+    };
+
+    void MoveFrom(InplaceFunction& other)
+    {
+        if (other.m_Ops)
+        {
+            other.m_Ops->m_Move(m_Storage, other.m_Storage);
+            m_Ops = other.m_Ops;
+            other.m_Ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) std::byte m_Storage[Capacity];
+    const Ops* m_Ops = nullptr;
+};
+
+// ─── FunctionRef ─────────────────────────────────────────────────────────────
+// Non-owning reference to a callable, for parameters that are only called
+// during the call they are passed to.  Binding a lambda never allocates; the
+// callable must outlive the FunctionRef (a temporary argument does).
+// ─────────────────────────────────────────────────────────────────────────────
+
+template <typename Signature>
+class FunctionRef;
+
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)>
+{
+public:
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionRef> && std::is_invocable_r_v<R, F&, Args...>>>
+    FunctionRef(F&& f)
+        : m_Callable(const_cast<void*>(static_cast<const void*>(std::addressof(f))))
+        , m_Invoke([](void* callable, Args... args) -> R { return (*static_cast<std::remove_reference_t<F>*>(callable))(std::forward<Args>(args)...); })
+    {
+    }
+
+    R operator()(Args... args) const { return m_Invoke(m_Callable, std::forward<Args>(args)...); }
+
+private:
+    void* m_Callable = nullptr;
+    R (*m_Invoke)(void* callable, Args... args) = nullptr;
+};
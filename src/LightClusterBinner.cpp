@@ -0,0 +1,412 @@
+#include "LightClusterBinner.h"
+#include "TaskScheduler.h"
+
+#include <bit>
+
+using namespace DirectX;
+
+namespace
+{
+    // One bit per lane of an XMVectorLessOrEqual & co. result
+    uint32_t MoveMask(FXMVECTOR mask)
+    {
+#if defined(_XM_SSE_INTRINSICS_)
+        return (uint32_t)_mm_movemask_ps(mask);
+#else
+        return (XMVectorGetIntX(mask) ? 1u : 0u) | (XMVectorGetIntY(mask) ? 2u : 0u) |
+               (XMVectorGetIntZ(mask) ? 4u : 0u) | (XMVectorGetIntW(mask) ? 8u : 0u);
+#endif
+    }
+
+    XMVECTOR Load4(const float (&lanes)[4])
+    {
+        return XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(lanes));
+    }
+
+    uint8_t NDCToTileX(float ndc)
+    {
+        const float tile = std::floor((ndc + 1.0f) * 0.5f * LightClusterBinner::kGridX);
+        return (uint8_t)std::clamp(tile, 0.0f, float(LightClusterBinner::kGridX - 1));
+    }
+
+    // Row 0 is the top of the screen
+    uint8_t NDCToTileY(float ndc)
+    {
+        const float tile = std::floor((1.0f - ndc) * 0.5f * LightClusterBinner::kGridY);
+        return (uint8_t)std::clamp(tile, 0.0f, float(LightClusterBinner::kGridY - 1));
+    }
+
+    // Range of x / (z * tanHalfFov) over [minX, maxX] x [minZ, maxZ], minZ > 0
+    void ProjectInterval(float minX, float maxX, float minZ, float maxZ, float tanHalfFov, float& outMin, float& outMax)
+    {
+        outMin = std::min(minX / (minZ * tanHalfFov), minX / (maxZ * tanHalfFov));
+        outMax = std::max(maxX / (minZ * tanHalfFov), maxX / (maxZ * tanHalfFov));
+    }
+
+    // View-space extent of a tile edge-to-edge at [z0, z1]
+    void TileExtent(float ndcMin, float ndcMax, float z0, float z1, float tanHalfFov, float& outMin, float& outMax)
+    {
+        outMin = std::min(ndcMin * tanHalfFov * z0, ndcMin * tanHalfFov * z1);
+        outMax = std::max(ndcMax * tanHalfFov * z0, ndcMax * tanHalfFov * z1);
+    }
+}
+
+void LightClusterBinner::RowScratch::Set(uint32_t slot, const BinLight& light)
+{
+    LightQuad& quad = m_Quads[slot / 4];
+    const uint32_t lane = slot % 4;
+    quad.m_X[lane] = light.m_X;
+    quad.m_Y[lane] = light.m_Y;
+    quad.m_Z[lane] = light.m_Z;
+    quad.m_RangeSq[lane] = light.m_Range * light.m_Range;
+    quad.m_Range[lane] = light.m_Range;
+    quad.m_DirX[lane] = light.m_DirX;
+    quad.m_DirY[lane] = light.m_DirY;
+    quad.m_DirZ[lane] = light.m_DirZ;
+    quad.m_CosOuter[lane] = light.m_CosOuter;
+    quad.m_SinOuter[lane] = light.m_SinOuter;
+    quad.m_LightIndex[lane] = light.m_LightIndex;
+}
+
+void LightClusterBinner::RowScratch::SetEmpty(uint32_t slot)
+{
+    // A negative squared range fails the sphere test
+    Set(slot, BinLight{});
+    m_Quads[slot / 4].m_RangeSq[slot % 4] = -1.0f;
+}
+
+float LightClusterBinner::GetSliceStartZ(uint32_t z) const
+{
+    return std::exp((float(z) - m_ZBias) / m_ZScale);
+}
+
+uint32_t LightClusterBinner::GetSlice(float logViewZ) const
+{
+    const float slice = std::floor(logViewZ * m_ZScale + m_ZBias);
+    return (uint32_t)std::clamp(slice, 0.0f, float(kGridZ - 1));
+}
+
+void LightClusterBinner::ClassifyChunk(const std::vector<srrhi::GPULight>& lights, const LightClusterView& view, uint32_t chunk)
+{
+    LightChunk& out = m_Chunks[chunk];
+    out.m_Lights.clear();
+    out.m_GlobalLights.clear();
+    out.m_MaxZ = 0.0f;
+
+    const Matrix& m = view.m_WorldToView;
+    const uint32_t begin = chunk * kLightsPerChunk;
+    const uint32_t end = std::min(begin + kLightsPerChunk, (uint32_t)lights.size());
+
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        const srrhi::GPULight& light = lights[i];
+
+        // AccumulateLight does not shade point lights (1) on the raster path; listing
+        // them would only lengthen every cluster's loop
+        if (light.m_Type == 1)
+            continue;
+
+        // Directional (0) and unbounded lights reach every pixel
+        if (light.m_Type == 0 || light.m_Range <= 0.0f)
+        {
+            out.m_GlobalLights.push_back(i);
+            continue;
+        }
+
+        const Vector3& p = light.m_Position;
+        const float x = p.x * m._11 + p.y * m._21 + p.z * m._31 + m._41;
+        const float y = p.x * m._12 + p.y * m._22 + p.z * m._32 + m._42;
+        const float z = p.x * m._13 + p.y * m._23 + p.z * m._33 + m._43;
+        const float r = light.m_Range;
+
+        if (z + r < m_NearZ)
+            continue;
+
+        // The visible part of the sphere is in [x +- r] x [y +- r] x [max(z - r, near), z + r]
+        const float minZ = std::max(z - r, m_NearZ);
+        float minX, maxX, minY, maxY;
+        ProjectInterval(x - r, x + r, minZ, z + r, m_TanHalfFovX, minX, maxX);
+        ProjectInterval(y - r, y + r, minZ, z + r, m_TanHalfFovY, minY, maxY);
+
+        const float edge = 1.0f + kEdgeMarginNDC;
+        if (maxX < -edge || minX > edge || maxY < -edge || minY > edge)
+            continue;
+
+        BinLight bin{};
+        bin.m_X = x;
+        bin.m_Y = y;
+        bin.m_Z = z;
+        bin.m_Range = r;
+        bin.m_LogMinZ = std::log(minZ);
+        bin.m_LogMaxZ = std::log(z + r);
+        bin.m_MinTileX = NDCToTileX(minX);
+        bin.m_MaxTileX = NDCToTileX(maxX);
+        bin.m_MinTileY = NDCToTileY(maxY);
+        bin.m_MaxTileY = NDCToTileY(minY);
+        bin.m_LightIndex = i;
+
+        // Spot (2) cones narrower than a hemisphere; wider ones are binned as spheres
+        if (light.m_Type == 2 && light.m_SpotOuterConeAngle < XM_PIDIV2)
+        {
+            const Vector3& d = light.m_Direction;
+            const float dx = d.x * m._11 + d.y * m._21 + d.z * m._31;
+            const float dy = d.x * m._12 + d.y * m._22 + d.z * m._32;
+            const float dz = d.x * m._13 + d.y * m._23 + d.z * m._33;
+            const float lengthSq = dx * dx + dy * dy + dz * dz;
+            if (lengthSq > 0.0f)
+            {
+                const float invLength = 1.0f / std::sqrt(lengthSq);
+                bin.m_DirX = dx * invLength;
+                bin.m_DirY = dy * invLength;
+                bin.m_DirZ = dz * invLength;
+                bin.m_CosOuter = std::cos(light.m_SpotOuterConeAngle);
+                bin.m_SinOuter = std::sin(light.m_SpotOuterConeAngle);
+            }
+        }
+
+        out.m_Lights.push_back(bin);
+        out.m_MaxZ = std::max(out.m_MaxZ, z + r);
+    }
+}
+
+void LightClusterBinner::BinRow(uint32_t slice, uint32_t row, uint32_t threadIndex)
+{
+    const uint32_t task = slice * kGridY + row;
+    std::vector<uint32_t>& out = m_RowIndices[task];
+    uint32_t* counts = &m_ClusterCounts[task * kGridX];
+    out.clear();
+    std::fill(counts, counts + kGridX, 0u);
+
+    const uint32_t* rowLights = m_RowLights.data() + m_RowOffsets[task];
+    const uint32_t numRowLights = m_RowOffsets[task + 1] - m_RowOffsets[task];
+    if (numRowLights == 0)
+        return;
+
+    // Bucket the row's lights by tile (counting sort), padding each tile's run to whole quads
+    std::array<uint32_t, kGridX> tileCounts{};
+    for (uint32_t i = 0; i < numRowLights; ++i)
+    {
+        const BinLight& light = m_BinLights[rowLights[i]];
+        for (uint32_t x = light.m_MinTileX; x <= light.m_MaxTileX; ++x)
+        {
+            ++tileCounts[x];
+        }
+    }
+
+    RowScratch& scratch = m_RowScratch[threadIndex];
+    std::array<uint32_t, kGridX> cursor;
+    scratch.m_TileOffsets[0] = 0;
+    for (uint32_t x = 0; x < kGridX; ++x)
+    {
+        cursor[x] = scratch.m_TileOffsets[x];
+        scratch.m_TileOffsets[x + 1] = scratch.m_TileOffsets[x] + ((tileCounts[x] + 3) & ~3u);
+    }
+    scratch.m_Quads.resize(scratch.m_TileOffsets[kGridX] / 4);
+    for (uint32_t i = 0; i < numRowLights; ++i)
+    {
+        const BinLight& light = m_BinLights[rowLights[i]];
+        for (uint32_t x = light.m_MinTileX; x <= light.m_MaxTileX; ++x)
+        {
+            scratch.Set(cursor[x]++, light);
+        }
+    }
+    for (uint32_t x = 0; x < kGridX; ++x)
+    {
+        for (uint32_t slot = cursor[x]; slot < scratch.m_TileOffsets[x + 1]; ++slot)
+        {
+            scratch.SetEmpty(slot);
+        }
+    }
+
+    const float z0 = GetSliceStartZ(slice);
+    const float z1 = GetSliceStartZ(slice + 1);
+
+    const float ndcTop = row == 0 ? 1.0f + kEdgeMarginNDC : 1.0f - 2.0f * row / kGridY;
+    const float ndcBottom = row == kGridY - 1 ? -1.0f - kEdgeMarginNDC : 1.0f - 2.0f * (row + 1) / kGridY;
+    float minY, maxY;
+    TileExtent(ndcBottom, ndcTop, z0, z1, m_TanHalfFovY, minY, maxY);
+
+    const XMVECTOR vMinY = XMVectorReplicate(minY);
+    const XMVECTOR vMaxY = XMVectorReplicate(maxY);
+    const XMVECTOR vMinZ = XMVectorReplicate(z0);
+    const XMVECTOR vMaxZ = XMVectorReplicate(z1);
+    const XMVECTOR vZero = XMVectorZero();
+
+    for (uint32_t x = 0; x < kGridX; ++x)
+    {
+        if (tileCounts[x] == 0)
+            continue;
+
+        const float ndcLeft = x == 0 ? -1.0f - kEdgeMarginNDC : -1.0f + 2.0f * x / kGridX;
+        const float ndcRight = x == kGridX - 1 ? 1.0f + kEdgeMarginNDC : -1.0f + 2.0f * (x + 1) / kGridX;
+        float minX, maxX;
+        TileExtent(ndcLeft, ndcRight, z0, z1, m_TanHalfFovX, minX, maxX);
+
+        // Froxel bounding sphere, for the cone test
+        const float halfX = 0.5f * (maxX - minX);
+        const float halfY = 0.5f * (maxY - minY);
+        const float halfZ = 0.5f * (z1 - z0);
+        const XMVECTOR vCenterX = XMVectorReplicate(minX + halfX);
+        const XMVECTOR vCenterY = XMVectorReplicate(minY + halfY);
+        const XMVECTOR vCenterZ = XMVectorReplicate(z0 + halfZ);
+        const XMVECTOR vRadius = XMVectorReplicate(std::sqrt(halfX * halfX + halfY * halfY + halfZ * halfZ));
+
+        const XMVECTOR vMinX = XMVectorReplicate(minX);
+        const XMVECTOR vMaxX = XMVectorReplicate(maxX);
+
+        uint32_t count = 0;
+        for (uint32_t q = scratch.m_TileOffsets[x] / 4; q < scratch.m_TileOffsets[x + 1] / 4; ++q)
+        {
+            const LightQuad& quad = scratch.m_Quads[q];
+            const XMVECTOR lx = Load4(quad.m_X);
+            const XMVECTOR ly = Load4(quad.m_Y);
+            const XMVECTOR lz = Load4(quad.m_Z);
+
+            // Sphere vs AABB: distance from the light to the box
+            const XMVECTOR dx = XMVectorMax(XMVectorMax(XMVectorSubtract(vMinX, lx), XMVectorSubtract(lx, vMaxX)), vZero);
+            const XMVECTOR dy = XMVectorMax(XMVectorMax(XMVectorSubtract(vMinY, ly), XMVectorSubtract(ly, vMaxY)), vZero);
+            const XMVECTOR dz = XMVectorMax(XMVectorMax(XMVectorSubtract(vMinZ, lz), XMVectorSubtract(lz, vMaxZ)), vZero);
+            const XMVECTOR distSq = XMVectorMultiplyAdd(dx, dx, XMVectorMultiplyAdd(dy, dy, XMVectorMultiply(dz, dz)));
+            XMVECTOR mask = XMVectorLessOrEqual(distSq, Load4(quad.m_RangeSq));
+
+            if (MoveMask(mask) == 0)
+                continue;
+
+            // Cone vs the froxel's bounding sphere (Wronski, "Cull that cone"); point lights
+            // have a zero axis and angle, which passes all three tests
+            const XMVECTOR vx = XMVectorSubtract(vCenterX, lx);
+            const XMVECTOR vy = XMVectorSubtract(vCenterY, ly);
+            const XMVECTOR vz = XMVectorSubtract(vCenterZ, lz);
+            const XMVECTOR lengthSq = XMVectorMultiplyAdd(vx, vx, XMVectorMultiplyAdd(vy, vy, XMVectorMultiply(vz, vz)));
+            const XMVECTOR axial = XMVectorMultiplyAdd(vx, Load4(quad.m_DirX),
+                                   XMVectorMultiplyAdd(vy, Load4(quad.m_DirY), XMVectorMultiply(vz, Load4(quad.m_DirZ))));
+            const XMVECTOR radial = XMVectorSqrt(XMVectorMax(XMVectorSubtract(lengthSq, XMVectorMultiply(axial, axial)), vZero));
+            const XMVECTOR closest = XMVectorSubtract(XMVectorMultiply(Load4(quad.m_CosOuter), radial),
+                                                      XMVectorMultiply(axial, Load4(quad.m_SinOuter)));
+
+            mask = XMVectorAndInt(mask, XMVectorLessOrEqual(closest, vRadius));
+            mask = XMVectorAndInt(mask, XMVectorLessOrEqual(axial, XMVectorAdd(vRadius, Load4(quad.m_Range))));
+            mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(axial, XMVectorNegate(vRadius)));
+
+            for (uint32_t bits = MoveMask(mask); bits != 0; bits &= bits - 1)
+            {
+                out.push_back(quad.m_LightIndex[std::countr_zero(bits)]);
+                ++count;
+            }
+        }
+        counts[x] = count;
+    }
+}
+
+void LightClusterBinner::Bin(const std::vector<srrhi::GPULight>& lights, const LightClusterView& view, TaskScheduler& scheduler)
+{
+    PROFILE_FUNCTION();
+
+    m_TanHalfFovX = view.m_TanHalfFovX;
+    m_TanHalfFovY = view.m_TanHalfFovY;
+    m_NearZ = view.m_NearZ;
+    m_Stats = {};
+    m_Stats.m_NumLights = (uint32_t)lights.size();
+
+    // 1. View space, frustum culling and tile rectangles
+    const uint32_t numChunks = ((uint32_t)lights.size() + kLightsPerChunk - 1) / kLightsPerChunk;
+    if (m_Chunks.size() < numChunks)
+    {
+        m_Chunks.resize(numChunks);
+    }
+    {
+        PROFILE_SCOPED("Classify");
+        scheduler.ParallelFor(numChunks, [this, &lights, &view](uint32_t chunk, uint32_t) { ClassifyChunk(lights, view, chunk); });
+    }
+
+    m_BinLights.clear();
+    m_LightIndices.clear();
+    float farZ = m_NearZ * 2.0f;
+    for (uint32_t chunk = 0; chunk < numChunks; ++chunk)
+    {
+        const LightChunk& c = m_Chunks[chunk];
+        m_LightIndices.insert(m_LightIndices.end(), c.m_GlobalLights.begin(), c.m_GlobalLights.end());
+        m_BinLights.insert(m_BinLights.end(), c.m_Lights.begin(), c.m_Lights.end());
+        farZ = std::max(farZ, c.m_MaxZ);
+    }
+    const uint32_t numGlobalLights = (uint32_t)m_LightIndices.size();
+
+    // 2. Exponential slices over [near, far]
+    m_ZScale = kGridZ / std::log(farZ / m_NearZ);
+    m_ZBias = -std::log(m_NearZ) * m_ZScale;
+
+    for (BinLight& light : m_BinLights)
+    {
+        light.m_MinSlice = (uint8_t)GetSlice(light.m_LogMinZ);
+        light.m_MaxSlice = (uint8_t)GetSlice(light.m_LogMaxZ);
+    }
+
+    // Bucket by (slice, row) cell (counting sort)
+    m_RowOffsets.assign(kNumRows + 1, 0);
+    for (const BinLight& light : m_BinLights)
+    {
+        for (uint32_t z = light.m_MinSlice; z <= light.m_MaxSlice; ++z)
+        {
+            for (uint32_t y = light.m_MinTileY; y <= light.m_MaxTileY; ++y)
+            {
+                ++m_RowOffsets[z * kGridY + y + 1];
+            }
+        }
+    }
+    for (uint32_t row = 0; row < kNumRows; ++row)
+    {
+        m_RowOffsets[row + 1] += m_RowOffsets[row];
+    }
+    m_RowLights.resize(m_RowOffsets[kNumRows]);
+    {
+        std::array<uint32_t, kNumRows> cursor;
+        std::copy(m_RowOffsets.begin(), m_RowOffsets.begin() + kNumRows, cursor.begin());
+        for (uint32_t i = 0; i < (uint32_t)m_BinLights.size(); ++i)
+        {
+            const BinLight& light = m_BinLights[i];
+            for (uint32_t z = light.m_MinSlice; z <= light.m_MaxSlice; ++z)
+            {
+                for (uint32_t y = light.m_MinTileY; y <= light.m_MaxTileY; ++y)
+                {
+                    m_RowLights[cursor[z * kGridY + y]++] = i;
+                }
+            }
+        }
+    }
+
+    // 3. Froxel tests, one (slice, row) per task
+    m_RowScratch.resize(std::max((size_t)scheduler.GetThreadCount() + 1, m_RowScratch.size()));
+    m_RowIndices.resize(kNumRows);
+    m_ClusterCounts.resize(kNumClusters);
+    {
+        PROFILE_SCOPED("Bin Rows");
+        scheduler.ParallelFor(kNumRows, [this](uint32_t task, uint32_t threadIndex) { BinRow(task / kGridY, task % kGridY, threadIndex); });
+    }
+
+    // 4. Ranges and the compact index list; a row's clusters are consecutive
+    m_Clusters.resize(kNumClusters);
+    uint32_t offset = numGlobalLights;
+    for (uint32_t c = 0; c < kNumClusters; ++c)
+    {
+        const uint32_t count = m_ClusterCounts[c];
+        m_Clusters[c] = { offset, count };
+        offset += count;
+
+        m_Stats.m_NumNonEmptyClusters += count != 0 ? 1 : 0;
+        m_Stats.m_MaxLightsPerCluster = std::max(m_Stats.m_MaxLightsPerCluster, count);
+    }
+    m_LightIndices.resize(offset);
+    for (uint32_t task = 0; task < kNumRows; ++task)
+    {
+        const std::vector<uint32_t>& rowIndices = m_RowIndices[task];
+        if (!rowIndices.empty())
+        {
+            std::memcpy(&m_LightIndices[m_Clusters[task * kGridX].m_Offset], rowIndices.data(), rowIndices.size() * sizeof(uint32_t));
+        }
+    }
+
+    m_Stats.m_NumGlobalLights = numGlobalLights;
+    m_Stats.m_NumVisibleLights = (uint32_t)m_BinLights.size();
+    m_Stats.m_NumIndices = offset;
+    m_Stats.m_FarZ = farZ;
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "shaders/srrhi/cpp/GPULight.h"
+
+class TaskScheduler;
+
+// ─── LightClusterBinner ──────────────────────────────────────────────────────
+// Bins the local lights of Scene::m_GPULights into a froxel grid (screen tiles
+// × exponential depth slices) on the CPU every frame, so the deferred pass
+// shades the lights of its pixel's cluster instead of every light.  Point
+// lights are skipped: the raster path's AccumulateLight does not shade them.
+//
+// Output, as uploaded to the GPU:
+//   - light indices: the global lights first (directional lights, lights with
+//     an unbounded range), then each cluster's local lights,
+//   - one range { offset, count } into the indices per cluster, ordered
+//     x + y * kGridX + z * kGridX * kGridY.
+//
+// Bin():
+//   1. ParallelFor over chunks of lights: transform to view space, cull
+//      against the frustum and compute the tile rectangle of each light
+//      sphere.
+//   2. Depth slices span [near, far], far being the farthest light extent;
+//      the lights are bucketed by the (slice, row) cells they overlap.
+//   3. ParallelFor over (slice, row): every froxel of the row tests the
+//      lights whose tile rectangle covers it four at a time, sphere vs froxel
+//      AABB and, for spot lights, cone vs froxel bounding sphere.  Each task
+//      writes its own row of clusters, which are contiguous, so nothing is
+//      shared.
+//   4. A prefix sum over the cluster counts places the rows in the index list.
+//
+// Lists are conservative: a light may be listed for a froxel it does not
+// touch, never the reverse.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct LightClusterView
+{
+    Matrix m_WorldToView;      // left-handed, +z forward
+    float  m_TanHalfFovX = 1.0f;
+    float  m_TanHalfFovY = 1.0f;
+    float  m_NearZ       = 0.1f;
+};
+
+struct LightClusterStats
+{
+    uint32_t m_NumLights           = 0;
+    uint32_t m_NumGlobalLights     = 0;
+    uint32_t m_NumVisibleLights    = 0; // local lights that overlap the frustum
+    uint32_t m_NumIndices          = 0; // global + cluster entries
+    uint32_t m_NumNonEmptyClusters = 0;
+    uint32_t m_MaxLightsPerCluster = 0;
+    float    m_FarZ                = 0.0f;
+};
+
+class LightClusterBinner
+{
+public:
+    static constexpr uint32_t kGridX       = 16;
+    static constexpr uint32_t kGridY       = 9;
+    static constexpr uint32_t kGridZ       = 24;
+    static constexpr uint32_t kNumClusters = kGridX * kGridY * kGridZ;
+
+    // Outer tiles extend past the frustum edge by this much (NDC), for pixels whose
+    // reconstructed position lands just outside it (TAA jitter, rounding)
+    static constexpr float kEdgeMarginNDC = 0.01f;
+
+    // StructuredBuffer<uint2> LightClusters
+    struct ClusterRange
+    {
+        uint32_t m_Offset = 0;
+        uint32_t m_Count  = 0;
+    };
+
+    void Bin(const std::vector<srrhi::GPULight>& lights, const LightClusterView& view, TaskScheduler& scheduler);
+
+    const std::vector<ClusterRange>& GetClusters() const { return m_Clusters; }
+    const std::vector<uint32_t>& GetLightIndices() const { return m_LightIndices; }
+    const LightClusterStats& GetStats() const { return m_Stats; }
+
+    // Depth slice of view-space z: floor(log(z) * GetZScale() + GetZBias())
+    float GetZScale() const { return m_ZScale; }
+    float GetZBias() const { return m_ZBias; }
+    float GetNearZ() const { return m_NearZ; }
+    float GetFarZ() const { return m_Stats.m_FarZ; }
+
+    // View-space depth where slice z begins (z == kGridZ: where the last one ends)
+    float GetSliceStartZ(uint32_t z) const;
+
+private:
+    // A local light in view space, with the cells its sphere projects to
+    struct BinLight
+    {
+        float    m_X, m_Y, m_Z, m_Range;
+        float    m_DirX, m_DirY, m_DirZ;  // spot axis; zero for point lights (no cone test)
+        float    m_CosOuter, m_SinOuter;  // zero for point lights
+        float    m_LogMinZ, m_LogMaxZ;    // log of the sphere's depth range, near-clamped
+        uint8_t  m_MinTileX, m_MaxTileX;
+        uint8_t  m_MinTileY, m_MaxTileY;
+        uint8_t  m_MinSlice, m_MaxSlice;
+        uint32_t m_LightIndex;
+    };
+
+    struct LightChunk
+    {
+        std::vector<BinLight> m_Lights;
+        std::vector<uint32_t> m_GlobalLights;
+        float                 m_MaxZ = 0.0f;
+    };
+
+    // Four lights, one per SIMD lane
+    struct alignas(16) LightQuad
+    {
+        float    m_X[4], m_Y[4], m_Z[4], m_RangeSq[4], m_Range[4];
+        float    m_DirX[4], m_DirY[4], m_DirZ[4], m_CosOuter[4], m_SinOuter[4];
+        uint32_t m_LightIndex[4];
+    };
+
+    // A row's lights bucketed by tile.  Each tile's run is padded to whole quads
+    // with lights that fail the sphere test.
+    struct RowScratch
+    {
+        std::vector<LightQuad>           m_Quads;
+        std::array<uint32_t, kGridX + 1> m_TileOffsets{}; // in lights, multiples of 4
+
+        void Set(uint32_t slot, const BinLight& light);
+        void SetEmpty(uint32_t slot);
+    };
+
+    void ClassifyChunk(const std::vector<srrhi::GPULight>& lights, const LightClusterView& view, uint32_t chunk);
+    void BinRow(uint32_t slice, uint32_t row, uint32_t threadIndex);
+    uint32_t GetSlice(float logViewZ) const;
+
+    static constexpr uint32_t kLightsPerChunk = 1024;
+    static constexpr uint32_t kNumRows        = kGridY * kGridZ; // (slice, row) cells, slice-major
+
+    std::vector<LightChunk>   m_Chunks;
+    std::vector<BinLight>     m_BinLights;
+    std::vector<uint32_t>     m_RowOffsets;      // kNumRows + 1, into m_RowLights
+    std::vector<uint32_t>     m_RowLights;       // m_BinLights indices, bucketed by (slice, row)
+    std::vector<RowScratch>   m_RowScratch;      // per worker thread
+    std::vector<std::vector<uint32_t>> m_RowIndices; // per (slice, row), its clusters' lists back to back
+    std::vector<uint32_t>     m_ClusterCounts;
+    std::vector<ClusterRange> m_Clusters;
+    std::vector<uint32_t>     m_LightIndices;
+
+    float m_TanHalfFovX = 1.0f;
+    float m_TanHalfFovY = 1.0f;
+    float m_NearZ  = 0.1f;
+    float m_ZScale = 0.0f;
+    float m_ZBias  = 0.0f;
+
+    LightClusterStats m_Stats;
+};
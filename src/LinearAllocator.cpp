@@ -0,0 +1,136 @@
+#include "LinearAllocator.h"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+// ─── LinearAllocator ─────────────────────────────────────────────────────────
+
+LinearAllocator::LinearAllocator(size_t capacityBytes)
+    : m_Capacity(capacityBytes)
+{
+    m_Arena = static_cast<uint8_t*>(::operator new(capacityBytes, std::align_val_t{ 64 }));
+}
+
+LinearAllocator::~LinearAllocator()
+{
+    ::operator delete(m_Arena, std::align_val_t{ 64 });
+}
+
+void LinearAllocator::Reset()
+{
+    const size_t used = m_Offset.exchange(0, std::memory_order_relaxed);
+    m_HighWaterMark = std::max(m_HighWaterMark, std::min(used, m_Capacity));
+    m_OverflowCount.store(0, std::memory_order_relaxed);
+}
+
+void* LinearAllocator::do_allocate(size_t bytes, size_t alignment)
+{
+    const uintptr_t base = reinterpret_cast<uintptr_t>(m_Arena);
+
+    size_t offset = m_Offset.load(std::memory_order_relaxed);
+    while (true)
+    {
+        const uintptr_t alignedAddr = (base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        const size_t newOffset = (alignedAddr - base) + bytes;
+        if (newOffset > m_Capacity)
+        {
+            break;
+        }
+        if (m_Offset.compare_exchange_weak(offset, newOffset, std::memory_order_relaxed))
+        {
+            return reinterpret_cast<void*>(alignedAddr);
+        }
+    }
+
+    m_OverflowCount.fetch_add(1, std::memory_order_relaxed);
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void LinearAllocator::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    // Arena memory is reclaimed wholesale by Reset(); only overflow goes back to the heap.
+    const uint8_t* ptr = static_cast<const uint8_t*>(p);
+    if (ptr < m_Arena || ptr >= m_Arena + m_Capacity)
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+}
+
+// ─── Allocation counting ─────────────────────────────────────────────────────
+
+#if ENABLE_ALLOCATION_COUNTING
+
+static std::atomic<uint64_t> s_GlobalAllocationCount{ 0 };
+
+// Everything goes through the aligned allocator so every delete can use AlignedFree
+static void* AlignedAllocate(size_t size, size_t alignment) noexcept
+{
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc wants the size to be a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+static void AlignedFree(void* p) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+static void* CountedAllocate(size_t size, size_t alignment) noexcept
+{
+    s_GlobalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return AlignedAllocate(size ? size : 1, std::max<size_t>(alignment, __STDCPP_DEFAULT_NEW_ALIGNMENT__));
+}
+
+static void* CountedAllocateOrThrow(size_t size, size_t alignment)
+{
+    void* p = CountedAllocate(size, alignment);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size)                                          { return CountedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size)                                        { return CountedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, std::align_val_t al)                     { return CountedAllocateOrThrow(size, (size_t)al); }
+void* operator new[](size_t size, std::align_val_t al)                   { return CountedAllocateOrThrow(size, (size_t)al); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept          { return CountedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept        { return CountedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept   { return CountedAllocate(size, (size_t)al); }
+void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return CountedAllocate(size, (size_t)al); }
+
+void operator delete(void* p) noexcept                                   { AlignedFree(p); }
+void operator delete[](void* p) noexcept                                 { AlignedFree(p); }
+void operator delete(void* p, size_t) noexcept                           { AlignedFree(p); }
+void operator delete[](void* p, size_t) noexcept                         { AlignedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept                 { AlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept               { AlignedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept         { AlignedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept       { AlignedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept            { AlignedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept          { AlignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept   { AlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { AlignedFree(p); }
+
+uint64_t GetGlobalAllocationCount()
+{
+    return s_GlobalAllocationCount.load(std::memory_order_relaxed);
+}
+
+#else
+
+uint64_t GetGlobalAllocationCount()
+{
+    return 0;
+}
+
+#endif // ENABLE_ALLOCATION_COUNTING
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreUtilities.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// ─── LinearAllocator ─────────────────────────────────────────────────────────
+// Lock-free bump allocator over a fixed arena, exposed as a std::pmr memory
+// resource so per-frame scratch containers (std::pmr::vector, ...) can use it
+// instead of the global heap.  Individual deallocations are no-ops; Reset()
+// rewinds the whole arena and must only be called once nothing allocated
+// since the previous Reset() is still alive (i.e. at the top of a frame).
+//
+// Requests that do not fit fall back to the global heap and are counted, so
+// the arena size can be tuned from GetOverflowCount() / GetHighWaterMark().
+class LinearAllocator final : public std::pmr::memory_resource
+{
+public:
+    explicit LinearAllocator(size_t capacityBytes);
+    ~LinearAllocator() override;
+
+    LinearAllocator(const LinearAllocator&) = delete;
+    LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+    void Reset();
+
+    size_t   GetCapacity()      const { return m_Capacity; }
+    size_t   GetBytesUsed()     const { return std::min(m_Offset.load(std::memory_order_relaxed), m_Capacity); }
+    size_t   GetHighWaterMark() const { return m_HighWaterMark; }
+    // Number of allocations since the last Reset() that did not fit in the arena.
+    uint32_t GetOverflowCount() const { return m_OverflowCount.load(std::memory_order_relaxed); }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void  do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    uint8_t*              m_Arena    = nullptr;
+    size_t                m_Capacity = 0;
+    std::atomic<size_t>   m_Offset{ 0 };
+    size_t                m_HighWaterMark = 0;
+    std::atomic<uint32_t> m_OverflowCount{ 0 };
+};
+
+// ─── Allocation counting ─────────────────────────────────────────────────────
+// When enabled, LinearAllocator.cpp replaces the global operator new/delete
+// with versions that bump a process-wide counter.  Sample it before and after
+// a region to assert that steady-state frames do not touch the heap.  On by
+// default in debug builds; define ENABLE_ALLOCATION_COUNTING to override.
+#ifndef ENABLE_ALLOCATION_COUNTING
+    #ifdef NDEBUG
+        #define ENABLE_ALLOCATION_COUNTING 0
+    #else
+        #define ENABLE_ALLOCATION_COUNTING 1
+    #endif
+#endif
+
+// Total number of global operator new calls so far (always 0 when disabled).
+uint64_t GetGlobalAllocationCount();
@@ -0,0 +1,507 @@
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdarg>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // ─── Record layout ───────────────────────────────────────────────────────
+    // [RecordHeader][payload ...][pad to 8]
+    // A header with m_FormatFn == nullptr is a wrap marker: skip m_Size bytes.
+    struct RecordHeader
+    {
+        uint32_t       m_Size   = 0; // header + payload, 8-byte aligned
+        Log::Level     m_Level  = Log::Level::Info;
+        uint64_t       m_Timestamp = 0;
+        const char*    m_Format = nullptr;
+        Log::FormatFn  m_FormatFn = nullptr;
+    };
+    static_assert(sizeof(RecordHeader) % 8 == 0);
+
+    constexpr uint32_t kRingMask = Log::kRingBufferBytes - 1;
+    static_assert((Log::kRingBufferBytes & kRingMask) == 0, "kRingBufferBytes must be a power of two");
+
+    // ─── ThreadRing ──────────────────────────────────────────────────────────
+    // SPSC ring: the owning thread advances m_Head, the sink thread advances m_Tail.
+    struct ThreadRing
+    {
+        alignas(64) std::atomic<uint32_t> m_Head{ 0 };
+        alignas(64) std::atomic<uint32_t> m_Tail{ 0 };
+        alignas(64) std::atomic<uint32_t> m_Dropped{ 0 };
+        std::atomic<bool> m_bAbandoned{ false }; // owning thread exited
+        // Set by the owning thread from before it checks that the logger runs until
+        // the record is committed or dropped; Shutdown waits for it to clear
+        std::atomic<bool> m_bWriting{ false };
+
+        uint32_t m_ThreadIndex = 0;
+
+        // Producer-side state between BeginRecord and CommitRecord
+        uint32_t m_PendingHead = 0;
+
+        alignas(64) uint8_t m_Data[Log::kRingBufferBytes];
+    };
+
+    struct LogState
+    {
+        std::mutex                               m_RingsMutex;
+        std::vector<std::unique_ptr<ThreadRing>> m_Rings;
+        uint32_t                                 m_NextThreadIndex = 0;
+
+        std::thread             m_SinkThread;
+        std::mutex              m_SinkMutex;
+        std::condition_variable m_SinkCV;       // wakes the sink
+        std::condition_variable m_FlushedCV;    // wakes Flush() callers
+        uint64_t                m_FlushRequested = 0;
+        uint64_t                m_FlushCompleted = 0;
+        bool                    m_bStop = false;
+
+        std::atomic<bool> m_bRunning{ false };
+
+        std::atomic<Log::ConsoleOutputFn> m_ConsoleOutput{ nullptr };
+
+        // Sink-thread only
+        std::string   m_FilePath;
+        std::ofstream m_File;
+        uint64_t      m_FileBytes = 0;
+        uint64_t      m_TicksAtStart = 0;
+    };
+
+    LogState& GetState()
+    {
+        static LogState s_State;
+        return s_State;
+    }
+
+    // Marks the thread's ring as abandoned on thread exit so it can be reused.
+    struct ThreadRingOwner
+    {
+        ThreadRing* m_Ring = nullptr;
+        ~ThreadRingOwner()
+        {
+            if (m_Ring)
+                m_Ring->m_bAbandoned.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local ThreadRingOwner t_RingOwner;
+
+    // Synchronous fallback scratch (logger not running)
+    thread_local uint8_t         t_FallbackPayload[Log::kMaxRecordBytes];
+    thread_local RecordHeader    t_FallbackHeader;
+    thread_local bool            t_bFallbackPending = false;
+
+    ThreadRing* GetThreadRing()
+    {
+        if (t_RingOwner.m_Ring)
+            return t_RingOwner.m_Ring;
+
+        LogState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_RingsMutex);
+
+        // Reuse a ring whose thread has exited and which the sink has fully drained
+        for (const std::unique_ptr<ThreadRing>& ring : state.m_Rings)
+        {
+            if (ring->m_bAbandoned.load(std::memory_order_acquire) &&
+                ring->m_Head.load(std::memory_order_acquire) == ring->m_Tail.load(std::memory_order_acquire))
+            {
+                ring->m_bAbandoned.store(false, std::memory_order_relaxed);
+                ring->m_ThreadIndex = state.m_NextThreadIndex++;
+                t_RingOwner.m_Ring = ring.get();
+                return ring.get();
+            }
+        }
+
+        state.m_Rings.push_back(std::make_unique<ThreadRing>());
+        ThreadRing* ring = state.m_Rings.back().get();
+        ring->m_ThreadIndex = state.m_NextThreadIndex++;
+        t_RingOwner.m_Ring = ring;
+        return ring;
+    }
+
+    uint64_t GetTimestamp()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    char LevelChar(Log::Level level)
+    {
+        switch (level)
+        {
+        case Log::Level::Verbose: return 'V';
+        case Log::Level::Warn:    return 'W';
+        case Log::Level::Error:   return 'E';
+        default:                  return 'I';
+        }
+    }
+
+    void WriteConsole(Log::Level level, const char* text)
+    {
+        if (const Log::ConsoleOutputFn outputFn = GetState().m_ConsoleOutput.load(std::memory_order_acquire))
+        {
+            outputFn(level, text);
+            return;
+        }
+        std::fprintf(stderr, "%s\n", text);
+    }
+
+    // Logger not running: the record is formatted and written by CommitRecord
+    uint8_t* BeginFallbackRecord(Log::Level level, const char* format, Log::FormatFn formatFn, uint32_t payloadSize)
+    {
+        if (sizeof(RecordHeader) + payloadSize > Log::kMaxRecordBytes)
+        {
+            char text[256];
+            std::snprintf(text, sizeof(text), "[Log] record too large (%u bytes): %s", payloadSize, format);
+            WriteConsole(Log::Level::Error, text);
+            return nullptr;
+        }
+        t_FallbackHeader = RecordHeader{ 0, level, 0, format, formatFn };
+        t_bFallbackPending = true;
+        return t_FallbackPayload;
+    }
+
+    // ─── Sink ────────────────────────────────────────────────────────────────
+
+    struct FormattedLine
+    {
+        uint64_t    m_Timestamp = 0;
+        uint32_t    m_ThreadIndex = 0;
+        Log::Level  m_Level = Log::Level::Info;
+        std::string m_Text;
+    };
+
+    void RotateLogFile(LogState& state)
+    {
+        state.m_File.close();
+
+        std::error_code ec;
+        const std::filesystem::path path{ state.m_FilePath };
+        const std::filesystem::path stem = path.parent_path() / path.stem();
+        const std::string ext = path.extension().string();
+
+        // HobbyRenderer.log -> HobbyRenderer.1.log -> ... -> HobbyRenderer.<kMaxRotatedFiles>.log (dropped)
+        for (uint32_t i = Log::kMaxRotatedFiles; i >= 1; --i)
+        {
+            const std::filesystem::path dst = stem.string() + "." + std::to_string(i) + ext;
+            const std::filesystem::path src = (i == 1) ? path : std::filesystem::path{ stem.string() + "." + std::to_string(i - 1) + ext };
+            std::filesystem::remove(dst, ec);
+            std::filesystem::rename(src, dst, ec);
+        }
+
+        state.m_File.open(state.m_FilePath, std::ios::out | std::ios::trunc);
+        state.m_FileBytes = 0;
+    }
+
+    void WriteLine(LogState& state, const FormattedLine& line, bool bToConsole)
+    {
+        if (bToConsole)
+        {
+            WriteConsole(line.m_Level, line.m_Text.c_str());
+        }
+
+        if (state.m_File.is_open())
+        {
+            char prefix[48];
+            const double seconds = (double)(line.m_Timestamp - state.m_TicksAtStart) * 1e-9;
+            const int prefixLen = std::snprintf(prefix, sizeof(prefix), "[%10.4f][T%02u][%c] ", seconds, line.m_ThreadIndex, LevelChar(line.m_Level));
+
+            state.m_File.write(prefix, prefixLen);
+            state.m_File.write(line.m_Text.data(), (std::streamsize)line.m_Text.size());
+            state.m_File.put('\n');
+            state.m_FileBytes += prefixLen + line.m_Text.size() + 1;
+
+            if (state.m_FileBytes >= Log::kMaxLogFileBytes)
+            {
+                RotateLogFile(state);
+            }
+        }
+    }
+
+    std::string FormatRecord(const RecordHeader& header, const uint8_t* payload)
+    {
+        char stackBuffer[512];
+        const int len = header.m_FormatFn(stackBuffer, sizeof(stackBuffer), header.m_Format, payload);
+        if (len < 0)
+            return std::string{ "[Log] format error: " } + header.m_Format;
+        if (len < (int)sizeof(stackBuffer))
+            return std::string(stackBuffer, len);
+
+        std::string text(len, '\0');
+        header.m_FormatFn(text.data(), text.size() + 1, header.m_Format, payload);
+        return text;
+    }
+
+    // Drains every ring once.  Returns true if anything was written.
+    bool DrainRings(LogState& state, std::vector<FormattedLine>& batch)
+    {
+        batch.clear();
+
+        std::vector<ThreadRing*> rings;
+        {
+            std::lock_guard<std::mutex> lock(state.m_RingsMutex);
+            rings.reserve(state.m_Rings.size());
+            for (const std::unique_ptr<ThreadRing>& ring : state.m_Rings)
+                rings.push_back(ring.get());
+        }
+
+        for (ThreadRing* ring : rings)
+        {
+            uint32_t tail = ring->m_Tail.load(std::memory_order_relaxed);
+            const uint32_t head = ring->m_Head.load(std::memory_order_acquire);
+
+            while (tail != head)
+            {
+                const uint32_t offset = tail & kRingMask;
+                if (Log::kRingBufferBytes - offset < sizeof(RecordHeader))
+                {
+                    tail += Log::kRingBufferBytes - offset; // too small for a header: implicit wrap
+                    continue;
+                }
+
+                RecordHeader header;
+                memcpy(&header, ring->m_Data + offset, sizeof(RecordHeader));
+                if (header.m_FormatFn)
+                {
+                    FormattedLine& line = batch.emplace_back();
+                    line.m_Timestamp = header.m_Timestamp;
+                    line.m_ThreadIndex = ring->m_ThreadIndex;
+                    line.m_Level = header.m_Level;
+                    line.m_Text = FormatRecord(header, ring->m_Data + offset + sizeof(RecordHeader));
+                }
+                tail += header.m_Size;
+            }
+            ring->m_Tail.store(tail, std::memory_order_release);
+
+            if (const uint32_t dropped = ring->m_Dropped.exchange(0, std::memory_order_relaxed))
+            {
+                FormattedLine& line = batch.emplace_back();
+                line.m_Timestamp = GetTimestamp();
+                line.m_ThreadIndex = ring->m_ThreadIndex;
+                line.m_Level = Log::Level::Warn;
+                line.m_Text = "[Log] ring full, dropped " + std::to_string(dropped) + " message(s)";
+            }
+        }
+
+        // Per-thread order is already correct; a stable sort interleaves threads by time
+        std::stable_sort(batch.begin(), batch.end(), [](const FormattedLine& a, const FormattedLine& b) { return a.m_Timestamp < b.m_Timestamp; });
+
+        for (const FormattedLine& line : batch)
+        {
+            WriteLine(state, line, true);
+        }
+        if (!batch.empty() && state.m_File.is_open())
+        {
+            state.m_File.flush();
+        }
+        return !batch.empty();
+    }
+
+    void SinkLoop()
+    {
+        LogState& state = GetState();
+        std::vector<FormattedLine> batch;
+
+        while (true)
+        {
+            uint64_t flushTarget;
+            bool bStop;
+            {
+                std::unique_lock<std::mutex> lock(state.m_SinkMutex);
+                // Periodic wake-up keeps latency low without producers ever signalling
+                state.m_SinkCV.wait_for(lock, std::chrono::milliseconds(5), [&state]() {
+                    return state.m_bStop || state.m_FlushRequested != state.m_FlushCompleted;
+                });
+                flushTarget = state.m_FlushRequested;
+                bStop = state.m_bStop;
+            }
+
+            DrainRings(state, batch);
+
+            {
+                std::lock_guard<std::mutex> lock(state.m_SinkMutex);
+                state.m_FlushCompleted = flushTarget;
+            }
+            state.m_FlushedCV.notify_all();
+
+            if (bStop)
+                return;
+        }
+    }
+} // namespace
+
+// ─── Log ─────────────────────────────────────────────────────────────────────
+
+void Log::SetConsoleOutput(ConsoleOutputFn outputFn)
+{
+    GetState().m_ConsoleOutput.store(outputFn, std::memory_order_release);
+}
+
+void Log::Initialize(const std::string& filePath)
+{
+    LogState& state = GetState();
+    assert(!state.m_bRunning && "Log::Initialize called twice");
+
+    state.m_FilePath = filePath;
+    state.m_TicksAtStart = GetTimestamp();
+
+    if (!state.m_FilePath.empty())
+    {
+        // Keep the previous run's log as the first rotated file
+        if (std::filesystem::exists(state.m_FilePath))
+        {
+            RotateLogFile(state);
+        }
+        else
+        {
+            state.m_File.open(state.m_FilePath, std::ios::out | std::ios::trunc);
+            state.m_FileBytes = 0;
+        }
+
+        if (!state.m_File.is_open())
+        {
+            LOG_WARN("[Log] Failed to open log file '%s', logging to console only", state.m_FilePath.c_str());
+        }
+    }
+
+    state.m_bStop = false;
+    state.m_SinkThread = std::thread{ SinkLoop };
+    state.m_bRunning.store(true, std::memory_order_release);
+}
+
+void Log::Shutdown()
+{
+    LogState& state = GetState();
+    if (!state.m_bRunning)
+        return;
+
+    // From here on new records fall back to synchronous output.  Records that
+    // passed the check before it are waited for, so the sink's final drain picks
+    // up every record that went to a ring.
+    state.m_bRunning.store(false, std::memory_order_seq_cst);
+    {
+        std::lock_guard<std::mutex> lock(state.m_RingsMutex);
+        for (const std::unique_ptr<ThreadRing>& ring : state.m_Rings)
+        {
+            while (ring->m_bWriting.load(std::memory_order_seq_cst))
+                std::this_thread::yield();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state.m_SinkMutex);
+        state.m_bStop = true;
+    }
+    state.m_SinkCV.notify_all();
+    state.m_SinkThread.join();
+
+    state.m_File.close();
+}
+
+void Log::Flush()
+{
+    LogState& state = GetState();
+    if (!state.m_bRunning)
+        return;
+
+    std::unique_lock<std::mutex> lock(state.m_SinkMutex);
+    const uint64_t ticket = ++state.m_FlushRequested;
+    state.m_SinkCV.notify_all();
+    state.m_FlushedCV.wait(lock, [&state, ticket]() { return state.m_FlushCompleted >= ticket || state.m_bStop; });
+}
+
+int Log::Printf(Level level, const char* format, ...)
+{
+    // Leave room for the record header and the string length in the ring
+    char text[kMaxRecordBytes - 128];
+
+    va_list args;
+    va_start(args, format);
+    const int length = std::vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    if (length >= 0)
+        Write(level, "%s", (const char*)text);
+    return length;
+}
+
+uint8_t* Log::BeginRecord(Level level, const char* format, FormatFn formatFn, uint32_t payloadSize)
+{
+    assert(format && formatFn);
+
+    const bool bTooLarge = sizeof(RecordHeader) + payloadSize > kMaxRecordBytes;
+
+    if (!GetState().m_bRunning.load(std::memory_order_acquire))
+        return BeginFallbackRecord(level, format, formatFn, payloadSize);
+
+    ThreadRing* ring = GetThreadRing();
+
+    // Announce the write before re-checking, so that Shutdown either sees it and
+    // waits for the commit, or has already stopped the logger and this record
+    // takes the synchronous path
+    ring->m_bWriting.store(true, std::memory_order_seq_cst);
+    if (!GetState().m_bRunning.load(std::memory_order_seq_cst))
+    {
+        ring->m_bWriting.store(false, std::memory_order_relaxed);
+        return BeginFallbackRecord(level, format, formatFn, payloadSize);
+    }
+
+    if (bTooLarge)
+    {
+        ring->m_Dropped.fetch_add(1, std::memory_order_relaxed);
+        ring->m_bWriting.store(false, std::memory_order_release);
+        return nullptr;
+    }
+
+    const uint32_t recordSize = (uint32_t)((sizeof(RecordHeader) + payloadSize + 7) & ~7u);
+    const uint32_t head = ring->m_Head.load(std::memory_order_relaxed);
+    const uint32_t tail = ring->m_Tail.load(std::memory_order_acquire);
+
+    // Records never straddle the end of the ring; skip the remainder if needed
+    const uint32_t offset = head & kRingMask;
+    const uint32_t contiguous = kRingBufferBytes - offset;
+    const uint32_t skip = (contiguous < recordSize) ? contiguous : 0;
+
+    if ((head - tail) + skip + recordSize > kRingBufferBytes)
+    {
+        ring->m_Dropped.fetch_add(1, std::memory_order_relaxed);
+        ring->m_bWriting.store(false, std::memory_order_release);
+        return nullptr;
+    }
+
+    if (skip >= sizeof(RecordHeader))
+    {
+        RecordHeader marker;
+        marker.m_Size = skip;
+        memcpy(ring->m_Data + offset, &marker, sizeof(RecordHeader));
+    }
+
+    const uint32_t recordOffset = (head + skip) & kRingMask;
+    const RecordHeader header{ recordSize, level, GetTimestamp(), format, formatFn };
+    memcpy(ring->m_Data + recordOffset, &header, sizeof(RecordHeader));
+
+    ring->m_PendingHead = head + skip + recordSize;
+    return ring->m_Data + recordOffset + sizeof(RecordHeader);
+}
+
+void Log::CommitRecord()
+{
+    if (t_bFallbackPending)
+    {
+        t_bFallbackPending = false;
+        const std::string text = FormatRecord(t_FallbackHeader, t_FallbackPayload);
+        WriteConsole(t_FallbackHeader.m_Level, text.c_str());
+        return;
+    }
+
+    ThreadRing* ring = t_RingOwner.m_Ring;
+    assert(ring);
+    ring->m_Head.store(ring->m_PendingHead, std::memory_order_release);
+    ring->m_bWriting.store(false, std::memory_order_release);
+}
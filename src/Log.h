@@ -0,0 +1,287 @@
+#pragma once
+
+// ─── Log ─────────────────────────────────────────────────────────────────────
+// Asynchronous logger for hot and multi-threaded code paths.
+//
+// Each producer thread owns a single-producer/single-consumer ring buffer.
+// LOG_*() copies the format pointer, a type-erased formatter and the raw
+// argument values into the calling thread's ring — no lock, no formatting,
+// no I/O.  A background sink thread drains all rings, formats the records
+// with snprintf, orders them by timestamp and writes them to the console
+// output and to a size-rotated log file.
+//
+// Rules:
+//   - The format string must be a string literal (only the pointer is stored).
+//   - LOG_*() formats and arguments are checked like printf at compile time,
+//     so pass std::string as c_str().  String arguments are copied into the
+//     ring, so temporaries are fine.
+//   - When a ring is full the record is dropped and counted; producers never
+//     block.  Dropped counts are reported by the sink.
+//   - Before Log::Initialize() (and after Log::Shutdown()) records are
+//     formatted and written synchronously to the console output.
+//
+// The logger only depends on the standard library so that it can be part of
+// HobbyRendererCore.  The console output defaults to stderr; the renderer
+// routes it through SDL_LogMessage with SetConsoleOutput().
+//
+// LOG_COMPILE_LEVEL strips lower levels at compile time.  LOG_*_RATE_LIMITED
+// emits at most one message per interval per call site and reports how many
+// were suppressed.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#define LOG_LEVEL_VERBOSE 0
+#define LOG_LEVEL_INFO    1
+#define LOG_LEVEL_WARN    2
+#define LOG_LEVEL_ERROR   3
+
+#ifndef LOG_COMPILE_LEVEL
+    #define LOG_COMPILE_LEVEL LOG_LEVEL_INFO
+#endif
+
+// printf format checking, as SDL_PRINTF_FORMAT_STRING / SDL_PRINTF_VARARG_FUNC
+#if defined(_MSC_VER) && defined(_USE_ATTRIBUTES_FOR_SAL) && _USE_ATTRIBUTES_FOR_SAL
+    #include <sal.h>
+    #define LOG_PRINTF_FORMAT_STRING _Printf_format_string_
+#else
+    #define LOG_PRINTF_FORMAT_STRING
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+    #define LOG_PRINTF_VARARG_FUNC(fmtargnumber) __attribute__((format(printf, fmtargnumber, fmtargnumber + 1)))
+#else
+    #define LOG_PRINTF_VARARG_FUNC(fmtargnumber)
+#endif
+
+class Log
+{
+public:
+    enum class Level : uint8_t
+    {
+        Verbose = LOG_LEVEL_VERBOSE,
+        Info    = LOG_LEVEL_INFO,
+        Warn    = LOG_LEVEL_WARN,
+        Error   = LOG_LEVEL_ERROR,
+    };
+
+    // Per-thread ring size.  Must be a power of two.
+    static constexpr uint32_t kRingBufferBytes = 64 * 1024;
+    // Largest single record; bigger payloads are truncated to an error marker.
+    static constexpr uint32_t kMaxRecordBytes  = 4 * 1024;
+    // Rotate the log file once it grows past this size.
+    static constexpr uint64_t kMaxLogFileBytes = 16ull * 1024 * 1024;
+    static constexpr uint32_t kMaxRotatedFiles = 3;
+
+    // Writes one formatted line to the console.  Called from the sink thread, or
+    // from the logging thread itself while the logger is not running.
+    using ConsoleOutputFn = void (*)(Level level, const char* text);
+
+    // Replaces the default stderr console output.  Set it before Initialize().
+    static void SetConsoleOutput(ConsoleOutputFn outputFn);
+
+    // Starts the sink thread.  Empty filePath logs to the console only.
+    static void Initialize(const std::string& filePath = {});
+    // Drains everything and stops the sink thread.
+    static void Shutdown();
+    // Blocks until every record submitted before the call has been written.
+    static void Flush();
+
+    template <typename... Args>
+    static void Write(Level level, const char* format, const Args&... args);
+
+    // printf-style front end.  Formats on the calling thread and queues the
+    // result, so the format does not have to be a literal.  The LOG_*() macros
+    // also name it in an unevaluated operand to get the compiler's format
+    // checks.  Returns the formatted length, as snprintf.
+    static int Printf(Level level, LOG_PRINTF_FORMAT_STRING const char* format, ...) LOG_PRINTF_VARARG_FUNC(2);
+
+    // ─── Internals used by the templates below ───────────────────────────────
+    using FormatFn = int (*)(char* out, size_t outSize, const char* format, const uint8_t* payload);
+
+    // Reserves payloadSize bytes in the calling thread's ring.  Returns nullptr
+    // when the record must be dropped.
+    static uint8_t* BeginRecord(Level level, const char* format, FormatFn formatFn, uint32_t payloadSize);
+    static void     CommitRecord();
+};
+
+// ─── Argument encoding ───────────────────────────────────────────────────────
+
+namespace LogInternal
+{
+    struct StringArg
+    {
+        const char* m_Str    = nullptr;
+        uint32_t    m_Length = 0;
+    };
+
+    template <typename T>
+    auto ToStored(const T& value)
+    {
+        using D = std::decay_t<T>;
+        if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>)
+        {
+            const char* s = value; // decays string literals before the null check
+            if (!s)
+                s = "(null)";
+            return StringArg{ s, (uint32_t)std::strlen(s) };
+        }
+        else if constexpr (std::is_enum_v<D>)
+        {
+            return static_cast<std::underlying_type_t<D>>(value);
+        }
+        else if constexpr (std::is_floating_point_v<D>)
+        {
+            return static_cast<double>(value); // printf promotes float anyway
+        }
+        else if constexpr (std::is_integral_v<D>)
+        {
+            return value;
+        }
+        else if constexpr (std::is_pointer_v<D>)
+        {
+            return static_cast<const void*>(value);
+        }
+        else
+        {
+            static_assert(sizeof(D) == 0, "Unsupported log argument type");
+        }
+    }
+
+    template <typename T>
+    using StoredType = decltype(ToStored(std::declval<const T&>()));
+
+    template <typename S>
+    uint32_t EncodedSize(const S&) { return sizeof(S); }
+    inline uint32_t EncodedSize(const StringArg& s) { return sizeof(uint32_t) + s.m_Length + 1; }
+
+    template <typename S>
+    void Encode(uint8_t*& dst, const S& value)
+    {
+        memcpy(dst, &value, sizeof(S));
+        dst += sizeof(S);
+    }
+
+    inline void Encode(uint8_t*& dst, const StringArg& s)
+    {
+        memcpy(dst, &s.m_Length, sizeof(uint32_t));
+        dst += sizeof(uint32_t);
+        memcpy(dst, s.m_Str, s.m_Length);
+        dst[s.m_Length] = '\0';
+        dst += s.m_Length + 1;
+    }
+
+    template <typename S>
+    auto Decode(const uint8_t*& src)
+    {
+        if constexpr (std::is_same_v<S, StringArg>)
+        {
+            uint32_t length;
+            memcpy(&length, src, sizeof(uint32_t));
+            const char* str = reinterpret_cast<const char*>(src + sizeof(uint32_t));
+            src += sizeof(uint32_t) + length + 1;
+            return str;
+        }
+        else
+        {
+            S value;
+            memcpy(&value, src, sizeof(S));
+            src += sizeof(S);
+            return value;
+        }
+    }
+
+    template <typename... Stored>
+    int FormatPayload(char* out, size_t outSize, const char* format, const uint8_t* payload)
+    {
+        // Braced initialization evaluates left-to-right, matching the encode order
+        const std::tuple<decltype(Decode<Stored>(payload))...> args{ Decode<Stored>(payload)... };
+        return std::apply([&](auto... a) { return std::snprintf(out, outSize, format, a...); }, args);
+    }
+
+    // Per-call-site limiter used by LOG_*_RATE_LIMITED.
+    struct RateLimiter
+    {
+        std::atomic<uint64_t> m_NextAllowedTicks{ 0 };
+        std::atomic<uint32_t> m_Suppressed{ 0 };
+
+        bool ShouldLog(uint32_t intervalMs, uint32_t& outSuppressed)
+        {
+            const uint64_t now  = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            uint64_t allowed    = m_NextAllowedTicks.load(std::memory_order_relaxed);
+            if (now < allowed || !m_NextAllowedTicks.compare_exchange_strong(allowed, now + intervalMs, std::memory_order_relaxed))
+            {
+                m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            outSuppressed = m_Suppressed.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+    };
+} // namespace LogInternal
+
+template <typename... Args>
+void Log::Write(Level level, const char* format, const Args&... args)
+{
+    constexpr FormatFn formatFn = &LogInternal::FormatPayload<LogInternal::StoredType<Args>...>;
+
+    const uint32_t payloadSize = (0u + ... + LogInternal::EncodedSize(LogInternal::ToStored(args)));
+
+    uint8_t* dst = BeginRecord(level, format, formatFn, payloadSize);
+    if (!dst)
+        return;
+
+    (LogInternal::Encode(dst, LogInternal::ToStored(args)), ...);
+    CommitRecord();
+}
+
+// ─── Macros ──────────────────────────────────────────────────────────────────
+
+// Log::Printf is never called here: it only lets the compiler check fmt against the arguments.
+#define LOG_WRITE_INTERNAL(level, fmt, ...) \
+    ((void)sizeof(Log::Printf(level, fmt, ##__VA_ARGS__)), Log::Write(level, fmt, ##__VA_ARGS__))
+
+#define LOG_RATE_LIMITED_INTERNAL(level, intervalMs, fmt, ...) \
+    do { \
+        static LogInternal::RateLimiter s_LogRateLimiter; \
+        uint32_t logSuppressed = 0; \
+        if (s_LogRateLimiter.ShouldLog(intervalMs, logSuppressed)) \
+        { \
+            if (logSuppressed) LOG_WRITE_INTERNAL(level, fmt " (+%u suppressed)", ##__VA_ARGS__, logSuppressed); \
+            else               LOG_WRITE_INTERNAL(level, fmt, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_VERBOSE
+    #define LOG_VERBOSE(fmt, ...)                          LOG_WRITE_INTERNAL(Log::Level::Verbose, fmt, ##__VA_ARGS__)
+    #define LOG_VERBOSE_RATE_LIMITED(intervalMs, fmt, ...) LOG_RATE_LIMITED_INTERNAL(Log::Level::Verbose, intervalMs, fmt, ##__VA_ARGS__)
+#else
+    #define LOG_VERBOSE(fmt, ...)                          do {} while (0)
+    #define LOG_VERBOSE_RATE_LIMITED(intervalMs, fmt, ...) do {} while (0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+    #define LOG_INFO(fmt, ...)                             LOG_WRITE_INTERNAL(Log::Level::Info, fmt, ##__VA_ARGS__)
+    #define LOG_INFO_RATE_LIMITED(intervalMs, fmt, ...)    LOG_RATE_LIMITED_INTERNAL(Log::Level::Info, intervalMs, fmt, ##__VA_ARGS__)
+#else
+    #define LOG_INFO(fmt, ...)                             do {} while (0)
+    #define LOG_INFO_RATE_LIMITED(intervalMs, fmt, ...)    do {} while (0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARN
+    #define LOG_WARN(fmt, ...)                             LOG_WRITE_INTERNAL(Log::Level::Warn, fmt, ##__VA_ARGS__)
+    #define LOG_WARN_RATE_LIMITED(intervalMs, fmt, ...)    LOG_RATE_LIMITED_INTERNAL(Log::Level::Warn, intervalMs, fmt, ##__VA_ARGS__)
+#else
+    #define LOG_WARN(fmt, ...)                             do {} while (0)
+    #define LOG_WARN_RATE_LIMITED(intervalMs, fmt, ...)    do {} while (0)
+#endif
+
+#define LOG_ERROR(fmt, ...)                                LOG_WRITE_INTERNAL(Log::Level::Error, fmt, ##__VA_ARGS__)
+#define LOG_ERROR_RATE_LIMITED(intervalMs, fmt, ...)       LOG_RATE_LIMITED_INTERNAL(Log::Level::Error, intervalMs, fmt, ##__VA_ARGS__)
@@ -0,0 +1,264 @@
+#include "MemoryMappedDataReader.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <string>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// ─── MemoryMappedDataReader ──────────────────────────────────────────────────
+
+MemoryMappedDataReader::MemoryMappedDataReader(std::string_view filePath, AccessHint hint, bool bPopulateIfSmall)
+{
+    const std::string path(filePath);
+
+#ifdef _WIN32
+    // The cache manager uses these to size read-ahead for the (rare) buffered reads
+    // of the file; page faults on the view honour them too.
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (hint == AccessHint::Random)     flags |= FILE_FLAG_RANDOM_ACCESS;
+    if (hint == AccessHint::Sequential) flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+
+    m_File = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                         NULL, OPEN_EXISTING, flags, NULL);
+    if (m_File == INVALID_HANDLE_VALUE)
+    {
+        LOG_ERROR("[MemoryMappedDataReader] CreateFileA failed for %s (Error: %lu)", path.c_str(), (unsigned long)GetLastError());
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_File, &size))
+    {
+        LOG_ERROR("[MemoryMappedDataReader] GetFileSizeEx failed for %s (Error: %lu)", path.c_str(), (unsigned long)GetLastError());
+        return;
+    }
+    m_Size = static_cast<size_t>(size.QuadPart);
+    if (m_Size == 0) return;
+
+    m_Mapping = CreateFileMappingA(m_File, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_Mapping == NULL)
+    {
+        LOG_ERROR("[MemoryMappedDataReader] CreateFileMappingA failed for %s (Error: %lu)", path.c_str(), (unsigned long)GetLastError());
+        return;
+    }
+
+    m_Data = MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_Data == NULL)
+    {
+        LOG_ERROR("[MemoryMappedDataReader] MapViewOfFile failed for %s (Error: %lu)", path.c_str(), (unsigned long)GetLastError());
+        return;
+    }
+
+    if (bPopulateIfSmall && m_Size <= kPopulateMaxBytes)
+        Prefetch(0, m_Size);
+#else
+    m_File = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_File < 0)
+    {
+        LOG_ERROR("[MemoryMappedDataReader] open failed for %s (errno: %d)", path.c_str(), errno);
+        return;
+    }
+
+    struct stat st;
+    if (fstat(m_File, &st) != 0)
+    {
+        LOG_ERROR("[MemoryMappedDataReader] fstat failed for %s (errno: %d)", path.c_str(), errno);
+        return;
+    }
+    m_Size = static_cast<size_t>(st.st_size);
+    if (m_Size == 0) return;
+
+    int mapFlags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (bPopulateIfSmall && m_Size <= kPopulateMaxBytes)
+        mapFlags |= MAP_POPULATE;
+#endif
+
+    void* data = mmap(nullptr, m_Size, PROT_READ, mapFlags, m_File, 0);
+    if (data == MAP_FAILED)
+    {
+        LOG_ERROR("[MemoryMappedDataReader] mmap failed for %s (errno: %d)", path.c_str(), errno);
+        return;
+    }
+    m_Data = data;
+
+    // Match the page cache read-ahead to the mapping's access pattern
+    const int fadvice = hint == AccessHint::Random     ? POSIX_FADV_RANDOM
+                      : hint == AccessHint::Sequential ? POSIX_FADV_SEQUENTIAL
+                      :                                  POSIX_FADV_NORMAL;
+    posix_fadvise(m_File, 0, 0, fadvice);
+
+    // The descriptor stays open for ReadAt()
+    SetAccessHint(hint);
+#endif
+}
+
+MemoryMappedDataReader::MemoryMappedDataReader(void* data, size_t size, void (*deleter)(void*))
+    : m_Data(data), m_Size(size), m_Deleter(deleter)
+{
+}
+
+MemoryMappedDataReader::~MemoryMappedDataReader()
+{
+    if (m_Deleter)
+    {
+        if (m_Data) m_Deleter(m_Data);
+    }
+    else
+    {
+#ifdef _WIN32
+        if (m_Data)    UnmapViewOfFile(m_Data);
+        if (m_Mapping) CloseHandle(m_Mapping);
+        if (m_File != INVALID_HANDLE_VALUE) CloseHandle(m_File);
+#else
+        if (m_Data)    munmap(m_Data, m_Size);
+        if (m_File >= 0) close(m_File);
+#endif
+    }
+}
+
+bool MemoryMappedDataReader::GetPageRange(size_t offset, size_t size, uint8_t*& outBegin, size_t& outSize) const
+{
+    // Hints only apply to file mappings
+    if (m_Deleter || !m_Data)
+        return false;
+
+    const size_t begin = std::min(m_Offset + offset, m_Size);
+    const size_t end   = std::min(begin + std::min(size, m_Size - begin), m_Size);
+    if (begin >= end)
+        return false;
+
+    // madvise/PrefetchVirtualMemory operate on whole pages.  The mapping itself
+    // starts on a page (allocation granularity) boundary.
+    static const size_t s_PageSize = []
+    {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return (size_t)info.dwPageSize;
+#else
+        return (size_t)sysconf(_SC_PAGESIZE);
+#endif
+    }();
+
+    const size_t alignedBegin = begin & ~(s_PageSize - 1);
+    const size_t alignedEnd   = std::min((end + s_PageSize - 1) & ~(s_PageSize - 1), m_Size);
+
+    outBegin = static_cast<uint8_t*>(m_Data) + alignedBegin;
+    outSize  = alignedEnd - alignedBegin;
+    return true;
+}
+
+void MemoryMappedDataReader::SetAccessHint(AccessHint hint) const
+{
+    if (m_Deleter || !m_Data)
+        return;
+
+#ifdef _WIN32
+    // No per-view read-ahead control on Windows; the file flags set at open time apply.
+    (void)hint;
+#else
+    const int advice = hint == AccessHint::Random     ? MADV_RANDOM
+                     : hint == AccessHint::Sequential ? MADV_SEQUENTIAL
+                     :                                  MADV_NORMAL;
+    madvise(m_Data, m_Size, advice);
+#endif
+}
+
+void MemoryMappedDataReader::Prefetch(size_t offset, size_t size) const
+{
+    uint8_t* begin;
+    size_t   bytes;
+    if (!GetPageRange(offset, size, begin, bytes))
+        return;
+
+#ifdef _WIN32
+    WIN32_MEMORY_RANGE_ENTRY range{ begin, bytes };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    madvise(begin, bytes, MADV_WILLNEED);
+#endif
+}
+
+void MemoryMappedDataReader::Evict(size_t offset, size_t size) const
+{
+    uint8_t* begin;
+    size_t   bytes;
+    if (!GetPageRange(offset, size, begin, bytes))
+        return;
+
+#ifdef _WIN32
+    // Pages that are not locked are removed from the working set; they stay in
+    // the standby list, so a later fault is a soft fault rather than a disk read.
+    VirtualUnlock(begin, bytes);
+#else
+    // Read-only private file mapping: the pages are clean, so dropping them is
+    // always safe and the next access re-reads from the page cache / disk.
+    madvise(begin, bytes, MADV_DONTNEED);
+#endif
+}
+
+size_t MemoryMappedDataReader::ReadAt(size_t offset, void* dst, size_t size) const
+{
+    if (m_Deleter || !m_Data)
+        return 0;
+
+    const size_t begin = std::min(m_Offset + offset, m_Size);
+    size = std::min(size, m_Size - begin);
+
+    uint8_t* out  = static_cast<uint8_t*>(dst);
+    size_t   done = 0;
+    while (done < size)
+    {
+#ifdef _WIN32
+        // OVERLAPPED carries the offset, so concurrent readers never race on the file pointer
+        OVERLAPPED overlapped{};
+        const uint64_t fileOffset = begin + done;
+        overlapped.Offset     = (DWORD)(fileOffset & 0xFFFFFFFFull);
+        overlapped.OffsetHigh = (DWORD)(fileOffset >> 32);
+
+        const DWORD toRead = (DWORD)std::min<size_t>(size - done, 1u << 30);
+        DWORD bytesRead = 0;
+        if (!ReadFile(m_File, out + done, toRead, &bytesRead, &overlapped) || bytesRead == 0)
+            break;
+#else
+        const ssize_t bytesRead = pread(m_File, out + done, size - done, (off_t)(begin + done));
+        if (bytesRead < 0 && errno == EINTR)
+            continue;
+        if (bytesRead <= 0)
+            break;
+#endif
+        done += (size_t)bytesRead;
+    }
+    return done;
+}
+
+bool MemoryMappedDataReader::DropCachedPages() const
+{
+    if (m_Deleter || !m_Data)
+        return false;
+
+#ifdef _WIN32
+    // The standby list can only be purged with SeProfileSingleProcessPrivilege
+    return false;
+#else
+    // Pages still mapped (here or elsewhere) stay; drop this mapping's first
+    madvise(m_Data, m_Size, MADV_DONTNEED);
+    return posix_fadvise(m_File, 0, 0, POSIX_FADV_DONTNEED) == 0;
+#endif
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// ─── MemoryMappedDataReader ──────────────────────────────────────────────────
+// Maps a file read-only using the OS virtual memory system (MapViewOfFile on
+// Windows, mmap elsewhere). Only the pages that are actually accessed are
+// loaded from disk, so callers pay only for what they touch — ideal for
+// reading a small slice out of a large binary file.
+//
+// Page-cache control for streaming sources:
+//   - AccessHint tells the kernel how the mapping will be read (MADV_RANDOM
+//     disables read-ahead for scattered tile reads).
+//   - Prefetch() starts asynchronous read-in of a range (MADV_WILLNEED /
+//     PrefetchVirtualMemory); Evict() drops a range from the resident set
+//     (MADV_DONTNEED / VirtualUnlock).  Both are hints and never fail.
+//   - bPopulateIfSmall pre-faults files up to kPopulateMaxBytes at map time
+//     (MAP_POPULATE), trading one bulk read for many page faults.
+//   - ReadAt() bypasses the mapping with a positional read (pread / ReadFile)
+//     of the same file, for callers that batch their own I/O.
+//
+// An alternative owned-data constructor lets callers wrap heap-allocated
+// buffers (e.g. stbi-decoded pixels) through the same interface; hints are
+// no-ops in that mode.
+class MemoryMappedDataReader
+{
+public:
+    enum class AccessHint : uint8_t
+    {
+        Normal,
+        Sequential,
+        Random,
+    };
+
+    static constexpr size_t kPopulateMaxBytes = 4 * 1024 * 1024;
+
+    // Maps filePath read-only.  Check IsValid() before use.
+    explicit MemoryMappedDataReader(std::string_view filePath, AccessHint hint = AccessHint::Normal, bool bPopulateIfSmall = false);
+
+    // Takes ownership of externally-allocated data.
+    // deleter(ptr) is called in the destructor to release the allocation.
+    MemoryMappedDataReader(void* data, size_t size, void (*deleter)(void*) = nullptr);
+
+    ~MemoryMappedDataReader();
+
+    MemoryMappedDataReader(const MemoryMappedDataReader&) = delete;
+    MemoryMappedDataReader& operator=(const MemoryMappedDataReader&) = delete;
+
+    bool        IsValid()  const { return m_Data != nullptr; }
+    // Returns a pointer at the current offset (see SetOffset).
+    const void* GetData()  const { return static_cast<const uint8_t*>(m_Data) + m_Offset; }
+    // Returns the number of bytes from the current offset to the end of the mapping.
+    size_t      GetSize()  const { return m_Size - m_Offset; }
+    // Skip the first `offset` bytes of the mapped region (e.g. to skip a header).
+    void        SetOffset(size_t offset) { m_Offset = offset; }
+
+    // Ranges below are relative to the current offset and clamped to the mapping.
+    void SetAccessHint(AccessHint hint) const;
+    void Prefetch(size_t offset, size_t size) const;
+    void Evict(size_t offset, size_t size) const;
+
+    // Thread-safe positional read of [offset, offset+size) (relative to the current
+    // offset) into dst.  Returns the number of bytes read; 0 in owned-data mode.
+    size_t ReadAt(size_t offset, void* dst, size_t size) const;
+
+    // Drops the file's clean pages from the OS page cache, so the next access reads
+    // from storage (cold-cache benchmarks).  Returns false where the platform has no
+    // unprivileged way to do it (Windows) and in owned-data mode.
+    bool DropCachedPages() const;
+
+private:
+    // Expands [offset, offset+size) (relative to m_Offset) to whole pages of the mapping.
+    bool GetPageRange(size_t offset, size_t size, uint8_t*& outBegin, size_t& outSize) const;
+
+    void*  m_Data    = nullptr;
+    size_t m_Size    = 0;
+    size_t m_Offset  = 0;
+    void (*m_Deleter)(void*) = nullptr; // non-null for owned-data mode
+#ifdef _WIN32
+    // HANDLEs, kept as void* so that this header does not need windows.h
+    void*  m_File    = reinterpret_cast<void*>(static_cast<intptr_t>(-1)); // INVALID_HANDLE_VALUE
+    void*  m_Mapping = nullptr;
+#else
+    int    m_File    = -1;
+#endif
+};
@@ -0,0 +1,41 @@
+#include "ProcessMemory.h"
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <cstdio>
+    #include <unistd.h>
+#endif
+
+size_t GetProcessResidentBytes()
+{
+#ifdef _WIN32
+    // K32GetProcessMemoryInfo (PSAPI_VERSION 2) lives in kernel32: no psapi.lib needed
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.WorkingSetSize;
+#elif defined(__linux__)
+    // "size resident shared text lib data dt", in pages
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file)
+        return 0;
+
+    unsigned long long totalPages = 0;
+    unsigned long long residentPages = 0;
+    const int numRead = std::fscanf(file, "%llu %llu", &totalPages, &residentPages);
+    std::fclose(file);
+    if (numRead != 2)
+        return 0;
+    return (size_t)residentPages * (size_t)sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+// ─── ProcessMemory ───────────────────────────────────────────────────────────
+// Resident set size of the current process: the bytes of its address space in
+// physical memory (working set on Windows, /proc/self/statm elsewhere).  Used to
+// check that memory released after load actually goes back to the OS.
+//
+// Returns 0 where the platform has no cheap way to read it.
+// ─────────────────────────────────────────────────────────────────────────────
+
+size_t GetProcessResidentBytes();
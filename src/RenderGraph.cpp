@@ -125,6 +125,7 @@ void RenderGraph::Shutdown()
     m_Heaps.clear();
     m_PassNames.clear();
     m_PassAccesses.clear();
+    m_PassAccessPool.clear();
     m_PassNeedsGlobalSyncBarrier.clear();
     m_DeferredReleaseTextures.clear();
     m_DeferredReleaseBuffers.clear();
@@ -156,13 +157,13 @@ void RenderGraph::Reset()
     m_IsInsideSetup = false; // safety: ensure setup state is clean at frame start
     m_Stats = Stats{};
     m_PassNames.clear();
-    m_PassAccesses.clear();
+    RecyclePassAccesses();
     m_PassNeedsGlobalSyncBarrier.clear();
     // was interrupted (e.g. a renderer's Setup() threw or returned early after
     // declaring resources).  BeginSetup() also clears these, but Reset() is the
     // authoritative frame-start reset and must leave the graph in a fully clean
     // state regardless of what happened last frame.
-    m_PendingPassAccess = {};
+    m_PendingPassAccess.Clear();
     m_PendingDeclaredTextures.clear();
     m_PendingDeclaredBuffers.clear();
 
@@ -241,6 +242,16 @@ void RenderGraph::Reset()
     }
 }
 
+void RenderGraph::RecyclePassAccesses()
+{
+    for (PassAccess& access : m_PassAccesses)
+    {
+        access.Clear();
+        m_PassAccessPool.push_back(std::move(access));
+    }
+    m_PassAccesses.clear();
+}
+
 void RenderGraph::BeginPass(const char* name)
 {
     PROFILE_FUNCTION();
@@ -248,7 +259,18 @@ void RenderGraph::BeginPass(const char* name)
     SDL_assert(name);
     m_CurrentPassIndex++;
     m_PassNames.push_back(name);
-    m_PassAccesses.push_back(m_PendingPassAccess); // Copy pending accesses from Setup
+
+    // Move pending accesses from Setup into the pass list; the pending slot takes
+    // over a recycled (cleared) PassAccess so no index set has to reallocate.
+    PassAccess recycled;
+    if (!m_PassAccessPool.empty())
+    {
+        recycled = std::move(m_PassAccessPool.back());
+        m_PassAccessPool.pop_back();
+    }
+    m_PassAccesses.push_back(std::move(m_PendingPassAccess));
+    m_PendingPassAccess = std::move(recycled);
+    const PassAccess& passAccess = m_PassAccesses.back();
     
     // Update resources declared in Setup with the correct pass index
     for (uint32_t texIdx : m_PendingDeclaredTextures)
@@ -263,12 +285,11 @@ void RenderGraph::BeginPass(const char* name)
     }
     
     // Also update any read/write resources that were just registered in Setup
-    for (uint32_t texIdx : m_PendingPassAccess.m_ReadTextures) UpdateResourceLifetime(m_Textures[texIdx].m_Lifetime, m_CurrentPassIndex);
-    for (uint32_t texIdx : m_PendingPassAccess.m_WriteTextures) UpdateResourceLifetime(m_Textures[texIdx].m_Lifetime, m_CurrentPassIndex);
-    for (uint32_t bufIdx : m_PendingPassAccess.m_ReadBuffers) UpdateResourceLifetime(m_Buffers[bufIdx].m_Lifetime, m_CurrentPassIndex);
-    for (uint32_t bufIdx : m_PendingPassAccess.m_WriteBuffers) UpdateResourceLifetime(m_Buffers[bufIdx].m_Lifetime, m_CurrentPassIndex);
+    for (uint32_t texIdx : passAccess.m_ReadTextures) UpdateResourceLifetime(m_Textures[texIdx].m_Lifetime, m_CurrentPassIndex);
+    for (uint32_t texIdx : passAccess.m_WriteTextures) UpdateResourceLifetime(m_Textures[texIdx].m_Lifetime, m_CurrentPassIndex);
+    for (uint32_t bufIdx : passAccess.m_ReadBuffers) UpdateResourceLifetime(m_Buffers[bufIdx].m_Lifetime, m_CurrentPassIndex);
+    for (uint32_t bufIdx : passAccess.m_WriteBuffers) UpdateResourceLifetime(m_Buffers[bufIdx].m_Lifetime, m_CurrentPassIndex);
 
-    m_PendingPassAccess = {};
     m_PendingDeclaredTextures.clear();
     m_PendingDeclaredBuffers.clear();
 }
@@ -314,7 +335,7 @@ void RenderGraph::ScheduleRenderer(IRenderer* pRenderer)
         }
         m_PendingDeclaredTextures.clear();
         m_PendingDeclaredBuffers.clear();
-        m_PendingPassAccess = {};
+        m_PendingPassAccess.Clear();
         pRenderer->m_CPUTime = 0.0f;
         pRenderer->m_GPUTime = 0.0f;
         return;
@@ -384,7 +405,7 @@ void RenderGraph::BeginSetup()
     }
 
     m_IsInsideSetup = true;
-    m_PendingPassAccess = {};
+    m_PendingPassAccess.Clear();
     m_PendingDeclaredTextures.clear();
     m_PendingDeclaredBuffers.clear();
 }
@@ -417,7 +438,7 @@ void RenderGraph::EndSetup()
     }
     m_PendingDeclaredTextures.clear();
     m_PendingDeclaredBuffers.clear();
-    m_PendingPassAccess = {};
+    m_PendingPassAccess.Clear();
     m_IsInsideSetup = false;
 }
 
@@ -256,15 +256,45 @@ private:
 private:
     uint16_t GetActivePassIndex() const;
 
+    // Flat set of resource indices.  A pass touches a handful of resources, so a
+    // linear scan beats hashing, and clear() keeps the capacity for next frame.
+    class ResourceIndexSet
+    {
+    public:
+        void insert(uint32_t index) { if (!count(index)) m_Indices.push_back(index); }
+        size_t count(uint32_t index) const { return std::find(m_Indices.begin(), m_Indices.end(), index) != m_Indices.end() ? 1 : 0; }
+        size_t size() const { return m_Indices.size(); }
+        bool empty() const { return m_Indices.empty(); }
+        void clear() { m_Indices.clear(); }
+        std::vector<uint32_t>::const_iterator begin() const { return m_Indices.begin(); }
+        std::vector<uint32_t>::const_iterator end() const { return m_Indices.end(); }
+
+    private:
+        std::vector<uint32_t> m_Indices;
+    };
+
     struct PassAccess
     {
-        std::unordered_set<uint32_t> m_ReadTextures;
-        std::unordered_set<uint32_t> m_WriteTextures;
-        std::unordered_set<uint32_t> m_ReadBuffers;
-        std::unordered_set<uint32_t> m_WriteBuffers;
+        ResourceIndexSet m_ReadTextures;
+        ResourceIndexSet m_WriteTextures;
+        ResourceIndexSet m_ReadBuffers;
+        ResourceIndexSet m_WriteBuffers;
+
+        void Clear()
+        {
+            m_ReadTextures.clear();
+            m_WriteTextures.clear();
+            m_ReadBuffers.clear();
+            m_WriteBuffers.clear();
+        }
     };
     std::vector<PassAccess> m_PassAccesses;
 
+    // Cleared PassAccess objects from previous frames, recycled by BeginPass()
+    // so the per-pass index sets keep their storage across frames.
+    std::vector<PassAccess> m_PassAccessPool;
+    void RecyclePassAccesses();
+
     std::vector<RenderGraphInternal::TransientTexture> m_Textures;
     std::vector<RenderGraphInternal::TransientBuffer> m_Buffers;
     std::vector<const char*> m_PassNames;
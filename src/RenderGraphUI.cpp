@@ -372,7 +372,7 @@ void RenderGraph::RenderDebugUI()
                         {
                             if (ImGui::TreeNodeEx("Resource Accesses", ImGuiTreeNodeFlags_DefaultOpen))
                             {
-                                auto listAccesses = [&](const std::unordered_set<uint32_t>& indices, bool isBuffer, const char* mode, ImVec4 color) {
+                                auto listAccesses = [&](const ResourceIndexSet& indices, bool isBuffer, const char* mode, ImVec4 color) {
                                     if (indices.empty()) return;
                                     ImGui::TextColored(color, "%s %s:", mode, isBuffer ? "Buffers" : "Textures");
                                     for (uint32_t idx : indices) {
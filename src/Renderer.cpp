@@ -1,15 +1,15 @@
 #include "Renderer.h"
 #include "Utilities.h"
+#include "Log.h"
 #include "Config.h"
 #include "CommonResources.h"
 #include "SceneLoader.h"
+#include "CPURayQuery.h"
 #include "Streaming/FeedbackTexture.h"
+#include "meshoptimizer.h"
 
 #include <ShaderMake/ShaderBlob.h>
 
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include "../external/microprofile/stb/stb_image_write.h"
-
 #define FFX_CPU
 #define FFX_STATIC static
 using FfxUInt32 = uint32_t;
@@ -215,61 +215,6 @@ nvrhi::TextureHandle Renderer::GetCurrentBackBufferTexture() const
     return m_RHI->m_NvrhiSwapchainTextures[m_SwapChainImageIdx];
 }
 
-void Renderer::SaveBackBufferScreenshot()
-{
-    PROFILE_FUNCTION();
-    
-    // Get the backbuffer texture
-    nvrhi::TextureHandle backbuffer = GetCurrentBackBufferTexture();
-
-    // Get backbuffer dimensions
-    const nvrhi::TextureDesc& bbDesc = backbuffer->getDesc();
-    uint32_t width = bbDesc.width;
-    uint32_t height = bbDesc.height;
-    nvrhi::Format format = bbDesc.format;
-
-    SDL_assert(width > 0 && height > 0 && "Backbuffer has invalid dimensions");
-    SDL_assert(format != nvrhi::Format::UNKNOWN && "Backbuffer has unknown format");
-
-    // Create a staging texture for readback  
-    nvrhi::TextureDesc stagingDesc;
-    stagingDesc.width = width;
-    stagingDesc.height = height;
-    stagingDesc.format = format;
-    stagingDesc.debugName = "Screenshot Staging Texture";
-
-    nvrhi::StagingTextureHandle stagingTexture = m_RHI->m_NvrhiDevice->createStagingTexture(stagingDesc, nvrhi::CpuAccessMode::Read);
-
-    // Acquire a command list for the copy operation
-    nvrhi::CommandListHandle cmdList = AcquireCommandList();
-
-    {
-        // Copy from backbuffer to staging texture
-        ScopedCommandList scoped(cmdList, "Screenshot Copy");
-        cmdList->copyTexture(stagingTexture, nvrhi::TextureSlice{}, backbuffer, nvrhi::TextureSlice{});
-    }
-
-    // Execute the command list immediately - this will synchronize
-    ExecutePendingCommandLists();
-
-    // Map the staging texture and read the data
-    size_t rowPitch = 0;
-    void* mappedData = m_RHI->m_NvrhiDevice->mapStagingTexture(stagingTexture, nvrhi::TextureSlice{}, nvrhi::CpuAccessMode::Read, &rowPitch);
-    SDL_assert(mappedData && "Failed to map staging texture for screenshot");
-
-    // Get the base path where to save the screenshot
-    const char* basePath = SDL_GetBasePath();
-    std::string screenshotPath{ basePath };
-    screenshotPath += "screenshot.jpg";
-
-    // Write the image as JPEG
-    int writeResult = stbi_write_jpg(screenshotPath.c_str(), (int)width, (int)height, 4, mappedData, 0);
-    SDL_assert(writeResult && "Failed to write screenshot using stb_image_write");
-
-    // Unmap the staging texture
-    m_RHI->m_NvrhiDevice->unmapStagingTexture(stagingTexture);
-}
-
 // ----------------------------------------------------------------------------
 // InitializeGPUStack � shared helper called by Initialize().
 // Assumes m_Window is already set.
@@ -361,6 +306,8 @@ bool Renderer::InitializeGPUStack(SDL_Window* window)
 
 void Renderer::Initialize()
 {
+    Log::Initialize(std::string{ SDL_GetBasePath() } + "HobbyRenderer.log");
+
     ScopedTimerLog initScope{"[Timing] Init phase:"};
 
     MicroProfileOnThreadCreate("Main");
@@ -376,6 +323,7 @@ void Renderer::Initialize()
     m_Window = CreateWindowScaled();
     if (!m_Window)
     {
+        Log::Shutdown();
         SDL_Quit();
         return;
     }
@@ -388,6 +336,12 @@ void Renderer::Initialize()
 
     m_CameraStateManager.Initialize();
 
+    m_FrameCapture.Initialize(m_RHI->m_NvrhiDevice);
+    if (!Config::Get().m_CaptureSequenceDirectory.empty())
+    {
+        m_FrameCapture.StartSequence(Config::Get().m_CaptureSequenceDirectory, Config::Get().m_CaptureSequenceFrameCount);
+    }
+
     // When entering NormalBasic, disable all RT-dependent features
     if (m_Mode == RenderingMode::NormalBasic)
     {
@@ -398,8 +352,68 @@ void Renderer::Initialize()
 
     InitStreaming();
 
-    // Load scene (if configured) after all renderer resources are ready
-    m_Scene.LoadScene();
+    if (Config::Get().m_EnableGeometryStreaming)
+    {
+        m_GeometryStreamer = std::make_unique<nvfeedback::GeometryStreamer>((uint64_t)Config::Get().m_GeometryPoolMB * 1024 * 1024);
+    }
+    if (Config::Get().m_EnableSceneCellStreaming)
+    {
+        m_SceneCellStreamer = std::make_unique<nvfeedback::SceneCellStreamer>((uint64_t)Config::Get().m_SceneCellPoolMB * 1024 * 1024);
+    }
+
+    // Load scene (if configured) after all renderer resources are ready.  It loads on its own
+    // thread, owning the streamers meanwhile; Run() presents a loading screen until
+    // UpdateSceneLoad swaps it in.
+    m_SceneLoader.Start(m_RHI->m_NvrhiDevice, std::move(m_GeometryStreamer), std::move(m_SceneCellStreamer));
+}
+
+bool Renderer::UpdateSceneLoad()
+{
+    PROFILE_FUNCTION();
+
+    if (!m_SceneLoader.Update())
+        return false;
+
+    // Nothing references the empty m_Scene yet: the scene-dependent work of the frame
+    // only starts once this returns true
+    std::unique_ptr<Scene> loadedScene = m_SceneLoader.TakeScene(m_GeometryStreamer, m_SceneCellStreamer);
+    m_Scene = std::move(*loadedScene);
+    if (m_GeometryStreamer && m_GeometryStreamer->IsInitialized())
+    {
+        m_GeometryStreamer->RebindScene(m_Scene);
+    }
+    if (m_SceneCellStreamer && m_SceneCellStreamer->IsInitialized())
+    {
+        m_SceneCellStreamer->RebindScene(m_Scene);
+    }
+
+    OnSceneLoaded();
+
+    // OnSceneLoaded idled the device
+    m_LoadingScreenCommandList = nullptr;
+    m_LoadingScreenQuery = nullptr;
+
+    LOG_INFO("[SceneLoad] Scene swapped in after %.2f s", m_SceneLoader.GetElapsedSeconds());
+    return true;
+}
+
+void Renderer::OnSceneLoaded()
+{
+    PROFILE_FUNCTION();
+
+    if (m_GeometryStreamer && !m_GeometryStreamer->IsInitialized())
+    {
+        m_GeometryStreamer.reset();
+    }
+    if (m_SceneCellStreamer && !m_SceneCellStreamer->IsInitialized())
+    {
+        m_SceneCellStreamer.reset();
+    }
+
+    if (!m_Scene.m_Cameras.empty())
+    {
+        SetCameraFromSceneCamera(m_Scene.m_Cameras[0]);
+    }
 
     // Restore saved camera state (overrides GLTF camera if present)
     {
@@ -424,9 +438,72 @@ void Renderer::Initialize()
         renderer->PostSceneLoad();
     }
 
+    InitVRAMBudget();
+
+    InitTilePrefetch();
+
+    if (Config::Get().m_ValidateRTInputs)
+    {
+        ValidateRTInputs();
+    }
+
     ExecutePendingCommandLists();
 }
 
+void Renderer::RenderLoadingScreen()
+{
+    PROFILE_FUNCTION();
+
+    nvrhi::IDevice* device = m_RHI->m_NvrhiDevice;
+
+    // The scene's uploads run on the same queue: wait for the previous frame by skipping
+    // this one rather than blocking in waitForIdle or Present
+    if (m_LoadingScreenQuery && !device->pollEventQuery(m_LoadingScreenQuery))
+        return;
+
+    device->runGarbageCollection();
+
+    m_ImGuiLayer.UpdateLoadingFrame();
+
+    const bool bSwapChainImageAcquireSuccess = m_RHI->AcquireNextSwapchainImage(&m_AcquiredSwapchainImageIdx);
+    SDL_assert(bSwapChainImageAcquireSuccess);
+
+    if (!m_LoadingScreenCommandList)
+    {
+        const nvrhi::CommandListParameters params{ .enableImmediateExecution = false, .queueType = nvrhi::CommandQueue::Graphics };
+        m_LoadingScreenCommandList = device->createCommandList(params);
+        m_LoadingScreenQuery = device->createEventQuery();
+    }
+
+    {
+        ScopedCommandList scopedCmd{ m_LoadingScreenCommandList, "Loading Screen" };
+        scopedCmd->clearTextureFloat(GetCurrentBackBufferTexture(), nvrhi::AllSubresources, nvrhi::Color{ 0.0f, 0.0f, 0.0f, 1.0f });
+
+        IRenderer* imguiRenderer = GET_RENDERER(ImGuiRenderer);
+        if (imguiRenderer->Setup(m_RenderGraph))
+        {
+            imguiRenderer->Render(m_LoadingScreenCommandList, m_RenderGraph);
+        }
+    }
+
+    if (m_LoadingScreenCommandList->m_GPULog != ULLONG_MAX)
+    {
+        MicroProfileGpuSubmit((uint32_t)nvrhi::CommandQueue::Graphics, m_LoadingScreenCommandList->m_GPULog);
+        m_LoadingScreenCommandList->m_GPULog = ULLONG_MAX;
+    }
+    device->executeCommandList(m_LoadingScreenCommandList);
+    device->resetEventQuery(m_LoadingScreenQuery);
+    device->setEventQuery(m_LoadingScreenQuery, nvrhi::CommandQueue::Graphics);
+
+    if (!m_RHI->PresentSwapchain(m_SwapChainImageIdx))
+    {
+        SDL_LOG_ASSERT_FAIL("PresentSwapchain failed", "[Run ] PresentSwapchain failed");
+        m_Running = false;
+        return;
+    }
+    m_SwapChainImageIdx = 1 - m_SwapChainImageIdx;
+}
+
 void Renderer::Run()
 {
     ScopedTimerLog runScope{"[Timing] Run phase:"};
@@ -437,6 +514,10 @@ void Renderer::Run()
     {
         PROFILE_SCOPED("Frame");
         const uint64_t frameStart = SDL_GetTicksNS();
+        const uint64_t frameStartAllocationCount = GetGlobalAllocationCount();
+
+        // Nothing from the previous frame references per-frame scratch memory any more
+        m_FrameAllocator.Reset();
         const uint32_t kFrameDurationNs = SDL_NS_PER_SECOND / m_TargetFPS;
 
         {
@@ -446,7 +527,10 @@ void Renderer::Run()
             while (SDL_PollEvent(&event))
             {
                 m_ImGuiLayer.ProcessEvent(event);
-                m_Scene.m_Camera.ProcessEvent(event);
+                if (!m_SceneLoader.IsActive())
+                {
+                    m_Scene.m_Camera.ProcessEvent(event);
+                }
 
                 if (event.type == SDL_EVENT_QUIT)
                 {
@@ -462,14 +546,29 @@ void Renderer::Run()
                         m_RequestedShaderReload = true;
                     }
 
+                    // Ctrl+P: screenshot, Ctrl+Shift+P: toggle image sequence capture
                     if ((event.key.mod & SDL_KMOD_CTRL) != 0 && event.key.scancode == SDL_SCANCODE_P)
                     {
-                        SaveBackBufferScreenshot();
+                        if ((event.key.mod & SDL_KMOD_SHIFT) == 0)
+                        {
+                            m_FrameCapture.RequestScreenshot();
+                        }
+                        else if (m_FrameCapture.IsSequenceActive())
+                        {
+                            m_FrameCapture.StopSequence();
+                        }
+                        else
+                        {
+                            m_FrameCapture.StartSequence(std::string{ SDL_GetBasePath() } + "captures");
+                        }
                     }
                 }
             }
         };
 
+        // The scene loads in the background: submit its uploads, swap it in once they are done
+        const bool bSceneReady = !m_SceneLoader.IsActive() || UpdateSceneLoad();
+
         SDL_WindowFlags flags = SDL_GetWindowFlags(m_Window);
         const bool bWindowIsInFocus = (flags & SDL_WINDOW_INPUT_FOCUS) != 0;
 
@@ -479,6 +578,28 @@ void Renderer::Run()
             continue; // Skip rendering when window is not in focus to save resources
         }
 
+        // Until then, only the loading screen: none of the scene-dependent work below runs,
+        // and m_FrameNumber stays put (the loader thread reads it)
+        if (!bSceneReady)
+        {
+            RenderLoadingScreen();
+
+            const uint32_t kLoadingScreenFrameDurationNs = SDL_NS_PER_SECOND / kLoadingScreenFPS;
+            const uint64_t workTimeNs = SDL_GetTicksNS() - frameStart;
+            if (workTimeNs < kLoadingScreenFrameDurationNs)
+            {
+                PROFILE_SCOPED("Sleep");
+                SDL_Delay(static_cast<uint32_t>(SDL_NS_TO_MS(kLoadingScreenFrameDurationNs - workTimeNs)));
+            }
+
+            m_FrameTime = SDL_NS_TO_MS(static_cast<double>(SDL_GetTicksNS() - frameStart));
+            MicroProfileFlip(nullptr);
+            continue;
+        }
+
+        // Shader reloads rebuild PSOs: not a steady-state frame
+        const bool bSteadyStateFrame = !m_RequestedShaderReload && m_FrameNumber >= kAllocationWarmUpFrames;
+
         if (m_RequestedShaderReload)
         {
             ReloadShaders();
@@ -512,6 +633,25 @@ void Renderer::Run()
         // Upload material constants for materials changed by emissive intensity animations.
         UploadDirtyMaterialConstants();
 
+        // Evict/restore streaming tiles, streamed geometry and BLAS LODs against the VRAM budget
+        UpdateVRAMBudget();
+
+        // Page mesh LODs in/out as the culling passes requested a few frames ago
+        if (m_GeometryStreamer)
+        {
+            nvrhi::CommandListHandle cmd = AcquireCommandList();
+            ScopedCommandList scopedCmd{ cmd, "Geometry Streaming" };
+            m_GeometryStreamer->Update(scopedCmd);
+        }
+
+        // Load and unload the models of a partitioned scene around the camera
+        if (m_SceneCellStreamer)
+        {
+            nvrhi::CommandListHandle cmd = AcquireCommandList();
+            ScopedCommandList scopedCmd{ cmd, "Scene Cell Streaming" };
+            m_SceneCellStreamer->Update(scopedCmd);
+        }
+
         // Update camera (camera retrieves frame time internally)
         m_Scene.m_ViewPrev = m_Scene.m_View;
         m_Scene.m_Camera.Update();
@@ -537,6 +677,9 @@ void Renderer::Run()
             scopedCmd->beginTimerQuery(m_GPUQueries[writeIndex]);
         }
 
+        // Predict the tiles the camera is about to need; consumed by this frame's BeginFrame
+        UpdateTilePrefetch();
+
         // Update texture streaming -> pre-render phase:
         // flush async uploads, BeginFrame, tile submit, UpdateTileMappings.
         {
@@ -546,9 +689,12 @@ void Renderer::Run()
 
         ComputeCSMCascadeSplits();
         ComputeCascadeViewProj();
+        UpdateLightClusters();
         ScheduleAndRunAllRenderers();
 
-        // Wait for all render passes to finish recording
+        // Wait for all render passes to finish recording.  Never while the loader thread runs:
+        // this would also wait for its ParallelFor batches
+        SDL_assert(!m_SceneLoader.IsActive());
         m_TaskScheduler->ExecuteAllScheduledTasks();
 
         m_RenderGraph.PostRender();
@@ -557,6 +703,14 @@ void Renderer::Run()
         // ResolveFeedback (reads sampler feedback written by GBuffer pass) + EndFrame.
         UpdateStreamingPostRender();
 
+        // Read back this frame's mesh LOD requests
+        if (m_GeometryStreamer)
+        {
+            nvrhi::CommandListHandle cmd = AcquireCommandList();
+            ScopedCommandList scopedCmd{ cmd, "Resolve Geometry LOD Requests" };
+            m_GeometryStreamer->ResolveRequests(scopedCmd);
+        }
+
         // GPU query for frame timer is super expensive on the CPU for some reason. i give up using it
         if constexpr (false)
         {
@@ -566,6 +720,15 @@ void Renderer::Run()
             scopedCmd->endTimerQuery(m_GPUQueries[writeIndex]);
         }
 
+        // Back buffer readback for screenshots / sequence capture (encoded off-thread)
+        m_FrameCapture.RetireCompletedSlots(m_FrameNumber);
+        if (m_FrameCapture.IsCapturePending())
+        {
+            nvrhi::CommandListHandle cmd = AcquireCommandList();
+            ScopedCommandList scopedCmd{ cmd, "Frame Capture" };
+            m_FrameCapture.RecordFrame(cmd, GetCurrentBackBufferTexture(), m_FrameNumber);
+        }
+
         // Execute any queued GPU work in submission order
         ExecutePendingCommandLists();
 
@@ -596,6 +759,18 @@ void Renderer::Run()
         if (m_FrameTime > 0.0)
             m_FPS = 1000.0 / m_FrameTime;
 
+        m_HeapAllocationsLastFrame = GetGlobalAllocationCount() - frameStartAllocationCount;
+#if ENABLE_ALLOCATION_COUNTING
+        // Per-frame scratch belongs in m_FrameAllocator or in reused members; a warmed-up
+        // frame that goes past the budget has a container reallocating every frame again
+        if (bSteadyStateFrame && m_HeapAllocationsLastFrame > kMaxHeapAllocationsPerFrame)
+        {
+            LOG_WARN("[Alloc] %llu heap allocations in frame %u (budget %llu)", (unsigned long long)m_HeapAllocationsLastFrame,
+                     m_FrameNumber, (unsigned long long)kMaxHeapAllocationsPerFrame);
+            SDL_assert(m_HeapAllocationsLastFrame <= kMaxHeapAllocationsPerFrame);
+        }
+#endif
+
         // Increment frame number for double buffering
         m_FrameNumber++;
 
@@ -617,8 +792,15 @@ void Renderer::Shutdown()
 {
     ScopedTimerLog shutdownScope{"[Timing] Shutdown phase:"};
 
+    // The loader thread records with the device, streamers and profiler torn down below
+    const bool bSceneLoaded = m_SceneLoader.GetState() == AsyncSceneLoader::State::Taken;
+    m_SceneLoader.Shutdown();
+
     MicroProfileShutdown();
 
+    // Flush outstanding captures before the device goes idle for teardown
+    m_FrameCapture.Shutdown();
+
     m_RHI->m_NvrhiDevice->waitForIdle();
     m_RHI->m_NvrhiDevice->runGarbageCollection();
 
@@ -627,6 +809,10 @@ void Renderer::Shutdown()
     m_InFlightCommandLists.clear();
     m_PendingCommandLists.clear();
     m_CommandListFreeList.clear();
+    m_LoadingScreenCommandList = nullptr;
+    m_LoadingScreenQuery = nullptr;
+    m_LightClusterBuffer = nullptr;
+    m_LightClusterIndexBuffer = nullptr;
 
     m_ImGuiLayer.Shutdown();
     CommonResources::GetInstance().Shutdown();
@@ -645,9 +831,15 @@ void Renderer::Shutdown()
 
     // Shutdown texture streaming before scene resources are released
     ShutdownStreaming();
+    m_GeometryStreamer.reset();
+    m_SceneCellStreamer.reset();
 
-    // Shutdown scene and free its GPU resources
-    m_Scene.Shutdown();
+    // Shutdown scene and free its GPU resources.  Before the load was swapped in, m_Scene is
+    // empty and its Shutdown would overwrite the saved camera with the default one.
+    if (bSceneLoaded)
+    {
+        m_Scene.Shutdown();
+    }
 
     // Free renderer instances
     m_Renderers.clear();
@@ -673,36 +865,451 @@ void Renderer::Shutdown()
         m_Window = nullptr;
     }
 
+    LOG_INFO("[Shutdown] Clean exit");
+
+    // Drain the logger while its SDL console output is still usable
+    Log::Shutdown();
     SDL_Quit();
-    SDL_Log("[Shutdown] Clean exit");
+}
+
+// --- VRAM Budget -------------------------------------------------------------
+
+void Renderer::InitVRAMBudget()
+{
+    // Eviction order: streaming tiles are cheapest to lose (they stream back in), then streamed
+    // geometry (LODs fall back to coarser resident ones, far cells unload; what that frees is
+    // their BLASes, the pools are fixed ranges of the scene buffers), then BLAS LODs (ray traced
+    // geometry gets coarser).  Render graph heaps and scene buffers are tracked only.
+    {
+        VRAMBudgetGovernor::SubsystemDesc desc;
+        desc.m_Name = "Streaming";
+        desc.m_EvictionPriority = 0;
+        desc.m_Reclaim = [this](uint64_t bytes) { return m_FeedbackManager->ReclaimHeapMemory(bytes); };
+        desc.m_Restore = [this]() { m_FeedbackManager->RestoreHeapBudget(); };
+        m_VRAMStreamingID = m_VRAMBudget.Register(desc);
+    }
+
+    if (m_GeometryStreamer)
+    {
+        VRAMBudgetGovernor::SubsystemDesc desc;
+        desc.m_Name = "GeometryLODs";
+        desc.m_EvictionPriority = 5;
+        desc.m_Reclaim = [this](uint64_t bytes) { return m_GeometryStreamer->ReclaimStreamedLODs(bytes); };
+        desc.m_Restore = [this]() { m_GeometryStreamer->RestoreStreamedLODs(); };
+        m_VRAMGeometryLODsID = m_VRAMBudget.Register(desc);
+    }
+
+    if (m_SceneCellStreamer)
+    {
+        VRAMBudgetGovernor::SubsystemDesc desc;
+        desc.m_Name = "SceneCells";
+        desc.m_EvictionPriority = 6;
+        desc.m_Reclaim = [this](uint64_t bytes) { return m_SceneCellStreamer->ReclaimCellMemory(bytes); };
+        desc.m_Restore = [this]() { m_SceneCellStreamer->RestoreCellBudget(); };
+        m_VRAMSceneCellsID = m_VRAMBudget.Register(desc);
+    }
+
+    {
+        VRAMBudgetGovernor::SubsystemDesc desc;
+        desc.m_Name = "BLAS";
+        desc.m_EvictionPriority = 10;
+        desc.m_Reclaim = [this](uint64_t bytes)
+        {
+            uint64_t freed = 0;
+            while (freed < bytes)
+            {
+                const uint64_t dropped = m_Scene.DropFinestBLASLOD();
+                if (dropped == 0)
+                    break;
+                freed += dropped;
+            }
+            return freed;
+        };
+        desc.m_Restore = [this]() { m_Scene.RestoreBLASLODs(); };
+        m_VRAMBLASID = m_VRAMBudget.Register(desc);
+    }
+
+    m_VRAMRenderGraphID  = m_VRAMBudget.Register({ .m_Name = "RenderGraph", .m_EvictionPriority = 100 });
+    m_VRAMSceneBuffersID = m_VRAMBudget.Register({ .m_Name = "SceneBuffers", .m_EvictionPriority = 100 });
+
+    // Scene buffers are created once at load
+    m_SceneBufferBytes = 0;
+    for (const nvrhi::BufferHandle& buffer : { m_Scene.m_VertexBufferQuantized, m_Scene.m_IndexBuffer, m_Scene.m_MaterialConstantsBuffer,
+                                               m_Scene.m_MeshDataBuffer, m_Scene.m_MeshletBuffer, m_Scene.m_MeshletVerticesBuffer,
+                                               m_Scene.m_MeshletTrianglesBuffer, m_Scene.m_InstanceDataBuffer, m_Scene.m_LightBuffer })
+    {
+        if (buffer)
+            m_SceneBufferBytes += buffer->getDesc().byteSize;
+    }
+
+    const uint32_t budgetMB = Config::Get().m_VRAMBudgetMB;
+    LOG_INFO("[VRAMBudget] Initialized: budget=%s%.0f MB", budgetMB ? "" : "driver ",
+             budgetMB ? (float)budgetMB : m_RHI->GetVRAMBudgetMB());
+}
+
+void Renderer::UpdateVRAMBudget()
+{
+    PROFILE_FUNCTION();
+
+    m_Scene.ReleaseDroppedBLAS();
+
+    const uint32_t capMB = Config::Get().m_VRAMBudgetMB;
+    const float budgetMB = capMB ? (float)capMB : m_RHI->GetVRAMBudgetMB();
+    m_VRAMBudget.SetBudget((uint64_t)budgetMB * 1024 * 1024);
+
+    uint64_t renderGraphBytes = 0;
+    for (const auto& heap : m_RenderGraph.GetHeaps())
+    {
+        renderGraphBytes += heap.m_Size;
+    }
+
+    const uint64_t streamingBytes = m_FeedbackManager->GetHeapBytes();
+
+    // The streamers' BLASes are theirs to give back; the rest is the scene-wide BLAS LODs
+    const uint64_t geometryLODBytes = m_GeometryStreamer ? m_GeometryStreamer->GetStreamedBLASBytes() : 0;
+    const uint64_t sceneCellBytes   = m_SceneCellStreamer ? m_SceneCellStreamer->GetStreamedBLASBytes() : 0;
+    const uint64_t blasBytes        = m_Scene.m_BLASMemoryBytes - std::min(m_Scene.m_BLASMemoryBytes, geometryLODBytes + sceneCellBytes);
+
+    m_VRAMBudget.ReportFootprint(m_VRAMStreamingID, streamingBytes, m_FeedbackManager->GetMinimumHeapBytes());
+    if (m_GeometryStreamer)
+        m_VRAMBudget.ReportFootprint(m_VRAMGeometryLODsID, geometryLODBytes, 0);
+    if (m_SceneCellStreamer)
+        m_VRAMBudget.ReportFootprint(m_VRAMSceneCellsID, sceneCellBytes, 0);
+    m_VRAMBudget.ReportFootprint(m_VRAMBLASID, blasBytes, m_Scene.m_BLASMinimumBytes);
+    m_VRAMBudget.ReportFootprint(m_VRAMRenderGraphID, renderGraphBytes, renderGraphBytes);
+    m_VRAMBudget.ReportFootprint(m_VRAMSceneBuffersID, m_SceneBufferBytes, m_SceneBufferBytes);
+
+    // Everything else the process holds (textures, swap chain, driver internals)
+    const uint64_t trackedBytes = streamingBytes + m_Scene.m_BLASMemoryBytes + renderGraphBytes + m_SceneBufferBytes;
+    const uint64_t usageBytes   = (uint64_t)(m_RHI->GetVRAMUsageMB() * 1024.0 * 1024.0);
+    m_VRAMBudget.ReportUntrackedBytes(usageBytes > trackedBytes ? usageBytes - trackedBytes : 0);
+
+    m_VRAMBudget.Update();
 }
 
 // --- Texture Streaming -------------------------------------------------------
 
 void Renderer::InitStreaming()
 {
-    m_FeedbackManager = std::make_unique<nvfeedback::FeedbackManager>();
+    m_FeedbackManager = std::make_unique<nvfeedback::FeedbackManager>(Config::Get().m_StreamingHeapSizeInTiles);
     SDL_assert(m_FeedbackManager && "CreateFeedbackManager failed");
 
-    // Create async tile I/O thread pool
-    m_AsyncTileIO = std::make_unique<nvfeedback::AsyncTileIO>();
+    if (!Config::Get().m_RecordStreamingTracePath.empty())
+        m_FeedbackManager->StartTraceRecording(Config::Get().m_RecordStreamingTracePath);
+
+    // Create async tile I/O, running on the TaskScheduler's I/O lane
+    const nvfeedback::AsyncTileIO::IOBackend ioBackend = Config::Get().m_TileIOExplicitReads
+        ? nvfeedback::AsyncTileIO::IOBackend::ExplicitRead
+        : nvfeedback::AsyncTileIO::IOBackend::MemoryMapped;
+    m_AsyncTileIO = std::make_unique<nvfeedback::AsyncTileIO>(m_RHI->m_NvrhiDevice, ioBackend, Config::Get().m_TileIOQueueDepth,
+                                                              nvfeedback::AsyncTileIO::kDefaultStagingRingBytes,
+                                                              (uint64_t)Config::Get().m_TileCacheMB * 1024 * 1024,
+                                                              m_TaskScheduler.get());
     SDL_assert(m_AsyncTileIO && "Failed to create AsyncTileIO");
 
-    SDL_Log("[Streaming] Initialized: asyncWorkers=%u",
-            m_AsyncTileIO->WorkerCount());
+    m_StreamingSessionTimer.Reset();
+
+    LOG_INFO("[Streaming] Initialized: asyncWorkers=%u ioBackend=%s queueDepth=%u tileCache=%uMB heapTiles=%u budgets=%s",
+             m_AsyncTileIO->WorkerCount(),
+             Config::Get().m_TileIOExplicitReads ? "read" : "mmap",
+             m_AsyncTileIO->GetQueueDepth(),
+             Config::Get().m_TileCacheMB,
+             m_FeedbackManager->GetHeapSizeInTiles(),
+             Config::Get().m_AdaptiveStreamingBudgets ? "adaptive" : "fixed");
 }
 
 void Renderer::ShutdownStreaming()
 {
     // Drain any in-flight async requests before destroying resources
     m_AsyncTileIO->WaitIdle();
-    m_AsyncTileIO->Flush(nullptr); // discard completed callbacks (resources about to be freed)
+    m_AsyncTileIO->Flush(nullptr, m_FrameNumber); // discard completed callbacks (resources about to be freed)
+
+    const nvfeedback::AsyncTileIO::IOStats ioStats = m_AsyncTileIO->GetIOStats();
+    if (ioStats.m_NumTiles > 0)
+    {
+        const uint64_t tilesRead = ioStats.m_NumTiles - ioStats.m_NumCachedTiles;
+        LOG_INFO("[Streaming] Tile I/O: %llu tiles (%llu from the tile cache), %llu reads (%.2f per tile read), %.2f MB read",
+                 (unsigned long long)ioStats.m_NumTiles, (unsigned long long)ioStats.m_NumCachedTiles, (unsigned long long)ioStats.m_NumReads,
+                 tilesRead > 0 ? (double)ioStats.m_NumReads / (double)tilesRead : 0.0, BYTES_TO_MB(ioStats.m_BytesRead));
+        LOG_INFO("[Streaming] Tile I/O throughput per core: read %.2f GB/s (%.3f s), decode %.2f GB/s (%llu tiles, %.2f MB, %.3f s)",
+                 ioStats.m_ReadSeconds > 0.0 ? (double)ioStats.m_BytesRead / ioStats.m_ReadSeconds / 1e9 : 0.0, ioStats.m_ReadSeconds,
+                 ioStats.m_DecodeSeconds > 0.0 ? (double)ioStats.m_BytesDecoded / ioStats.m_DecodeSeconds / 1e9 : 0.0,
+                 (unsigned long long)ioStats.m_NumCompressedTiles, BYTES_TO_MB(ioStats.m_BytesDecoded), ioStats.m_DecodeSeconds);
+    }
     m_AsyncTileIO.reset();
 
+    if (!Config::Get().m_StreamingStatsPath.empty())
+        ReportTextureStreamingStats(Config::Get().m_StreamingStatsPath);
+
+    m_FeedbackManager->StopTraceRecording();
+
+    if (!m_RecordedCameraPath.empty() && nvfeedback::SaveCameraPath(Config::Get().m_RecordCameraPath, m_RecordedCameraPath))
+    {
+        LOG_INFO("[Prefetch] Recorded %zu camera poses to '%s'", m_RecordedCameraPath.size(), Config::Get().m_RecordCameraPath.c_str());
+    }
+
     m_FeedbackManager.reset();
     SDL_Log("[Streaming] Shutdown complete.");
 }
 
+bool Renderer::ReportTextureStreamingStats(const std::filesystem::path& filePath)
+{
+    std::vector<nvfeedback::TextureStreamingReport> reports;
+    m_FeedbackManager->GetTextureStreamingReports(reports);
+
+    for (nvfeedback::TextureStreamingReport& report : reports)
+    {
+        const int userIndex = m_FeedbackManager->GetTextureByIndex(report.m_TextureIdx)->GetUserIndex();
+        if (userIndex >= 0 && userIndex < (int)m_Scene.m_Textures.size() && !m_Scene.m_Textures[userIndex].m_Uri.empty())
+            report.m_Name = m_Scene.m_Textures[userIndex].m_Uri;
+        else
+            report.m_Name = "Texture " + std::to_string(userIndex);
+    }
+
+    nvfeedback::LogWorstStreamingTextures(reports, 5);
+
+    if (!nvfeedback::WriteTextureStreamingReport(filePath, reports, m_StreamingSessionTimer.TotalSeconds()))
+        return false;
+
+    LOG_INFO("[Streaming] Wrote stats for %zu textures to '%s'", reports.size(), filePath.string().c_str());
+    return true;
+}
+
+static nvfeedback::PrefetchView GetPrefetchView(const Camera& camera, uint32_t viewportHeight)
+{
+    nvfeedback::PrefetchView view;
+    view.m_FovY           = camera.GetProjection().fovY;
+    view.m_AspectRatio    = camera.GetProjection().aspectRatio;
+    view.m_NearZ          = camera.GetProjection().nearZ;
+    view.m_ViewportHeight = (float)viewportHeight;
+    return view;
+}
+
+static nvfeedback::PrefetchInstance GetPrefetchInstance(const srrhi::PerInstanceData& instanceData)
+{
+    nvfeedback::PrefetchInstance instance;
+    instance.m_Center        = { instanceData.m_Center.x, instanceData.m_Center.y, instanceData.m_Center.z };
+    instance.m_Radius        = instanceData.m_Radius;
+    instance.m_WorldScale    = nvfeedback::GetPrefetchWorldScale(instanceData.m_World.m);
+    instance.m_MaterialIndex = instanceData.m_MaterialIndex;
+    return instance;
+}
+
+// UV units per mesh-local meter of every material, measured over (a sample of) the LOD0
+// triangles of its primitives (see TexelDensityEstimator).
+static void ComputeMaterialUVDensities(const Scene& scene, std::vector<nvfeedback::PrefetchMaterial>& materials)
+{
+    PROFILE_FUNCTION();
+
+    // Triangles sampled per primitive; the density of a mesh varies slowly
+    static constexpr uint32_t kMaxSampledTriangles = 4096;
+
+    Scene::CPUGeometryView geometry;
+    if (!scene.MapCPUGeometry(geometry))
+    {
+        LOG_WARN("[Prefetch] No cooked mesh cache: texel density falls back to instance bounds");
+        return;
+    }
+
+    std::vector<nvfeedback::TexelDensityEstimator> estimators(materials.size());
+
+    for (const Scene::Mesh& mesh : scene.m_Meshes)
+    {
+        for (const Scene::Primitive& primitive : mesh.m_Primitives)
+        {
+            if (primitive.m_MaterialIndex < 0 || materials[primitive.m_MaterialIndex].m_Textures.empty())
+                continue;
+
+            const srrhi::MeshData& meshData = scene.m_MeshData[primitive.m_MeshDataIndex];
+            const uint32_t numTriangles = meshData.m_IndexCounts[0] / 3;
+            const uint32_t stride       = std::max(1u, numTriangles / kMaxSampledTriangles);
+
+            for (uint32_t tri = 0; tri < numTriangles; tri += stride)
+            {
+                const size_t firstIndex = (size_t)meshData.m_IndexOffsets[0] + tri * 3;
+                if (firstIndex + 3 > geometry.m_Indices.size())
+                    break;
+
+                nvfeedback::PrefetchVector3 pos[3];
+                float uv[3][2];
+                bool  bValid = true;
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    const uint32_t vertexIndex = geometry.m_Indices[firstIndex + corner];
+                    if (vertexIndex >= geometry.m_VerticesQuantized.size())
+                    {
+                        bValid = false;
+                        break;
+                    }
+                    const srrhi::VertexQuantized& vertex = geometry.m_VerticesQuantized[vertexIndex];
+                    pos[corner]   = { vertex.m_Pos.x, vertex.m_Pos.y, vertex.m_Pos.z };
+                    uv[corner][0] = meshopt_dequantizeHalf((unsigned short)(vertex.m_Uv & 0xFFFF));
+                    uv[corner][1] = meshopt_dequantizeHalf((unsigned short)(vertex.m_Uv >> 16));
+                }
+                if (!bValid)
+                    continue;
+
+                estimators[primitive.m_MaterialIndex].AddTriangle(pos, uv);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < materials.size(); ++i)
+        materials[i].m_UVDensity = estimators[i].GetUVDensity();
+}
+
+void Renderer::InitTilePrefetch()
+{
+    PROFILE_FUNCTION();
+
+    m_PrefetchScene = {};
+    m_TilePrefetcher.ResetHistory();
+
+    // Streamed textures in FeedbackManager order, and the reverse map from scene texture index
+    std::vector<uint32_t> feedbackIndexOfTexture(m_Scene.m_Textures.size(), UINT32_MAX);
+    for (uint32_t i = 0; i < m_FeedbackManager->GetNumTextures(); ++i)
+    {
+        m_PrefetchScene.m_Textures.push_back(m_FeedbackManager->GetPrefetchTexture(i));
+
+        const int userIndex = m_FeedbackManager->GetTextureByIndex(i)->GetUserIndex();
+        if (userIndex >= 0 && userIndex < (int)feedbackIndexOfTexture.size())
+            feedbackIndexOfTexture[userIndex] = i;
+    }
+
+    if (m_PrefetchScene.m_Textures.empty())
+        return;
+
+    m_PrefetchScene.m_Materials.resize(m_Scene.m_Materials.size());
+    for (size_t i = 0; i < m_Scene.m_Materials.size(); ++i)
+    {
+        const Scene::Material& material = m_Scene.m_Materials[i];
+        for (int textureIdx : { material.m_BaseColorTexture, material.m_NormalTexture, material.m_MetallicRoughnessTexture, material.m_EmissiveTexture })
+        {
+            if (textureIdx >= 0 && textureIdx < (int)feedbackIndexOfTexture.size() && feedbackIndexOfTexture[textureIdx] != UINT32_MAX)
+                m_PrefetchScene.m_Materials[i].m_Textures.push_back(feedbackIndexOfTexture[textureIdx]);
+        }
+    }
+    ComputeMaterialUVDensities(m_Scene, m_PrefetchScene.m_Materials);
+
+    for (const srrhi::PerInstanceData& instanceData : m_Scene.m_InstanceData)
+        m_PrefetchScene.m_Instances.push_back(GetPrefetchInstance(instanceData));
+
+    LOG_INFO("[Prefetch] Initialized: %zu streamed textures, %zu materials, %zu instances",
+             m_PrefetchScene.m_Textures.size(), m_PrefetchScene.m_Materials.size(), m_PrefetchScene.m_Instances.size());
+
+    // Offline evaluation: replay a recorded path against the prediction model
+    const std::string& replayPath = Config::Get().m_PrefetchReplayPath;
+    std::vector<nvfeedback::CameraPose> path;
+    if (!replayPath.empty() && nvfeedback::LoadCameraPath(replayPath, path))
+    {
+        SimpleTimer timer;
+        const nvfeedback::PrefetchReplayStats stats = nvfeedback::ReplayCameraPath(m_PrefetchScene, GetPrefetchView(m_Scene.m_Camera, m_RHI->m_SwapchainExtent.y), path);
+        LOG_INFO("[Prefetch] Replay '%s': %u samples in %.2f s, hit rate %.1f%% (%.2f of %.2f MB needed), wasted %.2f MB (%.1f%% of %.2f MB predicted)",
+                 replayPath.c_str(), stats.m_NumSamples, timer.TotalSeconds(),
+                 stats.GetHitRate() * 100.0, BYTES_TO_MB(stats.m_HitBytes), BYTES_TO_MB(stats.m_NeededBytes),
+                 BYTES_TO_MB(stats.m_WastedBytes), stats.GetWasteRate() * 100.0, BYTES_TO_MB(stats.m_PredictedBytes));
+    }
+}
+
+void Renderer::ValidateRTInputs()
+{
+    PROFILE_FUNCTION();
+
+    // Grid of primary rays traced through the CPU BVH
+    static constexpr uint32_t kProbeWidth  = 320;
+    static constexpr uint32_t kProbeHeight = 180;
+
+    Scene::CPUGeometryView geometry;
+    if (!m_Scene.MapCPUGeometry(geometry))
+    {
+        LOG_WARN("[CPURayQuery] No cooked mesh cache: ray tracing inputs not validated");
+        return;
+    }
+
+    ValidateRayTracingInputs(m_Scene, geometry);
+
+    CPUSceneRayQuery rayQuery;
+    if (!rayQuery.Build(m_Scene, geometry, *m_TaskScheduler))
+        return;
+
+    const CPUSceneRayQueryStats& stats = rayQuery.GetStats();
+    LOG_INFO("[CPURayQuery] Built %u meshes (%llu triangles) and %u instances in %.2f ms, %.2f MB",
+             stats.m_NumMeshes, (unsigned long long)stats.m_NumTriangles, stats.m_NumInstances, stats.m_BuildMs, BYTES_TO_MB(stats.m_MemoryBytes));
+
+    const Camera& camera = m_Scene.m_Camera;
+    const ProjectionParams& projection = camera.GetProjection();
+    const float tanHalfFovY = std::tan(projection.fovY * 0.5f);
+    const float tanHalfFovX = tanHalfFovY * projection.aspectRatio;
+    const Matrix viewMatrix = camera.GetViewMatrix();
+    const DirectX::XMMATRIX viewToWorld = DirectX::XMMatrixInverse(nullptr, DirectX::XMLoadFloat4x4(&viewMatrix));
+
+    std::vector<CPURay> rays(kProbeWidth * kProbeHeight);
+    for (uint32_t y = 0; y < kProbeHeight; ++y)
+    {
+        for (uint32_t x = 0; x < kProbeWidth; ++x)
+        {
+            const float ndcX = (x + 0.5f) / kProbeWidth * 2.0f - 1.0f;
+            const float ndcY = 1.0f - (y + 0.5f) / kProbeHeight * 2.0f;
+            const DirectX::XMVECTOR viewDirection = DirectX::XMVectorSet(ndcX * tanHalfFovX, ndcY * tanHalfFovY, 1.0f, 0.0f);
+
+            CPURay& ray = rays[y * kProbeWidth + x];
+            ray.m_Origin = camera.GetPosition();
+            ray.m_TMin = projection.nearZ;
+            DirectX::XMStoreFloat3(&ray.m_Direction, DirectX::XMVector3TransformNormal(viewDirection, viewToWorld));
+        }
+    }
+
+    std::vector<CPURayHit> hits(rays.size());
+    SimpleTimer closestTimer;
+    rayQuery.TraceClosest(rays, hits, *m_TaskScheduler);
+    const double closestSeconds = closestTimer.TotalSeconds();
+
+    std::vector<uint8_t> occluded(rays.size());
+    SimpleTimer anyTimer;
+    rayQuery.TraceAny(rays, occluded, *m_TaskScheduler);
+    const double anySeconds = anyTimer.TotalSeconds();
+
+    const size_t numHits = std::count_if(hits.begin(), hits.end(), [](const CPURayHit& hit) { return hit.IsHit(); });
+    const size_t numOccluded = std::count(occluded.begin(), occluded.end(), (uint8_t)1);
+    LOG_INFO("[CPURayQuery] %ux%u camera rays: %.1f%% hit; closest hit %.2f Mrays/s, any hit %.2f Mrays/s%s",
+             kProbeWidth, kProbeHeight, 100.0 * numHits / rays.size(),
+             rays.size() / closestSeconds * 1e-6, rays.size() / anySeconds * 1e-6,
+             numHits == numOccluded ? "" : " (closest and any hit disagree)");
+}
+
+void Renderer::UpdateTilePrefetch()
+{
+    PROFILE_FUNCTION();
+
+    const Camera& camera = m_Scene.m_Camera;
+
+    const Vector3 position = camera.GetPosition();
+
+    nvfeedback::CameraPose pose;
+    pose.m_Position = { position.x, position.y, position.z };
+    pose.m_Yaw      = camera.GetYaw();
+    pose.m_Pitch    = camera.GetPitch();
+    pose.m_Time     = (double)SDL_GetTicksNS() * 1e-9;
+
+    if (!Config::Get().m_RecordCameraPath.empty())
+        m_RecordedCameraPath.push_back(pose);
+
+    if (!Config::Get().m_EnableTilePrefetch || m_PrefetchScene.m_Textures.empty())
+        return;
+
+    // Instances added after load (async mesh arrivals)
+    if (m_PrefetchScene.m_Instances.size() != m_Scene.m_InstanceData.size())
+    {
+        m_PrefetchScene.m_Instances.clear();
+        for (const srrhi::PerInstanceData& instanceData : m_Scene.m_InstanceData)
+            m_PrefetchScene.m_Instances.push_back(GetPrefetchInstance(instanceData));
+    }
+
+    m_TilePrefetcher.AddCameraSample(pose);
+    m_TilePrefetcher.Predict(m_PrefetchScene, GetPrefetchView(camera, m_RHI->m_SwapchainExtent.y), m_PrefetchMips);
+    m_FeedbackManager->SetPrefetchRequests(m_PrefetchMips);
+}
+
 void Renderer::UpdateStreamingPreRender(nvrhi::CommandListHandle cmd)
 {
     PROFILE_FUNCTION();
@@ -715,167 +1322,129 @@ void Renderer::UpdateStreamingPreRender(nvrhi::CommandListHandle cmd)
     //            This MUST happen after Flush() so that when MinMip says "mip N is
     //            resident", the tile data is already on the GPU.
     //   Phase 3: BeginFrame() reads back sampler feedback and queues new tile requests
-    //            (limited to kFeedbackTexturesToResolvePerFrame textures per frame).
+    //            (limited to m_FeedbackTexturesToResolvePerFrame textures per frame).
     //
     // All three are merged into one command list so that updateTextureTileMappings
-    // (an immediate GPU queue op) follows the writeTexture calls from Flush().
-
-    std::vector<nvfeedback::FeedbackTextureUpdate> newEntries;
+    // (an immediate GPU queue op) follows the tile copies recorded by Flush().
 
     {
         PROFILE_SCOPED("Streaming TileFlush+UpdateMappings+BeginFrame");
         ScopedCommandList scopedCmd{ cmd, "Streaming TileFlush+UpdateMappings+BeginFrame" };
 
+        SimpleTimer uploadTimer;
+
         // Phase 1: Flush completed async tile uploads from previous frame.
         // After this call, all tile data submitted last frame is on the GPU.
-        const uint32_t flushedCount = m_AsyncTileIO->Flush(cmd);
+        m_CompletedTileReads.clear();
+        const uint32_t flushedCount = m_AsyncTileIO->Flush(cmd, m_FrameNumber, &m_CompletedTileReads);
+        m_TilesFlushedThisFrame = flushedCount;
+
+        for (const nvfeedback::AsyncTileIO::CompletedTileRead& read : m_CompletedTileReads)
+            m_FeedbackManager->AddTileBytesRead(read.m_UserTag, read.m_BytesRead);
 
         if constexpr (nvfeedback::kStreamingDebugLog)
         {
             if (flushedCount > 0)
-                SDL_Log("[Streaming][PreRender] Phase 1: flushed %u tile write(s) to GPU", flushedCount);
+                LOG_INFO("[Streaming][PreRender] Phase 1: flushed %u tile write(s) to GPU", flushedCount);
         }
 
         // Phase 2: UpdateTileMappings for tiles whose data was just flushed above.
         // m_SubmittedTilesPendingMapping holds the tiles submitted last frame — their
         // data is now on the GPU, so it is safe to map them and update the MinMip texture.
-        if (!m_SubmittedTilesPendingMapping.empty())
+        if (m_NumTexturesPendingMapping > 0)
         {
+            const std::span<nvfeedback::FeedbackTextureUpdate> pendingMapping(m_SubmittedTilesPendingMapping.data(), m_NumTexturesPendingMapping);
             if constexpr (nvfeedback::kStreamingDebugLog)
             {
                 uint32_t totalTiles = 0;
-                for (auto& u : m_SubmittedTilesPendingMapping) totalTiles += (uint32_t)u.m_TileIndices.size();
-                SDL_Log("[Streaming][PreRender] Phase 2: UpdateTileMappings for %zu texture(s), %u tile(s) "
+                for (auto& u : pendingMapping) totalTiles += (uint32_t)u.m_TileIndices.size();
+                LOG_INFO("[Streaming][PreRender] Phase 2: UpdateTileMappings for %zu texture(s), %u tile(s) "
                         "(data was flushed this frame)",
-                        m_SubmittedTilesPendingMapping.size(), totalTiles);
+                        pendingMapping.size(), totalTiles);
             }
 
-            m_FeedbackManager->UpdateTileMappings(cmd, m_SubmittedTilesPendingMapping);
-            m_SubmittedTilesPendingMapping.clear();
+            m_FeedbackManager->UpdateTileMappings(cmd, pendingMapping);
+            m_NumTexturesPendingMapping = 0;
         }
 
-        // Phase 3: BeginFrame — collect new tile requests.
-        // Only release empty heaps when the pending upload queue is empty; releasing
-        // heaps while tiles are still pending causes the grow-shrink churn pattern.
-        const bool allowHeapRelease = m_PendingTileRequests.empty();
-        m_FeedbackManager->BeginFrame(cmd, newEntries, allowHeapRelease);
+        m_StreamingUploadSeconds = uploadTimer.LapSeconds();
+
+        // Phase 3: BeginFrame — enqueue new tile requests into the TileScheduler and
+        // cancel pending tiles that TTM unmapped.
+        m_FeedbackManager->BeginFrame(cmd);
     }
 
-    // -- Phase 4+5: Submit tile requests up to kMaxTilesPerFrame budget --
-    // Drain deferred tiles from previous frames first, then new entries.
-    // Tiles that exceed the budget are kept in m_PendingTileRequests for next frame.
-    // This prevents large single-frame upload batches (e.g. 1623 tiles = 104 MB).
-    std::vector<nvfeedback::FeedbackTextureUpdate> submittedThisFrame;
-    uint32_t tilesSubmitted = 0;
+    // -- Phase 4+5: Submit tile requests up to the m_MaxTilesPerFrame budget --
+    // The scheduler hands out the highest-priority pending tiles (screen coverage,
+    // distance to the resident mip, age); the rest stay queued for later frames.
+    // Only one frame's budget ever reaches the I/O workers, so a camera cut does not
+    // leave the workers busy with tiles nobody looks at anymore.
 
-    // Merge new entries into the pending queue (new entries go to the back)
-    for (auto& entry : newEntries)
-        m_PendingTileRequests.push_back(std::move(entry));
-    newEntries.clear();
+    // Reuses the entries (and tile lists) that last frame's Phase 2 mapped
+    std::vector<nvfeedback::FeedbackTextureUpdate>& submittedThisFrame = m_SubmittedTilesThisFrame;
+    uint32_t numSubmittedTextures = 0;
+    uint32_t tilesSubmitted = 0;
 
-    if (!m_PendingTileRequests.empty())
     {
         PROFILE_SCOPED("Streaming TileSubmit");
 
-        std::vector<nvfeedback::FeedbackTextureUpdate> stillPending;
+        SimpleTimer submitTimer;
 
-        for (nvfeedback::FeedbackTextureUpdate& texUpdate : m_PendingTileRequests)
-        {
-            if (tilesSubmitted >= nvfeedback::kMaxTilesPerFrame)
-            {
-                // Budget exhausted — defer remaining tiles
-                stillPending.push_back(std::move(texUpdate));
-                continue;
-            }
+        std::pmr::vector<nvfeedback::ScheduledTile> scheduledTiles{ &m_FrameAllocator };
+        m_FeedbackManager->PopScheduledTiles(m_FeedbackManager->GetBudgets().m_MaxTilesPerFrame, scheduledTiles);
 
-            nvfeedback::FeedbackTexture* feedbackTex = m_FeedbackManager->GetTextureByIndex(texUpdate.m_TextureIdx);
+        std::pmr::vector<nvfeedback::FeedbackTextureTileInfo> tileInfos{ &m_FrameAllocator };
+        for (const nvfeedback::ScheduledTile& tile : scheduledTiles)
+        {
+            nvfeedback::FeedbackTexture* feedbackTex = m_FeedbackManager->GetTextureByIndex(tile.m_TextureIdx);
             Scene::StreamingTexture& st = m_Scene.m_StreamingTextures.at(feedbackTex->GetUserIndex());
             SDL_assert(st.m_ReservedTexture && st.m_SourceData);
+            SDL_assert(!feedbackTex->IsTilePacked(tile.m_TileIndex));
 
-            nvrhi::TextureHandle reservedTex = feedbackTex->GetReservedTexture();
-            const nvrhi::TextureDesc& texDesc = reservedTex->getDesc();
+            const nvrhi::TextureDesc& texDesc = feedbackTex->GetReservedTexture()->getDesc();
             const nvrhi::FormatInfo& fmtInfo = nvrhi::getFormatInfo(texDesc.format);
 
-            std::vector<uint32_t> submittedTilesThisEntry;
-            std::vector<uint32_t> deferredTilesThisEntry;
-
-            for (uint32_t tileIndex : texUpdate.m_TileIndices)
-            {
-                if (tilesSubmitted >= nvfeedback::kMaxTilesPerFrame)
-                {
-                    deferredTilesThisEntry.push_back(tileIndex);
-                    continue;
-                }
-
-                SDL_assert(!feedbackTex->IsTilePacked(tileIndex));
-
-                std::vector<nvfeedback::FeedbackTextureTileInfo> tileInfos;
-                feedbackTex->GetTileInfo(tileIndex, tileInfos);
-
-                for (const nvfeedback::FeedbackTextureTileInfo& tileInfo : tileInfos)
-                {
-                    nvfeedback::TileRequest req;
-                    req.m_SourceData         = st.m_SourceData;
-                    req.m_ReservedTexture    = st.m_ReservedTexture;
-                    req.m_MipLevel           = tileInfo.m_Mip;
-                    req.m_TileXInTexels      = tileInfo.m_XInTexels;
-                    req.m_TileYInTexels      = tileInfo.m_YInTexels;
-                    req.m_TileWidthInTexels  = tileInfo.m_WidthInTexels;
-                    req.m_TileHeightInTexels = tileInfo.m_HeightInTexels;
-                    req.m_TextureWidth       = texDesc.width;
-                    req.m_TextureHeight      = texDesc.height;
-                    std::memcpy(req.m_MipOffsets, st.m_MipDataOffsets, sizeof(st.m_MipDataOffsets));
-                    req.m_Format             = texDesc.format;
-                    req.m_BytesPerBlock      = fmtInfo.bytesPerBlock;
-                    req.m_BlockSize          = fmtInfo.blockSize;
-
-                    req.m_OnComplete = [](const nvfeedback::TileRequest& r,
-                                            const void* tileData, size_t /*tileDataSize*/,
-                                            nvrhi::ICommandList* cmd)
-                    {
-                        SDL_assert(cmd);
-                        SDL_assert(r.m_ReservedTexture);
-
-                        const nvrhi::FormatInfo& fi = nvrhi::getFormatInfo(r.m_Format);
-                        uint32_t tileBlocksW = (r.m_TileWidthInTexels + fi.blockSize - 1) / fi.blockSize;
-                        uint32_t rowPitch    = tileBlocksW * fi.bytesPerBlock;
-
-                        nvrhi::TextureSlice destSlice{};
-                        destSlice.x          = r.m_TileXInTexels;
-                        destSlice.y          = r.m_TileYInTexels;
-                        destSlice.width      = r.m_TileWidthInTexels;
-                        destSlice.height     = r.m_TileHeightInTexels;
-                        destSlice.mipLevel   = r.m_MipLevel;
-                        destSlice.arraySlice = 0;
-
-                        cmd->writeTexture(r.m_ReservedTexture, destSlice, tileData, rowPitch, 0);
-                    };
+            feedbackTex->GetTileInfo(tile.m_TileIndex, tileInfos);
 
-                    m_AsyncTileIO->Submit(std::move(req));
-                }
-
-                submittedTilesThisEntry.push_back(tileIndex);
-                tilesSubmitted++;
-            }
-
-            if (!submittedTilesThisEntry.empty())
+            for (const nvfeedback::FeedbackTextureTileInfo& tileInfo : tileInfos)
             {
-                nvfeedback::FeedbackTextureUpdate submittedUpdate;
-                submittedUpdate.m_TextureIdx = texUpdate.m_TextureIdx;
-                submittedUpdate.m_TileIndices = std::move(submittedTilesThisEntry);
-                submittedThisFrame.push_back(std::move(submittedUpdate));
+                nvfeedback::TileRequest req;
+                req.m_SourceData         = st.m_SourceData;
+                req.m_TiledLayout        = st.m_TiledLayout;
+                req.m_ReservedTexture    = st.m_ReservedTexture;
+                req.m_MipLevel           = tileInfo.m_Mip;
+                req.m_TileXInTexels      = tileInfo.m_XInTexels;
+                req.m_TileYInTexels      = tileInfo.m_YInTexels;
+                req.m_TileWidthInTexels  = tileInfo.m_WidthInTexels;
+                req.m_TileHeightInTexels = tileInfo.m_HeightInTexels;
+                req.m_TextureWidth       = texDesc.width;
+                req.m_TextureHeight      = texDesc.height;
+                std::memcpy(req.m_MipOffsets, st.m_MipDataOffsets, sizeof(st.m_MipDataOffsets));
+                req.m_Format             = texDesc.format;
+                req.m_BytesPerBlock      = fmtInfo.bytesPerBlock;
+                req.m_BlockSize          = fmtInfo.blockSize;
+                req.m_UserTag            = tile.m_TextureIdx;
+
+                m_AsyncTileIO->Submit(std::move(req));
             }
 
-            if (!deferredTilesThisEntry.empty())
+            // Tiles come out in priority order, not grouped by texture
+            const auto submittedEnd = submittedThisFrame.begin() + numSubmittedTextures;
+            auto it = std::find_if(submittedThisFrame.begin(), submittedEnd,
+                [&](const nvfeedback::FeedbackTextureUpdate& u) { return u.m_TextureIdx == tile.m_TextureIdx; });
+            if (it == submittedEnd)
             {
-                nvfeedback::FeedbackTextureUpdate deferred;
-                deferred.m_TextureIdx = texUpdate.m_TextureIdx;
-                deferred.m_TileIndices = std::move(deferredTilesThisEntry);
-                stillPending.push_back(std::move(deferred));
+                if (numSubmittedTextures == submittedThisFrame.size())
+                    submittedThisFrame.emplace_back();
+                it = submittedThisFrame.begin() + numSubmittedTextures++;
+                it->m_TextureIdx = tile.m_TextureIdx;
+                it->m_TileIndices.clear();
             }
+            it->m_TileIndices.push_back(tile.m_TileIndex);
+            tilesSubmitted++;
         }
 
-        m_PendingTileRequests = std::move(stillPending);
+        m_StreamingUploadSeconds += submitTimer.LapSeconds();
     }
 
     m_TilesSubmittedThisFrame = tilesSubmitted;
@@ -886,19 +1455,18 @@ void Renderer::UpdateStreamingPreRender(nvrhi::CommandListHandle cmd)
     // to map the tiles and update the MinMip texture. Calling UpdateTileMappings now
     // (before the data arrives) would cause the MinMip to advertise tiles as resident
     // while they still contain uninitialized data, producing wrong-mip samples.
-    if (!submittedThisFrame.empty())
+    if constexpr (nvfeedback::kStreamingDebugLog)
     {
-        if constexpr (nvfeedback::kStreamingDebugLog)
+        if (numSubmittedTextures > 0)
         {
-            uint32_t totalTiles = 0;
-            for (auto& u : submittedThisFrame) totalTiles += (uint32_t)u.m_TileIndices.size();
-            SDL_Log("[Streaming][PreRender] Phase 5: stashing %zu texture(s), %u tile(s) — "
+            LOG_INFO("[Streaming][PreRender] Phase 5: stashing %u texture(s), %u tile(s) — "
                     "UpdateTileMappings deferred to next frame after Flush()",
-                    submittedThisFrame.size(), totalTiles);
+                    numSubmittedTextures, tilesSubmitted);
         }
-
-        m_SubmittedTilesPendingMapping = std::move(submittedThisFrame);
     }
+
+    std::swap(m_SubmittedTilesPendingMapping, m_SubmittedTilesThisFrame);
+    m_NumTexturesPendingMapping = numSubmittedTextures;
 }
 
 void Renderer::UpdateStreamingPostRender()
@@ -916,6 +1484,38 @@ void Renderer::UpdateStreamingPostRender()
 
     // -- Phase F: EndFrame --
     m_FeedbackManager->EndFrame();
+
+    // -- Phase G: Adapt next frame's budgets --
+    UpdateStreamingBudgets();
+}
+
+void Renderer::UpdateStreamingBudgets()
+{
+    PROFILE_FUNCTION();
+
+    const nvfeedback::AsyncTileIO::IOStats ioStats = m_AsyncTileIO->GetIOStats();
+    const nvfeedback::FeedbackManagerStats& stats  = m_FeedbackManager->GetStats();
+
+    nvfeedback::StreamingFrameSample sample;
+    sample.m_FrameSeconds      = m_FrameTime / 1000.0;
+    // Flushed tiles are the ones whose upload and mapping were recorded; the submit cost
+    // of this frame's tiles is charged to them too (in steady state both counts match)
+    sample.m_UploadSeconds     = m_StreamingUploadSeconds;
+    sample.m_TilesUploaded     = m_TilesFlushedThisFrame;
+    sample.m_ResolveSeconds    = stats.m_CpuTimeResolve;
+    sample.m_TexturesResolved  = std::min(m_FeedbackManager->GetBudgets().m_FeedbackTexturesToResolvePerFrame, m_FeedbackManager->GetNumTextures());
+    sample.m_TilesCompleted    = (uint32_t)(ioStats.m_NumTiles - m_LastIOStats.m_NumTiles);
+    sample.m_WorkerBusySeconds = ioStats.m_BusySeconds - m_LastIOStats.m_BusySeconds;
+    sample.m_LatencySeconds    = ioStats.m_LatencySeconds - m_LastIOStats.m_LatencySeconds;
+    sample.m_NumWorkers        = m_AsyncTileIO->WorkerCount();
+    sample.m_NumTextures       = m_FeedbackManager->GetNumTextures();
+    sample.m_VRAMHeadroomBytes = m_VRAMBudget.GetHeadroomBytes();
+    sample.m_bVRAMPressure     = m_VRAMBudget.IsUnderPressure();
+    m_LastIOStats = ioStats;
+
+    const nvfeedback::StreamingBudgets& budgets = m_StreamingBudgetController.Update(sample);
+    if (Config::Get().m_AdaptiveStreamingBudgets)
+        m_FeedbackManager->SetBudgets(budgets);
 }
 
 void Renderer::UploadDirtyInstanceTransforms()
@@ -969,6 +1569,10 @@ void Renderer::UploadDirtyInstanceTransforms()
             startIdx * sizeof(nvrhi::rt::InstanceDesc));
     }
 
+    // Keep the prefetcher's instance bounds in step with the animated transforms
+    for (uint32_t i = startIdx; i < startIdx + count && i < (uint32_t)m_PrefetchScene.m_Instances.size(); ++i)
+        m_PrefetchScene.m_Instances[i] = GetPrefetchInstance(m_Scene.m_InstanceData[i]);
+
     // Always reset after upload so the range never persists into the next frame.
     m_Scene.m_InstanceDirtyRange = { UINT32_MAX, 0 };
 
@@ -1215,6 +1819,60 @@ void Renderer::ComputeCascadeViewProj()
     }
 }
 
+void Renderer::UpdateLightClusters()
+{
+    PROFILE_FUNCTION();
+
+    m_bLightClustersValid = false;
+
+    // IBL, the path tracer and ReSTIR DI light the scene without the deferred pass's light loop
+    const bool bDeferredDirectLighting = (m_Mode == RenderingMode::Normal || m_Mode == RenderingMode::NormalBasic) && !m_EnableReSTIRDI;
+    if (!m_EnableClusteredLighting || !bDeferredDirectLighting || m_Scene.m_GPULights.empty())
+        return;
+
+    // Unjittered: the deferred pass finds a pixel's cluster from its view-space position
+    const Matrix& viewToClip = m_Scene.m_View.m_MatViewToClipNoOffset;
+    LightClusterView clusterView;
+    clusterView.m_WorldToView = m_Scene.m_View.m_MatWorldToView;
+    clusterView.m_TanHalfFovX = 1.0f / viewToClip._11;
+    clusterView.m_TanHalfFovY = 1.0f / viewToClip._22;
+    clusterView.m_NearZ = viewToClip._43; // infinite reversed-Z: _43 is the near plane
+
+    SimpleTimer timer;
+    m_LightClusterBinner.Bin(m_Scene.m_GPULights, clusterView, *m_TaskScheduler);
+    m_LightClusterBinMs = timer.TotalMilliseconds();
+
+    const std::vector<LightClusterBinner::ClusterRange>& clusters = m_LightClusterBinner.GetClusters();
+    const std::vector<uint32_t>& indices = m_LightClusterBinner.GetLightIndices();
+
+    // Grow-only, with headroom, so an index count moving with the camera does not reallocate every frame
+    auto EnsureBuffer = [this](nvrhi::BufferHandle& buffer, uint64_t byteSize, uint32_t stride, const char* debugName)
+    {
+        if (buffer && buffer->getDesc().byteSize >= byteSize)
+            return;
+
+        nvrhi::BufferDesc desc;
+        desc.byteSize = std::max<uint64_t>(byteSize + byteSize / 2, stride);
+        desc.structStride = stride;
+        desc.debugName = debugName;
+        desc.initialState = nvrhi::ResourceStates::ShaderResource;
+        desc.keepInitialState = true;
+        buffer = m_RHI->m_NvrhiDevice->createBuffer(desc);
+    };
+    EnsureBuffer(m_LightClusterBuffer, clusters.size() * sizeof(LightClusterBinner::ClusterRange), sizeof(LightClusterBinner::ClusterRange), "LightClusters");
+    EnsureBuffer(m_LightClusterIndexBuffer, indices.size() * sizeof(uint32_t), sizeof(uint32_t), "LightClusterIndices");
+
+    nvrhi::CommandListHandle cmd = AcquireCommandList();
+    ScopedCommandList scopedCmd{ cmd, "Light Cluster Upload" };
+    scopedCmd->writeBuffer(m_LightClusterBuffer, clusters.data(), clusters.size() * sizeof(LightClusterBinner::ClusterRange));
+    if (!indices.empty())
+    {
+        scopedCmd->writeBuffer(m_LightClusterIndexBuffer, indices.data(), indices.size() * sizeof(uint32_t));
+    }
+
+    m_bLightClustersValid = true;
+}
+
 void Renderer::ScheduleAndRunAllRenderers()
 {
     PROFILE_FUNCTION();
@@ -1228,45 +1886,45 @@ void Renderer::ScheduleAndRunAllRenderers()
 
     m_RenderGraph.BeginSetup();
 
-    m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("ClearRenderer"));
+    m_RenderGraph.ScheduleRenderer(GET_RENDERER(ClearRenderer));
 
     if (m_Mode == RenderingMode::ReferencePathTracer)
     {
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("PathTracerRenderer"));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(PathTracerRenderer));
     }
     else if (m_Mode == RenderingMode::NormalBasic)
     {
         // NormalBasic: raster-only pipeline: no TLAS, no RTXDI, no SHARC, no RT shadows
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("OpaqueRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("MaskedPassRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("HZBGeneratorPhase2"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("ShadowRenderer"));        // CSM depth array (4 × 2048²)
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("ShadowMaskRenderer"));    // fullscreen compute → R8 shadow mask
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("CSMDebugRenderer"));      // debug overlay (skips when mode == Off)
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("DeferredRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("SkyRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("TransparentPassRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("TAARenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("BloomRenderer"));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(OpaqueRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(MaskedPassRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(HZBGeneratorPhase2));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(ShadowRenderer));        // CSM depth array (4 × 2048²)
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(ShadowMaskRenderer));    // fullscreen compute → R8 shadow mask
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(CSMDebugRenderer));      // debug overlay (skips when mode == Off)
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(DeferredRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(SkyRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(TransparentPassRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(TAARenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(BloomRenderer));
     }
     else
     {
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("OpaqueRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("MaskedPassRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("HZBGeneratorPhase2"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("TLASRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("SHARCRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("RTXDIRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("DeferredRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("SkyRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("TransparentPassRenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("TAARenderer"));
-        m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("BloomRenderer"));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(OpaqueRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(MaskedPassRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(HZBGeneratorPhase2));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(TLASRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(SHARCRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(RTXDIRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(DeferredRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(SkyRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(TransparentPassRenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(TAARenderer));
+        m_RenderGraph.ScheduleRenderer(GET_RENDERER(BloomRenderer));
     }
 
-    m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("HDRRenderer"));
-    m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("TileResidencyDebugRenderer"));
-    m_RenderGraph.ScheduleRenderer(RendererRegistry::GetRenderer("ImGuiRenderer"));
+    m_RenderGraph.ScheduleRenderer(GET_RENDERER(HDRRenderer));
+    m_RenderGraph.ScheduleRenderer(GET_RENDERER(TileResidencyDebugRenderer));
+    m_RenderGraph.ScheduleRenderer(GET_RENDERER(ImGuiRenderer));
 
     m_RenderGraph.EndSetup();
 
@@ -1995,6 +2653,21 @@ void Renderer::GenerateMipsUsingSPD(nvrhi::TextureHandle texture, nvrhi::BufferH
 nvrhi::CommandListHandle Renderer::AcquireCommandList(bool bImmediatelyQueue)
 {
     PROFILE_FUNCTION();
+
+    // Recorded for a later submission by their owner (AsyncSceneLoader), off the main thread
+    if (std::vector<nvrhi::CommandListHandle>* sink = GetCommandListSinkForCurrentThread())
+    {
+        const nvrhi::CommandListParameters params{ .enableImmediateExecution = false, .queueType = nvrhi::CommandQueue::Graphics };
+        nvrhi::CommandListHandle handle = m_RHI->m_NvrhiDevice->createCommandList(params);
+        SDL_assert(handle && "Failed to create command list");
+
+        if (bImmediatelyQueue)
+        {
+            sink->push_back(handle);
+        }
+        return handle;
+    }
+
     SINGLE_THREAD_GUARD();
 
     nvrhi::CommandListHandle handle;
@@ -2062,7 +2735,7 @@ void Renderer::ExecutePendingCommandLists()
         }
         else
         {
-            std::vector<nvrhi::ICommandList*> rawLists;
+            std::pmr::vector<nvrhi::ICommandList*> rawLists{ &m_FrameAllocator };
             rawLists.reserve(m_PendingCommandLists.size());
             for (const nvrhi::CommandListHandle& handle : m_PendingCommandLists)
             {
@@ -2089,6 +2762,12 @@ MicroProfileThreadLogGpu*& Renderer::GetGPULogForCurrentThread()
     return tl_GPULog;
 }
 
+std::vector<nvrhi::CommandListHandle>*& Renderer::GetCommandListSinkForCurrentThread()
+{
+    thread_local std::vector<nvrhi::CommandListHandle>* tl_CommandListSink = nullptr;
+    return tl_CommandListSink;
+}
+
 nvrhi::BindingSetDesc Renderer::CreateBindingSetDesc(std::span<const srrhi::ResourceEntry> resources, uint32_t pushConstantBytes)
 {
     auto SRRHIDimensionToNVRHIDimension = [](srrhi::TextureDimension dim)
@@ -2268,11 +2947,40 @@ ScopedCommandList::~ScopedCommandList()
     tl_bScopedCommandListActive = false;
 }
 
+// Logger console output: the SDL log, so records show up alongside SDL's own messages.
+static void WriteLogToSDL(Log::Level level, const char* text)
+{
+    SDL_LogPriority priority = SDL_LOG_PRIORITY_INFO;
+    switch (level)
+    {
+    case Log::Level::Verbose: priority = SDL_LOG_PRIORITY_VERBOSE; break;
+    case Log::Level::Warn:    priority = SDL_LOG_PRIORITY_WARN;    break;
+    case Log::Level::Error:   priority = SDL_LOG_PRIORITY_ERROR;   break;
+    default:                  break;
+    }
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, priority, "%s", text);
+}
+
+#if HOBBY_RENDERER_ENGINE_TESTS
+int RunTestCases(int argc, char* argv[]); // tests/TestRunner.cpp
+int RunLightBinningBench(int argc, char* argv[]); // bench/LightBinningBench.cpp
+int RunRayQueryBench(int argc, char* argv[]); // bench/RayQueryBench.cpp
+#endif
+
 int main(int argc, char* argv[])
 {
-    // -----------------------------------------------------------------------
-    // Normal renderer mode
-    // -----------------------------------------------------------------------
+#if HOBBY_RENDERER_ENGINE_TESTS
+    // Engine test groups and benchmarks (see CMakeLists.txt): no window, no device
+    if (argc > 1 && std::strcmp(argv[1], "--run-tests") == 0)
+        return RunTestCases(argc - 1, argv + 1);
+    if (argc > 1 && std::strcmp(argv[1], "--bench-light-binning") == 0)
+        return RunLightBinningBench(argc - 1, argv + 1);
+    if (argc > 1 && std::strcmp(argv[1], "--bench-ray-query") == 0)
+        return RunRayQueryBench(argc - 1, argv + 1);
+#endif
+
+    Log::SetConsoleOutput(&WriteLogToSDL);
+
     Renderer renderer{};
     Config::ParseCommandLine(argc, argv);
 
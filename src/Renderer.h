@@ -1,18 +1,25 @@
 ﻿#pragma once
 
+#include "AsyncSceneLoader.h"
 #include "Camera.h"
 #include "CameraStateManager.h"
+#include "FrameCapture.h"
+#include "VRAMBudget.h"
 #include "GraphicRHI.h"
+#include "LightClusterBinner.h"
 #include "RenderGraph.h"
 #include "Scene.h"
 #include "srrhi.h"
 #include "TaskScheduler.h"
+#include "Utilities.h"
 
 #include "shaders/ShaderIDs.h"
 
 // Streaming
 #include "Streaming/FeedbackManager.h"
 #include "Streaming/AsyncTileIO.h"
+#include "Streaming/GeometryStreamer.h"
+#include "Streaming/SceneCellStreamer.h"
 
 class IRenderer
 {
@@ -37,11 +44,16 @@ public:
     bool m_bClearOnNextRender = false;
 };
 
+// Interned renderer name: index into RendererRegistry's creator list.
+using RendererID = uint32_t;
+
 class RendererRegistry
 {
 public:
     using Creator = std::function<std::shared_ptr<IRenderer>()>;
 
+    static constexpr RendererID kInvalidRendererID = UINT32_MAX;
+
     static void RegisterRenderer(const char* name, Creator creator)
     {
         s_Creators.push_back({ name, creator });
@@ -52,24 +64,50 @@ public:
         return s_Creators;
     }
 
+    // Resolve a renderer name to its ID.  Linear scan — resolve once and cache
+    // (see GET_RENDERER) rather than calling this per frame.
+    static RendererID GetRendererID(const char* name)
+    {
+        for (RendererID id = 0; id < (RendererID)s_Creators.size(); ++id)
+        {
+            if (std::strcmp(s_Creators[id].first, name) == 0)
+                return id;
+        }
+        SDL_LOG_ASSERT_FAIL("Unknown renderer", "[RendererRegistry] Unknown renderer '%s'", name);
+        return kInvalidRendererID;
+    }
+
     // Thread-safe after static init: renderers are created during InitializeGPUStack
     // and looked up during ScheduleAndRunAllRenderers (both on main thread).
+    static IRenderer* GetRenderer(RendererID id)
+    {
+        SDL_assert(id < s_Renderers.size() && s_Renderers[id] && "Renderer not created");
+        return s_Renderers[id];
+    }
+
     static IRenderer* GetRenderer(const char* name)
     {
-        return s_Renderers.at(name); // Throws if not found
+        return GetRenderer(GetRendererID(name));
     }
 
     static void SetRenderer(const char* name, IRenderer* renderer)
     {
-        SDL_assert(s_Renderers.contains(name) == false && "Renderer already registered");
-        s_Renderers[name] = renderer;
+        const RendererID id = GetRendererID(name);
+        s_Renderers.resize(s_Creators.size(), nullptr);
+        SDL_assert(s_Renderers[id] == nullptr && "Renderer already registered");
+        s_Renderers[id] = renderer;
     }
 
 private:
     inline static std::vector<std::pair<const char*, Creator>> s_Creators;
-    inline static std::unordered_map<std::string, IRenderer*>  s_Renderers;
+    inline static std::vector<IRenderer*>                      s_Renderers; // indexed by RendererID
 };
 
+// Per-frame renderer lookup: the name is interned to a RendererID once per call
+// site (function-local static), after which the lookup is a vector index.
+#define GET_RENDERER(ClassName) \
+    RendererRegistry::GetRenderer([]() { static const RendererID s_ID = RendererRegistry::GetRendererID(#ClassName); return s_ID; }())
+
 // Macro to register a renderer class.
 // No longer creates cross-TU global pointers — renderers are stored in
 // RendererRegistry and looked up by name.  This eliminates incremental-linker
@@ -92,6 +130,8 @@ public:
     void Shutdown();
     void ProcessEvent(const SDL_Event& event);
     void UpdateFrame();
+    // Loading screen UI while the scene loads in the background (touches no scene state)
+    void UpdateLoadingFrame();
 };
 
 enum class RenderingMode : uint32_t
@@ -139,6 +179,10 @@ struct Renderer
     // Called once per frame before ScheduleAndRunAllRenderers() so all renderers see up-to-date splits.
     void ComputeCSMCascadeSplits();
     void ComputeCascadeViewProj();
+    // Bins the scene lights into m_LightClusterBinner and uploads the cluster and index buffers
+    // when the deferred pass shades the direct lights itself (Normal / NormalBasic without
+    // ReSTIR DI).  Called once per frame after the camera update, before ScheduleAndRunAllRenderers().
+    void UpdateLightClusters();
     void HandleDebugModeSettings();
 
     // Command List Management
@@ -147,7 +191,6 @@ struct Renderer
 
     // Swapchain / Backbuffer
     nvrhi::TextureHandle GetCurrentBackBufferTexture() const;
-    void SaveBackBufferScreenshot();
 
     // Binding Layouts & Pipelines
     nvrhi::BindingLayoutHandle GetOrCreateBindingLayoutFromBindingSetDesc(const nvrhi::BindingSetDesc& setDesc, uint32_t registerSpace = 0);
@@ -224,6 +267,11 @@ struct Renderer
 
     static MicroProfileThreadLogGpu*& GetGPULogForCurrentThread();
 
+    // Set on a thread recording work for a later submission (AsyncSceneLoader): there,
+    // AcquireCommandList creates fresh command lists and queues them to the sink instead
+    // of m_PendingCommandLists, which belong to the main loop.
+    static std::vector<nvrhi::CommandListHandle>*& GetCommandListSinkForCurrentThread();
+
     static nvrhi::BindingSetDesc CreateBindingSetDesc(std::span<const srrhi::ResourceEntry> resources, uint32_t pushConstantBytes = 0);
 
     template<typename SrInput>
@@ -251,12 +299,44 @@ struct Renderer
     // Scene
     Scene m_Scene;
 
+    // Loads the scene in the background at startup; m_Scene stays empty until UpdateSceneLoad
+    // swaps the loaded scene in, and Run() draws only the loading screen until then.
+    static constexpr uint32_t kLoadingScreenFPS = 60; // leaves the cores to the load
+    AsyncSceneLoader m_SceneLoader;
+    nvrhi::CommandListHandle m_LoadingScreenCommandList;
+    nvrhi::EventQueryHandle  m_LoadingScreenQuery; // last loading screen frame's GPU work
+
     // Camera state persistence (periodic save + restore on load)
     CameraStateManager m_CameraStateManager;
 
+    // Screenshot / image sequence capture (ring-buffered readback, async encode)
+    FrameCapture m_FrameCapture;
+
+    // Arbitrates the VRAM budget between streaming tile heaps, streamed geometry, BLAS LODs,
+    // render graph heaps and scene buffers
+    VRAMBudgetGovernor m_VRAMBudget;
+    VRAMBudgetGovernor::SubsystemID m_VRAMStreamingID    = VRAMBudgetGovernor::kInvalidSubsystem;
+    VRAMBudgetGovernor::SubsystemID m_VRAMGeometryLODsID = VRAMBudgetGovernor::kInvalidSubsystem;
+    VRAMBudgetGovernor::SubsystemID m_VRAMSceneCellsID   = VRAMBudgetGovernor::kInvalidSubsystem;
+    VRAMBudgetGovernor::SubsystemID m_VRAMBLASID         = VRAMBudgetGovernor::kInvalidSubsystem;
+    VRAMBudgetGovernor::SubsystemID m_VRAMRenderGraphID  = VRAMBudgetGovernor::kInvalidSubsystem;
+    VRAMBudgetGovernor::SubsystemID m_VRAMSceneBuffersID = VRAMBudgetGovernor::kInvalidSubsystem;
+    uint64_t m_SceneBufferBytes = 0;
+
     // Renderers
     std::vector<std::shared_ptr<IRenderer>> m_Renderers;
 
+    // Per-frame scratch memory (std::pmr containers), rewound at the top of every frame.
+    // Anything allocated from it must not outlive the frame.
+    LinearAllocator m_FrameAllocator{ 4 * 1024 * 1024 };
+
+    // Global operator new calls during the last frame (needs ENABLE_ALLOCATION_COUNTING,
+    // on in debug builds).  Debug builds assert that frames after the warm-up stay
+    // within the budget: ImGui windows and the odd new resource, no per-frame containers.
+    uint64_t m_HeapAllocationsLastFrame = 0;
+    static constexpr uint32_t kAllocationWarmUpFrames     = 300;
+    static constexpr uint64_t kMaxHeapAllocationsPerFrame = 64;
+
     // Performance metrics
     double m_FrameTime = 0.0;
     double m_FPS       = 0.0;
@@ -295,6 +375,14 @@ struct Renderer
     bool m_EnableReSTIRDI = true;
     bool m_EnableReSTIRDenoising = true;
 
+    // Clustered direct lighting in the deferred pass (see UpdateLightClusters)
+    bool                m_EnableClusteredLighting = false;
+    bool                m_bLightClustersValid = false; // binned and uploaded this frame
+    double              m_LightClusterBinMs = 0.0;
+    LightClusterBinner  m_LightClusterBinner;
+    nvrhi::BufferHandle m_LightClusterBuffer;           // uint2 { offset, count } per cluster
+    nvrhi::BufferHandle m_LightClusterIndexBuffer;      // global lights, then the cluster lists
+
     // Indirect lighting technique (mutually exclusive: 0=None, 1=RestirGI, 2=SHARC, 3=RestirGI+SHARC)
     uint32_t m_IndirectLightingTechnique = 3;
 
@@ -356,22 +444,51 @@ struct Renderer
 
     std::unique_ptr<nvfeedback::FeedbackManager> m_FeedbackManager;
     
-    std::unique_ptr<nvfeedback::AsyncTileIO> m_AsyncTileIO; // Async tile I/O thread pool
+    std::unique_ptr<nvfeedback::AsyncTileIO> m_AsyncTileIO; // Async tile I/O on the TaskScheduler I/O lane
 
     // Tiles submitted to AsyncTileIO this frame — their UpdateTileMappings and MinMip
     // update is deferred to the NEXT frame, after Flush() confirms the tile data has
-    // been written to the GPU.
+    // been written to the GPU.  Only the first m_NumTexturesPendingMapping entries are
+    // live; the two lists swap every frame and keep their entries, so steady-state
+    // frames reuse the tile index storage.
     std::vector<nvfeedback::FeedbackTextureUpdate> m_SubmittedTilesPendingMapping;
-
-    // Tile requests that exceeded the per-frame budget (kMaxTilesPerFrame) and were
-    // deferred to the next frame.  Drained before new requests each frame.
-    std::vector<nvfeedback::FeedbackTextureUpdate> m_PendingTileRequests;
+    std::vector<nvfeedback::FeedbackTextureUpdate> m_SubmittedTilesThisFrame;
+    uint32_t m_NumTexturesPendingMapping = 0;
 
     // Count of tile indices actually submitted to AsyncTileIO this frame (for UI/debug).
     uint32_t m_TilesSubmittedThisFrame = 0;
 
+    // Adapts FeedbackManager's StreamingBudgets every frame (unless --fixed-streaming-budgets).
+    // Fed with the main-thread cost of the tile flush, mappings and submit measured in
+    // UpdateStreamingPreRender and the AsyncTileIO stats delta since m_LastIOStats.
+    nvfeedback::StreamingBudgetController m_StreamingBudgetController;
+    nvfeedback::AsyncTileIO::IOStats      m_LastIOStats;
+    double   m_StreamingUploadSeconds = 0.0;
+    uint32_t m_TilesFlushedThisFrame  = 0;
+
+    // Bytes read per flushed tile, handed to FeedbackManager's per-texture stats
+    std::vector<nvfeedback::AsyncTileIO::CompletedTileRead> m_CompletedTileReads;
+    SimpleTimer m_StreamingSessionTimer; // started by InitStreaming, for the stats export
+
     int m_TileResidencyDebugTextureIdx = -1; // -1 = disabled, 0..N = selected feedback texture index
 
+    // Camera-motion tile prefetch: m_PrefetchScene mirrors the streamed textures (FeedbackManager
+    // order), materials and instance bounds; m_TilePrefetcher extrapolates the camera over it.
+    nvfeedback::TilePrefetcher          m_TilePrefetcher;
+    nvfeedback::PrefetchScene           m_PrefetchScene;
+    std::vector<uint8_t>                m_PrefetchMips;
+    std::vector<nvfeedback::CameraPose> m_RecordedCameraPath; // --record-camera-path
+
+    // Mesh LOD streaming from the cooked mesh cache (null with --disable-geometry-streaming
+    // or when the scene has no cache).  Created before scene load and owned by
+    // m_SceneLoader until the swap; Scene::LoadScene initializes it.
+    std::unique_ptr<nvfeedback::GeometryStreamer> m_GeometryStreamer;
+
+    // Model streaming for JSON scenes with a "cellStreaming" object (null otherwise, or with
+    // --disable-scene-cell-streaming).  Created before scene load and owned by
+    // m_SceneLoader until the swap; Scene::LoadScene initializes it.
+    std::unique_ptr<nvfeedback::SceneCellStreamer> m_SceneCellStreamer;
+
     // Initialise the FeedbackManager after scene load.
     void InitStreaming();
     // Shutdown streaming resources.
@@ -379,9 +496,39 @@ struct Renderer
     // Pre-render streaming update: flush async uploads, BeginFrame, tile submit, UpdateTileMappings.
     // Call BEFORE ScheduleAndRunAllRenderers().
     void UpdateStreamingPreRender(nvrhi::CommandListHandle cmd);
-    // Post-render streaming update: ResolveFeedback + EndFrame.
+    // Builds m_PrefetchScene (texel densities from the cooked geometry) and runs --prefetch-replay.
+    // Call after scene load.
+    void InitTilePrefetch();
+    // Feeds the camera to the prefetcher and hands its prediction to the FeedbackManager.
+    // Main thread, before the streaming pre-render task is scheduled.
+    void UpdateTilePrefetch();
+    // Post-render streaming update: ResolveFeedback + EndFrame + budget adaptation.
     // Call AFTER ScheduleAndRunAllRenderers() so the GBuffer pass has written sampler feedback.
     void UpdateStreamingPostRender();
+    // Feeds this frame's streaming costs to m_StreamingBudgetController and applies its budgets.
+    void UpdateStreamingBudgets();
+    // Logs the worst-streaming textures and writes every texture's streaming stats to filePath (JSON).
+    bool ReportTextureStreamingStats(const std::filesystem::path& filePath);
+
+    // Advances m_SceneLoader and, once the loaded scene's GPU work is done, moves it into
+    // m_Scene and runs OnSceneLoaded.  Main thread, top of the frame.  Returns true once
+    // m_Scene is ready to render.
+    bool UpdateSceneLoad();
+    // Scene-dependent initialization, right after the loaded scene is swapped in.
+    void OnSceneLoaded();
+    // Clears the back buffer, draws the loading screen UI and presents.  Skips the frame
+    // while the previous one is still on the GPU, so it never waits on the scene uploads.
+    void RenderLoadingScreen();
+    // --validate-rt-inputs: checks the BLAS/TLAS inputs against the cooked geometry, then
+    // builds a CPUSceneRayQuery and traces a grid of camera rays through it.  After scene load.
+    void ValidateRTInputs();
+
+    // Registers the VRAM budget subsystems.  Call after the scene and streaming are initialized.
+    void InitVRAMBudget();
+    // Reports footprints and runs the budget policy.  Main thread, before the streaming
+    // pre-render task is scheduled and before the geometry streamers update (reclaim callbacks
+    // touch FeedbackManager, the streamers and the BLASes).
+    void UpdateVRAMBudget();
 
     // Internal State
     std::vector<nvrhi::CommandListHandle> m_CommandListFreeList;
@@ -5,8 +5,12 @@
 #include "Renderer.h"
 #include "CommonResources.h"
 #include "Utilities.h"
+#include "Log.h"
+#include "ProcessMemory.h"
+#include "Streaming/GeometryStreamer.h"
+#include "Streaming/SceneCellStreamer.h"
 
-void Scene::LoadScene()
+void Scene::LoadScene(nvfeedback::GeometryStreamer* geometryStreamer, nvfeedback::SceneCellStreamer* cellStreamer)
 {
 	const std::string& scenePath = Config::Get().m_ScenePath;
 	if (scenePath.empty())
@@ -52,18 +56,77 @@ void Scene::LoadScene()
 
 	SceneLoader::LoadTexturesFromImages(*this, sceneDir);
 	SceneLoader::UpdateMaterialsAndCreateConstants(*this);
+
+	// Cell streaming loads the models of a partitioned JSON scene by camera distance;
+	// geometry streaming keeps only the coarse LODs of allIndices and the meshlet arrays
+	if (!m_StreamedModels.empty())
+	{
+		SDL_assert(cellStreamer && "LoadJSONScene only streams models with a SceneCellStreamer");
+		cellStreamer->Init(*this, allVerticesQuantized, allIndices);
+	}
+	else if (!geometryStreamer || !geometryStreamer->Init(*this, allIndices))
+	{
+		m_GPUMeshData = m_MeshData;
+	}
+
 	SceneLoader::CreateAndUploadGpuBuffers(*this, allVerticesQuantized, allIndices);
+
+	// writeBuffer copies into upload memory, so the vertex/index streams are dead from here on
+	std::vector<srrhi::VertexQuantized>().swap(allVerticesQuantized);
+	std::vector<uint32_t>().swap(allIndices);
+
 	SceneLoader::CreateAndUploadLightBuffer(*this);
 	BuildAccelerationStructures();
 
+	if (!Config::Get().m_KeepCPUGeometry)
+	{
+		ReleaseCPUGeometry();
+	}
+
+	// Renderer::OnSceneLoaded points the view camera at m_Cameras[0]: this scene is not
+	// g_Renderer.m_Scene yet
 	if (!m_Cameras.empty())
 	{
-		const Scene::Camera& firstCam = m_Cameras[0];
-		g_Renderer.SetCameraFromSceneCamera(firstCam);
 		m_SelectedCameraIndex = 0;
 	}
 }
 
+size_t Scene::ReleaseCPUGeometry()
+{
+	if (!m_bCPUGeometryResident)
+		return 0;
+
+	// Only drop what can be brought back: scenes without a cooked cache keep their copies
+	if (m_CookedMeshCachePath.empty())
+	{
+		LOG_INFO("[Scene] No cooked mesh cache, keeping CPU geometry resident");
+		return 0;
+	}
+
+	const size_t residentBefore = GetProcessResidentBytes();
+	const size_t releasedBytes =
+		m_Meshlets.capacity() * sizeof(srrhi::Meshlet) +
+		m_MeshletVertices.capacity() * sizeof(uint32_t) +
+		m_MeshletTriangles.capacity() * sizeof(uint32_t);
+
+	std::vector<srrhi::Meshlet>().swap(m_Meshlets);
+	std::vector<uint32_t>().swap(m_MeshletVertices);
+	std::vector<uint32_t>().swap(m_MeshletTriangles);
+	m_bCPUGeometryResident = false;
+
+	LOG_INFO("[Scene] Released CPU geometry copies: %.2f MB, resident set %.2f MB -> %.2f MB", BYTES_TO_MB(releasedBytes),
+		BYTES_TO_MB(residentBefore), BYTES_TO_MB(GetProcessResidentBytes()));
+	return releasedBytes;
+}
+
+bool Scene::MapCPUGeometry(CPUGeometryView& outView) const
+{
+	if (m_CookedMeshCachePath.empty())
+		return false;
+
+	return SceneCache::MapCookedMesh(m_CookedMeshCachePath, outView);
+}
+
 void Scene::BuildAccelerationStructures()
 {
 	//SCOPED_TIMER("[Scene] Build Accel Structs");
@@ -77,6 +140,7 @@ void Scene::BuildAccelerationStructures()
 
 	// 1. Build one BLAS per LOD level per primitive
 	uint64_t totalBLASMemoryBytes = 0;
+	uint64_t minimumBLASMemoryBytes = 0;
 	for (Mesh& mesh : m_Meshes)
 	{
 		for (Primitive& primitive : mesh.m_Primitives)
@@ -92,35 +156,25 @@ void Scene::BuildAccelerationStructures()
 
 			for (uint32_t lod = 0; lod < lodCount; ++lod)
 			{
-				nvrhi::rt::GeometryDesc geometryDesc;
-				nvrhi::rt::GeometryTriangles& geometryTriangle = geometryDesc.geometryData.triangles;
-				geometryTriangle.indexBuffer = m_IndexBuffer;
-				geometryTriangle.vertexBuffer = m_VertexBufferQuantized;
-				geometryTriangle.indexFormat = nvrhi::Format::R32_UINT;
-				geometryTriangle.vertexFormat = nvrhi::Format::RGB32_FLOAT;
-				geometryTriangle.indexOffset = meshData.m_IndexOffsets[lod] * nvrhi::getFormatInfo(geometryTriangle.indexFormat).bytesPerBlock;
-				geometryTriangle.vertexOffset = 0; // Indices are already global relative to the start of the vertex buffer
-				geometryTriangle.indexCount = meshData.m_IndexCounts[lod];
-				geometryTriangle.vertexCount = primitive.m_VertexCount;
-				geometryTriangle.vertexStride = sizeof(srrhi::VertexQuantized);
-
-				geometryDesc.flags = nvrhi::rt::GeometryFlags::None; // can't be opaque since we have alpha tested materials that can be applied to this mesh
-				geometryDesc.geometryType = nvrhi::rt::GeometryType::Triangles;
-
-				nvrhi::rt::AccelStructDesc blasDesc;
-				blasDesc.bottomLevelGeometries = { geometryDesc };
-				blasDesc.debugName = (std::string("BLAS_LOD") + std::to_string(lod)).c_str();
-				blasDesc.buildFlags = nvrhi::rt::AccelStructBuildFlags::PreferFastTrace;
-
-				primitive.m_BLAS[lod] = device->createAccelStruct(blasDesc);
-				nvrhi::utils::BuildBottomLevelAccelStruct(scopedCmd, primitive.m_BLAS[lod], blasDesc);
+				// Streamed LODs get their BLAS when their geometry arrives
+				if (!(primitive.m_ResidentLODMask & (1u << lod)))
+					continue;
 
 				// Accumulate memory for logging (Req 7)
-				totalBLASMemoryBytes += device->getAccelStructMemoryRequirements(primitive.m_BLAS[lod]).size;
+				const uint64_t blasBytes = BuildPrimitiveBLAS(scopedCmd, primitive, lod);
+				totalBLASMemoryBytes += blasBytes;
+
+				// The coarsest LOD is never dropped under VRAM pressure
+				if (lod == lodCount - 1)
+					minimumBLASMemoryBytes += blasBytes;
 			}
 		}
 	}
 
+	m_BLASMemoryBytes = totalBLASMemoryBytes;
+	m_BLASMinimumBytes = minimumBLASMemoryBytes;
+	m_BLASMinLOD = 0;
+
 	//SDL_Log("[Scene] Total BLAS memory across all LODs: %.2f MB", totalBLASMemoryBytes / (1024.0 * 1024.0));
 
 	// 2. Build TLAS for the scene
@@ -154,8 +208,9 @@ void Scene::BuildAccelerationStructures()
         instanceDesc.instanceMask = 1;
         instanceDesc.instanceContributionToHitGroupIndex = 0;
         instanceDesc.flags = instanceFlags;
-        // Default to LOD 0 BLAS; TLASPatch_CS will overwrite with the correct LOD address each frame.
-        instanceDesc.blasDeviceAddress = primitive->m_BLAS[0]->getDeviceAddress();
+        // Default to the LOD 0 BLAS (or its stand-in); TLASPatch_CS will overwrite with the correct LOD address each frame.
+        // Instances of unloaded models stay inactive (null BLAS) until SceneCellStreamer loads them.
+        instanceDesc.blasDeviceAddress = primitive->m_ResidentLODMask != 0 ? primitive->m_BLAS[nvfeedback::GetStandInLOD(primitive->m_ResidentLODMask, 0)]->getDeviceAddress() : 0;
     }
 
     // Create RT instance desc buffer
@@ -178,41 +233,197 @@ void Scene::BuildAccelerationStructures()
     }
 
     // 3. Build the flat BLAS address buffer: blasAddresses[instanceIndex * srrhi::CommonConsts::MAX_LOD_COUNT + lodIndex]
-    //    This is uploaded once at scene load and read by TLASPatch_CS each frame.
+    //    This is uploaded at scene load (and again when BLAS LODs are dropped/restored) and read by TLASPatch_CS each frame.
     {
-        const uint32_t numInstances = (uint32_t)m_InstanceData.size();
-        const uint32_t totalEntries = numInstances * srrhi::CommonConsts::MAX_LOD_COUNT;
-        std::vector<uint64_t> blasAddresses(totalEntries, 0);
-
-        for (uint32_t instanceID = 0; instanceID < numInstances; ++instanceID)
-        {
-            const srrhi::PerInstanceData& instData = m_InstanceData[instanceID];
-            Primitive* primitive = meshDataToPrimitive.at(instData.m_MeshDataIndex);
-            const uint32_t lodCount = (uint32_t)primitive->m_BLAS.size();
-
-            for (uint32_t lod = 0; lod < srrhi::CommonConsts::MAX_LOD_COUNT; ++lod)
-            {
-                // Clamp to highest available LOD to avoid null/invalid addresses (Req 2 AC3)
-                const uint32_t clampedLod = (lod < lodCount) ? lod : (lodCount - 1);
-                blasAddresses[instanceID * srrhi::CommonConsts::MAX_LOD_COUNT + lod] = primitive->m_BLAS[clampedLod]->getDeviceAddress();
-            }
-        }
-
         nvrhi::BufferDesc blasAddrDesc;
-        blasAddrDesc.byteSize = totalEntries * sizeof(uint64_t);
+        blasAddrDesc.byteSize = std::max<uint64_t>(1, m_InstanceData.size()) * srrhi::CommonConsts::MAX_LOD_COUNT * sizeof(uint64_t);
         blasAddrDesc.structStride = sizeof(uint64_t);
         blasAddrDesc.debugName = "BLASAddressBuffer";
         blasAddrDesc.initialState = nvrhi::ResourceStates::ShaderResource;
         blasAddrDesc.keepInitialState = true;
         m_BLASAddressBuffer = device->createBuffer(blasAddrDesc);
 
-        if (totalEntries > 0)
-        {
-            scopedCmd->writeBuffer(m_BLASAddressBuffer, blasAddresses.data(), blasAddrDesc.byteSize);
-        }
+        UploadBLASAddresses(scopedCmd);
     }
 }
 
+nvrhi::rt::GeometryDesc Scene::GetBLASGeometryDesc(const Primitive& primitive, uint32_t lod) const
+{
+	const srrhi::MeshData& meshData = m_GPUMeshData[primitive.m_MeshDataIndex];
+
+	nvrhi::rt::GeometryDesc geometryDesc;
+	nvrhi::rt::GeometryTriangles& geometryTriangle = geometryDesc.geometryData.triangles;
+	geometryTriangle.indexBuffer = m_IndexBuffer;
+	geometryTriangle.vertexBuffer = m_VertexBufferQuantized;
+	geometryTriangle.indexFormat = nvrhi::Format::R32_UINT;
+	geometryTriangle.vertexFormat = nvrhi::Format::RGB32_FLOAT;
+	geometryTriangle.indexOffset = meshData.m_IndexOffsets[lod] * nvrhi::getFormatInfo(geometryTriangle.indexFormat).bytesPerBlock;
+	geometryTriangle.vertexOffset = 0; // Indices are already global relative to the start of the vertex buffer
+	geometryTriangle.indexCount = meshData.m_IndexCounts[lod];
+	// Global indices reach past the primitive's own vertex count: declare the whole buffer
+	geometryTriangle.vertexCount = (uint32_t)(m_VertexBufferQuantized->getDesc().byteSize / sizeof(srrhi::VertexQuantized));
+	geometryTriangle.vertexStride = sizeof(srrhi::VertexQuantized);
+
+	geometryDesc.flags = nvrhi::rt::GeometryFlags::None; // can't be opaque since we have alpha tested materials that can be applied to this mesh
+	geometryDesc.geometryType = nvrhi::rt::GeometryType::Triangles;
+	return geometryDesc;
+}
+
+uint64_t Scene::BuildPrimitiveBLAS(nvrhi::ICommandList* cmd, Primitive& primitive, uint32_t lod)
+{
+	nvrhi::IDevice* device = g_Renderer.m_RHI->m_NvrhiDevice;
+	SDL_assert(primitive.m_ResidentLODMask & (1u << lod));
+
+	const nvrhi::rt::GeometryDesc geometryDesc = GetBLASGeometryDesc(primitive, lod);
+
+	nvrhi::rt::AccelStructDesc blasDesc;
+	blasDesc.bottomLevelGeometries = { geometryDesc };
+	blasDesc.debugName = (std::string("BLAS_LOD") + std::to_string(lod)).c_str();
+	blasDesc.buildFlags = nvrhi::rt::AccelStructBuildFlags::PreferFastTrace;
+
+	primitive.m_BLAS[lod] = device->createAccelStruct(blasDesc);
+	nvrhi::utils::BuildBottomLevelAccelStruct(cmd, primitive.m_BLAS[lod], blasDesc);
+
+	return device->getAccelStructMemoryRequirements(primitive.m_BLAS[lod]).size;
+}
+
+void Scene::UploadBLASAddresses(nvrhi::ICommandList* cmd)
+{
+	const uint32_t numInstances = (uint32_t)m_InstanceData.size();
+	const uint32_t totalEntries = numInstances * srrhi::CommonConsts::MAX_LOD_COUNT;
+	if (totalEntries == 0)
+		return;
+
+	// Primitive lookup by MeshDataIndex
+	std::vector<const Primitive*> meshDataToPrimitive(m_MeshData.size(), nullptr);
+	for (const Mesh& mesh : m_Meshes)
+		for (const Primitive& primitive : mesh.m_Primitives)
+			meshDataToPrimitive[primitive.m_MeshDataIndex] = &primitive;
+
+	std::vector<uint64_t> blasAddresses(totalEntries, 0);
+
+	for (uint32_t instanceID = 0; instanceID < numInstances; ++instanceID)
+	{
+		const srrhi::PerInstanceData& instData = m_InstanceData[instanceID];
+		GetBLASAddresses(*meshDataToPrimitive.at(instData.m_MeshDataIndex), &blasAddresses[instanceID * srrhi::CommonConsts::MAX_LOD_COUNT]);
+	}
+
+	cmd->writeBuffer(m_BLASAddressBuffer, blasAddresses.data(), totalEntries * sizeof(uint64_t));
+}
+
+void Scene::GetBLASAddresses(const Primitive& primitive, uint64_t outAddresses[srrhi::CommonConsts::MAX_LOD_COUNT]) const
+{
+	const uint32_t lodCount = (uint32_t)primitive.m_BLAS.size();
+
+	// Nothing resident (a model SceneCellStreamer has unloaded): a null BLAS makes the instance inactive
+	if (primitive.m_ResidentLODMask == 0)
+	{
+		std::fill_n(outAddresses, srrhi::CommonConsts::MAX_LOD_COUNT, 0ull);
+		return;
+	}
+
+	uint8_t blasMask = 0;
+	for (uint32_t lod = 0; lod < lodCount; ++lod)
+		blasMask |= primitive.m_BLAS[lod] ? (uint8_t)(1u << lod) : 0;
+	SDL_assert(blasMask != 0 && "The coarsest BLAS LOD is never dropped");
+
+	for (uint32_t lod = 0; lod < srrhi::CommonConsts::MAX_LOD_COUNT; ++lod)
+	{
+		// Clamp to the resident LOD range: LODs dropped under VRAM pressure use the next coarser
+		// BLAS, LODs past the end use the coarsest one (Req 2 AC3)
+		const uint32_t clampedLod = std::min(std::max(lod, m_BLASMinLOD), lodCount - 1);
+		// A streamed LOD that is not resident is drawn with its stand-in's geometry (see
+		// m_GPUMeshData), so trace the same one; fall back further if the budget dropped that
+		const uint32_t standInLod = nvfeedback::GetStandInLOD(primitive.m_ResidentLODMask, clampedLod);
+		const uint32_t blasLod = nvfeedback::GetStandInLOD(blasMask, standInLod);
+		outAddresses[lod] = primitive.m_BLAS[blasLod]->getDeviceAddress();
+	}
+}
+
+uint64_t Scene::DropFinestBLASLOD()
+{
+	nvrhi::IDevice* device = g_Renderer.m_RHI->m_NvrhiDevice;
+
+	// Release level m_BLASMinLOD wherever a coarser level exists to take its place.  With
+	// geometry streaming a level may have no BLAS built at all; move on to the next one.
+	uint64_t freedBytes = 0;
+	bool bLevelExists = true;
+	while (freedBytes == 0 && bLevelExists)
+	{
+		bLevelExists = false;
+		for (Mesh& mesh : m_Meshes)
+		{
+			for (Primitive& primitive : mesh.m_Primitives)
+			{
+				if (m_BLASMinLOD + 1 >= (uint32_t)primitive.m_BLAS.size())
+					continue;
+
+				bLevelExists = true;
+				nvrhi::rt::AccelStructHandle& blas = primitive.m_BLAS[m_BLASMinLOD];
+				if (!blas)
+					continue;
+
+				freedBytes += device->getAccelStructMemoryRequirements(blas).size;
+				m_DroppedBLAS.push_back(std::move(blas));
+				blas = nullptr;
+			}
+		}
+
+		if (bLevelExists)
+			++m_BLASMinLOD;
+	}
+
+	if (freedBytes == 0)
+		return 0;
+
+	m_BLASMemoryBytes -= std::min(m_BLASMemoryBytes, freedBytes);
+	m_DroppedBLASFrame = g_Renderer.m_FrameNumber;
+
+	// Redirect the dropped LOD to the next resident one before this frame's TLAS build
+	nvrhi::CommandListHandle cmd = g_Renderer.AcquireCommandList();
+	ScopedCommandList scopedCmd{ cmd, "Drop BLAS LOD" };
+	UploadBLASAddresses(scopedCmd);
+
+	LOG_INFO("[Scene] Dropped BLAS LOD %u: %.2f MB freed", m_BLASMinLOD - 1, BYTES_TO_MB(freedBytes));
+	return freedBytes;
+}
+
+void Scene::ReleaseDroppedBLAS()
+{
+	// The previous frame's TLAS may still reference the dropped BLASes until its
+	// work has retired, which ExecutePendingCommandLists guarantees one frame later.
+	if (!m_DroppedBLAS.empty() && g_Renderer.m_FrameNumber > m_DroppedBLASFrame)
+	{
+		m_DroppedBLAS.clear();
+	}
+}
+
+void Scene::RestoreBLASLODs()
+{
+	if (m_BLASMinLOD == 0)
+		return;
+
+	nvrhi::CommandListHandle cmd = g_Renderer.AcquireCommandList();
+	ScopedCommandList scopedCmd{ cmd, "Restore BLAS LODs" };
+
+	for (Mesh& mesh : m_Meshes)
+	{
+		for (Primitive& primitive : mesh.m_Primitives)
+		{
+			for (uint32_t lod = 0; lod < (uint32_t)primitive.m_BLAS.size(); ++lod)
+			{
+				if (!primitive.m_BLAS[lod] && (primitive.m_ResidentLODMask & (1u << lod)))
+					m_BLASMemoryBytes += BuildPrimitiveBLAS(scopedCmd, primitive, lod);
+			}
+		}
+	}
+
+	m_BLASMinLOD = 0;
+	UploadBLASAddresses(scopedCmd);
+
+	LOG_INFO("[Scene] Restored all BLAS LODs (%.2f MB)", BYTES_TO_MB(m_BLASMemoryBytes));
+}
+
 void Scene::FinalizeLoadedScene()
 {
     //SCOPED_TIMER("[Scene] Finalize Scene");
@@ -591,20 +802,31 @@ void Scene::Shutdown()
 	m_MeshletVerticesBuffer = nullptr;
 	m_MeshletTrianglesBuffer = nullptr;
 	m_LightBuffer = nullptr;
+	m_GPULights.clear();
 	m_TLAS = nullptr;
 	m_RTInstanceDescBuffer = nullptr;
 	m_BLASAddressBuffer = nullptr;
 	m_InstanceLODBuffer = nullptr;
 	m_RTInstanceDescs.clear();
+	m_DroppedBLAS.clear();
+	m_BLASMinLOD = 0;
+	m_BLASMemoryBytes = 0;
+	m_BLASMinimumBytes = 0;
 
 	// Clear CPU-side containers
 	m_Meshes.clear();
 	m_Nodes.clear();
 	m_Materials.clear();
 	m_MeshData.clear();
+	m_GPUMeshData.clear();
 	m_Meshlets.clear();
 	m_MeshletVertices.clear();
 	m_MeshletTriangles.clear();
+	m_GeometryPoolSizes = {};
+	m_CookedMeshCachePath.clear();
+	m_StreamedModels.clear();
+	m_CellStreamingParams = {};
+	m_bCPUGeometryResident = true;
 	for (Scene::Texture& tex : m_Textures)
 	{
 		tex.m_Handle = nullptr;
@@ -1,9 +1,16 @@
 #include "SceneCache.h"
 #include "SceneLoader.h"
+#include "Utilities.h"
+#include "Log.h"
 
 namespace SceneCache
 {
 
+std::filesystem::path GetCookedMeshPath(const std::filesystem::path& scenePath)
+{
+    return scenePath.parent_path() / (scenePath.stem().string() + "_mesh.bin");
+}
+
 bool IsCacheValid(const std::filesystem::path& cachePath,
                   const std::filesystem::path& sourcePath)
 {
@@ -145,14 +152,140 @@ bool LoadCookedMesh(
     return true;
 }
 
+// Bounds-checked cursor over a mapped cooked mesh file.
+struct MappedCursor
+{
+    const uint8_t* m_Ptr;
+    const uint8_t* m_End;
+
+    template<typename T>
+    bool ReadPOD(T& value)
+    {
+        if ((size_t)(m_End - m_Ptr) < sizeof(T))
+            return false;
+        memcpy(&value, m_Ptr, sizeof(T));
+        m_Ptr += sizeof(T);
+        return true;
+    }
+
+    template<typename T>
+    bool ReadSpan(std::span<const T>& outSpan)
+    {
+        uint64_t count = 0;
+        if (!ReadPOD(count) || count > (uint64_t)(m_End - m_Ptr) / sizeof(T))
+            return false;
+        // Every section is a multiple of 4 bytes, so arrays stay naturally aligned
+        SDL_assert(reinterpret_cast<uintptr_t>(m_Ptr) % alignof(T) == 0 && "Misaligned cooked mesh array");
+        outSpan = std::span<const T>(reinterpret_cast<const T*>(m_Ptr), (size_t)count);
+        m_Ptr += count * sizeof(T);
+        return true;
+    }
+};
+
+bool MapCookedMesh(
+    const std::filesystem::path& cachePath,
+    Scene::CPUGeometryView&      outView)
+{
+    outView = {};
+
+    std::shared_ptr<MemoryMappedDataReader> file = std::make_shared<MemoryMappedDataReader>(cachePath.string());
+    if (!file->IsValid())
+        return false;
+
+    const uint8_t* base = static_cast<const uint8_t*>(file->GetData());
+    MappedCursor cursor{ base, base + file->GetSize() };
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (!cursor.ReadPOD(magic) || magic != kCookedMeshMagic ||
+        !cursor.ReadPOD(version) || version != kCookedMeshVersion)
+    {
+        LOG_WARN("[SceneCache] Cannot map cooked mesh (bad header): %s", cachePath.string().c_str());
+        return false;
+    }
+
+    // Skip the Mesh records; they are variable length and already resident in Scene::m_Meshes
+    uint32_t meshCount = 0;
+    if (!cursor.ReadPOD(meshCount))
+        return false;
+    for (uint32_t mi = 0; mi < meshCount; ++mi)
+    {
+        uint32_t primCount = 0;
+        if (!cursor.ReadPOD(primCount))
+            return false;
+        const size_t primBytes = (size_t)primCount * (sizeof(uint32_t) * 3 + sizeof(int32_t));
+        const size_t skipBytes = primBytes + sizeof(Vector3) + sizeof(float);
+        if ((size_t)(cursor.m_End - cursor.m_Ptr) < skipBytes)
+            return false;
+        cursor.m_Ptr += skipBytes;
+    }
+
+    if (!cursor.ReadSpan(outView.m_MeshData) ||
+        !cursor.ReadSpan(outView.m_Meshlets) ||
+        !cursor.ReadSpan(outView.m_MeshletVertices) ||
+        !cursor.ReadSpan(outView.m_MeshletTriangles) ||
+        !cursor.ReadSpan(outView.m_VerticesQuantized) ||
+        !cursor.ReadSpan(outView.m_Indices))
+    {
+        LOG_WARN("[SceneCache] Cannot map cooked mesh (truncated): %s", cachePath.string().c_str());
+        outView = {};
+        return false;
+    }
+
+    outView.m_File = std::move(file);
+    return true;
+}
+
+bool LoadCookedMeshLayout(
+    const std::filesystem::path&  cachePath,
+    std::vector<Scene::Mesh>&     outMeshes,
+    std::vector<srrhi::MeshData>& outMeshData,
+    CookedMeshSizes&              outSizes)
+{
+    // Only the pages holding the Mesh records and MeshData are touched
+    Scene::CPUGeometryView view;
+    if (!MapCookedMesh(cachePath, view))
+        return false;
+
+    const uint8_t* base = static_cast<const uint8_t*>(view.m_File->GetData());
+    MappedCursor cursor{ base + sizeof(kCookedMeshMagic) + sizeof(kCookedMeshVersion), reinterpret_cast<const uint8_t*>(view.m_MeshData.data()) };
+
+    // MapCookedMesh has validated the record sizes
+    uint32_t meshCount = 0;
+    cursor.ReadPOD(meshCount);
+    outMeshes.resize(meshCount);
+    for (Scene::Mesh& mesh : outMeshes)
+    {
+        uint32_t primCount = 0;
+        cursor.ReadPOD(primCount);
+        mesh.m_Primitives.resize(primCount);
+        for (Scene::Primitive& prim : mesh.m_Primitives)
+        {
+            cursor.ReadPOD(prim.m_VertexOffset);
+            cursor.ReadPOD(prim.m_VertexCount);
+            cursor.ReadPOD(prim.m_MaterialIndex);
+            cursor.ReadPOD(prim.m_MeshDataIndex);
+        }
+        cursor.ReadPOD(mesh.m_Center);
+        cursor.ReadPOD(mesh.m_Radius);
+    }
+
+    outMeshData.assign(view.m_MeshData.begin(), view.m_MeshData.end());
+    outSizes.m_Meshlets          = view.m_Meshlets.size();
+    outSizes.m_MeshletVertices   = view.m_MeshletVertices.size();
+    outSizes.m_MeshletTriangles  = view.m_MeshletTriangles.size();
+    outSizes.m_VerticesQuantized = view.m_VerticesQuantized.size();
+    outSizes.m_Indices           = view.m_Indices.size();
+    return true;
+}
+
 bool LoadOrCookMeshData(
     const std::filesystem::path& scenePath,
     Scene& scene,
     std::vector<srrhi::VertexQuantized>& outVerticesQuantized,
     std::vector<uint32_t>& outIndices)
 {
-    // Compute cache path: <scene_stem>_mesh.bin alongside the glTF
-    const std::filesystem::path cachePath = scenePath.parent_path() / (scenePath.stem().string() + "_mesh.bin");
+    const std::filesystem::path cachePath = GetCookedMeshPath(scenePath);
 
     // 1. Try loading from cache
     if (IsCacheValid(cachePath, scenePath))
@@ -168,6 +301,7 @@ bool LoadOrCookMeshData(
         if (loaded)
         {
             SDL_Log("[SceneCache] Loaded cooked mesh from cache: %s", cachePath.string().c_str());
+            scene.m_CookedMeshCachePath = cachePath;
 
             // Recompute node bounding spheres now that mesh data exists.
             // ProcessNodesAndHierarchy was called earlier (before meshes were available),
@@ -208,6 +342,7 @@ bool LoadOrCookMeshData(
         outIndices))
     {
         SDL_Log("[SceneCache] Saved cooked mesh to cache: %s", cachePath.string().c_str());
+        scene.m_CookedMeshCachePath = cachePath;
     }
     else
     {
@@ -217,4 +352,23 @@ bool LoadOrCookMeshData(
     return true;
 }
 
+bool CookMeshIfNeeded(const std::filesystem::path& scenePath)
+{
+    if (IsCacheValid(GetCookedMeshPath(scenePath), scenePath))
+        return true;
+
+    // Cooked with its own materials only, so the cache does not depend on what else
+    // was loaded before it
+    Scene cookScene;
+    std::vector<srrhi::VertexQuantized> verticesQuantized;
+    std::vector<uint32_t> indices;
+    if (!SceneLoader::LoadGLTFScene_NonMesh(cookScene, scenePath.string(), /*bFromJSONScene=*/true) ||
+        !LoadOrCookMeshData(scenePath, cookScene, verticesQuantized, indices))
+    {
+        return false;
+    }
+
+    return !cookScene.m_CookedMeshCachePath.empty();
+}
+
 } // namespace SceneCache
@@ -91,6 +91,35 @@ namespace SceneCache
         std::vector<srrhi::VertexQuantized>& outVerticesQuantized,
         std::vector<uint32_t>&               outIndices);
 
+    // Memory-map a cooked mesh file and point outView's spans at its POD arrays.
+    // Nothing is copied; pages are read from disk as the spans are accessed.
+    // Returns false if the file is missing, truncated, or has the wrong version.
+    bool MapCookedMesh(
+        const std::filesystem::path& cachePath,
+        Scene::CPUGeometryView&      outView);
+
+    // Element counts of the geometry arrays of a cooked mesh file.
+    struct CookedMeshSizes
+    {
+        uint64_t m_Meshlets          = 0;
+        uint64_t m_MeshletVertices   = 0;
+        uint64_t m_MeshletTriangles  = 0;
+        uint64_t m_VerticesQuantized = 0;
+        uint64_t m_Indices           = 0;
+    };
+
+    // Read the Mesh records and MeshData of a cooked mesh file, and the size of
+    // every geometry array, without reading the geometry itself.
+    // Returns false if the file is missing, truncated, or has the wrong version.
+    bool LoadCookedMeshLayout(
+        const std::filesystem::path&  cachePath,
+        std::vector<Scene::Mesh>&     outMeshes,
+        std::vector<srrhi::MeshData>& outMeshData,
+        CookedMeshSizes&              outSizes);
+
+    // Cooked mesh cache of a glTF file: <scene_stem>_mesh.bin alongside it.
+    std::filesystem::path GetCookedMeshPath(const std::filesystem::path& scenePath);
+
     // Check whether the cached file exists and is newer than the source file.
     bool IsCacheValid(const std::filesystem::path& cachePath,
                       const std::filesystem::path& sourcePath);
@@ -104,4 +133,9 @@ namespace SceneCache
         std::vector<srrhi::VertexQuantized>& outVerticesQuantized,
         std::vector<uint32_t>& outIndices);
 
+    // Cook the mesh cache of a glTF file on its own (as LoadOrCookMeshData would when
+    // loading it as the scene) unless an up-to-date one exists.  Returns false if the
+    // cache is still missing afterwards.
+    bool CookMeshIfNeeded(const std::filesystem::path& scenePath);
+
 } // namespace SceneCache
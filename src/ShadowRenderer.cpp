@@ -224,6 +224,7 @@ private:
         cullData.SetP11(0.0f);
         cullData.SetForcedLOD(0); // Always use LOD 0 for shadows — auto LOD introduces silhouette error
         cullData.SetInstanceBaseIndex(0);
+        cullData.SetRecordLODRequests(0); // LOD 0 is forced here; only the main view drives geometry streaming
         commandList->writeBuffer(cullCB, &cullData, sizeof(cullData), 0);
 
         srrhi::GPUCullingInputs cullInputs;
@@ -240,6 +241,7 @@ private:
         cullInputs.SetMeshletJobCount(h.meshletJobCount);
         cullInputs.SetMeshletIndirectArgs(h.meshletIndirect);
         cullInputs.SetInstanceLOD(g_Renderer.m_Scene.m_InstanceLODBuffer);
+        cullInputs.SetLODRequests(CommonResources::GetInstance().DummyUAVStructuredBuffer);
 
         nvrhi::BindingSetDesc cullBset = Renderer::CreateBindingSetDesc(cullInputs);
         const uint32_t dispatchX = DivideAndRoundUp(numInstances, srrhi::CommonConsts::kThreadsPerGroup);
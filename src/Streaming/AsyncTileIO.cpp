@@ -1,48 +1,113 @@
 #include "AsyncTileIO.h"
+#include "../Log.h"
+
+#include "d3d12.h"
 
 namespace nvfeedback
 {
     // ─── Helpers ─────────────────────────────────────────────────────────────
 
-    // Extract a tile from a linear DDS mip into dst.
-    static void ExtractTile(
-        const uint8_t* srcBase,
-        uint32_t mipWidth,
-        uint32_t tileXInTexels, uint32_t tileYInTexels,
-        uint32_t tileWidthInTexels, uint32_t tileHeightInTexels,
-        uint32_t bytesPerBlock, uint32_t blockSize,
-        uint8_t* dst)
+    static TileRowLayout GetTileRowLayout(const TileRequest& req)
     {
-        const uint32_t blocksPerRow = (mipWidth + blockSize - 1) / blockSize;
-        const uint32_t mipHeightInBlocks = blocksPerRow; // square-ish, but safe upper bound: use blocksPerRow
-        const uint32_t tileBlocksW  = (tileWidthInTexels  + blockSize - 1) / blockSize;
-        const uint32_t tileBlocksH  = (tileHeightInTexels + blockSize - 1) / blockSize;
-        const uint32_t srcBlockX    = tileXInTexels / blockSize;
-        const uint32_t srcBlockY    = tileYInTexels / blockSize;
-        const uint32_t rowPitchSrc  = blocksPerRow * bytesPerBlock;
-        const uint32_t rowPitchTile = tileBlocksW  * bytesPerBlock;
+        SDL_assert(req.m_MipLevel < srrhi::CommonConsts::MAX_MIP_COUNT);
 
-        SDL_assert(tileBlocksW > 0 && tileBlocksH > 0);
-        SDL_assert(srcBlockX + tileBlocksW <= blocksPerRow);
+        TileRowLayout layout;
+        layout.m_RowBytes = ((req.m_TileWidthInTexels  + req.m_BlockSize - 1) / req.m_BlockSize) * req.m_BytesPerBlock;
+        layout.m_NumRows  =  (req.m_TileHeightInTexels + req.m_BlockSize - 1) / req.m_BlockSize;
 
-        for (uint32_t row = 0; row < tileBlocksH; row++)
+        if (req.m_TiledLayout)
         {
-            const uint32_t readOffset = (srcBlockY + row) * rowPitchSrc + srcBlockX * bytesPerBlock;
-            memcpy(dst + row * rowPitchTile, srcBase + readOffset, rowPitchTile);
+            const TiledDDSTile* tile = req.m_TiledLayout->FindTile(req.m_MipLevel, req.m_TileXInTexels, req.m_TileYInTexels);
+            SDL_assert(tile && tile->m_Size == layout.m_RowBytes * layout.m_NumRows && "Tile request does not match the .tdds tile table");
+            layout.m_RowPitch       = layout.m_RowBytes;
+            layout.m_FirstRowOffset = tile->m_Offset;
+            layout.m_StoredSize     = tile->m_StoredSize;
+            return layout;
         }
+
+        const uint32_t mipWidth = std::max(req.m_TextureWidth >> req.m_MipLevel, 1u);
+        return GetLinearTileRowLayout(req.m_MipOffsets[req.m_MipLevel], mipWidth, req.m_TileXInTexels, req.m_TileYInTexels,
+                                      req.m_TileWidthInTexels, req.m_TileHeightInTexels, req.m_BlockSize, req.m_BytesPerBlock);
+    }
+
+    // Byte range covered by mips [firstMip, endMip).  Returns false for an empty range.
+    static bool GetMipByteRange(const MemoryMappedDataReader& source, const size_t* mipOffsets, uint32_t numMips,
+                                uint32_t firstMip, uint32_t endMip, size_t& outOffset, size_t& outSize)
+    {
+        endMip = std::min(endMip, numMips);
+        if (firstMip >= endMip)
+            return false;
+
+        const size_t begin = mipOffsets[firstMip];
+        const size_t end   = (endMip < numMips) ? mipOffsets[endMip] : source.GetSize();
+        if (begin >= end)
+            return false;
+
+        outOffset = begin;
+        outSize   = end - begin;
+        return true;
+    }
+
+    // ─── Source page-cache hints ──────────────────────────────────────────────
+
+    void PrefetchMipRange(const MemoryMappedDataReader& source, const size_t* mipOffsets, uint32_t numMips, uint32_t firstMip, uint32_t endMip)
+    {
+        size_t offset, size;
+        if (GetMipByteRange(source, mipOffsets, numMips, firstMip, endMip, offset, size))
+            source.Prefetch(offset, size);
+    }
+
+    void EvictMipRange(const MemoryMappedDataReader& source, const size_t* mipOffsets, uint32_t numMips, uint32_t firstMip, uint32_t endMip)
+    {
+        size_t offset, size;
+        if (GetMipByteRange(source, mipOffsets, numMips, firstMip, endMip, offset, size))
+            source.Evict(offset, size);
     }
 
     // ─── AsyncTileIO ─────────────────────────────────────────────────────────
 
-    AsyncTileIO::AsyncTileIO()
+    static TileCacheKey GetTileCacheKey(const TileRequest& req)
     {
+        TileCacheKey key;
+        key.m_Source    = (uint64_t)(uintptr_t)req.m_SourceData.get();
+        key.m_MipLevel  = req.m_MipLevel;
+        key.m_XInTexels = req.m_TileXInTexels;
+        key.m_YInTexels = req.m_TileYInTexels;
+        return key;
+    }
+
+    AsyncTileIO::AsyncTileIO(nvrhi::IDevice* device, IOBackend backend, uint32_t queueDepth, uint64_t stagingRingBytes, uint64_t tileCacheBytes, TaskScheduler* ioLane)
+        : m_Backend(backend)
+        , m_QueueDepth(std::max(queueDepth, 1u))
+        , m_IOLane(ioLane)
+    {
+        if (device && stagingRingBytes > 0)
+        {
+            m_StagingRing = std::make_unique<TileStagingRing>(stagingRingBytes);
+            if (!CreateStagingBuffer(device, m_StagingRing->GetCapacity()))
+            {
+                LOG_WARN("[Streaming] Failed to create the tile staging ring, using writeTexture uploads");
+                m_StagingRing.reset();
+            }
+        }
+
+        if (tileCacheBytes > 0)
+            m_TileCache = std::make_unique<TileCache>(tileCacheBytes);
+
+        if (m_IOLane)
+        {
+            // Lane tasks are scheduled by Submit()
+            m_NumWorkers = std::max(m_IOLane->GetIOThreadCount(), 1u);
+            return;
+        }
+
         // Default: half of hardware threads, at least 1, at most 4
         const uint32_t hw = std::thread::hardware_concurrency();
-        const uint32_t numWorkers = std::max(1u, std::min(4u, hw / 2));
+        m_NumWorkers = std::max(1u, std::min(4u, hw / 2));
 
-        m_Workers.reserve(numWorkers);
+        m_Workers.reserve(m_NumWorkers);
 
-        for (uint32_t i = 0; i < numWorkers; i++)
+        for (uint32_t i = 0; i < m_NumWorkers; i++)
         {
             m_Workers.emplace_back([this]() { WorkerLoop(); });
         }
@@ -50,34 +115,96 @@ namespace nvfeedback
 
     AsyncTileIO::~AsyncTileIO()
     {
-        // Signal shutdown and wake all workers
+        SDL_assert(IsOwnerThread() && "AsyncTileIO destroyed off its owner thread");
+
+        if (m_IOLane)
         {
-            std::lock_guard<std::mutex> lock(m_PendingMutex);
-            m_bShutdown.store(true, std::memory_order_release);
+            // Lane tasks drain the queue like the private workers below, then stop touching this
+            std::unique_lock<std::mutex> lock(m_PendingMutex);
+            m_IdleCV.wait(lock, [this]() { return m_NumLaneWorkers == 0; });
+        }
+        else
+        {
+            // Signal shutdown and wake all workers
+            {
+                std::lock_guard<std::mutex> lock(m_PendingMutex);
+                m_bShutdown.store(true, std::memory_order_release);
+            }
+            m_PendingCV.notify_all();
+
+            for (std::thread& t : m_Workers)
+            {
+                if (t.joinable())
+                    t.join();
+            }
         }
-        m_PendingCV.notify_all();
 
-        for (std::thread& t : m_Workers)
+        if (m_StagingData)
+            m_StagingDevice->unmapBuffer(m_StagingBuffer);
+    }
+
+    bool AsyncTileIO::CreateStagingBuffer(nvrhi::IDevice* device, uint64_t sizeBytes)
+    {
+        nvrhi::BufferDesc bufferDesc{};
+        bufferDesc.byteSize         = sizeBytes;
+        bufferDesc.cpuAccess        = nvrhi::CpuAccessMode::Write;
+        bufferDesc.initialState     = nvrhi::ResourceStates::CopySource;
+        bufferDesc.keepInitialState = true;
+        bufferDesc.debugName        = "Tile Staging Ring";
+        m_StagingBuffer = device->createBuffer(bufferDesc);
+        if (!m_StagingBuffer)
+            return false;
+
+        // Upload heaps may stay mapped for their whole lifetime; the ring's own
+        // retire logic guarantees the GPU is done with a range before it is rewritten.
+        m_StagingData = static_cast<uint8_t*>(device->mapBuffer(m_StagingBuffer, nvrhi::CpuAccessMode::Write));
+        if (!m_StagingData)
         {
-            if (t.joinable())
-                t.join();
+            m_StagingBuffer = nullptr;
+            return false;
         }
+
+        m_StagingDevice = device;
+        return true;
     }
 
     void AsyncTileIO::Submit(TileRequest request)
     {
+        SDL_assert(IsOwnerThread() && "AsyncTileIO::Submit called off its owner thread");
+
+        request.m_SubmitTicks = SDL_GetPerformanceCounter();
         m_PendingCount.fetch_add(1, std::memory_order_relaxed);
+
+        bool bStartLaneWorker = false;
         {
             std::lock_guard<std::mutex> lock(m_PendingMutex);
             m_PendingQueue.push(std::move(request));
+
+            // A lane worker only retires with the queue empty under this lock, so
+            // either a running one takes this request or a new one is started
+            if (m_IOLane && m_NumLaneWorkers < m_NumWorkers)
+            {
+                m_NumLaneWorkers++;
+                bStartLaneWorker = true;
+            }
         }
-        m_PendingCV.notify_one();
+
+        if (bStartLaneWorker)
+            m_IOLane->ScheduleIOTask([this]() { LaneWorker(); });
+        else if (!m_IOLane)
+            m_PendingCV.notify_one();
     }
 
-    uint32_t AsyncTileIO::Flush(nvrhi::ICommandList* cmd)
+    uint32_t AsyncTileIO::Flush(nvrhi::ICommandList* cmd, uint64_t frameNumber, std::vector<CompletedTileRead>* outReads)
     {
+        SDL_assert(IsOwnerThread() && "AsyncTileIO::Flush called off its owner thread");
+
         uint32_t processed = 0;
 
+        // Staging ranges whose copies were recorded kStagingRetireLatencyFrames ago are free again
+        if (m_StagingRing && frameNumber >= kStagingRetireLatencyFrames)
+            m_StagingRing->Retire(frameNumber - kStagingRetireLatencyFrames);
+
         // Drain all completed requests on the main thread
         std::vector<CompletedRequest> local;
         {
@@ -85,38 +212,133 @@ namespace nvfeedback
             std::swap(local, m_CompletedQueue);
         }
 
-        if (!cmd)
+        for (CompletedRequest& cr : local)
         {
-            return 0;
+            if (cmd)
+            {
+                RecordTileUpload(cmd, cr);
+                processed++;
+
+                if (outReads)
+                    outReads->push_back({ cr.m_Request.m_UserTag, cr.m_bFromCache ? 0u : GetTileRowLayout(cr.m_Request).m_StoredSize });
+            }
+
+            // Discarded ranges are retired with the rest so the ring never stalls on them
+            if (cr.m_Staging.IsValid())
+                m_StagingRing->MarkSubmitted(cr.m_Staging, frameNumber);
         }
 
-        for (CompletedRequest& cr : local)
+        // writeTexture copies into the upload buffer, so the fallback buffers can be reused right away
         {
-            SDL_assert(cr.m_Request.m_OnComplete);
-            cr.m_Request.m_OnComplete(cr.m_Request, cr.m_TileData.data(), cr.m_TileData.size(), cmd);
-            processed++;
+            std::lock_guard<std::mutex> lock(m_CompletedMutex);
+            for (CompletedRequest& cr : local)
+            {
+                if (m_FreeTileBuffers.size() >= kMaxPooledTileBuffers)
+                    break;
+                if (cr.m_TileData.capacity() > 0)
+                    m_FreeTileBuffers.push_back(std::move(cr.m_TileData));
+            }
         }
 
         return processed;
     }
 
+    void AsyncTileIO::RecordTileUpload(nvrhi::ICommandList* cmd, const CompletedRequest& cr) const
+    {
+        const TileRequest& r = cr.m_Request;
+        SDL_assert(r.m_ReservedTexture);
+
+        if (!cr.m_Staging.IsValid())
+        {
+            nvrhi::TextureSlice destSlice{};
+            destSlice.x          = r.m_TileXInTexels;
+            destSlice.y          = r.m_TileYInTexels;
+            destSlice.width      = r.m_TileWidthInTexels;
+            destSlice.height     = r.m_TileHeightInTexels;
+            destSlice.mipLevel   = r.m_MipLevel;
+            destSlice.arraySlice = 0;
+
+            cmd->writeTexture(r.m_ReservedTexture, destSlice, cr.m_TileData.data(), cr.m_RowPitch, 0);
+            return;
+        }
+
+        // NVRHI has no buffer-to-texture copy, so the staged rows go through the native
+        // command list.  Let NVRHI transition the destination mip first.
+        cmd->setTextureState(r.m_ReservedTexture, nvrhi::TextureSubresourceSet(r.m_MipLevel, 1, 0, 1), nvrhi::ResourceStates::CopyDest);
+        cmd->commitBarriers();
+
+        ID3D12GraphicsCommandList* nativeCmdList = cmd->getNativeObject(nvrhi::ObjectTypes::D3D12_GraphicsCommandList);
+        ID3D12Resource* dstRes = r.m_ReservedTexture->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource);
+        ID3D12Resource* srcRes = m_StagingBuffer->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource);
+
+        // Block-compressed footprints are whole blocks; the copy may run past a mip
+        // edge that is not block aligned, exactly as writeTexture does.
+        D3D12_TEXTURE_COPY_LOCATION src{};
+        src.pResource                          = srcRes;
+        src.Type                               = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        src.PlacedFootprint.Offset             = cr.m_Staging.m_Offset;
+        src.PlacedFootprint.Footprint.Format   = dstRes->GetDesc().Format;
+        src.PlacedFootprint.Footprint.Width    = (r.m_TileWidthInTexels  + r.m_BlockSize - 1) / r.m_BlockSize * r.m_BlockSize;
+        src.PlacedFootprint.Footprint.Height   = (r.m_TileHeightInTexels + r.m_BlockSize - 1) / r.m_BlockSize * r.m_BlockSize;
+        src.PlacedFootprint.Footprint.Depth    = 1;
+        src.PlacedFootprint.Footprint.RowPitch = cr.m_RowPitch;
+
+        D3D12_TEXTURE_COPY_LOCATION dst{};
+        dst.pResource        = dstRes;
+        dst.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        dst.SubresourceIndex = r.m_MipLevel; // single array slice, single plane
+
+        nativeCmdList->CopyTextureRegion(&dst, r.m_TileXInTexels, r.m_TileYInTexels, 0, &src, nullptr);
+    }
+
     void AsyncTileIO::WaitIdle()
     {
-        // Spin until all submitted requests have been completed
-        while (m_PendingCount.load(std::memory_order_acquire) > 0)
+        SDL_assert(IsOwnerThread() && "AsyncTileIO::WaitIdle called off its owner thread");
+
+        // CompleteBatch() notifies under m_PendingMutex once the count drops to 0
+        std::unique_lock<std::mutex> lock(m_PendingMutex);
+        m_IdleCV.wait(lock, [this]() { return m_PendingCount.load(std::memory_order_acquire) == 0; });
+    }
+
+    AsyncTileIO::IOStats AsyncTileIO::GetIOStats() const
+    {
+        const double ticksPerSecond = (double)SDL_GetPerformanceFrequency();
+
+        IOStats stats;
+        stats.m_NumTiles           = m_NumTilesRead.load(std::memory_order_relaxed);
+        stats.m_NumCachedTiles     = m_NumCachedTiles.load(std::memory_order_relaxed);
+        stats.m_NumReads           = m_NumReads.load(std::memory_order_relaxed);
+        stats.m_BytesRead          = m_BytesRead.load(std::memory_order_relaxed);
+        stats.m_NumCompressedTiles = m_NumCompressedTiles.load(std::memory_order_relaxed);
+        stats.m_BytesDecoded       = m_BytesDecoded.load(std::memory_order_relaxed);
+        stats.m_ReadSeconds        = (double)m_ReadTicks.load(std::memory_order_relaxed) / ticksPerSecond;
+        stats.m_DecodeSeconds      = (double)m_DecodeTicks.load(std::memory_order_relaxed) / ticksPerSecond;
+        stats.m_BusySeconds        = (double)m_BusyTicks.load(std::memory_order_relaxed) / ticksPerSecond;
+        stats.m_LatencySeconds     = (double)m_LatencyTicks.load(std::memory_order_relaxed) / ticksPerSecond;
+        return stats;
+    }
+
+    std::vector<uint8_t> AsyncTileIO::AcquireTileBuffer(size_t size)
+    {
+        std::vector<uint8_t> buffer;
         {
-            std::this_thread::yield();
+            std::lock_guard<std::mutex> lock(m_CompletedMutex);
+            if (!m_FreeTileBuffers.empty())
+            {
+                buffer = std::move(m_FreeTileBuffers.back());
+                m_FreeTileBuffers.pop_back();
+            }
         }
+        buffer.resize(size);
+        return buffer;
     }
 
     void AsyncTileIO::WorkerLoop()
     {
-        std::vector<uint8_t> scratch;
+        WorkerScratch scratch;
 
         while (true)
         {
-            TileRequest req;
-
             // Wait for work
             {
                 std::unique_lock<std::mutex> lock(m_PendingMutex);
@@ -127,51 +349,319 @@ namespace nvfeedback
                 if (m_bShutdown.load(std::memory_order_acquire) && m_PendingQueue.empty())
                     return;
 
-                req = std::move(m_PendingQueue.front());
-                m_PendingQueue.pop();
+                TakeBatch(scratch);
+            }
+
+            ProcessBatch(scratch);
+        }
+    }
+
+    // One batch per lane task, so the lane's other work is not starved while
+    // tiles stream.  The task re-queues itself until the queue is empty.
+    void AsyncTileIO::LaneWorker()
+    {
+        std::unique_ptr<WorkerScratch> scratch;
+        {
+            std::lock_guard<std::mutex> lock(m_PendingMutex);
+            if (m_PendingQueue.empty())
+            {
+                if (--m_NumLaneWorkers == 0)
+                    m_IdleCV.notify_all();
+                return;
+            }
+
+            if (!m_LaneScratch.empty())
+            {
+                scratch = std::move(m_LaneScratch.back());
+                m_LaneScratch.pop_back();
+            }
+            else
+            {
+                scratch = std::make_unique<WorkerScratch>();
+            }
+
+            TakeBatch(*scratch);
+        }
+
+        ProcessBatch(*scratch);
+
+        {
+            std::lock_guard<std::mutex> lock(m_PendingMutex);
+            m_LaneScratch.push_back(std::move(scratch));
+            if (m_PendingQueue.empty())
+            {
+                if (--m_NumLaneWorkers == 0)
+                    m_IdleCV.notify_all();
+                return;
+            }
+        }
+
+        m_IOLane->ScheduleIOTask([this]() { LaneWorker(); });
+    }
+
+    void AsyncTileIO::TakeBatch(WorkerScratch& scratch)
+    {
+        // The mmap path gains nothing from batching; keep one request per wake-up
+        // so work spreads evenly across the workers.
+        const uint32_t batchSize = (m_Backend == IOBackend::ExplicitRead) ? m_QueueDepth : 1u;
+
+        while (!m_PendingQueue.empty() && scratch.m_Batch.size() < batchSize)
+        {
+            scratch.m_Batch.emplace_back().m_Request = std::move(m_PendingQueue.front());
+            m_PendingQueue.pop();
+        }
+    }
+
+    void AsyncTileIO::ProcessBatch(WorkerScratch& scratch)
+    {
+        const uint64_t busyStart = SDL_GetPerformanceCounter();
+
+        AllocateTileDestinations(scratch);
+
+        if (m_TileCache)
+            LookupTileCache(scratch);
+
+        if (m_Backend == IOBackend::ExplicitRead)
+            ProcessBatchExplicit(scratch);
+        else
+            ProcessBatchMapped(scratch);
+
+        if (m_TileCache)
+            FillTileCache(scratch);
+
+        CompleteBatch(scratch);
+
+        m_BusyTicks.fetch_add(SDL_GetPerformanceCounter() - busyStart, std::memory_order_relaxed);
+    }
+
+    void AsyncTileIO::AllocateTileDestinations(WorkerScratch& scratch)
+    {
+        for (CompletedRequest& cr : scratch.m_Batch)
+        {
+            const TileRowLayout layout = GetTileRowLayout(cr.m_Request);
+
+            if (m_StagingRing)
+            {
+                const uint32_t rowPitch = (layout.m_RowBytes + TileStagingRing::kRowPitchAlignment - 1) / TileStagingRing::kRowPitchAlignment * TileStagingRing::kRowPitchAlignment;
+                if (m_StagingRing->Reserve((uint64_t)rowPitch * layout.m_NumRows, cr.m_Staging))
+                {
+                    cr.m_RowPitch = rowPitch;
+                    continue;
+                }
+
+                LOG_WARN_RATE_LIMITED(1000, "[Streaming] Tile staging ring full (%llu MB), falling back to writeTexture",
+                                      (unsigned long long)BYTES_TO_MB(m_StagingRing->GetCapacity()));
             }
 
-            // ── Extract tile data from mmap'd DDS ──
-            const uint8_t* ddsBase = static_cast<const uint8_t*>(req.m_SourceData->GetData());
+            cr.m_RowPitch = layout.m_RowBytes;
+            cr.m_TileData = AcquireTileBuffer((size_t)layout.m_RowBytes * layout.m_NumRows);
+        }
+    }
 
-            // Use the cached per-mip file offsets (parsed once from the DDS header at load time)
-            size_t mipOffset = req.m_MipOffsets[req.m_MipLevel];
-            SDL_assert(req.m_MipLevel < srrhi::CommonConsts::MAX_MIP_COUNT);
+    void AsyncTileIO::LookupTileCache(WorkerScratch& scratch)
+    {
+        uint64_t numHits = 0;
+        for (CompletedRequest& cr : scratch.m_Batch)
+        {
+            const TileRowLayout layout = GetTileRowLayout(cr.m_Request);
+            if (m_TileCache->Lookup(GetTileCacheKey(cr.m_Request), GetTileDestination(cr), cr.m_RowPitch, layout.m_RowBytes, layout.m_NumRows))
+            {
+                cr.m_bFromCache = true;
+                numHits++;
+                continue;
+            }
 
-            uint32_t mipWidth = std::max(req.m_TextureWidth >> req.m_MipLevel, 1u);
+            // Misses are read into the destination and, packed, into m_CacheData
+            cr.m_CacheData = AcquireTileBuffer((size_t)layout.m_RowBytes * layout.m_NumRows);
+        }
 
-            uint32_t tileBlocksW = (req.m_TileWidthInTexels  + req.m_BlockSize - 1) / req.m_BlockSize;
-            uint32_t tileBlocksH = (req.m_TileHeightInTexels + req.m_BlockSize - 1) / req.m_BlockSize;
-            size_t tileDataSize  = static_cast<size_t>(tileBlocksW) * tileBlocksH * req.m_BytesPerBlock;
+        m_NumCachedTiles.fetch_add(numHits, std::memory_order_relaxed);
+    }
 
-            // SDL_Log("[Streaming] Extracting tile: mip=%u tex=(%u,%u) size=(%u,%u) blocks=(%u,%u) dataSize=%zu offset=%zu",
-            //         req.m_MipLevel, req.m_TileXInTexels, req.m_TileYInTexels,
-            //         req.m_TileWidthInTexels, req.m_TileHeightInTexels,
-            //         tileBlocksW, tileBlocksH, tileDataSize, mipOffset);
+    void AsyncTileIO::FillTileCache(WorkerScratch& scratch)
+    {
+        for (CompletedRequest& cr : scratch.m_Batch)
+        {
+            // Empty for hits, and for tiles that failed to decode
+            if (!cr.m_CacheData.empty())
+                m_TileCache->Insert(GetTileCacheKey(cr.m_Request), cr.m_Request.m_SourceData, std::move(cr.m_CacheData));
+        }
+    }
+
+    uint8_t* AsyncTileIO::GetTileDestination(CompletedRequest& cr) const
+    {
+        return cr.m_Staging.IsValid() ? m_StagingData + cr.m_Staging.m_Offset : cr.m_TileData.data();
+    }
 
-            // Resize scratch buffer (only grows, never shrinks)
-            if (scratch.size() < tileDataSize)
-                scratch.resize(tileDataSize);
+    void AsyncTileIO::ProcessBatchMapped(WorkerScratch& scratch)
+    {
+        uint64_t numRanges = 0;
+        uint64_t numBytes  = 0;
+        uint64_t readTicks = 0;
 
-            ExtractTile(
-                ddsBase + mipOffset,
-                mipWidth,
-                req.m_TileXInTexels, req.m_TileYInTexels,
-                req.m_TileWidthInTexels, req.m_TileHeightInTexels,
-                req.m_BytesPerBlock, req.m_BlockSize,
-                scratch.data());
+        for (CompletedRequest& cr : scratch.m_Batch)
+        {
+            if (cr.m_bFromCache)
+                continue;
 
-            // ── Push to completed queue ──
-            CompletedRequest cr;
-            cr.m_Request = std::move(req);
-            cr.m_TileData.assign(scratch.data(), scratch.data() + tileDataSize);
+            const TileRequest& req = cr.m_Request;
+            const TileRowLayout layout = GetTileRowLayout(req);
+            const uint8_t* src = static_cast<const uint8_t*>(req.m_SourceData->GetData()) + layout.m_FirstRowOffset;
 
+            numRanges += (layout.m_RowPitch == layout.m_RowBytes) ? 1 : layout.m_NumRows;
+            numBytes  += layout.m_StoredSize;
+
+            // ── Decode a compressed tile straight out of the mapping ──
+            if (layout.IsCompressed())
             {
-                std::lock_guard<std::mutex> lock(m_CompletedMutex);
-                m_CompletedQueue.push_back(std::move(cr));
+                DecodeTile(scratch, cr, src, layout.m_StoredSize);
+                continue;
             }
 
-            m_PendingCount.fetch_sub(1, std::memory_order_release);
+            // ── Copy the tile rows out of the mmap'd source ──
+            const uint64_t start = SDL_GetPerformanceCounter();
+            uint8_t* dst = GetTileDestination(cr);
+
+            for (uint32_t row = 0; row < layout.m_NumRows; row++)
+                memcpy(dst + (size_t)row * cr.m_RowPitch, src + (size_t)row * layout.m_RowPitch, layout.m_RowBytes);
+
+            // Second copy from the pages the first one just faulted in
+            if (!cr.m_CacheData.empty())
+            {
+                for (uint32_t row = 0; row < layout.m_NumRows; row++)
+                    memcpy(cr.m_CacheData.data() + (size_t)row * layout.m_RowBytes, src + (size_t)row * layout.m_RowPitch, layout.m_RowBytes);
+            }
+
+            readTicks += SDL_GetPerformanceCounter() - start;
+        }
+
+        m_NumReads.fetch_add(numRanges, std::memory_order_relaxed);
+        m_BytesRead.fetch_add(numBytes, std::memory_order_relaxed);
+        m_ReadTicks.fetch_add(readTicks, std::memory_order_relaxed);
+    }
+
+    void AsyncTileIO::ProcessBatchExplicit(WorkerScratch& scratch)
+    {
+        // ── Gather every tile row's source byte range ──
+        scratch.m_Spans.clear();
+        for (uint32_t i = 0; i < scratch.m_Batch.size(); i++)
+        {
+            const CompletedRequest& cr = scratch.m_Batch[i];
+            if (!cr.m_bFromCache)
+                AppendTileReadSpans(cr.m_Request.m_SourceData.get(), GetTileRowLayout(cr.m_Request), cr.m_RowPitch, i, scratch.m_Spans);
+        }
+
+        // ── Coalesce neighbouring rows (and tiles) and read ──
+        CoalesceTileReads(scratch.m_Spans, kMaxCoalesceGapBytes, kMaxCoalescedReadBytes, scratch.m_Reads);
+
+        uint64_t numBytes  = 0;
+        uint64_t readTicks = 0;
+        for (const TileRead& read : scratch.m_Reads)
+        {
+            if (scratch.m_ReadBuffer.size() < read.m_Size)
+                scratch.m_ReadBuffer.resize(read.m_Size);
+
+            numBytes += read.m_Size;
+
+            const uint64_t start = SDL_GetPerformanceCounter();
+
+            const uint8_t* src = scratch.m_ReadBuffer.data();
+            if (read.m_Source->ReadAt(read.m_Offset, scratch.m_ReadBuffer.data(), read.m_Size) != read.m_Size)
+            {
+                // The mapping always covers the file; let it page the range in instead
+                LOG_WARN_RATE_LIMITED(1000, "[Streaming] Explicit tile read failed (offset=%zu size=%zu), falling back to mmap", read.m_Offset, read.m_Size);
+                src = static_cast<const uint8_t*>(read.m_Source->GetData()) + read.m_Offset;
+            }
+
+            readTicks += SDL_GetPerformanceCounter() - start;
+
+            for (uint32_t i = read.m_FirstSpan; i < read.m_EndSpan; i++)
+            {
+                const TileReadSpan& span = scratch.m_Spans[i];
+                CompletedRequest& cr = scratch.m_Batch[span.m_BatchIndex];
+                if (span.m_bCompressed)
+                {
+                    DecodeTile(scratch, cr, src + (span.m_SrcOffset - read.m_Offset), span.m_Size);
+                    continue;
+                }
+
+                memcpy(GetTileDestination(cr) + span.m_DstOffset, src + (span.m_SrcOffset - read.m_Offset), span.m_Size);
+                if (!cr.m_CacheData.empty())
+                    memcpy(cr.m_CacheData.data() + span.m_PackedOffset, src + (span.m_SrcOffset - read.m_Offset), span.m_Size);
+            }
+        }
+
+        const uint64_t numReads = scratch.m_Reads.size();
+        m_NumReads.fetch_add(numReads, std::memory_order_relaxed);
+        m_BytesRead.fetch_add(numBytes, std::memory_order_relaxed);
+        m_ReadTicks.fetch_add(readTicks, std::memory_order_relaxed);
+    }
+
+    void AsyncTileIO::DecodeTile(WorkerScratch& scratch, CompletedRequest& cr, const uint8_t* src, uint32_t storedSize)
+    {
+        const TileRequest& req = cr.m_Request;
+        const TileRowLayout layout = GetTileRowLayout(req);
+        const size_t tileSize = (size_t)layout.m_RowBytes * layout.m_NumRows;
+        uint8_t* dst = GetTileDestination(cr);
+
+        const uint64_t start = SDL_GetPerformanceCounter();
+
+        // Tightly packed destination: decode in place, no extra copy.  A tile bound for
+        // the TileCache is decoded into its packed cache buffer instead.
+        const bool bToCache = !cr.m_CacheData.empty();
+        const bool bInPlace = !bToCache && (cr.m_RowPitch == layout.m_RowBytes);
+        if (!bInPlace && !bToCache && scratch.m_DecodeBuffer.size() < tileSize)
+            scratch.m_DecodeBuffer.resize(tileSize);
+
+        uint8_t* decoded = bInPlace ? dst : bToCache ? cr.m_CacheData.data() : scratch.m_DecodeBuffer.data();
+        const bool bDecoded = DecompressTiledDDSTile(req.m_TiledLayout->m_Compression, src, storedSize, decoded, tileSize);
+        if (!bDecoded)
+        {
+            // A bad tile must not take the streamer down; upload black and keep going
+            LOG_ERROR_RATE_LIMITED(1000, "[Streaming] Failed to decode %s tile (mip %u, x=%u, y=%u)",
+                                   GetTiledDDSCompressionName(req.m_TiledLayout->m_Compression), req.m_MipLevel, req.m_TileXInTexels, req.m_TileYInTexels);
+            memset(decoded, 0, tileSize);
+        }
+
+        if (!bInPlace)
+        {
+            for (uint32_t row = 0; row < layout.m_NumRows; row++)
+                memcpy(dst + (size_t)row * cr.m_RowPitch, decoded + (size_t)row * layout.m_RowBytes, layout.m_RowBytes);
+        }
+
+        // The black stand-in is uploaded but not cached
+        if (!bDecoded)
+            cr.m_CacheData.clear();
+
+        m_DecodeTicks.fetch_add(SDL_GetPerformanceCounter() - start, std::memory_order_relaxed);
+        m_BytesDecoded.fetch_add(tileSize, std::memory_order_relaxed);
+        m_NumCompressedTiles.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void AsyncTileIO::CompleteBatch(WorkerScratch& scratch)
+    {
+        const uint32_t count = static_cast<uint32_t>(scratch.m_Batch.size());
+
+        const uint64_t now = SDL_GetPerformanceCounter();
+        uint64_t latencyTicks = 0;
+        for (const CompletedRequest& cr : scratch.m_Batch)
+            latencyTicks += now - cr.m_Request.m_SubmitTicks;
+        m_LatencyTicks.fetch_add(latencyTicks, std::memory_order_relaxed);
+
+        // ── Push to completed queue ──
+        {
+            std::lock_guard<std::mutex> lock(m_CompletedMutex);
+            for (CompletedRequest& cr : scratch.m_Batch)
+                m_CompletedQueue.push_back(std::move(cr));
+        }
+
+        scratch.m_Batch.clear();
+
+        m_NumTilesRead.fetch_add(count, std::memory_order_relaxed);
+        if (m_PendingCount.fetch_sub(count, std::memory_order_acq_rel) == count)
+        {
+            std::lock_guard<std::mutex> lock(m_PendingMutex);
+            m_IdleCV.notify_all();
         }
     }
 
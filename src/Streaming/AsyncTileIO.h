@@ -1,14 +1,19 @@
 #pragma once
 
+#include "../TaskScheduler.h"
 #include "../Utilities.h"
+#include "TileCache.h"
+#include "TileReadCoalescer.h"
+#include "TileStagingRing.h"
+#include "TiledDDS.h"
 #include "srrhi/cpp/Common.h"
 
 namespace nvfeedback
 {
     // ─── TileRequest ─────────────────────────────────────────────────────────
     // Describes a single tile that needs its data loaded from disk and uploaded
-    // to the GPU.  Submitted to AsyncTileIO::Submit() and completed via the
-    // callback on the main thread during Flush().
+    // to the GPU.  Submitted to AsyncTileIO::Submit(); the upload is recorded
+    // on the main thread during Flush().
     // ─────────────────────────────────────────────────────────────────────────
 
     struct TileRequest
@@ -16,6 +21,10 @@ namespace nvfeedback
         // Source DDS data (kept alive by the StreamingTexture::m_SourceData shared_ptr)
         std::shared_ptr<MemoryMappedDataReader> m_SourceData;
 
+        // Tile table when m_SourceData is a .tdds (each tile is one contiguous range).
+        // Null for linear DDS sources.
+        std::shared_ptr<const TiledDDSLayout> m_TiledLayout;
+
         // Destination reserved texture
         nvrhi::TextureHandle m_ReservedTexture;
 
@@ -32,6 +41,7 @@ namespace nvfeedback
 
         // Cached mip data offsets (fixed-size array; indexed by m_MipLevel).
         // Filled from StreamingTexture::m_MipDataOffsets at submit time.
+        // Unused for standard mips of a .tdds source.
         size_t m_MipOffsets[srrhi::CommonConsts::MAX_MIP_COUNT] = {};
 
         // Format info (filled from nvrhi::getFormatInfo)
@@ -39,74 +49,252 @@ namespace nvfeedback
         uint32_t m_BytesPerBlock     = 0;
         uint32_t m_BlockSize         = 0;   // 4 for BC, 1 for uncompressed
 
-        // Completion callback — called on the main thread in Flush().
-        // Receives the active command list for recording writeTexture calls.
-        // The callback receives the tile data pointer and its byte size.
-        std::function<void(const TileRequest&, const void* tileData, size_t tileDataSize, nvrhi::ICommandList* cmd)> m_OnComplete;
+        // Set by Submit() (SDL performance counter), for the completion latency stat
+        uint64_t m_SubmitTicks       = 0;
+
+        // Caller's tag, handed back by Flush() with the bytes read for the tile
+        // (the renderer passes the FeedbackManager texture index)
+        uint32_t m_UserTag           = UINT32_MAX;
+    };
+
+    // Source bytes one flushed request read: 0 when served from the TileCache,
+    // the stored size (compressed for compressed .tdds tiles) otherwise.
+    struct CompletedTileRead
+    {
+        uint32_t m_UserTag   = UINT32_MAX;
+        uint32_t m_BytesRead = 0;
     };
 
+    // ─── Source page-cache hints ──────────────────────────────────────────────
+    // Mip ranges [firstMip, endMip) of a mmap'd DDS, using the per-mip offsets
+    // cached in StreamingTexture::m_MipDataOffsets.  Prefetch starts an async
+    // read of the source pages; Evict drops them from the resident set once no
+    // tile of those mips is mapped any more.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    void PrefetchMipRange(const MemoryMappedDataReader& source, const size_t* mipOffsets, uint32_t numMips, uint32_t firstMip, uint32_t endMip);
+    void EvictMipRange(const MemoryMappedDataReader& source, const size_t* mipOffsets, uint32_t numMips, uint32_t firstMip, uint32_t endMip);
+
     // ─── AsyncTileIO ─────────────────────────────────────────────────────────
     // Thread-pool based async tile I/O.
     //
+    // Workers are either private threads or tasks on the I/O lane of a shared
+    // TaskScheduler.  A lane task processes one batch and re-queues itself while
+    // requests are left, so other I/O work on the lane interleaves with tile
+    // reads; at most as many run at once as the lane has threads.
+    //
     // Usage pattern (per frame):
     //   1. Submit() one TileRequest per tile that needs loading.
-    //   2. Worker threads extract tile data from the mmap'd DDS into per-thread
-    //      scratch buffers.
-    //   3. Flush() on the main thread drains all completed requests and fires
-    //      their m_OnComplete callbacks (which call cmd->writeTexture).
+    //   2. Worker threads de-tile the rows straight into a TileStagingRing
+    //      allocation (one copy per tile).  When the ring is full they fall
+    //      back to a pooled CPU buffer.
+    //   3. Flush() on the main thread drains all completed requests and records
+    //      one CopyTextureRegion per staged tile (writeTexture for fallback
+    //      tiles), then retires staging ranges the GPU has finished with.
+    //
+    // Backends:
+    //   MemoryMapped — rows are copied straight out of the mmap'd DDS.  Cold
+    //                  tiles cost a burst of synchronous page faults.
+    //                  With a .tdds source a tile is one contiguous range.
+    //   ExplicitRead — each worker takes up to queueDepth requests at a time,
+    //                  computes every tile row's byte range, sorts them and
+    //                  coalesces neighbours (gaps up to kMaxCoalesceGapBytes
+    //                  are read through) into a few large positional reads
+    //                  (TileReadCoalescer; TileIOBench measures both backends).
+    //                  Short reads fall back to the mapping.  A .tdds tile
+    //                  is a single aligned read.
     //
-    // Thread safety:
-    //   Submit() and Flush() must be called from the main thread only.
-    //   Worker threads only read from the mmap'd DDS and write to their own
-    //   scratch buffers — no shared mutable state.
+    // Compressed .tdds tiles (LZ4/Zstd) are decoded on the worker, straight into
+    // the staging allocation when its row pitch equals the tile's (every full BC
+    // tile), otherwise through a per-worker scratch buffer.
+    //
+    // With a TileCache, a batch first copies every cached tile out of host memory;
+    // only the misses are read, and each one is also kept, decoded, in the cache.
+    //
+    // Threading contract:
+    //   Every public member, the constructor and the destructor are called from
+    //   one owner thread: the thread that created the AsyncTileIO (the renderer's
+    //   main thread).  Submit(), Flush(), WaitIdle() and the destructor assert it.
+    //   Everything else runs on the workers, which only read the sources and
+    //   write their own scratch and tile destinations; the queues, the tile
+    //   buffer pool and the TileCache carry their own locks.
     // ─────────────────────────────────────────────────────────────────────────
 
     class AsyncTileIO
     {
     public:
-        AsyncTileIO();
+        enum class IOBackend : uint8_t
+        {
+            MemoryMapped,
+            ExplicitRead,
+        };
+
+        static constexpr uint32_t kDefaultQueueDepth     = 32;
+        static constexpr size_t   kMaxCoalesceGapBytes   = kTileReadMaxGapBytes;
+        static constexpr size_t   kMaxCoalescedReadBytes = kTileReadMaxBytes;
+        // Fallback tile buffers kept for reuse once their uploads have been recorded.
+        static constexpr uint32_t kMaxPooledTileBuffers  = 256;
+        // StreamingBudgets' default m_MaxTilesPerFrame 64 KB tiles, recorded one frame
+        // after submission and alive for kStagingRetireLatencyFrames more.
+        static constexpr uint64_t kDefaultStagingRingBytes = 32ull * 1024 * 1024;
+        // Frames after Flush() before a staging range may be overwritten (kNumFramesInFlight).
+        static constexpr uint32_t kStagingRetireLatencyFrames = 3;
+
+        // device may be null, in which case every tile takes the CPU buffer + writeTexture path.
+        // tileCacheBytes = 0 disables the host-memory TileCache.
+        // With ioLane the workers run on its I/O lane, otherwise on private threads.
+        AsyncTileIO(nvrhi::IDevice* device, IOBackend backend = IOBackend::MemoryMapped, uint32_t queueDepth = kDefaultQueueDepth,
+                    uint64_t stagingRingBytes = kDefaultStagingRingBytes, uint64_t tileCacheBytes = 0, TaskScheduler* ioLane = nullptr);
         ~AsyncTileIO();
 
         // Submit a tile request for async processing.
-        // Thread-safe: may be called from the main thread while workers run.
         void Submit(TileRequest request);
 
-        // Drain all completed requests and fire their onComplete callbacks.
-        // cmd is the active command list used to record writeTexture calls.
-        // Must be called from the main thread.
-        // Returns the number of completed requests processed.
-        uint32_t Flush(nvrhi::ICommandList* cmd);
+        // Drain all completed requests and record their uploads into cmd.
+        // A null cmd discards them (shutdown).
+        // Returns the number of completed requests processed; outReads, when given,
+        // receives one entry per processed request.
+        uint32_t Flush(nvrhi::ICommandList* cmd, uint64_t frameNumber, std::vector<CompletedTileRead>* outReads = nullptr);
 
-        // Block until all pending requests are complete.
+        // Block until all pending requests are complete.  Sleeps on a condition
+        // variable.
         void WaitIdle();
 
         // Number of requests currently in flight (submitted but not yet flushed).
         uint32_t PendingCount() const { return m_PendingCount.load(std::memory_order_relaxed); }
 
-        // Number of worker threads.
-        uint32_t WorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+        // Number of workers that can run at once (private threads or I/O lane threads).
+        uint32_t WorkerCount() const { return m_NumWorkers; }
+
+        IOBackend GetBackend() const    { return m_Backend; }
+        uint32_t  GetQueueDepth() const { return m_QueueDepth; }
+
+        // Null when created without a device (or when its buffer could not be created).
+        const TileStagingRing* GetStagingRing() const { return m_StagingRing.get(); }
+
+        // Null when created without a tile cache.
+        const TileCache* GetTileCache() const { return m_TileCache.get(); }
+
+        // Cumulative source I/O.  m_NumReads counts positional reads (ExplicitRead)
+        // or contiguous byte ranges copied out of the mapping (MemoryMapped).
+        // m_ReadSeconds is worker time spent fetching source bytes (ReadAt, or the
+        // copy out of the mapping for uncompressed tiles); m_DecodeSeconds is worker
+        // time spent decompressing, which on the mmap path includes the page faults
+        // on the compressed bytes.  Both are summed over workers, so bytes / seconds
+        // is per-core throughput.  m_BusySeconds is all worker time spent on batches
+        // (tiles / m_BusySeconds * workers is the I/O capacity); m_LatencySeconds sums
+        // each tile's submit-to-completion time (/ m_NumTiles is the mean latency).
+        // m_NumCachedTiles of m_NumTiles were copied from the TileCache and took no
+        // reads or decoding.
+        struct IOStats
+        {
+            uint64_t m_NumTiles           = 0;
+            uint64_t m_NumCachedTiles     = 0;
+            uint64_t m_NumReads           = 0;
+            uint64_t m_BytesRead          = 0; // bytes fetched from the source (compressed size for compressed tiles)
+            uint64_t m_NumCompressedTiles = 0;
+            uint64_t m_BytesDecoded       = 0; // decompressed bytes produced
+            double   m_ReadSeconds        = 0.0;
+            double   m_DecodeSeconds      = 0.0;
+            double   m_BusySeconds        = 0.0;
+            double   m_LatencySeconds     = 0.0;
+        };
+        IOStats GetIOStats() const;
 
     private:
         struct CompletedRequest
         {
             TileRequest m_Request;
-            std::vector<uint8_t> m_TileData;  // extracted tile bytes
+
+            // Exactly one of these holds the de-tiled rows
+            TileStagingRing::Allocation m_Staging;
+            std::vector<uint8_t>        m_TileData;  // fallback when the ring is full (pooled)
+            uint32_t                    m_RowPitch = 0;
+
+            // TileCache: served from the cache, or the packed rows to insert after the read
+            bool                        m_bFromCache = false;
+            std::vector<uint8_t>        m_CacheData;
+        };
+
+        // Per-worker state, reused across batches.
+        struct WorkerScratch
+        {
+            std::vector<CompletedRequest> m_Batch;
+            std::vector<TileReadSpan>     m_Spans;
+            std::vector<TileRead>         m_Reads;
+            std::vector<uint8_t>          m_ReadBuffer;
+            std::vector<uint8_t>          m_DecodeBuffer; // decoded tile when the destination row pitch is padded
         };
 
         void WorkerLoop();
+        void LaneWorker();
+        void TakeBatch(WorkerScratch& scratch); // m_PendingMutex held
+        void ProcessBatch(WorkerScratch& scratch);
+        void AllocateTileDestinations(WorkerScratch& scratch);
+        void LookupTileCache(WorkerScratch& scratch);
+        void FillTileCache(WorkerScratch& scratch);
+        void ProcessBatchMapped(WorkerScratch& scratch);
+        void ProcessBatchExplicit(WorkerScratch& scratch);
+        void CompleteBatch(WorkerScratch& scratch);
+
+        // Decompresses a stored .tdds tile (src) into the tile destination of cr.
+        void DecodeTile(WorkerScratch& scratch, CompletedRequest& cr, const uint8_t* src, uint32_t storedSize);
+
+        bool IsOwnerThread() const { return std::this_thread::get_id() == m_OwnerThread; }
+
+        uint8_t* GetTileDestination(CompletedRequest& cr) const;
+        void     RecordTileUpload(nvrhi::ICommandList* cmd, const CompletedRequest& cr) const;
+
+        std::vector<uint8_t> AcquireTileBuffer(size_t size);
+
+        // Creates and persistently maps the upload buffer behind m_StagingRing.
+        bool CreateStagingBuffer(nvrhi::IDevice* device, uint64_t sizeBytes);
+
+        const std::thread::id m_OwnerThread = std::this_thread::get_id();
+
+        IOBackend      m_Backend    = IOBackend::MemoryMapped;
+        uint32_t       m_QueueDepth = kDefaultQueueDepth;
+        TaskScheduler* m_IOLane     = nullptr;
+        uint32_t       m_NumWorkers = 0;
+
+        std::unique_ptr<TileStagingRing> m_StagingRing;
+        nvrhi::IDevice*                  m_StagingDevice = nullptr;
+        nvrhi::BufferHandle              m_StagingBuffer;
+        uint8_t*                         m_StagingData   = nullptr;
+        std::unique_ptr<TileCache>       m_TileCache;
 
         // Pending queue (main thread → workers)
         std::queue<TileRequest>  m_PendingQueue;
         mutable std::mutex       m_PendingMutex;
         std::condition_variable  m_PendingCV;
+        // Signalled under m_PendingMutex when m_PendingCount or m_NumLaneWorkers reaches 0
+        std::condition_variable  m_IdleCV;
+
+        // I/O lane: tasks queued or running, and the scratch of idle ones (guarded by m_PendingMutex)
+        uint32_t                                    m_NumLaneWorkers = 0;
+        std::vector<std::unique_ptr<WorkerScratch>> m_LaneScratch;
 
         // Completed vector (workers → main thread, fully drained each frame)
         std::vector<CompletedRequest> m_CompletedQueue;
         mutable std::mutex            m_CompletedMutex;
 
+        // Tile buffers returned by Flush() (guarded by m_CompletedMutex)
+        std::vector<std::vector<uint8_t>> m_FreeTileBuffers;
+
         std::vector<std::thread> m_Workers;
         std::atomic<bool>        m_bShutdown{ false };
         std::atomic<uint32_t>    m_PendingCount{ 0 };
+
+        std::atomic<uint64_t>    m_NumTilesRead{ 0 };
+        std::atomic<uint64_t>    m_NumCachedTiles{ 0 };
+        std::atomic<uint64_t>    m_NumReads{ 0 };
+        std::atomic<uint64_t>    m_BytesRead{ 0 };
+        std::atomic<uint64_t>    m_NumCompressedTiles{ 0 };
+        std::atomic<uint64_t>    m_BytesDecoded{ 0 };
+        std::atomic<uint64_t>    m_ReadTicks{ 0 };    // SDL performance counter ticks
+        std::atomic<uint64_t>    m_DecodeTicks{ 0 };
+        std::atomic<uint64_t>    m_BusyTicks{ 0 };
+        std::atomic<uint64_t>    m_LatencyTicks{ 0 };
     };
 
 } // namespace nvfeedback
@@ -0,0 +1,131 @@
+#include "DirtyTextureList.h"
+
+#include <algorithm>
+
+namespace nvfeedback
+{
+    void DirtyTextureList::AddTexture()
+    {
+        // AddTiledTexture() requests the packed tiles
+        m_Entries.emplace_back();
+        MarkDirty((uint32_t)m_Entries.size() - 1);
+    }
+
+    void DirtyTextureList::RemoveTexture(uint32_t textureIdx)
+    {
+        if (textureIdx >= m_Entries.size())
+            return;
+
+        RemoveResident(textureIdx);
+        if (m_Entries[textureIdx].m_bDirty)
+            std::erase(m_Dirty, textureIdx);
+        m_Entries.erase(m_Entries.begin() + textureIdx);
+
+        // Shifting keeps both lists' relative order, so m_bSorted still holds
+        for (uint32_t& idx : m_Dirty)
+        {
+            if (idx > textureIdx)
+                --idx;
+        }
+        for (uint32_t& idx : m_Resident)
+        {
+            if (idx > textureIdx)
+                --idx;
+        }
+    }
+
+    void DirtyTextureList::MarkDirty(uint32_t textureIdx)
+    {
+        Entry& entry = m_Entries[textureIdx];
+        if (entry.m_bDirty)
+            return;
+
+        entry.m_bDirty = true;
+        if (!m_Dirty.empty() && m_Dirty.back() > textureIdx)
+            m_bSorted = false;
+        m_Dirty.push_back(textureIdx);
+    }
+
+    void DirtyTextureList::MarkResidentDirty()
+    {
+        for (uint32_t textureIdx : m_Resident)
+            MarkDirty(textureIdx);
+    }
+
+    void DirtyTextureList::MarkAllDirty()
+    {
+        for (uint32_t textureIdx = 0; textureIdx < (uint32_t)m_Entries.size(); ++textureIdx)
+            MarkDirty(textureIdx);
+    }
+
+    void DirtyTextureList::OnTilesAllocated(uint32_t textureIdx, uint32_t numTiles)
+    {
+        Entry& entry = m_Entries[textureIdx];
+        if (numTiles == 0)
+            return;
+
+        if (entry.m_ResidentPos == kNotResident)
+        {
+            entry.m_ResidentPos = (uint32_t)m_Resident.size();
+            m_Resident.push_back(textureIdx);
+        }
+        entry.m_NumAllocatedTiles += numTiles;
+    }
+
+    void DirtyTextureList::OnTilesUnmapped(uint32_t textureIdx, uint32_t numTiles)
+    {
+        Entry& entry = m_Entries[textureIdx];
+        entry.m_NumAllocatedTiles -= std::min(numTiles, entry.m_NumAllocatedTiles);
+        if (entry.m_NumAllocatedTiles == 0)
+            RemoveResident(textureIdx);
+    }
+
+    void DirtyTextureList::RemoveResident(uint32_t textureIdx)
+    {
+        Entry& entry = m_Entries[textureIdx];
+        if (entry.m_ResidentPos == kNotResident)
+            return;
+
+        // Swap-remove; the order of m_Resident does not matter
+        const uint32_t lastIdx = m_Resident.back();
+        m_Resident[entry.m_ResidentPos] = lastIdx;
+        m_Entries[lastIdx].m_ResidentPos = entry.m_ResidentPos;
+        m_Resident.pop_back();
+
+        entry.m_ResidentPos       = kNotResident;
+        entry.m_NumAllocatedTiles = 0;
+    }
+
+    std::span<const uint32_t> DirtyTextureList::GetDirtyTextures()
+    {
+        if (!m_bSorted)
+        {
+            // Most textures dirty (trims while the heaps stay exhausted): reading
+            // the flags back in index order is linear, sorting is not
+            if (m_Dirty.size() > m_Entries.size() / 16)
+            {
+                m_Dirty.clear();
+                for (uint32_t textureIdx = 0; textureIdx < (uint32_t)m_Entries.size(); ++textureIdx)
+                {
+                    if (m_Entries[textureIdx].m_bDirty)
+                        m_Dirty.push_back(textureIdx);
+                }
+            }
+            else
+            {
+                std::sort(m_Dirty.begin(), m_Dirty.end());
+            }
+            m_bSorted = true;
+        }
+        return m_Dirty;
+    }
+
+    void DirtyTextureList::Clear()
+    {
+        for (uint32_t textureIdx : m_Dirty)
+            m_Entries[textureIdx].m_bDirty = false;
+        m_Dirty.clear();
+        m_bSorted = true;
+    }
+
+} // namespace nvfeedback
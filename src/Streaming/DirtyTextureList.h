@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace nvfeedback
+{
+    // ─── DirtyTextureList ────────────────────────────────────────────────────
+    // Textures that may have tiles for TTM's GetTilesToUnmap()/GetTilesToMap(),
+    // so BeginFrame's collection step visits those instead of every texture.
+    //
+    // TTM only changes a texture's tile states in three ways:
+    //   - AddTiledTexture() and UpdateWithSamplerFeedback() on that texture (new
+    //     requests, hysteresis timeouts): AddTexture() starts out dirty, MarkDirty()
+    //     after every feedback and prefetch update,
+    //   - TrimStandbyTiles(), which frees standby (standard) tiles of any texture
+    //     that has some allocated: MarkResidentDirty() whenever it has work, and
+    //     DefragmentTiles(), which may move packed tiles as well: MarkAllDirty(),
+    //   - AllocateRequestedTiles(), which serves requests from earlier feedback
+    //     updates.  While the heaps are exhausted requests can stay behind, so
+    //     the list is only cleared after a collection pass that left free heap
+    //     tiles (see FeedbackManager::BeginFrame).
+    // A texture counts as resident from the first standard tile it is handed
+    // by GetTilesToMap() until GetTilesToUnmap() has returned as many.
+    //
+    // Per-texture flags and the resident-list position live in one entry per
+    // texture, so marking is O(1) and never hashes.  Indices follow the
+    // FeedbackManager's: RemoveTexture() shifts later ones down.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    class DirtyTextureList
+    {
+    public:
+        // Registers the texture at index GetNumTextures().
+        void AddTexture();
+        void RemoveTexture(uint32_t textureIdx);
+
+        void MarkDirty(uint32_t textureIdx);
+        void MarkResidentDirty();
+        void MarkAllDirty();
+
+        // Standard tiles handed out by GetTilesToMap() / taken back by GetTilesToUnmap()
+        void OnTilesAllocated(uint32_t textureIdx, uint32_t numTiles);
+        void OnTilesUnmapped(uint32_t textureIdx, uint32_t numTiles);
+
+        // Dirty textures in ascending index order, the order of a full scan.
+        std::span<const uint32_t> GetDirtyTextures();
+        void Clear();
+
+        uint32_t GetNumTextures() const         { return (uint32_t)m_Entries.size(); }
+        uint32_t GetNumDirtyTextures() const    { return (uint32_t)m_Dirty.size(); }
+        uint32_t GetNumResidentTextures() const { return (uint32_t)m_Resident.size(); }
+
+    private:
+        static constexpr uint32_t kNotResident = UINT32_MAX;
+
+        struct Entry
+        {
+            uint32_t m_NumAllocatedTiles = 0;
+            uint32_t m_ResidentPos       = kNotResident; // index into m_Resident
+            bool     m_bDirty            = false;
+        };
+
+        void RemoveResident(uint32_t textureIdx);
+
+        std::vector<Entry>    m_Entries;
+        std::vector<uint32_t> m_Dirty;
+        std::vector<uint32_t> m_Resident;
+        bool                  m_bSorted = true;
+    };
+
+} // namespace nvfeedback
@@ -1,11 +1,44 @@
 #include "FeedbackManager.h"
 #include "Renderer.h"
+#include "Log.h"
 
 #include "d3d12.h"
 
 namespace nvfeedback
 {
-    const uint64_t kHeapSizeInBytes = kHeapSizeInTiles * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+    static_assert(kTileSizeInBytes == D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES);
+
+    // Updates TextureStreamingStats::m_FinestRequestedMip and the stretches spent below
+    // the requested mip after the feedback or the MinMip snapshot changed.
+    static void UpdateRequestedMipStats(FeedbackTexture& texture, uint64_t now)
+    {
+        const FeedbackTexture::FeedbackSnapshot& snapshot = texture.GetFeedbackSnapshot();
+        TextureStreamingStats& stats = texture.GetStreamingStats();
+        const uint8_t numStandardMips = (uint8_t)texture.GetPackedMipInfo().numStandardMips;
+        const bool bHasResident = snapshot.m_Resident.size() == snapshot.m_Requested.size();
+
+        bool bBelowRequested = false;
+        for (size_t region = 0; region < snapshot.m_Requested.size(); ++region)
+        {
+            const uint8_t requested = snapshot.m_Requested[region];
+            if (requested >= numStandardMips)
+                continue;
+
+            stats.m_FinestRequestedMip = std::min(stats.m_FinestRequestedMip, requested);
+            const uint8_t resident = bHasResident ? snapshot.m_Resident[region] : numStandardMips;
+            bBelowRequested |= resident > requested;
+        }
+
+        if (bBelowRequested && stats.m_BelowRequestedSince == 0)
+        {
+            stats.m_BelowRequestedSince = now;
+        }
+        else if (!bBelowRequested && stats.m_BelowRequestedSince != 0)
+        {
+            stats.m_BelowRequestedTicks += now - stats.m_BelowRequestedSince;
+            stats.m_BelowRequestedSince = 0;
+        }
+    }
 
     // ─── HeapAllocator ───────────────────────────────────────────────────────
     uint32_t HeapAllocator::AllocateHeap()
@@ -13,12 +46,12 @@ namespace nvfeedback
         nvrhi::IDevice* device = g_Renderer.m_RHI->m_NvrhiDevice;
 
         nvrhi::HeapDesc heapDesc{};
-        heapDesc.capacity = kHeapSizeInBytes;
+        heapDesc.capacity = m_HeapSizeInBytes;
         heapDesc.type = nvrhi::HeapType::DeviceLocal;
         nvrhi::HeapHandle heap = device->createHeap(heapDesc);
 
         nvrhi::BufferDesc bufferDesc{};
-        bufferDesc.byteSize = kHeapSizeInBytes;
+        bufferDesc.byteSize = m_HeapSizeInBytes;
         bufferDesc.isVirtual = true;
         bufferDesc.initialState = nvrhi::ResourceStates::CopySource;
         bufferDesc.keepInitialState = true;
@@ -35,8 +68,8 @@ namespace nvfeedback
 
             if constexpr (kStreamingDebugLog)
             {
-                SDL_Log("[Streaming][Heap] AllocateHeap: new slot %u (total heaps: %u, VRAM: %.2f MB)",
-                        heapId, m_NumHeaps + 1, BYTES_TO_MB(m_TotalAllocatedBytes + kHeapSizeInBytes));
+                LOG_INFO("[Streaming][Heap] AllocateHeap: new slot %u (total heaps: %u, VRAM: %.2f MB)",
+                        heapId, m_NumHeaps + 1, BYTES_TO_MB(m_TotalAllocatedBytes + m_HeapSizeInBytes));
             }
         }
         else
@@ -48,12 +81,12 @@ namespace nvfeedback
 
             if constexpr (kStreamingDebugLog)
             {
-                SDL_Log("[Streaming][Heap] AllocateHeap: reuse slot %u from free list (total heaps: %u, VRAM: %.2f MB)",
-                        heapId, m_NumHeaps + 1, BYTES_TO_MB(m_TotalAllocatedBytes + kHeapSizeInBytes));
+                LOG_INFO("[Streaming][Heap] AllocateHeap: reuse slot %u from free list (total heaps: %u, VRAM: %.2f MB)",
+                        heapId, m_NumHeaps + 1, BYTES_TO_MB(m_TotalAllocatedBytes + m_HeapSizeInBytes));
             }
         }
 
-        m_TotalAllocatedBytes += kHeapSizeInBytes;
+        m_TotalAllocatedBytes += m_HeapSizeInBytes;
         m_NumHeaps++;
 
         return heapId;
@@ -63,7 +96,7 @@ namespace nvfeedback
     {
         if constexpr (kStreamingDebugLog)
         {
-            SDL_Log("[Streaming][Heap] ReleaseHeap: heapId=%u frameIndex=%u bucket=%u "
+            LOG_INFO("[Streaming][Heap] ReleaseHeap: heapId=%u frameIndex=%u bucket=%u "
                     "(old Heaps[%u]=%p, VRAM before: %.2f MB) — deferred destroy, "
                     "WARNING: if any tiles are still mapped to this heap the GPU will TDR!",
                     heapId, frameIndex, frameIndex % kNumFramesInFlight,
@@ -81,12 +114,12 @@ namespace nvfeedback
         m_Heaps[heapId] = nullptr;
         m_Buffers[heapId] = nullptr;
 
-        m_TotalAllocatedBytes -= kHeapSizeInBytes;
+        m_TotalAllocatedBytes -= m_HeapSizeInBytes;
         m_NumHeaps--;
 
         if constexpr (kStreamingDebugLog)
         {
-            SDL_Log("[Streaming][Heap] ReleaseHeap: heapId=%u done (VRAM after: %.2f MB, in-use heaps: %u)",
+            LOG_INFO("[Streaming][Heap] ReleaseHeap: heapId=%u done (VRAM after: %.2f MB, in-use heaps: %u)",
                     heapId, BYTES_TO_MB(m_TotalAllocatedBytes), m_NumHeaps);
         }
     }
@@ -100,7 +133,7 @@ namespace nvfeedback
         {
             if constexpr (kStreamingDebugLog)
             {
-                SDL_Log("[Streaming][Heap] DrainReleaseQueue: frameIndex=%u bucket=%u — destroying %zu deferred heap(s) "
+                LOG_INFO("[Streaming][Heap] DrainReleaseQueue: frameIndex=%u bucket=%u — destroying %zu deferred heap(s) "
                         "(these were released %u frames ago, GPU should be done with them)",
                         frameIndex, bucket, numHeaps, kNumFramesInFlight);
             }
@@ -109,7 +142,7 @@ namespace nvfeedback
             {
                 if constexpr (kStreamingDebugLog)
                 {
-                    SDL_Log("[Streaming][Heap] DrainReleaseQueue:   heap handle=%p buffer handle=%p",
+                    LOG_INFO("[Streaming][Heap] DrainReleaseQueue:   heap handle=%p buffer handle=%p",
                             (void*)m_HeapsToRelease[bucket][i].Get(),
                             (void*)m_BuffersToRelease[bucket][i].Get());
                 }
@@ -122,12 +155,14 @@ namespace nvfeedback
 
     // ─── FeedbackManager ─────────────────────────────────────────────────────
 
-    FeedbackManager::FeedbackManager()
+    FeedbackManager::FeedbackManager(uint32_t heapSizeInTiles)
+        : m_HeapSizeInTiles(std::max(heapSizeInTiles, 1u))
+        , m_DefragPlanner(m_HeapSizeInTiles)
     {
-        m_HeapAllocator = std::make_unique<HeapAllocator>();
+        m_HeapAllocator = std::make_unique<HeapAllocator>((uint64_t)m_HeapSizeInTiles * kTileSizeInBytes);
 
         rtxts::TiledTextureManagerDesc tiledTextureManagerDesc{};
-        tiledTextureManagerDesc.heapTilesCapacity = kHeapSizeInTiles;
+        tiledTextureManagerDesc.heapTilesCapacity = m_HeapSizeInTiles;
         m_TiledTextureManager = std::unique_ptr<rtxts::TiledTextureManager>(
             rtxts::CreateTiledTextureManager(tiledTextureManagerDesc));
     }
@@ -140,6 +175,10 @@ namespace nvfeedback
         rawPtr->SetManagerIndex(idx);
         m_Textures.push_back(std::move(feedbackTexture));
         m_TexturesRingbuffer.push_back(idx);
+        m_DirtyTextures.AddTexture();
+        m_bMinMipDirty.push_back(0);
+
+        m_TraceWriter.AddTexture(idx, GetTraceTexture(idx));
 
         return rawPtr;
     }
@@ -169,7 +208,24 @@ namespace nvfeedback
             }
         }
 
-        m_MinMipDirtyTextures.erase(textureIdx);
+        std::erase(m_MinMipDirtyTextures, textureIdx);
+        for (uint32_t& texIdx : m_MinMipDirtyTextures)
+        {
+            if (texIdx > textureIdx)
+                texIdx--;
+        }
+        m_bMinMipDirty.erase(m_bMinMipDirty.begin() + textureIdx);
+        m_DirtyTextures.RemoveTexture(textureIdx);
+        std::erase_if(m_MovedTilesToRemap, [textureIdx](const FeedbackTextureUpdate& moved) { return moved.m_TextureIdx == textureIdx; });
+        for (FeedbackTextureUpdate& moved : m_MovedTilesToRemap)
+        {
+            if (moved.m_TextureIdx > textureIdx)
+                moved.m_TextureIdx--;
+        }
+        m_TileScheduler.RemoveTexture(textureIdx);
+        m_TraceWriter.RemoveTexture(textureIdx);
+        // Indexed by manager index, which shifts below
+        m_PrefetchMips.clear();
 
         // Release ownership — this destroys the FeedbackTexture (and its nvrhi resources)
         m_Textures.erase(m_Textures.begin() + textureIdx);
@@ -179,7 +235,7 @@ namespace nvfeedback
             m_Textures[i]->SetManagerIndex(i);
     }
 
-    void FeedbackManager::BeginFrame(nvrhi::ICommandList* commandList, std::vector<FeedbackTextureUpdate>& results, bool allowHeapRelease)
+    void FeedbackManager::BeginFrame(nvrhi::ICommandList* commandList)
     {
         PROFILE_FUNCTION();
         SimpleTimer timer;
@@ -190,21 +246,55 @@ namespace nvfeedback
         // GPU fence (NumFramesInFlight frames have elapsed).
         m_HeapAllocator->DrainReleaseQueue(m_FrameIndex);
 
+        // ── Step 0: Remap tiles moved last frame ──
+        // Their copies were recorded in last frame's command list, which the queue
+        // already has, so this queue op runs once they are done.  No other tile can
+        // have been written to their old slots yet: TTM hands those out in Step 5 at
+        // the earliest, and data for a tile only lands a frame after it is requested.
+        if (!m_MovedTilesToRemap.empty())
+        {
+            m_TileMappingBatch.Clear();
+            for (const FeedbackTextureUpdate& moved : m_MovedTilesToRemap)
+            {
+                FeedbackTexture* texture = GetTextureByIndex(moved.m_TextureIdx);
+                const std::vector<rtxts::TileCoord>& tileCoords = m_TiledTextureManager->GetTileCoordinates(texture->GetTiledTextureId());
+                const std::vector<FeedbackTexture::TileSlot>& tileSlots = texture->GetTileSlots();
+                for (uint32_t tileIndex : moved.m_TileIndices)
+                {
+                    const FeedbackTexture::TileSlot& slot = tileSlots[tileIndex];
+                    m_TileMappingBatch.Add(moved.m_TextureIdx, tileIndex, tileCoords[tileIndex].mipLevel, slot.m_HeapId, slot.m_HeapTileIndex);
+                }
+            }
+            SubmitTileMappings();
+            m_MovedTilesToRemap.clear();
+        }
+
         // Update TTM config
         rtxts::TiledTextureManagerConfig ttmConfig{};
-        // Standby tiles buffer: up to 64 tiles can be in standby before
-        // TrimStandbyTiles() starts freeing the oldest.  This is necessary
-        // for hysteresis (kTileHysteresisSeconds) to work — with 0, standby
+        // Standby tiles buffer: up to m_NumExtraStandbyTiles tiles can be in standby
+        // before TrimStandbyTiles() starts freeing the oldest.  This is necessary
+        // for hysteresis (m_TileHysteresisSeconds) to work — with 0, standby
         // tiles would be freed immediately and re-requested tiles would have
         // to go through the full allocate+submit+pending+mapping cycle.
-        // 64 tiles ≈ 4 MB of VRAM headroom for hysteresis.
-        ttmConfig.numExtraStandbyTiles = 64;
+        // Low-memory mode drops the standby pool so those tiles go back to the heaps.
+        ttmConfig.numExtraStandbyTiles = m_bLowMemoryMode ? 0 : m_Budgets.m_NumExtraStandbyTiles;
         m_TiledTextureManager->SetConfig(ttmConfig);
 
         // ── Step 1: Read back feedback from N frames ago ──
         std::vector<uint32_t>& readbackTextures = m_TexturesToReadback[m_FrameIndex];
         float timeStamp = static_cast<float>(GetTickCount64()) / 1000.0f;
 
+        if (m_TraceWriter.IsOpen())
+        {
+            StreamingTraceFrame traceFrame;
+            traceFrame.m_FrameNumber    = g_Renderer.m_FrameNumber;
+            traceFrame.m_TimeStamp      = timeStamp;
+            traceFrame.m_Budgets        = m_Budgets;
+            traceFrame.m_MaxTTMHeaps    = (m_MaxTTMHeaps == UINT32_MAX) ? 0 : m_MaxTTMHeaps;
+            traceFrame.m_bLowMemoryMode = m_bLowMemoryMode;
+            m_TraceWriter.BeginFrame(traceFrame);
+        }
+
         if (!readbackTextures.empty())
         {
             PROFILE_SCOPED("Resolve feedback");
@@ -215,13 +305,38 @@ namespace nvfeedback
                     g_Renderer.m_RHI->m_NvrhiDevice->mapBuffer(readbackTexture->GetFeedbackResolveBuffer(m_FrameIndex),
                                         nvrhi::CpuAccessMode::Read));
 
+                // Under VRAM pressure every sampled region asks for a coarser mip, so the finest
+                // tiles time out like unsampled ones.  Everything downstream (TTM, the snapshot
+                // the TileScheduler prioritizes with, the trace) sees the coarsened feedback.
+                const uint32_t numRegions = readbackTexture->GetFeedbackRegionsX() * readbackTexture->GetFeedbackRegionsY();
+                if (m_PressureMipBias > 0)
+                {
+                    const uint32_t numStandardMips = readbackTexture->GetPackedMipInfo().numStandardMips;
+                    m_BiasedFeedback.assign(pReadbackData, pReadbackData + numRegions);
+                    for (uint8_t& mip : m_BiasedFeedback)
+                    {
+                        if (mip < numStandardMips)
+                            mip = (uint8_t)std::min(mip + m_PressureMipBias, numStandardMips);
+                    }
+                    pReadbackData = m_BiasedFeedback.data();
+                }
+
                 rtxts::SamplerFeedbackDesc samplerFeedbackDesc{};
                 samplerFeedbackDesc.pMinMipData = pReadbackData;
                 m_TiledTextureManager->UpdateWithSamplerFeedback(
                     readbackTexture->GetTiledTextureId(),
                     samplerFeedbackDesc,
                     timeStamp,
-                    kTileHysteresisSeconds);
+                    m_Budgets.m_TileHysteresisSeconds);
+
+                // Keep a copy for tile prioritization (screen coverage per region)
+                FeedbackTexture::FeedbackSnapshot& snapshot = readbackTexture->GetFeedbackSnapshot();
+                snapshot.m_Requested.assign(pReadbackData, pReadbackData + numRegions);
+                snapshot.m_RequestedFrame = g_Renderer.m_FrameNumber;
+                UpdateRequestedMipStats(*readbackTexture, SDL_GetPerformanceCounter());
+                m_TraceWriter.Feedback(texIdx, snapshot.m_Requested);
+                m_DirtyTextures.MarkDirty(texIdx);
+                m_TileScheduler.MarkTextureChanged(texIdx);
 
                 g_Renderer.m_RHI->m_NvrhiDevice->unmapBuffer(readbackTexture->GetFeedbackResolveBuffer(m_FrameIndex));
             }
@@ -233,10 +348,14 @@ namespace nvfeedback
         // Re-submitting cached feedback for all textures every frame causes GetNumDesiredHeaps()
         // to reflect the full tile demand of ALL textures simultaneously, driving a burst to
         // 34 heaps instead of the gradual growth to 11 that the references exhibit.
-        // Without re-submission, tiles time out after kTileHysteresisSeconds (1s).
+        // Without re-submission, tiles time out after m_TileHysteresisSeconds (1s by default).
         // With 307 textures at 30/frame the ringbuffer cycle is ~10 frames (~167ms at 60fps),
         // giving 6 full cycles of margin before any tile times out.
 
+        // ── Step 1b: Predicted demand ──
+        // After the real feedback, so TTM sees it as extra demand on top of what is visible.
+        ApplyPrefetchRequests(timeStamp);
+
         // ── Step 2: Collect textures to read back NEXT frame ──
         // Assign to the NEXT slot so that the following frame's Step 1 reads from the
         // correct index (ResolveFeedback also decodes into this next slot).
@@ -245,9 +364,10 @@ namespace nvfeedback
 
             std::vector<uint32_t>& nextReadbackTextures = m_TexturesToReadback[(m_FrameIndex + 1) % kNumFramesInFlight];
             nextReadbackTextures.clear();
+            m_NumTexturesCollected = 0;
             if (!m_TexturesRingbuffer.empty())
             {
-                uint32_t updatesLeft = kFeedbackTexturesToResolvePerFrame;
+                uint32_t updatesLeft = m_Budgets.m_FeedbackTexturesToResolvePerFrame;
                 const uint32_t count = (uint32_t)m_TexturesRingbuffer.size();
                 for (uint32_t i = 0; i < count && updatesLeft > 0; ++i)
                 {
@@ -257,10 +377,14 @@ namespace nvfeedback
                     nextReadbackTextures.push_back(texIdx);
                     updatesLeft--;
                 }
+                m_NumTexturesCollected = (uint32_t)nextReadbackTextures.size();
             }
         }
 
         // ── Step 3: Trim standby tiles ──
+        // Trimmed tiles can belong to any resident texture, not just this frame's dirty ones
+        if (m_TiledTextureManager->GetStatistics().standbyTilesNum > ttmConfig.numExtraStandbyTiles)
+            m_DirtyTextures.MarkResidentDirty();
         m_TiledTextureManager->TrimStandbyTiles();
 
         // ── Step 4: Heap management ──
@@ -270,13 +394,14 @@ namespace nvfeedback
         // counted.  We only add heaps here; we never release them during normal operation.
         // Releasing empty heaps causes a burst-and-shrink pattern (the reference only
         // releases heaps when "compactMemory" is explicitly requested by the user).
-        const uint32_t numRequiredHeaps = m_TiledTextureManager->GetNumDesiredHeaps();
+        // Under VRAM pressure the heap count is capped; tiles beyond the cap stay requested.
+        const uint32_t numRequiredHeaps = std::min(m_TiledTextureManager->GetNumDesiredHeaps(), m_MaxTTMHeaps);
 
         if (numRequiredHeaps > m_NumTTMHeaps)
         {
             if constexpr (kStreamingDebugLog)
             {
-                SDL_Log("[Streaming][Heap] BeginFrame: need %u more TTM heap(s) (required=%u > registered=%u)",
+                LOG_INFO("[Streaming][Heap] BeginFrame: need %u more TTM heap(s) (required=%u > registered=%u)",
                         numRequiredHeaps - m_NumTTMHeaps, numRequiredHeaps, m_NumTTMHeaps);
             }
 
@@ -284,19 +409,20 @@ namespace nvfeedback
             {
                 uint32_t heapId = m_HeapAllocator->AllocateHeap();
                 m_TiledTextureManager->AddHeap(heapId);
+                m_DefragPlanner.AddHeap(heapId, false);
                 m_NumTTMHeaps++;
 
                 if constexpr (kStreamingDebugLog)
                 {
-                    SDL_Log("[Streaming][Heap] BeginFrame: added heapId=%u to TTM (TTM-registered=%u, total=%u)",
+                    LOG_INFO("[Streaming][Heap] BeginFrame: added heapId=%u to TTM (TTM-registered=%u, total=%u)",
                             heapId, m_NumTTMHeaps, m_HeapAllocator->GetNumHeaps());
                 }
             }
         }
-        else if (allowHeapRelease)
+        else if (m_TileScheduler.IsEmpty() || m_bLowMemoryMode)
         {
             // Only release empty heaps when there are no pending tile uploads.
-            // While m_PendingTileRequests is non-empty, TTM has already allocated
+            // While the TileScheduler is non-empty, TTM has already allocated
             // heap slots for those tiles; releasing an empty heap now and
             // re-allocating it next frame produces the grow-shrink pattern.
             std::vector<uint32_t> emptyHeaps;
@@ -304,8 +430,9 @@ namespace nvfeedback
             for (uint32_t heapId : emptyHeaps)
             {
                 if constexpr (kStreamingDebugLog)
-                    SDL_Log("[Streaming][Heap] BeginFrame: releasing empty TTM heapId=%u", heapId);
+                    LOG_INFO("[Streaming][Heap] BeginFrame: releasing empty TTM heapId=%u", heapId);
                 m_TiledTextureManager->RemoveHeap(heapId);
+                m_DefragPlanner.RemoveHeap(heapId);
                 m_HeapAllocator->ReleaseHeap(heapId, m_FrameIndex);
                 m_NumTTMHeaps--;
             }
@@ -314,143 +441,534 @@ namespace nvfeedback
         // ── Step 5: Allocate requested tiles ──
         m_TiledTextureManager->AllocateRequestedTiles();
 
-        // ── Step 6: Collect tiles to unmap and map ──
-        std::vector<uint32_t> tilesRequestedNew;
-        std::vector<uint32_t> tilesToUnmap;
+        // ── Step 5b: Defragmentation ──
+        // Moving tiles used to show as a brief drop to a coarser mip while they were
+        // streamed in again.  Now Step 6 copies a moved tile's data on the GPU and the
+        // texture keeps sampling the old slot until next frame's Step 0 remaps it.
+        // TileDefragPlanner only lets it run when it empties a nearly empty heap.
+        {
+            const TileDefragPlan plan = m_DefragPlanner.Plan(kMaxDefragMovesPerFrame, m_bLowMemoryMode);
+            if (plan.m_NumTilesToMove > 0)
+            {
+                m_TiledTextureManager->DefragmentTiles(plan.m_NumTilesToMove);
+                m_DirtyTextures.MarkAllDirty();
+            }
+        }
 
+        // ── Step 6: Collect tiles to unmap and map ──
+        // Only textures on the dirty list can have any (see DirtyTextureList).  The unmaps
+        // of every texture go out together through SubmitTileMappings, as merged runs.
         {
             PROFILE_SCOPED("Collect tiles to unmap/map");
 
-            for (uint32_t texIdx = 0; texIdx < (uint32_t)m_Textures.size(); ++texIdx)
+            std::vector<uint32_t>& tilesToUnmap = m_TilesToUnmap;
+            std::vector<uint32_t>& tilesRequestedNew = m_TilesRequestedNew;
+            m_TileMappingBatch.Clear();
+
+            m_NumDirtyTexturesScanned = m_DirtyTextures.GetNumDirtyTextures();
+            for (uint32_t texIdx : m_DirtyTextures.GetDirtyTextures())
             {
                 FeedbackTexture* feedbackTexture = m_Textures.at(texIdx).get();
                 // Unmap tiles
+                tilesToUnmap.clear();
                 m_TiledTextureManager->GetTilesToUnmap(feedbackTexture->GetTiledTextureId(), tilesToUnmap);
                 if (!tilesToUnmap.empty())
                 {
                     const std::vector<rtxts::TileCoord>& tileCoords = m_TiledTextureManager->GetTileCoordinates(feedbackTexture->GetTiledTextureId());
-                    uint32_t tileToUnmapNum = (uint32_t)tilesToUnmap.size();
-
-                    nvrhi::TiledTextureRegion tiledTextureRegion{};
-                    tiledTextureRegion.tilesNum = 1;
+                    for (uint32_t tileIndex : tilesToUnmap)
+                        m_TileMappingBatch.AddUnmap(texIdx, tileIndex, tileCoords[tileIndex].mipLevel);
+                    MarkMinMipDirty(texIdx);
 
-                    nvrhi::TextureTilesMapping textureTilesMapping{};
-                    textureTilesMapping.numTextureRegions = tileToUnmapNum;
-                    std::vector<nvrhi::TiledTextureCoordinate> tiledTextureCoordinates(tileToUnmapNum);
-                    std::vector<nvrhi::TiledTextureRegion> tiledTextureRegions(tileToUnmapNum, tiledTextureRegion);
-                    textureTilesMapping.tiledTextureCoordinates = tiledTextureCoordinates.data();
-                    textureTilesMapping.tiledTextureRegions = tiledTextureRegions.data();
+                    // TTM gave these tiles' heap slots back: a pending load would map
+                    // data into a slot that may already belong to another tile.
+                    m_TileScheduler.Cancel(texIdx, tilesToUnmap);
+                    m_DirtyTextures.OnTilesUnmapped(texIdx, (uint32_t)tilesToUnmap.size());
 
-                    uint32_t tilesProcessedNum = 0;
+                    std::vector<FeedbackTexture::TileSlot>& tileSlots = feedbackTexture->GetTileSlots();
+                    TextureStreamingStats& texStats = feedbackTexture->GetStreamingStats();
+                    texStats.m_TilesEvicted += tilesToUnmap.size();
                     for (uint32_t tileIndex : tilesToUnmap)
                     {
-                        nvrhi::TiledTextureCoordinate& coord = tiledTextureCoordinates[tilesProcessedNum];
-                        coord.mipLevel = tileCoords[tileIndex].mipLevel;
-                        coord.arrayLevel = 0;
-                        coord.x = tileCoords[tileIndex].x;
-                        coord.y = tileCoords[tileIndex].y;
-                        coord.z = 0;
-                        tilesProcessedNum++;
+                        if (tileSlots[tileIndex].m_HeapId != UINT32_MAX)
+                            m_DefragPlanner.OnTileFreed(tileSlots[tileIndex].m_HeapId);
+                        if (tileSlots[tileIndex].m_bMapped)
+                            texStats.m_TilesResident--;
+                        tileSlots[tileIndex] = {};
                     }
-
-                    g_Renderer.m_RHI->m_NvrhiDevice->updateTextureTileMappings(feedbackTexture->GetReservedTexture(), &textureTilesMapping, 1);
-                    m_MinMipDirtyTextures.insert(texIdx);
                 }
 
                 // Collect new standard tiles to stream in.
                 // Packed tiles are already mapped by MapPackedMips at scene load and
-                // will not appear here during normal operation.
+                // only appear here after Step 5b moved them.
+                tilesRequestedNew.clear();
                 m_TiledTextureManager->GetTilesToMap(feedbackTexture->GetTiledTextureId(), tilesRequestedNew);
+                MoveDefragmentedTiles(commandList, texIdx, tilesRequestedNew);
                 if (!tilesRequestedNew.empty())
                 {
-                    FeedbackTextureUpdate update;
-                    update.m_TextureIdx = texIdx;
-                    for (uint32_t tileIndex : tilesRequestedNew)
-                        update.m_TileIndices.push_back(tileIndex);
-                    if (!update.m_TileIndices.empty())
-                        results.push_back(update);
+                    m_TileScheduler.Enqueue(texIdx, tilesRequestedNew, g_Renderer.m_FrameNumber);
+                    m_DirtyTextures.OnTilesAllocated(texIdx, (uint32_t)tilesRequestedNew.size());
+                    feedbackTexture->GetStreamingStats().m_TilesRequested += tilesRequestedNew.size();
                 }
             }
-        }
 
-        // ── Step 7: Defragmentation ──
-        // NOTE: cause slight visual "stuttering" when tiles are moved, so disable for now
-        //m_TiledTextureManager->DefragmentTiles(16);
+            SubmitTileMappings();
+
+            // With free heap tiles left every request has been allocated and collected.
+            // Otherwise requests from these textures may still be waiting for a heap.
+            if (m_TiledTextureManager->GetStatistics().heapFreeTilesNum > 0)
+                m_DirtyTextures.Clear();
+        }
 
         m_BeginFrameCPUTime = timer.LapSeconds();
     }
 
-    void FeedbackManager::UpdateTileMappings(nvrhi::ICommandList* commandList, std::vector<FeedbackTextureUpdate>& tilesReady)
+    PrefetchTexture FeedbackManager::GetPrefetchTexture(uint32_t textureIdx) const
     {
-        SimpleTimer timer;
+        FeedbackTexture* texture = m_Textures.at(textureIdx).get();
+        const nvrhi::TextureDesc& desc = texture->GetReservedTexture()->getDesc();
+
+        PrefetchTexture prefetchTexture;
+        prefetchTexture.m_Width              = desc.width;
+        prefetchTexture.m_Height             = desc.height;
+        prefetchTexture.m_NumStandardMips    = texture->GetPackedMipInfo().numStandardMips;
+        prefetchTexture.m_TileWidthInTexels  = texture->GetTileShape().widthInTexels;
+        prefetchTexture.m_TileHeightInTexels = texture->GetTileShape().heightInTexels;
+        return prefetchTexture;
+    }
 
-        for (FeedbackTextureUpdate& texUpdate : tilesReady)
+    StreamingTraceTexture FeedbackManager::GetTraceTexture(uint32_t textureIdx) const
+    {
+        FeedbackTexture* texture = m_Textures.at(textureIdx).get();
+        const nvrhi::PackedMipDesc& packedMipDesc = texture->GetPackedMipInfo();
+
+        StreamingTraceTexture traceTexture;
+        traceTexture.m_Width              = texture->GetReservedTexture()->getDesc().width;
+        traceTexture.m_Height             = texture->GetReservedTexture()->getDesc().height;
+        traceTexture.m_NumStandardMips    = packedMipDesc.numStandardMips;
+        traceTexture.m_NumPackedMips      = packedMipDesc.numPackedMips;
+        traceTexture.m_NumPackedTiles     = packedMipDesc.numTilesForPackedMips;
+        traceTexture.m_TileWidthInTexels  = texture->GetTileShape().widthInTexels;
+        traceTexture.m_TileHeightInTexels = texture->GetTileShape().heightInTexels;
+        return traceTexture;
+    }
+
+    bool FeedbackManager::StartTraceRecording(const std::filesystem::path& filePath)
+    {
+        if (!m_TraceWriter.Open(filePath, m_HeapSizeInTiles))
+            return false;
+
+        // Packed mips of these are already mapped: replay them as mapped at load
+        for (uint32_t texIdx = 0; texIdx < (uint32_t)m_Textures.size(); ++texIdx)
         {
-            FeedbackTexture* texture = GetTextureByIndex(texUpdate.m_TextureIdx);
-            m_MinMipDirtyTextures.insert(texUpdate.m_TextureIdx);
+            m_TraceWriter.AddTexture(texIdx, GetTraceTexture(texIdx));
+            m_TraceWriter.MapPackedMips(texIdx);
+        }
 
-            uint32_t tiledTextureId = texture->GetTiledTextureId();
-            m_TiledTextureManager->UpdateTilesMapping(tiledTextureId, texUpdate.m_TileIndices);
+        LOG_INFO("[StreamingTrace] Recording to '%s'", filePath.string().c_str());
+        return true;
+    }
 
-            const std::vector<rtxts::TileCoord>& tileCoords     = m_TiledTextureManager->GetTileCoordinates(tiledTextureId);
-            const std::vector<rtxts::TileAllocation>& tileAllocations = m_TiledTextureManager->GetTileAllocations(tiledTextureId);
+    void FeedbackManager::StopTraceRecording()
+    {
+        if (!m_TraceWriter.IsOpen())
+            return;
 
-            // Group tiles by heap for batched updateTextureTileMappings calls
-            std::map<nvrhi::HeapHandle, std::vector<uint32_t>> heapTilesMapping;
-            for (uint32_t tileIndex : texUpdate.m_TileIndices)
+        m_TraceWriter.Close();
+        LOG_INFO("[StreamingTrace] Recorded %.2f MB", BYTES_TO_MB(m_TraceWriter.GetBytesWritten()));
+    }
+
+    void FeedbackManager::ApplyPrefetchRequests(float timeStamp)
+    {
+        PROFILE_FUNCTION();
+
+        m_NumTexturesPrefetched = 0;
+
+        // Speculative tiles would compete with visible ones for the capped heaps
+        if (m_PrefetchMips.empty() || m_bLowMemoryMode)
+        {
+            m_PrefetchMips.clear();
+            return;
+        }
+
+        // Textures predicted finer than they are resident, largest gap first
+        struct Candidate
+        {
+            uint32_t m_TextureIdx;
+            uint8_t  m_Mip;
+            uint32_t m_FinestResidentMip;
+        };
+        std::vector<Candidate> candidates;
+
+        const uint32_t numTextures = std::min((uint32_t)m_PrefetchMips.size(), (uint32_t)m_Textures.size());
+        for (uint32_t texIdx = 0; texIdx < numTextures; ++texIdx)
+        {
+            const uint8_t  mip       = m_PrefetchMips[texIdx];
+            const uint32_t finestMip = m_Textures[texIdx]->GetFinestResidentMip();
+            if (mip != kPrefetchMipNone && mip < finestMip)
+                candidates.push_back({ texIdx, mip, finestMip });
+        }
+        m_PrefetchMips.clear();
+
+        const size_t numSelected = std::min<size_t>(candidates.size(), kMaxPrefetchTexturesPerFrame);
+        std::partial_sort(candidates.begin(), candidates.begin() + numSelected, candidates.end(),
+            [](const Candidate& a, const Candidate& b) { return (a.m_FinestResidentMip - a.m_Mip) > (b.m_FinestResidentMip - b.m_Mip); });
+
+        for (size_t i = 0; i < numSelected; ++i)
+        {
+            const Candidate& candidate = candidates[i];
+            FeedbackTexture* texture = m_Textures[candidate.m_TextureIdx].get();
+
+            // Coarsen until the mips missing below the resident one fit the tile budget
+            const PrefetchTexture prefetchTexture = GetPrefetchTexture(candidate.m_TextureIdx);
+            const uint32_t residentTiles = GetPrefetchTileCount(prefetchTexture, (uint8_t)candidate.m_FinestResidentMip);
+            uint8_t mip = candidate.m_Mip;
+            while (mip < candidate.m_FinestResidentMip && GetPrefetchTileCount(prefetchTexture, mip) - residentTiles > kMaxPrefetchTilesPerTexture)
+                ++mip;
+            if (mip >= candidate.m_FinestResidentMip)
+                continue;
+
+            // Uniform feedback: every region sampled at `mip`
+            m_PrefetchMinMipData.assign((size_t)texture->GetFeedbackRegionsX() * texture->GetFeedbackRegionsY(), mip);
+
+            rtxts::SamplerFeedbackDesc samplerFeedbackDesc{};
+            samplerFeedbackDesc.pMinMipData = m_PrefetchMinMipData.data();
+            m_TiledTextureManager->UpdateWithSamplerFeedback(
+                texture->GetTiledTextureId(),
+                samplerFeedbackDesc,
+                timeStamp,
+                m_Budgets.m_TileHysteresisSeconds);
+
+            m_TraceWriter.Prefetch(candidate.m_TextureIdx, mip);
+            m_DirtyTextures.MarkDirty(candidate.m_TextureIdx);
+
+            FeedbackTexture::FeedbackSnapshot& snapshot = texture->GetFeedbackSnapshot();
+            snapshot.m_PrefetchMip   = mip;
+            snapshot.m_PrefetchFrame = g_Renderer.m_FrameNumber;
+            m_TileScheduler.MarkTextureChanged(candidate.m_TextureIdx);
+
+            m_NumTexturesPrefetched++;
+        }
+    }
+
+    void FeedbackManager::PopScheduledTiles(uint32_t maxTiles, std::pmr::vector<ScheduledTile>& outTiles)
+    {
+        PROFILE_FUNCTION();
+
+        m_TileScheduler.PopBatch(maxTiles, [this](const ScheduledTile& tile) { return ComputeTilePriorityInputs(tile); }, outTiles);
+    }
+
+    TilePriorityInputs FeedbackManager::ComputeTilePriorityInputs(const ScheduledTile& tile) const
+    {
+        const FeedbackTexture* texture = m_Textures.at(tile.m_TextureIdx).get();
+        const rtxts::TileCoord& coord = m_TiledTextureManager->GetTileCoordinates(texture->GetTiledTextureId())[tile.m_TileIndex];
+
+        return nvfeedback::ComputeTilePriorityInputs(GetTileFeedbackState(*texture), coord.mipLevel, coord.x, coord.y, tile.m_RequestFrame, g_Renderer.m_FrameNumber);
+    }
+
+    TileFeedbackState FeedbackManager::GetTileFeedbackState(const FeedbackTexture& texture) const
+    {
+        const FeedbackTexture::FeedbackSnapshot& snapshot = texture.GetFeedbackSnapshot();
+
+        TileFeedbackState state;
+        state.m_Requested          = snapshot.m_Requested;
+        state.m_Resident           = snapshot.m_Resident;
+        state.m_RequestedFrame     = snapshot.m_RequestedFrame;
+        state.m_PrefetchMip        = snapshot.m_PrefetchMip;
+        state.m_PrefetchFrame      = snapshot.m_PrefetchFrame;
+        state.m_RegionsX           = texture.GetFeedbackRegionsX();
+        state.m_RegionsY           = texture.GetFeedbackRegionsY();
+        state.m_RegionWidth        = texture.GetFeedbackRegionWidth();
+        state.m_RegionHeight       = texture.GetFeedbackRegionHeight();
+        state.m_TileWidthInTexels  = texture.GetTileShape().widthInTexels;
+        state.m_TileHeightInTexels = texture.GetTileShape().heightInTexels;
+        state.m_NumStandardMips    = texture.GetPackedMipInfo().numStandardMips;
+        return state;
+    }
+
+    void FeedbackManager::AddTileBytesRead(uint32_t textureIdx, uint64_t bytes)
+    {
+        if (textureIdx < m_Textures.size())
+            m_Textures[textureIdx]->GetStreamingStats().m_BytesRead += bytes;
+    }
+
+    void FeedbackManager::GetTextureStreamingReports(std::vector<TextureStreamingReport>& outReports) const
+    {
+        const uint64_t now = SDL_GetPerformanceCounter();
+        const double ticksPerSecond = (double)SDL_GetPerformanceFrequency();
+
+        outReports.clear();
+        outReports.resize(m_Textures.size());
+        for (uint32_t texIdx = 0; texIdx < (uint32_t)m_Textures.size(); ++texIdx)
+        {
+            const FeedbackTexture& texture = *m_Textures[texIdx];
+            const nvrhi::TextureDesc& desc = texture.GetReservedTexture()->getDesc();
+            const uint32_t numStandardMips = texture.GetPackedMipInfo().numStandardMips;
+
+            TextureStreamingReport& report = outReports[texIdx];
+            report.m_TextureIdx      = texIdx;
+            report.m_Width           = desc.width;
+            report.m_Height          = desc.height;
+            report.m_NumStandardMips = numStandardMips;
+            report.m_Stats           = texture.GetStreamingStats();
+            report.m_TilesPerMip.assign(numStandardMips, 0);
+            report.m_ResidentTilesPerMip.assign(numStandardMips, 0);
+
+            const TextureStreamingStats& stats = report.m_Stats;
+            if (stats.m_TilesLoaded > 0)
+                report.m_AverageLatencyMs = (double)stats.m_LatencyTicks / (double)stats.m_TilesLoaded / ticksPerSecond * 1000.0;
+            const uint64_t belowTicks = stats.m_BelowRequestedTicks + (stats.m_BelowRequestedSince != 0 ? now - stats.m_BelowRequestedSince : 0);
+            report.m_SecondsBelowRequestedMip = (double)belowTicks / ticksPerSecond;
+
+            // Standby: resident, yet neither the latest feedback nor a prefetch asks for it
+            const TileFeedbackState state = GetTileFeedbackState(texture);
+            const std::vector<rtxts::TileCoord>& tileCoords = m_TiledTextureManager->GetTileCoordinates(texture.GetTiledTextureId());
+            const std::vector<FeedbackTexture::TileSlot>& tileSlots = texture.GetTileSlots();
+            for (uint32_t tileIndex = 0; tileIndex < (uint32_t)tileSlots.size(); ++tileIndex)
             {
-                nvrhi::HeapHandle heap = m_HeapAllocator->GetHeapHandle(tileAllocations[tileIndex].heapId);
-                heapTilesMapping[heap].push_back(tileIndex);
+                const rtxts::TileCoord& coord = tileCoords[tileIndex];
+                if (texture.IsTilePacked(tileIndex) || coord.mipLevel >= numStandardMips)
+                    continue;
+
+                report.m_TilesPerMip[coord.mipLevel]++;
+                if (!tileSlots[tileIndex].m_bMapped)
+                    continue;
+
+                report.m_ResidentTilesPerMip[coord.mipLevel]++;
+                const TilePriorityInputs inputs = nvfeedback::ComputeTilePriorityInputs(state, coord.mipLevel, coord.x, coord.y, 0, g_Renderer.m_FrameNumber);
+                if (inputs.m_Coverage == 0.0f && !inputs.m_bPrefetched)
+                    report.m_TilesStandby++;
             }
+        }
+    }
+
+    uint64_t FeedbackManager::ReclaimHeapMemory(uint64_t bytes)
+    {
+        m_bLowMemoryMode = true;
+
+        const uint32_t currentCap   = std::min(m_MaxTTMHeaps, m_NumTTMHeaps);
+        const uint64_t heapBytes    = m_HeapAllocator->GetHeapSizeInBytes();
+        const uint32_t heapsToDrop  = (uint32_t)((bytes + heapBytes - 1) / heapBytes);
+        const uint32_t newCap       = std::max(m_NumPackedMipHeaps, currentCap - std::min(currentCap, heapsToDrop));
+
+        m_MaxTTMHeaps = newCap;
+
+        // The cap alone only stops growth: heaps full of requested tiles never drain.
+        // Coarsening the feedback releases the finest mips (one more per call).
+        if (newCap < currentCap)
+            m_PressureMipBias = std::min(m_PressureMipBias + 1, kMaxPressureMipBias);
+
+        return (uint64_t)(currentCap - newCap) * heapBytes;
+    }
+
+    void FeedbackManager::RestoreHeapBudget()
+    {
+        m_MaxTTMHeaps     = UINT32_MAX;
+        m_bLowMemoryMode  = false;
+        m_PressureMipBias = 0;
+    }
 
-            for (auto& [heap, heapTiles] : heapTilesMapping)
+    // Splits a texture's GetTilesToMap() result: tiles without a slot yet stay in
+    // tilesToMap to be streamed in, tiles Step 5b moved are taken out.  A moved tile
+    // whose data is on the GPU is copied to its new slot and remapped next frame;
+    // one still being loaded is mapped at the new slot when its data arrives.
+    void FeedbackManager::MoveDefragmentedTiles(nvrhi::ICommandList* commandList, uint32_t texIdx, std::vector<uint32_t>& tilesToMap)
+    {
+        if (tilesToMap.empty())
+            return;
+
+        FeedbackTexture* texture = GetTextureByIndex(texIdx);
+        const std::vector<rtxts::TileAllocation>& tileAllocations = m_TiledTextureManager->GetTileAllocations(texture->GetTiledTextureId());
+        std::vector<FeedbackTexture::TileSlot>& tileSlots = texture->GetTileSlots();
+        const uint64_t now = SDL_GetPerformanceCounter();
+
+        FeedbackTextureUpdate* moved = nullptr;
+        std::erase_if(tilesToMap, [&](uint32_t tileIndex)
+        {
+            const rtxts::TileAllocation& allocation = tileAllocations[tileIndex];
+            FeedbackTexture::TileSlot& slot = tileSlots[tileIndex];
+            m_DefragPlanner.OnTileAllocated(allocation.heapId);
+
+            if (slot.m_HeapId == UINT32_MAX)
             {
-                uint32_t numTiles = (uint32_t)heapTiles.size();
+                slot = { allocation.heapId, allocation.heapTileIndex, now, false };
+                return false;
+            }
+
+            m_DefragPlanner.OnTileFreed(slot.m_HeapId);
+            if (slot.m_bMapped)
+            {
+                CopyTileData(commandList, slot.m_HeapId, slot.m_HeapTileIndex, allocation.heapId, allocation.heapTileIndex);
+                if (!moved)
+                {
+                    moved = &m_MovedTilesToRemap.emplace_back();
+                    moved->m_TextureIdx = texIdx;
+                }
+                moved->m_TileIndices.push_back(tileIndex);
+                m_NumTilesMoved++;
+            }
+            slot.m_HeapId        = allocation.heapId;
+            slot.m_HeapTileIndex = allocation.heapTileIndex;
+            return true;
+        });
+
+        // Back to mapped for TTM, so the MinMip texture keeps advertising them
+        if (moved)
+            m_TiledTextureManager->UpdateTilesMapping(texture->GetTiledTextureId(), moved->m_TileIndices);
+    }
+
+    void FeedbackManager::CopyTileData(nvrhi::ICommandList* commandList, uint32_t srcHeapId, uint32_t srcHeapTileIndex, uint32_t dstHeapId, uint32_t dstHeapTileIndex)
+    {
+        auto copyTile = [commandList](nvrhi::IBuffer* dst, uint64_t dstOffset, nvrhi::IBuffer* src, uint64_t srcOffset)
+        {
+            commandList->setBufferState(src, nvrhi::ResourceStates::CopySource);
+            commandList->setBufferState(dst, nvrhi::ResourceStates::CopyDest);
+            commandList->commitBarriers();
+            commandList->copyBuffer(dst, dstOffset, src, srcOffset, kTileSizeInBytes);
+        };
+
+        nvrhi::IBuffer* srcBuffer = m_HeapAllocator->GetBufferHandle(srcHeapId);
+        nvrhi::IBuffer* dstBuffer = m_HeapAllocator->GetBufferHandle(dstHeapId);
+        const uint64_t srcOffset = (uint64_t)srcHeapTileIndex * kTileSizeInBytes;
+        const uint64_t dstOffset = (uint64_t)dstHeapTileIndex * kTileSizeInBytes;
+
+        // One buffer cannot be copy source and destination at once: moves within a
+        // heap go through a scratch tile
+        if (srcBuffer == dstBuffer)
+        {
+            if (!m_DefragScratchBuffer)
+            {
+                nvrhi::BufferDesc bufferDesc{};
+                bufferDesc.byteSize = kTileSizeInBytes;
+                bufferDesc.initialState = nvrhi::ResourceStates::CopyDest;
+                bufferDesc.keepInitialState = true;
+                bufferDesc.debugName = "Defrag Scratch Tile";
+                m_DefragScratchBuffer = g_Renderer.m_RHI->m_NvrhiDevice->createBuffer(bufferDesc);
+            }
+
+            copyTile(m_DefragScratchBuffer, 0, srcBuffer, srcOffset);
+            copyTile(dstBuffer, dstOffset, m_DefragScratchBuffer, 0);
+        }
+        else
+        {
+            copyTile(dstBuffer, dstOffset, srcBuffer, srcOffset);
+        }
+    }
+
+    void FeedbackManager::MarkMinMipDirty(uint32_t textureIdx)
+    {
+        if (!m_bMinMipDirty[textureIdx])
+        {
+            m_bMinMipDirty[textureIdx] = 1;
+            m_MinMipDirtyTextures.push_back(textureIdx);
+        }
+    }
+
+    // Maps (and unmaps) the tiles added to m_TileMappingBatch.
+    void FeedbackManager::SubmitTileMappings()
+    {
+        // Sorted by (texture, heap), adjacent tiles merged into multi-tile regions
+        const std::span<const TileMappingRun> runs = m_TileMappingBatch.Build();
+
+        m_MappingCoordinates.resize(runs.size());
+        m_MappingRegions.resize(runs.size());
+        m_MappingByteOffsets.resize(runs.size());
+        for (size_t i = 0; i < runs.size(); i++)
+        {
+            const TileMappingRun& run = runs[i];
+            FeedbackTexture* texture = GetTextureByIndex(run.m_TextureIdx);
+            const rtxts::TileCoord& tileCoord = m_TiledTextureManager->GetTileCoordinates(texture->GetTiledTextureId())[run.m_TileIndex];
+
+            // Packed tiles are addressed by their index within the packed mips, as in MapPackedMips
+            nvrhi::TiledTextureCoordinate& coord = m_MappingCoordinates[i];
+            coord.mipLevel   = tileCoord.mipLevel;
+            coord.arrayLevel = 0;
+            coord.x          = tileCoord.x;
+            coord.y          = texture->IsTilePacked(run.m_TileIndex) ? 0 : tileCoord.y;
+            coord.z          = 0;
+
+            m_MappingRegions[i] = {};
+            m_MappingRegions[i].tilesNum = run.m_NumTiles;
+
+            m_MappingByteOffsets[i] = static_cast<uint64_t>(run.m_HeapTileIndex) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+        }
+
+        // One call per texture, one mapping per heap
+        for (size_t textureBegin = 0; textureBegin < runs.size();)
+        {
+            const uint32_t texIdx = runs[textureBegin].m_TextureIdx;
+
+            m_TextureTilesMappings.clear();
+            size_t heapBegin = textureBegin;
+            while (heapBegin < runs.size() && runs[heapBegin].m_TextureIdx == texIdx)
+            {
+                size_t heapEnd = heapBegin + 1;
+                while (heapEnd < runs.size() && runs[heapEnd].m_TextureIdx == texIdx && runs[heapEnd].m_HeapId == runs[heapBegin].m_HeapId)
+                    heapEnd++;
+
+                nvrhi::TextureTilesMapping& textureTilesMapping = m_TextureTilesMappings.emplace_back();
+                textureTilesMapping.numTextureRegions       = (uint32_t)(heapEnd - heapBegin);
+                textureTilesMapping.tiledTextureCoordinates = m_MappingCoordinates.data() + heapBegin;
+                textureTilesMapping.tiledTextureRegions     = m_MappingRegions.data() + heapBegin;
+                if (runs[heapBegin].m_HeapId != TileMappingBatch::kNoHeap)
+                {
+                    textureTilesMapping.byteOffsets = m_MappingByteOffsets.data() + heapBegin;
+                    textureTilesMapping.heap        = m_HeapAllocator->GetHeapHandle(runs[heapBegin].m_HeapId);
+                }
 
                 if constexpr (kStreamingDebugLog)
                 {
-                    SDL_Log("[Streaming][Heap] UpdateTileMappings: textureIdx=%u mapping %u tiles to heap=%p "
+                    LOG_INFO("[Streaming][Heap] SubmitTileMappings: textureIdx=%u mapping %u regions to heap=%p "
                             "(verify heap is not in release queue!)",
-                            texUpdate.m_TextureIdx, numTiles, (void*)heap.Get());
+                            texIdx, textureTilesMapping.numTextureRegions, (void*)textureTilesMapping.heap.Get());
                 }
 
-                std::vector<nvrhi::TiledTextureCoordinate> tiledTextureCoordinates;
-                std::vector<nvrhi::TiledTextureRegion>     tiledTextureRegions;
-                std::vector<uint64_t>                      byteOffsets;
+                heapBegin = heapEnd;
+            }
 
-                tiledTextureCoordinates.reserve(numTiles);
-                tiledTextureRegions.reserve(numTiles);
-                byteOffsets.reserve(numTiles);
+            g_Renderer.m_RHI->m_NvrhiDevice->updateTextureTileMappings(GetTextureByIndex(texIdx)->GetReservedTexture(),
+                                                                       m_TextureTilesMappings.data(), (uint32_t)m_TextureTilesMappings.size());
+            textureBegin = heapBegin;
+        }
+    }
 
-                for (uint32_t i = 0; i < numTiles; i++)
-                {
-                    uint32_t tileIndex = heapTiles[i];
+    void FeedbackManager::UpdateTileMappings(nvrhi::ICommandList* commandList, std::span<FeedbackTextureUpdate> tilesReady)
+    {
+        SimpleTimer timer;
+        const uint64_t mappingTicks = SDL_GetPerformanceCounter();
 
-                    nvrhi::TiledTextureCoordinate coord{};
-                    coord.mipLevel   = tileCoords[tileIndex].mipLevel;
-                    coord.x          = tileCoords[tileIndex].x;
-                    coord.y          = tileCoords[tileIndex].y;
-                    coord.z          = 0;
-                    tiledTextureCoordinates.push_back(coord);
+        m_TileMappingBatch.Clear();
+        for (FeedbackTextureUpdate& texUpdate : tilesReady)
+        {
+            FeedbackTexture* texture = GetTextureByIndex(texUpdate.m_TextureIdx);
+            MarkMinMipDirty(texUpdate.m_TextureIdx);
 
-                    nvrhi::TiledTextureRegion region{};
-                    region.tilesNum = 1;
-                    tiledTextureRegions.push_back(region);
+            uint32_t tiledTextureId = texture->GetTiledTextureId();
+            m_TiledTextureManager->UpdateTilesMapping(tiledTextureId, texUpdate.m_TileIndices);
+            m_TraceWriter.TilesMapped(texUpdate.m_TextureIdx, texUpdate.m_TileIndices);
 
-                    byteOffsets.push_back(static_cast<uint64_t>(tileAllocations[tileIndex].heapTileIndex) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES);
-                }
+            const std::vector<rtxts::TileCoord>& tileCoords     = m_TiledTextureManager->GetTileCoordinates(tiledTextureId);
+            const std::vector<rtxts::TileAllocation>& tileAllocations = m_TiledTextureManager->GetTileAllocations(tiledTextureId);
 
-                nvrhi::TextureTilesMapping textureTilesMapping{};
-                textureTilesMapping.numTextureRegions       = numTiles;
-                textureTilesMapping.tiledTextureCoordinates = tiledTextureCoordinates.data();
-                textureTilesMapping.tiledTextureRegions     = tiledTextureRegions.data();
-                textureTilesMapping.byteOffsets             = byteOffsets.data();
-                textureTilesMapping.heap                    = heap;
+            std::vector<FeedbackTexture::TileSlot>& tileSlots = texture->GetTileSlots();
+            TextureStreamingStats& texStats = texture->GetStreamingStats();
+            for (uint32_t tileIndex : texUpdate.m_TileIndices)
+            {
+                m_TileMappingBatch.Add(texUpdate.m_TextureIdx, tileIndex, tileCoords[tileIndex].mipLevel,
+                                       tileAllocations[tileIndex].heapId, tileAllocations[tileIndex].heapTileIndex);
 
-                g_Renderer.m_RHI->m_NvrhiDevice->updateTextureTileMappings(texture->GetReservedTexture(), &textureTilesMapping, 1);
+                FeedbackTexture::TileSlot& slot = tileSlots[tileIndex];
+                if (slot.m_HeapId != UINT32_MAX && !slot.m_bMapped)
+                {
+                    slot.m_bMapped = true;
+                    texStats.m_TilesLoaded++;
+                    texStats.m_TilesResident++;
+                    texStats.m_LatencyTicks += mappingTicks - slot.m_RequestTicks;
+                }
             }
         }
 
+        SubmitTileMappings();
+
         // Upload MinMip data for dirty textures
         if (!m_MinMipDirtyTextures.empty())
         {
@@ -465,7 +983,7 @@ namespace nvfeedback
                 }
             }
 
-            std::vector<uint8_t> minMipData;
+            std::vector<uint8_t>& minMipData = m_MinMipScratch;
 
             for (uint32_t texIdx : m_MinMipDirtyTextures)
             {
@@ -482,6 +1000,20 @@ namespace nvfeedback
                 m_TiledTextureManager->WriteMinMipData(texture->GetTiledTextureId(), minMipData.data());
 
                 commandList->writeTexture(texture->GetMinMipTexture(), 0, 0, minMipData.data(), rowPitch);
+                texture->GetFeedbackSnapshot().m_Resident = minMipData;
+                m_TileScheduler.MarkTextureChanged(texIdx);
+                UpdateRequestedMipStats(*texture, mappingTicks);
+
+                // Drop the source pages of mips that lost their last mapped tile.  The
+                // mapping is read-only, so a later request simply faults them back in.
+                SDL_assert(!minMipData.empty());
+                const uint32_t finestResidentMip = *std::min_element(minMipData.begin(), minMipData.end());
+                const uint32_t prevFinestResidentMip = texture->GetFinestResidentMip();
+                if (finestResidentMip > prevFinestResidentMip)
+                {
+                    texture->EvictSourceMips(prevFinestResidentMip, finestResidentMip);
+                }
+                texture->SetFinestResidentMip(finestResidentMip);
             }
 
             if (!bUseAutomaticBarriers)
@@ -492,6 +1024,8 @@ namespace nvfeedback
                 }
             }
 
+            for (uint32_t texIdx : m_MinMipDirtyTextures)
+                m_bMinMipDirty[texIdx] = 0;
             m_MinMipDirtyTextures.clear();
             commandList->setEnableAutomaticBarriers(true);
         }
@@ -549,10 +1083,10 @@ namespace nvfeedback
     void FeedbackManager::EndFrame()
     {
         // Advance ring buffer cursor by the number of textures processed this frame
-        if (!m_TexturesRingbuffer.empty() && kFeedbackTexturesToResolvePerFrame > 0)
+        if (!m_TexturesRingbuffer.empty() && m_NumTexturesCollected > 0)
         {
             const uint32_t count = (uint32_t)m_TexturesRingbuffer.size();
-            const uint32_t advance = std::min(kFeedbackTexturesToResolvePerFrame, count);
+            const uint32_t advance = std::min(m_NumTexturesCollected, count);
             m_RingbufferCursor = (m_RingbufferCursor + advance) % count;
         }
 
@@ -569,6 +1103,14 @@ namespace nvfeedback
         m_StatsLastFrame.m_TilesTotal     = stats.totalTilesNum;
         m_StatsLastFrame.m_HeapTilesFree  = stats.heapFreeTilesNum;
         m_StatsLastFrame.m_TilesStandby   = stats.standbyTilesNum;
+
+        m_StatsLastFrame.m_TilesPending     = m_TileScheduler.GetNumPending();
+        m_StatsLastFrame.m_TilesCancelled   = m_TileScheduler.GetNumCancelled();
+        m_StatsLastFrame.m_TilesStaleLoaded = m_TileScheduler.GetNumStalePopped();
+        m_StatsLastFrame.m_TexturesPrefetched = m_NumTexturesPrefetched;
+        m_StatsLastFrame.m_TexturesScanned    = m_NumDirtyTexturesScanned;
+        m_StatsLastFrame.m_TexturesResident   = m_DirtyTextures.GetNumResidentTextures();
+        m_StatsLastFrame.m_TilesMoved         = m_NumTilesMoved;
     }
 
     const FeedbackManagerStats& FeedbackManager::GetStats() const
@@ -591,6 +1133,8 @@ namespace nvfeedback
         // GetEmptyHeaps() will never return them — they are never released.  This is
         // correct: packed-mip heaps must live for the lifetime of the scene.
 
+        m_TraceWriter.MapPackedMips(textureIdx);
+
         FeedbackTexture* texture = m_Textures.at(textureIdx).get();
         const nvrhi::PackedMipDesc& packedMipDesc = texture->GetPackedMipInfo();
         if (packedMipDesc.numPackedMips == 0)
@@ -604,12 +1148,14 @@ namespace nvfeedback
             if (stats.heapFreeTilesNum < numPackedTiles)
             {
                 const uint32_t deficit = numPackedTiles - stats.heapFreeTilesNum;
-                const uint32_t heapsNeeded = (deficit + kHeapSizeInTiles - 1) / kHeapSizeInTiles;
+                const uint32_t heapsNeeded = (deficit + m_HeapSizeInTiles - 1) / m_HeapSizeInTiles;
                 for (uint32_t i = 0; i < heapsNeeded; ++i)
                 {
                     uint32_t heapId = m_HeapAllocator->AllocateHeap();
                     m_TiledTextureManager->AddHeap(heapId);
+                    m_DefragPlanner.AddHeap(heapId, true);
                     m_NumTTMHeaps++;
+                    m_NumPackedMipHeaps++;
                 }
             }
         }
@@ -637,6 +1183,13 @@ namespace nvfeedback
         const std::vector<rtxts::TileAllocation>& allocs = m_TiledTextureManager->GetTileAllocations(texture->GetTiledTextureId());
         const std::vector<rtxts::TileCoord>& coords = m_TiledTextureManager->GetTileCoordinates(texture->GetTiledTextureId());
 
+        std::vector<FeedbackTexture::TileSlot>& tileSlots = texture->GetTileSlots();
+        for (uint32_t ti : packedTiles)
+        {
+            tileSlots[ti] = { allocs[ti].heapId, allocs[ti].heapTileIndex, 0, true };
+            m_DefragPlanner.OnTileAllocated(allocs[ti].heapId);
+        }
+
         std::map<nvrhi::HeapHandle, std::vector<uint32_t>> byHeap;
         for (uint32_t ti : packedTiles)
             byHeap[m_HeapAllocator->GetHeapHandle(allocs[ti].heapId)].push_back(ti);
@@ -669,7 +1222,7 @@ namespace nvfeedback
 
         if constexpr (kStreamingDebugLog)
         {
-            SDL_Log("[Streaming][Heap] MapPackedMips: textureIdx=%u mapped %u packed tile(s) (TTM heaps=%u)",
+            LOG_INFO("[Streaming][Heap] MapPackedMips: textureIdx=%u mapped %u packed tile(s) (TTM heaps=%u)",
                     textureIdx, (uint32_t)packedTiles.size(), m_NumTTMHeaps);
         }
     }
@@ -1,6 +1,13 @@
 #pragma once
 
+#include "DirtyTextureList.h"
 #include "FeedbackTexture.h"
+#include "StreamingBudgetController.h"
+#include "StreamingTrace.h"
+#include "TileDefragPlanner.h"
+#include "TileMappingBatch.h"
+#include "TilePrefetcher.h"
+#include "TileScheduler.h"
 #include "Utilities.h"
 
 #include <rtxts-ttm/TiledTextureManager.h>
@@ -18,6 +25,13 @@ namespace nvfeedback
         uint32_t m_TilesTotal = 0;
         uint32_t m_TilesAllocated = 0;
         uint32_t m_TilesStandby = 0;
+        uint32_t m_TilesPending = 0;        // requested, waiting in the TileScheduler
+        uint32_t m_TilesCancelled = 0;      // unmapped by TTM before their data was loaded (cumulative)
+        uint32_t m_TilesStaleLoaded = 0;    // loaded after feedback stopped requesting them (cumulative)
+        uint32_t m_TexturesPrefetched = 0;  // textures given predicted demand by the last BeginFrame
+        uint32_t m_TexturesScanned = 0;     // textures whose tiles to map/unmap the last BeginFrame collected
+        uint32_t m_TexturesResident = 0;    // textures with allocated standard tiles
+        uint32_t m_TilesMoved = 0;          // copied to another heap slot by defragmentation (cumulative)
 
         double m_CpuTimeBeginFrame = 0.0;
         double m_CpuTimeUpdateTileMappings = 0.0;
@@ -32,24 +46,20 @@ namespace nvfeedback
 
     static constexpr bool kStreamingDebugLog = false;
     static constexpr uint32_t kNumFramesInFlight = 3;
-    static constexpr uint32_t kHeapSizeInTiles   = 256;
-    static constexpr uint32_t kFeedbackTexturesToResolvePerFrame = 30;
-
-    // Maximum number of tile indices submitted to AsyncTileIO per frame.
-    // Matches the RTXTS reference's tilesPerFrame budget.  Excess tiles are deferred
-    // to m_PendingTileRequests and submitted in subsequent frames, preventing large
-    // single-frame upload batches (e.g. 1623 tiles = 104 MB in one frame).
-    static constexpr uint32_t kMaxTilesPerFrame = 128;
-
-    // Hysteresis timeout: a tile stays mapped for this many seconds after the
-    // last time sampler feedback requested it.  TTM transitions Mapped→Standby
-    // (not Free) when the timeout expires; Standby tiles are only freed when
-    // the standby queue overflows (numExtraStandbyTiles).
-    //
-    // With 307 textures at 30/frame the ringbuffer cycle is ~10 frames (~167ms
-    // at 60fps), so 1 second gives ~6 full cycles of margin before any tile
-    // times out.  No per-frame re-submission of cached feedback is needed.
-    static constexpr float kTileHysteresisSeconds = 1.0f;
+    // Default tiles per TTM heap (--streaming-heap-tiles).  TTM fixes the heap
+    // size when it is created, so unlike StreamingBudgets it cannot change at runtime.
+    static constexpr uint32_t kDefaultHeapSizeInTiles = 256;
+    static constexpr uint64_t kTileSizeInBytes        = 64 * 1024; // D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES
+
+    // Predictive prefetch budget per BeginFrame: at most this many textures, each
+    // limited to this many new tiles (the prefetched mip is coarsened until it fits).
+    // Prefetched tiles also only load in frames with scheduler budget left over.
+    static constexpr uint32_t kMaxPrefetchTexturesPerFrame = 8;
+    static constexpr uint32_t kMaxPrefetchTilesPerTexture  = 64;
+
+    // Mips the sampler feedback is coarsened by at most under VRAM pressure (see
+    // FeedbackManager::ReclaimHeapMemory).
+    static constexpr uint32_t kMaxPressureMipBias = 3;
 
     // ─── HeapAllocator ───────────────────────────────────────────────────────
     //
@@ -62,6 +72,8 @@ namespace nvfeedback
     class HeapAllocator
     {
     public:
+        explicit HeapAllocator(uint64_t heapSizeInBytes) : m_HeapSizeInBytes(heapSizeInBytes) {}
+
         uint32_t AllocateHeap();
         void ReleaseHeap(uint32_t heapId, uint32_t frameIndex);
         void DrainReleaseQueue(uint32_t frameIndex);
@@ -71,8 +83,11 @@ namespace nvfeedback
 
         uint64_t GetTotalAllocatedBytes() const { return m_TotalAllocatedBytes; }
         uint32_t GetNumHeaps() const { return m_NumHeaps; }
+        uint64_t GetHeapSizeInBytes() const { return m_HeapSizeInBytes; }
 
     private:
+        const uint64_t m_HeapSizeInBytes;
+
         std::vector<nvrhi::HeapHandle>   m_Heaps;
         std::vector<nvrhi::BufferHandle> m_Buffers;
         std::vector<uint32_t>            m_FreeHeapIds;
@@ -89,15 +104,17 @@ namespace nvfeedback
     class FeedbackManager
     {
     public:
-        FeedbackManager();
+        explicit FeedbackManager(uint32_t heapSizeInTiles = kDefaultHeapSizeInTiles);
 
         FeedbackTexture* CreateTexture(const nvrhi::TextureDesc& desc);
-        // allowHeapRelease: pass false while m_PendingTileRequests is non-empty.
-        // Releasing empty heaps while tiles are still pending upload causes churn:
-        // TTM has already allocated heap slots for those tiles; releasing the heap
+        // Reads back feedback, updates TTM and queues newly requested tiles in the
+        // TileScheduler.  Empty heaps are only released while no tile is pending:
+        // TTM has already allocated heap slots for pending tiles; releasing the heap
         // then re-allocating it next frame produces the grow-shrink pattern.
-        void BeginFrame(nvrhi::ICommandList* commandList, std::vector<FeedbackTextureUpdate>& results, bool allowHeapRelease = true);
-        void UpdateTileMappings(nvrhi::ICommandList* commandList, std::vector<FeedbackTextureUpdate>& tilesReady);
+        void BeginFrame(nvrhi::ICommandList* commandList);
+        // Pops up to maxTiles pending tiles, highest priority first.
+        void PopScheduledTiles(uint32_t maxTiles, std::pmr::vector<ScheduledTile>& outTiles);
+        void UpdateTileMappings(nvrhi::ICommandList* commandList, std::span<FeedbackTextureUpdate> tilesReady);
         void ResolveFeedback(nvrhi::ICommandList* commandList);
         void EndFrame();
 
@@ -120,8 +137,64 @@ namespace nvfeedback
 
         rtxts::TiledTextureManager* GetTiledTextureManager() { return m_TiledTextureManager.get(); }
 
+        // ─── Streaming budgets (see StreamingBudgetController) ───────────────
+        // Read every frame: tile hysteresis and standby count by BeginFrame, the
+        // resolve count by BeginFrame/EndFrame, m_MaxTilesPerFrame by the caller of
+        // PopScheduledTiles.
+        void SetBudgets(const StreamingBudgets& budgets) { m_Budgets = budgets; }
+        const StreamingBudgets& GetBudgets() const { return m_Budgets; }
+        uint32_t GetHeapSizeInTiles() const { return m_HeapSizeInTiles; }
+
+        // ─── Streaming trace (see StreamingTrace.h) ──────────────────────────
+        // Records every texture, feedback readback, prefetch request and tile mapping
+        // from now on.  Textures created before the call are recorded first.
+        bool StartTraceRecording(const std::filesystem::path& filePath);
+        void StopTraceRecording();
+
+        // ─── Predictive prefetch (see TilePrefetcher) ────────────────────────
+        // Finest mip per texture (GetTextureByIndex order, kPrefetchMipNone = not needed)
+        // the camera is predicted to need soon.  The next BeginFrame hands it to TTM as
+        // whole-texture feedback for textures not yet resident at that mip; the tiles it
+        // adds are scheduled behind every visible tile.  Skipped in low-memory mode.
+        void SetPrefetchRequests(const std::vector<uint8_t>& finestMipPerTexture) { m_PrefetchMips = finestMipPerTexture; }
+        // Size and tiling of a texture, as TilePrefetcher needs it.
+        PrefetchTexture GetPrefetchTexture(uint32_t textureIdx) const;
+
+        // ─── VRAM budget hooks (see VRAMBudgetGovernor) ──────────────────────
+        // Heap bytes held right now, and the part that backs packed mips and can never be released.
+        uint64_t GetHeapBytes() const { return m_HeapAllocator->GetTotalAllocatedBytes(); }
+        uint64_t GetMinimumHeapBytes() const { return (uint64_t)m_NumPackedMipHeaps * m_HeapAllocator->GetHeapSizeInBytes(); }
+        // Caps the TTM heap count `bytes` lower and enters low-memory mode: no standby
+        // tiles, any heap may be defragmented and the feedback asks for one mip coarser
+        // per call (up to kMaxPressureMipBias), so the finest tiles are unmapped, heaps
+        // drain and BeginFrame releases them.  Returns the heap bytes that will be given back.
+        uint64_t ReclaimHeapMemory(uint64_t bytes);
+        // Lifts the heap cap and the feedback bias, and leaves low-memory mode.
+        void     RestoreHeapBudget();
+
+        // ─── Per-texture statistics (see TextureStreamingStats) ──────────────
+        // Source bytes AsyncTileIO read for a texture's tiles (see TileRequest::m_UserTag).
+        void AddTileBytesRead(uint32_t textureIdx, uint64_t bytes);
+        // One report per texture in GetTextureByIndex order, names left empty.
+        // Walks every tile of every texture: meant for exports, not per frame.
+        void GetTextureStreamingReports(std::vector<TextureStreamingReport>& outReports) const;
+
     private:
+        TilePriorityInputs ComputeTilePriorityInputs(const ScheduledTile& tile) const;
+        TileFeedbackState GetTileFeedbackState(const FeedbackTexture& texture) const;
+        StreamingTraceTexture GetTraceTexture(uint32_t textureIdx) const;
+        void ApplyPrefetchRequests(float timeStamp);
+        void MoveDefragmentedTiles(nvrhi::ICommandList* commandList, uint32_t texIdx, std::vector<uint32_t>& tilesToMap);
+        void CopyTileData(nvrhi::ICommandList* commandList, uint32_t srcHeapId, uint32_t srcHeapTileIndex, uint32_t dstHeapId, uint32_t dstHeapTileIndex);
+        void SubmitTileMappings();
+        void MarkMinMipDirty(uint32_t textureIdx);
+
         uint32_t m_FrameIndex = 0;
+        const uint32_t m_HeapSizeInTiles;
+
+        StreamingBudgets m_Budgets;
+        // Textures BeginFrame took from the ringbuffer; EndFrame advances the cursor by it
+        uint32_t m_NumTexturesCollected = 0;
 
         std::vector<std::unique_ptr<FeedbackTexture>> m_Textures;
         std::vector<uint32_t>                         m_TexturesRingbuffer;
@@ -136,12 +209,50 @@ namespace nvfeedback
 
         std::unique_ptr<HeapAllocator>              m_HeapAllocator;
         std::unique_ptr<rtxts::TiledTextureManager> m_TiledTextureManager;
-        std::unordered_set<uint32_t>                m_MinMipDirtyTextures;
+        // Textures whose MinMip UpdateTileMappings uploads: a flag per texture and the list
+        // of flagged ones, as in DirtyTextureList
+        std::vector<uint8_t>                        m_bMinMipDirty;
+        std::vector<uint32_t>                       m_MinMipDirtyTextures;
+        DirtyTextureList                            m_DirtyTextures;    // BeginFrame Step 6 worklist
+        uint32_t                                    m_NumDirtyTexturesScanned = 0;
+        // BeginFrame Step 6 scratch, reused every frame
+        std::vector<uint32_t>                       m_TilesToUnmap;
+        std::vector<uint32_t>                       m_TilesRequestedNew;
+        TileScheduler                               m_TileScheduler;
+
+        StreamingTraceWriter m_TraceWriter;
+
+        // SubmitTileMappings scratch, reused every frame
+        TileMappingBatch                           m_TileMappingBatch;
+        std::vector<nvrhi::TiledTextureCoordinate> m_MappingCoordinates;
+        std::vector<nvrhi::TiledTextureRegion>     m_MappingRegions;
+        std::vector<uint64_t>                      m_MappingByteOffsets;
+        std::vector<nvrhi::TextureTilesMapping>    m_TextureTilesMappings;
+        std::vector<uint8_t>                       m_MinMipScratch;
+
+        // Defragmentation: tiles whose data was copied this frame are remapped by the next BeginFrame
+        TileDefragPlanner                  m_DefragPlanner;
+        std::vector<FeedbackTextureUpdate> m_MovedTilesToRemap;
+        nvrhi::BufferHandle                m_DefragScratchBuffer;
+        uint32_t                           m_NumTilesMoved = 0;
+
+        std::vector<uint8_t> m_PrefetchMips;        // set by SetPrefetchRequests, consumed by BeginFrame
+        std::vector<uint8_t> m_PrefetchMinMipData;  // synthesized feedback (one byte per region)
+        uint32_t             m_NumTexturesPrefetched = 0;
 
         // Number of heaps registered with TiledTextureManager via AddHeap.
         // Includes both packed-mip heaps (allocated in MapPackedMips) and
         // streaming heaps (allocated in BeginFrame Step 4).
         uint32_t m_NumTTMHeaps = 0;
+        // Heaps allocated by MapPackedMips; packed tiles are never unmapped.
+        uint32_t m_NumPackedMipHeaps = 0;
+
+        // Upper bound on m_NumTTMHeaps set by ReclaimHeapMemory (UINT32_MAX = unlimited).
+        uint32_t m_MaxTTMHeaps = UINT32_MAX;
+        bool     m_bLowMemoryMode = false;
+        // Mips added to every sampled feedback region, and the coarsened copy handed to TTM
+        uint32_t             m_PressureMipBias = 0;
+        std::vector<uint8_t> m_BiasedFeedback;
     };
 
 } // namespace nvfeedback
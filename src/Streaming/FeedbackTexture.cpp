@@ -28,6 +28,7 @@ namespace nvfeedback
         device->getTextureTiling(m_ReservedTexture, &m_NumTiles, &m_PackedMipDesc, &m_TileShape, &mipLevels, tilingsInfo.data());
 
         SDL_assert(m_NumTiles > 0 && "getTextureTiling() returned zero tiles");
+        m_FinestResidentMip = m_PackedMipDesc.numStandardMips;
 
         // Register with TTM
         rtxts::TiledLevelDesc tiledLevelDescs[16]{};
@@ -48,6 +49,7 @@ namespace nvfeedback
         }
 
         tiledTextureManager->AddTiledTexture(tiledTextureDesc, m_TiledTextureId);
+        m_TileSlots.resize(tiledTextureManager->GetTileAllocations(m_TiledTextureId).size());
 
         // Create sampler feedback texture (D3D12 only)
         rtxts::TextureDesc feedbackDesc = tiledTextureManager->GetTextureDesc(m_TiledTextureId, rtxts::eFeedbackTexture);
@@ -61,15 +63,17 @@ namespace nvfeedback
         samplerFeedbackTextureDesc.keepInitialState = true;
         m_FeedbackTexture = device->createSamplerFeedbackTexture(m_ReservedTexture, samplerFeedbackTextureDesc);
 
+        m_FeedbackRegionWidth  = feedbackDesc.textureOrMipRegionWidth;
+        m_FeedbackRegionHeight = feedbackDesc.textureOrMipRegionHeight;
+        m_FeedbackRegionsX     = (desc.width - 1) / feedbackDesc.textureOrMipRegionWidth + 1;
+        m_FeedbackRegionsY     = (desc.height - 1) / feedbackDesc.textureOrMipRegionHeight + 1;
+
         // Create readback (resolve) buffers — one per frame-in-flight
         m_FeedbackResolveBuffers.resize(3);
         for (uint32_t i = 0; i < 3; i++)
         {
-            uint32_t feedbackTilesX = (desc.width - 1) / feedbackDesc.textureOrMipRegionWidth + 1;
-            uint32_t feedbackTilesY = (desc.height - 1) / feedbackDesc.textureOrMipRegionHeight + 1;
-
             nvrhi::BufferDesc bufferDesc{};
-            bufferDesc.byteSize = feedbackTilesX * feedbackTilesY;
+            bufferDesc.byteSize = m_FeedbackRegionsX * m_FeedbackRegionsY;
             bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Read;
             bufferDesc.initialState = nvrhi::ResourceStates::ResolveDest;
             bufferDesc.debugName = "Feedback Resolve Buffer";
@@ -95,7 +99,7 @@ namespace nvfeedback
         }
     }
 
-    void FeedbackTexture::GetTileInfo(uint32_t tileIndex, std::vector<FeedbackTextureTileInfo>& tiles)
+    void FeedbackTexture::GetTileInfo(uint32_t tileIndex, std::pmr::vector<FeedbackTextureTileInfo>& tiles)
     {
         tiles.clear();
 
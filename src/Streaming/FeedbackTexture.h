@@ -1,5 +1,7 @@
 #pragma once
 
+#include "TextureStreamingStats.h"
+
 #include <rtxts-ttm/TiledTextureManager.h>
 
 namespace nvfeedback
@@ -31,8 +33,8 @@ namespace nvfeedback
         nvrhi::TextureHandle GetReservedTexture()                       { return m_ReservedTexture; }
         nvrhi::SamplerFeedbackTextureHandle GetSamplerFeedbackTexture() { return m_FeedbackTexture; }
         nvrhi::TextureHandle GetMinMipTexture()                         { return m_MinMipTexture; }
-        bool IsTilePacked(uint32_t tileIndex) { return tileIndex >= m_PackedMipDesc.startTileIndexInOverallResource; }
-        void GetTileInfo(uint32_t tileIndex, std::vector<FeedbackTextureTileInfo>& tiles);
+        bool IsTilePacked(uint32_t tileIndex) const { return tileIndex >= m_PackedMipDesc.startTileIndexInOverallResource; }
+        void GetTileInfo(uint32_t tileIndex, std::pmr::vector<FeedbackTextureTileInfo>& tiles);
 
         // Accessors used by FeedbackManager
         nvrhi::BufferHandle GetFeedbackResolveBuffer(uint32_t frameIndex) { return m_FeedbackResolveBuffers[frameIndex]; }
@@ -49,6 +51,62 @@ namespace nvfeedback
         uint32_t GetManagerIndex() const       { return m_ManagerIndex; }
         void     SetManagerIndex(uint32_t idx) { m_ManagerIndex = idx; }
 
+        // Finest standard mip with at least one mapped tile, as of the last MinMip
+        // update.  Mips finer than this have no resident tiles, so their source
+        // pages are cold.  Starts at numStandardMips (only packed mips resident).
+        uint32_t GetFinestResidentMip() const        { return m_FinestResidentMip; }
+        void     SetFinestResidentMip(uint32_t mip)  { m_FinestResidentMip = mip; }
+
+        // Drops the source pages of mips [firstMip, endMip) once they lose their last
+        // mapped tile.  Set by the owner of the tile source when it registers the
+        // texture, capturing its source handle; without one nothing is evicted.
+        using SourceMipEvictionFn = std::function<void(uint32_t firstMip, uint32_t endMip)>;
+        void SetSourceMipEviction(SourceMipEvictionFn fn) { m_SourceMipEviction = std::move(fn); }
+        void EvictSourceMips(uint32_t firstMip, uint32_t endMip) const
+        {
+            if (m_SourceMipEviction)
+                m_SourceMipEviction(firstMip, endMip);
+        }
+
+        // Sampler feedback region grid (one resolve byte / MinMip texel per region)
+        uint32_t GetFeedbackRegionWidth() const  { return m_FeedbackRegionWidth; }
+        uint32_t GetFeedbackRegionHeight() const { return m_FeedbackRegionHeight; }
+        uint32_t GetFeedbackRegionsX() const     { return m_FeedbackRegionsX; }
+        uint32_t GetFeedbackRegionsY() const     { return m_FeedbackRegionsY; }
+
+        // CPU copies of the last resolved feedback and the last MinMip upload, used
+        // to prioritize tile requests.  Empty until the first readback / upload.
+        //   m_Requested:   finest mip sampled per region (0xFF = not sampled)
+        //   m_Resident:    finest mip resident per region
+        //   m_PrefetchMip: finest mip last requested for the whole texture by the
+        //                  TilePrefetcher (0xFF = none), in frame m_PrefetchFrame
+        struct FeedbackSnapshot
+        {
+            std::vector<uint8_t> m_Requested;
+            std::vector<uint8_t> m_Resident;
+            uint32_t             m_RequestedFrame = 0;
+            uint8_t              m_PrefetchMip    = 0xFF;
+            uint32_t             m_PrefetchFrame  = 0;
+        };
+        FeedbackSnapshot&       GetFeedbackSnapshot()       { return m_FeedbackSnapshot; }
+        const FeedbackSnapshot& GetFeedbackSnapshot() const { return m_FeedbackSnapshot; }
+
+        // Heap slot TTM last handed each tile out at (m_HeapId UINT32_MAX = none), and
+        // whether the GPU mapping points there yet.  A tile that shows up in
+        // GetTilesToMap() while it still has a slot was moved by defragmentation.
+        struct TileSlot
+        {
+            uint32_t m_HeapId        = UINT32_MAX;
+            uint32_t m_HeapTileIndex = 0;
+            uint64_t m_RequestTicks  = 0; // when TTM first handed the tile out, for the latency stat
+            bool     m_bMapped       = false;
+        };
+        std::vector<TileSlot>& GetTileSlots() { return m_TileSlots; }
+        const std::vector<TileSlot>& GetTileSlots() const { return m_TileSlots; }
+
+        TextureStreamingStats&       GetStreamingStats()       { return m_StreamingStats; }
+        const TextureStreamingStats& GetStreamingStats() const { return m_StreamingStats; }
+
     private:
         nvrhi::TextureHandle m_ReservedTexture;
         nvrhi::SamplerFeedbackTextureHandle m_FeedbackTexture;
@@ -62,6 +120,16 @@ namespace nvfeedback
         uint32_t m_TiledTextureId = 0;
         int m_UserIndex = -1;
         uint32_t m_ManagerIndex = UINT32_MAX;
+        uint32_t m_FinestResidentMip = 0;
+        SourceMipEvictionFn m_SourceMipEviction;
+
+        uint32_t m_FeedbackRegionWidth  = 0;
+        uint32_t m_FeedbackRegionHeight = 0;
+        uint32_t m_FeedbackRegionsX     = 0;
+        uint32_t m_FeedbackRegionsY     = 0;
+        FeedbackSnapshot m_FeedbackSnapshot;
+        std::vector<TileSlot> m_TileSlots;
+        TextureStreamingStats m_StreamingStats;
     };
 
 } // namespace nvfeedback
@@ -0,0 +1,145 @@
+#include "GeometryLODScheduler.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace nvfeedback
+{
+    uint32_t GeometryLODScheduler::AddPrimitive(uint32_t lodCount, uint8_t pinnedMask, std::span<const uint32_t> lodBytes)
+    {
+        assert(lodCount > 0 && lodCount <= kMaxGeometryLODs && lodBytes.size() >= lodCount);
+        assert(pinnedMask != 0 && "A primitive needs at least one resident LOD");
+
+        Primitive& primitive = m_Primitives.emplace_back();
+        primitive.m_LODCount     = lodCount;
+        primitive.m_PinnedMask   = pinnedMask;
+        primitive.m_ResidentMask = pinnedMask;
+        for (uint32_t lod = 0; lod < lodCount; ++lod)
+            primitive.m_LODBytes[lod] = lodBytes[lod];
+
+        return (uint32_t)m_Primitives.size() - 1;
+    }
+
+    void GeometryLODScheduler::Update(std::span<const uint32_t> requestedLODs, uint32_t frame)
+    {
+        assert(requestedLODs.size() == m_Primitives.size());
+
+        for (size_t i = 0; i < m_Primitives.size(); ++i)
+        {
+            Primitive& primitive = m_Primitives[i];
+            const uint32_t requested = requestedLODs[i];
+            primitive.m_RequestedLOD = requested < primitive.m_LODCount ? requested : kNoRequest;
+            if (primitive.m_RequestedLOD == kNoRequest)
+                continue;
+
+            primitive.m_LastUsedFrame[primitive.m_RequestedLOD] = frame;
+            primitive.m_LastUsedFrame[GetStandInLOD(primitive.m_ResidentMask, primitive.m_RequestedLOD)] = frame;
+        }
+    }
+
+    void GeometryLODScheduler::GetLoads(uint32_t maxLoads, uint64_t maxBytes, std::vector<GeometryLODRef>& outLoads)
+    {
+        outLoads.clear();
+        if (maxLoads == 0)
+            return;
+
+        std::vector<LoadCandidate>& candidates = m_LoadCandidates;
+        candidates.clear();
+
+        for (uint32_t i = 0; i < (uint32_t)m_Primitives.size(); ++i)
+        {
+            const Primitive& primitive = m_Primitives[i];
+            const uint32_t requested = primitive.m_RequestedLOD;
+            if (requested == kNoRequest || ((primitive.m_ResidentMask | primitive.m_PendingMask) & (1u << requested)))
+                continue;
+
+            const uint32_t standIn = GetStandInLOD(primitive.m_ResidentMask, requested);
+            candidates.push_back({ { i, requested }, standIn > requested ? standIn - requested : 0, primitive.m_LODBytes[requested] });
+        }
+
+        const size_t numSorted = std::min<size_t>(maxLoads, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + numSorted, candidates.end(),
+            [](const LoadCandidate& a, const LoadCandidate& b)
+            {
+                if (a.m_Deficit != b.m_Deficit)
+                    return a.m_Deficit > b.m_Deficit;
+                if (a.m_Bytes != b.m_Bytes)
+                    return a.m_Bytes < b.m_Bytes;
+                return a.m_Ref.m_Primitive < b.m_Ref.m_Primitive;
+            });
+
+        uint64_t bytes = 0;
+        for (size_t i = 0; i < numSorted; ++i)
+        {
+            if (!outLoads.empty() && bytes + candidates[i].m_Bytes > maxBytes)
+                break;
+
+            bytes += candidates[i].m_Bytes;
+            outLoads.push_back(candidates[i].m_Ref);
+        }
+    }
+
+    void GeometryLODScheduler::GetExpired(uint32_t frame, uint32_t hysteresisFrames, std::vector<GeometryLODRef>& outExpired) const
+    {
+        outExpired.clear();
+        for (uint32_t i = 0; i < (uint32_t)m_Primitives.size(); ++i)
+        {
+            const Primitive& primitive = m_Primitives[i];
+            const uint8_t streamedResident = primitive.m_ResidentMask & ~primitive.m_PinnedMask;
+            for (uint32_t lod = 0; lod < primitive.m_LODCount; ++lod)
+            {
+                if ((streamedResident & (1u << lod)) && frame - primitive.m_LastUsedFrame[lod] > hysteresisFrames)
+                    outExpired.push_back({ i, lod });
+            }
+        }
+    }
+
+    void GeometryLODScheduler::GetEvictionCandidates(uint32_t frame, std::vector<GeometryLODRef>& outCandidates) const
+    {
+        outCandidates.clear();
+        for (uint32_t i = 0; i < (uint32_t)m_Primitives.size(); ++i)
+        {
+            const Primitive& primitive = m_Primitives[i];
+            const uint8_t streamedResident = primitive.m_ResidentMask & ~primitive.m_PinnedMask;
+            for (uint32_t lod = 0; lod < primitive.m_LODCount; ++lod)
+            {
+                if ((streamedResident & (1u << lod)) && primitive.m_LastUsedFrame[lod] != frame)
+                    outCandidates.push_back({ i, lod });
+            }
+        }
+
+        std::sort(outCandidates.begin(), outCandidates.end(), [this](const GeometryLODRef& a, const GeometryLODRef& b)
+        {
+            return m_Primitives[a.m_Primitive].m_LastUsedFrame[a.m_LOD] < m_Primitives[b.m_Primitive].m_LastUsedFrame[b.m_LOD];
+        });
+    }
+
+    void GeometryLODScheduler::OnLoadSubmitted(uint32_t primitive, uint32_t lod)
+    {
+        Primitive& p = m_Primitives[primitive];
+        assert(!((p.m_ResidentMask | p.m_PendingMask) & (1u << lod)));
+        p.m_PendingMask |= (uint8_t)(1u << lod);
+        m_NumPending++;
+    }
+
+    void GeometryLODScheduler::OnLoadCompleted(uint32_t primitive, uint32_t lod, uint32_t frame)
+    {
+        Primitive& p = m_Primitives[primitive];
+        assert(p.m_PendingMask & (1u << lod));
+        p.m_PendingMask  &= (uint8_t)~(1u << lod);
+        p.m_ResidentMask |= (uint8_t)(1u << lod);
+        // Counts as used on arrival: the request that asked for it is a few frames old
+        p.m_LastUsedFrame[lod] = frame;
+        m_NumPending--;
+        m_NumResidentStreamed++;
+    }
+
+    void GeometryLODScheduler::OnEvicted(uint32_t primitive, uint32_t lod)
+    {
+        Primitive& p = m_Primitives[primitive];
+        assert((p.m_ResidentMask & (1u << lod)) && !(p.m_PinnedMask & (1u << lod)));
+        p.m_ResidentMask &= (uint8_t)~(1u << lod);
+        m_NumResidentStreamed--;
+    }
+
+} // namespace nvfeedback
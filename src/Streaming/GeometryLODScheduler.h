@@ -0,0 +1,120 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace nvfeedback
+{
+    // ─── GeometryLODScheduler ────────────────────────────────────────────────
+    // Decides which mesh LODs GeometryStreamer loads and evicts, from the LOD
+    // the GPU culling pass selected for each primitive (the finest over its
+    // visible instances, read back a few frames late).
+    //
+    // Per primitive, the pinned LODs (the coarsest one, or all of them for
+    // primitives that are not streamed) are always resident; every other LOD
+    // is loaded when requested and evicted once no request has used it for
+    // the hysteresis period.  Until a requested LOD arrives its primitive
+    // draws a stand-in: the nearest finer resident LOD (never less detail than
+    // asked for), else the nearest coarser one.  A LOD standing in counts as
+    // used, so it is not evicted from under the request it serves.
+    //
+    // Loads are ranked by how many LODs too coarse the stand-in is (visible
+    // detail missing now), then by size, smallest first.  Requests already
+    // served by a finer stand-in still load, last, so the extra triangles go
+    // away.  Not thread-safe.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    static constexpr uint32_t kMaxGeometryLODs = 8; // srrhi::CommonConsts::MAX_LOD_COUNT
+
+    // LOD drawn in place of lod given the resident LODs (see above).  lod itself
+    // when resident; residentMask must not be empty.
+    inline uint32_t GetStandInLOD(uint8_t residentMask, uint32_t lod)
+    {
+        assert(residentMask != 0 && lod < kMaxGeometryLODs);
+        if (residentMask & (1u << lod))
+            return lod;
+
+        for (int finer = (int)lod - 1; finer >= 0; --finer)
+        {
+            if (residentMask & (1u << finer))
+                return (uint32_t)finer;
+        }
+        for (uint32_t coarser = lod + 1; coarser < kMaxGeometryLODs; ++coarser)
+        {
+            if (residentMask & (1u << coarser))
+                return coarser;
+        }
+        return lod;
+    }
+
+    struct GeometryLODRef
+    {
+        uint32_t m_Primitive = 0;
+        uint32_t m_LOD       = 0;
+    };
+
+    class GeometryLODScheduler
+    {
+    public:
+        static constexpr uint32_t kNoRequest = UINT32_MAX;
+
+        // Registers the next primitive (index = registration order).  lodBytes[lod]
+        // is what loading that LOD reads; pinnedMask the LODs resident from the start.
+        uint32_t AddPrimitive(uint32_t lodCount, uint8_t pinnedMask, std::span<const uint32_t> lodBytes);
+
+        // One requested LOD per primitive (kNoRequest = not visible), read back from culling.
+        void Update(std::span<const uint32_t> requestedLODs, uint32_t frame);
+
+        // Up to maxLoads missing LODs in priority order, stopping once maxBytes is
+        // reached (the first load is always returned, however large).
+        void GetLoads(uint32_t maxLoads, uint64_t maxBytes, std::vector<GeometryLODRef>& outLoads);
+        // Resident streamed LODs unused for more than hysteresisFrames.
+        void GetExpired(uint32_t frame, uint32_t hysteresisFrames, std::vector<GeometryLODRef>& outExpired) const;
+        // Resident streamed LODs not used this frame, least recently used first: what
+        // may be evicted to make room in the pools.
+        void GetEvictionCandidates(uint32_t frame, std::vector<GeometryLODRef>& outCandidates) const;
+
+        void OnLoadSubmitted(uint32_t primitive, uint32_t lod);
+        void OnLoadCompleted(uint32_t primitive, uint32_t lod, uint32_t frame);
+        void OnEvicted(uint32_t primitive, uint32_t lod);
+
+        uint32_t GetNumPrimitives() const                  { return (uint32_t)m_Primitives.size(); }
+        uint8_t  GetResidentMask(uint32_t primitive) const { return m_Primitives[primitive].m_ResidentMask; }
+        uint8_t  GetPinnedMask(uint32_t primitive) const   { return m_Primitives[primitive].m_PinnedMask; }
+        uint32_t GetRequestedLOD(uint32_t primitive) const { return m_Primitives[primitive].m_RequestedLOD; }
+        uint32_t GetLODBytes(uint32_t primitive, uint32_t lod) const { return m_Primitives[primitive].m_LODBytes[lod]; }
+        bool     IsStreamed(uint32_t primitive, uint32_t lod) const  { return !(m_Primitives[primitive].m_PinnedMask & (1u << lod)); }
+
+        uint32_t GetNumResidentStreamedLODs() const { return m_NumResidentStreamed; }
+        uint32_t GetNumPendingLODs() const          { return m_NumPending; }
+
+    private:
+        struct Primitive
+        {
+            uint32_t m_LODCount     = 0;
+            uint8_t  m_PinnedMask   = 0;
+            uint8_t  m_ResidentMask = 0;
+            uint8_t  m_PendingMask  = 0;
+            uint32_t m_RequestedLOD = kNoRequest;
+            uint32_t m_LODBytes[kMaxGeometryLODs]      = {};
+            uint32_t m_LastUsedFrame[kMaxGeometryLODs] = {};
+        };
+
+        struct LoadCandidate
+        {
+            GeometryLODRef m_Ref;
+            uint32_t       m_Deficit = 0; // LODs too coarse the stand-in is
+            uint32_t       m_Bytes   = 0;
+        };
+
+        std::vector<Primitive>     m_Primitives;
+        std::vector<LoadCandidate> m_LoadCandidates; // GetLoads scratch, kept for its capacity
+        uint32_t m_NumResidentStreamed = 0;
+        uint32_t m_NumPending          = 0;
+    };
+
+} // namespace nvfeedback
@@ -0,0 +1,88 @@
+#include "GeometryPoolAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace nvfeedback
+{
+    void GeometryPoolAllocator::Reset(uint32_t baseOffset, uint32_t capacity)
+    {
+        m_BaseOffset = baseOffset;
+        m_Capacity   = capacity;
+        m_Used       = 0;
+        m_FreeBlocks.clear();
+        if (capacity > 0)
+            m_FreeBlocks.push_back({ baseOffset, capacity });
+    }
+
+    uint32_t GeometryPoolAllocator::Allocate(uint32_t count)
+    {
+        if (count == 0)
+            return m_BaseOffset;
+
+        for (size_t i = 0; i < m_FreeBlocks.size(); ++i)
+        {
+            FreeBlock& block = m_FreeBlocks[i];
+            if (block.m_Count < count)
+                continue;
+
+            const uint32_t offset = block.m_Offset;
+            block.m_Offset += count;
+            block.m_Count  -= count;
+            if (block.m_Count == 0)
+                m_FreeBlocks.erase(m_FreeBlocks.begin() + i);
+
+            m_Used += count;
+            return offset;
+        }
+
+        return kInvalidOffset;
+    }
+
+    void GeometryPoolAllocator::Free(uint32_t offset, uint32_t count)
+    {
+        if (count == 0)
+            return;
+
+        assert(offset >= m_BaseOffset && offset + count <= m_BaseOffset + m_Capacity && "Range outside the geometry pool");
+        assert(m_Used >= count);
+        m_Used -= count;
+
+        auto next = std::lower_bound(m_FreeBlocks.begin(), m_FreeBlocks.end(), offset,
+            [](const FreeBlock& block, uint32_t value) { return block.m_Offset < value; });
+        assert((next == m_FreeBlocks.end() || offset + count <= next->m_Offset) && "Double free in the geometry pool");
+
+        // Merge with the block before and/or after
+        const bool bMergePrev = next != m_FreeBlocks.begin() && std::prev(next)->m_Offset + std::prev(next)->m_Count == offset;
+        const bool bMergeNext = next != m_FreeBlocks.end() && offset + count == next->m_Offset;
+
+        if (bMergePrev && bMergeNext)
+        {
+            std::prev(next)->m_Count += count + next->m_Count;
+            m_FreeBlocks.erase(next);
+        }
+        else if (bMergePrev)
+        {
+            std::prev(next)->m_Count += count;
+        }
+        else if (bMergeNext)
+        {
+            next->m_Offset  = offset;
+            next->m_Count  += count;
+        }
+        else
+        {
+            m_FreeBlocks.insert(next, { offset, count });
+        }
+    }
+
+    uint32_t GeometryPoolAllocator::GetLargestFreeBlock() const
+    {
+        uint32_t largest = 0;
+        for (const FreeBlock& block : m_FreeBlocks)
+            largest = std::max(largest, block.m_Count);
+        return largest;
+    }
+
+} // namespace nvfeedback
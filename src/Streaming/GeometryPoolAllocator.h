@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace nvfeedback
+{
+    // ─── GeometryPoolAllocator ───────────────────────────────────────────────
+    // Sub-allocates element ranges of one streamed geometry pool: the tail of a
+    // scene buffer (indices, meshlets, meshlet vertices or meshlet triangles)
+    // past the always-resident coarse LODs.
+    //
+    // First fit over a free list sorted by offset; Free() merges the range with
+    // its neighbours, so a pool that was emptied is one block again.  LOD ranges
+    // are a few hundred to a few hundred thousand elements and turn over slowly
+    // (seconds, not frames), which keeps the list short.  Offsets are absolute
+    // buffer element indices (pool base included).  Not thread-safe.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    class GeometryPoolAllocator
+    {
+    public:
+        static constexpr uint32_t kInvalidOffset = UINT32_MAX;
+
+        GeometryPoolAllocator() = default;
+        GeometryPoolAllocator(uint32_t baseOffset, uint32_t capacity) { Reset(baseOffset, capacity); }
+
+        void Reset(uint32_t baseOffset, uint32_t capacity);
+
+        // Offset of count contiguous elements, or kInvalidOffset when no free block
+        // is large enough.  A zero-sized request succeeds without using the pool.
+        uint32_t Allocate(uint32_t count);
+        void Free(uint32_t offset, uint32_t count);
+
+        uint32_t GetBaseOffset() const      { return m_BaseOffset; }
+        uint32_t GetCapacity() const        { return m_Capacity; }
+        uint32_t GetUsed() const            { return m_Used; }
+        uint32_t GetNumFreeBlocks() const   { return (uint32_t)m_FreeBlocks.size(); }
+        uint32_t GetLargestFreeBlock() const;
+
+    private:
+        struct FreeBlock
+        {
+            uint32_t m_Offset = 0;
+            uint32_t m_Count  = 0;
+        };
+
+        uint32_t               m_BaseOffset = 0;
+        uint32_t               m_Capacity   = 0;
+        uint32_t               m_Used       = 0;
+        std::vector<FreeBlock> m_FreeBlocks; // sorted by offset, never adjacent
+    };
+
+} // namespace nvfeedback
@@ -0,0 +1,582 @@
+#include "GeometryStreamer.h"
+#include "../Log.h"
+#include "FeedbackManager.h"
+#include "../Renderer.h"
+
+namespace nvfeedback
+{
+    namespace
+    {
+        constexpr uint32_t kPoolElementBytes[] = { sizeof(uint32_t), sizeof(srrhi::Meshlet), sizeof(uint32_t), sizeof(uint32_t) };
+        constexpr const char* kPoolNames[] = { "indices", "meshlets", "meshlet vertices", "meshlet triangles" };
+
+        bool IsEmissiveMaterial(const Scene& scene, int materialIndex)
+        {
+            if (materialIndex < 0)
+                return false;
+
+            // Same test as RTXDIRenderer's emissive triangle gathering
+            const Scene::Material& material = scene.m_Materials[materialIndex];
+            const Vector4& emissive = material.m_GPU.m_EmissiveFactor;
+            return material.m_EmissiveTexture >= 0 || emissive.x > 0.0f || emissive.y > 0.0f || emissive.z > 0.0f;
+        }
+
+        // Drops the cooked cache pages behind a span copied out of the mapping
+        template <typename T>
+        void EvictSourcePages(const MemoryMappedDataReader& file, std::span<const T> span)
+        {
+            if (span.empty())
+                return;
+            const size_t offset = (size_t)(reinterpret_cast<const uint8_t*>(span.data()) - static_cast<const uint8_t*>(file.GetData()));
+            file.Evict(offset, span.size_bytes());
+        }
+    }
+
+    // ─── Init ────────────────────────────────────────────────────────────────
+
+    bool GeometryStreamer::Init(Scene& scene, std::vector<uint32_t>& allIndices)
+    {
+        PROFILE_FUNCTION();
+        static_assert(std::size(kPoolElementBytes) == Pool_Count && std::size(kPoolNames) == Pool_Count);
+
+        std::shared_ptr<IOState> ioState = std::make_shared<IOState>();
+        if (!scene.MapCPUGeometry(ioState->m_Geometry))
+        {
+            LOG_INFO("[GeometryStreaming] No cooked mesh cache, every mesh LOD stays resident");
+            return false;
+        }
+
+        const Scene::CPUGeometryView& geometry = ioState->m_Geometry;
+        if (geometry.m_MeshData.size() != scene.m_MeshData.size() ||
+            geometry.m_Indices.size() != allIndices.size() ||
+            geometry.m_Meshlets.size() != scene.m_Meshlets.size() ||
+            geometry.m_MeshletVertices.size() != scene.m_MeshletVertices.size() ||
+            geometry.m_MeshletTriangles.size() != scene.m_MeshletTriangles.size())
+        {
+            LOG_WARN("[GeometryStreaming] Cooked mesh cache does not match the loaded scene, every mesh LOD stays resident");
+            return false;
+        }
+
+        const uint32_t numMeshData = (uint32_t)scene.m_MeshData.size();
+
+        m_Primitives.assign(numMeshData, nullptr);
+        for (Scene::Mesh& mesh : scene.m_Meshes)
+        {
+            for (Scene::Primitive& primitive : mesh.m_Primitives)
+                m_Primitives[primitive.m_MeshDataIndex] = &primitive;
+        }
+
+        // 1. Element ranges of every LOD in the cooked arrays.  A LOD's meshlets are
+        //    contiguous, and so are the meshlet vertices and triangles they reference.
+        m_FileRanges.assign((size_t)numMeshData * kMaxGeometryLODs, {});
+        for (uint32_t i = 0; i < numMeshData; ++i)
+        {
+            const srrhi::MeshData& meshData = scene.m_MeshData[i];
+            for (uint32_t lod = 0; lod < meshData.m_LODCount; ++lod)
+            {
+                LODRanges& ranges = GetLODRanges(m_FileRanges, i, lod);
+                ranges.m_Offset[Pool_Indices]  = meshData.m_IndexOffsets[lod];
+                ranges.m_Count[Pool_Indices]   = meshData.m_IndexCounts[lod];
+                ranges.m_Offset[Pool_Meshlets] = meshData.m_MeshletOffsets[lod];
+                ranges.m_Count[Pool_Meshlets]  = meshData.m_MeshletCounts[lod];
+                if (meshData.m_MeshletCounts[lod] == 0)
+                    continue;
+
+                uint32_t vertexBegin = UINT32_MAX, vertexEnd = 0, triangleBegin = UINT32_MAX, triangleEnd = 0;
+                for (uint32_t m = 0; m < meshData.m_MeshletCounts[lod]; ++m)
+                {
+                    const srrhi::Meshlet& meshlet = scene.m_Meshlets[meshData.m_MeshletOffsets[lod] + m];
+                    vertexBegin   = std::min(vertexBegin, meshlet.m_VertexOffset);
+                    vertexEnd     = std::max(vertexEnd, meshlet.m_VertexOffset + meshlet.m_VertexCount);
+                    triangleBegin = std::min(triangleBegin, meshlet.m_TriangleOffset);
+                    triangleEnd   = std::max(triangleEnd, meshlet.m_TriangleOffset + meshlet.m_TriangleCount);
+                }
+                ranges.m_Offset[Pool_MeshletVertices]  = vertexBegin;
+                ranges.m_Count[Pool_MeshletVertices]   = vertexEnd - vertexBegin;
+                ranges.m_Offset[Pool_MeshletTriangles] = triangleBegin;
+                ranges.m_Count[Pool_MeshletTriangles]  = triangleEnd - triangleBegin;
+            }
+        }
+
+        // 2. Pin the coarsest LOD, or every LOD of primitives that cannot be streamed, and
+        //    pack the pinned ranges at the start of the scene arrays
+        std::vector<uint32_t>       indices;
+        std::vector<srrhi::Meshlet> meshlets;
+        std::vector<uint32_t>       meshletVertices;
+        std::vector<uint32_t>       meshletTriangles;
+
+        m_ResidentRanges.assign(m_FileRanges.size(), {});
+        m_LODBLASBytes.assign(m_FileRanges.size(), 0);
+        m_StreamedBLASBytes    = 0;
+        m_MaxStreamedBLASBytes = UINT64_MAX;
+        m_Scheduler = {};
+        m_NumStreamedLODs = 0;
+        m_ResidentBytes   = 0;
+        m_StreamedBytes   = 0;
+
+        uint64_t streamedCount[Pool_Count] = {};
+        uint32_t largestLODCount[Pool_Count] = {};
+        uint32_t numPinnedPrimitives = 0;
+
+        for (uint32_t i = 0; i < numMeshData; ++i)
+        {
+            const uint32_t lodCount = scene.m_MeshData[i].m_LODCount;
+            Scene::Primitive* primitive = m_Primitives[i];
+
+            const uint8_t allLODs = (uint8_t)((1u << lodCount) - 1);
+            const bool bPinAll = lodCount == 1 || !primitive || IsEmissiveMaterial(scene, primitive->m_MaterialIndex);
+            const uint8_t pinnedMask = bPinAll ? allLODs : (uint8_t)(1u << (lodCount - 1));
+            numPinnedPrimitives += (bPinAll && lodCount > 1) ? 1 : 0;
+
+            uint32_t lodBytes[kMaxGeometryLODs] = {};
+            for (uint32_t lod = 0; lod < lodCount; ++lod)
+            {
+                const LODRanges& file = GetLODRanges(m_FileRanges, i, lod);
+                for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+                    lodBytes[lod] += file.m_Count[pool] * kPoolElementBytes[pool];
+
+                if (!(pinnedMask & (1u << lod)))
+                {
+                    for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+                    {
+                        streamedCount[pool]  += file.m_Count[pool];
+                        largestLODCount[pool] = std::max(largestLODCount[pool], file.m_Count[pool]);
+                    }
+                    m_StreamedBytes += lodBytes[lod];
+                    m_NumStreamedLODs++;
+                    continue;
+                }
+
+                LODRanges& resident = GetLODRanges(m_ResidentRanges, i, lod);
+                resident = file;
+                resident.m_Offset[Pool_Indices]          = (uint32_t)indices.size();
+                resident.m_Offset[Pool_Meshlets]         = (uint32_t)meshlets.size();
+                resident.m_Offset[Pool_MeshletVertices]  = (uint32_t)meshletVertices.size();
+                resident.m_Offset[Pool_MeshletTriangles] = (uint32_t)meshletTriangles.size();
+
+                indices.insert(indices.end(), allIndices.begin() + file.m_Offset[Pool_Indices],
+                               allIndices.begin() + file.m_Offset[Pool_Indices] + file.m_Count[Pool_Indices]);
+                for (uint32_t m = 0; m < file.m_Count[Pool_Meshlets]; ++m)
+                {
+                    srrhi::Meshlet meshlet = scene.m_Meshlets[file.m_Offset[Pool_Meshlets] + m];
+                    meshlet.m_VertexOffset   = meshlet.m_VertexOffset - file.m_Offset[Pool_MeshletVertices] + resident.m_Offset[Pool_MeshletVertices];
+                    meshlet.m_TriangleOffset = meshlet.m_TriangleOffset - file.m_Offset[Pool_MeshletTriangles] + resident.m_Offset[Pool_MeshletTriangles];
+                    meshlets.push_back(meshlet);
+                }
+                meshletVertices.insert(meshletVertices.end(), scene.m_MeshletVertices.begin() + file.m_Offset[Pool_MeshletVertices],
+                                       scene.m_MeshletVertices.begin() + file.m_Offset[Pool_MeshletVertices] + file.m_Count[Pool_MeshletVertices]);
+                meshletTriangles.insert(meshletTriangles.end(), scene.m_MeshletTriangles.begin() + file.m_Offset[Pool_MeshletTriangles],
+                                        scene.m_MeshletTriangles.begin() + file.m_Offset[Pool_MeshletTriangles] + file.m_Count[Pool_MeshletTriangles]);
+                m_ResidentBytes += lodBytes[lod];
+            }
+
+            m_Scheduler.AddPrimitive(lodCount, pinnedMask, lodBytes);
+            if (primitive)
+                primitive->m_ResidentLODMask = pinnedMask;
+        }
+
+        // 3. Pools behind the pinned ranges: every streamed LOD when the budget allows,
+        //    else the same fraction of each array (never less than its largest LOD)
+        const double poolScale = m_StreamedBytes > m_PoolBudgetBytes ? (double)m_PoolBudgetBytes / (double)m_StreamedBytes : 1.0;
+        const uint32_t residentCount[Pool_Count] = { (uint32_t)indices.size(), (uint32_t)meshlets.size(), (uint32_t)meshletVertices.size(), (uint32_t)meshletTriangles.size() };
+        uint32_t poolCapacity[Pool_Count] = {};
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+        {
+            const uint64_t scaled = (uint64_t)std::ceil((double)streamedCount[pool] * poolScale);
+            poolCapacity[pool] = (uint32_t)std::min<uint64_t>(streamedCount[pool], std::max<uint64_t>(scaled, largestLODCount[pool]));
+            m_Pools[pool].Reset(residentCount[pool], poolCapacity[pool]);
+        }
+        scene.m_GeometryPoolSizes = { poolCapacity[Pool_Indices], poolCapacity[Pool_Meshlets], poolCapacity[Pool_MeshletVertices], poolCapacity[Pool_MeshletTriangles] };
+
+        allIndices.swap(indices);
+        scene.m_Meshlets.swap(meshlets);
+        scene.m_MeshletVertices.swap(meshletVertices);
+        scene.m_MeshletTriangles.swap(meshletTriangles);
+
+        // 4. MeshData as the GPU sees it: non-resident LODs alias their stand-in
+        m_Scene = &scene;
+        scene.m_GPUMeshData = scene.m_MeshData;
+        for (uint32_t i = 0; i < numMeshData; ++i)
+            WriteGPUMeshData(i);
+
+        // 5. Instances of each primitive, for the BLAS address rows to rewrite
+        m_InstanceOffsets.assign(numMeshData + 1, 0);
+        for (const srrhi::PerInstanceData& instance : scene.m_InstanceData)
+            m_InstanceOffsets[instance.m_MeshDataIndex + 1]++;
+        for (uint32_t i = 0; i < numMeshData; ++i)
+            m_InstanceOffsets[i + 1] += m_InstanceOffsets[i];
+        m_Instances.resize(scene.m_InstanceData.size());
+        {
+            std::vector<uint32_t> cursor(m_InstanceOffsets.begin(), m_InstanceOffsets.end() - 1);
+            for (uint32_t instanceID = 0; instanceID < (uint32_t)scene.m_InstanceData.size(); ++instanceID)
+                m_Instances[cursor[scene.m_InstanceData[instanceID].m_MeshDataIndex]++] = instanceID;
+        }
+
+        // 6. Request buffer, written by the culling passes, and its readbacks
+        nvrhi::IDevice* device = g_Renderer.m_RHI->m_NvrhiDevice;
+        {
+            nvrhi::BufferDesc desc;
+            desc.byteSize = std::max<uint64_t>(1, numMeshData) * sizeof(uint32_t);
+            desc.structStride = sizeof(uint32_t);
+            desc.canHaveUAVs = true;
+            desc.initialState = nvrhi::ResourceStates::UnorderedAccess;
+            desc.keepInitialState = true;
+            desc.debugName = "GeometryLODRequests";
+            m_LODRequestBuffer = device->createBuffer(desc);
+
+            nvrhi::BufferDesc readbackDesc;
+            readbackDesc.byteSize = desc.byteSize;
+            readbackDesc.cpuAccess = nvrhi::CpuAccessMode::Read;
+            m_ReadbackBuffers.resize(kNumFramesInFlight);
+            for (uint32_t i = 0; i < kNumFramesInFlight; ++i)
+            {
+                readbackDesc.debugName = "GeometryLODRequestsReadback" + std::to_string(i);
+                m_ReadbackBuffers[i] = device->createBuffer(readbackDesc);
+            }
+            m_bReadbackWritten.assign(kNumFramesInFlight, false);
+
+            nvrhi::CommandListHandle cmd = g_Renderer.AcquireCommandList();
+            ScopedCommandList scopedCmd{ cmd, "Init Geometry Streaming" };
+            scopedCmd->clearBufferUInt(m_LODRequestBuffer, UINT32_MAX);
+        }
+
+        m_Requests.assign(numMeshData, GeometryLODScheduler::kNoRequest);
+        m_bPrimitiveDirty.assign(numMeshData, false);
+
+        // Loads touch scattered LOD ranges; read-ahead would only pull in their neighbours
+        geometry.m_File->SetAccessHint(MemoryMappedDataReader::AccessHint::Random);
+        m_IOState = std::move(ioState);
+
+        uint64_t poolBytes = 0;
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+            poolBytes += (uint64_t)poolCapacity[pool] * kPoolElementBytes[pool];
+
+        LOG_INFO("[GeometryStreaming] Initialized: %u LODs streamed (%.2f MB), %.2f MB pinned (%u primitives fully), pool %.2f MB",
+                 m_NumStreamedLODs, BYTES_TO_MB(m_StreamedBytes), BYTES_TO_MB(m_ResidentBytes), numPinnedPrimitives, BYTES_TO_MB(poolBytes));
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+        {
+            LOG_INFO("[GeometryStreaming]   %s: %u pinned, %u pool (%llu streamed)", kPoolNames[pool],
+                     residentCount[pool], poolCapacity[pool], (unsigned long long)streamedCount[pool]);
+        }
+        return true;
+    }
+
+    // ─── Per frame ───────────────────────────────────────────────────────────
+
+    void GeometryStreamer::Update(nvrhi::ICommandList* commandList)
+    {
+        PROFILE_FUNCTION();
+        if (!m_Scene)
+            return;
+
+        const uint32_t frame = g_Renderer.m_FrameNumber;
+
+        // 1. Pool ranges evicted kNumFramesInFlight frames ago are no longer read by the GPU
+        while (!m_RetiredRanges.empty() && frame - m_RetiredRanges.front().m_Frame >= kNumFramesInFlight)
+        {
+            FreeRanges(m_RetiredRanges.front().m_Ranges);
+            m_RetiredRanges.pop_front();
+        }
+
+        // 2. Requests resolved kNumFramesInFlight-1 frames ago
+        const uint32_t readIndex = (frame + 1) % kNumFramesInFlight;
+        if (m_bReadbackWritten[readIndex])
+        {
+            PROFILE_SCOPED("Read LOD requests");
+            nvrhi::IDevice* device = g_Renderer.m_RHI->m_NvrhiDevice;
+            const uint32_t* mapped = static_cast<const uint32_t*>(device->mapBuffer(m_ReadbackBuffers[readIndex], nvrhi::CpuAccessMode::Read));
+            if (mapped)
+            {
+                std::copy(mapped, mapped + m_Requests.size(), m_Requests.begin());
+                device->unmapBuffer(m_ReadbackBuffers[readIndex]);
+                m_Scheduler.Update(m_Requests, frame);
+            }
+        }
+
+        // 3. Map the LODs whose data has arrived
+        {
+            std::lock_guard<std::mutex> lock(m_IOState->m_Mutex);
+            m_CompletedLoads.swap(m_IOState->m_Completed);
+        }
+        for (CompletedLoad& load : m_CompletedLoads)
+            MapCompletedLoad(commandList, load);
+        m_CompletedLoads.clear();
+
+        // 4. Evict LODs nothing has asked for during the hysteresis period
+        m_Scheduler.GetExpired(frame, kEvictionHysteresisFrames, m_LODRefs);
+        for (const GeometryLODRef& ref : m_LODRefs)
+            Evict(ref);
+
+        // 5. Submit the most needed missing LODs, unless the VRAM budget holds them back
+        const uint32_t numPending = m_Scheduler.GetNumPendingLODs();
+        if (numPending < kMaxPendingLoads && m_StreamedBLASBytes < m_MaxStreamedBLASBytes)
+        {
+            m_Scheduler.GetLoads(std::min(kMaxLoadsPerFrame, kMaxPendingLoads - numPending), kMaxLoadBytesPerFrame, m_LODRefs);
+            for (const GeometryLODRef& ref : m_LODRefs)
+            {
+                LODRanges poolRanges;
+                if (AllocateRanges(GetLODRanges(m_FileRanges, ref.m_Primitive, ref.m_LOD), poolRanges))
+                {
+                    GetLODRanges(m_ResidentRanges, ref.m_Primitive, ref.m_LOD) = poolRanges;
+                    m_Scheduler.OnLoadSubmitted(ref.m_Primitive, ref.m_LOD);
+                    SubmitLoad(ref, poolRanges);
+                    continue;
+                }
+
+                // Pools full: make room with the least recently used LODs.  Their ranges come
+                // back kNumFramesInFlight frames later, so stop here and retry then, without
+                // evicting more while earlier evictions are still retiring.
+                m_NumFailedAllocations++;
+                if (m_RetiredRanges.empty())
+                {
+                    m_Scheduler.GetEvictionCandidates(frame, m_EvictionCandidates);
+                    const uint32_t neededBytes = m_Scheduler.GetLODBytes(ref.m_Primitive, ref.m_LOD);
+                    uint64_t evictedBytes = 0;
+                    for (size_t i = 0; i < m_EvictionCandidates.size() && evictedBytes < neededBytes; ++i)
+                    {
+                        const GeometryLODRef& victim = m_EvictionCandidates[i];
+                        evictedBytes += m_Scheduler.GetLODBytes(victim.m_Primitive, victim.m_LOD);
+                        Evict(victim);
+                    }
+                }
+                break;
+            }
+        }
+
+        // 6. Upload the MeshData entries and BLAS address rows that changed
+        if (!m_DirtyPrimitives.empty())
+        {
+            PROFILE_SCOPED("Upload MeshData and BLAS addresses");
+            Scene& scene = *m_Scene;
+            for (uint32_t i : m_DirtyPrimitives)
+            {
+                commandList->writeBuffer(scene.m_MeshDataBuffer, &scene.m_GPUMeshData[i], sizeof(srrhi::MeshData), (uint64_t)i * sizeof(srrhi::MeshData));
+                m_bPrimitiveDirty[i] = false;
+
+                if (!m_Primitives[i] || m_Primitives[i]->m_BLAS.empty() || !scene.m_BLASAddressBuffer)
+                    continue;
+
+                uint64_t blasAddresses[srrhi::CommonConsts::MAX_LOD_COUNT];
+                scene.GetBLASAddresses(*m_Primitives[i], blasAddresses);
+                for (uint32_t k = m_InstanceOffsets[i]; k < m_InstanceOffsets[i + 1]; ++k)
+                {
+                    commandList->writeBuffer(scene.m_BLASAddressBuffer, blasAddresses, sizeof(blasAddresses),
+                                             (uint64_t)m_Instances[k] * sizeof(blasAddresses));
+                }
+            }
+            m_DirtyPrimitives.clear();
+        }
+    }
+
+    void GeometryStreamer::ResolveRequests(nvrhi::ICommandList* commandList)
+    {
+        PROFILE_FUNCTION();
+        if (!m_Scene || m_Requests.empty())
+            return;
+
+        const uint32_t writeIndex = g_Renderer.m_FrameNumber % kNumFramesInFlight;
+        commandList->copyBuffer(m_ReadbackBuffers[writeIndex], 0, m_LODRequestBuffer, 0, m_Requests.size() * sizeof(uint32_t));
+        commandList->clearBufferUInt(m_LODRequestBuffer, UINT32_MAX);
+        m_bReadbackWritten[writeIndex] = true;
+    }
+
+    // ─── Loads and evictions ─────────────────────────────────────────────────
+
+    bool GeometryStreamer::AllocateRanges(const LODRanges& fileRanges, LODRanges& outRanges)
+    {
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+        {
+            outRanges.m_Count[pool]  = fileRanges.m_Count[pool];
+            outRanges.m_Offset[pool] = m_Pools[pool].Allocate(fileRanges.m_Count[pool]);
+            if (outRanges.m_Offset[pool] == GeometryPoolAllocator::kInvalidOffset)
+            {
+                // All four or nothing
+                for (uint32_t allocated = 0; allocated < pool; ++allocated)
+                    m_Pools[allocated].Free(outRanges.m_Offset[allocated], outRanges.m_Count[allocated]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void GeometryStreamer::FreeRanges(const LODRanges& ranges)
+    {
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+            m_Pools[pool].Free(ranges.m_Offset[pool], ranges.m_Count[pool]);
+    }
+
+    void GeometryStreamer::SubmitLoad(const GeometryLODRef& ref, const LODRanges& poolRanges)
+    {
+        const LODRanges fileRanges = GetLODRanges(m_FileRanges, ref.m_Primitive, ref.m_LOD);
+
+        g_Renderer.m_TaskScheduler->ScheduleIOTask([ioState = m_IOState, ref, fileRanges, poolRanges]()
+        {
+            PROFILE_SCOPED("Geometry LOD Load");
+            const Scene::CPUGeometryView& geometry = ioState->m_Geometry;
+
+            const std::span<const uint32_t> indices = geometry.m_Indices.subspan(fileRanges.m_Offset[Pool_Indices], fileRanges.m_Count[Pool_Indices]);
+            const std::span<const srrhi::Meshlet> meshlets = geometry.m_Meshlets.subspan(fileRanges.m_Offset[Pool_Meshlets], fileRanges.m_Count[Pool_Meshlets]);
+            const std::span<const uint32_t> meshletVertices = geometry.m_MeshletVertices.subspan(fileRanges.m_Offset[Pool_MeshletVertices], fileRanges.m_Count[Pool_MeshletVertices]);
+            const std::span<const uint32_t> meshletTriangles = geometry.m_MeshletTriangles.subspan(fileRanges.m_Offset[Pool_MeshletTriangles], fileRanges.m_Count[Pool_MeshletTriangles]);
+
+            CompletedLoad load;
+            load.m_Ref = ref;
+            load.m_Indices.assign(indices.begin(), indices.end());
+            load.m_Meshlets.assign(meshlets.begin(), meshlets.end());
+            load.m_MeshletVertices.assign(meshletVertices.begin(), meshletVertices.end());
+            load.m_MeshletTriangles.assign(meshletTriangles.begin(), meshletTriangles.end());
+
+            // Meshlets reference their vertices and triangles by absolute offset
+            for (srrhi::Meshlet& meshlet : load.m_Meshlets)
+            {
+                meshlet.m_VertexOffset   = meshlet.m_VertexOffset - fileRanges.m_Offset[Pool_MeshletVertices] + poolRanges.m_Offset[Pool_MeshletVertices];
+                meshlet.m_TriangleOffset = meshlet.m_TriangleOffset - fileRanges.m_Offset[Pool_MeshletTriangles] + poolRanges.m_Offset[Pool_MeshletTriangles];
+            }
+
+            // The copies are all that is needed until this LOD is evicted and requested again
+            const MemoryMappedDataReader& file = *geometry.m_File;
+            EvictSourcePages(file, indices);
+            EvictSourcePages(file, meshlets);
+            EvictSourcePages(file, meshletVertices);
+            EvictSourcePages(file, meshletTriangles);
+
+            std::lock_guard<std::mutex> lock(ioState->m_Mutex);
+            ioState->m_Completed.push_back(std::move(load));
+        });
+    }
+
+    void GeometryStreamer::MapCompletedLoad(nvrhi::ICommandList* commandList, CompletedLoad& load)
+    {
+        Scene& scene = *m_Scene;
+        const uint32_t primitiveIndex = load.m_Ref.m_Primitive;
+        const uint32_t lod = load.m_Ref.m_LOD;
+        const LODRanges& ranges = GetLODRanges(m_ResidentRanges, primitiveIndex, lod);
+
+        auto Upload = [commandList](nvrhi::IBuffer* buffer, const auto& data, uint32_t offset)
+        {
+            using Element = typename std::decay_t<decltype(data)>::value_type;
+            if (!data.empty())
+                commandList->writeBuffer(buffer, data.data(), data.size() * sizeof(Element), (uint64_t)offset * sizeof(Element));
+        };
+        Upload(scene.m_IndexBuffer, load.m_Indices, ranges.m_Offset[Pool_Indices]);
+        Upload(scene.m_MeshletBuffer, load.m_Meshlets, ranges.m_Offset[Pool_Meshlets]);
+        Upload(scene.m_MeshletVerticesBuffer, load.m_MeshletVertices, ranges.m_Offset[Pool_MeshletVertices]);
+        Upload(scene.m_MeshletTrianglesBuffer, load.m_MeshletTriangles, ranges.m_Offset[Pool_MeshletTriangles]);
+
+        m_Scheduler.OnLoadCompleted(primitiveIndex, lod, g_Renderer.m_FrameNumber);
+        RefreshPrimitive(primitiveIndex);
+        m_NumLoads++;
+        m_BytesLoaded += m_Scheduler.GetLODBytes(primitiveIndex, lod);
+
+        // The BLAS reads the index range just written (BuildPrimitiveBLAS uses m_GPUMeshData).
+        // LODs the VRAM budget has dropped from ray tracing stay without one.
+        Scene::Primitive* primitive = m_Primitives[primitiveIndex];
+        if (primitive && lod < primitive->m_BLAS.size() && lod >= scene.m_BLASMinLOD)
+        {
+            SDL_assert(!primitive->m_BLAS[lod]);
+            const uint64_t blasBytes = scene.BuildPrimitiveBLAS(commandList, *primitive, lod);
+            scene.m_BLASMemoryBytes += blasBytes;
+            GetLODBLASBytes(primitiveIndex, lod) = blasBytes;
+            m_StreamedBLASBytes += blasBytes;
+        }
+    }
+
+    uint64_t GeometryStreamer::Evict(const GeometryLODRef& ref)
+    {
+        Scene& scene = *m_Scene;
+
+        // Counted until evicted even if Scene::DropFinestBLASLOD released it earlier
+        uint64_t& lodBLASBytes = GetLODBLASBytes(ref.m_Primitive, ref.m_LOD);
+        m_StreamedBLASBytes -= std::min(m_StreamedBLASBytes, lodBLASBytes);
+        lodBLASBytes = 0;
+
+        m_Scheduler.OnEvicted(ref.m_Primitive, ref.m_LOD);
+        RefreshPrimitive(ref.m_Primitive);
+        m_NumEvictions++;
+
+        // In-flight frames may still read the range and trace the BLAS
+        m_RetiredRanges.push_back({ GetLODRanges(m_ResidentRanges, ref.m_Primitive, ref.m_LOD), g_Renderer.m_FrameNumber });
+
+        Scene::Primitive* primitive = m_Primitives[ref.m_Primitive];
+        if (!primitive || ref.m_LOD >= primitive->m_BLAS.size() || !primitive->m_BLAS[ref.m_LOD])
+            return 0;
+
+        nvrhi::rt::AccelStructHandle& blas = primitive->m_BLAS[ref.m_LOD];
+        const uint64_t blasBytes = g_Renderer.m_RHI->m_NvrhiDevice->getAccelStructMemoryRequirements(blas).size;
+        scene.m_BLASMemoryBytes -= std::min(scene.m_BLASMemoryBytes, blasBytes);
+        scene.m_DroppedBLAS.push_back(std::move(blas));
+        scene.m_DroppedBLASFrame = g_Renderer.m_FrameNumber;
+        blas = nullptr;
+        return blasBytes;
+    }
+
+    void GeometryStreamer::RefreshPrimitive(uint32_t primitive)
+    {
+        if (m_Primitives[primitive])
+            m_Primitives[primitive]->m_ResidentLODMask = m_Scheduler.GetResidentMask(primitive);
+
+        WriteGPUMeshData(primitive);
+        if (!m_bPrimitiveDirty[primitive])
+        {
+            m_bPrimitiveDirty[primitive] = true;
+            m_DirtyPrimitives.push_back(primitive);
+        }
+    }
+
+    void GeometryStreamer::WriteGPUMeshData(uint32_t primitive)
+    {
+        const uint8_t residentMask = m_Scheduler.GetResidentMask(primitive);
+        srrhi::MeshData& meshData = m_Scene->m_GPUMeshData[primitive];
+
+        // LOD errors stay as cooked so culling keeps selecting (and requesting) the real LOD
+        for (uint32_t lod = 0; lod < meshData.m_LODCount; ++lod)
+        {
+            const LODRanges& ranges = GetLODRanges(m_ResidentRanges, primitive, GetStandInLOD(residentMask, lod));
+            meshData.m_IndexOffsets[lod]   = ranges.m_Offset[Pool_Indices];
+            meshData.m_IndexCounts[lod]    = ranges.m_Count[Pool_Indices];
+            meshData.m_MeshletOffsets[lod] = ranges.m_Offset[Pool_Meshlets];
+            meshData.m_MeshletCounts[lod]  = ranges.m_Count[Pool_Meshlets];
+        }
+    }
+
+    // ─── VRAM budget ─────────────────────────────────────────────────────────
+
+    uint64_t GeometryStreamer::ReclaimStreamedLODs(uint64_t bytes)
+    {
+        if (!m_Scene || m_StreamedBLASBytes == 0)
+            return 0;
+
+        // No LOD was used in frame UINT32_MAX: every resident streamed LOD is a candidate
+        m_Scheduler.GetEvictionCandidates(UINT32_MAX, m_EvictionCandidates);
+        uint64_t freedBytes = 0;
+        for (size_t i = 0; i < m_EvictionCandidates.size() && freedBytes < bytes; ++i)
+            freedBytes += Evict(m_EvictionCandidates[i]);
+
+        m_MaxStreamedBLASBytes = m_StreamedBLASBytes;
+        return freedBytes;
+    }
+
+    // ─── Stats ───────────────────────────────────────────────────────────────
+
+    GeometryStreamerStats GeometryStreamer::GetStats() const
+    {
+        GeometryStreamerStats stats;
+        stats.m_NumPrimitives        = m_Scheduler.GetNumPrimitives();
+        stats.m_NumStreamedLODs      = m_NumStreamedLODs;
+        stats.m_NumResidentLODs      = m_Scheduler.GetNumResidentStreamedLODs();
+        stats.m_NumPendingLODs       = m_Scheduler.GetNumPendingLODs();
+        stats.m_NumLoads             = m_NumLoads;
+        stats.m_NumEvictions         = m_NumEvictions;
+        stats.m_NumFailedAllocations = m_NumFailedAllocations;
+        stats.m_BytesLoaded          = m_BytesLoaded;
+        stats.m_ResidentBytes        = m_ResidentBytes;
+        stats.m_StreamedBytes        = m_StreamedBytes;
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+        {
+            stats.m_PoolBytesUsed     += (uint64_t)m_Pools[pool].GetUsed() * kPoolElementBytes[pool];
+            stats.m_PoolBytesCapacity += (uint64_t)m_Pools[pool].GetCapacity() * kPoolElementBytes[pool];
+        }
+        return stats;
+    }
+
+} // namespace nvfeedback
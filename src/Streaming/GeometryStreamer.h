@@ -0,0 +1,190 @@
+#pragma once
+
+#include "GeometryLODScheduler.h"
+#include "GeometryPoolAllocator.h"
+#include "../Scene.h"
+
+namespace nvfeedback
+{
+    // ─── GeometryStreamer ────────────────────────────────────────────────────
+    // Pages the finer mesh LODs in and out of VRAM, so a scene only keeps
+    // the coarse geometry of what is far away or out of view.
+    //
+    // At load, Init() keeps the pinned LODs of every primitive (the coarsest,
+    // or all of them for primitives that cannot be streamed) packed at the
+    // start of the scene's index and meshlet buffers, and reserves the rest of
+    // each buffer as a pool for streamed LODs.  Vertices are shared by all
+    // LODs of a primitive and stay resident.  Shaders still address geometry
+    // through m_MeshDataBuffer: the entry of a LOD that is not resident points
+    // at its stand-in (GeometryLODScheduler), and so does its row in the BLAS
+    // address table, so raster, culling and ray tracing need no changes.
+    //
+    // Per frame:
+    //   ResolveRequests()  copies the finest LOD the main view's culling passes
+    //                      selected for each primitive to a readback buffer and
+    //                      resets the request buffer.
+    //   Update()           reads the requests back (kNumFramesInFlight-1 frames
+    //                      late), maps loads whose data has arrived (pool upload,
+    //                      BLAS build, MeshData and BLAS address rewrite), evicts
+    //                      expired LODs and submits new loads.  Loads copy their
+    //                      ranges out of the memory-mapped cooked mesh cache on the
+    //                      TaskScheduler I/O lane.
+    //
+    // Evicted pool ranges are reused kNumFramesInFlight frames later; their
+    // BLASes go to Scene::m_DroppedBLAS like the ones the VRAM budget drops.
+    // Primitives with emissive materials are not streamed: RTXDI builds its
+    // light triangles from LOD 0.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    struct GeometryStreamerStats
+    {
+        uint32_t m_NumPrimitives        = 0;
+        uint32_t m_NumStreamedLODs      = 0; // LODs that can be paged in
+        uint32_t m_NumResidentLODs      = 0; // of those, resident now
+        uint32_t m_NumPendingLODs       = 0;
+        uint64_t m_NumLoads             = 0; // cumulative
+        uint64_t m_NumEvictions         = 0; // cumulative
+        uint64_t m_NumFailedAllocations = 0; // loads postponed because the pools were full (cumulative)
+        uint64_t m_BytesLoaded          = 0; // cumulative
+        uint64_t m_PoolBytesUsed        = 0;
+        uint64_t m_PoolBytesCapacity    = 0;
+        uint64_t m_ResidentBytes        = 0; // pinned LODs
+        uint64_t m_StreamedBytes        = 0; // all streamed LODs, as if resident
+    };
+
+    class GeometryStreamer
+    {
+    public:
+        // Streamed LODs submitted per frame and in flight, and the bytes submitted per frame
+        static constexpr uint32_t kMaxLoadsPerFrame        = 64;
+        static constexpr uint32_t kMaxPendingLoads         = 256;
+        static constexpr uint64_t kMaxLoadBytesPerFrame    = 16ull * 1024 * 1024;
+        // Frames a streamed LOD stays resident after its last use
+        static constexpr uint32_t kEvictionHysteresisFrames = 180;
+
+        explicit GeometryStreamer(uint64_t poolBytes) : m_PoolBudgetBytes(poolBytes) {}
+
+        // Call after FinalizeLoadedScene and before the scene buffers are created:
+        // compacts allIndices and the scene's meshlet arrays to the pinned LODs,
+        // fills Scene::m_GPUMeshData, m_GeometryPoolSizes and every primitive's
+        // m_ResidentLODMask.  Returns false (scene untouched) without a cooked mesh cache.
+        bool Init(Scene& scene, std::vector<uint32_t>& allIndices);
+
+        void Update(nvrhi::ICommandList* commandList);
+        void ResolveRequests(nvrhi::ICommandList* commandList);
+
+        // Per-MeshData request buffer bound by the main view's culling passes
+        nvrhi::BufferHandle GetLODRequestBuffer() const { return m_LODRequestBuffer; }
+
+        // After the scene Init() was given moved (AsyncSceneLoader loads into a staging scene)
+        void RebindScene(Scene& scene) { SDL_assert(m_Scene); m_Scene = &scene; }
+
+        bool IsInitialized() const { return m_Scene != nullptr; }
+        GeometryStreamerStats GetStats() const;
+
+        // ─── VRAM budget hooks (see VRAMBudgetGovernor) ──────────────────
+        // The pools are fixed ranges of the scene buffers; what resident streamed
+        // LODs add on top is their BLASes (included in Scene::m_BLASMemoryBytes).
+        uint64_t GetStreamedBLASBytes() const { return m_StreamedBLASBytes; }
+        // Evicts resident streamed LODs, least recently used first whether in use or
+        // not, until their BLASes add up to `bytes`; primitives fall back to their
+        // coarser resident LODs.  Until RestoreStreamedLODs(), no LOD is loaded while
+        // the streamed BLASes are at what is left.  Returns the BLAS bytes freed.
+        uint64_t ReclaimStreamedLODs(uint64_t bytes);
+        // Lifts the load cap of ReclaimStreamedLODs.
+        void     RestoreStreamedLODs() { m_MaxStreamedBLASBytes = UINT64_MAX; }
+
+    private:
+        enum Pool : uint32_t
+        {
+            Pool_Indices,
+            Pool_Meshlets,
+            Pool_MeshletVertices,
+            Pool_MeshletTriangles,
+            Pool_Count
+        };
+
+        // Element ranges of one LOD in the four geometry arrays
+        struct LODRanges
+        {
+            uint32_t m_Offset[Pool_Count] = {};
+            uint32_t m_Count[Pool_Count]  = {};
+        };
+
+        struct CompletedLoad
+        {
+            GeometryLODRef              m_Ref;
+            std::vector<uint32_t>       m_Indices;
+            std::vector<srrhi::Meshlet> m_Meshlets; // offsets already relocated to the pool ranges
+            std::vector<uint32_t>       m_MeshletVertices;
+            std::vector<uint32_t>       m_MeshletTriangles;
+        };
+
+        // Shared with the I/O lane tasks, which may outlive the streamer
+        struct IOState
+        {
+            Scene::CPUGeometryView     m_Geometry;
+            std::mutex                 m_Mutex;
+            std::vector<CompletedLoad> m_Completed; // guarded by m_Mutex
+        };
+
+        struct RetiredRanges
+        {
+            LODRanges m_Ranges;
+            uint32_t  m_Frame = 0;
+        };
+
+        static LODRanges& GetLODRanges(std::vector<LODRanges>& table, uint32_t primitive, uint32_t lod) { return table[(size_t)primitive * kMaxGeometryLODs + lod]; }
+        uint64_t& GetLODBLASBytes(uint32_t primitive, uint32_t lod) { return m_LODBLASBytes[(size_t)primitive * kMaxGeometryLODs + lod]; }
+
+        bool AllocateRanges(const LODRanges& fileRanges, LODRanges& outRanges);
+        void FreeRanges(const LODRanges& ranges);
+        void SubmitLoad(const GeometryLODRef& ref, const LODRanges& poolRanges);
+        void MapCompletedLoad(nvrhi::ICommandList* commandList, CompletedLoad& load);
+        // Returns the BLAS bytes freed
+        uint64_t Evict(const GeometryLODRef& ref);
+        // Points a primitive's m_GPUMeshData LODs at their resident stand-ins
+        void WriteGPUMeshData(uint32_t primitive);
+        // WriteGPUMeshData, then queues the upload of the entry and of the BLAS address
+        // rows of the primitive's instances.
+        void RefreshPrimitive(uint32_t primitive);
+
+        const uint64_t m_PoolBudgetBytes;
+        Scene*         m_Scene = nullptr;
+
+        GeometryLODScheduler  m_Scheduler;
+        GeometryPoolAllocator m_Pools[Pool_Count];
+        std::vector<LODRanges> m_FileRanges;     // [primitive * kMaxGeometryLODs + lod], in the cooked cache
+        std::vector<LODRanges> m_ResidentRanges; // same, in the scene buffers (valid while resident)
+        std::vector<uint64_t>  m_LODBLASBytes;   // same, BLAS built when the LOD was mapped
+        std::vector<Scene::Primitive*> m_Primitives;    // by MeshData index
+        std::vector<uint32_t> m_InstanceOffsets; // instances of primitive i: m_Instances[m_InstanceOffsets[i] .. m_InstanceOffsets[i + 1])
+        std::vector<uint32_t> m_Instances;
+        std::deque<RetiredRanges> m_RetiredRanges;
+        std::shared_ptr<IOState> m_IOState;
+
+        nvrhi::BufferHandle              m_LODRequestBuffer;
+        std::vector<nvrhi::BufferHandle> m_ReadbackBuffers; // kNumFramesInFlight
+        std::vector<bool>                m_bReadbackWritten;
+
+        // Per-frame scratch, kept to avoid reallocating
+        std::vector<uint32_t>       m_Requests;
+        std::vector<GeometryLODRef> m_LODRefs;
+        std::vector<GeometryLODRef> m_EvictionCandidates;
+        std::vector<CompletedLoad>  m_CompletedLoads;
+        std::vector<uint32_t>       m_DirtyPrimitives;
+        std::vector<uint32_t>       m_DirtyInstances;
+        std::vector<bool>           m_bPrimitiveDirty;
+
+        uint32_t m_NumStreamedLODs      = 0;
+        uint64_t m_NumLoads             = 0;
+        uint64_t m_NumEvictions         = 0;
+        uint64_t m_NumFailedAllocations = 0;
+        uint64_t m_BytesLoaded          = 0;
+        uint64_t m_ResidentBytes        = 0;
+        uint64_t m_StreamedBytes        = 0;
+        uint64_t m_StreamedBLASBytes    = 0;
+        uint64_t m_MaxStreamedBLASBytes = UINT64_MAX; // load cap set by ReclaimStreamedLODs
+    };
+
+} // namespace nvfeedback
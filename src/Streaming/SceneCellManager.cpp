@@ -0,0 +1,128 @@
+#include "SceneCellManager.h"
+
+namespace nvfeedback
+{
+    namespace
+    {
+        float DistanceToBounds(const Vector3& point, const Vector3& boundsMin, const Vector3& boundsMax)
+        {
+            const float dx = std::max({ boundsMin.x - point.x, 0.0f, point.x - boundsMax.x });
+            const float dy = std::max({ boundsMin.y - point.y, 0.0f, point.y - boundsMax.y });
+            const float dz = std::max({ boundsMin.z - point.z, 0.0f, point.z - boundsMax.z });
+            return std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+    }
+
+    SceneCellManager::SceneCellManager(const SceneCellParams& params)
+        : m_Params(params)
+    {
+        SDL_assert(m_Params.m_CellSize > 0.0f && "Scene cells need a positive size");
+        m_Params.m_UnloadRadius = std::max(m_Params.m_UnloadRadius, m_Params.m_LoadRadius);
+        m_Params.m_MaxPendingLoads = std::max(m_Params.m_MaxPendingLoads, 1u);
+    }
+
+    uint32_t SceneCellManager::AddItem(const Vector3& center, float radius, uint64_t bytes)
+    {
+        const int32_t cellX = (int32_t)std::floor(center.x / m_Params.m_CellSize);
+        const int32_t cellZ = (int32_t)std::floor(center.z / m_Params.m_CellSize);
+        const uint64_t key = ((uint64_t)(uint32_t)cellX << 32) | (uint32_t)cellZ;
+
+        auto [it, bInserted] = m_CellByCoord.try_emplace(key, (uint32_t)m_Cells.size());
+        if (bInserted)
+            m_Cells.emplace_back();
+
+        const uint32_t cellIndex = it->second;
+        Cell& cell = m_Cells[cellIndex];
+        SDL_assert(cell.m_State == CellState::Unloaded && "Items are added before streaming starts");
+
+        radius = std::max(radius, 0.0f);
+        cell.m_BoundsMin = { std::min(cell.m_BoundsMin.x, center.x - radius), std::min(cell.m_BoundsMin.y, center.y - radius), std::min(cell.m_BoundsMin.z, center.z - radius) };
+        cell.m_BoundsMax = { std::max(cell.m_BoundsMax.x, center.x + radius), std::max(cell.m_BoundsMax.y, center.y + radius), std::max(cell.m_BoundsMax.z, center.z + radius) };
+        cell.m_Bytes += bytes;
+        cell.m_Items.push_back((uint32_t)m_ItemCells.size());
+
+        m_ItemCells.push_back(cellIndex);
+        return cellIndex;
+    }
+
+    void SceneCellManager::Update(const Vector3& cameraPos, std::vector<uint32_t>& outLoads, std::vector<uint32_t>& outUnloads)
+    {
+        PROFILE_FUNCTION();
+        outLoads.clear();
+        outUnloads.clear();
+
+        // 1. Wanted cells: within the load radius, or the unload radius once loaded
+        m_Candidates.clear();
+        for (uint32_t i = 0; i < (uint32_t)m_Cells.size(); ++i)
+        {
+            Cell& cell = m_Cells[i];
+            cell.m_Distance = DistanceToBounds(cameraPos, cell.m_BoundsMin, cell.m_BoundsMax);
+            const float radius = cell.m_State == CellState::Unloaded ? m_Params.m_LoadRadius : m_Params.m_UnloadRadius;
+            if (cell.m_Distance <= radius)
+                m_Candidates.push_back(i);
+        }
+
+        std::sort(m_Candidates.begin(), m_Candidates.end(), [this](uint32_t a, uint32_t b)
+        {
+            if (m_Cells[a].m_Distance != m_Cells[b].m_Distance)
+                return m_Cells[a].m_Distance < m_Cells[b].m_Distance;
+            return a < b;
+        });
+
+        // 2. Admit them nearest first while they fit in the budget
+        m_bAdmitted.assign(m_Cells.size(), false);
+        uint64_t admittedBytes = 0;
+        for (uint32_t i : m_Candidates)
+        {
+            const uint64_t bytes = m_Cells[i].m_Bytes;
+            if (admittedBytes > 0 && admittedBytes + bytes > m_Params.m_BudgetBytes)
+                break;
+
+            admittedBytes += bytes;
+            m_bAdmitted[i] = true;
+        }
+
+        // 3. Unload what was not admitted, load what was, nearest first
+        for (uint32_t i = 0; i < (uint32_t)m_Cells.size(); ++i)
+        {
+            if (m_Cells[i].m_State == CellState::Loaded && !m_bAdmitted[i])
+                outUnloads.push_back(i);
+        }
+
+        for (uint32_t i : m_Candidates)
+        {
+            if (m_NumPending + (uint32_t)outLoads.size() >= m_Params.m_MaxPendingLoads)
+                break;
+            if (m_bAdmitted[i] && m_Cells[i].m_State == CellState::Unloaded)
+                outLoads.push_back(i);
+        }
+    }
+
+    void SceneCellManager::OnLoadSubmitted(uint32_t cell)
+    {
+        Cell& c = m_Cells[cell];
+        SDL_assert(c.m_State == CellState::Unloaded);
+        c.m_State = CellState::Loading;
+        m_NumPending++;
+        m_ResidentBytes += c.m_Bytes;
+    }
+
+    void SceneCellManager::OnLoadCompleted(uint32_t cell)
+    {
+        Cell& c = m_Cells[cell];
+        SDL_assert(c.m_State == CellState::Loading);
+        c.m_State = CellState::Loaded;
+        m_NumPending--;
+        m_NumLoaded++;
+    }
+
+    void SceneCellManager::OnUnloaded(uint32_t cell)
+    {
+        Cell& c = m_Cells[cell];
+        SDL_assert(c.m_State == CellState::Loaded && "Only loaded cells are unloaded");
+        c.m_State = CellState::Unloaded;
+        m_NumLoaded--;
+        m_ResidentBytes -= c.m_Bytes;
+    }
+
+} // namespace nvfeedback
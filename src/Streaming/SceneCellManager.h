@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../Utilities.h"
+
+namespace nvfeedback
+{
+    // ─── SceneCellManager ────────────────────────────────────────────────────
+    // Decides which cells of a partitioned scene SceneCellStreamer keeps
+    // loaded, from the camera position.
+    //
+    // Items (the models of a JSON scene) go into square cells of a grid on the
+    // XZ plane by the centre of their bounding sphere; a cell's bounds grow to
+    // cover its items' spheres, so large models are loaded from as far as any
+    // of their geometry.  Per Update():
+    //   - a cell is wanted when the camera is within m_LoadRadius of its
+    //     bounds, and stays wanted until the camera is farther than
+    //     m_UnloadRadius (hysteresis: walking along a cell boundary does not
+    //     reload it every few frames),
+    //   - wanted cells are admitted nearest first while their bytes fit in
+    //     m_BudgetBytes (loads in flight count); the nearest one is always
+    //     admitted, and the first that does not fit stops admission so a far
+    //     small cell never takes the place of a near large one,
+    //   - loaded cells that are not admitted are unloaded; admitted cells that
+    //     are not loaded are loaded, nearest first, at most m_MaxPendingLoads
+    //     in flight.
+    // Cells being loaded are never unloaded: if unwanted when they complete,
+    // the next Update() unloads them.  Not thread-safe.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    struct SceneCellParams
+    {
+        float    m_CellSize        = 64.0f;
+        float    m_LoadRadius      = 256.0f;
+        float    m_UnloadRadius    = 320.0f; // >= m_LoadRadius
+        uint64_t m_BudgetBytes     = 512ull * 1024 * 1024;
+        uint32_t m_MaxPendingLoads = 4;
+    };
+
+    class SceneCellManager
+    {
+    public:
+        enum class CellState : uint8_t
+        {
+            Unloaded,
+            Loading,
+            Loaded,
+        };
+
+        explicit SceneCellManager(const SceneCellParams& params = {});
+
+        // Adds the next item (index = registration order) and returns the cell it went to.
+        // bytes is what loading the item costs.
+        uint32_t AddItem(const Vector3& center, float radius, uint64_t bytes);
+
+        // Cells to load (nearest first) and to unload for a camera at cameraPos.
+        void Update(const Vector3& cameraPos, std::vector<uint32_t>& outLoads, std::vector<uint32_t>& outUnloads);
+
+        void OnLoadSubmitted(uint32_t cell);
+        void OnLoadCompleted(uint32_t cell);
+        void OnUnloaded(uint32_t cell);
+
+        const SceneCellParams& GetParams() const                  { return m_Params; }
+        // Takes effect at the next Update(): under a lowered budget the farthest loaded
+        // cells are no longer admitted and get unloaded (the VRAM budget's pressure response).
+        void                      SetBudgetBytes(uint64_t bytes)   { m_Params.m_BudgetBytes = bytes; }
+        uint32_t                  GetNumCells() const             { return (uint32_t)m_Cells.size(); }
+        uint32_t                  GetNumItems() const             { return (uint32_t)m_ItemCells.size(); }
+        uint32_t                  GetItemCell(uint32_t item) const { return m_ItemCells[item]; }
+        std::span<const uint32_t> GetCellItems(uint32_t cell) const { return m_Cells[cell].m_Items; }
+        CellState                 GetCellState(uint32_t cell) const { return m_Cells[cell].m_State; }
+        uint64_t                  GetCellBytes(uint32_t cell) const { return m_Cells[cell].m_Bytes; }
+        // Camera distance to the cell's bounds at the last Update()
+        float                     GetCellDistance(uint32_t cell) const { return m_Cells[cell].m_Distance; }
+
+        uint32_t GetNumLoadedCells() const  { return m_NumLoaded; }
+        uint32_t GetNumPendingLoads() const { return m_NumPending; }
+        uint64_t GetResidentBytes() const   { return m_ResidentBytes; } // loaded and loading cells
+
+    private:
+        struct Cell
+        {
+            Vector3               m_BoundsMin{ FLT_MAX, FLT_MAX, FLT_MAX };
+            Vector3               m_BoundsMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            uint64_t              m_Bytes    = 0;
+            float                 m_Distance = FLT_MAX;
+            CellState             m_State    = CellState::Unloaded;
+            std::vector<uint32_t> m_Items;
+        };
+
+        SceneCellParams m_Params;
+        std::vector<Cell> m_Cells;
+        std::vector<uint32_t> m_ItemCells;
+        std::unordered_map<uint64_t, uint32_t> m_CellByCoord; // packed (x, z) grid coordinates
+
+        uint32_t m_NumLoaded     = 0;
+        uint32_t m_NumPending    = 0;
+        uint64_t m_ResidentBytes = 0;
+
+        // Per-Update scratch, kept to avoid reallocating
+        std::vector<uint32_t> m_Candidates;
+        std::vector<bool>     m_bAdmitted;
+    };
+
+} // namespace nvfeedback
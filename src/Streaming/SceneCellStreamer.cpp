@@ -0,0 +1,583 @@
+#include "SceneCellStreamer.h"
+#include "../Log.h"
+#include "../Renderer.h"
+#include "../SceneCache.h"
+
+namespace nvfeedback
+{
+    namespace
+    {
+        constexpr uint32_t kPoolElementBytes[] = { sizeof(srrhi::VertexQuantized), sizeof(uint32_t), sizeof(srrhi::Meshlet), sizeof(uint32_t), sizeof(uint32_t) };
+        constexpr const char* kPoolNames[] = { "vertices", "indices", "meshlets", "meshlet vertices", "meshlet triangles" };
+
+        bool IsEmissiveMaterial(const Scene& scene, int materialIndex)
+        {
+            if (materialIndex < 0)
+                return false;
+
+            // Same test as RTXDIRenderer's emissive triangle gathering
+            const Scene::Material& material = scene.m_Materials[materialIndex];
+            const Vector4& emissive = material.m_GPU.m_EmissiveFactor;
+            return material.m_EmissiveTexture >= 0 || emissive.x > 0.0f || emissive.y > 0.0f || emissive.z > 0.0f;
+        }
+
+        // Smallest sphere enclosing both (center, radius) and (otherCenter, otherRadius)
+        void MergeSphere(Vector3& center, float& radius, const Vector3& otherCenter, float otherRadius)
+        {
+            const float dx = otherCenter.x - center.x, dy = otherCenter.y - center.y, dz = otherCenter.z - center.z;
+            const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+            if (distance + otherRadius <= radius)
+                return;
+            if (distance + radius <= otherRadius)
+            {
+                center = otherCenter;
+                radius = otherRadius;
+                return;
+            }
+
+            const float newRadius = 0.5f * (distance + radius + otherRadius);
+            const float t = (newRadius - radius) / distance;
+            center = { center.x + dx * t, center.y + dy * t, center.z + dz * t };
+            radius = newRadius;
+        }
+    }
+
+    // ─── Init ────────────────────────────────────────────────────────────────
+
+    void SceneCellStreamer::Init(Scene& scene, std::vector<srrhi::VertexQuantized>& allVerticesQuantized, std::vector<uint32_t>& allIndices)
+    {
+        PROFILE_FUNCTION();
+        static_assert(std::size(kPoolElementBytes) == Pool_Count && std::size(kPoolNames) == Pool_Count);
+        SDL_assert(!scene.m_StreamedModels.empty());
+
+        const uint32_t numModels = (uint32_t)scene.m_StreamedModels.size();
+        const uint32_t numMeshData = (uint32_t)scene.m_MeshData.size();
+
+        m_Primitives.assign(numMeshData, nullptr);
+        for (Scene::Mesh& mesh : scene.m_Meshes)
+        {
+            for (Scene::Primitive& primitive : mesh.m_Primitives)
+                m_Primitives[primitive.m_MeshDataIndex] = &primitive;
+        }
+
+        SceneCellParams params;
+        params.m_CellSize        = scene.m_CellStreamingParams.m_CellSize;
+        params.m_LoadRadius      = scene.m_CellStreamingParams.m_LoadRadius;
+        params.m_UnloadRadius    = scene.m_CellStreamingParams.m_UnloadRadius;
+        params.m_MaxPendingLoads = kMaxPendingCellLoads;
+
+        // 1. Pin the models that cannot be streamed and append their geometry to the scene
+        //    arrays; the others become SceneCellManager items, placed by their mesh nodes
+        m_ModelSizes.assign(numModels, {});
+        m_ModelRanges.assign(numModels, {});
+        m_bModelResident.assign(numModels, false);
+        m_ModelBLASBytes.assign(numModels, 0);
+        m_StreamedBLASBytes = 0;
+        m_ItemModels.clear();
+        m_NumPinnedModels = 0;
+        m_PinnedBytes     = 0;
+        m_StreamedBytes   = 0;
+
+        struct StreamedItem
+        {
+            uint32_t m_Model;
+            Vector3  m_Center;
+            float    m_Radius;
+        };
+        std::vector<StreamedItem> items;
+
+        for (uint32_t modelIndex = 0; modelIndex < numModels; ++modelIndex)
+        {
+            const Scene::StreamedModel& model = scene.m_StreamedModels[modelIndex];
+            ModelRanges& sizes = m_ModelSizes[modelIndex];
+            sizes.m_Count[Pool_Vertices]         = model.m_NumVertices;
+            sizes.m_Count[Pool_Indices]          = model.m_NumIndices;
+            sizes.m_Count[Pool_Meshlets]         = model.m_NumMeshlets;
+            sizes.m_Count[Pool_MeshletVertices]  = model.m_NumMeshletVertices;
+            sizes.m_Count[Pool_MeshletTriangles] = model.m_NumMeshletTriangles;
+
+            uint64_t bytes = 0;
+            for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+                bytes += (uint64_t)sizes.m_Count[pool] * kPoolElementBytes[pool];
+
+            bool bPinned = bytes == 0;
+            for (uint32_t i = model.m_FirstMeshData; i < model.m_FirstMeshData + model.m_MeshDataCount && !bPinned; ++i)
+                bPinned = m_Primitives[i] && IsEmissiveMaterial(scene, m_Primitives[i]->m_MaterialIndex);
+
+            Vector3 center{ 0.0f, 0.0f, 0.0f };
+            float radius = -1.0f;
+            for (uint32_t n = model.m_FirstNode; n < model.m_FirstNode + model.m_NodeCount; ++n)
+            {
+                const Scene::Node& node = scene.m_Nodes[n];
+                if (node.m_MeshIndex < 0)
+                    continue;
+
+                bPinned |= node.m_IsDynamic;
+                if (radius < 0.0f)
+                {
+                    center = node.m_Center;
+                    radius = node.m_Radius;
+                }
+                else
+                {
+                    MergeSphere(center, radius, node.m_Center, node.m_Radius);
+                }
+            }
+
+            if (!bPinned)
+            {
+                items.push_back({ modelIndex, center, std::max(radius, 0.0f) });
+                m_StreamedBytes += bytes;
+                continue;
+            }
+
+            ModelRanges& ranges = m_ModelRanges[modelIndex];
+            ranges = sizes;
+            ranges.m_Offset[Pool_Vertices]         = (uint32_t)allVerticesQuantized.size();
+            ranges.m_Offset[Pool_Indices]          = (uint32_t)allIndices.size();
+            ranges.m_Offset[Pool_Meshlets]         = (uint32_t)scene.m_Meshlets.size();
+            ranges.m_Offset[Pool_MeshletVertices]  = (uint32_t)scene.m_MeshletVertices.size();
+            ranges.m_Offset[Pool_MeshletTriangles] = (uint32_t)scene.m_MeshletTriangles.size();
+
+            m_NumPinnedModels++;
+
+            ModelGeometry geometry;
+            if (bytes > 0 && !ReadModelGeometry(model.m_CookedMeshCachePath, ranges, geometry))
+            {
+                LOG_WARN("[CellStreaming] Cannot read %s, its model stays empty", model.m_CookedMeshCachePath.string().c_str());
+                continue;
+            }
+
+            allVerticesQuantized.insert(allVerticesQuantized.end(), geometry.m_Vertices.begin(), geometry.m_Vertices.end());
+            allIndices.insert(allIndices.end(), geometry.m_Indices.begin(), geometry.m_Indices.end());
+            scene.m_Meshlets.insert(scene.m_Meshlets.end(), geometry.m_Meshlets.begin(), geometry.m_Meshlets.end());
+            scene.m_MeshletVertices.insert(scene.m_MeshletVertices.end(), geometry.m_MeshletVertices.begin(), geometry.m_MeshletVertices.end());
+            scene.m_MeshletTriangles.insert(scene.m_MeshletTriangles.end(), geometry.m_MeshletTriangles.begin(), geometry.m_MeshletTriangles.end());
+            m_bModelResident[modelIndex] = true;
+            m_PinnedBytes += bytes;
+        }
+
+        // 2. Cells, admitting what the pools can hold, and the largest one of each array:
+        //    a pool must hold at least the cell nearest the camera, which is always admitted
+        params.m_BudgetBytes = std::min(m_PoolBudgetBytes, m_StreamedBytes);
+        m_Cells = SceneCellManager(params);
+        m_CellBudgetBytes = params.m_BudgetBytes;
+        std::vector<ModelRanges> cellSizes;
+        uint64_t streamedCount[Pool_Count] = {};
+        for (const StreamedItem& item : items)
+        {
+            const ModelRanges& sizes = m_ModelSizes[item.m_Model];
+            uint64_t bytes = 0;
+            for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+            {
+                bytes += (uint64_t)sizes.m_Count[pool] * kPoolElementBytes[pool];
+                streamedCount[pool] += sizes.m_Count[pool];
+            }
+
+            const uint32_t cell = m_Cells.AddItem(item.m_Center, item.m_Radius, bytes);
+            m_ItemModels.push_back(item.m_Model);
+            if (cell >= cellSizes.size())
+                cellSizes.resize(cell + 1);
+            for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+                cellSizes[cell].m_Count[pool] += sizes.m_Count[pool];
+        }
+
+        // 3. Pools behind the pinned models: every streamed model when the budget allows,
+        //    else the same fraction of each array plus room for the largest cell
+        const double poolScale = m_StreamedBytes > m_PoolBudgetBytes ? (double)m_PoolBudgetBytes / (double)m_StreamedBytes : 1.0;
+        const uint32_t residentCount[Pool_Count] = { (uint32_t)allVerticesQuantized.size(), (uint32_t)allIndices.size(), (uint32_t)scene.m_Meshlets.size(),
+                                                     (uint32_t)scene.m_MeshletVertices.size(), (uint32_t)scene.m_MeshletTriangles.size() };
+        uint32_t poolCapacity[Pool_Count] = {};
+        uint64_t poolBytes = 0;
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+        {
+            uint32_t largestCellCount = 0;
+            for (const ModelRanges& sizes : cellSizes)
+                largestCellCount = std::max(largestCellCount, sizes.m_Count[pool]);
+
+            const uint64_t scaled = (uint64_t)std::ceil((double)streamedCount[pool] * poolScale);
+            poolCapacity[pool] = (uint32_t)std::min<uint64_t>(streamedCount[pool], scaled + largestCellCount);
+            m_Pools[pool].Reset(residentCount[pool], poolCapacity[pool]);
+            poolBytes += (uint64_t)poolCapacity[pool] * kPoolElementBytes[pool];
+        }
+        scene.m_GeometryPoolSizes = { poolCapacity[Pool_Indices], poolCapacity[Pool_Meshlets], poolCapacity[Pool_MeshletVertices],
+                                      poolCapacity[Pool_MeshletTriangles], poolCapacity[Pool_Vertices] };
+
+        // 4. MeshData as the GPU sees it, and residency: streamed models start unloaded
+        m_Scene = &scene;
+        scene.m_GPUMeshData = scene.m_MeshData;
+        for (uint32_t modelIndex = 0; modelIndex < numModels; ++modelIndex)
+            WriteGPUMeshData(modelIndex);
+        m_bModelDirty.assign(numModels, false);
+
+        m_IOState = std::make_shared<IOState>();
+
+        LOG_INFO("[CellStreaming] Initialized: %u models in %u cells (%.2f MB), %u pinned (%.2f MB), pool %.2f MB",
+                 numModels - m_NumPinnedModels, m_Cells.GetNumCells(), BYTES_TO_MB(m_StreamedBytes), m_NumPinnedModels, BYTES_TO_MB(m_PinnedBytes), BYTES_TO_MB(poolBytes));
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+            LOG_INFO("[CellStreaming]   %s: %u pinned, %u pool", kPoolNames[pool], residentCount[pool], poolCapacity[pool]);
+    }
+
+    // ─── Per frame ───────────────────────────────────────────────────────────
+
+    void SceneCellStreamer::Update(nvrhi::ICommandList* commandList)
+    {
+        PROFILE_FUNCTION();
+        if (!m_Scene)
+            return;
+
+        const uint32_t frame = g_Renderer.m_FrameNumber;
+
+        // 1. Pool ranges unloaded kNumFramesInFlight frames ago are no longer read by the GPU
+        while (!m_RetiredRanges.empty() && frame - m_RetiredRanges.front().m_Frame >= kNumFramesInFlight)
+        {
+            FreeRanges(m_RetiredRanges.front().m_Ranges);
+            m_RetiredRanges.pop_front();
+        }
+
+        // 2. Map the cells whose data has arrived
+        {
+            std::lock_guard<std::mutex> lock(m_IOState->m_Mutex);
+            m_CompletedLoads.swap(m_IOState->m_Completed);
+        }
+        for (CompletedLoad& load : m_CompletedLoads)
+            MapCompletedLoad(commandList, load);
+        m_CompletedLoads.clear();
+
+        // 3. Unload the cells the camera has left, then load the ones it approaches.  A cell
+        //    that does not fit in the pools yet waits for the unloaded ranges to retire.
+        m_Cells.Update(m_Scene->m_Camera.GetPosition(), m_Loads, m_Unloads);
+        for (uint32_t cell : m_Unloads)
+            Unload(cell);
+
+        for (uint32_t cell : m_Loads)
+        {
+            if (!SubmitLoad(cell))
+            {
+                m_NumFailedAllocations++;
+                break;
+            }
+        }
+
+        // 4. Upload the MeshData entries and BLAS address rows that changed
+        if (!m_DirtyModels.empty())
+        {
+            PROFILE_SCOPED("Upload MeshData and BLAS addresses");
+            Scene& scene = *m_Scene;
+            for (uint32_t modelIndex : m_DirtyModels)
+            {
+                m_bModelDirty[modelIndex] = false;
+                const Scene::StreamedModel& model = scene.m_StreamedModels[modelIndex];
+                if (model.m_MeshDataCount > 0)
+                {
+                    commandList->writeBuffer(scene.m_MeshDataBuffer, &scene.m_GPUMeshData[model.m_FirstMeshData], model.m_MeshDataCount * sizeof(srrhi::MeshData),
+                                             (uint64_t)model.m_FirstMeshData * sizeof(srrhi::MeshData));
+                }
+
+                if (!scene.m_BLASAddressBuffer)
+                    continue;
+
+                for (uint32_t n = model.m_FirstNode; n < model.m_FirstNode + model.m_NodeCount; ++n)
+                {
+                    for (uint32_t instanceID : scene.m_Nodes[n].m_InstanceIndices)
+                    {
+                        const Scene::Primitive* primitive = m_Primitives[scene.m_InstanceData[instanceID].m_MeshDataIndex];
+                        if (!primitive || primitive->m_BLAS.empty())
+                            continue;
+
+                        uint64_t blasAddresses[srrhi::CommonConsts::MAX_LOD_COUNT];
+                        scene.GetBLASAddresses(*primitive, blasAddresses);
+                        commandList->writeBuffer(scene.m_BLASAddressBuffer, blasAddresses, sizeof(blasAddresses),
+                                                 (uint64_t)instanceID * sizeof(blasAddresses));
+                    }
+                }
+            }
+            m_DirtyModels.clear();
+        }
+    }
+
+    // ─── Loads and unloads ───────────────────────────────────────────────────
+
+    bool SceneCellStreamer::ReadModelGeometry(const std::filesystem::path& cachePath, const ModelRanges& ranges, ModelGeometry& out)
+    {
+        Scene::CPUGeometryView geometry;
+        if (!SceneCache::MapCookedMesh(cachePath, geometry) ||
+            geometry.m_VerticesQuantized.size() != ranges.m_Count[Pool_Vertices] ||
+            geometry.m_Indices.size() != ranges.m_Count[Pool_Indices] ||
+            geometry.m_Meshlets.size() != ranges.m_Count[Pool_Meshlets] ||
+            geometry.m_MeshletVertices.size() != ranges.m_Count[Pool_MeshletVertices] ||
+            geometry.m_MeshletTriangles.size() != ranges.m_Count[Pool_MeshletTriangles])
+        {
+            return false;
+        }
+
+        // Indices and meshlet vertices are vertex indices, meshlets reference their vertices
+        // and triangles by absolute offset
+        const uint32_t vertexBase = ranges.m_Offset[Pool_Vertices];
+        out.m_Vertices.assign(geometry.m_VerticesQuantized.begin(), geometry.m_VerticesQuantized.end());
+        out.m_Indices.resize(geometry.m_Indices.size());
+        for (size_t i = 0; i < geometry.m_Indices.size(); ++i)
+            out.m_Indices[i] = geometry.m_Indices[i] + vertexBase;
+        out.m_Meshlets.assign(geometry.m_Meshlets.begin(), geometry.m_Meshlets.end());
+        for (srrhi::Meshlet& meshlet : out.m_Meshlets)
+        {
+            meshlet.m_VertexOffset   += ranges.m_Offset[Pool_MeshletVertices];
+            meshlet.m_TriangleOffset += ranges.m_Offset[Pool_MeshletTriangles];
+        }
+        out.m_MeshletVertices.resize(geometry.m_MeshletVertices.size());
+        for (size_t i = 0; i < geometry.m_MeshletVertices.size(); ++i)
+            out.m_MeshletVertices[i] = geometry.m_MeshletVertices[i] + vertexBase;
+        out.m_MeshletTriangles.assign(geometry.m_MeshletTriangles.begin(), geometry.m_MeshletTriangles.end());
+        out.m_bValid = true;
+        return true;
+    }
+
+    bool SceneCellStreamer::AllocateRanges(const ModelRanges& sizes, ModelRanges& outRanges)
+    {
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+        {
+            outRanges.m_Count[pool]  = sizes.m_Count[pool];
+            outRanges.m_Offset[pool] = m_Pools[pool].Allocate(sizes.m_Count[pool]);
+            if (outRanges.m_Offset[pool] == GeometryPoolAllocator::kInvalidOffset)
+            {
+                // All five or nothing
+                for (uint32_t allocated = 0; allocated < pool; ++allocated)
+                    m_Pools[allocated].Free(outRanges.m_Offset[allocated], outRanges.m_Count[allocated]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void SceneCellStreamer::FreeRanges(const ModelRanges& ranges)
+    {
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+            m_Pools[pool].Free(ranges.m_Offset[pool], ranges.m_Count[pool]);
+    }
+
+    bool SceneCellStreamer::SubmitLoad(uint32_t cell)
+    {
+        const std::span<const uint32_t> items = m_Cells.GetCellItems(cell);
+
+        // Every model of the cell or none
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            const uint32_t modelIndex = m_ItemModels[items[i]];
+            if (!AllocateRanges(m_ModelSizes[modelIndex], m_ModelRanges[modelIndex]))
+            {
+                for (size_t allocated = 0; allocated < i; ++allocated)
+                    FreeRanges(m_ModelRanges[m_ItemModels[items[allocated]]]);
+                return false;
+            }
+        }
+
+        struct ModelLoad
+        {
+            uint32_t              m_Model;
+            std::filesystem::path m_CachePath;
+            ModelRanges           m_Ranges;
+        };
+        std::vector<ModelLoad> loads;
+        loads.reserve(items.size());
+        for (uint32_t item : items)
+        {
+            const uint32_t modelIndex = m_ItemModels[item];
+            loads.push_back({ modelIndex, m_Scene->m_StreamedModels[modelIndex].m_CookedMeshCachePath, m_ModelRanges[modelIndex] });
+        }
+
+        m_Cells.OnLoadSubmitted(cell);
+
+        g_Renderer.m_TaskScheduler->ScheduleIOTask([ioState = m_IOState, cell, loads = std::move(loads)]()
+        {
+            PROFILE_SCOPED("Scene Cell Load");
+
+            CompletedLoad load;
+            load.m_Cell = cell;
+            load.m_Models.resize(loads.size());
+            for (size_t i = 0; i < loads.size(); ++i)
+            {
+                load.m_Models[i].m_Model = loads[i].m_Model;
+                if (!ReadModelGeometry(loads[i].m_CachePath, loads[i].m_Ranges, load.m_Models[i]))
+                    LOG_WARN("[CellStreaming] Cannot read %s, its model stays empty", loads[i].m_CachePath.string().c_str());
+            }
+
+            std::lock_guard<std::mutex> lock(ioState->m_Mutex);
+            ioState->m_Completed.push_back(std::move(load));
+        });
+        return true;
+    }
+
+    void SceneCellStreamer::MapCompletedLoad(nvrhi::ICommandList* commandList, CompletedLoad& load)
+    {
+        Scene& scene = *m_Scene;
+
+        auto Upload = [commandList](nvrhi::IBuffer* buffer, const auto& data, uint32_t offset)
+        {
+            using Element = typename std::decay_t<decltype(data)>::value_type;
+            if (!data.empty())
+                commandList->writeBuffer(buffer, data.data(), data.size() * sizeof(Element), (uint64_t)offset * sizeof(Element));
+        };
+
+        for (ModelGeometry& geometry : load.m_Models)
+        {
+            if (!geometry.m_bValid)
+                continue;
+
+            const uint32_t modelIndex = geometry.m_Model;
+            const ModelRanges& ranges = m_ModelRanges[modelIndex];
+            Upload(scene.m_VertexBufferQuantized, geometry.m_Vertices, ranges.m_Offset[Pool_Vertices]);
+            Upload(scene.m_IndexBuffer, geometry.m_Indices, ranges.m_Offset[Pool_Indices]);
+            Upload(scene.m_MeshletBuffer, geometry.m_Meshlets, ranges.m_Offset[Pool_Meshlets]);
+            Upload(scene.m_MeshletVerticesBuffer, geometry.m_MeshletVertices, ranges.m_Offset[Pool_MeshletVertices]);
+            Upload(scene.m_MeshletTrianglesBuffer, geometry.m_MeshletTriangles, ranges.m_Offset[Pool_MeshletTriangles]);
+
+            m_bModelResident[modelIndex] = true;
+            RefreshModel(modelIndex);
+            for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+                m_BytesLoaded += (uint64_t)ranges.m_Count[pool] * kPoolElementBytes[pool];
+
+            // The BLASes read the ranges just written (BuildPrimitiveBLAS uses m_GPUMeshData).
+            // LODs the VRAM budget has dropped from ray tracing stay without one.  Unlike
+            // those of pinned models, the coarsest are no BLAS floor: unloading frees them.
+            const Scene::StreamedModel& model = scene.m_StreamedModels[modelIndex];
+            for (uint32_t i = model.m_FirstMeshData; i < model.m_FirstMeshData + model.m_MeshDataCount; ++i)
+            {
+                Scene::Primitive* primitive = m_Primitives[i];
+                if (!primitive || primitive->m_BLAS.empty())
+                    continue;
+
+                const uint32_t lodCount = (uint32_t)primitive->m_BLAS.size();
+                for (uint32_t lod = std::min(scene.m_BLASMinLOD, lodCount - 1); lod < lodCount; ++lod)
+                {
+                    SDL_assert(!primitive->m_BLAS[lod]);
+                    const uint64_t blasBytes = scene.BuildPrimitiveBLAS(commandList, *primitive, lod);
+                    scene.m_BLASMemoryBytes += blasBytes;
+                    m_ModelBLASBytes[modelIndex] += blasBytes;
+                    m_StreamedBLASBytes += blasBytes;
+                }
+            }
+        }
+
+        m_Cells.OnLoadCompleted(load.m_Cell);
+        m_NumLoads++;
+    }
+
+    void SceneCellStreamer::Unload(uint32_t cell)
+    {
+        Scene& scene = *m_Scene;
+        nvrhi::IDevice* device = g_Renderer.m_RHI->m_NvrhiDevice;
+
+        for (uint32_t item : m_Cells.GetCellItems(cell))
+        {
+            const uint32_t modelIndex = m_ItemModels[item];
+            m_bModelResident[modelIndex] = false;
+            RefreshModel(modelIndex);
+
+            // In-flight frames may still read the ranges and trace the BLASes
+            m_RetiredRanges.push_back({ m_ModelRanges[modelIndex], g_Renderer.m_FrameNumber });
+            m_StreamedBLASBytes -= std::min(m_StreamedBLASBytes, m_ModelBLASBytes[modelIndex]);
+            m_ModelBLASBytes[modelIndex] = 0;
+
+            const Scene::StreamedModel& model = scene.m_StreamedModels[modelIndex];
+            for (uint32_t i = model.m_FirstMeshData; i < model.m_FirstMeshData + model.m_MeshDataCount; ++i)
+            {
+                Scene::Primitive* primitive = m_Primitives[i];
+                if (!primitive)
+                    continue;
+
+                const uint32_t lodCount = (uint32_t)primitive->m_BLAS.size();
+                for (uint32_t lod = 0; lod < lodCount; ++lod)
+                {
+                    nvrhi::rt::AccelStructHandle& blas = primitive->m_BLAS[lod];
+                    if (!blas)
+                        continue;
+
+                    const uint64_t blasBytes = device->getAccelStructMemoryRequirements(blas).size;
+                    scene.m_BLASMemoryBytes -= std::min(scene.m_BLASMemoryBytes, blasBytes);
+                    scene.m_DroppedBLAS.push_back(std::move(blas));
+                    scene.m_DroppedBLASFrame = g_Renderer.m_FrameNumber;
+                    blas = nullptr;
+                }
+            }
+        }
+
+        m_Cells.OnUnloaded(cell);
+        m_NumUnloads++;
+    }
+
+    void SceneCellStreamer::RefreshModel(uint32_t modelIndex)
+    {
+        WriteGPUMeshData(modelIndex);
+        if (!m_bModelDirty[modelIndex])
+        {
+            m_bModelDirty[modelIndex] = true;
+            m_DirtyModels.push_back(modelIndex);
+        }
+    }
+
+    void SceneCellStreamer::WriteGPUMeshData(uint32_t modelIndex)
+    {
+        Scene& scene = *m_Scene;
+        const Scene::StreamedModel& model = scene.m_StreamedModels[modelIndex];
+        const ModelRanges& ranges = m_ModelRanges[modelIndex];
+        const bool bResident = m_bModelResident[modelIndex];
+
+        // LOD counts and errors stay as cooked so culling keeps selecting the same LODs
+        for (uint32_t i = model.m_FirstMeshData; i < model.m_FirstMeshData + model.m_MeshDataCount; ++i)
+        {
+            const srrhi::MeshData& cooked = scene.m_MeshData[i];
+            srrhi::MeshData& meshData = scene.m_GPUMeshData[i];
+            meshData = cooked;
+            for (uint32_t lod = 0; lod < cooked.m_LODCount; ++lod)
+            {
+                meshData.m_IndexOffsets[lod]   = bResident ? cooked.m_IndexOffsets[lod] + ranges.m_Offset[Pool_Indices] : 0;
+                meshData.m_IndexCounts[lod]    = bResident ? cooked.m_IndexCounts[lod] : 0;
+                meshData.m_MeshletOffsets[lod] = bResident ? cooked.m_MeshletOffsets[lod] + ranges.m_Offset[Pool_Meshlets] : 0;
+                meshData.m_MeshletCounts[lod]  = bResident ? cooked.m_MeshletCounts[lod] : 0;
+            }
+
+            if (m_Primitives[i])
+                m_Primitives[i]->m_ResidentLODMask = bResident ? (uint8_t)((1u << cooked.m_LODCount) - 1) : 0;
+        }
+    }
+
+    // ─── VRAM budget ─────────────────────────────────────────────────────────
+
+    uint64_t SceneCellStreamer::ReclaimCellMemory(uint64_t bytes)
+    {
+        const uint64_t residentBytes = m_Cells.GetResidentBytes();
+        if (m_StreamedBLASBytes == 0 || residentBytes == 0)
+            return 0;
+
+        // A cell's BLASes scale with its geometry: give up the same share of both
+        const uint64_t reclaimBytes = std::min(bytes, m_StreamedBLASBytes);
+        const double   share        = (double)reclaimBytes / (double)m_StreamedBLASBytes;
+        m_Cells.SetBudgetBytes(residentBytes - (uint64_t)((double)residentBytes * share));
+        return reclaimBytes;
+    }
+
+    // ─── Stats ───────────────────────────────────────────────────────────────
+
+    SceneCellStreamerStats SceneCellStreamer::GetStats() const
+    {
+        SceneCellStreamerStats stats;
+        stats.m_NumModels            = (uint32_t)m_ModelSizes.size();
+        stats.m_NumPinnedModels      = m_NumPinnedModels;
+        stats.m_NumCells             = m_Cells.GetNumCells();
+        stats.m_NumLoadedCells       = m_Cells.GetNumLoadedCells();
+        stats.m_NumPendingCells      = m_Cells.GetNumPendingLoads();
+        stats.m_NumLoads             = m_NumLoads;
+        stats.m_NumUnloads           = m_NumUnloads;
+        stats.m_NumFailedAllocations = m_NumFailedAllocations;
+        stats.m_BytesLoaded          = m_BytesLoaded;
+        stats.m_PinnedBytes          = m_PinnedBytes;
+        stats.m_StreamedBytes        = m_StreamedBytes;
+        for (uint32_t pool = 0; pool < Pool_Count; ++pool)
+        {
+            stats.m_PoolBytesUsed     += (uint64_t)m_Pools[pool].GetUsed() * kPoolElementBytes[pool];
+            stats.m_PoolBytesCapacity += (uint64_t)m_Pools[pool].GetCapacity() * kPoolElementBytes[pool];
+        }
+        return stats;
+    }
+
+} // namespace nvfeedback
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "GeometryPoolAllocator.h"
+#include "SceneCellManager.h"
+#include "../Scene.h"
+
+namespace nvfeedback
+{
+    // ─── SceneCellStreamer ───────────────────────────────────────────────────
+    // Loads and unloads the models of a partitioned JSON scene (one with a
+    // "cellStreaming" object) by camera distance, so a world larger than VRAM
+    // only keeps the geometry around the camera.
+    //
+    // SceneLoader loads the non-mesh data of every model (nodes, materials,
+    // textures, lights) and only the mesh layout of their cooked mesh caches
+    // (Scene::m_StreamedModels).  At load, Init() appends the geometry of the
+    // models that cannot be streamed to the scene arrays, reserves the rest of
+    // each geometry buffer as a pool (vertices, indices, meshlets, meshlet
+    // vertices and triangles) and hands the other models to a SceneCellManager
+    // by the bounds of their mesh nodes.
+    //
+    // Per frame, Update():
+    //   - maps the cells whose data has arrived: pool upload, MeshData rewrite,
+    //     BLAS build and BLAS address rows of the models' instances,
+    //   - unloads the cells the manager no longer wants: their MeshData entries
+    //     get empty LODs, so raster and culling draw nothing, and their BLAS
+    //     address rows go null, which TLASPatch_CS turns into inactive
+    //     instances.  Nodes, instances and materials stay, so instance indices
+    //     are stable and nothing is rebuilt,
+    //   - submits new cell loads, which copy and relocate each model's arrays
+    //     out of its memory-mapped cooked mesh cache on the TaskScheduler I/O
+    //     lane.
+    //
+    // Unloaded pool ranges are reused kNumFramesInFlight frames later; their
+    // BLASes go to Scene::m_DroppedBLAS.  Models with emissive materials
+    // (RTXDI builds its light triangles once, at load) or animated mesh nodes
+    // are pinned.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    struct SceneCellStreamerStats
+    {
+        uint32_t m_NumModels            = 0;
+        uint32_t m_NumPinnedModels      = 0;
+        uint32_t m_NumCells             = 0;
+        uint32_t m_NumLoadedCells       = 0;
+        uint32_t m_NumPendingCells      = 0;
+        uint64_t m_NumLoads             = 0; // cumulative, in cells
+        uint64_t m_NumUnloads           = 0; // cumulative, in cells
+        uint64_t m_NumFailedAllocations = 0; // loads postponed because the pools were full (cumulative)
+        uint64_t m_BytesLoaded          = 0; // cumulative
+        uint64_t m_PoolBytesUsed        = 0;
+        uint64_t m_PoolBytesCapacity    = 0;
+        uint64_t m_PinnedBytes          = 0;
+        uint64_t m_StreamedBytes        = 0; // all streamed models, as if loaded
+    };
+
+    class SceneCellStreamer
+    {
+    public:
+        // Cell loads in flight
+        static constexpr uint32_t kMaxPendingCellLoads = 4;
+
+        explicit SceneCellStreamer(uint64_t poolBytes) : m_PoolBudgetBytes(poolBytes) {}
+
+        // Call after FinalizeLoadedScene and before the scene buffers are created, for a
+        // scene with m_StreamedModels: appends the pinned models to allVerticesQuantized,
+        // allIndices and the scene's meshlet arrays, and fills Scene::m_GPUMeshData,
+        // m_GeometryPoolSizes and every primitive's m_ResidentLODMask.
+        void Init(Scene& scene, std::vector<srrhi::VertexQuantized>& allVerticesQuantized, std::vector<uint32_t>& allIndices);
+
+        void Update(nvrhi::ICommandList* commandList);
+
+        // After the scene Init() was given moved (AsyncSceneLoader loads into a staging scene)
+        void RebindScene(Scene& scene) { SDL_assert(m_Scene); m_Scene = &scene; }
+
+        bool IsInitialized() const { return m_Scene != nullptr; }
+        SceneCellStreamerStats GetStats() const;
+
+        // ─── VRAM budget hooks (see VRAMBudgetGovernor) ──────────────────
+        // The pools are fixed ranges of the scene buffers; what loaded cells add on
+        // top is their BLASes (included in Scene::m_BLASMemoryBytes).
+        uint64_t GetStreamedBLASBytes() const { return m_StreamedBLASBytes; }
+        // Lowers the SceneCellManager budget by the share of the loaded cells whose
+        // BLASes make up `bytes`, so the next Update() unloads the farthest ones.
+        // Returns that estimate (the cell nearest the camera always stays).
+        uint64_t ReclaimCellMemory(uint64_t bytes);
+        // Back to the budget set by Init().
+        void     RestoreCellBudget() { m_Cells.SetBudgetBytes(m_CellBudgetBytes); }
+
+    private:
+        enum Pool : uint32_t
+        {
+            Pool_Vertices,
+            Pool_Indices,
+            Pool_Meshlets,
+            Pool_MeshletVertices,
+            Pool_MeshletTriangles,
+            Pool_Count
+        };
+
+        // Element ranges of one model in the five geometry arrays
+        struct ModelRanges
+        {
+            uint32_t m_Offset[Pool_Count] = {};
+            uint32_t m_Count[Pool_Count]  = {};
+        };
+
+        // A model's arrays, relocated to its ranges in the scene buffers
+        struct ModelGeometry
+        {
+            uint32_t                            m_Model = 0;
+            bool                                m_bValid = false;
+            std::vector<srrhi::VertexQuantized> m_Vertices;
+            std::vector<uint32_t>               m_Indices;
+            std::vector<srrhi::Meshlet>         m_Meshlets;
+            std::vector<uint32_t>               m_MeshletVertices;
+            std::vector<uint32_t>               m_MeshletTriangles;
+        };
+
+        struct CompletedLoad
+        {
+            uint32_t                   m_Cell = 0;
+            std::vector<ModelGeometry> m_Models;
+        };
+
+        // Shared with the I/O lane tasks, which may outlive the streamer
+        struct IOState
+        {
+            std::mutex                 m_Mutex;
+            std::vector<CompletedLoad> m_Completed; // guarded by m_Mutex
+        };
+
+        struct RetiredRanges
+        {
+            ModelRanges m_Ranges;
+            uint32_t    m_Frame = 0;
+        };
+
+        // Copies a model's arrays out of its cooked mesh cache and relocates them to ranges.
+        // Returns false when the cache no longer matches the layout loaded with the scene.
+        static bool ReadModelGeometry(const std::filesystem::path& cachePath, const ModelRanges& ranges, ModelGeometry& out);
+
+        bool AllocateRanges(const ModelRanges& sizes, ModelRanges& outRanges);
+        void FreeRanges(const ModelRanges& ranges);
+        bool SubmitLoad(uint32_t cell);
+        void MapCompletedLoad(nvrhi::ICommandList* commandList, CompletedLoad& load);
+        void Unload(uint32_t cell);
+        // Points the model's m_GPUMeshData entries at its ranges, or at nothing while unloaded,
+        // and sets its primitives' m_ResidentLODMask
+        void WriteGPUMeshData(uint32_t model);
+        // WriteGPUMeshData, then queues the upload of the entries and of the BLAS address
+        // rows of the model's instances.
+        void RefreshModel(uint32_t model);
+
+        const uint64_t m_PoolBudgetBytes;
+        Scene*         m_Scene = nullptr;
+
+        SceneCellManager      m_Cells;
+        GeometryPoolAllocator m_Pools[Pool_Count];
+        std::vector<ModelRanges> m_ModelSizes;     // element counts of each model's arrays (offsets unused)
+        std::vector<ModelRanges> m_ModelRanges;    // in the scene buffers (valid while loaded or loading)
+        std::vector<bool>        m_bModelResident; // geometry in the scene buffers
+        std::vector<uint64_t>    m_ModelBLASBytes; // BLASes built when the model was mapped
+        std::vector<uint32_t>    m_ItemModels;     // model of each SceneCellManager item
+        std::vector<Scene::Primitive*> m_Primitives; // by MeshData index
+        std::deque<RetiredRanges> m_RetiredRanges;
+        std::shared_ptr<IOState> m_IOState;
+
+        // Per-frame scratch, kept to avoid reallocating
+        std::vector<uint32_t>      m_Loads;
+        std::vector<uint32_t>      m_Unloads;
+        std::vector<CompletedLoad> m_CompletedLoads;
+        std::vector<uint32_t>      m_DirtyModels;
+        std::vector<bool>          m_bModelDirty;
+
+        uint32_t m_NumPinnedModels      = 0;
+        uint64_t m_NumLoads             = 0;
+        uint64_t m_NumUnloads           = 0;
+        uint64_t m_NumFailedAllocations = 0;
+        uint64_t m_BytesLoaded          = 0;
+        uint64_t m_PinnedBytes          = 0;
+        uint64_t m_StreamedBytes        = 0;
+        uint64_t m_StreamedBLASBytes    = 0;
+        uint64_t m_CellBudgetBytes      = 0;
+    };
+
+} // namespace nvfeedback
@@ -0,0 +1,118 @@
+#include "StreamingBudgetController.h"
+
+#include <cmath>
+
+namespace nvfeedback
+{
+    static constexpr double kStandbyTileSizeInBytes = 64.0 * 1024.0;
+
+    static void Smooth(double& average, double value)
+    {
+        average = (average < 0.0) ? value : std::lerp(average, value, (double)StreamingBudgetController::kSmoothing);
+    }
+
+    void StreamingBudgetController::AdaptiveValue::Track(float target, float minValue, float maxValue, float minStep)
+    {
+        target = std::clamp(target, minValue, maxValue);
+
+        const float error = std::abs(target - m_Value);
+        if (!m_bTracking && error > m_Value * kDeadBand)
+            m_bTracking = true;
+        if (!m_bTracking)
+            return;
+
+        const float maxDelta = std::max(m_Value * kMaxStepFraction, minStep);
+        m_Value += std::clamp(target - m_Value, -maxDelta, maxDelta);
+
+        if (std::abs(target - m_Value) <= m_Value * kSettleBand)
+            m_bTracking = false;
+    }
+
+    StreamingBudgetController::StreamingBudgetController(const StreamingBudgets& initial)
+        : m_Budgets(initial)
+    {
+        m_TilesPerFrame.m_Value     = (float)initial.m_MaxTilesPerFrame;
+        m_TexturesPerFrame.m_Value  = (float)initial.m_FeedbackTexturesToResolvePerFrame;
+        m_StandbyTiles.m_Value      = (float)initial.m_NumExtraStandbyTiles;
+        m_HysteresisSeconds.m_Value = initial.m_TileHysteresisSeconds;
+    }
+
+    double StreamingBudgetController::GetIOCapacityTilesPerSecond() const
+    {
+        return m_BusySecondsPerTile > 0.0 ? (double)m_NumWorkers / m_BusySecondsPerTile : 0.0;
+    }
+
+    const StreamingBudgets& StreamingBudgetController::Update(const StreamingFrameSample& sample)
+    {
+        if (sample.m_FrameSeconds <= 0.0)
+            return m_Budgets;
+
+        // ── Measurements ──
+        Smooth(m_FrameSeconds, sample.m_FrameSeconds);
+        Smooth(m_HeadroomBytes, (double)sample.m_VRAMHeadroomBytes);
+        m_NumWorkers = std::max(sample.m_NumWorkers, 1u);
+
+        if (sample.m_TilesCompleted > 0)
+        {
+            Smooth(m_BusySecondsPerTile, sample.m_WorkerBusySeconds / sample.m_TilesCompleted);
+            Smooth(m_LatencySeconds, sample.m_LatencySeconds / sample.m_TilesCompleted);
+        }
+        if (sample.m_TilesUploaded > 0)
+            Smooth(m_UploadSecondsPerTile, sample.m_UploadSeconds / sample.m_TilesUploaded);
+        if (sample.m_TexturesResolved > 0)
+            Smooth(m_ResolveSecondsPerTexture, sample.m_ResolveSeconds / sample.m_TexturesResolved);
+
+        // ── Tiles per frame ──
+        {
+            float target = m_TilesPerFrame.m_Value;
+            if (m_BusySecondsPerTile > 0.0)
+                target = (float)(GetIOCapacityTilesPerSecond() * m_FrameSeconds * kIOUtilization);
+            if (m_UploadSecondsPerTile > 0.0)
+                target = std::min(target, (float)(kUploadFrameFraction * m_FrameSeconds / m_UploadSecondsPerTile));
+            // The I/O queue is backing up: drain it before trusting the capacity estimate again
+            if (m_LatencySeconds > kMaxLatencyFrames * m_FrameSeconds)
+            {
+                target = std::min(target, m_TilesPerFrame.m_Value * kLatencyBackoff);
+                m_TilesPerFrame.m_bTracking = true;
+            }
+
+            m_TilesPerFrame.Track(target, (float)kMinTilesPerFrame, (float)kMaxTilesPerFrame, 1.0f);
+        }
+
+        // ── Feedback textures resolved per frame ──
+        if (m_ResolveSecondsPerTexture > 0.0)
+        {
+            const float target = (float)(kResolveFrameFraction * m_FrameSeconds / m_ResolveSecondsPerTexture);
+            m_TexturesPerFrame.Track(target, (float)kMinTexturesPerFrame, (float)kMaxTexturesPerFrame, 1.0f);
+        }
+
+        // ── Standby tiles ──
+        if (sample.m_bVRAMPressure)
+        {
+            m_StandbyTiles = {};
+        }
+        else
+        {
+            const float target = (float)(m_HeadroomBytes * kStandbyHeadroomFraction / kStandbyTileSizeInBytes);
+            m_StandbyTiles.Track(target, 0.0f, (float)kMaxStandbyTiles, 1.0f);
+        }
+
+        // ── Hysteresis ──
+        {
+            const uint32_t texturesPerFrame = std::max((uint32_t)std::lround(m_TexturesPerFrame.m_Value), 1u);
+            const uint32_t cycleFrames      = DivideAndRoundUp(std::max(sample.m_NumTextures, 1u), texturesPerFrame);
+            const float    minSeconds       = std::max(kMinHysteresisSeconds, kMinFeedbackCycles * cycleFrames * (float)m_FrameSeconds);
+
+            const float headroom = sample.m_bVRAMPressure ? 0.0f : (float)std::min(m_HeadroomBytes / (double)kFullHysteresisHeadroomBytes, 1.0);
+            const float target   = std::lerp(minSeconds, std::max(minSeconds, kMaxHysteresisSeconds), headroom);
+            m_HysteresisSeconds.Track(target, minSeconds, std::max(minSeconds, kMaxHysteresisSeconds), 0.05f);
+        }
+
+        m_Budgets.m_MaxTilesPerFrame                  = (uint32_t)std::lround(m_TilesPerFrame.m_Value);
+        m_Budgets.m_FeedbackTexturesToResolvePerFrame = (uint32_t)std::lround(m_TexturesPerFrame.m_Value);
+        m_Budgets.m_NumExtraStandbyTiles              = (uint32_t)std::lround(m_StandbyTiles.m_Value);
+        m_Budgets.m_TileHysteresisSeconds             = m_HysteresisSeconds.m_Value;
+        return m_Budgets;
+    }
+
+} // namespace nvfeedback
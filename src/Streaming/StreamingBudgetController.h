@@ -0,0 +1,147 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace nvfeedback
+{
+    // ─── StreamingBudgets ────────────────────────────────────────────────────
+    // Per-frame streaming limits, read by FeedbackManager and the renderer's tile
+    // submit every frame.  StreamingBudgetController rewrites them from
+    // measurements; with --fixed-streaming-budgets they keep these defaults.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    struct StreamingBudgets
+    {
+        // Tiles popped from the TileScheduler and submitted to AsyncTileIO per frame.
+        // The default matches the RTXTS reference's tilesPerFrame.  Excess tiles stay
+        // queued, so a large request burst (e.g. 1623 tiles = 104 MB) never reaches
+        // the workers in one frame.
+        uint32_t m_MaxTilesPerFrame = 128;
+        // Feedback textures cleared, resolved and read back per frame (ringbuffer step).
+        uint32_t m_FeedbackTexturesToResolvePerFrame = 30;
+        // Standby tiles TTM keeps before TrimStandbyTiles() frees the oldest.  Re-requested
+        // standby tiles skip the allocate+load+map cycle.  Forced to 0 in low-memory mode.
+        uint32_t m_NumExtraStandbyTiles = 64;
+        // A tile stays mapped this long after feedback last requested it, then goes
+        // Mapped→Standby.  Must span several feedback ringbuffer cycles: with 307
+        // textures at 30/frame a texture is read back every ~10 frames (~167 ms at
+        // 60 fps), so 1 second leaves ~6 cycles of margin.
+        float    m_TileHysteresisSeconds = 1.0f;
+    };
+
+    // One frame's streaming measurements.  Worker figures are deltas since the
+    // previous sample (see AsyncTileIO::IOStats).
+    struct StreamingFrameSample
+    {
+        double   m_FrameSeconds      = 0.0;
+        // Main thread: recording tile uploads and mappings, submitting tiles
+        double   m_UploadSeconds     = 0.0;
+        uint32_t m_TilesUploaded     = 0;
+        // Main thread: recording feedback resolves
+        double   m_ResolveSeconds    = 0.0;
+        uint32_t m_TexturesResolved  = 0;
+        // I/O workers
+        uint32_t m_TilesCompleted    = 0;
+        double   m_WorkerBusySeconds = 0.0;
+        double   m_LatencySeconds    = 0.0; // summed over m_TilesCompleted
+        uint32_t m_NumWorkers        = 1;
+        uint32_t m_NumTextures       = 0;   // streamed textures
+        // VRAMBudgetGovernor
+        uint64_t m_VRAMHeadroomBytes = 0;
+        bool     m_bVRAMPressure     = false;
+    };
+
+    // ─── StreamingBudgetController ───────────────────────────────────────────
+    // Adapts StreamingBudgets once per frame to what streaming actually costs:
+    //   tiles / frame:    min(I/O capacity, main-thread upload budget), where
+    //                     capacity = workers / worker seconds per tile * frame
+    //                     time * kIOUtilization, and the upload budget is
+    //                     kUploadFrameFraction of the frame over the main-thread
+    //                     cost per uploaded tile.  While the mean submit-to-
+    //                     completion latency is above kMaxLatencyFrames frames
+    //                     the budget backs off by kLatencyBackoff per frame,
+    //                     ignoring the dead band, until the queue has drained.
+    //   resolves / frame: kResolveFrameFraction of the frame over the cost per
+    //                     resolved feedback texture.
+    //   standby tiles:    kStandbyHeadroomFraction of the VRAM headroom, 0 under
+    //                     pressure.
+    //   hysteresis:       kMinFeedbackCycles feedback ringbuffer cycles, raised
+    //                     towards kMaxHysteresisSeconds as headroom grows.
+    //
+    // Stability: measurements are exponentially smoothed, a budget only starts
+    // moving once its target leaves a kDeadBand band around it, then moves at most
+    // kMaxStepFraction per frame until it is within kSettleBand of the target.
+    // Targets come from per-unit costs rather than queue lengths, so raising a
+    // budget does not change its own target: a step change in I/O bandwidth moves
+    // the tile budget monotonically to its new level.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    class StreamingBudgetController
+    {
+    public:
+        static constexpr float    kSmoothing               = 0.1f;  // weight of the newest measurement
+        static constexpr float    kDeadBand                = 0.15f;
+        static constexpr float    kSettleBand              = 0.02f;
+        static constexpr float    kMaxStepFraction         = 0.25f;
+
+        static constexpr float    kIOUtilization           = 0.75f;
+        static constexpr float    kUploadFrameFraction     = 0.10f;
+        static constexpr float    kResolveFrameFraction    = 0.05f;
+        static constexpr float    kMaxLatencyFrames        = 3.0f;
+        static constexpr float    kLatencyBackoff          = 0.75f;
+        static constexpr uint32_t kMinTilesPerFrame        = 4;
+        // The staging ring is sized for the default budget; tiles beyond it take the
+        // slower writeTexture path, so the budget is not allowed to grow without bound.
+        static constexpr uint32_t kMaxTilesPerFrame        = 512;
+        static constexpr uint32_t kMinTexturesPerFrame     = 8;
+        static constexpr uint32_t kMaxTexturesPerFrame     = 128;
+
+        static constexpr float    kStandbyHeadroomFraction = 0.25f;
+        static constexpr uint32_t kMaxStandbyTiles         = 1024;
+        static constexpr float    kMinFeedbackCycles       = 4.0f;
+        static constexpr float    kMinHysteresisSeconds    = 0.5f;
+        static constexpr float    kMaxHysteresisSeconds    = 4.0f;
+        // VRAM headroom at which the hysteresis reaches kMaxHysteresisSeconds
+        static constexpr uint64_t kFullHysteresisHeadroomBytes = 1024ull * 1024 * 1024;
+
+        explicit StreamingBudgetController(const StreamingBudgets& initial = {});
+
+        const StreamingBudgets& Update(const StreamingFrameSample& sample);
+        const StreamingBudgets& GetBudgets() const { return m_Budgets; }
+
+        // Smoothed estimates (0 until measured)
+        double GetIOCapacityTilesPerSecond() const;
+        double GetMeanLatencySeconds() const { return std::max(m_LatencySeconds, 0.0); }
+
+    private:
+        // A budget that follows its target with a dead band and a rate limit
+        struct AdaptiveValue
+        {
+            float m_Value     = 0.0f;
+            bool  m_bTracking = false;
+
+            // minStep: smallest move per frame, so values near 0 still get anywhere
+            void Track(float target, float minValue, float maxValue, float minStep);
+        };
+
+        StreamingBudgets m_Budgets;
+
+        AdaptiveValue m_TilesPerFrame;
+        AdaptiveValue m_TexturesPerFrame;
+        AdaptiveValue m_StandbyTiles;
+        AdaptiveValue m_HysteresisSeconds;
+
+        // Exponential moving averages, negative until the first measurement
+        double   m_FrameSeconds             = -1.0;
+        double   m_BusySecondsPerTile       = -1.0;
+        double   m_UploadSecondsPerTile     = -1.0;
+        double   m_ResolveSecondsPerTexture = -1.0;
+        double   m_LatencySeconds           = -1.0;
+        double   m_HeadroomBytes            = -1.0;
+        uint32_t m_NumWorkers               = 1;
+    };
+
+} // namespace nvfeedback
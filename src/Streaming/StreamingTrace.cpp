@@ -0,0 +1,899 @@
+#include "StreamingTrace.h"
+#include "../Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <unordered_set>
+
+namespace nvfeedback
+{
+    // Buffered records are written out once they pass this size
+    static constexpr size_t   kTraceBufferBytes = 1024 * 1024;
+    // Standard tiles are always 64 KB
+    static constexpr uint64_t kTraceTileSizeInBytes = 64 * 1024;
+    // Sanity limits for decoded counts (a corrupt varint must not allocate gigabytes)
+    static constexpr uint32_t kMaxTraceRegions = 1u << 24;
+    static constexpr uint32_t kMaxTraceTiles   = 1u << 24;
+
+    // ─── StreamingTraceWriter ────────────────────────────────────────────────
+
+    bool StreamingTraceWriter::Open(const std::filesystem::path& filePath, uint32_t heapSizeInTiles)
+    {
+        Close();
+
+        m_File.open(filePath, std::ios::binary | std::ios::trunc);
+        if (!m_File.is_open())
+        {
+            LOG_ERROR("[StreamingTrace] Failed to create '%s'", filePath.string().c_str());
+            return false;
+        }
+
+        StreamingTraceHeader header;
+        header.m_HeapSizeInTiles = heapSizeInTiles;
+        m_File.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        m_Buffer.clear();
+        m_Buffer.reserve(kTraceBufferBytes + 4096);
+        m_BytesWritten = sizeof(header);
+        return true;
+    }
+
+    void StreamingTraceWriter::Close()
+    {
+        if (!m_File.is_open())
+            return;
+
+        WriteRecord(StreamingTraceRecord::End);
+        FlushBuffer(true);
+        m_File.close();
+    }
+
+    void StreamingTraceWriter::WriteRecord(StreamingTraceRecord record)
+    {
+        m_Buffer.push_back((uint8_t)record);
+    }
+
+    void StreamingTraceWriter::WriteVarint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            m_Buffer.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        m_Buffer.push_back((uint8_t)value);
+    }
+
+    void StreamingTraceWriter::WriteFloat(float value)
+    {
+        uint8_t bytes[sizeof(float)];
+        std::memcpy(bytes, &value, sizeof(float));
+        m_Buffer.insert(m_Buffer.end(), std::begin(bytes), std::end(bytes));
+    }
+
+    void StreamingTraceWriter::FlushBuffer(bool bForce)
+    {
+        if (m_Buffer.empty() || (!bForce && m_Buffer.size() < kTraceBufferBytes))
+            return;
+
+        m_File.write(reinterpret_cast<const char*>(m_Buffer.data()), (std::streamsize)m_Buffer.size());
+        m_BytesWritten += m_Buffer.size();
+        m_Buffer.clear();
+    }
+
+    void StreamingTraceWriter::AddTexture(uint32_t textureIdx, const StreamingTraceTexture& texture)
+    {
+        if (!IsOpen())
+            return;
+
+        WriteRecord(StreamingTraceRecord::AddTexture);
+        WriteVarint(textureIdx);
+        WriteVarint(texture.m_Width);
+        WriteVarint(texture.m_Height);
+        WriteVarint(texture.m_NumStandardMips);
+        WriteVarint(texture.m_NumPackedMips);
+        WriteVarint(texture.m_NumPackedTiles);
+        WriteVarint(texture.m_TileWidthInTexels);
+        WriteVarint(texture.m_TileHeightInTexels);
+        FlushBuffer(false);
+    }
+
+    void StreamingTraceWriter::RemoveTexture(uint32_t textureIdx)
+    {
+        if (!IsOpen())
+            return;
+
+        WriteRecord(StreamingTraceRecord::RemoveTexture);
+        WriteVarint(textureIdx);
+    }
+
+    void StreamingTraceWriter::MapPackedMips(uint32_t textureIdx)
+    {
+        if (!IsOpen())
+            return;
+
+        WriteRecord(StreamingTraceRecord::MapPackedMips);
+        WriteVarint(textureIdx);
+    }
+
+    void StreamingTraceWriter::BeginFrame(const StreamingTraceFrame& frame)
+    {
+        if (!IsOpen())
+            return;
+
+        WriteRecord(StreamingTraceRecord::BeginFrame);
+        WriteVarint(frame.m_FrameNumber);
+        WriteFloat(frame.m_TimeStamp);
+        WriteFloat(frame.m_Budgets.m_TileHysteresisSeconds);
+        WriteVarint(frame.m_Budgets.m_NumExtraStandbyTiles);
+        WriteVarint(frame.m_Budgets.m_MaxTilesPerFrame);
+        WriteVarint(frame.m_MaxTTMHeaps);
+        WriteVarint(frame.m_bLowMemoryMode ? 1 : 0);
+        FlushBuffer(false);
+    }
+
+    void StreamingTraceWriter::Feedback(uint32_t textureIdx, std::span<const uint8_t> minMipData)
+    {
+        if (!IsOpen())
+            return;
+
+        WriteRecord(StreamingTraceRecord::Feedback);
+        WriteVarint(textureIdx);
+        WriteVarint(minMipData.size());
+
+        // Most regions are unsampled (0xFF) or share a mip with their neighbours
+        for (size_t i = 0; i < minMipData.size();)
+        {
+            const uint8_t mip = minMipData[i];
+            size_t runEnd = i + 1;
+            while (runEnd < minMipData.size() && minMipData[runEnd] == mip)
+                ++runEnd;
+
+            WriteVarint(runEnd - i);
+            m_Buffer.push_back(mip);
+            i = runEnd;
+        }
+        FlushBuffer(false);
+    }
+
+    void StreamingTraceWriter::Prefetch(uint32_t textureIdx, uint8_t mip)
+    {
+        if (!IsOpen())
+            return;
+
+        WriteRecord(StreamingTraceRecord::Prefetch);
+        WriteVarint(textureIdx);
+        m_Buffer.push_back(mip);
+    }
+
+    void StreamingTraceWriter::TilesMapped(uint32_t textureIdx, std::span<const uint32_t> tileIndices)
+    {
+        if (!IsOpen() || tileIndices.empty())
+            return;
+
+        WriteRecord(StreamingTraceRecord::TilesMapped);
+        WriteVarint(textureIdx);
+        WriteVarint(tileIndices.size());
+        for (uint32_t tileIndex : tileIndices)
+            WriteVarint(tileIndex);
+        FlushBuffer(false);
+    }
+
+    // ─── StreamingTraceReader ────────────────────────────────────────────────
+
+    bool StreamingTraceReader::Open(const std::filesystem::path& filePath)
+    {
+        m_File.open(filePath, std::ios::binary);
+        if (!m_File.is_open())
+        {
+            LOG_ERROR("[StreamingTrace] Failed to open '%s'", filePath.string().c_str());
+            return false;
+        }
+
+        m_File.read(reinterpret_cast<char*>(&m_Header), sizeof(m_Header));
+        if (!m_File || m_Header.m_Magic != kStreamingTraceMagic || m_Header.m_Version != kStreamingTraceVersion)
+        {
+            LOG_ERROR("[StreamingTrace] '%s' is not a version %u streaming trace", filePath.string().c_str(), kStreamingTraceVersion);
+            m_bError = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool StreamingTraceReader::ReadVarint(uint64_t& outValue)
+    {
+        outValue = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7)
+        {
+            const int c = m_File.get();
+            if (c == std::char_traits<char>::eof())
+                return false;
+
+            outValue |= (uint64_t)(c & 0x7F) << shift;
+            if ((c & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool StreamingTraceReader::ReadVarint32(uint32_t& outValue)
+    {
+        uint64_t value;
+        if (!ReadVarint(value) || value > UINT32_MAX)
+            return false;
+        outValue = (uint32_t)value;
+        return true;
+    }
+
+    bool StreamingTraceReader::ReadFloat(float& outValue)
+    {
+        return (bool)m_File.read(reinterpret_cast<char*>(&outValue), sizeof(float));
+    }
+
+    bool StreamingTraceReader::Next(StreamingTraceEvent& outEvent)
+    {
+        if (m_bError || !m_File.is_open())
+            return false;
+
+        const int type = m_File.get();
+        if (type == std::char_traits<char>::eof())
+        {
+            // Not closed by the recorder: everything up to here is still usable
+            LOG_WARN("[StreamingTrace] Trace ends without an End record");
+            return false;
+        }
+
+        outEvent.m_Type = (StreamingTraceRecord)type;
+
+        bool bOk = true;
+        switch (outEvent.m_Type)
+        {
+        case StreamingTraceRecord::End:
+            return false;
+
+        case StreamingTraceRecord::AddTexture:
+        {
+            StreamingTraceTexture& texture = outEvent.m_Texture;
+            bOk = ReadVarint32(outEvent.m_TextureIdx) &&
+                  ReadVarint32(texture.m_Width) && ReadVarint32(texture.m_Height) &&
+                  ReadVarint32(texture.m_NumStandardMips) && ReadVarint32(texture.m_NumPackedMips) &&
+                  ReadVarint32(texture.m_NumPackedTiles) &&
+                  ReadVarint32(texture.m_TileWidthInTexels) && ReadVarint32(texture.m_TileHeightInTexels);
+            break;
+        }
+
+        case StreamingTraceRecord::RemoveTexture:
+        case StreamingTraceRecord::MapPackedMips:
+            bOk = ReadVarint32(outEvent.m_TextureIdx);
+            break;
+
+        case StreamingTraceRecord::BeginFrame:
+        {
+            StreamingTraceFrame& frame = outEvent.m_Frame;
+            uint32_t bLowMemoryMode = 0;
+            bOk = ReadVarint32(frame.m_FrameNumber) && ReadFloat(frame.m_TimeStamp) &&
+                  ReadFloat(frame.m_Budgets.m_TileHysteresisSeconds) &&
+                  ReadVarint32(frame.m_Budgets.m_NumExtraStandbyTiles) &&
+                  ReadVarint32(frame.m_Budgets.m_MaxTilesPerFrame) &&
+                  ReadVarint32(frame.m_MaxTTMHeaps) && ReadVarint32(bLowMemoryMode);
+            frame.m_bLowMemoryMode = (bLowMemoryMode != 0);
+            break;
+        }
+
+        case StreamingTraceRecord::Feedback:
+        {
+            uint32_t numRegions = 0;
+            bOk = ReadVarint32(outEvent.m_TextureIdx) && ReadVarint32(numRegions) && numRegions <= kMaxTraceRegions;
+
+            outEvent.m_MinMipData.clear();
+            while (bOk && outEvent.m_MinMipData.size() < numRegions)
+            {
+                uint32_t runLength = 0;
+                const bool bRun = ReadVarint32(runLength) && runLength > 0 && runLength <= numRegions - outEvent.m_MinMipData.size();
+                const int  mip  = bRun ? m_File.get() : std::char_traits<char>::eof();
+                bOk = bRun && mip != std::char_traits<char>::eof();
+                if (bOk)
+                    outEvent.m_MinMipData.insert(outEvent.m_MinMipData.end(), runLength, (uint8_t)mip);
+            }
+            break;
+        }
+
+        case StreamingTraceRecord::Prefetch:
+        {
+            bOk = ReadVarint32(outEvent.m_TextureIdx);
+            const int mip = bOk ? m_File.get() : std::char_traits<char>::eof();
+            bOk = bOk && mip != std::char_traits<char>::eof();
+            outEvent.m_Mip = (uint8_t)mip;
+            break;
+        }
+
+        case StreamingTraceRecord::TilesMapped:
+        {
+            uint32_t numTiles = 0;
+            bOk = ReadVarint32(outEvent.m_TextureIdx) && ReadVarint32(numTiles) && numTiles <= kMaxTraceTiles;
+            outEvent.m_TileIndices.resize(bOk ? numTiles : 0);
+            for (uint32_t i = 0; bOk && i < numTiles; ++i)
+                bOk = ReadVarint32(outEvent.m_TileIndices[i]);
+            break;
+        }
+
+        default:
+            bOk = false;
+            break;
+        }
+
+        if (!bOk)
+        {
+            LOG_ERROR("[StreamingTrace] Malformed record (type %d) at offset %lld", type, (long long)m_File.tellg());
+            m_bError = true;
+        }
+        return bOk;
+    }
+
+    // ─── StreamingTraceSimulator ─────────────────────────────────────────────
+
+    class StreamingTraceSimulator
+    {
+    public:
+        StreamingTraceSimulator(const StreamingSimConfig& config, uint32_t heapSizeInTiles, StreamingSimStats& stats)
+            : m_Config(config)
+            , m_HeapSizeInTiles(std::max(heapSizeInTiles, 1u))
+            , m_Stats(stats)
+            , m_DefragPlanner(m_HeapSizeInTiles)
+            , m_TileCache(config.m_TileCacheBytes)
+        {
+            rtxts::TiledTextureManagerDesc tiledTextureManagerDesc{};
+            tiledTextureManagerDesc.heapTilesCapacity = m_HeapSizeInTiles;
+            m_TiledTextureManager = std::unique_ptr<rtxts::TiledTextureManager>(
+                rtxts::CreateTiledTextureManager(tiledTextureManagerDesc));
+        }
+
+        bool Process(const StreamingTraceEvent& event);
+        void Finish() { FinishFrame(); }
+
+    private:
+        struct Texture
+        {
+            uint32_t m_TiledTextureId   = 0;
+            uint32_t m_NumStandardTiles = 0; // tile indices from here on are packed
+            uint32_t m_NumPackedMips    = 0;
+            uint32_t m_NumPackedTiles   = 0;
+            TileFeedbackState    m_Feedback; // spans set by GetFeedbackState
+            std::vector<uint8_t> m_Requested;
+            std::vector<uint8_t> m_Resident;
+            std::vector<uint32_t> m_TileHeapIds; // as FeedbackTexture::TileSlot, UINT32_MAX = no slot
+            std::vector<uint8_t>  m_TileMapped;
+            bool m_bResidentDirty = true;
+
+            TileFeedbackState GetFeedbackState() const
+            {
+                TileFeedbackState state = m_Feedback;
+                state.m_Requested = m_Requested;
+                state.m_Resident  = m_Resident;
+                return state;
+            }
+        };
+
+        struct InFlightTile
+        {
+            uint32_t m_TextureIdx;
+            uint32_t m_TileIndex;
+            uint32_t m_ReadyFrame;
+        };
+
+        static uint64_t MakeKey(uint32_t textureIdx, uint32_t tileIndex) { return ((uint64_t)textureIdx << 32) | tileIndex; }
+
+        Texture* GetTexture(uint32_t textureIdx) { return textureIdx < m_Textures.size() ? &m_Textures[textureIdx] : nullptr; }
+
+        void AddTexture(const StreamingTraceTexture& desc); // appended: Process checks the trace's index
+        void RemoveTexture(uint32_t textureIdx);
+        void MapPackedMips(uint32_t textureIdx);
+        void BeginFrame(const StreamingTraceFrame& frame);
+        void ApplyFeedback(uint32_t textureIdx, const std::vector<uint8_t>& minMipData);
+        void ApplyPrefetch(uint32_t textureIdx, uint8_t mip);
+        void UpdateTTM(const Texture& texture, const uint8_t* minMipData);
+        void FinishFrame();
+
+        void AddHeap(bool bPinned);
+        void MoveDefragmentedTiles(uint32_t textureIdx, std::vector<uint32_t>& tilesToMap);
+        void CompleteIO();
+        void RefreshResident(Texture& texture);
+
+        const StreamingSimConfig m_Config;
+        const uint32_t           m_HeapSizeInTiles;
+        StreamingSimStats&       m_Stats;
+
+        std::unique_ptr<rtxts::TiledTextureManager> m_TiledTextureManager;
+        std::vector<Texture>  m_Textures;
+        TileScheduler         m_TileScheduler;
+        DirtyTextureList      m_DirtyTextures;
+        TileDefragPlanner     m_DefragPlanner;
+
+        std::vector<InFlightTile>    m_InFlight;
+        std::unordered_set<uint64_t> m_InFlightKeys;   // cleared when TTM unmaps the tile
+        double                       m_IOBusyUntilFrame = 0.0;
+        TileCachePolicy              m_TileCache;      // capacity 0 when disabled
+        std::vector<uint32_t>        m_EvictedSlots;
+
+        StreamingTraceFrame m_Frame;
+        StreamingBudgets    m_Budgets;
+        bool                m_bFrameOpen = false;
+
+        uint32_t              m_NextHeapId = 0;
+        std::vector<uint32_t> m_FreeHeapIds;
+        uint32_t              m_NumTTMHeaps = 0;
+
+        std::vector<uint8_t>  m_UniformFeedback;
+        std::vector<uint32_t> m_TileList;
+        std::vector<uint32_t> m_MovedTileList;
+    };
+
+    bool StreamingTraceSimulator::Process(const StreamingTraceEvent& event)
+    {
+        // Texture and mapping records happen between BeginFrames; feedback belongs to the open one
+        if (event.m_Type != StreamingTraceRecord::Feedback && event.m_Type != StreamingTraceRecord::Prefetch)
+            FinishFrame();
+
+        switch (event.m_Type)
+        {
+        case StreamingTraceRecord::AddTexture:
+            if (event.m_TextureIdx != m_Textures.size())
+            {
+                LOG_ERROR("[StreamingSim] AddTexture index %u out of order (expected %zu)", event.m_TextureIdx, m_Textures.size());
+                return false;
+            }
+            AddTexture(event.m_Texture);
+            break;
+        case StreamingTraceRecord::RemoveTexture:
+            RemoveTexture(event.m_TextureIdx);
+            break;
+        case StreamingTraceRecord::MapPackedMips:
+            MapPackedMips(event.m_TextureIdx);
+            break;
+        case StreamingTraceRecord::BeginFrame:
+            BeginFrame(event.m_Frame);
+            break;
+        case StreamingTraceRecord::Feedback:
+            ApplyFeedback(event.m_TextureIdx, event.m_MinMipData);
+            break;
+        case StreamingTraceRecord::Prefetch:
+            ApplyPrefetch(event.m_TextureIdx, event.m_Mip);
+            break;
+        case StreamingTraceRecord::TilesMapped:
+            m_Stats.m_RecordedTilesMapped += event.m_TileIndices.size();
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    void StreamingTraceSimulator::AddTexture(const StreamingTraceTexture& desc)
+    {
+        Texture& texture = m_Textures.emplace_back();
+        m_DirtyTextures.AddTexture();
+        texture.m_NumPackedMips  = desc.m_NumPackedMips;
+        texture.m_NumPackedTiles = desc.m_NumPackedTiles;
+
+        rtxts::TiledLevelDesc tiledLevelDescs[16]{};
+        rtxts::TiledTextureDesc tiledTextureDesc{};
+        tiledTextureDesc.textureWidth        = desc.m_Width;
+        tiledTextureDesc.textureHeight       = desc.m_Height;
+        tiledTextureDesc.tiledLevelDescs     = tiledLevelDescs;
+        tiledTextureDesc.regularMipLevelsNum = std::min(desc.m_NumStandardMips, 16u);
+        tiledTextureDesc.packedMipLevelsNum  = desc.m_NumPackedMips;
+        tiledTextureDesc.packedTilesNum      = desc.m_NumPackedTiles;
+        tiledTextureDesc.tileWidth           = std::max(desc.m_TileWidthInTexels, 1u);
+        tiledTextureDesc.tileHeight          = std::max(desc.m_TileHeightInTexels, 1u);
+
+        for (uint32_t mip = 0; mip < tiledTextureDesc.regularMipLevelsNum; ++mip)
+        {
+            tiledLevelDescs[mip].widthInTiles  = DivideAndRoundUp(std::max(1u, desc.m_Width  >> mip), tiledTextureDesc.tileWidth);
+            tiledLevelDescs[mip].heightInTiles = DivideAndRoundUp(std::max(1u, desc.m_Height >> mip), tiledTextureDesc.tileHeight);
+            texture.m_NumStandardTiles += tiledLevelDescs[mip].widthInTiles * tiledLevelDescs[mip].heightInTiles;
+        }
+
+        m_TiledTextureManager->AddTiledTexture(tiledTextureDesc, texture.m_TiledTextureId);
+        const size_t numTiles = m_TiledTextureManager->GetTileAllocations(texture.m_TiledTextureId).size();
+        texture.m_TileHeapIds.assign(numTiles, UINT32_MAX);
+        texture.m_TileMapped.assign(numTiles, 0);
+
+        // Same region grid as FeedbackTexture
+        const rtxts::TextureDesc feedbackDesc = m_TiledTextureManager->GetTextureDesc(texture.m_TiledTextureId, rtxts::eFeedbackTexture);
+        TileFeedbackState& feedback = texture.m_Feedback;
+        feedback.m_RegionWidth        = std::max(feedbackDesc.textureOrMipRegionWidth, 1u);
+        feedback.m_RegionHeight       = std::max(feedbackDesc.textureOrMipRegionHeight, 1u);
+        feedback.m_RegionsX           = (desc.m_Width  - 1) / feedback.m_RegionWidth  + 1;
+        feedback.m_RegionsY           = (desc.m_Height - 1) / feedback.m_RegionHeight + 1;
+        feedback.m_TileWidthInTexels  = tiledTextureDesc.tileWidth;
+        feedback.m_TileHeightInTexels = tiledTextureDesc.tileHeight;
+        feedback.m_NumStandardMips    = tiledTextureDesc.regularMipLevelsNum;
+    }
+
+    void StreamingTraceSimulator::RemoveTexture(uint32_t textureIdx)
+    {
+        if (!GetTexture(textureIdx))
+            return;
+
+        // As FeedbackManager::UnregisterTexture: the TTM texture stays registered
+        m_TileScheduler.RemoveTexture(textureIdx);
+        m_DirtyTextures.RemoveTexture(textureIdx);
+        std::erase_if(m_InFlight, [textureIdx](const InFlightTile& tile) { return tile.m_TextureIdx == textureIdx; });
+        m_Textures.erase(m_Textures.begin() + textureIdx);
+
+        // Keys of later textures shifted along with their indices
+        m_InFlightKeys.clear();
+        for (InFlightTile& tile : m_InFlight)
+        {
+            if (tile.m_TextureIdx > textureIdx)
+                --tile.m_TextureIdx;
+            m_InFlightKeys.insert(MakeKey(tile.m_TextureIdx, tile.m_TileIndex));
+        }
+    }
+
+    void StreamingTraceSimulator::AddHeap(bool bPinned)
+    {
+        uint32_t heapId;
+        if (m_FreeHeapIds.empty())
+        {
+            heapId = m_NextHeapId++;
+        }
+        else
+        {
+            heapId = m_FreeHeapIds.back();
+            m_FreeHeapIds.pop_back();
+        }
+
+        m_TiledTextureManager->AddHeap(heapId);
+        m_DefragPlanner.AddHeap(heapId, bPinned);
+        m_NumTTMHeaps++;
+        m_Stats.m_HeapsAdded++;
+        m_Stats.m_PeakHeaps = std::max(m_Stats.m_PeakHeaps, m_NumTTMHeaps);
+    }
+
+    void StreamingTraceSimulator::MapPackedMips(uint32_t textureIdx)
+    {
+        Texture* texture = GetTexture(textureIdx);
+        if (!texture)
+            return;
+
+        if (texture->m_NumPackedMips == 0)
+            return;
+
+        // Same steps as FeedbackManager::MapPackedMips, without the GPU mapping
+        const rtxts::Statistics stats = m_TiledTextureManager->GetStatistics();
+        if (stats.heapFreeTilesNum < texture->m_NumPackedTiles)
+        {
+            const uint32_t heapsNeeded = DivideAndRoundUp(texture->m_NumPackedTiles - stats.heapFreeTilesNum, m_HeapSizeInTiles);
+            for (uint32_t i = 0; i < heapsNeeded; ++i)
+                AddHeap(true);
+        }
+
+        m_TiledTextureManager->AllocateRequestedTiles();
+        m_TiledTextureManager->GetTilesToMap(texture->m_TiledTextureId, m_TileList);
+        std::erase_if(m_TileList, [texture](uint32_t tileIndex) { return tileIndex < texture->m_NumStandardTiles; });
+        if (!m_TileList.empty())
+            m_TiledTextureManager->UpdateTilesMapping(texture->m_TiledTextureId, m_TileList);
+
+        const std::vector<rtxts::TileAllocation>& allocations = m_TiledTextureManager->GetTileAllocations(texture->m_TiledTextureId);
+        for (uint32_t tileIndex : m_TileList)
+        {
+            texture->m_TileHeapIds[tileIndex] = allocations[tileIndex].heapId;
+            texture->m_TileMapped[tileIndex]  = 1;
+            m_DefragPlanner.OnTileAllocated(allocations[tileIndex].heapId);
+        }
+
+        texture->m_bResidentDirty = true;
+    }
+
+    void StreamingTraceSimulator::BeginFrame(const StreamingTraceFrame& frame)
+    {
+        m_Frame   = frame;
+        m_Budgets = m_Config.m_bRecordedBudgets ? frame.m_Budgets : m_Config.m_Budgets;
+        m_Stats.m_NumFrames++;
+
+        // Phase 1+2: data that arrived is mapped and shows up in the MinMip textures
+        CompleteIO();
+
+        rtxts::TiledTextureManagerConfig ttmConfig{};
+        ttmConfig.numExtraStandbyTiles = m_Frame.m_bLowMemoryMode ? 0 : m_Budgets.m_NumExtraStandbyTiles;
+        m_TiledTextureManager->SetConfig(ttmConfig);
+
+        m_bFrameOpen = true;
+    }
+
+    void StreamingTraceSimulator::RefreshResident(Texture& texture)
+    {
+        if (!texture.m_bResidentDirty)
+            return;
+
+        const rtxts::TextureDesc desc = m_TiledTextureManager->GetTextureDesc(texture.m_TiledTextureId, rtxts::TextureTypes::eMinMipTexture);
+        texture.m_Resident.resize((size_t)desc.textureOrMipRegionWidth * desc.textureOrMipRegionHeight);
+        m_TiledTextureManager->WriteMinMipData(texture.m_TiledTextureId, texture.m_Resident.data());
+        texture.m_bResidentDirty = false;
+    }
+
+    void StreamingTraceSimulator::CompleteIO()
+    {
+        // Tiles whose data arrived, grouped per texture like FeedbackTextureUpdate
+        std::map<uint32_t, std::vector<uint32_t>> arrived;
+        std::erase_if(m_InFlight, [&](const InFlightTile& tile)
+        {
+            if (tile.m_ReadyFrame > m_Frame.m_FrameNumber)
+                return false;
+            if (m_InFlightKeys.erase(MakeKey(tile.m_TextureIdx, tile.m_TileIndex)) > 0)
+                arrived[tile.m_TextureIdx].push_back(tile.m_TileIndex);
+            return true;
+        });
+
+        for (auto& [textureIdx, tileIndices] : arrived)
+        {
+            Texture& texture = m_Textures[textureIdx];
+            m_TiledTextureManager->UpdateTilesMapping(texture.m_TiledTextureId, tileIndices);
+            for (uint32_t tileIndex : tileIndices)
+                texture.m_TileMapped[tileIndex] = texture.m_TileHeapIds[tileIndex] != UINT32_MAX;
+            texture.m_bResidentDirty = true;
+            m_Stats.m_TilesLoaded += tileIndices.size();
+        }
+
+        for (uint32_t textureIdx = 0; textureIdx < (uint32_t)m_Textures.size(); ++textureIdx)
+        {
+            if (m_Textures[textureIdx].m_bResidentDirty)
+                m_TileScheduler.MarkTextureChanged(textureIdx);
+            RefreshResident(m_Textures[textureIdx]);
+        }
+    }
+
+    void StreamingTraceSimulator::UpdateTTM(const Texture& texture, const uint8_t* minMipData)
+    {
+        rtxts::SamplerFeedbackDesc samplerFeedbackDesc{};
+        samplerFeedbackDesc.pMinMipData = minMipData;
+        m_TiledTextureManager->UpdateWithSamplerFeedback(
+            texture.m_TiledTextureId,
+            samplerFeedbackDesc,
+            m_Frame.m_TimeStamp,
+            m_Budgets.m_TileHysteresisSeconds);
+    }
+
+    void StreamingTraceSimulator::ApplyFeedback(uint32_t textureIdx, const std::vector<uint8_t>& minMipData)
+    {
+        Texture* texture = GetTexture(textureIdx);
+        if (!texture || !m_bFrameOpen)
+            return;
+
+        const size_t numRegions = (size_t)texture->m_Feedback.m_RegionsX * texture->m_Feedback.m_RegionsY;
+        if (minMipData.size() != numRegions)
+        {
+            LOG_ERROR("[StreamingSim] Feedback for texture %u has %zu regions, expected %zu", textureIdx, minMipData.size(), numRegions);
+            return;
+        }
+
+        // Residency hit rate: what this feedback asked for against what was resident
+        if (texture->m_Resident.size() == numRegions)
+        {
+            for (size_t region = 0; region < numRegions; ++region)
+            {
+                const uint8_t requested = minMipData[region];
+                if (requested >= texture->m_Feedback.m_NumStandardMips)
+                    continue;
+
+                m_Stats.m_RegionsSampled++;
+                if (texture->m_Resident[region] <= requested)
+                    m_Stats.m_RegionsResident++;
+            }
+        }
+
+        texture->m_Requested = minMipData;
+        texture->m_Feedback.m_RequestedFrame = m_Frame.m_FrameNumber;
+        UpdateTTM(*texture, texture->m_Requested.data());
+        m_DirtyTextures.MarkDirty(textureIdx);
+        m_TileScheduler.MarkTextureChanged(textureIdx);
+    }
+
+    void StreamingTraceSimulator::ApplyPrefetch(uint32_t textureIdx, uint8_t mip)
+    {
+        Texture* texture = GetTexture(textureIdx);
+        if (!texture || !m_bFrameOpen)
+            return;
+
+        // Uniform feedback, as FeedbackManager::ApplyPrefetchRequests builds it
+        m_UniformFeedback.assign((size_t)texture->m_Feedback.m_RegionsX * texture->m_Feedback.m_RegionsY, mip);
+        texture->m_Feedback.m_PrefetchMip   = mip;
+        texture->m_Feedback.m_PrefetchFrame = m_Frame.m_FrameNumber;
+        m_TileScheduler.MarkTextureChanged(textureIdx);
+        UpdateTTM(*texture, m_UniformFeedback.data());
+        m_DirtyTextures.MarkDirty(textureIdx);
+    }
+
+    // As FeedbackManager::MoveDefragmentedTiles: a moved tile with its data mapped
+    // costs a GPU copy, one still in flight lands in its new slot.  Neither is loaded again.
+    void StreamingTraceSimulator::MoveDefragmentedTiles(uint32_t textureIdx, std::vector<uint32_t>& tilesToMap)
+    {
+        Texture& texture = m_Textures[textureIdx];
+        const std::vector<rtxts::TileAllocation>& allocations = m_TiledTextureManager->GetTileAllocations(texture.m_TiledTextureId);
+
+        m_MovedTileList.clear();
+        std::erase_if(tilesToMap, [&](uint32_t tileIndex)
+        {
+            const uint32_t heapId = allocations[tileIndex].heapId;
+            m_DefragPlanner.OnTileAllocated(heapId);
+
+            uint32_t& slotHeapId = texture.m_TileHeapIds[tileIndex];
+            if (slotHeapId == UINT32_MAX)
+            {
+                slotHeapId = heapId;
+                return false;
+            }
+
+            m_DefragPlanner.OnTileFreed(slotHeapId);
+            slotHeapId = heapId;
+            if (texture.m_TileMapped[tileIndex])
+                m_MovedTileList.push_back(tileIndex);
+            return true;
+        });
+
+        if (!m_MovedTileList.empty())
+        {
+            m_TiledTextureManager->UpdateTilesMapping(texture.m_TiledTextureId, m_MovedTileList);
+            m_Stats.m_TilesMoved += m_MovedTileList.size();
+        }
+    }
+
+    void StreamingTraceSimulator::FinishFrame()
+    {
+        if (!m_bFrameOpen)
+            return;
+        m_bFrameOpen = false;
+
+        // ── Steps 3-7 of FeedbackManager::BeginFrame ──
+        const uint32_t numExtraStandbyTiles = m_Frame.m_bLowMemoryMode ? 0 : m_Budgets.m_NumExtraStandbyTiles;
+        if (m_TiledTextureManager->GetStatistics().standbyTilesNum > numExtraStandbyTiles)
+            m_DirtyTextures.MarkResidentDirty();
+        m_TiledTextureManager->TrimStandbyTiles();
+
+        const uint32_t maxTTMHeaps      = m_Frame.m_MaxTTMHeaps > 0 ? m_Frame.m_MaxTTMHeaps : UINT32_MAX;
+        const uint32_t numRequiredHeaps = std::min(m_TiledTextureManager->GetNumDesiredHeaps(), maxTTMHeaps);
+        if (numRequiredHeaps > m_NumTTMHeaps)
+        {
+            while (m_NumTTMHeaps < numRequiredHeaps)
+                AddHeap(false);
+        }
+        else if (m_TileScheduler.IsEmpty() || m_Frame.m_bLowMemoryMode)
+        {
+            std::vector<uint32_t> emptyHeaps;
+            m_TiledTextureManager->GetEmptyHeaps(emptyHeaps);
+            for (uint32_t heapId : emptyHeaps)
+            {
+                m_TiledTextureManager->RemoveHeap(heapId);
+                m_DefragPlanner.RemoveHeap(heapId);
+                m_FreeHeapIds.push_back(heapId);
+                m_NumTTMHeaps--;
+                m_Stats.m_HeapsRemoved++;
+            }
+        }
+
+        m_TiledTextureManager->AllocateRequestedTiles();
+
+        const TileDefragPlan plan = m_DefragPlanner.Plan(kMaxDefragMovesPerFrame, m_Frame.m_bLowMemoryMode);
+        if (plan.m_NumTilesToMove > 0)
+        {
+            m_TiledTextureManager->DefragmentTiles(plan.m_NumTilesToMove);
+            m_DirtyTextures.MarkAllDirty();
+        }
+
+        for (uint32_t textureIdx : m_DirtyTextures.GetDirtyTextures())
+        {
+            Texture& texture = m_Textures[textureIdx];
+
+            m_TiledTextureManager->GetTilesToUnmap(texture.m_TiledTextureId, m_TileList);
+            if (!m_TileList.empty())
+            {
+                m_Stats.m_TilesUnmapped += m_TileList.size();
+                texture.m_bResidentDirty = true;
+                m_DirtyTextures.OnTilesUnmapped(textureIdx, (uint32_t)m_TileList.size());
+
+                const uint32_t numPendingBefore = m_TileScheduler.GetNumPending();
+                m_TileScheduler.Cancel(textureIdx, m_TileList);
+                m_Stats.m_TilesCancelled += numPendingBefore - m_TileScheduler.GetNumPending();
+
+                for (uint32_t tileIndex : m_TileList)
+                {
+                    m_Stats.m_TilesCancelled += m_InFlightKeys.erase(MakeKey(textureIdx, tileIndex));
+                    if (texture.m_TileHeapIds[tileIndex] != UINT32_MAX)
+                        m_DefragPlanner.OnTileFreed(texture.m_TileHeapIds[tileIndex]);
+                    texture.m_TileHeapIds[tileIndex] = UINT32_MAX;
+                    texture.m_TileMapped[tileIndex]  = 0;
+                }
+            }
+
+            m_TiledTextureManager->GetTilesToMap(texture.m_TiledTextureId, m_TileList);
+            MoveDefragmentedTiles(textureIdx, m_TileList);
+            if (!m_TileList.empty())
+            {
+                m_Stats.m_TilesRequested += m_TileList.size();
+                m_TileScheduler.Enqueue(textureIdx, m_TileList, m_Frame.m_FrameNumber);
+                m_DirtyTextures.OnTilesAllocated(textureIdx, (uint32_t)m_TileList.size());
+            }
+        }
+        if (m_TiledTextureManager->GetStatistics().heapFreeTilesNum > 0)
+            m_DirtyTextures.Clear();
+
+        // ── Phase 4: submit the budget to the modeled I/O ──
+        std::pmr::vector<ScheduledTile> scheduledTiles;
+        m_TileScheduler.PopBatch(m_Budgets.m_MaxTilesPerFrame, [this](const ScheduledTile& tile)
+        {
+            // Equal priorities pop oldest first
+            if (m_Config.m_bFifoScheduling)
+                return TilePriorityInputs{};
+
+            const Texture& texture = m_Textures[tile.m_TextureIdx];
+            const rtxts::TileCoord& coord = m_TiledTextureManager->GetTileCoordinates(texture.m_TiledTextureId)[tile.m_TileIndex];
+            return ComputeTilePriorityInputs(texture.GetFeedbackState(), coord.mipLevel, coord.x, coord.y, tile.m_RequestFrame, m_Frame.m_FrameNumber);
+        }, scheduledTiles);
+
+        for (const ScheduledTile& tile : scheduledTiles)
+        {
+            const Texture& texture = m_Textures[tile.m_TextureIdx];
+            const rtxts::TileCoord& coord = m_TiledTextureManager->GetTileCoordinates(texture.m_TiledTextureId)[tile.m_TileIndex];
+
+            // TTM texture ids are never reused, unlike trace indices
+            TileCacheKey cacheKey;
+            cacheKey.m_Source    = texture.m_TiledTextureId;
+            cacheKey.m_MipLevel  = coord.mipLevel;
+            cacheKey.m_XInTexels = coord.x * texture.m_Feedback.m_TileWidthInTexels;
+            cacheKey.m_YInTexels = coord.y * texture.m_Feedback.m_TileHeightInTexels;
+
+            if (m_TileCache.Find(cacheKey) != TileCachePolicy::kInvalidSlot)
+            {
+                m_InFlight.push_back({ tile.m_TextureIdx, tile.m_TileIndex, m_Frame.m_FrameNumber + 1 });
+                m_InFlightKeys.insert(MakeKey(tile.m_TextureIdx, tile.m_TileIndex));
+                m_Stats.m_TilesFromCache++;
+                m_Stats.m_BytesFromCache += kTraceTileSizeInBytes;
+                continue;
+            }
+
+            m_EvictedSlots.clear();
+            m_TileCache.Insert(cacheKey, kTraceTileSizeInBytes, m_EvictedSlots);
+
+            uint32_t readyFrame = m_Frame.m_FrameNumber + std::max(m_Config.m_IOLatencyFrames, 1u);
+            if (m_Config.m_IOTilesPerFrame > 0)
+            {
+                // The workers drain a FIFO at m_IOTilesPerFrame
+                const double start = std::max(m_IOBusyUntilFrame, (double)m_Frame.m_FrameNumber);
+                m_IOBusyUntilFrame = start + 1.0 / (double)m_Config.m_IOTilesPerFrame;
+                readyFrame = std::max(readyFrame, (uint32_t)std::ceil(m_IOBusyUntilFrame) + m_Config.m_IOLatencyFrames - 1);
+            }
+
+            m_InFlight.push_back({ tile.m_TextureIdx, tile.m_TileIndex, readyFrame });
+            m_InFlightKeys.insert(MakeKey(tile.m_TextureIdx, tile.m_TileIndex));
+            m_Stats.m_BytesRead += kTraceTileSizeInBytes;
+        }
+    }
+
+    bool SimulateStreamingTrace(const std::filesystem::path& tracePath, const StreamingSimConfig& config, StreamingSimStats& outStats)
+    {
+        outStats = {};
+
+        StreamingTraceReader reader;
+        if (!reader.Open(tracePath))
+            return false;
+
+        const uint32_t heapSizeInTiles = config.m_HeapSizeInTiles > 0 ? config.m_HeapSizeInTiles : reader.GetHeader().m_HeapSizeInTiles;
+        if (heapSizeInTiles != reader.GetHeader().m_HeapSizeInTiles)
+            LOG_WARN("[StreamingSim] Heap size %u tiles differs from the recorded %u", heapSizeInTiles, reader.GetHeader().m_HeapSizeInTiles);
+        StreamingTraceSimulator simulator(config, heapSizeInTiles, outStats);
+
+        StreamingTraceEvent event;
+        while (reader.Next(event))
+        {
+            if (!simulator.Process(event))
+                return false;
+        }
+        simulator.Finish();
+
+        return !reader.HasError();
+    }
+
+} // namespace nvfeedback
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+#include "DirtyTextureList.h"
+#include "StreamingBudgetController.h"
+#include "TileCache.h"
+#include "TileDefragPlanner.h"
+#include "TileScheduler.h"
+
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#include <rtxts-ttm/TiledTextureManager.h>
+
+namespace nvfeedback
+{
+    // ─── Streaming trace (.strace) ───────────────────────────────────────────
+    // Everything FeedbackManager hands to TTM, recorded as it happens, so that
+    // streaming policies can be replayed on the CPU without a device (see
+    // SimulateStreamingTrace).  Recorded with --record-streaming-trace.
+    //
+    // Offset  Size   Field
+    // ------  ----   -----
+    // 0       16     StreamingTraceHeader
+    // 16      var    Records until StreamingTraceRecord::End.  Each record is its
+    //                type byte followed by its fields; integers are LEB128
+    //                varints, floats are raw little-endian.
+    //
+    // Record         Fields
+    // ------         ------
+    // AddTexture     index, width, height, standard mips, packed mips, packed
+    //                tiles, tile width, tile height (texels)
+    // RemoveTexture  index; later indices shift down, as in FeedbackManager
+    // MapPackedMips  index
+    // BeginFrame     frame number, TTM timestamp, hysteresis seconds, standby
+    //                tiles, tiles per frame, heap cap (0 = none), low-memory flag
+    // Feedback       index, region count, (run length, mip) pairs: the resolved
+    //                min-mip feedback, 0xFF = region not sampled
+    // Prefetch       index, mip: uniform feedback from the TilePrefetcher
+    // TilesMapped    index, tile count, tile indices: uploads that completed and
+    //                were mapped (the recorded I/O completions)
+    // ─────────────────────────────────────────────────────────────────────────
+
+    // Magic: "STRC" = 0x43525453
+    constexpr uint32_t kStreamingTraceMagic   = 0x43525453;
+    // Bump when a record's fields change
+    constexpr uint32_t kStreamingTraceVersion = 1;
+
+    enum class StreamingTraceRecord : uint8_t
+    {
+        End,
+        AddTexture,
+        RemoveTexture,
+        MapPackedMips,
+        BeginFrame,
+        Feedback,
+        Prefetch,
+        TilesMapped,
+    };
+
+    struct StreamingTraceHeader
+    {
+        uint32_t m_Magic           = kStreamingTraceMagic;
+        uint32_t m_Version         = kStreamingTraceVersion;
+        uint32_t m_HeapSizeInTiles = 0;
+        uint32_t m_Reserved        = 0;
+    };
+    static_assert(sizeof(StreamingTraceHeader) == 16);
+
+    // What TTM needs to register a texture.  Tiles per standard mip are
+    // DivideAndRoundUp(mip size, tile size), the D3D12 standard tile layout.
+    struct StreamingTraceTexture
+    {
+        uint32_t m_Width              = 0;
+        uint32_t m_Height             = 0;
+        uint32_t m_NumStandardMips    = 0;
+        uint32_t m_NumPackedMips      = 0;
+        uint32_t m_NumPackedTiles     = 0;
+        uint32_t m_TileWidthInTexels  = 0;
+        uint32_t m_TileHeightInTexels = 0;
+    };
+
+    struct StreamingTraceFrame
+    {
+        uint32_t         m_FrameNumber = 0;
+        float            m_TimeStamp   = 0.0f; // seconds, as passed to UpdateWithSamplerFeedback
+        StreamingBudgets m_Budgets;
+        uint32_t         m_MaxTTMHeaps = 0;    // 0 = uncapped
+        bool             m_bLowMemoryMode = false;
+    };
+
+    // One decoded record.  Only the fields of m_Type are valid.
+    struct StreamingTraceEvent
+    {
+        StreamingTraceRecord  m_Type       = StreamingTraceRecord::End;
+        uint32_t              m_TextureIdx = 0;
+        StreamingTraceTexture m_Texture;     // AddTexture
+        StreamingTraceFrame   m_Frame;       // BeginFrame
+        uint8_t               m_Mip = 0xFF;  // Prefetch
+        std::vector<uint8_t>  m_MinMipData;  // Feedback
+        std::vector<uint32_t> m_TileIndices; // TilesMapped
+    };
+
+    class StreamingTraceWriter
+    {
+    public:
+        ~StreamingTraceWriter() { Close(); }
+
+        bool Open(const std::filesystem::path& filePath, uint32_t heapSizeInTiles);
+        // Writes the End record and closes the file.
+        void Close();
+        bool IsOpen() const { return m_File.is_open(); }
+        uint64_t GetBytesWritten() const { return m_BytesWritten + m_Buffer.size(); }
+
+        void AddTexture(uint32_t textureIdx, const StreamingTraceTexture& texture);
+        void RemoveTexture(uint32_t textureIdx);
+        void MapPackedMips(uint32_t textureIdx);
+        void BeginFrame(const StreamingTraceFrame& frame);
+        void Feedback(uint32_t textureIdx, std::span<const uint8_t> minMipData);
+        void Prefetch(uint32_t textureIdx, uint8_t mip);
+        void TilesMapped(uint32_t textureIdx, std::span<const uint32_t> tileIndices);
+
+    private:
+        void WriteRecord(StreamingTraceRecord record);
+        void WriteVarint(uint64_t value);
+        void WriteFloat(float value);
+        void FlushBuffer(bool bForce);
+
+        std::ofstream        m_File;
+        std::vector<uint8_t> m_Buffer;
+        uint64_t             m_BytesWritten = 0;
+    };
+
+    class StreamingTraceReader
+    {
+    public:
+        bool Open(const std::filesystem::path& filePath);
+
+        // Decodes the next record into outEvent.  Returns false at the End record,
+        // at the end of the file (a trace cut short by a crash) or on malformed data.
+        bool Next(StreamingTraceEvent& outEvent);
+
+        bool HasError() const { return m_bError; }
+        const StreamingTraceHeader& GetHeader() const { return m_Header; }
+
+    private:
+        bool ReadVarint(uint64_t& outValue);
+        bool ReadVarint32(uint32_t& outValue);
+        bool ReadFloat(float& outValue);
+
+        std::ifstream        m_File;
+        StreamingTraceHeader m_Header;
+        bool                 m_bError = false;
+    };
+
+    // ─── Streaming trace simulation ──────────────────────────────────────────
+    // Run by the StreamingSim command-line tool and the headless tests.
+    // Replays a trace through a CPU-only TiledTextureManager with FeedbackManager's
+    // BeginFrame steps (standby trim, heap growth and release, allocation, unmap
+    // and map collection over the DirtyTextureList, planned defragmentation)
+    // and the TileScheduler, in place of the GPU and AsyncTileIO:
+    //   - a popped tile's data arrives m_IOLatencyFrames frames later, limited to
+    //     m_IOTilesPerFrame tiles per frame, and is mapped at the start of that
+    //     frame (where the renderer calls UpdateTileMappings),
+    //   - a tile TTM unmaps before its data arrived is cancelled,
+    //   - with m_TileCacheBytes, a tile the TileCachePolicy still holds skips the
+    //     modeled disk and arrives the next frame,
+    //   - residency is TTM's MinMip data after the frame's mappings, the same
+    //     grid the GPU samples.
+    // The trace's feedback and frame timestamps are replayed verbatim, so the
+    // camera does not react to residency: the hit rate compares policies under
+    // identical demand.
+    //
+    // hit rate  = sampled feedback regions whose requested mip was resident when
+    //             the feedback arrived / sampled regions (packed-mip requests,
+    //             always resident, are left out)
+    // churn     = heaps added + removed, tiles unmapped
+    // ─────────────────────────────────────────────────────────────────────────
+
+    struct StreamingSimConfig
+    {
+        uint32_t         m_HeapSizeInTiles  = 0;    // 0 = as recorded
+        // Replay the per-frame budgets the trace recorded, or use m_Budgets every frame
+        bool             m_bRecordedBudgets = true;
+        StreamingBudgets m_Budgets;
+        // Submit to mapped.  The renderer maps tiles the frame after submitting them.
+        uint32_t         m_IOLatencyFrames  = 1;
+        uint32_t         m_IOTilesPerFrame  = 0;    // 0 = unlimited
+        uint64_t         m_TileCacheBytes   = 0;    // host-memory TileCache, 0 = none
+        // Pop tiles in request order instead of by TileScheduler priority (the
+        // baseline the priority scheduler is measured against)
+        bool             m_bFifoScheduling  = false;
+    };
+
+    struct StreamingSimStats
+    {
+        uint32_t m_NumFrames           = 0;
+        uint64_t m_RegionsSampled      = 0;
+        uint64_t m_RegionsResident     = 0;
+        uint64_t m_TilesRequested      = 0; // allocated by TTM and queued for loading
+        uint64_t m_TilesLoaded         = 0; // data arrived and mapped
+        uint64_t m_TilesCancelled      = 0; // unmapped while queued or in flight
+        uint64_t m_TilesUnmapped       = 0; // evicted after being requested
+        uint64_t m_TilesMoved          = 0; // defragmented with their data resident (a GPU copy, no I/O)
+        uint64_t m_BytesRead           = 0; // from disk
+        uint64_t m_TilesFromCache      = 0;
+        uint64_t m_BytesFromCache      = 0;
+        uint32_t m_HeapsAdded          = 0;
+        uint32_t m_HeapsRemoved        = 0;
+        uint32_t m_PeakHeaps           = 0;
+        uint64_t m_RecordedTilesMapped = 0; // TilesMapped records, for comparison
+
+        double GetHitRate() const { return m_RegionsSampled > 0 ? (double)m_RegionsResident / (double)m_RegionsSampled : 1.0; }
+    };
+
+    bool SimulateStreamingTrace(const std::filesystem::path& tracePath, const StreamingSimConfig& config, StreamingSimStats& outStats);
+
+} // namespace nvfeedback
@@ -0,0 +1,139 @@
+#include "TextureStreamingStats.h"
+#include "../Log.h"
+
+namespace nvfeedback
+{
+    static std::string EscapeJson(std::string_view str)
+    {
+        std::string out;
+        out.reserve(str.size());
+        for (char c : str)
+        {
+            if (c == '"')       out += "\\\"";
+            else if (c == '\\') out += "\\\\";
+            else if ((unsigned char)c < 0x20) out += ' ';
+            else                out += c;
+        }
+        return out;
+    }
+
+    static void WriteUintArray(FILE* f, const std::vector<uint32_t>& values)
+    {
+        fprintf(f, "[");
+        for (size_t i = 0; i < values.size(); ++i)
+            fprintf(f, i > 0 ? ", %u" : "%u", values[i]);
+        fprintf(f, "]");
+    }
+
+    uint64_t TextureStreamingReport::GetUnusedTexels() const
+    {
+        const uint32_t finestMip = m_Stats.m_FinestRequestedMip;
+        if (finestMip == 0 || finestMip == 0xFF)
+            return 0;
+
+        const uint64_t texels = (uint64_t)m_Width * m_Height;
+        return texels - (texels >> (2 * std::min(finestMip, 31u)));
+    }
+
+    bool WriteTextureStreamingReport(const std::filesystem::path& filePath, std::span<const TextureStreamingReport> reports, double sessionSeconds)
+    {
+        FILE* f = fopen(filePath.string().c_str(), "w");
+        if (!f)
+        {
+            LOG_ERROR("[Streaming] Failed to write texture stats '%s'", filePath.string().c_str());
+            return false;
+        }
+
+        fprintf(f, "{\n");
+        fprintf(f, "\t\"sessionSeconds\": %.3f,\n", sessionSeconds);
+        fprintf(f, "\t\"textures\": [\n");
+        for (size_t i = 0; i < reports.size(); ++i)
+        {
+            const TextureStreamingReport& report = reports[i];
+            const TextureStreamingStats& stats = report.m_Stats;
+
+            fprintf(f, "\t\t{\n");
+            fprintf(f, "\t\t\t\"name\": \"%s\",\n", EscapeJson(report.m_Name).c_str());
+            fprintf(f, "\t\t\t\"index\": %u,\n", report.m_TextureIdx);
+            fprintf(f, "\t\t\t\"width\": %u,\n", report.m_Width);
+            fprintf(f, "\t\t\t\"height\": %u,\n", report.m_Height);
+            fprintf(f, "\t\t\t\"standardMips\": %u,\n", report.m_NumStandardMips);
+            if (stats.m_FinestRequestedMip == 0xFF)
+                fprintf(f, "\t\t\t\"finestRequestedMip\": null,\n");
+            else
+                fprintf(f, "\t\t\t\"finestRequestedMip\": %u,\n", (uint32_t)stats.m_FinestRequestedMip);
+            fprintf(f, "\t\t\t\"tilesRequested\": %llu,\n", (unsigned long long)stats.m_TilesRequested);
+            fprintf(f, "\t\t\t\"tilesLoaded\": %llu,\n", (unsigned long long)stats.m_TilesLoaded);
+            fprintf(f, "\t\t\t\"tilesResident\": %u,\n", stats.m_TilesResident);
+            fprintf(f, "\t\t\t\"tilesStandby\": %u,\n", report.m_TilesStandby);
+            fprintf(f, "\t\t\t\"tilesEvicted\": %llu,\n", (unsigned long long)stats.m_TilesEvicted);
+            fprintf(f, "\t\t\t\"bytesRead\": %llu,\n", (unsigned long long)stats.m_BytesRead);
+            fprintf(f, "\t\t\t\"averageLatencyMs\": %.3f,\n", report.m_AverageLatencyMs);
+            fprintf(f, "\t\t\t\"secondsBelowRequestedMip\": %.3f,\n", report.m_SecondsBelowRequestedMip);
+            fprintf(f, "\t\t\t\"tilesPerMip\": ");
+            WriteUintArray(f, report.m_TilesPerMip);
+            fprintf(f, ",\n\t\t\t\"residentTilesPerMip\": ");
+            WriteUintArray(f, report.m_ResidentTilesPerMip);
+            fprintf(f, "\n\t\t}%s\n", i + 1 < reports.size() ? "," : "");
+        }
+        fprintf(f, "\t]\n");
+        fprintf(f, "}\n");
+
+        const bool bOk = ferror(f) == 0;
+        fclose(f);
+        return bOk;
+    }
+
+    void LogWorstStreamingTextures(std::span<const TextureStreamingReport> reports, uint32_t count)
+    {
+        std::vector<const TextureStreamingReport*> sorted;
+        sorted.reserve(reports.size());
+
+        auto logWorst = [&](const char* title, auto key, auto print)
+        {
+            sorted.clear();
+            for (const TextureStreamingReport& report : reports)
+            {
+                if (key(report) > 0)
+                    sorted.push_back(&report);
+            }
+            if (sorted.empty())
+                return;
+
+            const size_t numShown = std::min<size_t>(count, sorted.size());
+            std::partial_sort(sorted.begin(), sorted.begin() + numShown, sorted.end(),
+                [&](const TextureStreamingReport* a, const TextureStreamingReport* b) { return key(*a) > key(*b); });
+
+            LOG_INFO("[Streaming] Worst textures by %s:", title);
+            for (size_t i = 0; i < numShown; ++i)
+                print(*sorted[i]);
+        };
+
+        logWorst("bytes read",
+            [](const TextureStreamingReport& r) { return (double)r.m_Stats.m_BytesRead; },
+            [](const TextureStreamingReport& r)
+            {
+                LOG_INFO("[Streaming]   %8.2f MB  %llu tiles loaded, %llu evicted  %s", BYTES_TO_MB(r.m_Stats.m_BytesRead),
+                         (unsigned long long)r.m_Stats.m_TilesLoaded, (unsigned long long)r.m_Stats.m_TilesEvicted, r.m_Name.c_str());
+            });
+        logWorst("time below the requested mip",
+            [](const TextureStreamingReport& r) { return r.m_SecondsBelowRequestedMip; },
+            [](const TextureStreamingReport& r)
+            {
+                LOG_INFO("[Streaming]   %8.2f s   %s", r.m_SecondsBelowRequestedMip, r.m_Name.c_str());
+            });
+        logWorst("average request-to-resident latency",
+            [](const TextureStreamingReport& r) { return r.m_AverageLatencyMs; },
+            [](const TextureStreamingReport& r)
+            {
+                LOG_INFO("[Streaming]   %8.1f ms  over %llu tiles  %s", r.m_AverageLatencyMs, (unsigned long long)r.m_Stats.m_TilesLoaded, r.m_Name.c_str());
+            });
+        logWorst("unused resolution (finest sampled mip > 0)",
+            [](const TextureStreamingReport& r) { return (double)r.GetUnusedTexels(); },
+            [](const TextureStreamingReport& r)
+            {
+                LOG_INFO("[Streaming]   %ux%u, finest sampled mip %u  %s", r.m_Width, r.m_Height, (uint32_t)r.m_Stats.m_FinestRequestedMip, r.m_Name.c_str());
+            });
+    }
+
+} // namespace nvfeedback
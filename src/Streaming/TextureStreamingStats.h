@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../Utilities.h"
+
+namespace nvfeedback
+{
+    // ─── TextureStreamingStats ───────────────────────────────────────────────
+    // Per-texture counters, kept on each FeedbackTexture by FeedbackManager
+    // where it already touches the tiles (Step 6 collection, UpdateTileMappings,
+    // feedback readback and MinMip upload), so keeping them costs a few adds
+    // per tile.  Counts are cumulative since RegisterTexture, except
+    // m_TilesResident.  Times are SDL performance counter ticks.
+    //
+    // A texture is below its requested mip while some feedback region sampled at
+    // mip N has only a coarser mip resident; the stretch starts and ends when the
+    // readback or the MinMip upload changes that.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    struct TextureStreamingStats
+    {
+        uint64_t m_TilesRequested      = 0; // standard tiles TTM allocated and queued for loading
+        uint64_t m_TilesLoaded         = 0; // of those, mapped once their data arrived
+        uint64_t m_TilesEvicted        = 0; // unmapped by TTM, requests cancelled before loading included
+        uint64_t m_BytesRead           = 0; // source bytes read for its tiles (TileCache hits read none)
+        uint64_t m_LatencyTicks        = 0; // request-to-resident time summed over m_TilesLoaded
+        uint64_t m_BelowRequestedTicks = 0; // finished stretches below the requested mip
+        uint64_t m_BelowRequestedSince = 0; // start of the current stretch, 0 = not below
+        uint32_t m_TilesResident       = 0; // standard tiles mapped now
+        uint8_t  m_FinestRequestedMip  = 0xFF; // finest mip any feedback sampled (0xFF = never sampled)
+    };
+
+    // ─── TextureStreamingReport ──────────────────────────────────────────────
+    // One texture's row in the export: the counters plus what is only worth
+    // computing on demand (standby tiles need every resident tile checked
+    // against the latest feedback) and the per-mip residency heatmap.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    struct TextureStreamingReport
+    {
+        std::string m_Name;            // filled by the caller (FeedbackManager has no names)
+        uint32_t    m_TextureIdx      = 0;
+        uint32_t    m_Width           = 0;
+        uint32_t    m_Height          = 0;
+        uint32_t    m_NumStandardMips = 0;
+        uint32_t    m_TilesStandby    = 0; // resident, but not sampled by the latest feedback nor prefetched
+        double      m_AverageLatencyMs          = 0.0;
+        double      m_SecondsBelowRequestedMip  = 0.0;
+        std::vector<uint32_t> m_TilesPerMip;         // standard mips
+        std::vector<uint32_t> m_ResidentTilesPerMip;
+        TextureStreamingStats m_Stats;
+
+        // Texels of the full-resolution image feedback never asked for: a texture
+        // whose finest sampled mip is N could have been 4^N times smaller.
+        uint64_t GetUnusedTexels() const;
+    };
+
+    bool WriteTextureStreamingReport(const std::filesystem::path& filePath, std::span<const TextureStreamingReport> reports, double sessionSeconds);
+
+    // Logs the `count` worst textures by bytes read, time below the requested mip,
+    // average latency and unused resolution.
+    void LogWorstStreamingTextures(std::span<const TextureStreamingReport> reports, uint32_t count);
+
+} // namespace nvfeedback
@@ -0,0 +1,185 @@
+#include "TileCache.h"
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace nvfeedback
+{
+    // ─── TileCachePolicy ─────────────────────────────────────────────────────
+
+    uint32_t TileCachePolicy::Find(const TileCacheKey& key)
+    {
+        auto it = m_Index.find(key);
+        if (it == m_Index.end())
+            return kInvalidSlot;
+
+        m_Slots[it->second].m_bReferenced = true;
+        return it->second;
+    }
+
+    uint32_t TileCachePolicy::Insert(const TileCacheKey& key, uint64_t sizeInBytes, std::vector<uint32_t>& outEvicted)
+    {
+        if (sizeInBytes > m_CapacityBytes || m_Index.contains(key))
+            return kInvalidSlot;
+
+        while (m_SizeInBytes + sizeInBytes > m_CapacityBytes)
+            outEvicted.push_back(EvictNext());
+
+        uint32_t slot;
+        if (m_FreeSlots.empty())
+        {
+            slot = (uint32_t)m_Slots.size();
+            m_Slots.emplace_back();
+        }
+        else
+        {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+
+        Slot& s = m_Slots[slot];
+        s.m_Key         = key;
+        s.m_SizeInBytes = sizeInBytes;
+        s.m_bUsed       = true;
+        s.m_bReferenced = false;
+
+        m_SizeInBytes += sizeInBytes;
+        m_Index.emplace(key, slot);
+        return slot;
+    }
+
+    uint32_t TileCachePolicy::EvictNext()
+    {
+        assert(!m_Index.empty());
+
+        // At most two sweeps: the first clears every reference bit it passes
+        while (true)
+        {
+            if (m_Hand >= m_Slots.size())
+                m_Hand = 0;
+
+            const uint32_t slot = m_Hand++;
+            Slot& s = m_Slots[slot];
+            if (!s.m_bUsed)
+                continue;
+
+            if (s.m_bReferenced)
+            {
+                s.m_bReferenced = false;
+                continue;
+            }
+
+            m_Index.erase(s.m_Key);
+            FreeSlot(slot);
+            m_NumEvictions++;
+            return slot;
+        }
+    }
+
+    void TileCachePolicy::FreeSlot(uint32_t slot)
+    {
+        Slot& s = m_Slots[slot];
+        m_SizeInBytes -= s.m_SizeInBytes;
+        s = {};
+        m_FreeSlots.push_back(slot);
+    }
+
+    void TileCachePolicy::Erase(const TileCacheKey& key)
+    {
+        auto it = m_Index.find(key);
+        if (it == m_Index.end())
+            return;
+
+        FreeSlot(it->second);
+        m_Index.erase(it);
+    }
+
+    void TileCachePolicy::Clear()
+    {
+        m_Slots.clear();
+        m_FreeSlots.clear();
+        m_Index.clear();
+        m_SizeInBytes = 0;
+        m_Hand        = 0;
+    }
+
+    // ─── TileCache ───────────────────────────────────────────────────────────
+
+    bool TileCache::Lookup(const TileCacheKey& key, uint8_t* dst, uint32_t dstRowPitch, uint32_t rowBytes, uint32_t numRows)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        const uint32_t slot = m_Policy.Find(key);
+        if (slot == TileCachePolicy::kInvalidSlot || m_Entries[slot].m_Data.size() != (size_t)rowBytes * numRows)
+        {
+            m_NumMisses++;
+            return false;
+        }
+
+        const uint8_t* src = m_Entries[slot].m_Data.data();
+        if (dstRowPitch == rowBytes)
+        {
+            memcpy(dst, src, (size_t)rowBytes * numRows);
+        }
+        else
+        {
+            for (uint32_t row = 0; row < numRows; row++)
+                memcpy(dst + (size_t)row * dstRowPitch, src + (size_t)row * rowBytes, rowBytes);
+        }
+
+        m_NumHits++;
+        return true;
+    }
+
+    void TileCache::Insert(const TileCacheKey& key, std::shared_ptr<const void> owner, std::vector<uint8_t>&& data)
+    {
+        // Freed outside the lock
+        std::vector<Entry> evicted;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            m_Evicted.clear();
+            const uint32_t slot = m_Policy.Insert(key, data.size(), m_Evicted);
+
+            for (uint32_t evictedSlot : m_Evicted)
+            {
+                if (evictedSlot != slot)
+                    evicted.push_back(std::move(m_Entries[evictedSlot]));
+            }
+
+            if (slot == TileCachePolicy::kInvalidSlot)
+                return;
+
+            if (slot >= m_Entries.size())
+                m_Entries.resize(slot + 1);
+            m_Entries[slot].m_Data  = std::move(data);
+            m_Entries[slot].m_Owner = std::move(owner);
+        }
+    }
+
+    void TileCache::Clear()
+    {
+        std::vector<Entry> entries;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Policy.Clear();
+            std::swap(entries, m_Entries);
+        }
+    }
+
+    TileCache::Stats TileCache::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        Stats stats;
+        stats.m_CapacityBytes = m_Policy.GetCapacityBytes();
+        stats.m_SizeInBytes   = m_Policy.GetSizeInBytes();
+        stats.m_NumEntries    = m_Policy.GetNumEntries();
+        stats.m_NumHits       = m_NumHits;
+        stats.m_NumMisses     = m_NumMisses;
+        stats.m_NumEvictions  = m_Policy.GetNumEvictions();
+        return stats;
+    }
+
+} // namespace nvfeedback
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace nvfeedback
+{
+    // One standard tile of one source: the source's identity (AsyncTileIO uses the
+    // MemoryMappedDataReader address), the mip and the tile origin in texels.
+    struct TileCacheKey
+    {
+        uint64_t m_Source        = 0;
+        uint32_t m_MipLevel      = 0;
+        uint32_t m_XInTexels     = 0;
+        uint32_t m_YInTexels     = 0;
+
+        bool operator==(const TileCacheKey&) const = default;
+    };
+
+    struct TileCacheKeyHash
+    {
+        size_t operator()(const TileCacheKey& key) const
+        {
+            uint64_t h = key.m_Source * 0x9E3779B97F4A7C15ull;
+            h ^= ((uint64_t)key.m_MipLevel << 56) ^ ((uint64_t)key.m_XInTexels << 28) ^ key.m_YInTexels;
+            h ^= h >> 29;
+            return (size_t)(h * 0xBF58476D1CE4E5B9ull);
+        }
+    };
+
+    // ─── TileCachePolicy ─────────────────────────────────────────────────────
+    // Byte-capped CLOCK (second chance) replacement over slot indices, without
+    // the tile data: TileCache stores the bytes, the streaming trace simulator
+    // only the bookkeeping.
+    //
+    //   Find()    a hit sets the entry's reference bit.
+    //   Insert()  evicts until the new entry fits: the hand sweeps the slots,
+    //             clearing set reference bits and evicting the first entry
+    //             whose bit is already clear.  New entries start unreferenced,
+    //             so a tile read once and never again is the next to go, while
+    //             a tile hit since the hand last passed survives one more sweep.
+    // Freed slots are reused most recent first; an entry inserted right after an
+    // eviction takes the evicted slot just behind the hand and so gets a full
+    // sweep before it is considered.  Not thread-safe.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    class TileCachePolicy
+    {
+    public:
+        static constexpr uint32_t kInvalidSlot = UINT32_MAX;
+
+        explicit TileCachePolicy(uint64_t capacityBytes) : m_CapacityBytes(capacityBytes) {}
+
+        // Slot of key (reference bit set), or kInvalidSlot.
+        uint32_t Find(const TileCacheKey& key);
+
+        // Slot for a new entry of sizeInBytes, after evicting what it takes to fit
+        // (evicted slots are appended to outEvicted; the returned slot may be one of
+        // them).  kInvalidSlot when the entry is larger than the cache or already cached.
+        uint32_t Insert(const TileCacheKey& key, uint64_t sizeInBytes, std::vector<uint32_t>& outEvicted);
+
+        void Erase(const TileCacheKey& key);
+        void Clear();
+
+        uint64_t GetCapacityBytes() const { return m_CapacityBytes; }
+        uint64_t GetSizeInBytes() const   { return m_SizeInBytes; }
+        uint32_t GetNumEntries() const    { return (uint32_t)m_Index.size(); }
+        uint64_t GetNumEvictions() const  { return m_NumEvictions; }
+
+    private:
+        struct Slot
+        {
+            TileCacheKey m_Key;
+            uint64_t     m_SizeInBytes = 0;
+            bool         m_bUsed       = false;
+            bool         m_bReferenced = false;
+        };
+
+        uint32_t EvictNext();
+        void     FreeSlot(uint32_t slot);
+
+        const uint64_t m_CapacityBytes;
+        uint64_t       m_SizeInBytes  = 0;
+        uint64_t       m_NumEvictions = 0;
+
+        std::vector<Slot>     m_Slots;
+        std::vector<uint32_t> m_FreeSlots;
+        uint32_t              m_Hand = 0;
+        std::unordered_map<TileCacheKey, uint32_t, TileCacheKeyHash> m_Index;
+    };
+
+    // ─── TileCache ───────────────────────────────────────────────────────────
+    // Host-memory tier between the tile sources and the VRAM heaps: decoded,
+    // tightly packed tile rows, consulted by the AsyncTileIO workers before they
+    // read a tile and filled with every tile they read.  Tiles that TTM evicted
+    // (hysteresis, standby trim) and requests again shortly after are copied
+    // from here instead of going back to disk and through the decoder.
+    //
+    // Each entry holds a reference to the object its key's m_Source was derived
+    // from, so a source address cannot be reused by another file while cached
+    // tiles still carry it.  Thread-safe.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    class TileCache
+    {
+    public:
+        explicit TileCache(uint64_t capacityBytes) : m_Policy(capacityBytes) {}
+
+        // Copies a cached tile's numRows rows of rowBytes into dst, dstRowPitch apart.
+        // False on a miss, or when the cached tile has a different size.
+        bool Lookup(const TileCacheKey& key, uint8_t* dst, uint32_t dstRowPitch, uint32_t rowBytes, uint32_t numRows);
+
+        // Takes ownership of a tightly packed tile.  Ignored when key is already cached.
+        void Insert(const TileCacheKey& key, std::shared_ptr<const void> owner, std::vector<uint8_t>&& data);
+
+        void Clear();
+
+        struct Stats
+        {
+            uint64_t m_CapacityBytes = 0;
+            uint64_t m_SizeInBytes   = 0;
+            uint32_t m_NumEntries    = 0;
+            uint64_t m_NumHits       = 0;
+            uint64_t m_NumMisses     = 0;
+            uint64_t m_NumEvictions  = 0;
+        };
+        Stats GetStats() const;
+
+    private:
+        struct Entry
+        {
+            std::vector<uint8_t>        m_Data;
+            std::shared_ptr<const void> m_Owner;
+        };
+
+        TileCachePolicy       m_Policy;
+        std::vector<Entry>    m_Entries;  // indexed by policy slot
+        std::vector<uint32_t> m_Evicted;
+        uint64_t              m_NumHits   = 0;
+        uint64_t              m_NumMisses = 0;
+        mutable std::mutex    m_Mutex;
+    };
+
+} // namespace nvfeedback
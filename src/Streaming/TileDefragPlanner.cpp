@@ -0,0 +1,78 @@
+#include "TileDefragPlanner.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace nvfeedback
+{
+    void TileDefragPlanner::AddHeap(uint32_t heapId, bool bPinned)
+    {
+        if (heapId >= m_Heaps.size())
+            m_Heaps.resize(heapId + 1);
+
+        m_Heaps[heapId] = { 0, true, bPinned };
+    }
+
+    void TileDefragPlanner::RemoveHeap(uint32_t heapId)
+    {
+        assert(heapId < m_Heaps.size());
+        m_Heaps[heapId] = {};
+    }
+
+    void TileDefragPlanner::OnTileAllocated(uint32_t heapId)
+    {
+        assert(heapId < m_Heaps.size() && m_Heaps[heapId].m_bActive);
+        m_Heaps[heapId].m_NumAllocatedTiles++;
+    }
+
+    void TileDefragPlanner::OnTileFreed(uint32_t heapId)
+    {
+        assert(heapId < m_Heaps.size());
+        if (m_Heaps[heapId].m_NumAllocatedTiles > 0)
+            m_Heaps[heapId].m_NumAllocatedTiles--;
+    }
+
+    TileDefragPlan TileDefragPlanner::Plan(uint32_t maxMoves, bool bLowMemoryMode) const
+    {
+        TileDefragPlan plan;
+        if (maxMoves == 0)
+            return plan;
+
+        uint64_t numFreeTiles = 0;
+        uint32_t sourceTiles  = UINT32_MAX;
+        for (uint32_t heapId = 0; heapId < (uint32_t)m_Heaps.size(); ++heapId)
+        {
+            const Heap& heap = m_Heaps[heapId];
+            if (!heap.m_bActive)
+                continue;
+
+            numFreeTiles += m_HeapSizeInTiles - heap.m_NumAllocatedTiles;
+
+            // Empty heaps are released without moving anything
+            if (heap.m_bPinned || heap.m_NumAllocatedTiles == 0)
+                continue;
+
+            if (heap.m_NumAllocatedTiles < sourceTiles)
+            {
+                sourceTiles         = heap.m_NumAllocatedTiles;
+                plan.m_SourceHeapId = heapId;
+            }
+        }
+
+        if (plan.m_SourceHeapId == UINT32_MAX)
+            return plan;
+
+        // The source's tiles must fit into the other heaps' free slots
+        const uint64_t numFreeElsewhere = numFreeTiles - (m_HeapSizeInTiles - sourceTiles);
+        const bool bNearlyEmpty = sourceTiles <= (uint32_t)(m_MaxSourceOccupancy * m_HeapSizeInTiles);
+        if (sourceTiles > numFreeElsewhere || (!bNearlyEmpty && !bLowMemoryMode))
+        {
+            plan.m_SourceHeapId = UINT32_MAX;
+            return plan;
+        }
+
+        plan.m_NumTilesToMove = std::min(maxMoves, sourceTiles);
+        return plan;
+    }
+
+} // namespace nvfeedback
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace nvfeedback
+{
+    // ─── TileDefragPlanner ───────────────────────────────────────────────────
+    // Decides when BeginFrame defragments the TTM heaps and how many tiles it
+    // moves, from the number of allocated tiles in each heap.
+    //
+    // Defragmenting only pays off when it ends with an empty heap that can be
+    // released: the source heap is the least occupied one, it has to fit into
+    // the free slots of the other heaps, and at most m_MaxSourceOccupancy of it
+    // may be in use (moving a half-full heap costs as many copies as streaming
+    // it in again).  In low-memory mode any heap that fits qualifies.  A frame
+    // moves min(budget, tiles left in the source), so a nearly empty heap is
+    // evacuated within a frame or two.  Heaps holding packed mips are pinned:
+    // they are never released, so they only receive tiles.
+    //
+    // TTM's DefragmentTiles() picks the actual tiles; the planner only sizes the
+    // work.  FeedbackManager keeps the counts up to date as tiles are allocated,
+    // moved and unmapped.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    // Tiles defragmentation may move (and copy on the GPU) per BeginFrame.
+    static constexpr uint32_t kMaxDefragMovesPerFrame = 16;
+
+    struct TileDefragPlan
+    {
+        uint32_t m_SourceHeapId   = UINT32_MAX;
+        uint32_t m_NumTilesToMove = 0;
+    };
+
+    class TileDefragPlanner
+    {
+    public:
+        explicit TileDefragPlanner(uint32_t heapSizeInTiles) : m_HeapSizeInTiles(heapSizeInTiles) {}
+
+        void AddHeap(uint32_t heapId, bool bPinned);
+        void RemoveHeap(uint32_t heapId);
+
+        void OnTileAllocated(uint32_t heapId);
+        void OnTileFreed(uint32_t heapId);
+
+        TileDefragPlan Plan(uint32_t maxMoves, bool bLowMemoryMode) const;
+
+        uint32_t GetNumAllocatedTiles(uint32_t heapId) const { return heapId < m_Heaps.size() ? m_Heaps[heapId].m_NumAllocatedTiles : 0; }
+
+        // Fraction of a heap that may still be in use for it to be evacuated outside low-memory mode
+        void SetMaxSourceOccupancy(float occupancy) { m_MaxSourceOccupancy = occupancy; }
+
+    private:
+        struct Heap
+        {
+            uint32_t m_NumAllocatedTiles = 0;
+            bool     m_bActive           = false;
+            bool     m_bPinned           = false;
+        };
+
+        const uint32_t    m_HeapSizeInTiles;
+        float             m_MaxSourceOccupancy = 0.25f;
+        std::vector<Heap> m_Heaps; // indexed by heap id
+    };
+
+} // namespace nvfeedback
@@ -0,0 +1,47 @@
+#include "TileMappingBatch.h"
+
+#include <algorithm>
+
+namespace nvfeedback
+{
+    std::span<const TileMappingRun> TileMappingBatch::Build()
+    {
+        std::sort(m_Tiles.begin(), m_Tiles.end(), [](const Tile& a, const Tile& b)
+        {
+            if (a.m_TextureIdx != b.m_TextureIdx)
+                return a.m_TextureIdx < b.m_TextureIdx;
+            if (a.m_HeapId != b.m_HeapId)
+                return a.m_HeapId < b.m_HeapId;
+            return a.m_TileIndex < b.m_TileIndex;
+        });
+
+        m_Runs.clear();
+        uint32_t runMipLevel = 0;
+        for (const Tile& tile : m_Tiles)
+        {
+            if (!m_Runs.empty())
+            {
+                TileMappingRun& run = m_Runs.back();
+                if (run.m_TextureIdx == tile.m_TextureIdx && run.m_HeapId == tile.m_HeapId)
+                {
+                    const uint32_t lastTileIndex = run.m_TileIndex + run.m_NumTiles - 1;
+                    if (tile.m_TileIndex == lastTileIndex)
+                        continue;
+
+                    if (tile.m_TileIndex == lastTileIndex + 1 && tile.m_MipLevel == runMipLevel &&
+                        (tile.m_HeapId == kNoHeap || tile.m_HeapTileIndex == run.m_HeapTileIndex + run.m_NumTiles))
+                    {
+                        run.m_NumTiles++;
+                        continue;
+                    }
+                }
+            }
+
+            m_Runs.push_back({ tile.m_TextureIdx, tile.m_HeapId, tile.m_TileIndex, tile.m_HeapTileIndex, 1 });
+            runMipLevel = tile.m_MipLevel;
+        }
+
+        return m_Runs;
+    }
+
+} // namespace nvfeedback
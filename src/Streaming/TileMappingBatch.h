@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace nvfeedback
+{
+    // ─── TileMappingBatch ────────────────────────────────────────────────────
+    // One frame's tile mappings, reduced to as few regions as possible.
+    //
+    // Tiles are collected into a flat array, sorted by (texture, heap, tile
+    // index) and merged into runs: a tile extends the previous run when it is
+    // the next tile of the same mip (TTM numbers a mip's tiles in row-major
+    // order, the order D3D12 walks a tile region without a box) and sits in
+    // the next slot of the same heap.  Runs of one texture are contiguous, so
+    // FeedbackManager issues one updateTextureTileMappings() per texture with
+    // one mapping per heap.  Both arrays are reused across frames.
+    //
+    // Unmaps go through the same path: AddUnmap() tiles have no heap
+    // (kNoHeap, sorted after every heap of their texture), and merge into a
+    // run whenever they are the next tile of the same mip.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    struct TileMappingRun
+    {
+        uint32_t m_TextureIdx    = UINT32_MAX;
+        uint32_t m_HeapId        = 0; // kNoHeap: unmap the tiles
+        uint32_t m_TileIndex     = 0; // first tile
+        uint32_t m_HeapTileIndex = 0; // heap slot of the first tile
+        uint32_t m_NumTiles      = 0;
+    };
+
+    class TileMappingBatch
+    {
+    public:
+        static constexpr uint32_t kNoHeap = UINT32_MAX;
+
+        void Clear() { m_Tiles.clear(); m_Runs.clear(); }
+
+        void Add(uint32_t textureIdx, uint32_t tileIndex, uint32_t mipLevel, uint32_t heapId, uint32_t heapTileIndex)
+        {
+            m_Tiles.push_back({ textureIdx, heapId, tileIndex, heapTileIndex, mipLevel });
+        }
+
+        void AddUnmap(uint32_t textureIdx, uint32_t tileIndex, uint32_t mipLevel)
+        {
+            m_Tiles.push_back({ textureIdx, kNoHeap, tileIndex, 0, mipLevel });
+        }
+
+        // Sorts and merges the added tiles.  A tile added twice is mapped once.
+        std::span<const TileMappingRun> Build();
+
+        uint32_t GetNumTiles() const { return (uint32_t)m_Tiles.size(); }
+
+    private:
+        struct Tile
+        {
+            uint32_t m_TextureIdx;
+            uint32_t m_HeapId;
+            uint32_t m_TileIndex;
+            uint32_t m_HeapTileIndex;
+            uint32_t m_MipLevel;
+        };
+
+        std::vector<Tile>           m_Tiles;
+        std::vector<TileMappingRun> m_Runs;
+    };
+
+} // namespace nvfeedback
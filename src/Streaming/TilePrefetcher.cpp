@@ -0,0 +1,329 @@
+#include "TilePrefetcher.h"
+#include "../Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace nvfeedback
+{
+    // Standard tiles are always 64 KB
+    static constexpr uint64_t kPrefetchTileSizeInBytes = 64 * 1024;
+    // The visibility cone is widened so objects about to rotate into view count
+    static constexpr float kPrefetchConeGuardBand = 1.15f;
+    // Pitch limit of Camera, reapplied to extrapolated poses
+    static constexpr float kMaxPitch = std::numbers::pi_v<float> / 2.0f - 0.01f;
+
+    static float WrapAngle(float angle)
+    {
+        return std::remainder(angle, 2.0f * std::numbers::pi_v<float>);
+    }
+
+    static PrefetchVector3 Subtract(const PrefetchVector3& a, const PrefetchVector3& b)
+    {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
+
+    static float Dot(const PrefetchVector3& a, const PrefetchVector3& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    static float Length(const PrefetchVector3& v)
+    {
+        return std::sqrt(Dot(v, v));
+    }
+
+    static uint8_t ClampToStandardMips(const PrefetchTexture& texture, uint8_t mip)
+    {
+        return (uint8_t)std::min<uint32_t>(mip, texture.m_NumStandardMips);
+    }
+
+    uint32_t GetPrefetchTileCount(const PrefetchTexture& texture, uint8_t firstMip)
+    {
+        if (texture.m_TileWidthInTexels == 0 || texture.m_TileHeightInTexels == 0)
+            return 0;
+
+        uint32_t numTiles = 0;
+        for (uint32_t mip = firstMip; mip < texture.m_NumStandardMips; ++mip)
+        {
+            const uint32_t mipWidth  = std::max(1u, texture.m_Width >> mip);
+            const uint32_t mipHeight = std::max(1u, texture.m_Height >> mip);
+            numTiles += DivideAndRoundUp(mipWidth, texture.m_TileWidthInTexels) * DivideAndRoundUp(mipHeight, texture.m_TileHeightInTexels);
+        }
+        return numTiles;
+    }
+
+    uint64_t GetPrefetchBytes(const PrefetchTexture& texture, uint8_t firstMip)
+    {
+        return (uint64_t)GetPrefetchTileCount(texture, firstMip) * kPrefetchTileSizeInBytes;
+    }
+
+    // Bytes of the standard mips [firstMip, endMip)
+    static uint64_t GetPrefetchBytesInRange(const PrefetchTexture& texture, uint8_t firstMip, uint8_t endMip)
+    {
+        firstMip = ClampToStandardMips(texture, firstMip);
+        endMip   = ClampToStandardMips(texture, endMip);
+        if (firstMip >= endMip)
+            return 0;
+        return GetPrefetchBytes(texture, firstMip) - GetPrefetchBytes(texture, endMip);
+    }
+
+    float GetPrefetchWorldScale(const float (&world)[4][4])
+    {
+        float scale = 0.0f;
+        for (uint32_t axis = 0; axis < 3; ++axis)
+            scale = std::max(scale, Length({ world[axis][0], world[axis][1], world[axis][2] }));
+        return scale;
+    }
+
+    void TexelDensityEstimator::AddTriangle(const PrefetchVector3 (&positions)[3], const float (&uvs)[3][2])
+    {
+        const PrefetchVector3 e1 = Subtract(positions[1], positions[0]);
+        const PrefetchVector3 e2 = Subtract(positions[2], positions[0]);
+        const PrefetchVector3 cross{ e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x };
+
+        m_SurfaceArea += 0.5 * Length(cross);
+        m_UVArea      += 0.5 * std::abs((uvs[1][0] - uvs[0][0]) * (uvs[2][1] - uvs[0][1]) - (uvs[2][0] - uvs[0][0]) * (uvs[1][1] - uvs[0][1]));
+    }
+
+    float TexelDensityEstimator::GetUVDensity() const
+    {
+        if (m_SurfaceArea <= 0.0 || m_UVArea <= 0.0)
+            return 0.0f;
+        return (float)std::sqrt(m_UVArea / m_SurfaceArea);
+    }
+
+    void AccumulateNeededMips(const PrefetchScene& scene, const PrefetchView& view, const CameraPose& pose, std::vector<uint8_t>& outMips)
+    {
+        outMips.resize(scene.m_Textures.size(), kPrefetchMipNone);
+
+        // Same basis as Camera::GetViewMatrix: +Z rotated by pitch about X, then by yaw about Y
+        const float cosPitch = std::cos(pose.m_Pitch);
+        const PrefetchVector3 forward{ std::sin(pose.m_Yaw) * cosPitch, -std::sin(pose.m_Pitch), std::cos(pose.m_Yaw) * cosPitch };
+
+        // Cone around the frustum's corner rays
+        const float tanHalfFovY   = std::tan(view.m_FovY * 0.5f);
+        const float tanHalfDiag   = tanHalfFovY * std::sqrt(1.0f + view.m_AspectRatio * view.m_AspectRatio);
+        const float coneHalfAngle = std::min(std::atan(tanHalfDiag) * kPrefetchConeGuardBand, std::numbers::pi_v<float>);
+
+        // Screen pixels covered by one meter at distance 1
+        const float pixelsPerMeterAtUnitDistance = view.m_ViewportHeight / (2.0f * tanHalfFovY);
+
+        for (const PrefetchInstance& instance : scene.m_Instances)
+        {
+            if (instance.m_MaterialIndex >= scene.m_Materials.size())
+                continue;
+
+            const PrefetchMaterial& material = scene.m_Materials[instance.m_MaterialIndex];
+            if (material.m_Textures.empty())
+                continue;
+
+            const PrefetchVector3 toCenter = Subtract(instance.m_Center, pose.m_Position);
+            const float           distance = Length(toCenter);
+
+            if (distance > instance.m_Radius)
+            {
+                const float cosAngle    = std::clamp(Dot(toCenter, forward) / distance, -1.0f, 1.0f);
+                const float angle       = std::acos(cosAngle);
+                const float sphereAngle = std::asin(std::min(instance.m_Radius / distance, 1.0f));
+                if (angle - sphereAngle > coneHalfAngle)
+                    continue;
+            }
+
+            const float nearestDistance = std::max(distance - instance.m_Radius, view.m_NearZ);
+            const float pixelsPerMeter  = pixelsPerMeterAtUnitDistance / nearestDistance;
+
+            const float uvPerMeter = material.m_UVDensity > 0.0f
+                ? material.m_UVDensity / std::max(instance.m_WorldScale, 1e-6f)
+                : 1.0f / std::max(2.0f * instance.m_Radius, 1e-6f);
+
+            for (uint32_t textureIdx : material.m_Textures)
+            {
+                const PrefetchTexture& texture = scene.m_Textures[textureIdx];
+
+                const float texelsPerMeter = uvPerMeter * (float)std::max(texture.m_Width, texture.m_Height);
+                const float mipF           = std::log2(std::max(texelsPerMeter / pixelsPerMeter, 1.0f));
+                const uint32_t mip         = (uint32_t)mipF;
+
+                // Packed mips are always resident
+                if (mip >= texture.m_NumStandardMips)
+                    continue;
+
+                outMips[textureIdx] = std::min(outMips[textureIdx], (uint8_t)mip);
+            }
+        }
+    }
+
+    // ─── TilePrefetcher ──────────────────────────────────────────────────────
+
+    void TilePrefetcher::ResetHistory()
+    {
+        m_Velocity   = PrefetchVector3{};
+        m_YawRate    = 0.0f;
+        m_PitchRate  = 0.0f;
+        m_NumSamples = 0;
+    }
+
+    void TilePrefetcher::AddCameraSample(const CameraPose& pose)
+    {
+        const double dt = pose.m_Time - m_Last.m_Time;
+
+        if (m_NumSamples == 0 || dt > kMaxSampleGapSeconds || dt < 0.0)
+        {
+            ResetHistory();
+            m_Last       = pose;
+            m_NumSamples = 1;
+            return;
+        }
+
+        // Same timestamp: keep the velocity, take the newer pose
+        if (dt == 0.0)
+        {
+            m_Last = pose;
+            return;
+        }
+
+        const float invDt = (float)(1.0 / dt);
+        const PrefetchVector3 velocity{
+            (pose.m_Position.x - m_Last.m_Position.x) * invDt,
+            (pose.m_Position.y - m_Last.m_Position.y) * invDt,
+            (pose.m_Position.z - m_Last.m_Position.z) * invDt };
+        const float yawRate   = WrapAngle(pose.m_Yaw - m_Last.m_Yaw) * invDt;
+        const float pitchRate = (pose.m_Pitch - m_Last.m_Pitch) * invDt;
+
+        const float w = (m_NumSamples == 1) ? 1.0f : kVelocitySmoothing;
+        m_Velocity.x = std::lerp(m_Velocity.x, velocity.x, w);
+        m_Velocity.y = std::lerp(m_Velocity.y, velocity.y, w);
+        m_Velocity.z = std::lerp(m_Velocity.z, velocity.z, w);
+        m_YawRate    = std::lerp(m_YawRate, yawRate, w);
+        m_PitchRate  = std::lerp(m_PitchRate, pitchRate, w);
+
+        m_Last = pose;
+        ++m_NumSamples;
+    }
+
+    bool TilePrefetcher::Extrapolate(float dt, CameraPose& outPose) const
+    {
+        if (m_NumSamples == 0)
+            return false;
+
+        outPose = m_Last;
+        outPose.m_Time += dt;
+        outPose.m_Position.x += m_Velocity.x * dt;
+        outPose.m_Position.y += m_Velocity.y * dt;
+        outPose.m_Position.z += m_Velocity.z * dt;
+        outPose.m_Yaw   = WrapAngle(m_Last.m_Yaw + m_YawRate * dt);
+        outPose.m_Pitch = std::clamp(m_Last.m_Pitch + m_PitchRate * dt, -kMaxPitch, kMaxPitch);
+        return true;
+    }
+
+    void TilePrefetcher::Predict(const PrefetchScene& scene, const PrefetchView& view, std::vector<uint8_t>& outMips) const
+    {
+        outMips.assign(scene.m_Textures.size(), kPrefetchMipNone);
+
+        // A static camera predicts exactly what feedback already requests
+        if (!HasVelocity())
+            return;
+
+        for (uint32_t step = 1; step <= kNumHorizonSteps; ++step)
+        {
+            CameraPose pose;
+            Extrapolate(kHorizonSeconds * (float)step / (float)kNumHorizonSteps, pose);
+            AccumulateNeededMips(scene, view, pose, outMips);
+        }
+    }
+
+    // ─── Camera path replay ──────────────────────────────────────────────────
+
+    PrefetchReplayStats ReplayCameraPath(const PrefetchScene& scene, const PrefetchView& view, std::span<const CameraPose> path)
+    {
+        PrefetchReplayStats stats;
+
+        TilePrefetcher prefetcher;
+        std::vector<uint8_t> currentMips;
+        std::vector<uint8_t> futureMips;
+        std::vector<uint8_t> predictedMips;
+
+        for (size_t i = 0; i < path.size(); ++i)
+        {
+            prefetcher.AddCameraSample(path[i]);
+
+            // Ground truth: everything the path needs over the horizon
+            futureMips.assign(scene.m_Textures.size(), kPrefetchMipNone);
+            bool bHasFuture = false;
+            for (size_t j = i + 1; j < path.size() && path[j].m_Time - path[i].m_Time <= TilePrefetcher::kHorizonSeconds; ++j)
+            {
+                AccumulateNeededMips(scene, view, path[j], futureMips);
+                bHasFuture = true;
+            }
+            if (!bHasFuture)
+                continue;
+
+            currentMips.assign(scene.m_Textures.size(), kPrefetchMipNone);
+            AccumulateNeededMips(scene, view, path[i], currentMips);
+            prefetcher.Predict(scene, view, predictedMips);
+
+            for (size_t t = 0; t < scene.m_Textures.size(); ++t)
+            {
+                const PrefetchTexture& texture = scene.m_Textures[t];
+
+                // Mips are requested whole, so each set is a mip range ending at the current need
+                const uint8_t current   = currentMips[t];
+                const uint8_t future    = futureMips[t];
+                const uint8_t predicted = predictedMips[t];
+
+                stats.m_NeededBytes    += GetPrefetchBytesInRange(texture, future, current);
+                stats.m_PredictedBytes += GetPrefetchBytesInRange(texture, predicted, current);
+                stats.m_HitBytes       += GetPrefetchBytesInRange(texture, std::max(predicted, future), current);
+                stats.m_WastedBytes    += GetPrefetchBytesInRange(texture, predicted, std::min(future, current));
+            }
+            ++stats.m_NumSamples;
+        }
+
+        return stats;
+    }
+
+    bool SaveCameraPath(const std::filesystem::path& filePath, std::span<const CameraPose> path)
+    {
+        std::ofstream file(filePath, std::ios::trunc);
+        if (!file.is_open())
+        {
+            LOG_ERROR("[Prefetch] Failed to write camera path '%s'", filePath.string().c_str());
+            return false;
+        }
+
+        file << std::setprecision(9);
+        for (const CameraPose& pose : path)
+        {
+            file << pose.m_Time << ' '
+                 << pose.m_Position.x << ' ' << pose.m_Position.y << ' ' << pose.m_Position.z << ' '
+                 << pose.m_Yaw << ' ' << pose.m_Pitch << '\n';
+        }
+        return file.good();
+    }
+
+    bool LoadCameraPath(const std::filesystem::path& filePath, std::vector<CameraPose>& outPath)
+    {
+        std::ifstream file(filePath);
+        if (!file.is_open())
+        {
+            LOG_ERROR("[Prefetch] Failed to open camera path '%s'", filePath.string().c_str());
+            return false;
+        }
+
+        outPath.clear();
+        CameraPose pose;
+        while (file >> pose.m_Time >> pose.m_Position.x >> pose.m_Position.y >> pose.m_Position.z >> pose.m_Yaw >> pose.m_Pitch)
+            outPath.push_back(pose);
+
+        if (!file.eof())
+        {
+            LOG_ERROR("[Prefetch] Malformed camera path '%s' after %zu poses", filePath.string().c_str(), outPath.size());
+            return false;
+        }
+        return true;
+    }
+
+} // namespace nvfeedback
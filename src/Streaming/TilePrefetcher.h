@@ -0,0 +1,179 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+
+#include <filesystem>
+#include <numbers>
+#include <span>
+#include <vector>
+
+namespace nvfeedback
+{
+    // ─── TilePrefetcher ──────────────────────────────────────────────────────
+    // Predicts which streamed textures (and down to which mip) the camera will
+    // need over the next kHorizonSeconds, so their tiles can be requested before
+    // sampler feedback sees them (feedback arrives kNumFramesInFlight frames
+    // late and only covers what is already on screen).
+    //
+    // Inputs:
+    //   - camera history: position and yaw/pitch, extrapolated with smoothed
+    //     linear and angular velocity to kNumHorizonSteps future poses,
+    //   - instance bounds: world-space spheres from the CPU instance data,
+    //     tested against a widened view cone at each future pose,
+    //   - per-material texel density: UV units per meter of surface, measured
+    //     from the geometry at load (see PrefetchMaterial).
+    // For each visible instance the required mip is
+    //   log2(texels per meter / pixels per meter at the sphere's nearest point),
+    // the isotropic mip a surface facing the camera would select.
+    //
+    // The predictor is part of HobbyRendererCore: the renderer fills a
+    // PrefetchScene from its textures, materials and instance data, and
+    // ReplayCameraPath() runs it over a recorded camera path and scores it
+    // against the mips the same model says each later pose actually needs (hit
+    // rate and wasted bytes), on any platform.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    // Needed-mip value for textures no pose needs at a standard mip
+    static constexpr uint8_t kPrefetchMipNone = 0xFF;
+
+    struct PrefetchVector3
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+    };
+
+    struct CameraPose
+    {
+        PrefetchVector3 m_Position{};
+        float   m_Yaw   = 0.0f;
+        float   m_Pitch = 0.0f;
+        double  m_Time  = 0.0; // seconds
+    };
+
+    struct PrefetchView
+    {
+        float m_FovY           = std::numbers::pi_v<float> / 4.0f;
+        float m_AspectRatio    = 16.0f / 9.0f;
+        float m_ViewportHeight = 1080.0f;
+        float m_NearZ          = 0.1f;
+    };
+
+    struct PrefetchTexture
+    {
+        uint32_t m_Width              = 0;
+        uint32_t m_Height             = 0;
+        uint32_t m_NumStandardMips    = 0;
+        uint32_t m_TileWidthInTexels  = 0;
+        uint32_t m_TileHeightInTexels = 0;
+    };
+
+    struct PrefetchMaterial
+    {
+        // UV units per meter of mesh-local surface.  0 when unknown (no CPU geometry):
+        // the instance's bounding diameter is assumed to span the [0, 1] UV range.
+        float m_UVDensity = 0.0f;
+        // Indices into PrefetchScene::m_Textures of the streamed textures it samples
+        std::vector<uint32_t> m_Textures;
+    };
+
+    struct PrefetchInstance
+    {
+        PrefetchVector3 m_Center{};           // world space
+        float           m_Radius        = 0.0f;
+        float           m_WorldScale    = 1.0f; // largest axis scale of the world transform
+        uint32_t        m_MaterialIndex = UINT32_MAX;
+    };
+
+    // m_WorldScale of a row-major world matrix (row vectors, as DirectX::XMFLOAT4X4)
+    float GetPrefetchWorldScale(const float (&world)[4][4]);
+
+    // UV units per mesh-local meter of a set of triangles, area weighted:
+    // sqrt(sum of UV areas / sum of surface areas).  A material's m_UVDensity is
+    // measured by adding (a sample of) the triangles of every primitive using it.
+    class TexelDensityEstimator
+    {
+    public:
+        void AddTriangle(const PrefetchVector3 (&positions)[3], const float (&uvs)[3][2]);
+
+        // 0 without a triangle of non-zero surface and UV area
+        float GetUVDensity() const;
+
+    private:
+        double m_UVArea      = 0.0;
+        double m_SurfaceArea = 0.0;
+    };
+
+    struct PrefetchScene
+    {
+        std::vector<PrefetchTexture>  m_Textures;
+        std::vector<PrefetchMaterial> m_Materials;
+        std::vector<PrefetchInstance> m_Instances;
+    };
+
+    // Finest mip every texture needs when seen from pose.  outMips is resized to the
+    // texture count and min-combined into, so several poses can accumulate.
+    void AccumulateNeededMips(const PrefetchScene& scene, const PrefetchView& view, const CameraPose& pose, std::vector<uint8_t>& outMips);
+
+    // Bytes of the standard tiles of mips [firstMip, numStandardMips).
+    uint64_t GetPrefetchBytes(const PrefetchTexture& texture, uint8_t firstMip);
+    // Number of standard tiles of mips [firstMip, numStandardMips).
+    uint32_t GetPrefetchTileCount(const PrefetchTexture& texture, uint8_t firstMip);
+
+    class TilePrefetcher
+    {
+    public:
+        static constexpr float    kHorizonSeconds  = 0.5f;
+        static constexpr uint32_t kNumHorizonSteps = 5;
+        // Exponential smoothing of the velocity estimate (weight of the newest sample)
+        static constexpr float    kVelocitySmoothing = 0.5f;
+        // Samples further apart than this restart the velocity estimate (teleport, hitch)
+        static constexpr double   kMaxSampleGapSeconds = 0.25;
+
+        void AddCameraSample(const CameraPose& pose);
+        void ResetHistory();
+
+        // Pose dt seconds after the newest sample.  Returns false without history.
+        bool Extrapolate(float dt, CameraPose& outPose) const;
+
+        // Finest mip per texture needed by the extrapolated poses over the horizon
+        // (the current pose excluded: feedback already covers it).
+        void Predict(const PrefetchScene& scene, const PrefetchView& view, std::vector<uint8_t>& outMips) const;
+
+        bool HasVelocity() const { return m_NumSamples >= 2; }
+
+    private:
+        CameraPose      m_Last;
+        PrefetchVector3 m_Velocity{};
+        float           m_YawRate   = 0.0f;
+        float           m_PitchRate = 0.0f;
+        uint32_t        m_NumSamples = 0;
+    };
+
+    // ─── Camera path replay ──────────────────────────────────────────────────
+    // For every sample of a recorded path the prefetcher (fed with the path up to
+    // that sample) predicts, and the prediction is compared with the mips the
+    // following kHorizonSeconds of the path need.  Only tiles the current pose does
+    // not already need count: those are the ones feedback would fetch too late.
+    //   hit rate     = predicted needed bytes / needed bytes
+    //   wasted bytes = predicted bytes the horizon never needs
+
+    struct PrefetchReplayStats
+    {
+        uint32_t m_NumSamples     = 0;
+        uint64_t m_NeededBytes    = 0;
+        uint64_t m_PredictedBytes = 0;
+        uint64_t m_HitBytes       = 0;
+        uint64_t m_WastedBytes    = 0;
+
+        double GetHitRate() const   { return m_NeededBytes    > 0 ? (double)m_HitBytes    / (double)m_NeededBytes    : 1.0; }
+        double GetWasteRate() const { return m_PredictedBytes > 0 ? (double)m_WastedBytes / (double)m_PredictedBytes : 0.0; }
+    };
+
+    PrefetchReplayStats ReplayCameraPath(const PrefetchScene& scene, const PrefetchView& view, std::span<const CameraPose> path);
+
+    // Text format, one pose per line: "time x y z yaw pitch"
+    bool SaveCameraPath(const std::filesystem::path& filePath, std::span<const CameraPose> path);
+    bool LoadCameraPath(const std::filesystem::path& filePath, std::vector<CameraPose>& outPath);
+
+} // namespace nvfeedback
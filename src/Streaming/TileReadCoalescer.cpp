@@ -0,0 +1,102 @@
+#include "TileReadCoalescer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+namespace nvfeedback
+{
+    TileRowLayout GetLinearTileRowLayout(size_t mipOffset, uint32_t mipWidth, uint32_t xInTexels, uint32_t yInTexels,
+                                         uint32_t widthInTexels, uint32_t heightInTexels, uint32_t blockSize, uint32_t bytesPerBlock)
+    {
+        const uint32_t blocksPerRow = DivideAndRoundUp(mipWidth, blockSize);
+        const uint32_t srcBlockX    = xInTexels / blockSize;
+        const uint32_t srcBlockY    = yInTexels / blockSize;
+
+        TileRowLayout layout;
+        layout.m_RowBytes = DivideAndRoundUp(widthInTexels, blockSize) * bytesPerBlock;
+        layout.m_NumRows  = DivideAndRoundUp(heightInTexels, blockSize);
+
+        assert(srcBlockX * bytesPerBlock + layout.m_RowBytes <= blocksPerRow * bytesPerBlock);
+
+        layout.m_RowPitch       = blocksPerRow * bytesPerBlock;
+        layout.m_FirstRowOffset = mipOffset + (size_t)srcBlockY * layout.m_RowPitch + (size_t)srcBlockX * bytesPerBlock;
+        layout.m_StoredSize     = layout.m_RowBytes * layout.m_NumRows;
+        return layout;
+    }
+
+    void AppendTileReadSpans(const MemoryMappedDataReader* source, const TileRowLayout& layout, uint32_t dstRowPitch,
+                             uint32_t batchIndex, std::vector<TileReadSpan>& spans)
+    {
+        assert(layout.m_NumRows > 0 && layout.m_RowBytes > 0);
+
+        if (layout.IsCompressed())
+        {
+            TileReadSpan& span = spans.emplace_back();
+            span.m_Source      = source;
+            span.m_SrcOffset   = layout.m_FirstRowOffset;
+            span.m_Size        = layout.m_StoredSize;
+            span.m_BatchIndex  = batchIndex;
+            span.m_bCompressed = true;
+            return;
+        }
+
+        for (uint32_t row = 0; row < layout.m_NumRows; row++)
+        {
+            TileReadSpan& span  = spans.emplace_back();
+            span.m_Source       = source;
+            span.m_SrcOffset    = layout.m_FirstRowOffset + (size_t)row * layout.m_RowPitch;
+            span.m_Size         = layout.m_RowBytes;
+            span.m_BatchIndex   = batchIndex;
+            span.m_DstOffset    = row * dstRowPitch;
+            span.m_PackedOffset = row * layout.m_RowBytes;
+        }
+    }
+
+    void CoalesceTileReads(std::vector<TileReadSpan>& spans, size_t maxGapBytes, size_t maxReadBytes, std::vector<TileRead>& outReads)
+    {
+        outReads.clear();
+
+        // ── Sort by file position so neighbouring rows (and tiles) become one read ──
+        std::sort(spans.begin(), spans.end(), [](const TileReadSpan& a, const TileReadSpan& b)
+        {
+            if (a.m_Source != b.m_Source)
+                return std::less<const MemoryMappedDataReader*>{}(a.m_Source, b.m_Source);
+            return a.m_SrcOffset < b.m_SrcOffset;
+        });
+
+        // ── Merge while the gap and the read size allow ──
+        size_t first = 0;
+        while (first < spans.size())
+        {
+            const MemoryMappedDataReader* source = spans[first].m_Source;
+            const size_t readBegin = spans[first].m_SrcOffset;
+            size_t readEnd = readBegin + spans[first].m_Size;
+
+            size_t last = first + 1;
+            while (last < spans.size())
+            {
+                const TileReadSpan& next = spans[last];
+                const size_t nextEnd = std::max(readEnd, next.m_SrcOffset + next.m_Size);
+                if (next.m_Source != source ||
+                    next.m_SrcOffset > readEnd + maxGapBytes ||
+                    nextEnd - readBegin > maxReadBytes)
+                {
+                    break;
+                }
+                readEnd = nextEnd;
+                last++;
+            }
+
+            TileRead& read   = outReads.emplace_back();
+            read.m_Source    = source;
+            read.m_Offset    = readBegin;
+            read.m_Size      = readEnd - readBegin;
+            read.m_FirstSpan = (uint32_t)first;
+            read.m_EndSpan   = (uint32_t)last;
+
+            first = last;
+        }
+    }
+
+} // namespace nvfeedback
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class MemoryMappedDataReader;
+
+namespace nvfeedback
+{
+    // ─── Tile source reads ───────────────────────────────────────────────────
+    // Where a tile's bytes live in its source file, and how the ExplicitRead
+    // backend of AsyncTileIO (and TileIOBench) turns a batch of tiles into a
+    // few large positional reads:
+    //   1. AppendTileReadSpans() adds one span per tile row, or one for a tile
+    //      stored contiguously (.tdds),
+    //   2. CoalesceTileReads() sorts the spans by source and offset and merges
+    //      neighbours at most maxGapBytes apart into reads of at most
+    //      maxReadBytes (a single span larger than that is read on its own).
+    //      Every span lands in exactly one read.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    // Spans closer than this are merged into one read; matches the page size the
+    // mmap path would have faulted in anyway.
+    constexpr size_t kTileReadMaxGapBytes = 4 * 1024;
+    // Upper bound for a single merged read (bounds the per-worker read buffer).
+    constexpr size_t kTileReadMaxBytes    = 4 * 1024 * 1024;
+
+    // Source byte layout of one tile: numRows rows of rowBytes each, starting at
+    // firstRowOffset (relative to the source data) and rowPitch bytes apart.
+    // .tdds tiles are stored with rowPitch == rowBytes; a compressed one is
+    // m_StoredSize bytes at firstRowOffset that decode to those rows.
+    struct TileRowLayout
+    {
+        size_t   m_FirstRowOffset = 0;
+        uint32_t m_RowPitch       = 0;
+        uint32_t m_RowBytes       = 0;
+        uint32_t m_NumRows        = 0;
+        uint32_t m_StoredSize     = 0;
+
+        bool IsCompressed() const { return m_StoredSize < m_RowBytes * m_NumRows; }
+    };
+
+    // A tile of a linear (DDS) mip starting at mipOffset.  blockSize is 4 for BC
+    // formats, 1 for uncompressed ones.
+    TileRowLayout GetLinearTileRowLayout(size_t mipOffset, uint32_t mipWidth, uint32_t xInTexels, uint32_t yInTexels,
+                                         uint32_t widthInTexels, uint32_t heightInTexels, uint32_t blockSize, uint32_t bytesPerBlock);
+
+    // One tile row: a contiguous byte range in the source and its place in the tile buffer.
+    // A compressed .tdds tile is a single span holding the whole stored tile.
+    struct TileReadSpan
+    {
+        const MemoryMappedDataReader* m_Source = nullptr;
+        size_t   m_SrcOffset    = 0;  // relative to m_Source->GetData()
+        uint32_t m_Size         = 0;
+        uint32_t m_BatchIndex   = 0;  // the caller's tile index
+        uint32_t m_DstOffset    = 0;  // offset within the tile destination
+        uint32_t m_PackedOffset = 0;  // offset within the packed tile (rows rowBytes apart)
+        bool     m_bCompressed  = false;
+    };
+
+    // Spans [m_FirstSpan, m_EndSpan) of the sorted span list, all inside
+    // [m_Offset, m_Offset + m_Size) of m_Source.
+    struct TileRead
+    {
+        const MemoryMappedDataReader* m_Source = nullptr;
+        size_t   m_Offset    = 0;
+        size_t   m_Size      = 0;
+        uint32_t m_FirstSpan = 0;
+        uint32_t m_EndSpan   = 0;
+    };
+
+    // Rows land dstRowPitch apart in the tile destination.
+    void AppendTileReadSpans(const MemoryMappedDataReader* source, const TileRowLayout& layout, uint32_t dstRowPitch,
+                             uint32_t batchIndex, std::vector<TileReadSpan>& spans);
+
+    // Sorts spans in place and replaces outReads.
+    void CoalesceTileReads(std::vector<TileReadSpan>& spans, size_t maxGapBytes, size_t maxReadBytes, std::vector<TileRead>& outReads);
+
+} // namespace nvfeedback
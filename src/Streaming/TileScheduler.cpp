@@ -0,0 +1,257 @@
+#include "TileScheduler.h"
+
+#include <algorithm>
+
+namespace nvfeedback
+{
+    float TileScheduler::ComputePriority(const TilePriorityInputs& inputs)
+    {
+        const float age = (float)std::min(inputs.m_AgeFrames, kAgeSaturationFrames) / (float)kAgeSaturationFrames;
+
+        if (inputs.m_bStale)
+            return kAgeWeight * age * kStaleScale;
+        if (inputs.m_bPrefetched)
+            return kAgeWeight * age * kPrefetchScale;
+
+        const float coverage    = std::clamp(inputs.m_Coverage, 0.0f, 1.0f);
+        const float mipDistance = (float)std::min(inputs.m_MipDistance, kMaxMipDistance) / (float)kMaxMipDistance;
+
+        return kCoverageWeight * coverage + kMipDistanceWeight * mipDistance + kAgeWeight * age;
+    }
+
+    TilePriorityInputs ComputeTilePriorityInputs(const TileFeedbackState& state, uint32_t mip, uint32_t tileX, uint32_t tileY,
+                                                 uint32_t requestFrame, uint32_t frameNumber)
+    {
+        TilePriorityInputs inputs;
+        inputs.m_AgeFrames = frameNumber - requestFrame;
+
+        // Covered by a prediction made no earlier than the request
+        const bool bPrefetched = (mip >= state.m_PrefetchMip) && (state.m_PrefetchFrame >= requestFrame);
+
+        const uint32_t regionsX = state.m_RegionsX;
+        const uint32_t regionsY = state.m_RegionsY;
+        if (regionsX == 0 || regionsY == 0 || state.m_Requested.size() != (size_t)regionsX * regionsY)
+        {
+            inputs.m_bPrefetched = bPrefetched;
+            return inputs;
+        }
+
+        // Tile footprint in mip 0 texels, then in feedback regions
+        const uint32_t x0  = (tileX * state.m_TileWidthInTexels)  << mip;
+        const uint32_t y0  = (tileY * state.m_TileHeightInTexels) << mip;
+        const uint32_t rx0 = std::min(x0 / state.m_RegionWidth,  regionsX - 1);
+        const uint32_t ry0 = std::min(y0 / state.m_RegionHeight, regionsY - 1);
+        const uint32_t rx1 = std::min(((x0 + (state.m_TileWidthInTexels  << mip)) - 1) / state.m_RegionWidth,  regionsX - 1);
+        const uint32_t ry1 = std::min(((y0 + (state.m_TileHeightInTexels << mip)) - 1) / state.m_RegionHeight, regionsY - 1);
+
+        const bool bHasResident = (state.m_Resident.size() == state.m_Requested.size());
+
+        uint32_t numRegions = 0;
+        uint32_t numCovered = 0;
+        for (uint32_t ry = ry0; ry <= ry1; ry++)
+        {
+            for (uint32_t rx = rx0; rx <= rx1; rx++)
+            {
+                const uint32_t region = ry * regionsX + rx;
+                numRegions++;
+
+                const uint8_t requested = state.m_Requested[region];
+                if (requested == 0xFF || requested > mip)
+                    continue;
+
+                numCovered++;
+                const uint32_t resident = bHasResident ? state.m_Resident[region] : state.m_NumStandardMips;
+                if (resident > mip)
+                    inputs.m_MipDistance = std::max(inputs.m_MipDistance, resident - mip);
+            }
+        }
+
+        inputs.m_Coverage = (float)numCovered / (float)numRegions;
+        // Feedback newer than the request no longer samples this tile
+        inputs.m_bStale   = (numCovered == 0) && (state.m_RequestedFrame > requestFrame);
+        // Not on screen yet, but the TilePrefetcher expects it to be
+        if (numCovered == 0 && bPrefetched)
+        {
+            inputs.m_bPrefetched = true;
+            inputs.m_bStale      = false;
+        }
+        return inputs;
+    }
+
+    namespace
+    {
+        // Older requests win ties, so equal-priority tiles keep FIFO order
+        bool IsLessUrgent(const ScheduledTile& a, const ScheduledTile& b)
+        {
+            if (a.m_Priority != b.m_Priority)
+                return a.m_Priority < b.m_Priority;
+            if (a.m_RequestFrame != b.m_RequestFrame)
+                return a.m_RequestFrame > b.m_RequestFrame;
+            return a.m_Sequence > b.m_Sequence;
+        }
+    }
+
+    void TileScheduler::Enqueue(uint32_t textureIdx, const std::vector<uint32_t>& tileIndices, uint32_t frameNumber)
+    {
+        if (textureIdx >= m_TextureTiles.size())
+            m_TextureTiles.resize(textureIdx + 1);
+
+        for (uint32_t tileIndex : tileIndices)
+        {
+            const uint64_t key = MakeKey(textureIdx, tileIndex);
+            PendingTile pending;
+            pending.m_RequestFrame = frameNumber;
+            pending.m_Sequence     = m_NextSequence;
+            if (!m_Pending.emplace(key, pending).second)
+                continue;
+
+            m_NextSequence++;
+            m_TextureTiles[textureIdx].push_back(tileIndex);
+            m_Unscored.push_back(key);
+        }
+    }
+
+    void TileScheduler::Cancel(uint32_t textureIdx, const std::vector<uint32_t>& tileIndices)
+    {
+        for (uint32_t tileIndex : tileIndices)
+            m_NumCancelled += (uint32_t)m_Pending.erase(MakeKey(textureIdx, tileIndex));
+    }
+
+    void TileScheduler::RemoveTexture(uint32_t textureIdx)
+    {
+        if (textureIdx >= m_TextureTiles.size())
+            return;
+
+        for (uint32_t tileIndex : m_TextureTiles[textureIdx])
+            m_NumCancelled += (uint32_t)m_Pending.erase(MakeKey(textureIdx, tileIndex));
+        m_TextureTiles.erase(m_TextureTiles.begin() + textureIdx);
+
+        // Keys embed the texture index: re-key the later textures' tiles and let the
+        // next PopBatch rebuild the heap from scratch
+        std::pmr::unordered_map<uint64_t, PendingTile> pending{ &m_PendingNodes };
+        pending.reserve(m_Pending.size());
+        for (const auto& [key, tile] : m_Pending)
+        {
+            const uint32_t tileTextureIdx = (uint32_t)(key >> 32);
+            pending.emplace(tileTextureIdx > textureIdx ? key - (1ull << 32) : key, tile);
+        }
+        m_Pending = std::move(pending);
+        m_bRescoreAll = true;
+    }
+
+    void TileScheduler::MarkTextureChanged(uint32_t textureIdx)
+    {
+        if (textureIdx >= m_bTextureChanged.size())
+            m_bTextureChanged.resize(textureIdx + 1, 0);
+
+        if (!m_bTextureChanged[textureIdx])
+        {
+            m_bTextureChanged[textureIdx] = 1;
+            m_ChangedTextures.push_back(textureIdx);
+        }
+    }
+
+    void TileScheduler::ScoreAndPush(uint64_t key, PendingTile& pending, PriorityFn priorityFn)
+    {
+        HeapEntry& entry = m_Heap.emplace_back();
+        entry.m_Tile.m_TextureIdx   = (uint32_t)(key >> 32);
+        entry.m_Tile.m_TileIndex    = (uint32_t)key;
+        entry.m_Tile.m_RequestFrame = pending.m_RequestFrame;
+        entry.m_Tile.m_Sequence     = pending.m_Sequence;
+
+        const TilePriorityInputs inputs = priorityFn(entry.m_Tile);
+        entry.m_Tile.m_Priority = ComputePriority(inputs);
+        entry.m_Tile.m_bStale   = inputs.m_bStale;
+        entry.m_Version         = m_NextVersion++;
+        pending.m_Version       = entry.m_Version;
+        m_NumScored++;
+    }
+
+    void TileScheduler::RescoreAll(PriorityFn priorityFn)
+    {
+        m_Heap.clear();
+        for (std::vector<uint32_t>& tiles : m_TextureTiles)
+            tiles.clear();
+
+        for (auto& [key, pending] : m_Pending)
+        {
+            const uint32_t textureIdx = (uint32_t)(key >> 32);
+            if (textureIdx >= m_TextureTiles.size())
+                m_TextureTiles.resize(textureIdx + 1);
+            m_TextureTiles[textureIdx].push_back((uint32_t)key);
+            ScoreAndPush(key, pending, priorityFn);
+        }
+        std::make_heap(m_Heap.begin(), m_Heap.end(), [](const HeapEntry& a, const HeapEntry& b) { return IsLessUrgent(a.m_Tile, b.m_Tile); });
+
+        m_bRescoreAll = false;
+        m_BatchesSinceRescoreAll = 0;
+    }
+
+    void TileScheduler::PopBatch(uint32_t maxTiles, PriorityFn priorityFn, std::pmr::vector<ScheduledTile>& outTiles)
+    {
+        outTiles.clear();
+
+        auto lessUrgent = [](const HeapEntry& a, const HeapEntry& b) { return IsLessUrgent(a.m_Tile, b.m_Tile); };
+
+        // Age moves every tile's priority a little each frame: re-score everything now and
+        // then, and whenever dead entries outnumber the live ones
+        if (m_bRescoreAll || ++m_BatchesSinceRescoreAll >= kFullRescoreInterval || m_Heap.size() > 2 * m_Pending.size() + 64)
+        {
+            RescoreAll(priorityFn);
+        }
+        else
+        {
+            // Coverage and residency changed for these textures' tiles only
+            for (uint32_t textureIdx : m_ChangedTextures)
+            {
+                if (textureIdx >= m_TextureTiles.size())
+                    continue;
+
+                std::vector<uint32_t>& tiles = m_TextureTiles[textureIdx];
+                std::erase_if(tiles, [&](uint32_t tileIndex)
+                {
+                    auto it = m_Pending.find(MakeKey(textureIdx, tileIndex));
+                    if (it == m_Pending.end())
+                        return true;
+                    ScoreAndPush(it->first, it->second, priorityFn);
+                    std::push_heap(m_Heap.begin(), m_Heap.end(), lessUrgent);
+                    return false;
+                });
+            }
+
+            // Tiles of unchanged textures enqueued since the last batch
+            for (uint64_t key : m_Unscored)
+            {
+                auto it = m_Pending.find(key);
+                if (it == m_Pending.end() || it->second.m_Version != 0)
+                    continue;
+                ScoreAndPush(key, it->second, priorityFn);
+                std::push_heap(m_Heap.begin(), m_Heap.end(), lessUrgent);
+            }
+        }
+
+        for (uint32_t textureIdx : m_ChangedTextures)
+            m_bTextureChanged[textureIdx] = 0;
+        m_ChangedTextures.clear();
+        m_Unscored.clear();
+
+        while (!m_Heap.empty() && outTiles.size() < maxTiles)
+        {
+            std::pop_heap(m_Heap.begin(), m_Heap.end(), lessUrgent);
+            const HeapEntry entry = m_Heap.back();
+            m_Heap.pop_back();
+
+            // Cancelled, already popped, or re-scored since this entry was pushed
+            auto it = m_Pending.find(MakeKey(entry.m_Tile.m_TextureIdx, entry.m_Tile.m_TileIndex));
+            if (it == m_Pending.end() || it->second.m_Version != entry.m_Version)
+                continue;
+            m_Pending.erase(it);
+
+            if (entry.m_Tile.m_bStale)
+                m_NumStalePopped++;
+
+            outTiles.push_back(entry.m_Tile);
+        }
+    }
+
+} // namespace nvfeedback
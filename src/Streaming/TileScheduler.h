@@ -0,0 +1,166 @@
+#pragma once
+
+#include "../CoreUtilities.h"
+#include "../InplaceFunction.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace nvfeedback
+{
+    // ─── TileScheduler ───────────────────────────────────────────────────────
+    // Pending standard-tile requests, handed out highest priority first.
+    //
+    // FeedbackManager enqueues the tiles TTM wants mapped, cancels tiles TTM
+    // unmapped before their data arrived, and pops up to m_MaxTilesPerFrame
+    // tiles per frame.  A tile's priority is computed from
+    //   - coverage:     fraction of the tile's feedback regions that the latest
+    //                   sampler feedback says are sampled at this mip or finer
+    //                   (a proxy for on-screen area),
+    //   - mip distance: how many mips coarser than the tile the region is
+    //                   currently resident at (how blurry it looks right now),
+    //   - age:          frames since the request, so nothing starves.
+    // A request is stale when feedback newer than the request no longer covers
+    // the tile (the object left view).  Stale tiles keep only a reduced age
+    // term: they still load eventually, because TTM has already allocated
+    // them, but never ahead of anything visible.
+    // Prefetched tiles (requested by the TilePrefetcher, not yet seen by
+    // feedback) sit between the two: behind every visible tile, ahead of
+    // stale ones.
+    //
+    // The heap persists across frames.  PopBatch() only re-scores the tiles of
+    // textures whose feedback or residency changed (MarkTextureChanged) and
+    // newly enqueued tiles; a re-scored tile is pushed again and its old entry,
+    // like a cancelled tile's, is dropped when it reaches the top.  The age term
+    // of everything else is refreshed by a full re-score every
+    // kFullRescoreInterval batches, so it lags by at most that many frames.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    struct TilePriorityInputs
+    {
+        float    m_Coverage    = 0.0f; // [0, 1]
+        uint32_t m_MipDistance = 0;
+        uint32_t m_AgeFrames   = 0;
+        bool     m_bStale      = false;
+        bool     m_bPrefetched = false; // uncovered, but predicted to be needed soon
+    };
+
+    // Latest feedback of one texture, as ComputeTilePriorityInputs reads it.  Shared
+    // by FeedbackManager and the streaming trace simulator, so both rank tiles alike.
+    struct TileFeedbackState
+    {
+        std::span<const uint8_t> m_Requested;          // finest mip sampled per feedback region (0xFF = not sampled)
+        std::span<const uint8_t> m_Resident;           // finest mip resident per region (empty = none uploaded yet)
+        uint32_t m_RequestedFrame     = 0;
+        uint8_t  m_PrefetchMip        = 0xFF;          // TilePrefetcher request for the whole texture
+        uint32_t m_PrefetchFrame      = 0;
+        uint32_t m_RegionsX           = 0;
+        uint32_t m_RegionsY           = 0;
+        uint32_t m_RegionWidth        = 1;             // texels
+        uint32_t m_RegionHeight       = 1;
+        uint32_t m_TileWidthInTexels  = 0;
+        uint32_t m_TileHeightInTexels = 0;
+        uint32_t m_NumStandardMips    = 0;
+    };
+
+    struct ScheduledTile
+    {
+        uint32_t m_TextureIdx   = UINT32_MAX;
+        uint32_t m_TileIndex    = 0;
+        uint32_t m_RequestFrame = 0;
+        uint32_t m_Sequence     = 0;    // enqueue order; breaks priority ties
+        float    m_Priority     = 0.0f;
+        bool     m_bStale       = false;
+    };
+
+    // Priority inputs of the standard tile (tileX, tileY) of mip, requested in requestFrame.
+    TilePriorityInputs ComputeTilePriorityInputs(const TileFeedbackState& state, uint32_t mip, uint32_t tileX, uint32_t tileY,
+                                                 uint32_t requestFrame, uint32_t frameNumber);
+
+    class TileScheduler
+    {
+    public:
+        static constexpr float    kCoverageWeight       = 4.0f;
+        static constexpr float    kMipDistanceWeight    = 2.0f;
+        static constexpr float    kAgeWeight            = 1.0f;
+        static constexpr float    kStaleScale           = 0.25f;
+        static constexpr float    kPrefetchScale        = 0.5f;
+        static constexpr uint32_t kMaxMipDistance       = 4;   // distance term saturates here
+        static constexpr uint32_t kAgeSaturationFrames  = 60;  // age term saturates here
+        static constexpr uint32_t kFullRescoreInterval  = 8;   // PopBatch calls between full re-scores
+
+        static float ComputePriority(const TilePriorityInputs& inputs);
+
+        // Duplicate (texture, tile) pairs are ignored.
+        void Enqueue(uint32_t textureIdx, const std::vector<uint32_t>& tileIndices, uint32_t frameNumber);
+
+        // Drops pending requests for tiles TTM no longer wants mapped.
+        void Cancel(uint32_t textureIdx, const std::vector<uint32_t>& tileIndices);
+
+        // Drops every pending request for a texture (texture unregistered); the
+        // indices of later textures shift down by one, as in FeedbackManager.
+        void RemoveTexture(uint32_t textureIdx);
+
+        // The priority inputs of the texture's tiles changed (new feedback, prefetch
+        // request or residency); its pending tiles are re-scored by the next PopBatch.
+        void MarkTextureChanged(uint32_t textureIdx);
+
+        // Scores the new and changed tiles through priorityFn, then moves up to maxTiles
+        // of the highest-priority ones into outTiles (in descending priority order).
+        // outTiles may live in a per-frame arena.
+        using PriorityFn = FunctionRef<TilePriorityInputs(const ScheduledTile&)>;
+        void PopBatch(uint32_t maxTiles, PriorityFn priorityFn, std::pmr::vector<ScheduledTile>& outTiles);
+
+        bool     IsEmpty() const          { return m_Pending.empty(); }
+        uint32_t GetNumPending() const    { return (uint32_t)m_Pending.size(); }
+        uint32_t GetNumCancelled() const  { return m_NumCancelled; }
+        uint32_t GetNumStalePopped() const { return m_NumStalePopped; }
+        uint32_t GetNumScored() const     { return m_NumScored; }    // priorityFn calls so far
+
+    private:
+        static uint64_t MakeKey(uint32_t textureIdx, uint32_t tileIndex) { return ((uint64_t)textureIdx << 32) | tileIndex; }
+
+        struct PendingTile
+        {
+            uint32_t m_RequestFrame = 0;
+            uint32_t m_Sequence     = 0;
+            uint32_t m_Version      = 0;    // of the tile's live heap entry; 0 = not scored yet
+        };
+
+        struct HeapEntry
+        {
+            ScheduledTile m_Tile;
+            uint32_t      m_Version = 0;
+        };
+
+        void ScoreAndPush(uint64_t key, PendingTile& pending, PriorityFn priorityFn);
+        void RescoreAll(PriorityFn priorityFn);
+
+        // Heap storage; entries whose version no longer matches m_Pending were
+        // cancelled, popped or re-scored and are dropped lazily.
+        std::vector<HeapEntry>                         m_Heap;
+        // Nodes come from a pool that keeps freed ones, so a warmed-up scheduler
+        // enqueues and pops without touching the heap
+        std::pmr::unsynchronized_pool_resource         m_PendingNodes;
+        std::pmr::unordered_map<uint64_t, PendingTile> m_Pending{ &m_PendingNodes };
+
+        // Pending tiles per texture; cancelled and popped ones are dropped when the
+        // texture is re-scored
+        std::vector<std::vector<uint32_t>> m_TextureTiles;
+        std::vector<uint8_t>               m_bTextureChanged;
+        std::vector<uint32_t>              m_ChangedTextures;
+        std::vector<uint64_t>              m_Unscored;
+        bool                               m_bRescoreAll = false;
+        uint32_t                           m_BatchesSinceRescoreAll = 0;
+
+        uint32_t m_NextSequence   = 0;
+        uint32_t m_NextVersion    = 1;
+        uint32_t m_NumCancelled   = 0;
+        uint32_t m_NumStalePopped = 0;
+        uint32_t m_NumScored      = 0;
+    };
+
+} // namespace nvfeedback
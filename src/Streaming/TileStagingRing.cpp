@@ -0,0 +1,114 @@
+#include "TileStagingRing.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace nvfeedback
+{
+    static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    TileStagingRing::TileStagingRing(uint64_t capacityBytes)
+        : m_Capacity(AlignUp(std::max<uint64_t>(capacityBytes, kPlacementAlignment), kPlacementAlignment))
+    {
+    }
+
+    bool TileStagingRing::Reserve(uint64_t size, Allocation& outAllocation)
+    {
+        assert(size > 0);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (size > m_Capacity)
+        {
+            m_NumFailedReservations.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // An empty ring restarts at the beginning of the buffer so a full-size reservation always fits
+        if (m_NumRecords == 0)
+            m_Head = m_Tail = AlignUp(m_Head, m_Capacity);
+
+        uint64_t begin = AlignUp(m_Head, kPlacementAlignment);
+
+        // Never straddle the end of the buffer: skip to the start of the next lap
+        if ((begin % m_Capacity) + size > m_Capacity)
+            begin = AlignUp(begin, m_Capacity);
+
+        const uint64_t end = begin + size;
+        if (end - m_Tail > m_Capacity)
+        {
+            m_NumFailedReservations.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        m_Head = end;
+        PushRecord(Record{ end, kNotSubmitted });
+
+        outAllocation.m_Offset = begin % m_Capacity;
+        outAllocation.m_Size   = size;
+        outAllocation.m_ID     = m_FirstID + m_NumRecords - 1;
+        return true;
+    }
+
+    void TileStagingRing::PushRecord(const Record& record)
+    {
+        if (m_NumRecords == m_Records.size())
+        {
+            // Full: unroll into a ring twice the size, oldest first
+            std::vector<Record> grown(std::max<size_t>(64, m_Records.size() * 2));
+            for (uint32_t i = 0; i < m_NumRecords; ++i)
+                grown[i] = m_Records[(m_FirstRecord + i) % m_Records.size()];
+            m_Records.swap(grown);
+            m_FirstRecord = 0;
+        }
+
+        m_Records[(m_FirstRecord + m_NumRecords) % m_Records.size()] = record;
+        m_NumRecords++;
+    }
+
+    void TileStagingRing::MarkSubmitted(const Allocation& allocation, uint64_t frameNumber)
+    {
+        assert(allocation.IsValid());
+        assert(frameNumber != kNotSubmitted);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        assert(allocation.m_ID >= m_FirstID && allocation.m_ID - m_FirstID < m_NumRecords && "Allocation already retired");
+        Record& record = GetRecord(allocation.m_ID);
+        assert(record.m_SubmitFrame == kNotSubmitted && "Allocation submitted twice");
+        record.m_SubmitFrame = frameNumber;
+    }
+
+    void TileStagingRing::Retire(uint64_t completedFrameNumber)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        while (m_NumRecords > 0)
+        {
+            const Record& front = m_Records[m_FirstRecord];
+            if (front.m_SubmitFrame == kNotSubmitted || front.m_SubmitFrame > completedFrameNumber)
+                break;
+
+            m_Tail = front.m_End;
+            m_FirstRecord = (m_FirstRecord + 1) % (uint32_t)m_Records.size();
+            m_NumRecords--;
+            m_FirstID++;
+        }
+    }
+
+    uint64_t TileStagingRing::GetUsedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Head - m_Tail;
+    }
+
+    uint32_t TileStagingRing::GetNumLiveAllocations() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_NumRecords;
+    }
+
+} // namespace nvfeedback
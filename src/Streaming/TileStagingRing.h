@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace nvfeedback
+{
+    // ─── TileStagingRing ─────────────────────────────────────────────────────
+    // Allocator for the persistently mapped upload buffer that AsyncTileIO
+    // workers de-tile into directly, so Flush() only has to record a
+    // CopyTextureRegion per tile.
+    //
+    // Allocations are handed out in FIFO order on a byte ring:
+    //   Reserve()       worker threads; returns false when the ring is full
+    //                   (callers fall back to a CPU buffer + writeTexture).
+    //   MarkSubmitted() main thread, once the copy reading the allocation has
+    //                   been recorded.
+    //   Retire()        main thread, with the newest frame whose command lists
+    //                   are known to have finished on the GPU.  Frees every
+    //                   allocation at the head of the ring that was submitted
+    //                   in or before that frame.
+    // An allocation that is reserved but not yet submitted holds back every
+    // allocation behind it; workers complete in roughly FIFO order, so the
+    // stall is at most one frame.
+    //
+    // Offsets are aligned to D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT and never
+    // straddle the end of the buffer.  The ring only hands out offsets; the
+    // buffer itself belongs to AsyncTileIO, which keeps this class platform
+    // neutral (HobbyRendererCore).
+    // ─────────────────────────────────────────────────────────────────────────
+
+    class TileStagingRing
+    {
+    public:
+        static constexpr uint64_t kPlacementAlignment = 512; // D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+        static constexpr uint32_t kRowPitchAlignment  = 256; // D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+        static constexpr uint64_t kNotSubmitted       = UINT64_MAX;
+
+        struct Allocation
+        {
+            uint64_t m_Offset = 0;  // byte offset within the buffer
+            uint64_t m_Size   = 0;
+            uint64_t m_ID     = UINT64_MAX;
+
+            bool IsValid() const { return m_ID != UINT64_MAX; }
+        };
+
+        // capacityBytes is rounded up to kPlacementAlignment.
+        explicit TileStagingRing(uint64_t capacityBytes);
+
+        TileStagingRing(const TileStagingRing&) = delete;
+        TileStagingRing& operator=(const TileStagingRing&) = delete;
+
+        // Thread-safe.
+        bool Reserve(uint64_t size, Allocation& outAllocation);
+        void MarkSubmitted(const Allocation& allocation, uint64_t frameNumber);
+        void Retire(uint64_t completedFrameNumber);
+
+        uint64_t GetCapacity() const { return m_Capacity; }
+        uint64_t GetUsedBytes() const;
+        uint32_t GetNumLiveAllocations() const;
+        uint64_t GetNumFailedReservations() const { return m_NumFailedReservations.load(std::memory_order_relaxed); }
+
+    private:
+        struct Record
+        {
+            uint64_t m_End         = 0;              // virtual end offset (monotonic)
+            uint64_t m_SubmitFrame = kNotSubmitted;
+        };
+
+        Record& GetRecord(uint64_t id) { return m_Records[(m_FirstRecord + (id - m_FirstID)) % m_Records.size()]; }
+        void PushRecord(const Record& record);
+
+        const uint64_t m_Capacity;
+
+        // Virtual offsets grow monotonically; physical offset = virtual % m_Capacity.
+        uint64_t            m_Head    = 0;  // next free byte
+        uint64_t            m_Tail    = 0;  // oldest live byte
+        uint64_t            m_FirstID = 0;  // ID of the oldest live record
+        // Live records, oldest at m_FirstRecord; a ring that only grows (to the most
+        // allocations ever live at once), so a warmed-up ring never touches the heap
+        std::vector<Record> m_Records;
+        uint32_t            m_FirstRecord = 0;
+        uint32_t            m_NumRecords  = 0;
+        mutable std::mutex  m_Mutex;
+
+        std::atomic<uint64_t> m_NumFailedReservations{ 0 };
+    };
+
+} // namespace nvfeedback
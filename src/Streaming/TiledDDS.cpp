@@ -0,0 +1,586 @@
+#include "TiledDDS.h"
+#include "../Log.h"
+#include "../TextureLoader.h"
+
+#include <lz4.h>
+#include <lz4hc.h>
+#include <zstd.h>
+
+namespace nvfeedback
+{
+    // ─── Helpers ─────────────────────────────────────────────────────────────
+
+    static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    static bool IsTiledDDSCompatible(const nvrhi::TextureDesc& desc)
+    {
+        return desc.dimension == nvrhi::TextureDimension::Texture2D &&
+               desc.arraySize == 1 && desc.depth == 1 &&
+               desc.mipLevels >= 1 && desc.mipLevels <= srrhi::CommonConsts::MAX_MIP_COUNT;
+    }
+
+    // Leading mips that hold at least one whole tile.  Smaller mips are packed.
+    static uint32_t ComputeNumStandardMips(const nvrhi::TextureDesc& desc, uint32_t tileWidth, uint32_t tileHeight)
+    {
+        uint32_t numStandardMips = 0;
+        while (numStandardMips < desc.mipLevels &&
+               std::max(desc.width  >> numStandardMips, 1u) >= tileWidth &&
+               std::max(desc.height >> numStandardMips, 1u) >= tileHeight)
+        {
+            numStandardMips++;
+        }
+        return numStandardMips;
+    }
+
+    // Fills m_FirstTileOfMip / m_TilesXOfMip and returns the total number of standard tiles.
+    static uint32_t BuildTileGrid(const nvrhi::TextureDesc& desc, TiledDDSLayout& layout)
+    {
+        uint32_t numTiles = 0;
+        for (uint32_t mip = 0; mip < layout.m_NumStandardMips; mip++)
+        {
+            const uint32_t mipWidth  = std::max(desc.width  >> mip, 1u);
+            const uint32_t mipHeight = std::max(desc.height >> mip, 1u);
+            const uint32_t tilesX = (mipWidth  + layout.m_TileWidthInTexels  - 1) / layout.m_TileWidthInTexels;
+            const uint32_t tilesY = (mipHeight + layout.m_TileHeightInTexels - 1) / layout.m_TileHeightInTexels;
+
+            layout.m_FirstTileOfMip[mip] = numTiles;
+            layout.m_TilesXOfMip[mip]    = tilesX;
+            numTiles += tilesX * tilesY;
+        }
+        return numTiles;
+    }
+
+    // Block footprint of one standard tile, clipped to its mip (same clipping as FeedbackTexture::GetTileInfo).
+    struct TileExtent
+    {
+        uint32_t m_BlockX   = 0;
+        uint32_t m_BlockY   = 0;
+        uint32_t m_RowBytes = 0;
+        uint32_t m_NumRows  = 0;
+    };
+
+    static TileExtent GetTileExtent(const nvrhi::TextureDesc& desc, const nvrhi::FormatInfo& fmtInfo, const TiledDDSLayout& layout,
+                                    uint32_t mip, uint32_t tileX, uint32_t tileY)
+    {
+        const uint32_t mipBlocksW  = (std::max(desc.width  >> mip, 1u) + fmtInfo.blockSize - 1) / fmtInfo.blockSize;
+        const uint32_t mipBlocksH  = (std::max(desc.height >> mip, 1u) + fmtInfo.blockSize - 1) / fmtInfo.blockSize;
+        const uint32_t tileBlocksW = layout.m_TileWidthInTexels  / fmtInfo.blockSize;
+        const uint32_t tileBlocksH = layout.m_TileHeightInTexels / fmtInfo.blockSize;
+
+        TileExtent extent;
+        extent.m_BlockX   = tileX * tileBlocksW;
+        extent.m_BlockY   = tileY * tileBlocksH;
+        extent.m_RowBytes = std::min(tileBlocksW, mipBlocksW - extent.m_BlockX) * fmtInfo.bytesPerBlock;
+        extent.m_NumRows  = std::min(tileBlocksH, mipBlocksH - extent.m_BlockY);
+        return extent;
+    }
+
+    // Byte size of mips [firstMip, mipLevels) in linear DDS layout.
+    static uint64_t GetLinearSize(const nvrhi::TextureDesc& desc, const size_t mipOffsets[srrhi::CommonConsts::MAX_MIP_COUNT], uint32_t firstMip)
+    {
+        if (firstMip >= desc.mipLevels)
+            return 0;
+
+        const nvrhi::FormatInfo& fmtInfo = nvrhi::getFormatInfo(desc.format);
+        const uint32_t lastMip = desc.mipLevels - 1;
+        const uint32_t blocksW = (std::max(desc.width  >> lastMip, 1u) + fmtInfo.blockSize - 1) / fmtInfo.blockSize;
+        const uint32_t blocksH = (std::max(desc.height >> lastMip, 1u) + fmtInfo.blockSize - 1) / fmtInfo.blockSize;
+        const uint64_t end = mipOffsets[lastMip] + (uint64_t)blocksW * blocksH * fmtInfo.bytesPerBlock;
+        return end - mipOffsets[firstMip];
+    }
+
+    // Compresses one tile into outStored.  Returns false when the codec did not make it
+    // smaller, in which case the tile is stored raw.
+    static bool CompressTile(TiledDDSCompression compression, const std::vector<uint8_t>& tile, std::vector<uint8_t>& outStored)
+    {
+        switch (compression)
+        {
+        case TiledDDSCompression::LZ4:
+        {
+            outStored.resize(LZ4_compressBound((int)tile.size()));
+            const int size = LZ4_compress_HC(reinterpret_cast<const char*>(tile.data()), reinterpret_cast<char*>(outStored.data()),
+                                             (int)tile.size(), (int)outStored.size(), kTiledDDSLZ4HCLevel);
+            if (size <= 0 || (size_t)size >= tile.size())
+                return false;
+            outStored.resize(size);
+            return true;
+        }
+        case TiledDDSCompression::Zstd:
+        {
+            outStored.resize(ZSTD_compressBound(tile.size()));
+            const size_t size = ZSTD_compress(outStored.data(), outStored.size(), tile.data(), tile.size(), kTiledDDSZstdLevel);
+            if (ZSTD_isError(size) || size >= tile.size())
+                return false;
+            outStored.resize(size);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    static void WritePadding(std::ostream& os, uint64_t& written, uint64_t target)
+    {
+        static const char kZeros[kTiledDDSTileAlignment] = {};
+        while (written < target)
+        {
+            const uint64_t count = std::min<uint64_t>(target - written, sizeof(kZeros));
+            os.write(kZeros, (std::streamsize)count);
+            written += count;
+        }
+    }
+
+    // ─── TiledDDSLayout ──────────────────────────────────────────────────────
+
+    const TiledDDSTile* TiledDDSLayout::FindTile(uint32_t mip, uint32_t xInTexels, uint32_t yInTexels) const
+    {
+        if (mip >= m_NumStandardMips)
+            return nullptr;
+
+        const uint32_t tileX = xInTexels / m_TileWidthInTexels;
+        const uint32_t tileY = yInTexels / m_TileHeightInTexels;
+        if (tileX >= m_TilesXOfMip[mip])
+            return nullptr;
+
+        const uint32_t tileIndex = m_FirstTileOfMip[mip] + tileY * m_TilesXOfMip[mip] + tileX;
+        const uint32_t endIndex  = (mip + 1 < m_NumStandardMips) ? m_FirstTileOfMip[mip + 1] : (uint32_t)m_Tiles.size();
+        return (tileIndex < endIndex) ? &m_Tiles[tileIndex] : nullptr;
+    }
+
+    // ─── Compression ─────────────────────────────────────────────────────────
+
+    const char* GetTiledDDSCompressionName(TiledDDSCompression compression)
+    {
+        switch (compression)
+        {
+        case TiledDDSCompression::None: return "none";
+        case TiledDDSCompression::LZ4:  return "lz4";
+        case TiledDDSCompression::Zstd: return "zstd";
+        }
+        return "unknown";
+    }
+
+    bool DecompressTiledDDSTile(TiledDDSCompression compression, const void* src, size_t srcSize, void* dst, size_t dstSize)
+    {
+        switch (compression)
+        {
+        case TiledDDSCompression::LZ4:
+        {
+            const int size = LZ4_decompress_safe(static_cast<const char*>(src), static_cast<char*>(dst), (int)srcSize, (int)dstSize);
+            return size >= 0 && (size_t)size == dstSize;
+        }
+        case TiledDDSCompression::Zstd:
+        {
+            // One decompression context per I/O worker, reused across tiles
+            static thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> s_DCtx{ ZSTD_createDCtx(), &ZSTD_freeDCtx };
+            if (!s_DCtx)
+                return false;
+            const size_t size = ZSTD_decompressDCtx(s_DCtx.get(), dst, dstSize, src, srcSize);
+            return !ZSTD_isError(size) && size == dstSize;
+        }
+        default:
+            return false;
+        }
+    }
+
+    // ─── Cooking ─────────────────────────────────────────────────────────────
+
+    bool GetStandardTileShape(uint32_t bytesPerBlock, uint32_t blockSize, uint32_t& outWidth, uint32_t& outHeight)
+    {
+        // 64 KB standard tile shapes, in elements (texels, or blocks for BC formats)
+        switch (bytesPerBlock)
+        {
+        case 1:  outWidth = 256; outHeight = 256; break;
+        case 2:  outWidth = 256; outHeight = 128; break;
+        case 4:  outWidth = 128; outHeight = 128; break;
+        case 8:  outWidth = 128; outHeight = 64;  break;
+        case 16: outWidth = 64;  outHeight = 64;  break;
+        default: return false;
+        }
+
+        outWidth  *= blockSize;
+        outHeight *= blockSize;
+        return true;
+    }
+
+    bool CookTiledDDS(const std::filesystem::path& ddsPath, const std::filesystem::path& tddsPath, TiledDDSCompression compression)
+    {
+        PROFILE_FUNCTION();
+
+        MemoryMappedDataReader source(ddsPath.string(), MemoryMappedDataReader::AccessHint::Sequential);
+        if (!source.IsValid())
+        {
+            LOG_ERROR("[TiledDDS] Cannot map source DDS: %s", ddsPath.string().c_str());
+            return false;
+        }
+
+        const uint8_t* file   = static_cast<const uint8_t*>(source.GetData());
+        const size_t fileSize = source.GetSize();
+
+        nvrhi::TextureDesc desc;
+        const size_t pixelOffset = ParseDDSHeader(file, fileSize, desc);
+        if (pixelOffset == 0 || !IsTiledDDSCompatible(desc))
+        {
+            LOG_WARN("[TiledDDS] Unsupported DDS (2D single-slice textures only): %s", ddsPath.string().c_str());
+            return false;
+        }
+
+        size_t mipOffsets[srrhi::CommonConsts::MAX_MIP_COUNT];
+        ComputeDDSMipOffsets(desc, mipOffsets);
+        if (!ValidateDDSMipOffsets(desc, mipOffsets, fileSize - pixelOffset))
+        {
+            LOG_ERROR("[TiledDDS] DDS pixel data size mismatch: %s", ddsPath.string().c_str());
+            return false;
+        }
+
+        const nvrhi::FormatInfo& fmtInfo = nvrhi::getFormatInfo(desc.format);
+
+        TiledDDSLayout layout;
+        if (!GetStandardTileShape(fmtInfo.bytesPerBlock, fmtInfo.blockSize, layout.m_TileWidthInTexels, layout.m_TileHeightInTexels))
+        {
+            LOG_WARN("[TiledDDS] No standard tile shape for %s: %s", fmtInfo.name, ddsPath.string().c_str());
+            return false;
+        }
+
+        layout.m_NumStandardMips = ComputeNumStandardMips(desc, layout.m_TileWidthInTexels, layout.m_TileHeightInTexels);
+        if (layout.m_NumStandardMips == 0)
+        {
+            LOG_INFO("[TiledDDS] Texture is smaller than one tile, nothing to cook: %s", ddsPath.string().c_str());
+            return false;
+        }
+
+        layout.m_Tiles.resize(BuildTileGrid(desc, layout));
+
+        // ── Header; tile offsets and sizes are only known once every tile is compressed ──
+        TiledDDSHeader header;
+        header.m_TileWidthInTexels  = layout.m_TileWidthInTexels;
+        header.m_TileHeightInTexels = layout.m_TileHeightInTexels;
+        header.m_NumStandardMips    = layout.m_NumStandardMips;
+        header.m_NumTiles           = (uint32_t)layout.m_Tiles.size();
+        header.m_DDSHeaderSize      = (uint32_t)pixelOffset;
+        header.m_Compression        = (uint32_t)compression;
+        header.m_TileTableOffset    = sizeof(TiledDDSHeader) + pixelOffset;
+        header.m_PackedMipSize      = GetLinearSize(desc, mipOffsets, layout.m_NumStandardMips);
+
+        // ── Write to a temporary file, then move it into place ──
+        std::filesystem::path tempPath = tddsPath;
+        tempPath += ".tmp";
+
+        uint64_t rawTileBytes    = 0;
+        uint64_t storedTileBytes = 0;
+        uint32_t numCompressedTiles = 0;
+        {
+            std::ofstream os(tempPath, std::ios::binary | std::ios::trunc);
+            if (!os)
+            {
+                LOG_ERROR("[TiledDDS] Failed to open for writing: %s", tempPath.string().c_str());
+                return false;
+            }
+
+            // Header and tile table are rewritten below with the final offsets
+            uint64_t written = 0;
+            os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            os.write(reinterpret_cast<const char*>(file), (std::streamsize)pixelOffset);
+            os.write(reinterpret_cast<const char*>(layout.m_Tiles.data()), (std::streamsize)(layout.m_Tiles.size() * sizeof(TiledDDSTile)));
+            written = header.m_TileTableOffset + layout.m_Tiles.size() * sizeof(TiledDDSTile);
+
+            std::vector<uint8_t> tileBytes;
+            std::vector<uint8_t> compressed;
+
+            const uint8_t* pixels = file + pixelOffset;
+            for (uint32_t mip = 0; mip < layout.m_NumStandardMips; mip++)
+            {
+                const uint32_t mipBlocksW = (std::max(desc.width >> mip, 1u) + fmtInfo.blockSize - 1) / fmtInfo.blockSize;
+                const size_t   rowPitch   = (size_t)mipBlocksW * fmtInfo.bytesPerBlock;
+
+                const uint32_t firstTile = layout.m_FirstTileOfMip[mip];
+                const uint32_t endTile   = (mip + 1 < layout.m_NumStandardMips) ? layout.m_FirstTileOfMip[mip + 1] : header.m_NumTiles;
+                for (uint32_t t = firstTile; t < endTile; t++)
+                {
+                    const uint32_t local = t - firstTile;
+                    const TileExtent extent = GetTileExtent(desc, fmtInfo, layout, mip, local % layout.m_TilesXOfMip[mip], local / layout.m_TilesXOfMip[mip]);
+
+                    tileBytes.resize((size_t)extent.m_RowBytes * extent.m_NumRows);
+                    for (uint32_t row = 0; row < extent.m_NumRows; row++)
+                    {
+                        const uint8_t* src = pixels + mipOffsets[mip] + (extent.m_BlockY + row) * rowPitch + (size_t)extent.m_BlockX * fmtInfo.bytesPerBlock;
+                        memcpy(tileBytes.data() + (size_t)row * extent.m_RowBytes, src, extent.m_RowBytes);
+                    }
+
+                    const bool bCompressed = CompressTile(compression, tileBytes, compressed);
+                    const std::vector<uint8_t>& stored = bCompressed ? compressed : tileBytes;
+
+                    TiledDDSTile& tile = layout.m_Tiles[t];
+                    tile.m_Offset     = AlignUp(written, kTiledDDSTileAlignment);
+                    tile.m_Size       = (uint32_t)tileBytes.size();
+                    tile.m_StoredSize = (uint32_t)stored.size();
+
+                    WritePadding(os, written, tile.m_Offset);
+                    os.write(reinterpret_cast<const char*>(stored.data()), (std::streamsize)stored.size());
+                    written += stored.size();
+
+                    rawTileBytes    += tile.m_Size;
+                    storedTileBytes += tile.m_StoredSize;
+                    numCompressedTiles += bCompressed ? 1 : 0;
+                }
+            }
+
+            header.m_PackedMipOffset = AlignUp(written, kTiledDDSTileAlignment);
+            header.m_FileSize        = header.m_PackedMipOffset + header.m_PackedMipSize;
+
+            WritePadding(os, written, header.m_PackedMipOffset);
+            if (header.m_PackedMipSize > 0)
+                os.write(reinterpret_cast<const char*>(pixels + mipOffsets[layout.m_NumStandardMips]), (std::streamsize)header.m_PackedMipSize);
+
+            os.seekp(0);
+            os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            os.seekp((std::streamoff)header.m_TileTableOffset);
+            os.write(reinterpret_cast<const char*>(layout.m_Tiles.data()), (std::streamsize)(layout.m_Tiles.size() * sizeof(TiledDDSTile)));
+
+            if (!os)
+            {
+                LOG_ERROR("[TiledDDS] Write error: %s", tempPath.string().c_str());
+                os.close();
+                std::error_code ec;
+                std::filesystem::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, tddsPath, ec);
+        if (ec)
+        {
+            LOG_ERROR("[TiledDDS] Failed to move %s into place: %s", tddsPath.string().c_str(), ec.message().c_str());
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        LOG_INFO("[TiledDDS] Cooked %s (%u tiles, %u standard mips, %.2f MB -> %.2f MB, %s: %u/%u tiles compressed, tile data %.2f MB -> %.2f MB)",
+                 tddsPath.string().c_str(), header.m_NumTiles, header.m_NumStandardMips,
+                 BYTES_TO_MB(fileSize), BYTES_TO_MB(header.m_FileSize),
+                 GetTiledDDSCompressionName(compression), numCompressedTiles, header.m_NumTiles,
+                 BYTES_TO_MB(rawTileBytes), BYTES_TO_MB(storedTileBytes));
+        return true;
+    }
+
+    // ─── Loading ─────────────────────────────────────────────────────────────
+
+    bool ReadTiledDDSHeader(const std::filesystem::path& tddsPath, TiledDDSHeader& outHeader)
+    {
+        std::ifstream is(tddsPath, std::ios::binary);
+        if (!is.read(reinterpret_cast<char*>(&outHeader), sizeof(outHeader)))
+            return false;
+
+        return outHeader.m_Magic == kTiledDDSMagic && outHeader.m_Version == kTiledDDSVersion;
+    }
+
+    bool LoadTiledDDS(std::string_view filePath, nvrhi::TextureDesc& desc, std::unique_ptr<MemoryMappedDataReader>& data,
+                      std::shared_ptr<const TiledDDSLayout>& outLayout, size_t outMipOffsets[srrhi::CommonConsts::MAX_MIP_COUNT])
+    {
+        // Tiles are read one at a time in feedback order: no read-ahead
+        std::unique_ptr<MemoryMappedDataReader> mapped = std::make_unique<MemoryMappedDataReader>(filePath, MemoryMappedDataReader::AccessHint::Random);
+        if (!mapped->IsValid())
+        {
+            LOG_ERROR("[TiledDDS] Cannot map file: %s", std::string(filePath).c_str());
+            return false;
+        }
+
+        const uint8_t* file   = static_cast<const uint8_t*>(mapped->GetData());
+        const size_t fileSize = mapped->GetSize();
+
+        TiledDDSHeader header;
+        if (fileSize < sizeof(header))
+        {
+            LOG_ERROR("[TiledDDS] Truncated header: %s", std::string(filePath).c_str());
+            return false;
+        }
+        memcpy(&header, file, sizeof(header));
+
+        if (header.m_Magic != kTiledDDSMagic || header.m_Version != kTiledDDSVersion)
+        {
+            LOG_ERROR("[TiledDDS] Magic/version mismatch (version=%u, expected=%u): %s", header.m_Version, kTiledDDSVersion, std::string(filePath).c_str());
+            return false;
+        }
+
+        if (header.m_FileSize != fileSize || sizeof(header) + (uint64_t)header.m_DDSHeaderSize > header.m_TileTableOffset ||
+            header.m_TileTableOffset + (uint64_t)header.m_NumTiles * sizeof(TiledDDSTile) > header.m_PackedMipOffset ||
+            header.m_PackedMipOffset + header.m_PackedMipSize != fileSize ||
+            header.m_Compression > (uint32_t)TiledDDSCompression::Zstd)
+        {
+            LOG_ERROR("[TiledDDS] Corrupt section table: %s", std::string(filePath).c_str());
+            return false;
+        }
+
+        if (ParseDDSHeader(file + sizeof(header), header.m_DDSHeaderSize, desc) != header.m_DDSHeaderSize || !IsTiledDDSCompatible(desc))
+        {
+            LOG_ERROR("[TiledDDS] Invalid embedded DDS header: %s", std::string(filePath).c_str());
+            return false;
+        }
+
+        const nvrhi::FormatInfo& fmtInfo = nvrhi::getFormatInfo(desc.format);
+
+        std::shared_ptr<TiledDDSLayout> layout = std::make_shared<TiledDDSLayout>();
+        layout->m_TileWidthInTexels  = header.m_TileWidthInTexels;
+        layout->m_TileHeightInTexels = header.m_TileHeightInTexels;
+        layout->m_NumStandardMips    = header.m_NumStandardMips;
+        layout->m_Compression        = (TiledDDSCompression)header.m_Compression;
+
+        if (layout->m_TileWidthInTexels == 0 || layout->m_TileHeightInTexels == 0 ||
+            layout->m_TileWidthInTexels % fmtInfo.blockSize != 0 || layout->m_TileHeightInTexels % fmtInfo.blockSize != 0 ||
+            layout->m_NumStandardMips == 0 || layout->m_NumStandardMips > desc.mipLevels ||
+            BuildTileGrid(desc, *layout) != header.m_NumTiles)
+        {
+            LOG_ERROR("[TiledDDS] Tile layout does not match the texture: %s", std::string(filePath).c_str());
+            return false;
+        }
+
+        layout->m_Tiles.resize(header.m_NumTiles);
+        memcpy(layout->m_Tiles.data(), file + header.m_TileTableOffset, header.m_NumTiles * sizeof(TiledDDSTile));
+
+        for (uint32_t mip = 0; mip < layout->m_NumStandardMips; mip++)
+        {
+            const uint32_t firstTile = layout->m_FirstTileOfMip[mip];
+            const uint32_t endTile   = (mip + 1 < layout->m_NumStandardMips) ? layout->m_FirstTileOfMip[mip + 1] : header.m_NumTiles;
+            for (uint32_t t = firstTile; t < endTile; t++)
+            {
+                const uint32_t local = t - firstTile;
+                const TileExtent extent = GetTileExtent(desc, fmtInfo, *layout, mip, local % layout->m_TilesXOfMip[mip], local / layout->m_TilesXOfMip[mip]);
+                const TiledDDSTile& tile = layout->m_Tiles[t];
+                const bool bStoredSizeValid = (layout->m_Compression == TiledDDSCompression::None) ? tile.m_StoredSize == tile.m_Size
+                                                                                                    : tile.m_StoredSize <= tile.m_Size;
+                if (tile.m_Size != extent.m_RowBytes * extent.m_NumRows || !bStoredSizeValid ||
+                    tile.m_Offset + tile.m_StoredSize > header.m_PackedMipOffset)
+                {
+                    LOG_ERROR("[TiledDDS] Corrupt tile %u: %s", t, std::string(filePath).c_str());
+                    return false;
+                }
+            }
+        }
+
+        size_t linearOffsets[srrhi::CommonConsts::MAX_MIP_COUNT];
+        ComputeDDSMipOffsets(desc, linearOffsets);
+        if (GetLinearSize(desc, linearOffsets, layout->m_NumStandardMips) != header.m_PackedMipSize)
+        {
+            LOG_ERROR("[TiledDDS] Packed mip size mismatch: %s", std::string(filePath).c_str());
+            return false;
+        }
+
+        for (uint32_t mip = 0; mip < srrhi::CommonConsts::MAX_MIP_COUNT; mip++)
+        {
+            if (mip < layout->m_NumStandardMips)
+                outMipOffsets[mip] = layout->m_Tiles[layout->m_FirstTileOfMip[mip]].m_Offset;
+            else if (mip < desc.mipLevels)
+                outMipOffsets[mip] = header.m_PackedMipOffset + (linearOffsets[mip] - linearOffsets[layout->m_NumStandardMips]);
+            else
+                outMipOffsets[mip] = 0;
+        }
+
+        data      = std::move(mapped);
+        outLayout = std::move(layout);
+        return true;
+    }
+
+    // ─── De-tiling / verification ────────────────────────────────────────────
+
+    bool DetileTiledDDS(std::string_view tddsPath, std::vector<uint8_t>& outDDS)
+    {
+        PROFILE_FUNCTION();
+
+        nvrhi::TextureDesc desc;
+        std::unique_ptr<MemoryMappedDataReader> data;
+        std::shared_ptr<const TiledDDSLayout> layout;
+        size_t tiledMipOffsets[srrhi::CommonConsts::MAX_MIP_COUNT];
+        if (!LoadTiledDDS(tddsPath, desc, data, layout, tiledMipOffsets))
+            return false;
+
+        const uint8_t* file = static_cast<const uint8_t*>(data->GetData());
+        TiledDDSHeader header;
+        memcpy(&header, file, sizeof(header));
+
+        const nvrhi::FormatInfo& fmtInfo = nvrhi::getFormatInfo(desc.format);
+
+        size_t linearOffsets[srrhi::CommonConsts::MAX_MIP_COUNT];
+        ComputeDDSMipOffsets(desc, linearOffsets);
+
+        outDDS.resize(header.m_DDSHeaderSize + GetLinearSize(desc, linearOffsets, 0));
+        memcpy(outDDS.data(), file + sizeof(header), header.m_DDSHeaderSize);
+
+        std::vector<uint8_t> decoded;
+
+        uint8_t* pixels = outDDS.data() + header.m_DDSHeaderSize;
+        for (uint32_t mip = 0; mip < layout->m_NumStandardMips; mip++)
+        {
+            const uint32_t mipBlocksW = (std::max(desc.width >> mip, 1u) + fmtInfo.blockSize - 1) / fmtInfo.blockSize;
+            const size_t   rowPitch   = (size_t)mipBlocksW * fmtInfo.bytesPerBlock;
+
+            const uint32_t firstTile = layout->m_FirstTileOfMip[mip];
+            const uint32_t endTile   = (mip + 1 < layout->m_NumStandardMips) ? layout->m_FirstTileOfMip[mip + 1] : header.m_NumTiles;
+            for (uint32_t t = firstTile; t < endTile; t++)
+            {
+                const uint32_t local = t - firstTile;
+                const TileExtent extent = GetTileExtent(desc, fmtInfo, *layout, mip, local % layout->m_TilesXOfMip[mip], local / layout->m_TilesXOfMip[mip]);
+                const TiledDDSTile& tile = layout->m_Tiles[t];
+                const uint8_t* src = file + tile.m_Offset;
+                if (tile.m_StoredSize < tile.m_Size)
+                {
+                    decoded.resize(tile.m_Size);
+                    if (!DecompressTiledDDSTile(layout->m_Compression, src, tile.m_StoredSize, decoded.data(), decoded.size()))
+                    {
+                        LOG_ERROR("[TiledDDS] Failed to decompress tile %u: %s", t, std::string(tddsPath).c_str());
+                        return false;
+                    }
+                    src = decoded.data();
+                }
+
+                for (uint32_t row = 0; row < extent.m_NumRows; row++)
+                {
+                    uint8_t* dst = pixels + linearOffsets[mip] + (extent.m_BlockY + row) * rowPitch + (size_t)extent.m_BlockX * fmtInfo.bytesPerBlock;
+                    memcpy(dst, src + (size_t)row * extent.m_RowBytes, extent.m_RowBytes);
+                }
+            }
+        }
+
+        if (header.m_PackedMipSize > 0)
+            memcpy(pixels + linearOffsets[layout->m_NumStandardMips], file + header.m_PackedMipOffset, header.m_PackedMipSize);
+
+        return true;
+    }
+
+    bool VerifyTiledDDS(const std::filesystem::path& tddsPath, const std::filesystem::path& ddsPath)
+    {
+        PROFILE_FUNCTION();
+
+        std::vector<uint8_t> detiled;
+        if (!DetileTiledDDS(tddsPath.string(), detiled))
+            return false;
+
+        MemoryMappedDataReader source(ddsPath.string(), MemoryMappedDataReader::AccessHint::Sequential);
+        if (!source.IsValid())
+        {
+            LOG_ERROR("[TiledDDS] Cannot map source DDS: %s", ddsPath.string().c_str());
+            return false;
+        }
+
+        const uint8_t* sourceBytes = static_cast<const uint8_t*>(source.GetData());
+        if (source.GetSize() != detiled.size())
+        {
+            LOG_ERROR("[TiledDDS] Verify failed, size %zu != %zu: %s", detiled.size(), source.GetSize(), tddsPath.string().c_str());
+            return false;
+        }
+
+        const auto mismatch = std::mismatch(detiled.begin(), detiled.end(), sourceBytes);
+        if (mismatch.first != detiled.end())
+        {
+            LOG_ERROR("[TiledDDS] Verify failed, first difference at byte %zu: %s",
+                      (size_t)(mismatch.first - detiled.begin()), tddsPath.string().c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+} // namespace nvfeedback
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "../Utilities.h"
+#include "srrhi/cpp/Common.h"
+
+namespace nvfeedback
+{
+    // ─── Tiled DDS (.tdds) ───────────────────────────────────────────────────
+    // Streaming texture format cooked from a DDS.  Every standard tile's block
+    // rows are stored back to back, so AsyncTileIO loads a tile with one aligned
+    // read instead of one scattered read per block row of the linear mip.
+    //
+    // Offset  Size   Field
+    // ------  ----   -----
+    // 0       64     TiledDDSHeader
+    // 64      var    DDS header: the source's 'DDS ' magic, DDS_HEADER and optional
+    //                DDS_HEADER_DXT10, copied verbatim
+    // var     var    Tile table: TiledDDSTile * m_NumTiles, standard tile order
+    //                (mip-major, row-major within a mip)
+    // aligned var    Tiles: each starts on a kTiledDDSTileAlignment boundary; block
+    //                rows are tightly packed, edge tiles are clipped to the mip.
+    //                With m_Compression != None a tile is one LZ4/Zstd frame, unless
+    //                compressing did not make it smaller (m_StoredSize == m_Size)
+    // aligned var    Packed mips: mips [m_NumStandardMips, mipLevels) in linear DDS
+    //                layout, never compressed (uploaded once at load straight from
+    //                the mapping)
+    //
+    // The tile shape and the standard/packed mip split are the D3D12 64 KB
+    // standard tile layout, computed at cook time.  The scene loader only uses a
+    // .tdds whose layout matches the reserved texture's actual tiling.
+    // ─────────────────────────────────────────────────────────────────────────
+
+    // Magic: "TDDS" = 0x53444454
+    constexpr uint32_t kTiledDDSMagic   = 0x53444454;
+    // Bump when the header, tile table or tile layout changes
+    constexpr uint32_t kTiledDDSVersion = 2;
+    // Tiles and the packed mip blob start on page/sector boundaries
+    constexpr uint32_t kTiledDDSTileAlignment = 4096;
+
+    // Per-tile codec, chosen at cook time.  BC data usually still shrinks 20-40%.
+    enum class TiledDDSCompression : uint32_t
+    {
+        None,
+        LZ4,  // LZ4 HC: fastest decode
+        Zstd, // better ratio, slower decode
+    };
+
+    // Cook-time compression levels (decode speed does not depend on them for LZ4)
+    constexpr int kTiledDDSLZ4HCLevel = 9;
+    constexpr int kTiledDDSZstdLevel  = 12;
+
+    struct TiledDDSHeader
+    {
+        uint32_t m_Magic              = kTiledDDSMagic;
+        uint32_t m_Version            = kTiledDDSVersion;
+        uint32_t m_TileWidthInTexels  = 0;
+        uint32_t m_TileHeightInTexels = 0;
+        uint32_t m_NumStandardMips    = 0;
+        uint32_t m_NumTiles           = 0;
+        uint32_t m_DDSHeaderSize      = 0;
+        uint32_t m_Compression        = (uint32_t)TiledDDSCompression::None;
+        uint64_t m_TileTableOffset    = 0;
+        uint64_t m_PackedMipOffset    = 0;
+        uint64_t m_PackedMipSize      = 0;
+        uint64_t m_FileSize           = 0;
+    };
+    static_assert(sizeof(TiledDDSHeader) == 64);
+
+    struct TiledDDSTile
+    {
+        uint64_t m_Offset     = 0; // absolute file offset
+        uint32_t m_Size       = 0; // block rows * row bytes once decoded
+        uint32_t m_StoredSize = 0; // bytes on disk; < m_Size when the tile is compressed
+    };
+    static_assert(sizeof(TiledDDSTile) == 16);
+
+    // Tile table of an opened .tdds.  Shared by every TileRequest of the texture.
+    struct TiledDDSLayout
+    {
+        uint32_t m_TileWidthInTexels  = 0;
+        uint32_t m_TileHeightInTexels = 0;
+        uint32_t m_NumStandardMips    = 0;
+        TiledDDSCompression m_Compression = TiledDDSCompression::None;
+        uint32_t m_FirstTileOfMip[srrhi::CommonConsts::MAX_MIP_COUNT] = {};
+        uint32_t m_TilesXOfMip[srrhi::CommonConsts::MAX_MIP_COUNT]    = {};
+        std::vector<TiledDDSTile> m_Tiles;
+
+        // Tile of a standard mip that starts at texel (x, y).  Null for packed mips.
+        const TiledDDSTile* FindTile(uint32_t mip, uint32_t xInTexels, uint32_t yInTexels) const;
+    };
+
+    // D3D12 64 KB standard tile shape (in texels) for a block size in bytes.
+    bool GetStandardTileShape(uint32_t bytesPerBlock, uint32_t blockSize, uint32_t& outWidth, uint32_t& outHeight);
+
+    const char* GetTiledDDSCompressionName(TiledDDSCompression compression);
+
+    // Writes a .tdds for a 2D, single-slice DDS.  Returns false (and leaves no file
+    // behind) when the source is unsupported or smaller than one tile.
+    bool CookTiledDDS(const std::filesystem::path& ddsPath, const std::filesystem::path& tddsPath,
+                      TiledDDSCompression compression = TiledDDSCompression::None);
+
+    // Reads and checks the magic/version of a .tdds header without mapping the file.
+    bool ReadTiledDDSHeader(const std::filesystem::path& tddsPath, TiledDDSHeader& outHeader);
+
+    // Decodes one stored tile (srcSize bytes) into exactly dstSize bytes.
+    bool DecompressTiledDDSTile(TiledDDSCompression compression, const void* src, size_t srcSize, void* dst, size_t dstSize);
+
+    // Opens a .tdds for streaming.  desc comes from the embedded DDS header, data maps
+    // the whole file (tile offsets are absolute) and outMipOffsets holds the byte offset
+    // of each mip: its first tile for standard mips, its linear data inside the packed
+    // blob for packed mips.
+    bool LoadTiledDDS(std::string_view filePath, nvrhi::TextureDesc& desc, std::unique_ptr<MemoryMappedDataReader>& data,
+                      std::shared_ptr<const TiledDDSLayout>& outLayout, size_t outMipOffsets[srrhi::CommonConsts::MAX_MIP_COUNT]);
+
+    // Rebuilds the source DDS file (header and linear mips) from a .tdds.
+    bool DetileTiledDDS(std::string_view tddsPath, std::vector<uint8_t>& outDDS);
+
+    // De-tiles tddsPath and compares it with ddsPath byte for byte.
+    bool VerifyTiledDDS(const std::filesystem::path& tddsPath, const std::filesystem::path& ddsPath);
+
+} // namespace nvfeedback
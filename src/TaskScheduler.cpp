@@ -1,13 +1,47 @@
 
 #include "TaskScheduler.h"
 
+struct TaskScheduler::ParallelForBatch
+{
+    explicit ParallelForBatch(ParallelForFunction func) : m_Func(func) {}
+
+    ParallelForFunction m_Func;
+    std::atomic<uint32_t> m_Remaining{ 0 };
+    std::mutex m_CompletionMutex;
+    std::condition_variable m_CompletionCondition;
+};
+
 TaskScheduler::TaskScheduler()
 {
     SetThreadCount(kRuntimeThreadCount);
+
+    // Half of the hardware threads, at least 1, at most 4: enough reads in flight
+    // to keep an NVMe queue busy without taking cores from the runtime workers
+    const uint32_t hw = std::thread::hardware_concurrency();
+    const uint32_t numIOThreads = std::max(1u, std::min(4u, hw / 2));
+    m_IOWorkers.reserve(numIOThreads);
+    for (uint32_t i = 0; i < numIOThreads; ++i)
+    {
+        m_IOWorkers.emplace_back(&TaskScheduler::IOWorkerThread, this);
+    }
 }
 
 TaskScheduler::~TaskScheduler()
 {
+    // Queued I/O tasks still run: their owners may be waiting on them
+    {
+        std::lock_guard<std::mutex> lock(m_IOQueueMutex);
+        m_bIOStop = true;
+    }
+    m_IOCondition.notify_all();
+    for (std::thread& worker : m_IOWorkers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+
     {
         std::lock_guard<std::mutex> lock(m_QueueMutex);
         m_Stop = true;
@@ -24,6 +58,8 @@ TaskScheduler::~TaskScheduler()
 
 void TaskScheduler::SetThreadCount(uint32_t count)
 {
+    SDL_assert(std::this_thread::get_id() == m_OwnerThreadId);
+
     std::vector<std::thread> threadsToJoin;
     {
         std::lock_guard<std::mutex> lock(m_QueueMutex);
@@ -63,65 +99,74 @@ void TaskScheduler::SetThreadCount(uint32_t count)
     }
 }
 
-void TaskScheduler::ParallelFor(uint32_t count, const std::function<void(uint32_t index, uint32_t threadIndex)>& func)
+void TaskScheduler::ParallelFor(uint32_t count, ParallelForFunction func)
 {
     if (count == 0) return;
 
-    std::atomic<uint32_t> remaining{ count };
-    std::mutex completionMutex;
-    std::condition_variable completionCondition;
+    ParallelForBatch batch{ func };
+    batch.m_Remaining = count;
 
     {
         std::lock_guard<std::mutex> lock(m_QueueMutex);
         m_RemainingTasks.fetch_add(count);
         for (uint32_t i = 0; i < count; ++i)
         {
-            m_Tasks.push_back([i, &func, &remaining, &completionCondition, &completionMutex](uint32_t threadIndex)
-                {
-                    func(i, threadIndex);
-
-                    // last task to finish signals completion
-                    if (remaining.fetch_sub(1) == 1)
-                    {
-                        std::lock_guard<std::mutex> lock(completionMutex);
-                        completionCondition.notify_all();
-                    }
-                });
+            Task& task = m_Tasks.emplace_back();
+            task.m_Batch = &batch;
+            task.m_Index = i;
         }
     }
     m_Condition.notify_all();
     m_CompletionCondition.notify_all();
 
-    std::unique_lock<std::mutex> lock(completionMutex);
-    completionCondition.wait(lock, [&remaining]() { return remaining == 0; });
+    std::unique_lock<std::mutex> lock(batch.m_CompletionMutex);
+    batch.m_CompletionCondition.wait(lock, [&batch]() { return batch.m_Remaining == 0; });
+}
+
+void TaskScheduler::RunTask(Task& task, uint32_t threadIndex)
+{
+    if (ParallelForBatch* batch = task.m_Batch)
+    {
+        batch->m_Func(task.m_Index, threadIndex);
+
+        // last task to finish signals completion
+        if (batch->m_Remaining.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(batch->m_CompletionMutex);
+            batch->m_CompletionCondition.notify_all();
+        }
+    }
+    else
+    {
+        task.m_Func();
+    }
 }
 
-void TaskScheduler::ScheduleTask(std::function<void()> func, bool bImmediateExecute)
+void TaskScheduler::ScheduleTask(TaskFunction func, bool bImmediateExecute)
 {
     std::lock_guard<std::mutex> lock(m_QueueMutex);
+    SDL_assert((bImmediateExecute || std::this_thread::get_id() == m_OwnerThreadId) && "Deferred tasks are scheduled from the owner thread");
     if (bImmediateExecute)
     {
         m_RemainingTasks.fetch_add(1);
-        m_Tasks.push_back([func](uint32_t)
-            {
-                func();
-            });
+        m_Tasks.emplace_back().m_Func = std::move(func);
 
         m_Condition.notify_one();
     }
     else
     {
-        m_DeferredTasks.push_back([func]() { func(); });
+        m_DeferredTasks.push_back(std::move(func));
     }
 }
 
 void TaskScheduler::ExecuteAllScheduledTasks()
 {
     PROFILE_FUNCTION();
+    SDL_assert(std::this_thread::get_id() == m_OwnerThreadId);
 
     m_Condition.notify_all();
 
-    for (std::function<void()>& deferredTask : m_DeferredTasks)
+    for (TaskFunction& deferredTask : m_DeferredTasks)
     {
         ScheduleTask(std::move(deferredTask));
     }
@@ -129,19 +174,21 @@ void TaskScheduler::ExecuteAllScheduledTasks()
 
     while (m_RemainingTasks > 0)
     {
-        std::function<void(uint32_t)> task;
+        Task task;
+        bool bHasTask = false;
         {
             std::lock_guard<std::mutex> lock(m_QueueMutex);
             if (!m_Tasks.empty())
             {
                 task = std::move(m_Tasks.back());
                 m_Tasks.pop_back();
+                bHasTask = true;
             }
         }
 
-        if (task)
+        if (bHasTask)
         {
-            task(GetThreadCount());
+            RunTask(task, GetThreadCount());
 
             if (m_RemainingTasks.fetch_sub(1) == 1)
             {
@@ -164,7 +211,7 @@ void TaskScheduler::WorkerThread(uint32_t threadIndex)
 {
     while (true)
     {
-        std::function<void(uint32_t)> task;
+        Task task;
         {
             std::unique_lock<std::mutex> lock(m_QueueMutex);
             m_Condition.wait(lock, [this, threadIndex]() { return m_Stop || !m_Tasks.empty() || threadIndex >= m_TargetThreadCount; });
@@ -179,7 +226,7 @@ void TaskScheduler::WorkerThread(uint32_t threadIndex)
             m_Tasks.pop_back();
         }
         
-        task(threadIndex);
+        RunTask(task, threadIndex);
 
         if (m_RemainingTasks.fetch_sub(1) == 1)
         {
@@ -188,3 +235,31 @@ void TaskScheduler::WorkerThread(uint32_t threadIndex)
         }
     }
 }
+
+void TaskScheduler::ScheduleIOTask(std::function<void()> func)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_IOQueueMutex);
+        m_IOTasks.push_back(std::move(func));
+    }
+    m_IOCondition.notify_one();
+}
+
+void TaskScheduler::IOWorkerThread()
+{
+    while (true)
+    {
+        std::function<void()> func;
+        {
+            std::unique_lock<std::mutex> lock(m_IOQueueMutex);
+            m_IOCondition.wait(lock, [this]() { return m_bIOStop || !m_IOTasks.empty(); });
+
+            if (m_IOTasks.empty()) return;
+
+            func = std::move(m_IOTasks.front());
+            m_IOTasks.pop_front();
+        }
+
+        func();
+    }
+}
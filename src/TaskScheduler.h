@@ -1,26 +1,58 @@
 #pragma once
 
+#include "InplaceFunction.h"
+
+// ParallelFor and ScheduleIOTask may be called from any thread (AsyncSceneLoader's
+// thread uses ParallelFor while the main thread renders the loading screen), and
+// ScheduleTask from tasks.  Deferred ScheduleTask, ExecuteAllScheduledTasks and
+// SetThreadCount belong to the thread that created the scheduler.
 class TaskScheduler
 {
 public:
     static const uint32_t kRuntimeThreadCount = 12;
 
+    // ScheduleTask callables are stored inline in the queue: capturing more than
+    // 64 bytes is a compile error instead of a heap allocation per task.
+    using TaskFunction = InplaceFunction<void(), 64>;
+
     TaskScheduler();
     ~TaskScheduler();
 
-    void ParallelFor(uint32_t count, const std::function<void(uint32_t index, uint32_t threadIndex)>& func);
-    void ScheduleTask(std::function<void()> func, bool bImmediateExecute = true);
+    using ParallelForFunction = FunctionRef<void(uint32_t index, uint32_t threadIndex)>;
+    void ParallelFor(uint32_t count, ParallelForFunction func);
+    void ScheduleTask(TaskFunction func, bool bImmediateExecute = true);
     void ExecuteAllScheduledTasks();
 
     void SetThreadCount(uint32_t count);
-    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+    uint32_t GetThreadCount() const { return m_TargetThreadCount.load(); }
+
+    // I/O lane: a few extra threads for work that blocks on the disk (tile reads).
+    // Its tasks run in submission order, are not counted by ExecuteAllScheduledTasks
+    // and never run on the runtime workers, so a slow read cannot stall a frame.
+    void ScheduleIOTask(std::function<void()> func);
+    uint32_t GetIOThreadCount() const { return static_cast<uint32_t>(m_IOWorkers.size()); }
 
 private:
+    struct ParallelForBatch;
+
+    // A queued unit of work. ParallelFor items reference a batch shared by all
+    // indices instead of wrapping every index in its own callable, so neither
+    // kind of task touches the heap once m_Tasks has reached its peak size.
+    struct Task
+    {
+        TaskFunction          m_Func;         // ScheduleTask
+        ParallelForBatch*     m_Batch = nullptr; // ParallelFor
+        uint32_t              m_Index = 0;
+    };
+
     void WorkerThread(uint32_t threadIndex);
+    void RunTask(Task& task, uint32_t threadIndex);
+    void IOWorkerThread();
 
+    const std::thread::id m_OwnerThreadId = std::this_thread::get_id();
     std::vector<std::thread> m_Workers;
-    std::vector<std::function<void(uint32_t)>> m_Tasks;
-    std::vector<std::function<void()>> m_DeferredTasks;
+    std::vector<Task> m_Tasks;
+    std::vector<TaskFunction> m_DeferredTasks;
     
     std::mutex m_QueueMutex;
     std::condition_variable m_Condition;
@@ -30,4 +62,10 @@ private:
     std::atomic<uint32_t> m_RemainingTasks{ 0 };
     std::mutex m_CompletionMutex;
     std::condition_variable m_CompletionCondition;
+
+    std::vector<std::thread> m_IOWorkers;
+    std::deque<std::function<void()>> m_IOTasks;
+    std::mutex m_IOQueueMutex;
+    std::condition_variable m_IOCondition;
+    bool m_bIOStop = false; // guarded by m_IOQueueMutex
 };
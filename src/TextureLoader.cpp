@@ -160,36 +160,26 @@ static nvrhi::TextureDimension GetDimensionFromDDS(bool hasDX10, const DDS_HEADE
     return nvrhi::TextureDimension::Texture2D;
 }
 
-void LoadDDSTexture(std::string_view filePath, nvrhi::TextureDesc& desc, std::unique_ptr<MemoryMappedDataReader>& data)
+size_t ParseDDSHeader(const uint8_t* ptr, size_t size, nvrhi::TextureDesc& desc)
 {
-    std::unique_ptr<MemoryMappedDataReader> mappedData = std::make_unique<MemoryMappedDataReader>(filePath);
-    if (!mappedData->IsValid())
-    {
-        SDL_Log("Cannot map file", "Cannot map file: %s", std::string(filePath).c_str());
-        return;
-    }
-
-    const uint8_t* ptr = static_cast<const uint8_t*>(mappedData->GetData());
-    size_t size = mappedData->GetSize();
-
     if (size < sizeof(uint32_t) + sizeof(DDS_HEADER))
     {
         SDL_Log("Invalid DDS file size", "Invalid DDS file size");
-        return;
+        return 0;
     }
 
     uint32_t magic = *reinterpret_cast<const uint32_t*>(ptr);
     if (magic != DDS_MAGIC)
     {
         SDL_Log("Not a DDS file", "Not a DDS file");
-        return;
+        return 0;
     }
 
     const DDS_HEADER& header = *reinterpret_cast<const DDS_HEADER*>(ptr + sizeof(uint32_t));
     if (header.dwSize != sizeof(DDS_HEADER))
     {
         SDL_Log("Invalid DDS header size", "Invalid DDS header size");
-        return;
+        return 0;
     }
 
     bool hasDX10 = (header.ddspf.dwFlags & DDS_DDPF_FOURCC) && (header.ddspf.dwFourCC == DDS_FOURCC_DX10);
@@ -201,7 +191,7 @@ void LoadDDSTexture(std::string_view filePath, nvrhi::TextureDesc& desc, std::un
         if (size < offset + sizeof(DDS_HEADER_DXT10))
         {
             SDL_Log("Invalid DDS file size (DX10)", "Invalid DDS file size (DX10)");
-            return;
+            return 0;
         }
         dx10Header = *reinterpret_cast<const DDS_HEADER_DXT10*>(ptr + offset);
         offset += sizeof(DDS_HEADER_DXT10);
@@ -218,6 +208,23 @@ void LoadDDSTexture(std::string_view filePath, nvrhi::TextureDesc& desc, std::un
     desc.initialState = nvrhi::ResourceStates::ShaderResource;
     desc.keepInitialState = true;
 
+    return offset;
+}
+
+void LoadDDSTexture(std::string_view filePath, nvrhi::TextureDesc& desc, std::unique_ptr<MemoryMappedDataReader>& data)
+{
+    // Non-streamed DDS files are uploaded front to back; small ones are pre-faulted in one go
+    std::unique_ptr<MemoryMappedDataReader> mappedData = std::make_unique<MemoryMappedDataReader>(filePath, MemoryMappedDataReader::AccessHint::Sequential, true);
+    if (!mappedData->IsValid())
+    {
+        SDL_Log("Cannot map file", "Cannot map file: %s", std::string(filePath).c_str());
+        return;
+    }
+
+    const size_t offset = ParseDDSHeader(static_cast<const uint8_t*>(mappedData->GetData()), mappedData->GetSize(), desc);
+    if (offset == 0)
+        return;
+
     mappedData->SetOffset(offset);
     data = std::move(mappedData);
 }
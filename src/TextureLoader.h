@@ -8,6 +8,9 @@ class MemoryMappedDataReader; // defined in Utilities.h
 void UploadTexture(nvrhi::ICommandList* cmd, nvrhi::ITexture* texture, const nvrhi::TextureDesc& desc, const void* data, size_t dataSize = 0);
 
 bool LoadTexture(std::string_view filePath, nvrhi::TextureDesc& desc, std::unique_ptr<MemoryMappedDataReader>& data);
+// Parses the 'DDS ' magic, DDS_HEADER and optional DDS_HEADER_DXT10 at ptr into desc.
+// Returns the byte offset of the pixel data, or 0 if the header is invalid.
+size_t ParseDDSHeader(const uint8_t* ptr, size_t size, nvrhi::TextureDesc& desc);
 void LoadDDSTexture(std::string_view filePath, nvrhi::TextureDesc& desc, std::unique_ptr<MemoryMappedDataReader>& data);
 void LoadSTBITexture(std::string_view filePath, nvrhi::TextureDesc& desc, std::unique_ptr<MemoryMappedDataReader>& data);
 
@@ -0,0 +1,183 @@
+#include "VRAMBudget.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+
+static double ToMB(uint64_t bytes)
+{
+    return (double)bytes / (1024.0 * 1024.0);
+}
+
+VRAMBudgetGovernor::SubsystemID VRAMBudgetGovernor::Register(const SubsystemDesc& desc)
+{
+    const SubsystemID id = (SubsystemID)m_Subsystems.size();
+
+    Subsystem& subsystem = m_Subsystems.emplace_back();
+    subsystem.m_Desc = desc;
+    subsystem.m_Stats.m_Name = desc.m_Name;
+    subsystem.m_bRegistered = true;
+
+    m_EvictionOrder.push_back(id);
+    std::stable_sort(m_EvictionOrder.begin(), m_EvictionOrder.end(), [this](uint32_t a, uint32_t b)
+    {
+        return m_Subsystems[a].m_Desc.m_EvictionPriority < m_Subsystems[b].m_Desc.m_EvictionPriority;
+    });
+
+    return id;
+}
+
+void VRAMBudgetGovernor::Unregister(SubsystemID id)
+{
+    Subsystem& subsystem = m_Subsystems.at(id);
+    subsystem.m_bRegistered = false;
+    subsystem.m_Desc.m_Reclaim = nullptr;
+    subsystem.m_Desc.m_Restore = nullptr;
+    subsystem.m_Stats = SubsystemStats{ subsystem.m_Desc.m_Name };
+    subsystem.m_PendingReclaimBytes = 0;
+    subsystem.m_PendingReclaimFrames = 0;
+
+    m_EvictionOrder.erase(std::remove(m_EvictionOrder.begin(), m_EvictionOrder.end(), id), m_EvictionOrder.end());
+}
+
+void VRAMBudgetGovernor::ReportFootprint(SubsystemID id, uint64_t currentBytes, uint64_t minimumBytes)
+{
+    Subsystem& subsystem = m_Subsystems.at(id);
+    assert(subsystem.m_bRegistered && "ReportFootprint on an unregistered subsystem");
+
+    // Whatever the subsystem gave back settles the matching part of its promise
+    if (currentBytes < subsystem.m_Stats.m_CurrentBytes)
+    {
+        const uint64_t released = subsystem.m_Stats.m_CurrentBytes - currentBytes;
+        subsystem.m_PendingReclaimBytes -= std::min(subsystem.m_PendingReclaimBytes, released);
+    }
+
+    subsystem.m_Stats.m_CurrentBytes = currentBytes;
+    subsystem.m_Stats.m_MinimumBytes = std::min(minimumBytes, currentBytes);
+}
+
+uint64_t VRAMBudgetGovernor::GetTotalBytes() const
+{
+    uint64_t total = m_UntrackedBytes;
+    for (const Subsystem& subsystem : m_Subsystems)
+    {
+        if (subsystem.m_bRegistered)
+            total += subsystem.m_Stats.m_CurrentBytes - std::min(subsystem.m_PendingReclaimBytes, subsystem.m_Stats.m_CurrentBytes);
+    }
+    return total;
+}
+
+uint64_t VRAMBudgetGovernor::GetHeadroomBytes() const
+{
+    if (m_BudgetBytes == 0)
+        return UINT64_MAX;
+
+    const uint64_t highWatermark = (uint64_t)(m_BudgetBytes * (double)kHighWatermark);
+    const uint64_t total = GetTotalBytes();
+    return total < highWatermark ? highWatermark - total : 0;
+}
+
+uint64_t VRAMBudgetGovernor::Update()
+{
+    if (m_BudgetBytes == 0)
+        return 0;
+
+    // Promises that never materialized (the subsystem hit a floor it did not report) expire
+    for (Subsystem& subsystem : m_Subsystems)
+    {
+        if (subsystem.m_PendingReclaimBytes > 0 && ++subsystem.m_PendingReclaimFrames >= kReclaimSettleFrames)
+        {
+            subsystem.m_PendingReclaimBytes = 0;
+            subsystem.m_PendingReclaimFrames = 0;
+        }
+    }
+
+    const uint64_t total            = GetTotalBytes();
+    const uint64_t highWatermark    = (uint64_t)(m_BudgetBytes * (double)kHighWatermark);
+    const uint64_t lowWatermark     = (uint64_t)(m_BudgetBytes * (double)kLowWatermark);
+    const uint64_t restoreWatermark = (uint64_t)(m_BudgetBytes * (double)kRestoreWatermark);
+
+    if (total > highWatermark)
+        m_bUnderPressure = true;
+    else if (total <= lowWatermark)
+        m_bUnderPressure = false;
+
+    // ── Pressure: reclaim down to the low watermark, cheapest subsystems first ──
+    if (total > highWatermark)
+    {
+        m_FramesBelowRestoreWatermark = 0;
+
+        uint64_t overage = total - lowWatermark;
+        uint64_t requested = 0;
+
+        for (uint32_t idx : m_EvictionOrder)
+        {
+            Subsystem& subsystem = m_Subsystems[idx];
+            if (!subsystem.m_Desc.m_Reclaim)
+                continue;
+
+            const SubsystemStats& stats = subsystem.m_Stats;
+            const uint64_t effective = stats.m_CurrentBytes - std::min(subsystem.m_PendingReclaimBytes, stats.m_CurrentBytes);
+            const uint64_t reclaimable = effective > stats.m_MinimumBytes ? effective - stats.m_MinimumBytes : 0;
+            const uint64_t ask = std::min(overage, reclaimable);
+            if (ask == 0)
+                continue;
+
+            const uint64_t promised = std::min(subsystem.m_Desc.m_Reclaim(ask), ask);
+            if (promised == 0)
+                continue;
+
+            LOG_INFO("[VRAMBudget] %s: reclaiming %.2f MB (total %.2f / budget %.2f MB)",
+                     stats.m_Name, ToMB(promised), ToMB(total), ToMB(m_BudgetBytes));
+
+            subsystem.m_PendingReclaimBytes += promised;
+            subsystem.m_PendingReclaimFrames = 0;
+            subsystem.m_Stats.m_ReclaimedBytes += promised;
+            subsystem.m_Stats.m_bDegraded = true;
+
+            overage   -= promised;
+            requested += promised;
+            if (overage == 0)
+                break;
+        }
+
+        if (overage > 0)
+        {
+            LOG_WARN_RATE_LIMITED(5000, "[VRAMBudget] Over budget by %.2f MB with every subsystem at its minimum",
+                                  ToMB(overage));
+        }
+
+        return requested;
+    }
+
+    // ── Relief: restore one degraded subsystem after a sustained quiet period ──
+    if (total >= restoreWatermark)
+    {
+        m_FramesBelowRestoreWatermark = 0;
+        return 0;
+    }
+
+    if (++m_FramesBelowRestoreWatermark < kRestoreDelayFrames)
+        return 0;
+
+    m_FramesBelowRestoreWatermark = 0;
+
+    for (auto it = m_EvictionOrder.rbegin(); it != m_EvictionOrder.rend(); ++it)
+    {
+        Subsystem& subsystem = m_Subsystems[*it];
+        if (!subsystem.m_Stats.m_bDegraded)
+            continue;
+
+        LOG_INFO("[VRAMBudget] %s: restoring (total %.2f / budget %.2f MB)",
+                 subsystem.m_Stats.m_Name, ToMB(total), ToMB(m_BudgetBytes));
+
+        if (subsystem.m_Desc.m_Restore)
+            subsystem.m_Desc.m_Restore();
+
+        subsystem.m_Stats.m_bDegraded = false;
+        subsystem.m_Stats.m_ReclaimedBytes = 0;
+        break;
+    }
+
+    return 0;
+}
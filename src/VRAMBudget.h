@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// ─── VRAMBudgetGovernor ──────────────────────────────────────────────────────
+// Arbitrates one global VRAM budget between the subsystems that own large GPU
+// allocations (streaming tile heaps, BLAS, render graph heaps, scene buffers).
+//
+// Each subsystem registers once and then reports its footprint every frame:
+//   current  — bytes it holds right now
+//   minimum  — bytes it cannot give back (packed mips, coarsest BLAS LOD, ...)
+// Subsystems that can shrink also provide a Reclaim callback (evict tiles,
+// drop LODs) and a Restore callback (undo the downgrade).
+//
+// Update() runs once per frame on the main thread:
+//   - total > budget * kHighWatermark: pressure.  The overage down to
+//     budget * kLowWatermark is requested from subsystems in ascending
+//     eviction priority, each clamped to (current - minimum).
+//   - total < budget * kRestoreWatermark for kRestoreDelayFrames frames:
+//     degraded subsystems are restored in descending priority, one at a time
+//     kRestoreDelayFrames apart, so a restore that overshoots is caught before
+//     the next one runs.
+// The gap between the watermarks is the hysteresis that keeps a subsystem from
+// oscillating between reclaim and restore.
+//
+// The policy is pure CPU bookkeeping (part of HobbyRendererCore, tested with
+// synthetic footprints); the budget itself comes from
+// GraphicRHI::GetVRAMBudgetMB() or Config::m_VRAMBudgetMB.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class VRAMBudgetGovernor
+{
+public:
+    using SubsystemID = uint32_t;
+    static constexpr SubsystemID kInvalidSubsystem = UINT32_MAX;
+
+    static constexpr float    kHighWatermark      = 0.95f;
+    static constexpr float    kLowWatermark       = 0.85f;
+    static constexpr float    kRestoreWatermark   = 0.70f;
+    static constexpr uint32_t kRestoreDelayFrames = 120;
+    // Reclaims usually take effect a few frames later (deferred heap release).
+    // Bytes promised by a subsystem are treated as already freed for this many
+    // frames so the same overage is not requested again every frame.
+    static constexpr uint32_t kReclaimSettleFrames = 8;
+
+    struct SubsystemDesc
+    {
+        const char* m_Name = "";
+        // Lower values are asked to reclaim first.
+        uint32_t    m_EvictionPriority = 0;
+        // Free up to `bytes` without going below the reported minimum.  Returns the
+        // bytes that will be released (the effect may only show in a later report).
+        // Null for subsystems that are tracked but cannot shrink.
+        std::function<uint64_t(uint64_t bytes)> m_Reclaim = nullptr;
+        // Undo every downgrade applied by m_Reclaim.
+        std::function<void()> m_Restore = nullptr;
+    };
+
+    struct SubsystemStats
+    {
+        const char* m_Name = "";
+        uint64_t    m_CurrentBytes = 0;
+        uint64_t    m_MinimumBytes = 0;
+        uint64_t    m_ReclaimedBytes = 0; // total requested from this subsystem since the last restore
+        bool        m_bDegraded = false;
+    };
+
+    SubsystemID Register(const SubsystemDesc& desc);
+    void        Unregister(SubsystemID id);
+
+    void ReportFootprint(SubsystemID id, uint64_t currentBytes, uint64_t minimumBytes);
+
+    // Memory used by the process that no registered subsystem accounts for
+    // (textures, swap chain, driver internals).  Counts against the budget.
+    void ReportUntrackedBytes(uint64_t bytes) { m_UntrackedBytes = bytes; }
+
+    void     SetBudget(uint64_t budgetBytes) { m_BudgetBytes = budgetBytes; }
+    uint64_t GetBudget() const { return m_BudgetBytes; }
+
+    // Runs the arbitration policy.  Returns the bytes requested from subsystems this frame.
+    uint64_t Update();
+
+    uint64_t GetTotalBytes() const;
+    // Bytes a subsystem may still allocate before pressure kicks in.
+    uint64_t GetHeadroomBytes() const;
+    bool     IsUnderPressure() const { return m_bUnderPressure; }
+
+    uint32_t              GetNumSubsystems() const { return (uint32_t)m_Subsystems.size(); }
+    const SubsystemStats& GetSubsystemStats(SubsystemID id) const { return m_Subsystems.at(id).m_Stats; }
+    uint64_t              GetUntrackedBytes() const { return m_UntrackedBytes; }
+
+private:
+    struct Subsystem
+    {
+        SubsystemDesc  m_Desc;
+        SubsystemStats m_Stats;
+        bool           m_bRegistered = false;
+
+        // Promised by m_Reclaim but not yet visible in m_CurrentBytes
+        uint64_t       m_PendingReclaimBytes = 0;
+        uint32_t       m_PendingReclaimFrames = 0;
+    };
+
+    std::vector<Subsystem> m_Subsystems;
+    std::vector<uint32_t>  m_EvictionOrder; // indices into m_Subsystems, ascending priority
+
+    uint64_t m_BudgetBytes    = 0;
+    uint64_t m_UntrackedBytes = 0;
+    bool     m_bUnderPressure = false;
+    uint32_t m_FramesBelowRestoreWatermark = 0;
+};
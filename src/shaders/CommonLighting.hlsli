@@ -575,6 +575,23 @@ LightingComponents ComputeSpotLighting(LightingInputs inputs, srrhi::GPULight li
     return EvaluateDirectLight(inputs, radiance, shadow);
 }
 
+void AccumulateLight(inout LightingComponents total, LightingInputs inputs, srrhi::GPULight light)
+{
+    [branch]
+    if (light.m_Type == 0) // Directional
+    {
+        LightingComponents comp = ComputeDirectionalLighting(inputs, light);
+        total.diffuse += comp.diffuse;
+        total.specular += comp.specular;
+    }
+    else if (light.m_Type == 2) // Spot
+    {
+        LightingComponents comp = ComputeSpotLighting(inputs, light);
+        total.diffuse += comp.diffuse;
+        total.specular += comp.specular;
+    }
+}
+
 LightingComponents AccumulateDirectLighting(LightingInputs inputs, uint lightCount)
 {
     LightingComponents total;
@@ -583,21 +600,26 @@ LightingComponents AccumulateDirectLighting(LightingInputs inputs, uint lightCou
 
     for (uint i = 0; i < lightCount; ++i)
     {
-        srrhi::GPULight light = inputs.lights[i];
-        
-        [branch]
-        if (light.m_Type == 0) // Directional
-        {
-            LightingComponents comp = ComputeDirectionalLighting(inputs, light);
-            total.diffuse += comp.diffuse;
-            total.specular += comp.specular;
-        }
-        else if (light.m_Type == 2) // Spot
-        {
-            LightingComponents comp = ComputeSpotLighting(inputs, light);
-            total.diffuse += comp.diffuse;
-            total.specular += comp.specular;
-        }
+        AccumulateLight(total, inputs, inputs.lights[i]);
+    }
+    return total;
+}
+
+// Same, for the lights of one cluster of the CPU-binned light grid: lightIndices[0, numGlobalLights)
+// reach every pixel, cluster = { offset, count } lists the cluster's local lights.
+LightingComponents AccumulateClusteredDirectLighting(LightingInputs inputs, StructuredBuffer<uint> lightIndices, uint numGlobalLights, uint2 cluster)
+{
+    LightingComponents total;
+    total.diffuse = 0;
+    total.specular = 0;
+
+    for (uint i = 0; i < numGlobalLights; ++i)
+    {
+        AccumulateLight(total, inputs, inputs.lights[lightIndices[i]]);
+    }
+    for (uint j = 0; j < cluster.y; ++j)
+    {
+        AccumulateLight(total, inputs, inputs.lights[lightIndices[cluster.x + j]]);
     }
     return total;
 }
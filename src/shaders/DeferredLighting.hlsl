@@ -26,6 +26,22 @@ static const Texture2D<float4>                          g_RTXDIDIComposited  = s
 static const Texture2D<float4>                          g_SHARCIndirect      = srrhi::DeferredLightingInputs::GetSHARCIndirect();
 static const Texture2D<float>                           g_ShadowMask         = srrhi::DeferredLightingInputs::GetShadowMask();
 static const Texture2D<float4>                          g_CSMDebugOutput     = srrhi::DeferredLightingInputs::GetCSMDebugOutput();
+static const StructuredBuffer<uint2>                    g_LightClusters      = srrhi::DeferredLightingInputs::GetLightClusters();
+static const StructuredBuffer<uint>                     g_LightClusterIndices = srrhi::DeferredLightingInputs::GetLightClusterIndices();
+
+// Cluster of a view-space position in LightClusterBinner's grid (tiles x depth slices)
+uint GetLightClusterIndex(float3 viewPos)
+{
+    const float2 tile = float2(
+        viewPos.x / viewPos.z * g_Deferred.m_LightClusterScaleX + 0.5f * g_Deferred.m_LightClusterCountX,
+        0.5f * g_Deferred.m_LightClusterCountY - viewPos.y / viewPos.z * g_Deferred.m_LightClusterScaleY);
+    const float slice = log(viewPos.z) * g_Deferred.m_LightClusterZScale + g_Deferred.m_LightClusterZBias;
+
+    const uint x = (uint)clamp(floor(tile.x), 0.0f, g_Deferred.m_LightClusterCountX - 1.0f);
+    const uint y = (uint)clamp(floor(tile.y), 0.0f, g_Deferred.m_LightClusterCountY - 1.0f);
+    const uint z = (uint)clamp(floor(slice), 0.0f, g_Deferred.m_LightClusterCountZ - 1.0f);
+    return x + (y + z * g_Deferred.m_LightClusterCountY) * g_Deferred.m_LightClusterCountX;
+}
 
 float4 DeferredLighting_PSMain(FullScreenVertexOut input) : SV_Target
 {
@@ -115,7 +131,17 @@ float4 DeferredLighting_PSMain(FullScreenVertexOut input) : SV_Target
                 lightingInputs.useSunRadiance = true;
             }
 
-            LightingComponents directLighting = AccumulateDirectLighting(lightingInputs, g_Deferred.m_LightCount);
+            LightingComponents directLighting;
+            if (g_Deferred.m_UseLightClusters != 0)
+            {
+                const float3 viewPos = MatrixMultiply(float4(worldPos, 1.0f), g_Deferred.m_View.m_MatWorldToView).xyz;
+                const uint2 cluster = g_LightClusters[GetLightClusterIndex(viewPos)];
+                directLighting = AccumulateClusteredDirectLighting(lightingInputs, g_LightClusterIndices, g_Deferred.m_NumGlobalLights, cluster);
+            }
+            else
+            {
+                directLighting = AccumulateDirectLighting(lightingInputs, g_Deferred.m_LightCount);
+            }
             color = directLighting.diffuse + directLighting.specular;
             color += emissive;
         }
@@ -34,6 +34,7 @@ static RWStructuredBuffer<srrhi::MeshletJob>                       g_MeshletJobs
 static RWStructuredBuffer<uint>                                    g_MeshletJobCount     = srrhi::GPUCullingInputs::GetMeshletJobCount();
 static RWStructuredBuffer<srrhi::DispatchIndirectArguments>        g_MeshletIndirectArgs = srrhi::GPUCullingInputs::GetMeshletIndirectArgs();
 static RWStructuredBuffer<uint>                                    g_InstanceLOD         = srrhi::GPUCullingInputs::GetInstanceLOD();
+static RWStructuredBuffer<uint>                                    g_LODRequests         = srrhi::GPUCullingInputs::GetLODRequests();
 
 [numthreads(srrhi::CommonConsts::kThreadsPerGroup, 1, 1)]
 void Culling_CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
@@ -133,6 +134,12 @@ void Culling_CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
         // Always write the selected LOD index for this instance so TLASRenderer
         // can patch the correct BLAS address regardless of rendering path.
         g_InstanceLOD[actualInstanceIndex] = lodIndex;
+
+        // Finest LOD any visible instance of this mesh wants, read back by GeometryStreamer
+        if (g_Culling.m_RecordLODRequests)
+        {
+            InterlockedMin(g_LODRequests[inst.m_MeshDataIndex], lodIndex);
+        }
     }
 
     if (g_Culling.m_Phase == 0)
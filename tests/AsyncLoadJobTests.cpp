@@ -0,0 +1,152 @@
+#include "TestFramework.h"
+
+#include "AsyncLoadJob.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double MillisecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Stands in for the device: counts submissions and reports the uploads done
+    // after a number of polls, without ever waiting
+    struct StubGPU
+    {
+        std::thread::id       m_SubmitThread;
+        std::atomic<uint32_t> m_NumSubmits{ 0 };
+        uint32_t              m_NumPolls          = 0;
+        uint32_t              m_PollsUntilDone    = 5;
+        bool                  m_bLoadDoneAtSubmit = false;
+    };
+
+    AsyncLoadJob::Desc MakeDesc(StubGPU& gpu, std::atomic<bool>& bLoadDone, uint32_t numSteps, uint32_t stepMilliseconds)
+    {
+        return {
+            .m_Load = [&bLoadDone, numSteps, stepMilliseconds]() {
+                // A scripted slow load: parsing, decoding and recording uploads in steps
+                for (uint32_t i = 0; i < numSteps; ++i)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(stepMilliseconds));
+                bLoadDone.store(true);
+            },
+            .m_SubmitUploads = [&gpu, &bLoadDone]() {
+                gpu.m_SubmitThread = std::this_thread::get_id();
+                gpu.m_bLoadDoneAtSubmit = bLoadDone.load();
+                gpu.m_NumSubmits.fetch_add(1);
+                return 7u;
+            },
+            .m_PollUploads = [&gpu]() {
+                return ++gpu.m_NumPolls >= gpu.m_PollsUntilDone;
+            },
+        };
+    }
+} // namespace
+
+TEST_CASE(AsyncLoadJob, FrameLoopKeepsTickingDuringASlowLoad)
+{
+    constexpr uint32_t kNumLoadSteps         = 30;
+    constexpr uint32_t kLoadStepMilliseconds = 10;
+    constexpr double   kFrameMilliseconds    = 2.0;
+    // A frame that waited for the load would take ~kNumLoadSteps * kLoadStepMilliseconds
+    constexpr double   kMaxTickMilliseconds  = 50.0;
+
+    StubGPU gpu;
+    std::atomic<bool> bLoadDone{ false };
+    AsyncLoadJob job;
+    job.Start(MakeDesc(gpu, bLoadDone, kNumLoadSteps, kLoadStepMilliseconds));
+    CHECK(job.IsActive());
+
+    // The frame loop: Update() then the rest of a (loading screen) frame
+    const Clock::time_point loadStart = Clock::now();
+    uint32_t numTicks = 0;
+    uint32_t numTicksWhileLoading = 0;
+    double   maxTickMilliseconds = 0.0;
+    double   maxUpdateMilliseconds = 0.0;
+    while (true)
+    {
+        const Clock::time_point tickStart = Clock::now();
+        const bool bReady = job.Update();
+        maxUpdateMilliseconds = std::max(maxUpdateMilliseconds, MillisecondsSince(tickStart));
+        if (bReady)
+            break;
+
+        numTicksWhileLoading += job.GetState() == AsyncLoadJob::State::Loading;
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(kFrameMilliseconds));
+        maxTickMilliseconds = std::max(maxTickMilliseconds, MillisecondsSince(tickStart));
+        numTicks++;
+        REQUIRE(MillisecondsSince(loadStart) < 10000.0);
+    }
+    const double loadMilliseconds = MillisecondsSince(loadStart);
+
+    std::printf("  load %.0f ms, %u frames (%u while loading), longest frame %.2f ms, longest Update %.3f ms\n",
+                loadMilliseconds, numTicks, numTicksWhileLoading, maxTickMilliseconds, maxUpdateMilliseconds);
+    CHECK(loadMilliseconds >= kNumLoadSteps * kLoadStepMilliseconds);
+    CHECK(maxTickMilliseconds < kMaxTickMilliseconds);
+    CHECK(maxUpdateMilliseconds < kMaxTickMilliseconds);
+    // The loop kept presenting while the load ran
+    CHECK(numTicksWhileLoading >= (kNumLoadSteps * kLoadStepMilliseconds) / kMaxTickMilliseconds);
+
+    CHECK(job.GetState() == AsyncLoadJob::State::Ready);
+    job.MarkTaken();
+    CHECK(!job.IsActive());
+    CHECK(!job.Shutdown());
+}
+
+TEST_CASE(AsyncLoadJob, SubmitsOnceOnTheMainThreadAndPollsUntilDone)
+{
+    StubGPU gpu;
+    std::atomic<bool> bLoadDone{ false };
+    AsyncLoadJob job;
+    CHECK(job.GetState() == AsyncLoadJob::State::Idle);
+    CHECK(job.GetElapsedSeconds() == 0.0);
+
+    job.Start(MakeDesc(gpu, bLoadDone, 1, 5));
+    while (job.GetState() == AsyncLoadJob::State::Loading)
+    {
+        CHECK(!job.Update());
+        std::this_thread::yield();
+    }
+    CHECK(gpu.m_NumSubmits.load() == 0);
+
+    // Loaded: the next Update submits, the polls after it finish
+    CHECK(!job.Update());
+    CHECK(job.GetState() == AsyncLoadJob::State::Uploading);
+    CHECK(gpu.m_NumSubmits.load() == 1);
+    CHECK(gpu.m_bLoadDoneAtSubmit);
+    CHECK(gpu.m_SubmitThread == std::this_thread::get_id());
+
+    for (uint32_t i = 1; i < gpu.m_PollsUntilDone; ++i)
+        CHECK(!job.Update());
+    CHECK(job.Update());
+    CHECK(job.GetState() == AsyncLoadJob::State::Ready);
+
+    // Ready stays ready without polling the GPU again
+    const uint32_t numPolls = gpu.m_NumPolls;
+    CHECK(job.Update());
+    CHECK(gpu.m_NumPolls == numPolls);
+    CHECK(gpu.m_NumSubmits.load() == 1);
+
+    job.MarkTaken();
+    CHECK(job.GetState() == AsyncLoadJob::State::Taken);
+    CHECK(!job.Update());
+    job.Shutdown();
+}
+
+TEST_CASE(AsyncLoadJob, ShutdownWaitsForARunningLoad)
+{
+    StubGPU gpu;
+    std::atomic<bool> bLoadDone{ false };
+    AsyncLoadJob job;
+    job.Start(MakeDesc(gpu, bLoadDone, 10, 10));
+
+    CHECK(job.Shutdown());
+    CHECK(bLoadDone.load());
+    CHECK(gpu.m_NumSubmits.load() == 0);
+}
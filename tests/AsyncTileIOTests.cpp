@@ -0,0 +1,272 @@
+#include "TestFramework.h"
+
+#include "Streaming/AsyncTileIO.h"
+#include "TaskScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // One BC1 mip 0 of kTextureSize^2 texels without a header (mip 0 at offset 0),
+    // read in standard 512x256 tiles
+    constexpr uint32_t kTextureSize   = 2048;
+    constexpr uint32_t kTileWidth     = 512;
+    constexpr uint32_t kTileHeight    = 256;
+    constexpr uint32_t kBytesPerBlock = 8;
+    constexpr uint32_t kTilesPerMip   = (kTextureSize / kTileWidth) * (kTextureSize / kTileHeight);
+
+    // A wait that spins burns about as much CPU as it waits; one that sleeps
+    // stays under the timer granularity (15.6 ms on Windows)
+    constexpr double kMaxWaitCPUSeconds = 0.05;
+
+    struct TempSource
+    {
+        std::filesystem::path                   m_Path;
+        std::shared_ptr<MemoryMappedDataReader> m_Reader;
+
+        explicit TempSource(const char* name)
+            : m_Path(std::filesystem::temp_directory_path() / name)
+        {
+            std::vector<uint8_t> bytes((size_t)kTextureSize / 4 * kTextureSize / 4 * kBytesPerBlock);
+            for (size_t i = 0; i < bytes.size(); ++i)
+                bytes[i] = (uint8_t)(i * 31 + (i >> 11));
+            {
+                std::ofstream file(m_Path, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char*>(bytes.data()), (std::streamsize)bytes.size());
+            }
+            m_Reader = std::make_shared<MemoryMappedDataReader>(m_Path.string());
+        }
+
+        ~TempSource()
+        {
+            m_Reader.reset();
+            std::error_code ec;
+            std::filesystem::remove(m_Path, ec);
+        }
+    };
+
+    // No reserved texture: the tests flush with a null command list, which discards
+    TileRequest MakeRequest(const TempSource& source, uint32_t tileIndex)
+    {
+        tileIndex %= kTilesPerMip;
+
+        TileRequest request;
+        request.m_SourceData         = source.m_Reader;
+        request.m_TileXInTexels      = (tileIndex % (kTextureSize / kTileWidth)) * kTileWidth;
+        request.m_TileYInTexels      = (tileIndex / (kTextureSize / kTileWidth)) * kTileHeight;
+        request.m_TileWidthInTexels  = kTileWidth;
+        request.m_TileHeightInTexels = kTileHeight;
+        request.m_TextureWidth       = kTextureSize;
+        request.m_TextureHeight      = kTextureSize;
+        request.m_Format             = nvrhi::Format::BC1_UNORM;
+        request.m_BytesPerBlock      = kBytesPerBlock;
+        request.m_BlockSize          = 4;
+        request.m_UserTag            = tileIndex;
+        return request;
+    }
+
+    double GetProcessCPUSeconds()
+    {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+            return 0.0;
+        const uint64_t ticks = ((uint64_t)kernel.dwHighDateTime << 32 | kernel.dwLowDateTime) +
+                               ((uint64_t)user.dwHighDateTime << 32 | user.dwLowDateTime);
+        return (double)ticks * 1e-7;
+#else
+        return (double)std::clock() / CLOCKS_PER_SEC;
+#endif
+    }
+
+    double GetThreadCPUSeconds()
+    {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+            return 0.0;
+        const uint64_t ticks = ((uint64_t)kernel.dwHighDateTime << 32 | kernel.dwLowDateTime) +
+                               ((uint64_t)user.dwHighDateTime << 32 | user.dwLowDateTime);
+        return (double)ticks * 1e-7;
+#else
+        timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+    }
+
+    double SecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Occupies every I/O lane thread for `milliseconds`, the way reads from a slow
+    // disk would: the tile tasks queued behind them wait, and nothing uses the CPU
+    void HoldIOLane(TaskScheduler& scheduler, uint32_t milliseconds)
+    {
+        std::atomic<uint32_t> numHeld{ 0 };
+        for (uint32_t i = 0; i < scheduler.GetIOThreadCount(); ++i)
+        {
+            scheduler.ScheduleIOTask([&numHeld, milliseconds]() {
+                numHeld.fetch_add(1);
+                std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+            });
+        }
+        while (numHeld.load() < scheduler.GetIOThreadCount())
+            std::this_thread::yield();
+    }
+} // namespace
+
+TEST_CASE(AsyncTileIO, WaitIdleSleepsOnASlowSource)
+{
+    constexpr uint32_t kHoldMilliseconds = 300;
+    constexpr uint32_t kNumRequests      = 64;
+
+    TempSource source("HobbyRendererTests_AsyncTileIO_slow.bin");
+    REQUIRE(source.m_Reader->IsValid());
+
+    for (AsyncTileIO::IOBackend backend : { AsyncTileIO::IOBackend::MemoryMapped, AsyncTileIO::IOBackend::ExplicitRead })
+    {
+        // The lane held by a slow read: WaitIdle blocks for the whole hold, and
+        // with every thread asleep the process uses (almost) no CPU meanwhile
+        {
+            TaskScheduler scheduler;
+            AsyncTileIO io(nullptr, backend, AsyncTileIO::kDefaultQueueDepth, 0, 0, &scheduler);
+
+            HoldIOLane(scheduler, kHoldMilliseconds);
+            for (uint32_t i = 0; i < kNumRequests; ++i)
+                io.Submit(MakeRequest(source, i));
+
+            const Clock::time_point waitStart = Clock::now();
+            const double cpuStart = GetProcessCPUSeconds();
+            io.WaitIdle();
+            const double cpuSeconds = GetProcessCPUSeconds() - cpuStart;
+            const double waitSeconds = SecondsSince(waitStart);
+
+            std::printf("  lane, %s: WaitIdle %.1f ms, process CPU %.1f ms\n",
+                        backend == AsyncTileIO::IOBackend::MemoryMapped ? "mmap" : "explicit", waitSeconds * 1e3, cpuSeconds * 1e3);
+            CHECK(waitSeconds >= kHoldMilliseconds * 1e-3 * 0.5);
+            CHECK(cpuSeconds < kMaxWaitCPUSeconds);
+            CHECK(io.PendingCount() == 0);
+            CHECK(io.GetIOStats().m_NumTiles == kNumRequests);
+            io.Flush(nullptr, 0);
+        }
+
+        // Private workers: they read while the owner waits, so only the waiting
+        // thread's own CPU time has to stay near zero
+        {
+            AsyncTileIO io(nullptr, backend, AsyncTileIO::kDefaultQueueDepth, 0, 0);
+
+            source.m_Reader->DropCachedPages();
+            for (uint32_t i = 0; i < kNumRequests * 16; ++i)
+                io.Submit(MakeRequest(source, i));
+
+            const Clock::time_point waitStart = Clock::now();
+            const double cpuStart = GetThreadCPUSeconds();
+            io.WaitIdle();
+            const double cpuSeconds = GetThreadCPUSeconds() - cpuStart;
+            const double waitSeconds = SecondsSince(waitStart);
+
+            std::printf("  private workers, %s: WaitIdle %.1f ms, waiting thread CPU %.1f ms\n",
+                        backend == AsyncTileIO::IOBackend::MemoryMapped ? "mmap" : "explicit", waitSeconds * 1e3, cpuSeconds * 1e3);
+            CHECK(cpuSeconds < kMaxWaitCPUSeconds);
+            CHECK(cpuSeconds <= waitSeconds * 0.5 + 0.02);
+            CHECK(io.PendingCount() == 0);
+            CHECK(io.GetIOStats().m_NumTiles == kNumRequests * 16);
+            io.Flush(nullptr, 0);
+        }
+    }
+}
+
+TEST_CASE(AsyncTileIO, WaitIdleCoversEveryProducersSubmits)
+{
+    constexpr uint32_t kNumProducers = 4;
+    constexpr uint32_t kNumRounds    = 20;
+    constexpr uint32_t kNumPerRound  = 50;
+
+    TempSource source("HobbyRendererTests_AsyncTileIO_producers.bin");
+    REQUIRE(source.m_Reader->IsValid());
+
+    // Each producer owns an AsyncTileIO (the threading contract) and alternates
+    // submit bursts with WaitIdle.  With the lane, all of them share its threads,
+    // so one producer's WaitIdle overlaps the others' tiles.
+    for (bool bUseLane : { false, true })
+    {
+        TaskScheduler scheduler;
+        std::atomic<uint32_t> numEarlyReturns{ 0 };
+        std::atomic<uint64_t> numTilesDone{ 0 };
+
+        std::vector<std::thread> producers;
+        for (uint32_t p = 0; p < kNumProducers; ++p)
+        {
+            producers.emplace_back([&, p]() {
+                const AsyncTileIO::IOBackend backend = (p % 2) ? AsyncTileIO::IOBackend::ExplicitRead : AsyncTileIO::IOBackend::MemoryMapped;
+                AsyncTileIO io(nullptr, backend, 8, 0, 0, bUseLane ? &scheduler : nullptr);
+
+                uint64_t numSubmitted = 0;
+                for (uint32_t round = 0; round < kNumRounds; ++round)
+                {
+                    // Submitted in two parts, the second while the workers are on the first
+                    for (uint32_t i = 0; i < kNumPerRound; ++i)
+                    {
+                        io.Submit(MakeRequest(source, p * 7 + round * kNumPerRound + i));
+                        numSubmitted++;
+                        if (i == kNumPerRound / 2)
+                            std::this_thread::yield();
+                    }
+
+                    io.WaitIdle();
+                    if (io.PendingCount() != 0 || io.GetIOStats().m_NumTiles != numSubmitted)
+                        numEarlyReturns.fetch_add(1);
+                    io.Flush(nullptr, round);
+                }
+                numTilesDone.fetch_add(io.GetIOStats().m_NumTiles);
+            });
+        }
+        for (std::thread& producer : producers)
+            producer.join();
+
+        std::printf("  %s: %llu tiles from %u producers, %u early WaitIdle returns\n",
+                    bUseLane ? "I/O lane" : "private workers", (unsigned long long)numTilesDone.load(), kNumProducers, numEarlyReturns.load());
+        CHECK(numEarlyReturns.load() == 0);
+        CHECK(numTilesDone.load() == (uint64_t)kNumProducers * kNumRounds * kNumPerRound);
+    }
+}
+
+TEST_CASE(AsyncTileIO, DestructionFinishesQueuedRequests)
+{
+    TempSource source("HobbyRendererTests_AsyncTileIO_destroy.bin");
+    REQUIRE(source.m_Reader->IsValid());
+
+    for (bool bUseLane : { false, true })
+    {
+        TaskScheduler scheduler;
+        {
+            AsyncTileIO io(nullptr, AsyncTileIO::IOBackend::ExplicitRead, AsyncTileIO::kDefaultQueueDepth, 0, 0, bUseLane ? &scheduler : nullptr);
+            if (bUseLane)
+                HoldIOLane(scheduler, 50);
+            for (uint32_t i = 0; i < 500; ++i)
+                io.Submit(MakeRequest(source, i));
+            if (bUseLane)
+                CHECK(io.PendingCount() == 500);
+        }
+
+        // The lane tasks no longer reference the destroyed AsyncTileIO
+        std::atomic<bool> bRan{ false };
+        scheduler.ScheduleIOTask([&bRan]() { bRan.store(true); });
+        const Clock::time_point start = Clock::now();
+        while (!bRan.load() && SecondsSince(start) < 10.0)
+            std::this_thread::yield();
+        CHECK(bRan.load());
+    }
+}
@@ -0,0 +1,295 @@
+#include "TestFramework.h"
+
+#include "CPURayQuery.h"
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr uint32_t kNumSoupTriangles = 300;
+    constexpr uint32_t kGridSize         = 12; // quads per side
+    constexpr uint32_t kNumInstances     = 40;
+    constexpr uint32_t kNumRays          = 4000;
+
+    // Barycentrics or t this close to a boundary may round either way in float
+    constexpr double kEdgeEpsilon = 1e-4;
+
+    enum Materials : uint32_t
+    {
+        kMaterialOpaque,
+        kMaterialMaskedKept,    // alpha 1 >= cutoff: always passes
+        kMaterialMaskedCutAway, // alpha 0.2 < cutoff: never hit
+        kNumMaterials
+    };
+
+    // Cooked-layout geometry: one vertex array, global indices, two LODs per MeshData
+    struct TestGeometry
+    {
+        std::vector<srrhi::VertexQuantized> m_Vertices;
+        std::vector<uint32_t>               m_Indices;
+    };
+
+    void AddLOD(srrhi::MeshData& meshData, TestGeometry& geometry, const std::vector<uint32_t>& indices)
+    {
+        meshData.m_IndexOffsets[meshData.m_LODCount] = (uint32_t)geometry.m_Indices.size();
+        meshData.m_IndexCounts[meshData.m_LODCount] = (uint32_t)indices.size();
+        meshData.m_LODCount++;
+        geometry.m_Indices.insert(geometry.m_Indices.end(), indices.begin(), indices.end());
+    }
+
+    void BuildTestScene(Scene& scene, TestGeometry& geometry, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        auto addVertex = [&](float x, float y, float z) {
+            srrhi::VertexQuantized& vertex = geometry.m_Vertices.emplace_back();
+            vertex.m_Pos = Vector3{ x, y, z };
+            return (uint32_t)geometry.m_Vertices.size() - 1;
+        };
+
+        // MeshData 0: a soup of small triangles, with a degenerate and a non-finite one.
+        // LOD 1 is every other triangle.
+        {
+            std::vector<uint32_t> lod0, lod1;
+            for (uint32_t i = 0; i < kNumSoupTriangles; ++i)
+            {
+                const float x = unit(rng) * 2.0f - 1.0f, y = unit(rng) * 2.0f - 1.0f, z = unit(rng) * 2.0f - 1.0f;
+                const uint32_t v0 = addVertex(x, y, z);
+                const uint32_t v1 = addVertex(x + unit(rng) * 0.5f - 0.25f, y + unit(rng) * 0.5f - 0.25f, z + unit(rng) * 0.5f - 0.25f);
+                const uint32_t v2 = (i == 7) ? v1 : addVertex(x + unit(rng) * 0.5f - 0.25f, y + unit(rng) * 0.5f - 0.25f, z + unit(rng) * 0.5f - 0.25f);
+                if (i == 11)
+                    geometry.m_Vertices[v2].m_Pos.x = std::numeric_limits<float>::quiet_NaN();
+                lod0.insert(lod0.end(), { v0, v1, v2 });
+                if (i % 2 == 0)
+                    lod1.insert(lod1.end(), { v0, v1, v2 });
+            }
+            srrhi::MeshData& meshData = scene.m_MeshData.emplace_back();
+            AddLOD(meshData, geometry, lod0);
+            AddLOD(meshData, geometry, lod1);
+        }
+
+        // MeshData 1: a bumpy height field; LOD 1 is the first half of the rows
+        {
+            const uint32_t firstVertex = (uint32_t)geometry.m_Vertices.size();
+            for (uint32_t y = 0; y <= kGridSize; ++y)
+            {
+                for (uint32_t x = 0; x <= kGridSize; ++x)
+                    addVertex(float(x) / kGridSize * 2.0f - 1.0f, unit(rng) * 0.2f, float(y) / kGridSize * 2.0f - 1.0f);
+            }
+            std::vector<uint32_t> lod0, lod1;
+            for (uint32_t y = 0; y < kGridSize; ++y)
+            {
+                for (uint32_t x = 0; x < kGridSize; ++x)
+                {
+                    const uint32_t v = firstVertex + y * (kGridSize + 1) + x;
+                    const uint32_t quad[6] = { v, v + kGridSize + 1, v + 1, v + 1, v + kGridSize + 1, v + kGridSize + 2 };
+                    lod0.insert(lod0.end(), std::begin(quad), std::end(quad));
+                    if (y < kGridSize / 2)
+                        lod1.insert(lod1.end(), std::begin(quad), std::end(quad));
+                }
+            }
+            srrhi::MeshData& meshData = scene.m_MeshData.emplace_back();
+            AddLOD(meshData, geometry, lod0);
+            AddLOD(meshData, geometry, lod1);
+        }
+
+        scene.m_Materials.resize(kNumMaterials);
+        scene.m_Materials[kMaterialOpaque].m_GPU.m_AlphaMode = (uint32_t)srrhi::CommonConsts::ALPHA_MODE_OPAQUE;
+        for (uint32_t material : { kMaterialMaskedKept, kMaterialMaskedCutAway })
+        {
+            srrhi::MaterialConstants& gpu = scene.m_Materials[material].m_GPU;
+            gpu.m_AlphaMode = (uint32_t)srrhi::CommonConsts::ALPHA_MODE_MASK;
+            gpu.m_AlphaCutoff = 0.5f;
+            gpu.m_TextureFlags = 0;
+            gpu.m_BaseColor.w = material == kMaterialMaskedKept ? 1.0f : 0.2f;
+        }
+
+        // Rotated, scaled and translated instances; the last one is singular
+        scene.m_InstanceData.resize(kNumInstances);
+        for (uint32_t i = 0; i < kNumInstances; ++i)
+        {
+            srrhi::PerInstanceData& instance = scene.m_InstanceData[i];
+            instance.m_MeshDataIndex = i % 2;
+            instance.m_MaterialIndex = (i % 5 == 3) ? kMaterialMaskedKept : ((i % 7 == 5) ? kMaterialMaskedCutAway : kMaterialOpaque);
+
+            const float scale = (i == kNumInstances - 1) ? 0.0f : 0.5f + unit(rng) * 2.0f;
+            const XMMATRIX world = XMMatrixScaling(scale, scale * (0.5f + unit(rng)), scale) *
+                                   XMMatrixRotationRollPitchYaw(unit(rng) * XM_2PI, unit(rng) * XM_2PI, unit(rng) * XM_2PI) *
+                                   XMMatrixTranslation(unit(rng) * 16.0f - 8.0f, unit(rng) * 16.0f - 8.0f, unit(rng) * 16.0f - 8.0f);
+            XMStoreFloat4x4(&instance.m_World, world);
+        }
+    }
+
+    struct BruteForceHit
+    {
+        double   m_T = DBL_MAX;
+        uint32_t m_InstanceIndex = UINT32_MAX;
+        uint32_t m_PrimitiveIndex = 0;
+    };
+
+    struct BruteForceResult
+    {
+        BruteForceHit m_Closest;
+        bool          m_bAmbiguous = false; // a hit or miss close enough to an edge to round either way
+    };
+
+    // Every triangle of every instance in world space, double precision, no culling
+    BruteForceResult TraceBruteForce(const Scene& scene, const TestGeometry& geometry, uint32_t lod, const CPURay& ray)
+    {
+        BruteForceResult result;
+        const double o[3] = { ray.m_Origin.x, ray.m_Origin.y, ray.m_Origin.z };
+        const double d[3] = { ray.m_Direction.x, ray.m_Direction.y, ray.m_Direction.z };
+        auto sub = [](const double* a, const double* b, double* out) { for (int k = 0; k < 3; ++k) out[k] = a[k] - b[k]; };
+        auto dot = [](const double* a, const double* b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+        auto cross = [](const double* a, const double* b, double* out) {
+            out[0] = a[1] * b[2] - a[2] * b[1];
+            out[1] = a[2] * b[0] - a[0] * b[2];
+            out[2] = a[0] * b[1] - a[1] * b[0];
+        };
+
+        for (uint32_t instanceIndex = 0; instanceIndex < (uint32_t)scene.m_InstanceData.size(); ++instanceIndex)
+        {
+            const srrhi::PerInstanceData& instance = scene.m_InstanceData[instanceIndex];
+            if (instance.m_MaterialIndex == kMaterialMaskedCutAway)
+                continue;
+
+            const XMMATRIX world = XMLoadFloat4x4(&instance.m_World);
+            const srrhi::MeshData& meshData = scene.m_MeshData[instance.m_MeshDataIndex];
+            const uint32_t offset = meshData.m_IndexOffsets[lod];
+            for (uint32_t triangle = 0; triangle < meshData.m_IndexCounts[lod] / 3; ++triangle)
+            {
+                double v[3][3];
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    const Vector3& p = geometry.m_Vertices[geometry.m_Indices[offset + triangle * 3 + corner]].m_Pos;
+                    XMFLOAT3 w;
+                    XMStoreFloat3(&w, XMVector3Transform(XMVectorSet(p.x, p.y, p.z, 1.0f), world));
+                    v[corner][0] = w.x;
+                    v[corner][1] = w.y;
+                    v[corner][2] = w.z;
+                }
+
+                double e1[3], e2[3], s[3], p[3], q[3];
+                sub(v[1], v[0], e1);
+                sub(v[2], v[0], e2);
+                cross(d, e2, p);
+                const double det = dot(e1, p);
+                if (!(std::abs(det) > 1e-12))
+                    continue;
+                sub(o, v[0], s);
+                cross(s, e1, q);
+                const double u = dot(s, p) / det;
+                const double w = dot(d, q) / det;
+                const double t = dot(e2, q) / det;
+
+                // Hits, or near misses, that float rounding could flip
+                const double margin = std::min({ u, w, 1.0 - u - w });
+                const double tScale = std::max(1.0, std::abs(t));
+                const bool bNearEdge = std::abs(margin) < kEdgeEpsilon;
+                const bool bNearTRange = std::abs(t - ray.m_TMin) < kEdgeEpsilon * tScale || std::abs(t - ray.m_TMax) < kEdgeEpsilon * tScale;
+                const bool bInTRange = t >= ray.m_TMin && t <= ray.m_TMax;
+                if ((bNearEdge && (bInTRange || bNearTRange)) || (bNearTRange && margin >= 0.0))
+                    result.m_bAmbiguous = true;
+                if (margin < 0.0 || !bInTRange)
+                    continue;
+                if (std::abs(t - result.m_Closest.m_T) < kEdgeEpsilon * tScale)
+                    result.m_bAmbiguous = true; // two surfaces at the same distance
+                if (t < result.m_Closest.m_T)
+                    result.m_Closest = { t, instanceIndex, triangle };
+            }
+        }
+        return result;
+    }
+
+    std::vector<CPURay> MakeRays(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<CPURay> rays(kNumRays);
+        for (uint32_t i = 0; i < kNumRays; ++i)
+        {
+            CPURay& ray = rays[i];
+            ray.m_Origin = Vector3{ unit(rng) * 24.0f - 12.0f, unit(rng) * 24.0f - 12.0f, unit(rng) * 24.0f - 12.0f };
+            const Vector3 target{ unit(rng) * 16.0f - 8.0f, unit(rng) * 16.0f - 8.0f, unit(rng) * 16.0f - 8.0f };
+            // Unnormalized on purpose: t is in units of the direction
+            ray.m_Direction = Vector3{ target.x - ray.m_Origin.x, target.y - ray.m_Origin.y, target.z - ray.m_Origin.z };
+            ray.m_TMin = (i % 3 == 0) ? 0.0f : unit(rng) * 0.3f;
+            ray.m_TMax = (i % 4 == 0) ? 0.5f + unit(rng) : FLT_MAX;
+        }
+        return rays;
+    }
+} // namespace
+
+TEST_CASE(CPURayQuery, MatchesBruteForce)
+{
+    TaskScheduler scheduler;
+    std::mt19937 rng(2024);
+
+    Scene scene;
+    TestGeometry geometry;
+    BuildTestScene(scene, geometry, rng);
+
+    Scene::CPUGeometryView view;
+    view.m_MeshData = scene.m_MeshData;
+    view.m_VerticesQuantized = geometry.m_Vertices;
+    view.m_Indices = geometry.m_Indices;
+
+    const std::vector<CPURay> rays = MakeRays(rng);
+    for (uint32_t lod = 0; lod < 2; ++lod)
+    {
+        CPUSceneRayQuery rayQuery;
+        REQUIRE(rayQuery.Build(scene, view, scheduler, lod));
+        // The singular instance is left out of the top level
+        CHECK(rayQuery.GetStats().m_NumInstances == kNumInstances - 1);
+
+        std::vector<CPURayHit> hits(rays.size());
+        std::vector<uint8_t> occluded(rays.size());
+        rayQuery.TraceClosest(rays, hits, scheduler);
+        rayQuery.TraceAny(rays, occluded, scheduler);
+
+        uint32_t numChecked = 0;
+        uint32_t numHits = 0;
+        uint32_t numMismatches = 0;
+        for (uint32_t i = 0; i < (uint32_t)rays.size(); ++i)
+        {
+            const BruteForceResult expected = TraceBruteForce(scene, geometry, lod, rays[i]);
+            if (expected.m_bAmbiguous)
+                continue;
+            numChecked++;
+
+            const CPURayHit& hit = hits[i];
+            const bool bExpectedHit = expected.m_Closest.m_InstanceIndex != UINT32_MAX;
+            bool bMatch = hit.IsHit() == bExpectedHit && (occluded[i] != 0) == bExpectedHit;
+            if (bMatch && bExpectedHit)
+            {
+                numHits++;
+                bMatch = hit.m_InstanceIndex == expected.m_Closest.m_InstanceIndex &&
+                         hit.m_PrimitiveIndex == expected.m_Closest.m_PrimitiveIndex &&
+                         std::abs(hit.m_RayT - expected.m_Closest.m_T) <= 1e-3 * std::max(1.0, expected.m_Closest.m_T);
+            }
+
+            // The single-ray entry points agree with the batches
+            CPURayHit single;
+            bMatch = bMatch && rayQuery.TraceClosest(rays[i], single) == hit.IsHit() && single.m_InstanceIndex == hit.m_InstanceIndex &&
+                     single.m_RayT == hit.m_RayT && rayQuery.TraceAny(rays[i]) == (occluded[i] != 0);
+
+            if (!bMatch && numMismatches++ < 5)
+            {
+                std::printf("  LOD %u ray %u: expected instance %u triangle %u t %.5f, got instance %u triangle %u t %.5f, any %u\n",
+                            lod, i, expected.m_Closest.m_InstanceIndex, expected.m_Closest.m_PrimitiveIndex, expected.m_Closest.m_T,
+                            hit.m_InstanceIndex, hit.m_PrimitiveIndex, hit.m_RayT, (uint32_t)occluded[i]);
+            }
+        }
+
+        std::printf("  LOD %u: %u rays checked (%u hits), %u mismatches\n", lod, numChecked, numHits, numMismatches);
+        CHECK(numChecked > kNumRays / 2);
+        CHECK(numHits > numChecked / 10);
+        CHECK(numMismatches == 0);
+    }
+}
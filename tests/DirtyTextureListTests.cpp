@@ -0,0 +1,206 @@
+#include "TestFramework.h"
+
+#include "Streaming/DirtyTextureList.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    // Just enough of TTM's tile states to decide which textures a full scan of
+    // GetTilesToUnmap()/GetTilesToMap() would find work on
+    struct MockTileManager
+    {
+        struct Texture
+        {
+            uint32_t m_NumRequested = 0; // waiting for a heap tile
+            uint32_t m_NumToMap     = 0; // allocated, not collected yet
+            uint32_t m_NumMapped    = 0; // collected
+            uint32_t m_NumToUnmap   = 0;
+        };
+
+        std::vector<Texture> m_Textures;
+        uint32_t m_NumFreeHeapTiles = 0;
+
+        bool HasWork(uint32_t textureIdx) const
+        {
+            return m_Textures[textureIdx].m_NumToMap > 0 || m_Textures[textureIdx].m_NumToUnmap > 0;
+        }
+
+        // Unmapping gives the heap tiles back right away, as TTM does
+        void Unmap(Texture& texture, uint32_t numTiles)
+        {
+            numTiles = std::min(numTiles, texture.m_NumMapped);
+            texture.m_NumMapped -= numTiles;
+            texture.m_NumToUnmap += numTiles;
+            m_NumFreeHeapTiles += numTiles;
+        }
+
+        void AllocateRequestedTiles()
+        {
+            for (Texture& texture : m_Textures)
+            {
+                const uint32_t numTiles = std::min(texture.m_NumRequested, m_NumFreeHeapTiles);
+                texture.m_NumRequested -= numTiles;
+                texture.m_NumToMap += numTiles;
+                m_NumFreeHeapTiles -= numTiles;
+            }
+        }
+    };
+} // namespace
+
+TEST_CASE(DirtyTextureList, FindsEveryTextureAFullScanWould)
+{
+    constexpr uint32_t kNumFrames = 2000;
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_int_distribution<uint32_t> tileCountDist(1, 24);
+
+    MockTileManager ttm;
+    ttm.m_NumFreeHeapTiles = 600;
+    DirtyTextureList dirtyTextures;
+    for (uint32_t textureIdx = 0; textureIdx < 64; ++textureIdx)
+    {
+        ttm.m_Textures.emplace_back();
+        dirtyTextures.AddTexture();
+    }
+
+    uint64_t numScanned = 0;
+    uint64_t numFullScan = 0;
+    uint32_t numMissed = 0;
+    uint32_t numOutOfOrder = 0;
+    uint32_t numResidentMismatches = 0;
+
+    for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+    {
+        // Textures come and go with scene changes
+        if (unit(rng) < 0.01f && ttm.m_Textures.size() > 8)
+        {
+            const uint32_t textureIdx = std::uniform_int_distribution<uint32_t>(0, (uint32_t)ttm.m_Textures.size() - 1)(rng);
+            const MockTileManager::Texture& texture = ttm.m_Textures[textureIdx];
+            ttm.m_NumFreeHeapTiles += texture.m_NumToMap + texture.m_NumMapped;
+            ttm.m_Textures.erase(ttm.m_Textures.begin() + textureIdx);
+            dirtyTextures.RemoveTexture(textureIdx);
+        }
+        if (unit(rng) < 0.01f)
+        {
+            ttm.m_Textures.emplace_back();
+            dirtyTextures.AddTexture();
+        }
+
+        // Feedback for a few visible textures: new requests and hysteresis timeouts
+        const uint32_t numTextures = (uint32_t)ttm.m_Textures.size();
+        std::uniform_int_distribution<uint32_t> textureDist(0, numTextures - 1);
+        for (uint32_t i = 0; i < 6; ++i)
+        {
+            const uint32_t textureIdx = textureDist(rng);
+            MockTileManager::Texture& texture = ttm.m_Textures[textureIdx];
+            if (unit(rng) < 0.6f)
+                texture.m_NumRequested += tileCountDist(rng);
+            if (unit(rng) < 0.3f)
+                ttm.Unmap(texture, tileCountDist(rng));
+            dirtyTextures.MarkDirty(textureIdx);
+        }
+
+        // Standby trimming when the heaps run low touches any texture with tiles
+        if (ttm.m_NumFreeHeapTiles < 40)
+        {
+            bool bTrimmed = false;
+            for (MockTileManager::Texture& texture : ttm.m_Textures)
+            {
+                if (texture.m_NumMapped > 0 && unit(rng) < 0.3f)
+                {
+                    ttm.Unmap(texture, tileCountDist(rng));
+                    bTrimmed = true;
+                }
+            }
+            if (bTrimmed)
+                dirtyTextures.MarkResidentDirty();
+        }
+
+        ttm.AllocateRequestedTiles();
+
+        // What a full scan would find
+        std::vector<uint32_t> expected;
+        for (uint32_t textureIdx = 0; textureIdx < numTextures; ++textureIdx)
+        {
+            if (ttm.HasWork(textureIdx))
+                expected.push_back(textureIdx);
+        }
+        numFullScan += numTextures;
+
+        // Collection over the dirty list only
+        const std::span<const uint32_t> dirty = dirtyTextures.GetDirtyTextures();
+        numScanned += dirty.size();
+        if (!std::is_sorted(dirty.begin(), dirty.end()))
+            numOutOfOrder++;
+        for (uint32_t textureIdx : dirty)
+        {
+            MockTileManager::Texture& texture = ttm.m_Textures[textureIdx];
+            if (texture.m_NumToUnmap > 0)
+                dirtyTextures.OnTilesUnmapped(textureIdx, std::exchange(texture.m_NumToUnmap, 0));
+            if (texture.m_NumToMap > 0)
+            {
+                dirtyTextures.OnTilesAllocated(textureIdx, texture.m_NumToMap);
+                texture.m_NumMapped += std::exchange(texture.m_NumToMap, 0);
+            }
+        }
+        for (uint32_t textureIdx : expected)
+        {
+            if (ttm.HasWork(textureIdx))
+                numMissed++;
+        }
+
+        uint32_t numResident = 0;
+        for (const MockTileManager::Texture& texture : ttm.m_Textures)
+            numResident += texture.m_NumMapped > 0;
+        if (numResident != dirtyTextures.GetNumResidentTextures())
+            numResidentMismatches++;
+
+        if (ttm.m_NumFreeHeapTiles > 0)
+            dirtyTextures.Clear();
+    }
+
+    std::printf("  %llu textures scanned instead of %llu, %u missed\n",
+        (unsigned long long)numScanned, (unsigned long long)numFullScan, numMissed);
+    CHECK(numMissed == 0);
+    CHECK(numOutOfOrder == 0);
+    CHECK(numResidentMismatches == 0);
+    CHECK(numScanned < numFullScan / 2);
+}
+
+TEST_CASE(DirtyTextureList, RemoveTextureShiftsLaterTextures)
+{
+    DirtyTextureList dirtyTextures;
+    for (uint32_t textureIdx = 0; textureIdx < 5; ++textureIdx)
+        dirtyTextures.AddTexture();
+    dirtyTextures.Clear();
+
+    dirtyTextures.OnTilesAllocated(1, 4);
+    dirtyTextures.OnTilesAllocated(4, 2);
+    dirtyTextures.MarkDirty(3);
+    dirtyTextures.MarkDirty(1);
+
+    // Texture 1 goes; 3 and 4 become 2 and 3
+    dirtyTextures.RemoveTexture(1);
+    CHECK(dirtyTextures.GetNumTextures() == 4);
+    CHECK(dirtyTextures.GetNumResidentTextures() == 1);
+    const std::span<const uint32_t> dirty = dirtyTextures.GetDirtyTextures();
+    REQUIRE(dirty.size() == 1);
+    CHECK(dirty[0] == 2);
+
+    // The resident texture (was 4) is marked by a trim
+    dirtyTextures.Clear();
+    dirtyTextures.MarkResidentDirty();
+    REQUIRE(dirtyTextures.GetNumDirtyTextures() == 1);
+    CHECK(dirtyTextures.GetDirtyTextures()[0] == 3);
+
+    // Unmapping its last tiles makes it non-resident
+    dirtyTextures.OnTilesUnmapped(3, 2);
+    CHECK(dirtyTextures.GetNumResidentTextures() == 0);
+}
@@ -0,0 +1,330 @@
+#include "TestFramework.h"
+
+#include "FrameCaptureQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../external/stb_image.h"
+
+namespace
+{
+    using FileFormat  = FrameCaptureQueue::FileFormat;
+    using PixelFormat = FrameCaptureQueue::PixelFormat;
+    using EncodeJob   = FrameCaptureQueue::EncodeJob;
+
+    // Records the jobs the encoder threads were given instead of writing them
+    struct RecordingEncoder
+    {
+        std::mutex               m_Mutex;
+        std::vector<std::string> m_Paths;
+
+        FrameCaptureQueue::EncodeFn GetFn()
+        {
+            return [this](const EncodeJob& job) {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Paths.push_back(job.m_Path);
+                return true;
+            };
+        }
+    };
+
+    std::vector<uint8_t> MakePixels(uint32_t width, uint32_t height, uint32_t bytesPerPixel)
+    {
+        std::vector<uint8_t> pixels((size_t)width * height * bytesPerPixel);
+        for (size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = (uint8_t)(i * 37 + i / 7);
+        return pixels;
+    }
+
+    // One retire + record step of the frame loop, as FrameCapture does it
+    void RunFrame(FrameCaptureQueue& queue, uint32_t frameNumber)
+    {
+        uint32_t slots[FrameCaptureQueue::kNumReadbackSlots];
+        const uint32_t numSlots = queue.GetRetirableSlots(frameNumber, slots);
+        for (uint32_t i = 0; i < numSlots; ++i)
+            queue.RetireSlot(slots[i], MakePixels(4, 4, 4));
+
+        if (queue.IsCapturePending())
+        {
+            while (!queue.HasFreeSlot())
+                queue.RetireSlot(queue.GetOldestInFlightSlot(), MakePixels(4, 4, 4));
+            queue.BeginCapture(frameNumber, 4, 4, PixelFormat::RGBA8);
+        }
+    }
+
+    // Reads back the layout FrameCaptureQueue::WriteEXR produces (uncompressed
+    // scanlines, channels A, B, G, R) as interleaved RGBA
+    bool ReadEXR(const std::filesystem::path& path, uint32_t width, uint32_t height, uint32_t bytesPerComponent, std::vector<uint8_t>& outPixels)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (bytes.size() < 8 || *reinterpret_cast<const uint32_t*>(bytes.data()) != 20000630)
+            return false;
+
+        // Attributes: name\0 type\0 int32 size, data; an empty name ends the header
+        size_t offset = 8;
+        while (offset < bytes.size() && bytes[offset] != 0)
+        {
+            offset += std::strlen(reinterpret_cast<const char*>(&bytes[offset])) + 1;
+            offset += std::strlen(reinterpret_cast<const char*>(&bytes[offset])) + 1;
+            int32_t size = 0;
+            std::memcpy(&size, &bytes[offset], sizeof(size));
+            offset += sizeof(size) + size;
+        }
+        offset += 1;
+
+        const uint32_t kChannelTarget[] = { 3, 2, 1, 0 }; // A, B, G, R -> RGBA
+        outPixels.assign((size_t)width * height * 4 * bytesPerComponent, 0);
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            uint64_t chunkOffset = 0;
+            std::memcpy(&chunkOffset, &bytes[offset + y * sizeof(uint64_t)], sizeof(chunkOffset));
+            int32_t chunkY = -1;
+            std::memcpy(&chunkY, &bytes[chunkOffset], sizeof(chunkY));
+            if (chunkY != (int32_t)y || chunkOffset + 8 + (size_t)width * 4 * bytesPerComponent > bytes.size())
+                return false;
+
+            const uint8_t* samples = &bytes[chunkOffset + 8];
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    uint8_t* dst = &outPixels[(((size_t)y * width + x) * 4 + kChannelTarget[c]) * bytesPerComponent];
+                    std::memcpy(dst, samples, bytesPerComponent);
+                    samples += bytesPerComponent;
+                }
+            }
+        }
+        return true;
+    }
+} // namespace
+
+TEST_CASE(FrameCapture, RetiresAfterTheReadbackLatency)
+{
+    RecordingEncoder encoder;
+    FrameCaptureQueue queue;
+    queue.Start(1, "shots/", encoder.GetFn());
+
+    // Across the frame counter's wrap-around too
+    for (uint32_t frame : { 10u, UINT32_MAX - 1 })
+    {
+        uint32_t slots[FrameCaptureQueue::kNumReadbackSlots];
+        queue.RequestScreenshot();
+        const uint32_t slot = queue.BeginCapture(frame, 4, 4, PixelFormat::RGBA8);
+        REQUIRE(slot != FrameCaptureQueue::kInvalidSlot);
+        CHECK(!queue.IsCapturePending());
+        CHECK(queue.GetSlot(slot).m_Path == "shots/screenshot.png");
+
+        for (uint32_t age = 0; age < FrameCaptureQueue::kReadbackLatencyFrames; ++age)
+            CHECK(queue.GetRetirableSlots(frame + age, slots) == 0);
+        REQUIRE(queue.GetRetirableSlots(frame + FrameCaptureQueue::kReadbackLatencyFrames, slots) == 1);
+        CHECK(slots[0] == slot);
+        queue.RetireSlot(slot, MakePixels(4, 4, 4));
+    }
+
+    // Nothing pending: no slot is taken
+    CHECK(queue.BeginCapture(20, 4, 4, PixelFormat::RGBA8) == FrameCaptureQueue::kInvalidSlot);
+
+    queue.Stop();
+    CHECK(encoder.m_Paths.size() == 2);
+}
+
+TEST_CASE(FrameCapture, SequenceWrapsAroundTheRing)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "HobbyRendererTests_FrameCapture_sequence";
+    constexpr uint32_t kNumFrames = 20;
+
+    RecordingEncoder encoder;
+    FrameCaptureQueue queue;
+    queue.Start(1, {}, encoder.GetFn());
+    REQUIRE(queue.StartSequence(directory.string(), kNumFrames));
+
+    // Every slot is re-used several times while the frame counter wraps; one
+    // capture per frame never needs more than the ring, so nothing is retired early
+    uint32_t frame = UINT32_MAX - 7;
+    uint32_t numEarlyRetires = 0;
+    for (uint32_t i = 0; i < kNumFrames + FrameCaptureQueue::kReadbackLatencyFrames; ++i, ++frame)
+    {
+        if (queue.IsCapturePending() && !queue.HasFreeSlot())
+            numEarlyRetires++;
+        RunFrame(queue, frame);
+    }
+    CHECK(numEarlyRetires == 0);
+    CHECK(!queue.IsSequenceActive());
+    CHECK(queue.GetOldestInFlightSlot() == FrameCaptureQueue::kInvalidSlot);
+
+    queue.Stop();
+
+    // One encoder thread: the files arrive in order, without gaps
+    REQUIRE(encoder.m_Paths.size() == kNumFrames);
+    for (uint32_t i = 0; i < kNumFrames; ++i)
+    {
+        char fileName[32];
+        std::snprintf(fileName, sizeof(fileName), "frame_%05u.png", i);
+        CHECK(encoder.m_Paths[i] == (directory / fileName).string());
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+}
+
+TEST_CASE(FrameCapture, FullRingRetiresTheOldestForAScreenshot)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "HobbyRendererTests_FrameCapture_full";
+
+    RecordingEncoder encoder;
+    FrameCaptureQueue queue;
+    queue.Start(1, {}, encoder.GetFn());
+    REQUIRE(queue.StartSequence(directory.string()));
+
+    // Captures recorded faster than the ring retires them fill it
+    for (uint32_t i = 0; i < FrameCaptureQueue::kNumReadbackSlots; ++i)
+        queue.BeginCapture(100 + i, 4, 4, PixelFormat::RGBA8);
+    CHECK(!queue.HasFreeSlot());
+
+    queue.RequestScreenshot("shot.png");
+    const uint32_t oldest = queue.GetOldestInFlightSlot();
+    REQUIRE(oldest != FrameCaptureQueue::kInvalidSlot);
+    CHECK(queue.GetSlot(oldest).m_RecordedFrame == 100);
+
+    // FrameCapture maps (waits for) the oldest slot, which frees it for the screenshot
+    queue.RetireSlot(oldest, MakePixels(4, 4, 4));
+    const uint32_t slot = queue.BeginCapture(103, 4, 4, PixelFormat::RGBA8);
+    REQUIRE(slot == oldest);
+    CHECK(queue.GetSlot(slot).m_Path == "shot.png");
+
+    // The screenshot did not take a sequence number
+    queue.StopSequence();
+    for (uint32_t s = queue.GetOldestInFlightSlot(); s != FrameCaptureQueue::kInvalidSlot; s = queue.GetOldestInFlightSlot())
+        queue.RetireSlot(s, MakePixels(4, 4, 4));
+    queue.Stop();
+
+    REQUIRE(encoder.m_Paths.size() == FrameCaptureQueue::kNumReadbackSlots + 1);
+    CHECK(encoder.m_Paths[0] == (directory / "frame_00000.png").string());
+    CHECK(encoder.m_Paths[1] == (directory / "frame_00001.png").string());
+    CHECK(encoder.m_Paths[2] == (directory / "frame_00002.png").string());
+    CHECK(encoder.m_Paths[3] == "shot.png");
+
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+}
+
+TEST_CASE(FrameCapture, FullEncoderQueueBlocksInsteadOfDropping)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "HobbyRendererTests_FrameCapture_backpressure";
+    constexpr uint32_t kNumFrames = FrameCaptureQueue::kMaxQueuedEncodeJobs + 8;
+
+    // The encoder holds its first job until released, so the queue fills up
+    std::atomic<bool>     bReleased{ false };
+    std::atomic<uint32_t> numEncoded{ 0 };
+    FrameCaptureQueue queue;
+    queue.Start(1, {}, [&](const EncodeJob&) {
+        while (!bReleased.load())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        numEncoded.fetch_add(1);
+        return true;
+    });
+    REQUIRE(queue.StartSequence(directory.string(), kNumFrames));
+
+    std::atomic<uint32_t> numFramesRun{ 0 };
+    std::thread frameLoop([&]() {
+        for (uint32_t frame = 0; frame < kNumFrames + FrameCaptureQueue::kReadbackLatencyFrames; ++frame)
+        {
+            RunFrame(queue, frame);
+            numFramesRun.fetch_add(1);
+        }
+    });
+
+    // The frame loop waits for the encoders once the queue is full
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const uint32_t numFramesWhileBlocked = numFramesRun.load();
+    std::printf("  frame loop blocked after %u of %u frames, %u encode(s) pending\n",
+                numFramesWhileBlocked, kNumFrames + FrameCaptureQueue::kReadbackLatencyFrames, queue.GetPendingEncodeCount());
+    CHECK(numFramesWhileBlocked < kNumFrames);
+    CHECK(queue.GetPendingEncodeCount() <= FrameCaptureQueue::kMaxQueuedEncodeJobs + 1);
+
+    bReleased.store(true);
+    frameLoop.join();
+    queue.Stop();
+
+    // Every requested frame was encoded, none dropped
+    CHECK(numEncoded.load() == kNumFrames);
+    CHECK(queue.GetNumBackPressureStalls() >= 1);
+    CHECK(queue.GetBackPressureStallSeconds() > 0.1);
+
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+}
+
+TEST_CASE(FrameCapture, EncodersRoundTrip)
+{
+    constexpr uint32_t kWidth  = 37;
+    constexpr uint32_t kHeight = 11;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "HobbyRendererTests_FrameCapture_encode";
+    std::filesystem::create_directories(directory);
+
+    // EXR, half and float: written bit-exact
+    for (PixelFormat format : { PixelFormat::RGBA16_FLOAT, PixelFormat::RGBA32_FLOAT })
+    {
+        const uint32_t bytesPerComponent = (format == PixelFormat::RGBA16_FLOAT) ? 2 : 4;
+        EncodeJob job;
+        job.m_Pixels = MakePixels(kWidth, kHeight, 4 * bytesPerComponent);
+        job.m_Width = kWidth;
+        job.m_Height = kHeight;
+        job.m_Format = format;
+        job.m_FileFormat = FileFormat::PNG; // float formats are always written as EXR
+        job.m_Path = (directory / "roundtrip.exr").string();
+        REQUIRE(FrameCaptureQueue::Encode(job));
+
+        std::vector<uint8_t> read;
+        REQUIRE(ReadEXR(job.m_Path, kWidth, kHeight, bytesPerComponent, read));
+        CHECK(read == job.m_Pixels);
+    }
+
+    // PNG, RGBA and BGRA: lossless, BGRA swizzled back to RGBA
+    if (!FrameCaptureQueue::CanEncode(FileFormat::PNG))
+    {
+        std::printf("  built without stb_image_write, PNG round-trip skipped\n");
+    }
+    else
+    {
+        for (PixelFormat format : { PixelFormat::RGBA8, PixelFormat::BGRA8 })
+        {
+            EncodeJob job;
+            job.m_Pixels = MakePixels(kWidth, kHeight, 4);
+            job.m_Width = kWidth;
+            job.m_Height = kHeight;
+            job.m_Format = format;
+            job.m_Path = (directory / "roundtrip.png").string();
+            REQUIRE(FrameCaptureQueue::Encode(job));
+
+            int width = 0, height = 0, channels = 0;
+            uint8_t* decoded = stbi_load(job.m_Path.c_str(), &width, &height, &channels, 4);
+            REQUIRE(decoded);
+            CHECK(width == (int)kWidth && height == (int)kHeight);
+
+            uint32_t numMismatches = 0;
+            for (size_t i = 0; i < job.m_Pixels.size(); i += 4)
+            {
+                const uint8_t r = (format == PixelFormat::BGRA8) ? job.m_Pixels[i + 2] : job.m_Pixels[i + 0];
+                const uint8_t b = (format == PixelFormat::BGRA8) ? job.m_Pixels[i + 0] : job.m_Pixels[i + 2];
+                if (decoded[i + 0] != r || decoded[i + 1] != job.m_Pixels[i + 1] || decoded[i + 2] != b || decoded[i + 3] != job.m_Pixels[i + 3])
+                    numMismatches++;
+            }
+            CHECK(numMismatches == 0);
+            stbi_image_free(decoded);
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+}
@@ -0,0 +1,249 @@
+#include "TestFramework.h"
+
+#include "Streaming/GeometryLODScheduler.h"
+#include "Streaming/GeometryPoolAllocator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    constexpr uint32_t kNoRequest = GeometryLODScheduler::kNoRequest;
+} // namespace
+
+TEST_CASE(GeometryLODScheduler, StandInNeverShowsLessDetailThanAvailable)
+{
+    // Resident LODs 1 and 3
+    const uint8_t residentMask = 0b1010;
+    CHECK(GetStandInLOD(residentMask, 1) == 1);
+    CHECK(GetStandInLOD(residentMask, 2) == 1); // finer one resident
+    CHECK(GetStandInLOD(residentMask, 0) == 1); // only coarser ones: the nearest
+    CHECK(GetStandInLOD(residentMask, 5) == 3);
+    CHECK(GetStandInLOD(0b1000, 0) == 3);
+}
+
+TEST_CASE(GeometryLODScheduler, LoadsTheLargestDeficitFirst)
+{
+    GeometryLODScheduler scheduler;
+    const uint32_t bytes[] = { 4000, 2000, 1000, 500 };
+    const uint32_t smallBytes[] = { 400, 200, 100, 50 };
+    scheduler.AddPrimitive(4, 0b1000, bytes);
+    scheduler.AddPrimitive(4, 0b1000, smallBytes);
+    scheduler.AddPrimitive(4, 0b1111, bytes); // not streamed
+
+    // Primitive 0 wants LOD 0 (3 too coarse), 1 wants LOD 2 (1 too coarse)
+    std::vector<uint32_t> requests = { 0, 2, 0 };
+    scheduler.Update(requests, 1);
+    std::vector<GeometryLODRef> loads;
+    scheduler.GetLoads(8, UINT64_MAX, loads);
+    REQUIRE(loads.size() == 2);
+    CHECK(loads[0].m_Primitive == 0 && loads[0].m_LOD == 0);
+    CHECK(loads[1].m_Primitive == 1 && loads[1].m_LOD == 2);
+
+    // The byte budget stops after the first load, which always goes out
+    scheduler.GetLoads(8, 100, loads);
+    CHECK(loads.size() == 1);
+    scheduler.GetLoads(0, UINT64_MAX, loads);
+    CHECK(loads.empty());
+
+    // In flight: not loaded twice
+    scheduler.OnLoadSubmitted(0, 0);
+    scheduler.GetLoads(8, UINT64_MAX, loads);
+    REQUIRE(loads.size() == 1);
+    CHECK(loads[0].m_Primitive == 1);
+    CHECK(scheduler.GetNumPendingLODs() == 1);
+
+    // Primitive 0 arrives, then asks for LOD 1: LOD 0 stands in, and the load still goes
+    // out (last) to drop the extra triangles
+    scheduler.OnLoadCompleted(0, 0, 2);
+    requests = { 1, 2, kNoRequest };
+    scheduler.Update(requests, 3);
+    scheduler.GetLoads(8, UINT64_MAX, loads);
+    REQUIRE(loads.size() == 2);
+    CHECK(loads[0].m_Primitive == 1 && loads[0].m_LOD == 2);
+    CHECK(loads[1].m_Primitive == 0 && loads[1].m_LOD == 1);
+}
+
+TEST_CASE(GeometryLODScheduler, EvictsOnlyUnusedStreamedLODs)
+{
+    GeometryLODScheduler scheduler;
+    const uint32_t bytes[] = { 4000, 2000, 1000 };
+    scheduler.AddPrimitive(3, 0b100, bytes);
+    scheduler.AddPrimitive(3, 0b100, bytes);
+
+    for (uint32_t primitive = 0; primitive < 2; ++primitive)
+    {
+        for (uint32_t lod = 0; lod < 2; ++lod)
+        {
+            scheduler.OnLoadSubmitted(primitive, lod);
+            scheduler.OnLoadCompleted(primitive, lod, 10 + primitive * 2 + lod);
+        }
+    }
+    CHECK(scheduler.GetNumResidentStreamedLODs() == 4);
+
+    // Primitive 1 keeps asking for LOD 1
+    std::vector<uint32_t> requests = { kNoRequest, 1 };
+    for (uint32_t frame = 20; frame <= 60; ++frame)
+        scheduler.Update(requests, frame);
+
+    std::vector<GeometryLODRef> expired;
+    scheduler.GetExpired(60, 30, expired);
+    REQUIRE(expired.size() == 3);
+    for (const GeometryLODRef& ref : expired)
+        CHECK(!(ref.m_Primitive == 1 && ref.m_LOD == 1));
+
+    // Least recently used first; the LOD in use and the pinned ones never
+    std::vector<GeometryLODRef> candidates;
+    scheduler.GetEvictionCandidates(60, candidates);
+    REQUIRE(candidates.size() == 3);
+    CHECK(candidates[0].m_Primitive == 0 && candidates[0].m_LOD == 0);
+    CHECK(candidates[1].m_Primitive == 0 && candidates[1].m_LOD == 1);
+    CHECK(candidates[2].m_Primitive == 1 && candidates[2].m_LOD == 0);
+
+    // A stand-in counts as used: evicting LOD 1 of primitive 1 leaves LOD 0 serving it
+    scheduler.OnEvicted(1, 1);
+    scheduler.Update(requests, 61);
+    scheduler.GetEvictionCandidates(61, candidates);
+    for (const GeometryLODRef& ref : candidates)
+        CHECK(!(ref.m_Primitive == 1 && ref.m_LOD == 0));
+    CHECK(scheduler.GetResidentMask(1) == 0b101);
+    CHECK(scheduler.GetNumResidentStreamedLODs() == 3);
+}
+
+TEST_CASE(GeometryLODScheduler, ServesEveryRequestWithinABoundedPool)
+{
+    constexpr uint32_t kNumPrimitives = 200;
+    constexpr uint32_t kNumLODs       = 4;
+    constexpr uint32_t kLoadLatency   = 3;
+    constexpr uint32_t kHysteresis    = 30;
+
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<uint32_t> sizeDist(200, 4000);
+
+    GeometryLODScheduler scheduler;
+    std::vector<std::array<uint32_t, kNumLODs>> lodSizes(kNumPrimitives);
+    for (uint32_t primitive = 0; primitive < kNumPrimitives; ++primitive)
+    {
+        // Each LOD about half the size of the finer one; the coarsest is pinned
+        lodSizes[primitive][0] = sizeDist(rng);
+        for (uint32_t lod = 1; lod < kNumLODs; ++lod)
+            lodSizes[primitive][lod] = lodSizes[primitive][lod - 1] / 2;
+        scheduler.AddPrimitive(kNumLODs, 1u << (kNumLODs - 1), lodSizes[primitive]);
+    }
+
+    // About 1.7x the settled working set, so loads have to evict to make room.  Much
+    // tighter and first-fit fragmentation can keep the largest LODs out for good.
+    GeometryPoolAllocator pool(0, 100000);
+    std::vector<std::array<uint32_t, kNumLODs>> offsets(kNumPrimitives);
+    struct InFlight { GeometryLODRef m_Ref; uint32_t m_Offset; uint32_t m_ArrivalFrame; };
+    std::vector<InFlight> inFlight;
+
+    std::vector<uint32_t> requests(kNumPrimitives);
+    std::vector<GeometryLODRef> refs;
+    uint32_t numLoads = 0;
+    uint32_t numEvictions = 0;
+    uint32_t numEvictionsForRoom = 0;
+    uint32_t numCoarserThanAvailable = 0;
+    uint32_t framesToSettle = 0;
+
+    // A camera sweeping along a row of primitives: LOD by distance, 60 visible at a time
+    for (uint32_t frame = 1; frame <= 600; ++frame)
+    {
+        const float camera = frame < 400 ? frame * 0.35f : 140.0f;
+        for (uint32_t primitive = 0; primitive < kNumPrimitives; ++primitive)
+        {
+            const float distance = std::abs((float)primitive - camera);
+            requests[primitive] = distance > 30.0f ? kNoRequest : std::min((uint32_t)(distance / 8.0f), kNumLODs - 1);
+        }
+        scheduler.Update(requests, frame);
+
+        // Arrivals
+        for (size_t i = 0; i < inFlight.size();)
+        {
+            if (inFlight[i].m_ArrivalFrame > frame)
+            {
+                ++i;
+                continue;
+            }
+            offsets[inFlight[i].m_Ref.m_Primitive][inFlight[i].m_Ref.m_LOD] = inFlight[i].m_Offset;
+            scheduler.OnLoadCompleted(inFlight[i].m_Ref.m_Primitive, inFlight[i].m_Ref.m_LOD, frame);
+            inFlight[i] = inFlight.back();
+            inFlight.pop_back();
+        }
+
+        // Expired LODs go; loads make room from the eviction candidates when the pool is full
+        auto evict = [&](const GeometryLODRef& ref)
+        {
+            pool.Free(offsets[ref.m_Primitive][ref.m_LOD], scheduler.GetLODBytes(ref.m_Primitive, ref.m_LOD));
+            scheduler.OnEvicted(ref.m_Primitive, ref.m_LOD);
+            numEvictions++;
+        };
+        scheduler.GetExpired(frame, kHysteresis, refs);
+        for (const GeometryLODRef& ref : refs)
+            evict(ref);
+
+        scheduler.GetLoads(16, 64 * 1024, refs);
+        std::vector<GeometryLODRef> candidates;
+        for (const GeometryLODRef& ref : refs)
+        {
+            const uint32_t size = scheduler.GetLODBytes(ref.m_Primitive, ref.m_LOD);
+            uint32_t offset = pool.Allocate(size);
+            if (offset == GeometryPoolAllocator::kInvalidOffset)
+            {
+                scheduler.GetEvictionCandidates(frame, candidates);
+                for (size_t i = 0; i < candidates.size() && offset == GeometryPoolAllocator::kInvalidOffset; ++i)
+                {
+                    evict(candidates[i]);
+                    numEvictionsForRoom++;
+                    offset = pool.Allocate(size);
+                }
+            }
+            if (offset == GeometryPoolAllocator::kInvalidOffset)
+                break;
+
+            scheduler.OnLoadSubmitted(ref.m_Primitive, ref.m_LOD);
+            inFlight.push_back({ ref, offset, frame + kLoadLatency });
+            numLoads++;
+        }
+
+        // What a primitive draws is never coarser than a resident LOD it could use
+        bool bSettled = scheduler.GetNumPendingLODs() == 0;
+        for (uint32_t primitive = 0; primitive < kNumPrimitives; ++primitive)
+        {
+            if (requests[primitive] == kNoRequest)
+                continue;
+            const uint8_t residentMask = scheduler.GetResidentMask(primitive);
+            const uint32_t standIn = GetStandInLOD(residentMask, requests[primitive]);
+            if (standIn > requests[primitive] && (residentMask & ((1u << requests[primitive]) - 1)))
+                numCoarserThanAvailable++;
+            bSettled &= standIn == requests[primitive];
+        }
+        if (frame >= 400 && !bSettled)
+            framesToSettle = frame - 400 + 1;
+    }
+
+    std::printf("  %u loads, %u evictions (%u to make room), pool %u/%u used, settled %u frames after the camera stopped\n",
+        numLoads, numEvictions, numEvictionsForRoom, pool.GetUsed(), pool.GetCapacity(), framesToSettle);
+    CHECK(numCoarserThanAvailable == 0);
+    CHECK(numEvictionsForRoom > 0);
+    CHECK(framesToSettle < 20);
+    CHECK(scheduler.GetNumPendingLODs() == inFlight.size());
+
+    uint32_t residentBytes = 0;
+    for (uint32_t primitive = 0; primitive < kNumPrimitives; ++primitive)
+    {
+        for (uint32_t lod = 0; lod < kNumLODs; ++lod)
+        {
+            if (scheduler.IsStreamed(primitive, lod) && (scheduler.GetResidentMask(primitive) & (1u << lod)))
+                residentBytes += scheduler.GetLODBytes(primitive, lod);
+        }
+    }
+    for (const InFlight& load : inFlight)
+        residentBytes += scheduler.GetLODBytes(load.m_Ref.m_Primitive, load.m_Ref.m_LOD);
+    CHECK(pool.GetUsed() == residentBytes);
+}
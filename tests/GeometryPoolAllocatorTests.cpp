@@ -0,0 +1,135 @@
+#include "TestFramework.h"
+
+#include "Streaming/GeometryPoolAllocator.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    // First fit over an element bitmap: the lowest maximal free run that is long enough
+    struct ReferencePool
+    {
+        std::vector<bool> m_bUsed;
+        uint32_t          m_BaseOffset = 0;
+
+        uint32_t Allocate(uint32_t count)
+        {
+            for (uint32_t start = 0; start < m_bUsed.size();)
+            {
+                if (m_bUsed[start])
+                {
+                    start++;
+                    continue;
+                }
+                uint32_t end = start;
+                while (end < m_bUsed.size() && !m_bUsed[end])
+                    end++;
+                if (end - start >= count)
+                {
+                    std::fill(m_bUsed.begin() + start, m_bUsed.begin() + start + count, true);
+                    return m_BaseOffset + start;
+                }
+                start = end;
+            }
+            return GeometryPoolAllocator::kInvalidOffset;
+        }
+
+        void Free(uint32_t offset, uint32_t count)
+        {
+            std::fill(m_bUsed.begin() + (offset - m_BaseOffset), m_bUsed.begin() + (offset - m_BaseOffset + count), false);
+        }
+
+        void GetFreeRuns(uint32_t& outNumRuns, uint32_t& outLargest) const
+        {
+            outNumRuns = 0;
+            outLargest = 0;
+            uint32_t run = 0;
+            for (size_t i = 0; i <= m_bUsed.size(); ++i)
+            {
+                if (i < m_bUsed.size() && !m_bUsed[i])
+                {
+                    run++;
+                    continue;
+                }
+                if (run > 0)
+                {
+                    outNumRuns++;
+                    outLargest = std::max(outLargest, run);
+                }
+                run = 0;
+            }
+        }
+    };
+
+    struct Allocation
+    {
+        uint32_t m_Offset = 0;
+        uint32_t m_Count  = 0;
+    };
+} // namespace
+
+TEST_CASE(GeometryPoolAllocator, MatchesFirstFitReference)
+{
+    constexpr uint32_t kBaseOffset = 5000;
+    constexpr uint32_t kCapacity   = 4000;
+
+    GeometryPoolAllocator pool(kBaseOffset, kCapacity);
+    ReferencePool reference;
+    reference.m_bUsed.assign(kCapacity, false);
+    reference.m_BaseOffset = kBaseOffset;
+
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_int_distribution<uint32_t> sizeDist(1, 300);
+
+    std::vector<Allocation> live;
+    uint32_t numFailed = 0;
+    uint32_t numMismatches = 0;
+    for (uint32_t step = 0; step < 3000; ++step)
+    {
+        if (live.empty() || unit(rng) < 0.55f)
+        {
+            const uint32_t count = sizeDist(rng);
+            const uint32_t offset = pool.Allocate(count);
+            if (offset != reference.Allocate(count))
+                numMismatches++;
+            if (offset == GeometryPoolAllocator::kInvalidOffset)
+                numFailed++;
+            else
+                live.push_back({ offset, count });
+        }
+        else
+        {
+            const size_t i = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+            pool.Free(live[i].m_Offset, live[i].m_Count);
+            reference.Free(live[i].m_Offset, live[i].m_Count);
+            live[i] = live.back();
+            live.pop_back();
+        }
+
+        uint32_t used = 0;
+        for (const Allocation& allocation : live)
+            used += allocation.m_Count;
+        uint32_t numRuns, largest;
+        reference.GetFreeRuns(numRuns, largest);
+        if (pool.GetUsed() != used || pool.GetNumFreeBlocks() != numRuns || pool.GetLargestFreeBlock() != largest)
+            numMismatches++;
+    }
+
+    std::printf("  %u allocations failed, %u free blocks at the end\n", numFailed, pool.GetNumFreeBlocks());
+    CHECK(numMismatches == 0);
+    CHECK(numFailed > 0);
+
+    // Emptied, the pool is one block again
+    for (const Allocation& allocation : live)
+        pool.Free(allocation.m_Offset, allocation.m_Count);
+    CHECK(pool.GetUsed() == 0);
+    CHECK(pool.GetNumFreeBlocks() == 1 && pool.GetLargestFreeBlock() == kCapacity);
+    CHECK(pool.Allocate(kCapacity) == kBaseOffset);
+    CHECK(pool.Allocate(0) == kBaseOffset);
+    CHECK(pool.Allocate(1) == GeometryPoolAllocator::kInvalidOffset);
+}
@@ -0,0 +1,91 @@
+#include "TestFramework.h"
+
+#include "InplaceFunction.h"
+#include "LinearAllocator.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    // Counts live copies, so a leaked or doubly destroyed callable shows up
+    struct LifetimeCounter
+    {
+        int* m_Alive;
+
+        explicit LifetimeCounter(int* alive) : m_Alive(alive) { ++*m_Alive; }
+        LifetimeCounter(const LifetimeCounter& other) : m_Alive(other.m_Alive) { ++*m_Alive; }
+        LifetimeCounter(LifetimeCounter&& other) noexcept : m_Alive(other.m_Alive) { ++*m_Alive; }
+        ~LifetimeCounter() { --*m_Alive; }
+    };
+
+    uint32_t SumBy(FunctionRef<uint32_t(uint32_t)> fn, uint32_t count)
+    {
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i < count; ++i)
+            sum += fn(i);
+        return sum;
+    }
+} // namespace
+
+TEST_CASE(InplaceFunction, StoresAndMovesWithoutTheHeap)
+{
+    int calls = 0;
+    int alive = 0;
+    std::vector<InplaceFunction<void()>> queue;
+    queue.reserve(4);
+
+    const uint64_t allocationsBefore = GetGlobalAllocationCount();
+    {
+
+        const uint64_t captured[4] = { 1, 2, 3, 4 };
+        queue.emplace_back([&calls, captured, counter = LifetimeCounter(&alive)]() { calls += (int)captured[3]; });
+        CHECK(alive == 1);
+
+        // Moving the task moves the callable, leaving the source empty
+        InplaceFunction<void()> task = std::move(queue.back());
+        CHECK(!queue.back());
+        CHECK((bool)task);
+        CHECK(alive == 1);
+
+        task();
+        task();
+        CHECK(calls == 8);
+
+        task.Reset();
+        CHECK(alive == 0);
+        CHECK(!task);
+    }
+    queue.clear();
+    CHECK(alive == 0);
+    CHECK(GetGlobalAllocationCount() == allocationsBefore);
+}
+
+TEST_CASE(InplaceFunction, MoveAssignDestroysThePreviousCallable)
+{
+    int alive = 0;
+    int result = 0;
+    {
+        InplaceFunction<int(int)> a = [counter = LifetimeCounter(&alive)](int x) { return x + 1; };
+        InplaceFunction<int(int)> b = [counter = LifetimeCounter(&alive)](int x) { return x * 2; };
+        CHECK(alive == 2);
+
+        a = std::move(b);
+        CHECK(alive == 1);
+        result = a(21);
+    }
+    CHECK(result == 42);
+    CHECK(alive == 0);
+}
+
+TEST_CASE(InplaceFunction, FunctionRefCallsTheReferencedCallable)
+{
+    uint32_t numCalls = 0;
+    auto square = [&numCalls](uint32_t i) { ++numCalls; return i * i; };
+
+    const uint64_t allocationsBefore = GetGlobalAllocationCount();
+    CHECK(SumBy(square, 4) == 0 + 1 + 4 + 9);
+    CHECK(SumBy([](uint32_t i) { return i; }, 5) == 10);
+    CHECK(GetGlobalAllocationCount() == allocationsBefore);
+    CHECK(numCalls == 4);
+}
@@ -0,0 +1,176 @@
+#include "TestFramework.h"
+
+#include "LightClusterBinner.h"
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr float kNearZ       = 0.1f;
+    constexpr float kTanHalfFovX = 1.0f;
+    constexpr float kTanHalfFovY = 0.5625f;
+
+    // View space = world space, so the brute force needs no transform
+    LightClusterView MakeView()
+    {
+        LightClusterView view;
+        XMStoreFloat4x4(&view.m_WorldToView, XMMatrixIdentity());
+        view.m_TanHalfFovX = kTanHalfFovX;
+        view.m_TanHalfFovY = kTanHalfFovY;
+        view.m_NearZ       = kNearZ;
+        return view;
+    }
+
+    // Directional, point and spot lights in front of the camera; some spot cones are
+    // wider than a hemisphere and some lights have no range
+    std::vector<srrhi::GPULight> MakeLights(std::mt19937& rng, uint32_t count)
+    {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<srrhi::GPULight> lights(count);
+        for (srrhi::GPULight& light : lights)
+        {
+            const float type = unit(rng);
+            light.m_Type = type < 0.05f ? 0u : (type < 0.25f ? 1u : 2u);
+            light.m_Intensity = 1.0f;
+            light.m_Position = Vector3{ (unit(rng) - 0.5f) * 60.0f, (unit(rng) - 0.5f) * 30.0f, unit(rng) * 80.0f - 5.0f };
+            light.m_Range = unit(rng) < 0.02f ? 0.0f : 0.5f + unit(rng) * 8.0f;
+
+            XMFLOAT3 direction{ unit(rng) - 0.5f, unit(rng) - 0.5f, unit(rng) - 0.5f };
+            XMStoreFloat3(&direction, XMVector3Normalize(XMLoadFloat3(&direction)));
+            light.m_Direction = direction;
+            light.m_SpotOuterConeAngle = unit(rng) < 0.1f ? XM_PIDIV2 + unit(rng) : 0.05f + unit(rng) * 1.3f;
+            light.m_SpotInnerConeAngle = light.m_SpotOuterConeAngle * 0.5f;
+        }
+        return lights;
+    }
+
+    // Exactly the deferred shader's test: spot light within range and inside the outer cone
+    bool SpotLightReaches(const srrhi::GPULight& light, const XMFLOAT3& p)
+    {
+        const XMVECTOR toPoint = XMVectorSubtract(XMLoadFloat3(&p), XMLoadFloat3(&light.m_Position));
+        const float dist = XMVectorGetX(XMVector3Length(toPoint));
+        if (light.m_Range > 0.0f && dist > light.m_Range)
+            return false;
+        if (dist <= 0.0f)
+            return true;
+        const float cosTheta = XMVectorGetX(XMVector3Dot(XMVectorScale(toPoint, 1.0f / dist), XMVector3Normalize(XMLoadFloat3(&light.m_Direction))));
+        return cosTheta >= std::cos(light.m_SpotOuterConeAngle);
+    }
+
+    // The cluster of a view-space point, as DeferredLighting.hlsl computes it
+    uint32_t GetClusterIndex(const LightClusterBinner& binner, const XMFLOAT3& p)
+    {
+        const float ndcX = p.x / (p.z * kTanHalfFovX);
+        const float ndcY = p.y / (p.z * kTanHalfFovY);
+        const uint32_t x = (uint32_t)std::clamp(std::floor((ndcX + 1.0f) * 0.5f * LightClusterBinner::kGridX), 0.0f, float(LightClusterBinner::kGridX - 1));
+        const uint32_t y = (uint32_t)std::clamp(std::floor((1.0f - ndcY) * 0.5f * LightClusterBinner::kGridY), 0.0f, float(LightClusterBinner::kGridY - 1));
+        const uint32_t z = (uint32_t)std::clamp(std::floor(std::log(p.z) * binner.GetZScale() + binner.GetZBias()), 0.0f, float(LightClusterBinner::kGridZ - 1));
+        return x + y * LightClusterBinner::kGridX + z * LightClusterBinner::kGridX * LightClusterBinner::kGridY;
+    }
+} // namespace
+
+TEST_CASE(LightClusterBinner, MatchesBruteForce)
+{
+    constexpr uint32_t kNumScenes        = 10;
+    constexpr uint32_t kNumLights        = 300;
+    constexpr uint32_t kSamplesPerScene  = 20000;
+
+    TaskScheduler scheduler;
+    LightClusterBinner binner;
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    uint32_t numMissed = 0;
+    uint32_t numLitSamples = 0;
+    for (uint32_t scene = 0; scene < kNumScenes; ++scene)
+    {
+        const std::vector<srrhi::GPULight> lights = MakeLights(rng, kNumLights);
+        binner.Bin(lights, MakeView(), scheduler);
+
+        const std::vector<LightClusterBinner::ClusterRange>& clusters = binner.GetClusters();
+        const std::vector<uint32_t>& indices = binner.GetLightIndices();
+        const LightClusterStats& stats = binner.GetStats();
+        REQUIRE(clusters.size() == LightClusterBinner::kNumClusters);
+        REQUIRE(indices.size() == stats.m_NumIndices);
+
+        // Global lights: every directional or unbounded spot light, and nothing else
+        std::vector<uint32_t> expectedGlobal;
+        for (uint32_t i = 0; i < kNumLights; ++i)
+        {
+            if (lights[i].m_Type == 0 || (lights[i].m_Type == 2 && lights[i].m_Range <= 0.0f))
+                expectedGlobal.push_back(i);
+        }
+        std::vector<uint32_t> global(indices.begin(), indices.begin() + stats.m_NumGlobalLights);
+        std::sort(global.begin(), global.end());
+        CHECK(global == expectedGlobal);
+
+        // Point lights are not shaded by the raster path, so never listed
+        for (uint32_t index : indices)
+            CHECK(index < kNumLights && lights[index].m_Type != 1);
+
+        // No cluster lists a light twice
+        for (const LightClusterBinner::ClusterRange& cluster : clusters)
+        {
+            std::vector<uint32_t> list(indices.begin() + cluster.m_Offset, indices.begin() + cluster.m_Offset + cluster.m_Count);
+            std::sort(list.begin(), list.end());
+            CHECK(std::adjacent_find(list.begin(), list.end()) == list.end());
+        }
+
+        // Every spot light that reaches a sampled point is in that point's cluster
+        const float farZ = binner.GetFarZ();
+        for (uint32_t sample = 0; sample < kSamplesPerScene; ++sample)
+        {
+            const float z = kNearZ * std::pow(farZ / kNearZ, unit(rng));
+            const XMFLOAT3 p{ (unit(rng) * 2.0f - 1.0f) * z * kTanHalfFovX, (unit(rng) * 2.0f - 1.0f) * z * kTanHalfFovY, z };
+            const LightClusterBinner::ClusterRange& cluster = clusters[GetClusterIndex(binner, p)];
+            const auto listBegin = indices.begin() + cluster.m_Offset;
+            const auto listEnd = listBegin + cluster.m_Count;
+
+            for (uint32_t i = 0; i < kNumLights; ++i)
+            {
+                if (lights[i].m_Type != 2 || lights[i].m_Range <= 0.0f || !SpotLightReaches(lights[i], p))
+                    continue;
+                numLitSamples++;
+                if (std::find(listBegin, listEnd, i) == listEnd)
+                    numMissed++;
+            }
+        }
+    }
+
+    std::printf("  %u lit (sample, light) pairs, %u missed\n", numLitSamples, numMissed);
+    CHECK(numLitSamples > 0);
+    CHECK(numMissed == 0);
+}
+
+TEST_CASE(LightClusterBinner, CullsLightsOutsideTheFrustum)
+{
+    TaskScheduler scheduler;
+    LightClusterBinner binner;
+
+    std::vector<srrhi::GPULight> lights(3);
+    for (srrhi::GPULight& light : lights)
+    {
+        light.m_Type = 2;
+        light.m_Range = 1.0f;
+        light.m_Direction = Vector3{ 0.0f, 0.0f, 1.0f };
+        light.m_SpotOuterConeAngle = 0.5f;
+    }
+    lights[0].m_Position = Vector3{ 0.0f, 0.0f, 10.0f };  // in view
+    lights[1].m_Position = Vector3{ 0.0f, 0.0f, -10.0f }; // behind the camera
+    lights[2].m_Position = Vector3{ 50.0f, 0.0f, 10.0f }; // far to the right
+
+    binner.Bin(lights, MakeView(), scheduler);
+
+    const LightClusterStats& stats = binner.GetStats();
+    CHECK(stats.m_NumLights == 3);
+    CHECK(stats.m_NumGlobalLights == 0);
+    CHECK(stats.m_NumVisibleLights == 1);
+    for (uint32_t index : binner.GetLightIndices())
+        CHECK(index == 0);
+}
@@ -0,0 +1,118 @@
+#include "TestFramework.h"
+
+#include "LinearAllocator.h"
+
+#include <cstring>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+TEST_CASE(LinearAllocator, FrameContainersStayOffTheHeap)
+{
+    LinearAllocator allocator(256 * 1024);
+
+    const uint64_t allocationsBefore = GetGlobalAllocationCount();
+    {
+        std::pmr::vector<uint32_t> values{ &allocator };
+        for (uint32_t i = 0; i < 4096; ++i)
+            values.push_back(i);
+        CHECK(values[4095] == 4095);
+    }
+    CHECK(GetGlobalAllocationCount() == allocationsBefore);
+    CHECK(allocator.GetBytesUsed() > 4096 * sizeof(uint32_t));
+    CHECK(allocator.GetOverflowCount() == 0);
+
+    // Reset rewinds the arena and records the high-water mark
+    const size_t bytesUsed = allocator.GetBytesUsed();
+    allocator.Reset();
+    CHECK(allocator.GetBytesUsed() == 0);
+    CHECK(allocator.GetHighWaterMark() == bytesUsed);
+}
+
+TEST_CASE(LinearAllocator, AlignsEveryAllocation)
+{
+    LinearAllocator allocator(64 * 1024);
+    std::pmr::memory_resource& resource = allocator;
+
+    for (size_t alignment = 1; alignment <= 256; alignment *= 2)
+    {
+        void* p = resource.allocate(3, alignment);
+        CHECK(reinterpret_cast<uintptr_t>(p) % alignment == 0);
+    }
+}
+
+TEST_CASE(LinearAllocator, OverflowFallsBackToTheHeap)
+{
+    LinearAllocator allocator(1024);
+    std::pmr::memory_resource& resource = allocator;
+
+    void* inArena = resource.allocate(1000, 8);
+    const uint64_t allocationsBefore = GetGlobalAllocationCount();
+    void* overflow = resource.allocate(1000, 8);
+    CHECK(allocator.GetOverflowCount() == 1);
+    if (ENABLE_ALLOCATION_COUNTING)
+        CHECK(GetGlobalAllocationCount() == allocationsBefore + 1);
+
+    // Still usable memory, returned to the heap by deallocate
+    std::memset(overflow, 0xAB, 1000);
+    resource.deallocate(overflow, 1000, 8);
+    resource.deallocate(inArena, 1000, 8);
+
+    allocator.Reset();
+    CHECK(allocator.GetOverflowCount() == 0);
+    CHECK(allocator.GetHighWaterMark() <= allocator.GetCapacity());
+}
+
+TEST_CASE(LinearAllocator, ThreadsGetDisjointBlocks)
+{
+    constexpr uint32_t kNumThreads = 4;
+    constexpr uint32_t kAllocationsPerThread = 2000;
+    constexpr size_t   kBlockSize = 24;
+
+    LinearAllocator allocator(kNumThreads * kAllocationsPerThread * 32);
+    std::vector<std::vector<uint8_t*>> blocks(kNumThreads);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kNumThreads; ++t)
+    {
+        threads.emplace_back([&allocator, &blocks, t]()
+        {
+            std::pmr::memory_resource& resource = allocator;
+            blocks[t].reserve(kAllocationsPerThread);
+            for (uint32_t i = 0; i < kAllocationsPerThread; ++i)
+            {
+                uint8_t* block = static_cast<uint8_t*>(resource.allocate(kBlockSize, 8));
+                std::memset(block, (int)t + 1, kBlockSize);
+                blocks[t].push_back(block);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // A block overlapped by another thread's would hold that thread's byte pattern
+    uint32_t numCorrupted = 0;
+    for (uint32_t t = 0; t < kNumThreads; ++t)
+    {
+        for (const uint8_t* block : blocks[t])
+        {
+            for (size_t i = 0; i < kBlockSize; ++i)
+                numCorrupted += block[i] != t + 1;
+        }
+    }
+    CHECK(numCorrupted == 0);
+    CHECK(allocator.GetOverflowCount() == 0);
+}
+
+TEST_CASE(LinearAllocator, CountsGlobalAllocationsWhenEnabled)
+{
+    const uint64_t allocationsBefore = GetGlobalAllocationCount();
+    std::vector<int>* heapVector = new std::vector<int>(16);
+    const uint64_t allocationsAfter = GetGlobalAllocationCount();
+    delete heapVector;
+
+    if (ENABLE_ALLOCATION_COUNTING)
+        CHECK(allocationsAfter == allocationsBefore + 2);
+    else
+        CHECK(allocationsAfter == 0);
+}
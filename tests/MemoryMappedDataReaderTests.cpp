@@ -0,0 +1,212 @@
+#include "TestFramework.h"
+
+#include "MemoryMappedDataReader.h"
+#include "ProcessMemory.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+    using AccessHint = MemoryMappedDataReader::AccessHint;
+
+    uint8_t Pattern(size_t i)
+    {
+        return (uint8_t)((i * 2654435761u) >> 13);
+    }
+
+    // A file of `size` pattern bytes, removed when the test case returns
+    struct TempFile
+    {
+        std::filesystem::path m_Path;
+
+        TempFile(const char* name, size_t size)
+            : m_Path(std::filesystem::temp_directory_path() / name)
+        {
+            std::vector<uint8_t> bytes(size);
+            for (size_t i = 0; i < size; ++i)
+                bytes[i] = Pattern(i);
+            std::ofstream file(m_Path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(bytes.data()), (std::streamsize)bytes.size());
+        }
+
+        ~TempFile()
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_Path, ec);
+        }
+    };
+
+    // Bytes [begin, begin + size) of the reader's view hold the file's bytes from fileOffset
+    bool MatchesFile(const MemoryMappedDataReader& reader, size_t begin, size_t size, size_t fileOffset)
+    {
+        const uint8_t* data = static_cast<const uint8_t*>(reader.GetData());
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (data[begin + i] != Pattern(fileOffset + begin + i))
+                return false;
+        }
+        return true;
+    }
+
+    // Reads every page of the view so that it is resident
+    uint32_t TouchPages(const MemoryMappedDataReader& reader)
+    {
+        const volatile uint8_t* data = static_cast<const uint8_t*>(reader.GetData());
+        uint32_t sum = 0;
+        for (size_t i = 0; i < reader.GetSize(); i += 1024)
+            sum += data[i];
+        return sum;
+    }
+} // namespace
+
+TEST_CASE(MemoryMappedDataReader, ContentsAreIdenticalAcrossHints)
+{
+    // Not a whole number of pages
+    constexpr size_t kSize = 1024 * 1024 + 123;
+    TempFile file("HobbyRendererTests_MemoryMappedDataReader_hints.bin", kSize);
+
+    uint32_t numMismatches = 0;
+    for (AccessHint hint : { AccessHint::Normal, AccessHint::Sequential, AccessHint::Random })
+    {
+        for (bool bPopulate : { false, true })
+        {
+            MemoryMappedDataReader reader(file.m_Path.string(), hint, bPopulate);
+            REQUIRE(reader.IsValid());
+            REQUIRE(reader.GetSize() == kSize);
+            if (!MatchesFile(reader, 0, kSize, 0))
+                numMismatches++;
+
+            // Changing the hint on a live mapping leaves it readable
+            reader.SetAccessHint(hint == AccessHint::Random ? AccessHint::Sequential : AccessHint::Random);
+            if (!MatchesFile(reader, kSize - 4096, 4096, 0))
+                numMismatches++;
+
+            std::vector<uint8_t> read(5000);
+            if (reader.ReadAt(kSize - 5000, read.data(), read.size()) != read.size() ||
+                memcmp(read.data(), static_cast<const uint8_t*>(reader.GetData()) + kSize - 5000, read.size()) != 0)
+            {
+                numMismatches++;
+            }
+        }
+    }
+    CHECK(numMismatches == 0);
+}
+
+TEST_CASE(MemoryMappedDataReader, PopulatesOnlySmallFiles)
+{
+    TempFile small("HobbyRendererTests_MemoryMappedDataReader_small.bin", MemoryMappedDataReader::kPopulateMaxBytes);
+    TempFile large("HobbyRendererTests_MemoryMappedDataReader_large.bin", 4 * MemoryMappedDataReader::kPopulateMaxBytes);
+
+    const size_t before = GetProcessResidentBytes();
+    MemoryMappedDataReader smallReader(small.m_Path.string(), AccessHint::Random, true);
+    const size_t afterSmall = GetProcessResidentBytes();
+    MemoryMappedDataReader largeReader(large.m_Path.string(), AccessHint::Random, true);
+    const size_t afterLarge = GetProcessResidentBytes();
+    REQUIRE(smallReader.IsValid() && largeReader.IsValid());
+
+    std::printf("  resident set %.1f MB -> %.1f MB (small, populated) -> %.1f MB (large, not populated)\n",
+                before / 1048576.0, afterSmall / 1048576.0, afterLarge / 1048576.0);
+#ifdef __linux__
+    // MAP_POPULATE faults the small file in at map time; the large one stays unmapped
+    CHECK(afterSmall >= before + MemoryMappedDataReader::kPopulateMaxBytes * 3 / 4);
+    CHECK(afterLarge < afterSmall + largeReader.GetSize() / 4);
+#endif
+
+    // Populated or not, both read the file
+    CHECK(MatchesFile(smallReader, 0, smallReader.GetSize(), 0));
+    CHECK(MatchesFile(largeReader, 0, largeReader.GetSize(), 0));
+}
+
+TEST_CASE(MemoryMappedDataReader, EvictedPagesStayReadable)
+{
+    constexpr size_t kSize = 16 * 1024 * 1024 + 4321;
+    TempFile file("HobbyRendererTests_MemoryMappedDataReader_evict.bin", kSize);
+
+    MemoryMappedDataReader reader(file.m_Path.string(), AccessHint::Random);
+    REQUIRE(reader.IsValid());
+    TouchPages(reader);
+
+    // An unaligned range covering all but the first and last byte expands to every page
+    const size_t touched = GetProcessResidentBytes();
+    reader.Evict(1, kSize - 2);
+    const size_t evicted = GetProcessResidentBytes();
+    std::printf("  resident set %.1f MB -> %.1f MB after Evict\n", touched / 1048576.0, evicted / 1048576.0);
+#ifdef __linux__
+    CHECK(evicted + kSize * 3 / 4 <= touched);
+#endif
+    CHECK(MatchesFile(reader, 0, kSize, 0));
+
+    // Dropped from the page cache too: the next access reads the file again
+    const bool bDropped = reader.DropCachedPages();
+#ifdef __linux__
+    CHECK(bDropped);
+#else
+    (void)bDropped;
+#endif
+    CHECK(MatchesFile(reader, 0, kSize, 0));
+
+    reader.Prefetch(0, kSize);
+    CHECK(MatchesFile(reader, kSize / 2, kSize / 2, 0));
+
+    std::vector<uint8_t> read(kSize);
+    reader.DropCachedPages();
+    CHECK(reader.ReadAt(0, read.data(), read.size()) == kSize);
+    CHECK(memcmp(read.data(), reader.GetData(), kSize) == 0);
+}
+
+TEST_CASE(MemoryMappedDataReader, OddOffsetsAndSizesAreClamped)
+{
+    constexpr size_t kSize   = 256 * 1024 + 77;
+    constexpr size_t kHeader = 4097; // not page aligned
+    TempFile file("HobbyRendererTests_MemoryMappedDataReader_offsets.bin", kSize);
+
+    MemoryMappedDataReader reader(file.m_Path.string());
+    REQUIRE(reader.IsValid());
+    reader.SetOffset(kHeader);
+    REQUIRE(reader.GetSize() == kSize - kHeader);
+    CHECK(MatchesFile(reader, 0, reader.GetSize(), kHeader));
+
+    // Ranges are relative to the offset; the pages around them are expanded to,
+    // and nothing past the end of the mapping is touched
+    const size_t ranges[][2] = {
+        { 0, 1 }, { 1, 4095 }, { 4095, 2 }, { 12345, 54321 }, { reader.GetSize() - 1, 1 },
+        { reader.GetSize() - 100, SIZE_MAX }, { reader.GetSize(), 10 }, { SIZE_MAX / 2, SIZE_MAX }, { 333, 0 },
+    };
+    for (const auto& range : ranges)
+    {
+        reader.Prefetch(range[0], range[1]);
+        reader.Evict(range[0], range[1]);
+    }
+    CHECK(MatchesFile(reader, 0, reader.GetSize(), kHeader));
+
+    // Positional reads are clamped to the end of the file
+    std::vector<uint8_t> read(300, 0xCD);
+    CHECK(reader.ReadAt(12345, read.data(), 255) == 255);
+    CHECK(memcmp(read.data(), static_cast<const uint8_t*>(reader.GetData()) + 12345, 255) == 0);
+    CHECK(read[255] == 0xCD);
+    CHECK(reader.ReadAt(reader.GetSize() - 10, read.data(), read.size()) == 10);
+    CHECK(read[9] == Pattern(kSize - 1));
+    CHECK(reader.ReadAt(reader.GetSize(), read.data(), read.size()) == 0);
+}
+
+TEST_CASE(MemoryMappedDataReader, OwnedDataIgnoresHints)
+{
+    uint8_t bytes[64];
+    for (size_t i = 0; i < sizeof(bytes); ++i)
+        bytes[i] = Pattern(i);
+
+    // The no-op deleter keeps the destructor from freeing the stack array
+    MemoryMappedDataReader reader(bytes, sizeof(bytes), [](void*) {});
+    reader.SetAccessHint(AccessHint::Random);
+    reader.Prefetch(0, sizeof(bytes));
+    reader.Evict(3, 17);
+    CHECK(!reader.DropCachedPages());
+
+    uint8_t read[8] = {};
+    CHECK(reader.ReadAt(0, read, sizeof(read)) == 0);
+    CHECK(MatchesFile(reader, 0, sizeof(bytes), 0));
+}
@@ -0,0 +1,41 @@
+#include "TestFramework.h"
+
+#include "ProcessMemory.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+TEST_CASE(ProcessMemory, FollowsLargeAllocations)
+{
+    // Large enough to be mapped on its own, so that freeing it unmaps it
+    constexpr size_t kBytes = 96 * 1024 * 1024;
+
+    const size_t before = GetProcessResidentBytes();
+#if defined(_WIN32) || defined(__linux__)
+    REQUIRE(before > 0);
+#else
+    if (before == 0)
+    {
+        std::printf("  resident set size not available on this platform\n");
+        return;
+    }
+#endif
+
+    std::vector<uint8_t> block(kBytes);
+    memset(block.data(), 0x5A, block.size());
+    const size_t touched = GetProcessResidentBytes();
+
+    std::vector<uint8_t>().swap(block);
+    const size_t released = GetProcessResidentBytes();
+
+    std::printf("  %.1f MB -> %.1f MB -> %.1f MB\n", before / 1048576.0, touched / 1048576.0, released / 1048576.0);
+    CHECK(touched >= before + kBytes * 3 / 4);
+    CHECK(released + kBytes * 3 / 4 <= touched);
+
+    // Allocated but only one page touched: not resident
+    std::unique_ptr<uint8_t[]> untouched(new uint8_t[kBytes]);
+    untouched[0] = 1;
+    CHECK(GetProcessResidentBytes() < released + kBytes / 4);
+}
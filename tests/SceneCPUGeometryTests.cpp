@@ -0,0 +1,115 @@
+#include "TestFramework.h"
+
+#include "ProcessMemory.h"
+#include "Scene.h"
+#include "SceneCache.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    // A large scene's meshlet arrays: 64 MB of meshlets, 32 MB of each index array
+    constexpr size_t kMeshletBytes = 64 * 1024 * 1024;
+    constexpr size_t kIndexBytes   = 32 * 1024 * 1024;
+
+    uint32_t Pattern(size_t i)
+    {
+        return (uint32_t)(i * 2654435761u);
+    }
+
+    void FillGeometry(Scene& scene, size_t meshletBytes, size_t indexBytes)
+    {
+        scene.m_MeshData.resize(1);
+        scene.m_MeshData[0].m_LODCount = 1;
+
+        scene.m_Meshlets.resize(meshletBytes / sizeof(srrhi::Meshlet));
+        for (size_t i = 0; i < scene.m_Meshlets.size(); ++i)
+        {
+            scene.m_Meshlets[i].m_VertexOffset   = Pattern(i);
+            scene.m_Meshlets[i].m_TriangleOffset = Pattern(i + 1);
+        }
+
+        scene.m_MeshletVertices.resize(indexBytes / sizeof(uint32_t));
+        scene.m_MeshletTriangles.resize(indexBytes / sizeof(uint32_t));
+        for (size_t i = 0; i < scene.m_MeshletVertices.size(); ++i)
+        {
+            scene.m_MeshletVertices[i]  = Pattern(i);
+            scene.m_MeshletTriangles[i] = Pattern(i) ^ 0xFFu;
+        }
+    }
+
+    struct TempCache
+    {
+        std::filesystem::path m_Path = std::filesystem::temp_directory_path() / "HobbyRendererTests_SceneCPUGeometry_mesh.bin";
+
+        ~TempCache()
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_Path, ec);
+        }
+    };
+} // namespace
+
+TEST_CASE(SceneCPUGeometry, ReleaseLowersResidentSetAndTheCacheRestoresIt)
+{
+    TempCache cache;
+    Scene scene;
+    FillGeometry(scene, kMeshletBytes, kIndexBytes);
+
+    const std::vector<srrhi::VertexQuantized> vertices(3);
+    const std::vector<uint32_t> indices = { 0, 1, 2 };
+    REQUIRE(SceneCache::SaveCookedMesh(cache.m_Path, scene.m_Meshes, scene.m_MeshData, scene.m_Meshlets,
+                                       scene.m_MeshletVertices, scene.m_MeshletTriangles, vertices, indices));
+    scene.m_CookedMeshCachePath = cache.m_Path;
+
+    const size_t numMeshlets = scene.m_Meshlets.size();
+    const size_t numIndices  = scene.m_MeshletVertices.size();
+
+    const size_t before = GetProcessResidentBytes();
+    const size_t releasedBytes = scene.ReleaseCPUGeometry();
+    const size_t after = GetProcessResidentBytes();
+
+    std::printf("  released %.1f MB, resident set %.1f MB -> %.1f MB\n", releasedBytes / 1048576.0, before / 1048576.0, after / 1048576.0);
+    CHECK(releasedBytes >= kMeshletBytes - sizeof(srrhi::Meshlet) + 2 * kIndexBytes);
+    CHECK(scene.m_Meshlets.capacity() == 0 && scene.m_MeshletVertices.capacity() == 0 && scene.m_MeshletTriangles.capacity() == 0);
+    CHECK(after + releasedBytes * 3 / 4 <= before);
+    CHECK(scene.ReleaseCPUGeometry() == 0);
+
+    // Re-read lazily: the mapping faults in what is accessed
+    {
+        Scene::CPUGeometryView view;
+        REQUIRE(scene.MapCPUGeometry(view));
+        REQUIRE(view.m_Meshlets.size() == numMeshlets);
+        REQUIRE(view.m_MeshletVertices.size() == numIndices && view.m_MeshletTriangles.size() == numIndices);
+        CHECK(view.m_VerticesQuantized.size() == 3 && view.m_Indices.size() == 3);
+
+        uint32_t numMismatches = 0;
+        for (size_t i = 0; i < numMeshlets; i += 997)
+        {
+            if (view.m_Meshlets[i].m_VertexOffset != Pattern(i) || view.m_Meshlets[i].m_TriangleOffset != Pattern(i + 1))
+                numMismatches++;
+        }
+        for (size_t i = 0; i < numIndices; i += 997)
+        {
+            if (view.m_MeshletVertices[i] != Pattern(i) || view.m_MeshletTriangles[i] != (Pattern(i) ^ 0xFFu))
+                numMismatches++;
+        }
+        CHECK(numMismatches == 0);
+    }
+}
+
+TEST_CASE(SceneCPUGeometry, ScenesWithoutACacheKeepTheirCopies)
+{
+    // JSON scenes: nothing to re-read the arrays from, so they stay resident
+    Scene scene;
+    FillGeometry(scene, 1024 * sizeof(srrhi::Meshlet), 4096 * sizeof(uint32_t));
+
+    CHECK(scene.ReleaseCPUGeometry() == 0);
+    CHECK(scene.m_bCPUGeometryResident);
+    CHECK(scene.m_Meshlets.size() == 1024 && scene.m_MeshletVertices.size() == 4096 && scene.m_MeshletTriangles.size() == 4096);
+    CHECK(scene.m_Meshlets[7].m_VertexOffset == Pattern(7) && scene.m_MeshletTriangles[7] == (Pattern(7) ^ 0xFFu));
+
+    Scene::CPUGeometryView view;
+    CHECK(!scene.MapCPUGeometry(view));
+}
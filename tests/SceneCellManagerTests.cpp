@@ -0,0 +1,285 @@
+#include "TestFramework.h"
+
+#include "Streaming/SceneCellManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    constexpr uint64_t kMB = 1024 * 1024;
+
+    using CellState = SceneCellManager::CellState;
+
+    // Applies an Update() the way SceneCellStreamer does: unloads right away, loads
+    // complete latency frames after they are submitted
+    struct MockStreamer
+    {
+        struct PendingLoad
+        {
+            uint32_t m_Cell         = 0;
+            uint32_t m_ArrivalFrame = 0;
+        };
+
+        SceneCellManager         m_Cells;
+        std::vector<PendingLoad> m_Pending;
+        std::vector<uint32_t>    m_NumLoadsOfCell;
+        std::vector<uint32_t>    m_Loads;
+        std::vector<uint32_t>    m_Unloads;
+        uint32_t                 m_Latency = 4;
+
+        explicit MockStreamer(const SceneCellParams& params) : m_Cells(params) {}
+
+        void Update(const Vector3& cameraPos, uint32_t frame)
+        {
+            for (size_t i = 0; i < m_Pending.size();)
+            {
+                if (m_Pending[i].m_ArrivalFrame > frame)
+                {
+                    ++i;
+                    continue;
+                }
+                m_Cells.OnLoadCompleted(m_Pending[i].m_Cell);
+                m_Pending[i] = m_Pending.back();
+                m_Pending.pop_back();
+            }
+
+            m_Cells.Update(cameraPos, m_Loads, m_Unloads);
+            for (uint32_t cell : m_Unloads)
+                m_Cells.OnUnloaded(cell);
+            for (uint32_t cell : m_Loads)
+            {
+                m_Cells.OnLoadSubmitted(cell);
+                m_Pending.push_back({ cell, frame + m_Latency });
+                m_NumLoadsOfCell.resize(m_Cells.GetNumCells());
+                m_NumLoadsOfCell[cell]++;
+            }
+        }
+    };
+} // namespace
+
+TEST_CASE(SceneCellManager, PlacesItemsByCellAndGrowsBounds)
+{
+    SceneCellParams params;
+    params.m_CellSize = 10.0f;
+    SceneCellManager cells(params);
+
+    const uint32_t a = cells.AddItem({ 1.0f, 0.0f, 1.0f }, 1.0f, 1 * kMB);
+    const uint32_t b = cells.AddItem({ 9.0f, 50.0f, 9.0f }, 1.0f, 2 * kMB);    // same cell, any height
+    const uint32_t c = cells.AddItem({ -1.0f, 0.0f, 1.0f }, 1.0f, 4 * kMB);    // x < 0: the next cell over
+    const uint32_t d = cells.AddItem({ 10.0f, 0.0f, 1.0f }, 30.0f, 8 * kMB);   // on the boundary: the upper cell
+
+    CHECK(a == b);
+    CHECK(a != c && a != d && c != d);
+    CHECK(cells.GetNumCells() == 3 && cells.GetNumItems() == 4);
+    CHECK(cells.GetCellBytes(a) == 3 * kMB);
+    CHECK(cells.GetCellItems(a).size() == 2 && cells.GetItemCell(1) == a);
+
+    // The large item's sphere reaches 30 units out of its cell
+    std::vector<uint32_t> loads, unloads;
+    cells.Update({ 10.0f, 0.0f, -25.0f }, loads, unloads);
+    CHECK(cells.GetCellDistance(d) == 0.0f);
+    CHECK(std::abs(cells.GetCellDistance(a) - 25.0f) < 1e-4f);
+}
+
+TEST_CASE(SceneCellManager, HysteresisStopsBoundaryReloads)
+{
+    // A camera pacing back and forth across the load radius of one cell
+    auto countLoads = [](float unloadRadius)
+    {
+        SceneCellParams params;
+        params.m_CellSize     = 10.0f;
+        params.m_LoadRadius   = 100.0f;
+        params.m_UnloadRadius = unloadRadius;
+        MockStreamer streamer(params);
+        streamer.m_Cells.AddItem({ 5.0f, 0.0f, 5.0f }, 0.0f, kMB);
+
+        for (uint32_t frame = 0; frame < 400; ++frame)
+        {
+            const float x = 105.0f + 8.0f * std::sin(frame * 0.1f);
+            streamer.Update({ x, 0.0f, 5.0f }, frame);
+        }
+        return streamer.m_NumLoadsOfCell.empty() ? 0u : streamer.m_NumLoadsOfCell[0];
+    };
+
+    const uint32_t withoutHysteresis = countLoads(100.0f);
+    const uint32_t withHysteresis    = countLoads(120.0f);
+    std::printf("  %u loads without hysteresis, %u with\n", withoutHysteresis, withHysteresis);
+    CHECK(withoutHysteresis > 5);
+    CHECK(withHysteresis == 1);
+}
+
+TEST_CASE(SceneCellManager, AdmitsNearestFirstWithinTheBudget)
+{
+    SceneCellParams params;
+    params.m_CellSize        = 10.0f;
+    params.m_LoadRadius      = 1000.0f;
+    params.m_UnloadRadius    = 1000.0f;
+    params.m_BudgetBytes     = 10 * kMB;
+    params.m_MaxPendingLoads = 2;
+
+    // The nearest cell is always admitted, even when it is over budget on its own
+    {
+        SceneCellManager cells(params);
+        const uint32_t huge = cells.AddItem({ 5.0f, 0.0f, 5.0f }, 0.0f, 12 * kMB);
+        cells.AddItem({ 25.0f, 0.0f, 5.0f }, 0.0f, 1 * kMB);
+
+        std::vector<uint32_t> loads, unloads;
+        cells.Update({ 5.0f, 0.0f, 5.0f }, loads, unloads);
+        REQUIRE(loads.size() == 1);
+        CHECK(loads[0] == huge);
+    }
+
+    SceneCellManager cells(params);
+    const uint32_t nearest = cells.AddItem({ 5.0f, 0.0f, 5.0f }, 0.0f, 8 * kMB);
+    const uint32_t second  = cells.AddItem({ 25.0f, 0.0f, 5.0f }, 0.0f, 4 * kMB);
+    const uint32_t third   = cells.AddItem({ 45.0f, 0.0f, 5.0f }, 0.0f, 1 * kMB);
+    const uint32_t fourth  = cells.AddItem({ 65.0f, 0.0f, 5.0f }, 0.0f, 1 * kMB);
+
+    // The second cell no longer fits, which stops admission even though the farther
+    // small ones would
+    std::vector<uint32_t> loads, unloads;
+    cells.Update({ 5.0f, 0.0f, 5.0f }, loads, unloads);
+    REQUIRE(loads.size() == 1);
+    CHECK(loads[0] == nearest);
+
+    // Standing next to the small cells: nearest first, two in flight at most
+    cells.OnLoadSubmitted(nearest);
+    cells.Update({ 45.0f, 0.0f, 5.0f }, loads, unloads);
+    CHECK(unloads.empty()); // loading cells are never unloaded
+    REQUIRE(loads.size() == 1);
+    CHECK(loads[0] == third);
+
+    cells.OnLoadCompleted(nearest);
+    cells.Update({ 45.0f, 0.0f, 5.0f }, loads, unloads);
+    REQUIRE(loads.size() == 2);
+    CHECK(loads[0] == third && loads[1] == second); // equal distance: lower cell index first
+    CHECK(cells.GetCellState(fourth) == CellState::Unloaded);
+    // The nearest cell of the first Update no longer fits next to them
+    REQUIRE(unloads.size() == 1);
+    CHECK(unloads[0] == nearest);
+
+    cells.OnUnloaded(nearest);
+    CHECK(cells.GetResidentBytes() == 0);
+    CHECK(cells.GetCellState(nearest) == CellState::Unloaded);
+}
+
+TEST_CASE(SceneCellManager, LoweredBudgetUnloadsTheFarthestCells)
+{
+    // VRAM pressure lowers the budget; restoring it reloads what was dropped
+    SceneCellParams params;
+    params.m_CellSize        = 10.0f;
+    params.m_LoadRadius      = 1000.0f;
+    params.m_UnloadRadius    = 1000.0f;
+    params.m_BudgetBytes     = 100 * kMB;
+    params.m_MaxPendingLoads = 8;
+    MockStreamer streamer(params);
+
+    std::vector<uint32_t> cells;
+    for (uint32_t i = 0; i < 5; ++i)
+        cells.push_back(streamer.m_Cells.AddItem({ 5.0f + 20.0f * i, 0.0f, 5.0f }, 0.0f, 10 * kMB));
+
+    const Vector3 cameraPos = { 5.0f, 0.0f, 5.0f };
+    uint32_t frame = 0;
+    for (; frame < 10; ++frame)
+        streamer.Update(cameraPos, frame);
+    REQUIRE(streamer.m_Cells.GetResidentBytes() == 50 * kMB);
+
+    streamer.m_Cells.SetBudgetBytes(25 * kMB);
+    streamer.Update(cameraPos, frame++);
+    CHECK(streamer.m_Unloads.size() == 3);
+    CHECK(streamer.m_Cells.GetResidentBytes() == 20 * kMB);
+    CHECK(streamer.m_Cells.GetCellState(cells[1]) == CellState::Loaded);
+    CHECK(streamer.m_Cells.GetCellState(cells[2]) == CellState::Unloaded);
+    CHECK(streamer.m_Cells.GetCellState(cells[4]) == CellState::Unloaded);
+
+    streamer.m_Cells.SetBudgetBytes(params.m_BudgetBytes);
+    for (const uint32_t end = frame + 10; frame < end; ++frame)
+        streamer.Update(cameraPos, frame);
+    CHECK(streamer.m_Cells.GetResidentBytes() == 50 * kMB);
+    CHECK(streamer.m_NumLoadsOfCell[cells[0]] == 1 && streamer.m_NumLoadsOfCell[cells[4]] == 2);
+}
+
+TEST_CASE(SceneCellManager, WalkStaysWithinTheBudget)
+{
+    constexpr uint32_t kGridSize = 24;
+
+    SceneCellParams params;
+    params.m_CellSize        = 64.0f;
+    params.m_LoadRadius      = 200.0f;
+    params.m_UnloadRadius    = 260.0f;
+    params.m_BudgetBytes     = 300 * kMB;
+    params.m_MaxPendingLoads = 4;
+    MockStreamer streamer(params);
+
+    // A few items per cell, 1-8 MB each
+    std::mt19937 rng(31);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    uint64_t largestCellBytes = 0;
+    for (uint32_t z = 0; z < kGridSize; ++z)
+    {
+        for (uint32_t x = 0; x < kGridSize; ++x)
+        {
+            const uint32_t numItems = 1 + (uint32_t)(unit(rng) * 3.0f);
+            for (uint32_t i = 0; i < numItems; ++i)
+            {
+                const Vector3 center{ (x + unit(rng)) * params.m_CellSize, 0.0f, (z + unit(rng)) * params.m_CellSize };
+                streamer.m_Cells.AddItem(center, unit(rng) * 20.0f, (uint64_t)(1 + unit(rng) * 7.0f) * kMB);
+            }
+        }
+    }
+    for (uint32_t cell = 0; cell < streamer.m_Cells.GetNumCells(); ++cell)
+        largestCellBytes = std::max(largestCellBytes, streamer.m_Cells.GetCellBytes(cell));
+
+    // Walk diagonally across the world, then stop
+    uint32_t numOverBudget = 0;
+    uint32_t numFarLoads = 0;
+    uint64_t peakBytes = 0;
+    uint32_t frame = 0;
+    const float worldSize = kGridSize * params.m_CellSize;
+    for (; frame < 1500; ++frame)
+    {
+        const float t = std::min(frame / 1200.0f, 1.0f);
+        const Vector3 camera{ worldSize * (0.1f + 0.8f * t), 0.0f, worldSize * (0.1f + 0.8f * t) };
+        streamer.Update(camera, frame);
+
+        for (uint32_t cell : streamer.m_Loads)
+        {
+            if (streamer.m_Cells.GetCellDistance(cell) > params.m_LoadRadius)
+                numFarLoads++;
+        }
+
+        // Loads in flight may still be finishing for cells no longer admitted
+        peakBytes = std::max(peakBytes, streamer.m_Cells.GetResidentBytes());
+        if (streamer.m_Cells.GetResidentBytes() > params.m_BudgetBytes + params.m_MaxPendingLoads * largestCellBytes)
+            numOverBudget++;
+    }
+
+    // Stopped: every loaded cell is admitted, and what fits is loaded
+    uint32_t numMissing = 0;
+    uint64_t loadedBytes = 0;
+    for (uint32_t cell = 0; cell < streamer.m_Cells.GetNumCells(); ++cell)
+    {
+        const bool bLoaded = streamer.m_Cells.GetCellState(cell) == CellState::Loaded;
+        loadedBytes += bLoaded ? streamer.m_Cells.GetCellBytes(cell) : 0;
+        if (!bLoaded && streamer.m_Cells.GetCellDistance(cell) <= params.m_LoadRadius)
+            numMissing++;
+    }
+
+    uint32_t numLoads = 0;
+    for (uint32_t n : streamer.m_NumLoadsOfCell)
+        numLoads += n;
+    std::printf("  %u cells, %u loads, peak %.0f MB of %.0f MB, %u MB loaded at rest, %u cells in range not loaded\n",
+        streamer.m_Cells.GetNumCells(), numLoads, (double)peakBytes / kMB, (double)params.m_BudgetBytes / kMB,
+        (uint32_t)(loadedBytes / kMB), numMissing);
+    CHECK(numOverBudget == 0);
+    CHECK(numFarLoads == 0);
+    CHECK(streamer.m_Cells.GetNumPendingLoads() == 0);
+    CHECK(loadedBytes <= params.m_BudgetBytes);
+    // Cells in range are only left out when the budget is spent
+    CHECK(numMissing == 0 || loadedBytes + largestCellBytes > params.m_BudgetBytes);
+}
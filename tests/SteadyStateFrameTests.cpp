@@ -0,0 +1,211 @@
+#include "TestFramework.h"
+
+#include "InplaceFunction.h"
+#include "LinearAllocator.h"
+#include "Streaming/DirtyTextureList.h"
+#include "Streaming/GeometryLODScheduler.h"
+#include "Streaming/StreamingBudgetController.h"
+#include "Streaming/TileMappingBatch.h"
+#include "Streaming/TileScheduler.h"
+#include "Streaming/TileStagingRing.h"
+
+#include <memory_resource>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    constexpr uint32_t kNumTextures     = 64;
+    constexpr uint32_t kTilesPerTexture = 256;
+    constexpr uint32_t kNumPrimitives   = 512;
+    constexpr uint32_t kNumCommandLists = 24;
+    constexpr uint32_t kNumTasks        = 32;
+    constexpr uint32_t kWarmUpFrames    = 300;
+    constexpr uint32_t kMeasuredFrames  = 600;
+
+    // The CPU side of Renderer's per-frame streaming and submission work on the
+    // HobbyRendererCore components, with every container the renderer keeps as a
+    // member kept here too.  The camera sweeps over the textures and primitives,
+    // so every frame requests, cancels, pops, maps and evicts something.
+    struct SteadyStateFrame
+    {
+        LinearAllocator           m_FrameAllocator{ 1024 * 1024 };
+        TileScheduler             m_TileScheduler;
+        DirtyTextureList          m_DirtyTextures;
+        TileMappingBatch          m_TileMappingBatch;
+        TileStagingRing           m_StagingRing{ 8 * 1024 * 1024 };
+        StreamingBudgetController m_BudgetController;
+        GeometryLODScheduler      m_LODScheduler;
+
+        // Reused members, as in FeedbackManager and Renderer
+        std::vector<uint32_t>                m_RequestedTiles;
+        std::vector<uint32_t>                m_CancelledTiles;
+        std::vector<uint32_t>                m_RequestedLODs;
+        std::vector<GeometryLODRef>          m_LODLoads;
+        std::vector<GeometryLODRef>          m_LODExpired;
+        std::vector<int>                     m_PendingCommandLists;
+        std::vector<int>                     m_InFlightCommandLists;
+        std::vector<int>                     m_CommandListFreeList;
+        std::vector<InplaceFunction<void()>> m_Tasks;
+        uint64_t                             m_Checksum = 0;
+
+        SteadyStateFrame()
+        {
+            for (uint32_t i = 0; i < kNumTextures; ++i)
+                m_DirtyTextures.AddTexture();
+
+            const uint32_t lodBytes[4] = { 65536, 16384, 4096, 1024 };
+            for (uint32_t i = 0; i < kNumPrimitives; ++i)
+                m_LODScheduler.AddPrimitive(4, 1u << 3, lodBytes);
+            m_RequestedLODs.resize(kNumPrimitives);
+
+            for (int i = 0; i < (int)kNumCommandLists; ++i)
+                m_CommandListFreeList.push_back(i);
+        }
+
+        void Run(uint32_t frame)
+        {
+            m_FrameAllocator.Reset();
+
+            // ─── Feedback: new requests where the camera looks, cancellations behind it
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                const uint32_t textureIdx = (frame * 3 + i * 17) % kNumTextures;
+                const uint32_t firstTile  = (frame * 7 + i * 31) % (kTilesPerTexture - 16);
+
+                m_RequestedTiles.clear();
+                for (uint32_t tile = firstTile; tile < firstTile + 16; ++tile)
+                    m_RequestedTiles.push_back(tile);
+                m_TileScheduler.Enqueue(textureIdx, m_RequestedTiles, frame);
+
+                m_CancelledTiles.clear();
+                for (uint32_t tile = firstTile; tile < firstTile + 4; ++tile)
+                    m_CancelledTiles.push_back((tile + kTilesPerTexture / 2) % kTilesPerTexture);
+                m_TileScheduler.Cancel((textureIdx + kNumTextures / 2) % kNumTextures, m_CancelledTiles);
+
+                m_TileScheduler.MarkTextureChanged(textureIdx);
+                m_DirtyTextures.MarkDirty(textureIdx);
+            }
+
+            // ─── Tile submission (UpdateStreamingPreRender)
+            std::pmr::vector<ScheduledTile> scheduledTiles{ &m_FrameAllocator };
+            m_TileScheduler.PopBatch(64, [frame](const ScheduledTile& tile) {
+                TilePriorityInputs inputs;
+                inputs.m_Coverage      = (float)((tile.m_TileIndex * 13 + frame) % 100) / 100.0f;
+                inputs.m_MipDistance   = tile.m_TileIndex % 4;
+                inputs.m_AgeFrames     = frame - tile.m_RequestFrame;
+                return inputs;
+            }, scheduledTiles);
+
+            m_TileMappingBatch.Clear();
+            for (const ScheduledTile& tile : scheduledTiles)
+            {
+                TileStagingRing::Allocation allocation;
+                if (m_StagingRing.Reserve(65536, allocation))
+                    m_StagingRing.MarkSubmitted(allocation, frame);
+                m_TileMappingBatch.Add(tile.m_TextureIdx, tile.m_TileIndex, tile.m_TileIndex % 4, tile.m_TextureIdx % 8, tile.m_TileIndex);
+                m_DirtyTextures.OnTilesAllocated(tile.m_TextureIdx, 1);
+            }
+            for (uint32_t textureIdx : m_DirtyTextures.GetDirtyTextures())
+            {
+                if (textureIdx % 5 == frame % 5)
+                {
+                    m_TileMappingBatch.AddUnmap(textureIdx, frame % kTilesPerTexture, 0);
+                    m_DirtyTextures.OnTilesUnmapped(textureIdx, 1);
+                }
+            }
+            m_DirtyTextures.Clear();
+            for (const TileMappingRun& run : m_TileMappingBatch.Build())
+                m_Checksum += run.m_NumTiles;
+            m_StagingRing.Retire(frame >= 2 ? frame - 2 : 0);
+
+            // ─── Budgets
+            StreamingFrameSample sample;
+            sample.m_FrameSeconds      = 1.0 / 60.0;
+            sample.m_UploadSeconds     = 0.001;
+            sample.m_TilesUploaded     = (uint32_t)scheduledTiles.size();
+            sample.m_TilesCompleted    = (uint32_t)scheduledTiles.size();
+            sample.m_WorkerBusySeconds = 0.004;
+            sample.m_LatencySeconds    = 0.02 * scheduledTiles.size();
+            sample.m_NumWorkers        = 4;
+            sample.m_NumTextures       = kNumTextures;
+            m_Checksum += m_BudgetController.Update(sample).m_MaxTilesPerFrame;
+
+            // ─── Geometry LODs
+            for (uint32_t i = 0; i < kNumPrimitives; ++i)
+                m_RequestedLODs[i] = ((i + frame) % 64 < 16) ? (i + frame / 8) % 4 : GeometryLODScheduler::kNoRequest;
+            m_LODScheduler.Update(m_RequestedLODs, frame);
+            m_LODScheduler.GetLoads(16, 1024 * 1024, m_LODLoads);
+            for (const GeometryLODRef& load : m_LODLoads)
+            {
+                m_LODScheduler.OnLoadSubmitted(load.m_Primitive, load.m_LOD);
+                m_LODScheduler.OnLoadCompleted(load.m_Primitive, load.m_LOD, frame);
+            }
+            m_LODScheduler.GetExpired(frame, 30, m_LODExpired);
+            for (const GeometryLODRef& expired : m_LODExpired)
+                m_LODScheduler.OnEvicted(expired.m_Primitive, expired.m_LOD);
+
+            // ─── Tasks (TaskScheduler's queue of InplaceFunctions)
+            for (uint32_t i = 0; i < kNumTasks; ++i)
+                m_Tasks.emplace_back([this, i]() { m_Checksum += i; });
+            for (InplaceFunction<void()>& task : m_Tasks)
+                task();
+            m_Tasks.clear();
+
+            // ─── ExecutePendingCommandLists: acquire from the free list, submit
+            // through an arena array, retire last frame's lists
+            m_CommandListFreeList.insert(m_CommandListFreeList.end(), m_InFlightCommandLists.begin(), m_InFlightCommandLists.end());
+            m_InFlightCommandLists.clear();
+            for (uint32_t i = 0; i < kNumCommandLists / 2 + frame % (kNumCommandLists / 2); ++i)
+            {
+                m_PendingCommandLists.push_back(m_CommandListFreeList.back());
+                m_CommandListFreeList.pop_back();
+            }
+            std::pmr::vector<const int*> rawLists{ &m_FrameAllocator };
+            rawLists.reserve(m_PendingCommandLists.size());
+            for (const int& commandList : m_PendingCommandLists)
+                rawLists.push_back(&commandList);
+            for (const int* commandList : rawLists)
+                m_Checksum += (uint64_t)*commandList;
+            m_InFlightCommandLists.insert(m_InFlightCommandLists.end(), m_PendingCommandLists.begin(), m_PendingCommandLists.end());
+            m_PendingCommandLists.clear();
+        }
+    };
+} // namespace
+
+TEST_CASE(SteadyStateFrame, NoHeapAllocationsAfterWarmUp)
+{
+    if (!ENABLE_ALLOCATION_COUNTING)
+    {
+        std::printf("  allocation counting is disabled in this build (NDEBUG)\n");
+        return;
+    }
+
+    SteadyStateFrame frame;
+    uint32_t frameNumber = 1;
+    for (; frameNumber <= kWarmUpFrames; ++frameNumber)
+        frame.Run(frameNumber);
+
+    uint64_t maxFrameAllocations = 0;
+    uint32_t numAllocatingFrames = 0;
+    const uint64_t allocationsBefore = GetGlobalAllocationCount();
+    for (uint32_t i = 0; i < kMeasuredFrames; ++i, ++frameNumber)
+    {
+        const uint64_t frameStart = GetGlobalAllocationCount();
+        frame.Run(frameNumber);
+        const uint64_t frameAllocations = GetGlobalAllocationCount() - frameStart;
+        maxFrameAllocations = std::max(maxFrameAllocations, frameAllocations);
+        numAllocatingFrames += frameAllocations > 0;
+    }
+    const uint64_t allocations = GetGlobalAllocationCount() - allocationsBefore;
+
+    std::printf("  %u frames after %u warm-up frames: %llu heap allocations (%u frames allocating, at most %llu), "
+                "%zu KB frame arena high-water mark, %u pending tiles\n",
+                kMeasuredFrames, kWarmUpFrames, (unsigned long long)allocations, numAllocatingFrames,
+                (unsigned long long)maxFrameAllocations, frame.m_FrameAllocator.GetHighWaterMark() / 1024,
+                frame.m_TileScheduler.GetNumPending());
+    CHECK(allocations == 0);
+    CHECK(frame.m_FrameAllocator.GetOverflowCount() == 0);
+    CHECK(frame.m_Checksum != 0);
+}
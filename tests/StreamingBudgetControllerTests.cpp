@@ -0,0 +1,148 @@
+#include "TestFramework.h"
+
+#include "Streaming/StreamingBudgetController.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    constexpr double   kFrameSeconds = 1.0 / 60.0;
+    constexpr uint32_t kNumWorkers   = 4;
+
+    // I/O workers draining a FIFO of tiles: each tile keeps one worker busy for
+    // m_SecondsPerTile; a tile's latency is the time it waited plus its own read.
+    struct IOModel
+    {
+        double m_SecondsPerTile = 0.001;
+        double m_Queue          = 0.0; // tiles submitted, not yet completed
+
+        StreamingFrameSample Step(uint32_t tilesSubmitted)
+        {
+            m_Queue += tilesSubmitted;
+            const double capacity  = kNumWorkers * kFrameSeconds / m_SecondsPerTile;
+            const double completed = std::min(m_Queue, capacity);
+            m_Queue -= completed;
+
+            StreamingFrameSample sample;
+            sample.m_FrameSeconds      = kFrameSeconds;
+            sample.m_TilesCompleted    = (uint32_t)completed;
+            sample.m_WorkerBusySeconds = sample.m_TilesCompleted * m_SecondsPerTile;
+            sample.m_LatencySeconds    = sample.m_TilesCompleted * (m_SecondsPerTile + m_Queue / capacity * kFrameSeconds);
+            sample.m_NumWorkers        = kNumWorkers;
+            sample.m_NumTextures       = 300;
+            sample.m_VRAMHeadroomBytes = 512ull * 1024 * 1024;
+            return sample;
+        }
+    };
+
+    uint32_t GetTargetTilesPerFrame(double secondsPerTile)
+    {
+        return (uint32_t)std::lround(kNumWorkers / secondsPerTile * kFrameSeconds * StreamingBudgetController::kIOUtilization);
+    }
+
+    // Runs the controller against the model for numFrames and returns the tile budget of every frame
+    std::vector<uint32_t> Run(StreamingBudgetController& controller, IOModel& io, uint32_t numFrames)
+    {
+        std::vector<uint32_t> budgets;
+        for (uint32_t frame = 0; frame < numFrames; ++frame)
+            budgets.push_back(controller.Update(io.Step(controller.GetBudgets().m_MaxTilesPerFrame)).m_MaxTilesPerFrame);
+        return budgets;
+    }
+
+    uint32_t CountDirectionChanges(const std::vector<uint32_t>& budgets)
+    {
+        uint32_t numChanges = 0;
+        int lastDirection = 0;
+        for (size_t i = 1; i < budgets.size(); ++i)
+        {
+            const int direction = budgets[i] > budgets[i - 1] ? 1 : (budgets[i] < budgets[i - 1] ? -1 : 0);
+            if (direction != 0 && lastDirection != 0 && direction != lastDirection)
+                numChanges++;
+            if (direction != 0)
+                lastDirection = direction;
+        }
+        return numChanges;
+    }
+} // namespace
+
+TEST_CASE(StreamingBudgetController, StepResponse)
+{
+    StreamingBudgetController controller;
+    IOModel io;
+
+    // Settle at 1 ms per tile
+    Run(controller, io, 300);
+    const uint32_t slowTarget = GetTargetTilesPerFrame(io.m_SecondsPerTile);
+    const uint32_t settled = controller.GetBudgets().m_MaxTilesPerFrame;
+    std::printf("  1 ms/tile: target %u, settled at %u\n", slowTarget, settled);
+    CHECK(std::abs((int)settled - (int)slowTarget) <= (int)(slowTarget * StreamingBudgetController::kDeadBand) + 1);
+
+    // I/O gets 4x faster: the budget rises monotonically, at most kMaxStepFraction per frame
+    io.m_SecondsPerTile = 0.00025;
+    const std::vector<uint32_t> rise = Run(controller, io, 200);
+    const uint32_t fastTarget = GetTargetTilesPerFrame(io.m_SecondsPerTile);
+    uint32_t previous = settled;
+    uint32_t riseFrames = 0;
+    for (uint32_t budget : rise)
+    {
+        CHECK(budget >= previous);
+        CHECK(budget <= std::max<uint32_t>((uint32_t)std::ceil(previous * (1.0f + StreamingBudgetController::kMaxStepFraction)), previous + 1));
+        if (budget < fastTarget * (1.0f - StreamingBudgetController::kDeadBand))
+            riseFrames++;
+        previous = budget;
+    }
+    std::printf("  0.25 ms/tile: target %u, reached %u after %u frames\n", fastTarget, rise.back(), riseFrames);
+    CHECK(std::abs((int)rise.back() - (int)fastTarget) <= (int)(fastTarget * StreamingBudgetController::kDeadBand) + 1);
+    CHECK(riseFrames < 60);
+
+    // I/O gets 4x slower again: the queue backs up, the budget backs off and
+    // settles at the old level without oscillating
+    io.m_SecondsPerTile = 0.001;
+    const std::vector<uint32_t> fall = Run(controller, io, 300);
+    std::printf("  back to 1 ms/tile: min %u, settled at %u, %u direction changes, queue %.0f tiles\n",
+                *std::min_element(fall.begin(), fall.end()), fall.back(), CountDirectionChanges(fall), io.m_Queue);
+    CHECK(std::abs((int)fall.back() - (int)slowTarget) <= (int)(slowTarget * StreamingBudgetController::kDeadBand) + 1);
+    CHECK(*std::min_element(fall.begin(), fall.end()) >= StreamingBudgetController::kMinTilesPerFrame);
+    CHECK(CountDirectionChanges(fall) <= 1);
+    CHECK(io.m_Queue < slowTarget);
+
+    // Steady state: no more budget changes once settled
+    const std::vector<uint32_t> steady = Run(controller, io, 200);
+    CHECK(*std::min_element(steady.begin(), steady.end()) == *std::max_element(steady.begin(), steady.end()));
+}
+
+TEST_CASE(StreamingBudgetController, IgnoresNoiseInsideTheDeadBand)
+{
+    StreamingBudgetController controller;
+    IOModel io;
+    Run(controller, io, 300);
+    const uint32_t settled = controller.GetBudgets().m_MaxTilesPerFrame;
+
+    // +-10% jitter on the read cost never moves the budget
+    std::vector<uint32_t> budgets;
+    for (uint32_t frame = 0; frame < 300; ++frame)
+    {
+        io.m_SecondsPerTile = 0.001 * (frame % 2 ? 1.1 : 0.9);
+        budgets.push_back(controller.Update(io.Step(controller.GetBudgets().m_MaxTilesPerFrame)).m_MaxTilesPerFrame);
+    }
+    for (uint32_t budget : budgets)
+        CHECK(budget == settled);
+}
+
+TEST_CASE(StreamingBudgetController, DropsStandbyTilesUnderPressure)
+{
+    StreamingBudgetController controller;
+    IOModel io;
+    Run(controller, io, 100);
+    CHECK(controller.GetBudgets().m_NumExtraStandbyTiles > 0);
+
+    StreamingFrameSample sample = io.Step(controller.GetBudgets().m_MaxTilesPerFrame);
+    sample.m_bVRAMPressure = true;
+    sample.m_VRAMHeadroomBytes = 0;
+    CHECK(controller.Update(sample).m_NumExtraStandbyTiles == 0);
+    CHECK(controller.GetBudgets().m_TileHysteresisSeconds >= StreamingBudgetController::kMinHysteresisSeconds);
+}
@@ -0,0 +1,176 @@
+#include "TestFramework.h"
+
+#include "Streaming/StreamingTrace.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+
+using namespace nvfeedback;
+
+namespace
+{
+    constexpr uint32_t kHeapSizeInTiles = 64;
+
+    // 1024x1024 with 128x128 tiles: 4 standard mips (85 tiles), mips 64..1 packed into one tile
+    StreamingTraceTexture MakeTexture()
+    {
+        StreamingTraceTexture texture;
+        texture.m_Width              = 1024;
+        texture.m_Height             = 1024;
+        texture.m_NumStandardMips    = 4;
+        texture.m_NumPackedMips      = 7;
+        texture.m_NumPackedTiles     = 1;
+        texture.m_TileWidthInTexels  = 128;
+        texture.m_TileHeightInTexels = 128;
+        return texture;
+    }
+
+    // Feedback regions per texture, from TTM exactly as the simulator derives them
+    size_t GetNumFeedbackRegions(const StreamingTraceTexture& texture)
+    {
+        rtxts::TiledTextureManagerDesc managerDesc{};
+        managerDesc.heapTilesCapacity = kHeapSizeInTiles;
+        std::unique_ptr<rtxts::TiledTextureManager> manager(rtxts::CreateTiledTextureManager(managerDesc));
+
+        rtxts::TiledLevelDesc levelDescs[16]{};
+        rtxts::TiledTextureDesc desc{};
+        desc.textureWidth        = texture.m_Width;
+        desc.textureHeight       = texture.m_Height;
+        desc.tiledLevelDescs     = levelDescs;
+        desc.regularMipLevelsNum = texture.m_NumStandardMips;
+        desc.packedMipLevelsNum  = texture.m_NumPackedMips;
+        desc.packedTilesNum      = texture.m_NumPackedTiles;
+        desc.tileWidth           = texture.m_TileWidthInTexels;
+        desc.tileHeight          = texture.m_TileHeightInTexels;
+        for (uint32_t mip = 0; mip < texture.m_NumStandardMips; ++mip)
+        {
+            levelDescs[mip].widthInTiles  = DivideAndRoundUp(std::max(1u, texture.m_Width  >> mip), desc.tileWidth);
+            levelDescs[mip].heightInTiles = DivideAndRoundUp(std::max(1u, texture.m_Height >> mip), desc.tileHeight);
+        }
+
+        uint32_t textureId = 0;
+        manager->AddTiledTexture(desc, textureId);
+        const rtxts::TextureDesc feedbackDesc = manager->GetTextureDesc(textureId, rtxts::eFeedbackTexture);
+        const uint32_t regionsX = (texture.m_Width  - 1) / std::max(feedbackDesc.textureOrMipRegionWidth, 1u)  + 1;
+        const uint32_t regionsY = (texture.m_Height - 1) / std::max(feedbackDesc.textureOrMipRegionHeight, 1u) + 1;
+        return (size_t)regionsX * regionsY;
+    }
+
+    // The camera looks at texture 0 for a few frames, then turns to texture 1 for
+    // the rest of the trace.  Texture 0's tiles stay allocated (long hysteresis),
+    // so its requests are still queued when texture 1's arrive, and the tile I/O
+    // only moves 4 tiles per frame.
+    bool WriteCameraTurnTrace(const std::filesystem::path& path, uint32_t numFrames)
+    {
+        StreamingTraceWriter writer;
+        if (!writer.Open(path, kHeapSizeInTiles))
+            return false;
+
+        const StreamingTraceTexture texture = MakeTexture();
+        const size_t numRegions = GetNumFeedbackRegions(texture);
+        const std::vector<uint8_t> sampledAtMip0(numRegions, 0);
+        const std::vector<uint8_t> notSampled(numRegions, 0xFF);
+
+        writer.AddTexture(0, texture);
+        writer.AddTexture(1, texture);
+        writer.MapPackedMips(0);
+        writer.MapPackedMips(1);
+
+        for (uint32_t frame = 1; frame <= numFrames; ++frame)
+        {
+            StreamingTraceFrame traceFrame;
+            traceFrame.m_FrameNumber                     = frame;
+            traceFrame.m_TimeStamp                       = (float)frame / 60.0f;
+            traceFrame.m_Budgets.m_MaxTilesPerFrame      = 4;
+            traceFrame.m_Budgets.m_NumExtraStandbyTiles  = 1024;
+            traceFrame.m_Budgets.m_TileHysteresisSeconds = 100.0f;
+            writer.BeginFrame(traceFrame);
+
+            const bool bLookingAtTexture0 = (frame <= 3);
+            writer.Feedback(0, bLookingAtTexture0 ? sampledAtMip0 : notSampled);
+            writer.Feedback(1, bLookingAtTexture0 ? notSampled : sampledAtMip0);
+        }
+
+        writer.Close();
+        return true;
+    }
+} // namespace
+
+TEST_CASE(StreamingSim, PrioritySchedulingBeatsFifo)
+{
+    const std::filesystem::path tracePath = std::filesystem::temp_directory_path() / "HobbyRendererTests_CameraTurn.strace";
+    REQUIRE(WriteCameraTurnTrace(tracePath, 90));
+
+    StreamingSimConfig config;
+    config.m_IOLatencyFrames = 1;
+    config.m_IOTilesPerFrame = 4;
+
+    StreamingSimStats priorityStats;
+    const bool bPriorityOk = SimulateStreamingTrace(tracePath, config, priorityStats);
+
+    config.m_bFifoScheduling = true;
+    StreamingSimStats fifoStats;
+    const bool bFifoOk = SimulateStreamingTrace(tracePath, config, fifoStats);
+
+    std::error_code ec;
+    std::filesystem::remove(tracePath, ec);
+    REQUIRE(bPriorityOk && bFifoOk);
+
+    std::printf("  hit rate: priority %.2f%%, FIFO %.2f%% (%llu vs %llu tiles loaded)\n",
+                priorityStats.GetHitRate() * 100.0, fifoStats.GetHitRate() * 100.0,
+                (unsigned long long)priorityStats.m_TilesLoaded, (unsigned long long)fifoStats.m_TilesLoaded);
+
+    CHECK(priorityStats.m_NumFrames == 90);
+    CHECK(priorityStats.m_RegionsSampled == fifoStats.m_RegionsSampled);
+    CHECK(priorityStats.m_TilesLoaded > 0);
+    // The stale texture-0 requests go behind texture 1's under priority scheduling
+    CHECK(priorityStats.GetHitRate() > fifoStats.GetHitRate());
+}
+
+TEST_CASE(StreamingSim, TraceRoundTrip)
+{
+    const std::filesystem::path tracePath = std::filesystem::temp_directory_path() / "HobbyRendererTests_RoundTrip.strace";
+    REQUIRE(WriteCameraTurnTrace(tracePath, 5));
+
+    uint32_t numTextures = 0;
+    uint32_t numFrames   = 0;
+    uint32_t numFeedback = 0;
+    bool     bReadError  = true;
+    {
+        StreamingTraceReader reader;
+        REQUIRE(reader.Open(tracePath));
+        CHECK(reader.GetHeader().m_HeapSizeInTiles == kHeapSizeInTiles);
+
+        StreamingTraceEvent event;
+        while (reader.Next(event))
+        {
+            switch (event.m_Type)
+            {
+            case StreamingTraceRecord::AddTexture:
+                CHECK(event.m_Texture.m_Width == 1024 && event.m_Texture.m_NumPackedMips == 7);
+                numTextures++;
+                break;
+            case StreamingTraceRecord::BeginFrame:
+                CHECK(event.m_Frame.m_FrameNumber == numFrames + 1);
+                CHECK(event.m_Frame.m_Budgets.m_MaxTilesPerFrame == 4);
+                numFrames++;
+                break;
+            case StreamingTraceRecord::Feedback:
+                CHECK(event.m_MinMipData.size() == GetNumFeedbackRegions(MakeTexture()));
+                numFeedback++;
+                break;
+            default:
+                break;
+            }
+        }
+        bReadError = reader.HasError();
+    }
+    std::error_code ec;
+    std::filesystem::remove(tracePath, ec);
+
+    CHECK(!bReadError);
+    CHECK(numTextures == 2);
+    CHECK(numFrames == 5);
+    CHECK(numFeedback == 10);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+// ─── Test framework ──────────────────────────────────────────────────────────
+// Minimal self-registering test cases for HobbyRendererTests.
+//
+//   TEST_CASE(TileCache, EvictsUnreferencedFirst)
+//   {
+//       CHECK(cache.Find(key) != TileCachePolicy::kInvalidSlot);
+//       REQUIRE(slot < capacity);   // returns from the test case on failure
+//   }
+//
+// The group (first argument) matches the <Group>Tests.cpp file and the CTest
+// case that runs it; see tests/CMakeLists.txt.  A failed CHECK is reported
+// and the test case carries on; the process exits non-zero if any failed.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct TestCase
+{
+    const char* m_Group = nullptr;
+    const char* m_Name  = nullptr;
+    void (*m_Fn)()      = nullptr;
+};
+
+std::vector<TestCase>& GetTestCases();
+
+// Counts a failed check of the running test case.
+void ReportTestFailure(const char* file, int line, const char* expression);
+
+// Runs the test cases selected by argv[1..] (all of them without arguments);
+// returns the process exit code.
+int RunTestCases(int argc, char* argv[]);
+
+struct TestRegistrar
+{
+    TestRegistrar(const char* group, const char* name, void (*fn)()) { GetTestCases().push_back({ group, name, fn }); }
+};
+
+#define TEST_CASE(group, name) \
+    static void group##_##name(); \
+    static const TestRegistrar s_TestRegistrar_##group##_##name{ #group, #name, &group##_##name }; \
+    static void group##_##name()
+
+#define CHECK(expr) \
+    do { if (!(expr)) ReportTestFailure(__FILE__, __LINE__, #expr); } while (0)
+
+#define REQUIRE(expr) \
+    do { if (!(expr)) { ReportTestFailure(__FILE__, __LINE__, #expr); return; } } while (0)
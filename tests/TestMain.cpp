@@ -0,0 +1,10 @@
+#include "TestFramework.h"
+
+// ============================================================
+// HobbyRendererTests — headless CPU test runner
+// ============================================================
+
+int main(int argc, char* argv[])
+{
+    return RunTestCases(argc, argv);
+}
@@ -0,0 +1,79 @@
+#include "TestFramework.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+// ============================================================
+// Test runner, shared by HobbyRendererTests and the renderer's
+// --run-tests mode (engine test groups, see CMakeLists.txt)
+// ============================================================
+//   <runner>                 runs every test case
+//   <runner> <Group> ...     runs the named groups
+//   <runner> <Group.Name>    runs one test case
+
+namespace
+{
+    uint32_t g_NumFailedChecks = 0;
+}
+
+std::vector<TestCase>& GetTestCases()
+{
+    static std::vector<TestCase> s_TestCases;
+    return s_TestCases;
+}
+
+void ReportTestFailure(const char* file, int line, const char* expression)
+{
+    std::printf("  %s(%d): CHECK failed: %s\n", file, line, expression);
+    g_NumFailedChecks++;
+}
+
+static bool MatchesFilter(const TestCase& testCase, const char* filter)
+{
+    const size_t groupLength = std::strlen(testCase.m_Group);
+    if (std::strncmp(filter, testCase.m_Group, groupLength) != 0)
+        return false;
+    if (filter[groupLength] == '\0')
+        return true;
+    return filter[groupLength] == '.' && std::strcmp(filter + groupLength + 1, testCase.m_Name) == 0;
+}
+
+int RunTestCases(int argc, char* argv[])
+{
+    uint32_t numRun    = 0;
+    uint32_t numFailed = 0;
+
+    for (const TestCase& testCase : GetTestCases())
+    {
+        bool bSelected = (argc < 2);
+        for (int i = 1; i < argc && !bSelected; ++i)
+            bSelected = MatchesFilter(testCase, argv[i]);
+        if (!bSelected)
+            continue;
+
+        std::printf("[ RUN  ] %s.%s\n", testCase.m_Group, testCase.m_Name);
+        std::fflush(stdout);
+
+        const uint32_t failedBefore = g_NumFailedChecks;
+        const auto start = std::chrono::steady_clock::now();
+        testCase.m_Fn();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        const bool bPassed = (g_NumFailedChecks == failedBefore);
+        std::printf("[ %s ] %s.%s (%.1f ms)\n", bPassed ? " OK " : "FAIL", testCase.m_Group, testCase.m_Name, ms);
+        std::fflush(stdout);
+
+        numRun++;
+        numFailed += bPassed ? 0 : 1;
+    }
+
+    if (numRun == 0)
+    {
+        std::printf("No test case matches the arguments\n");
+        return 1;
+    }
+
+    std::printf("%u test case(s), %u failed\n", numRun, numFailed);
+    return numFailed == 0 ? 0 : 1;
+}
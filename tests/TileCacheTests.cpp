@@ -0,0 +1,184 @@
+#include "TestFramework.h"
+
+#include "Streaming/TileCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    constexpr uint64_t kTileBytes = 64 * 1024;
+
+    TileCacheKey MakeKey(uint32_t tile)
+    {
+        TileCacheKey key;
+        key.m_Source    = 1 + tile / 64;
+        key.m_MipLevel  = tile % 3;
+        key.m_XInTexels = (tile % 8) * 128;
+        key.m_YInTexels = ((tile / 8) % 8) * 128;
+        return key;
+    }
+
+    // Textbook CLOCK over a fixed number of frames: a victim is replaced in place
+    // and the hand moves past it
+    struct ReferenceClock
+    {
+        std::vector<uint32_t> m_Frames;
+        std::vector<bool>     m_Referenced;
+        uint32_t              m_Capacity = 0;
+        uint32_t              m_Hand     = 0;
+
+        bool Access(uint32_t tile, uint32_t& outEvicted)
+        {
+            outEvicted = UINT32_MAX;
+            auto it = std::find(m_Frames.begin(), m_Frames.end(), tile);
+            if (it != m_Frames.end())
+            {
+                m_Referenced[it - m_Frames.begin()] = true;
+                return true;
+            }
+
+            if (m_Frames.size() < m_Capacity)
+            {
+                m_Frames.push_back(tile);
+                m_Referenced.push_back(false);
+                return false;
+            }
+
+            while (m_Referenced[m_Hand])
+            {
+                m_Referenced[m_Hand] = false;
+                m_Hand = (m_Hand + 1) % m_Capacity;
+            }
+            outEvicted = m_Frames[m_Hand];
+            m_Frames[m_Hand] = tile;
+            m_Hand = (m_Hand + 1) % m_Capacity;
+            return false;
+        }
+    };
+} // namespace
+
+TEST_CASE(TileCache, MatchesTextbookClockForEqualTiles)
+{
+    constexpr uint32_t kCapacityTiles = 64;
+    constexpr uint32_t kNumTiles      = 400;
+
+    TileCachePolicy policy(kCapacityTiles * kTileBytes);
+    ReferenceClock reference;
+    reference.m_Capacity = kCapacityTiles;
+
+    // Skewed accesses: a few tiles are hot, most come back rarely
+    std::mt19937 rng(3);
+    std::exponential_distribution<double> skew(1.0 / 60.0);
+
+    uint32_t numHits = 0;
+    uint32_t numMismatches = 0;
+    std::vector<uint32_t> evicted;
+    for (uint32_t access = 0; access < 20000; ++access)
+    {
+        const uint32_t tile = std::min((uint32_t)skew(rng), kNumTiles - 1);
+
+        uint32_t expectedEvicted;
+        const bool bExpectedHit = reference.Access(tile, expectedEvicted);
+
+        bool bHit = policy.Find(MakeKey(tile)) != TileCachePolicy::kInvalidSlot;
+        evicted.clear();
+        if (!bHit)
+            CHECK(policy.Insert(MakeKey(tile), kTileBytes, evicted) != TileCachePolicy::kInvalidSlot);
+
+        numHits += bHit;
+        if (bHit != bExpectedHit || evicted.size() != (expectedEvicted == UINT32_MAX ? 0u : 1u))
+            numMismatches++;
+        CHECK(policy.GetSizeInBytes() <= policy.GetCapacityBytes());
+    }
+
+    std::printf("  %u of 20000 hits, %llu evictions, %u mismatches\n", numHits, (unsigned long long)policy.GetNumEvictions(), numMismatches);
+    CHECK(numMismatches == 0);
+    CHECK(policy.GetNumEntries() == kCapacityTiles);
+}
+
+TEST_CASE(TileCache, ReferencedTilesGetASecondChance)
+{
+    TileCachePolicy policy(8 * kTileBytes);
+    std::vector<uint32_t> evicted;
+    for (uint32_t tile = 0; tile < 8; ++tile)
+        policy.Insert(MakeKey(tile), kTileBytes, evicted);
+
+    // Tiles 0-3 are hit again; a burst of 4 new tiles evicts 4-7 instead
+    for (uint32_t tile = 0; tile < 4; ++tile)
+        CHECK(policy.Find(MakeKey(tile)) != TileCachePolicy::kInvalidSlot);
+    for (uint32_t tile = 100; tile < 104; ++tile)
+        policy.Insert(MakeKey(tile), kTileBytes, evicted);
+
+    CHECK(evicted.size() == 4);
+    for (uint32_t tile = 0; tile < 4; ++tile)
+        CHECK(policy.Find(MakeKey(tile)) != TileCachePolicy::kInvalidSlot);
+    for (uint32_t tile = 4; tile < 8; ++tile)
+        CHECK(policy.Find(MakeKey(tile)) == TileCachePolicy::kInvalidSlot);
+}
+
+TEST_CASE(TileCache, StaysWithinTheByteCap)
+{
+    TileCachePolicy policy(10 * kTileBytes);
+    std::vector<uint32_t> evicted;
+
+    // Larger than the whole cache, or already cached: rejected
+    CHECK(policy.Insert(MakeKey(0), 11 * kTileBytes, evicted) == TileCachePolicy::kInvalidSlot);
+    CHECK(policy.Insert(MakeKey(1), 3 * kTileBytes, evicted) != TileCachePolicy::kInvalidSlot);
+    CHECK(policy.Insert(MakeKey(1), kTileBytes, evicted) == TileCachePolicy::kInvalidSlot);
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<uint32_t> sizeDist(1, 4);
+    for (uint32_t tile = 2; tile < 200; ++tile)
+    {
+        evicted.clear();
+        const uint32_t slot = policy.Insert(MakeKey(tile), sizeDist(rng) * kTileBytes, evicted);
+        CHECK(slot != TileCachePolicy::kInvalidSlot);
+        CHECK(policy.GetSizeInBytes() <= policy.GetCapacityBytes());
+        CHECK(evicted.size() <= 4);
+    }
+
+    const uint64_t sizeBefore = policy.GetSizeInBytes();
+    const uint32_t entriesBefore = policy.GetNumEntries();
+    policy.Erase(MakeKey(199));
+    CHECK(policy.GetNumEntries() == entriesBefore - 1);
+    CHECK(policy.GetSizeInBytes() < sizeBefore);
+}
+
+TEST_CASE(TileCache, CopiesRowsAndKeepsOwnersAlive)
+{
+    TileCache cache(2 * 256);
+    std::shared_ptr<int> owner = std::make_shared<int>(0);
+    std::weak_ptr<int> weakOwner = owner;
+
+    std::vector<uint8_t> tile(256);
+    for (size_t i = 0; i < tile.size(); ++i)
+        tile[i] = (uint8_t)i;
+    cache.Insert(MakeKey(0), owner, std::vector<uint8_t>(tile));
+    owner.reset();
+    CHECK(!weakOwner.expired());
+
+    // 16 rows of 16 bytes into a 32-byte pitch
+    std::vector<uint8_t> dst(16 * 32, 0xFF);
+    REQUIRE(cache.Lookup(MakeKey(0), dst.data(), 32, 16, 16));
+    CHECK(dst[0] == 0 && dst[15] == 15 && dst[16] == 0xFF && dst[32] == 16 && dst[15 * 32 + 15] == 255);
+
+    // Same key, different tile size: a miss
+    CHECK(!cache.Lookup(MakeKey(0), dst.data(), 8, 8, 8));
+
+    // The hit gave the first tile a second chance, so tile 1 goes first;
+    // the next insert pushes the first tile out and releases its owner
+    cache.Insert(MakeKey(1), nullptr, std::vector<uint8_t>(256));
+    cache.Insert(MakeKey(2), nullptr, std::vector<uint8_t>(256));
+    CHECK(!weakOwner.expired());
+    cache.Insert(MakeKey(3), nullptr, std::vector<uint8_t>(256));
+    CHECK(weakOwner.expired());
+
+    const TileCache::Stats stats = cache.GetStats();
+    CHECK(stats.m_NumHits == 1 && stats.m_NumMisses == 1);
+    CHECK(stats.m_NumEntries == 2 && stats.m_NumEvictions == 2);
+}
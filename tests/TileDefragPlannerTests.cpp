@@ -0,0 +1,205 @@
+#include "TestFramework.h"
+
+#include "Streaming/TileDefragPlanner.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    constexpr uint32_t kHeapSizeInTiles = 64;
+
+    void AllocateTiles(TileDefragPlanner& planner, uint32_t heapId, uint32_t numTiles)
+    {
+        for (uint32_t i = 0; i < numTiles; ++i)
+            planner.OnTileAllocated(heapId);
+    }
+
+    // Heap occupancy as TTM keeps it: tiles go to the first heap with a free slot,
+    // a new heap is created when all are full and an empty unpinned heap is released
+    struct MockHeaps
+    {
+        TileDefragPlanner     m_Planner{ kHeapSizeInTiles };
+        std::vector<uint32_t> m_NumTiles;  // per heap id
+        std::vector<bool>     m_bActive;
+        uint32_t              m_NumHeapsReleased = 0;
+
+        uint32_t AddHeap(bool bPinned)
+        {
+            const uint32_t heapId = (uint32_t)m_NumTiles.size();
+            m_NumTiles.push_back(0);
+            m_bActive.push_back(true);
+            m_Planner.AddHeap(heapId, bPinned);
+            return heapId;
+        }
+
+        void Allocate(uint32_t skipHeapId = UINT32_MAX)
+        {
+            for (uint32_t heapId = 0; heapId < m_NumTiles.size(); ++heapId)
+            {
+                if (m_bActive[heapId] && heapId != skipHeapId && m_NumTiles[heapId] < kHeapSizeInTiles)
+                {
+                    m_NumTiles[heapId]++;
+                    m_Planner.OnTileAllocated(heapId);
+                    return;
+                }
+            }
+            const uint32_t heapId = AddHeap(false);
+            m_NumTiles[heapId]++;
+            m_Planner.OnTileAllocated(heapId);
+        }
+
+        void Free(uint32_t heapId)
+        {
+            m_NumTiles[heapId]--;
+            m_Planner.OnTileFreed(heapId);
+        }
+
+        void ReleaseEmptyHeaps()
+        {
+            // Heap 0 holds the packed mips and is never released
+            for (uint32_t heapId = 1; heapId < m_NumTiles.size(); ++heapId)
+            {
+                if (m_bActive[heapId] && m_NumTiles[heapId] == 0)
+                {
+                    m_bActive[heapId] = false;
+                    m_Planner.RemoveHeap(heapId);
+                    m_NumHeapsReleased++;
+                }
+            }
+        }
+
+        uint32_t GetNumTiles() const
+        {
+            uint32_t numTiles = 0;
+            for (uint32_t n : m_NumTiles)
+                numTiles += n;
+            return numTiles;
+        }
+
+        uint32_t GetNumActiveHeaps() const { return (uint32_t)std::count(m_bActive.begin(), m_bActive.end(), true); }
+    };
+} // namespace
+
+TEST_CASE(TileDefragPlanner, PicksANearlyEmptyHeapThatFits)
+{
+    TileDefragPlanner planner(kHeapSizeInTiles);
+    planner.AddHeap(0, true);
+    planner.AddHeap(1, false);
+    planner.AddHeap(2, false);
+    AllocateTiles(planner, 0, 2);   // pinned: never a source, even nearly empty
+    AllocateTiles(planner, 1, 40);
+    AllocateTiles(planner, 2, 20);
+
+    // Heap 2 is too full to be worth moving...
+    CHECK(planner.Plan(kMaxDefragMovesPerFrame, false).m_NumTilesToMove == 0);
+    // ...except in low-memory mode
+    TileDefragPlan plan = planner.Plan(kMaxDefragMovesPerFrame, true);
+    CHECK(plan.m_SourceHeapId == 2 && plan.m_NumTilesToMove == kMaxDefragMovesPerFrame);
+
+    // A quarter full, it is evacuated in two frames
+    for (uint32_t i = 0; i < 4; ++i)
+        planner.OnTileFreed(2);
+    plan = planner.Plan(kMaxDefragMovesPerFrame, false);
+    CHECK(plan.m_SourceHeapId == 2 && plan.m_NumTilesToMove == kMaxDefragMovesPerFrame);
+    CHECK(planner.Plan(4, false).m_NumTilesToMove == 4);
+    CHECK(planner.Plan(0, false).m_NumTilesToMove == 0);
+
+    // Empty heaps are released, not evacuated: heap 1 becomes the source
+    for (uint32_t i = 0; i < 16; ++i)
+        planner.OnTileFreed(2);
+    CHECK(planner.GetNumAllocatedTiles(2) == 0);
+    plan = planner.Plan(kMaxDefragMovesPerFrame, true);
+    CHECK(plan.m_SourceHeapId == 1);
+}
+
+TEST_CASE(TileDefragPlanner, NeverMovesMoreThanTheOtherHeapsCanTake)
+{
+    TileDefragPlanner planner(kHeapSizeInTiles);
+    planner.AddHeap(0, false);
+    planner.AddHeap(1, false);
+    AllocateTiles(planner, 0, kHeapSizeInTiles - 4);
+    AllocateTiles(planner, 1, 8);
+
+    // 8 tiles, 4 free slots elsewhere
+    CHECK(planner.Plan(kMaxDefragMovesPerFrame, true).m_NumTilesToMove == 0);
+    for (uint32_t i = 0; i < 4; ++i)
+        planner.OnTileFreed(1);
+    const TileDefragPlan plan = planner.Plan(kMaxDefragMovesPerFrame, true);
+    CHECK(plan.m_SourceHeapId == 1 && plan.m_NumTilesToMove == 4);
+
+    // A removed heap is neither a source nor free space
+    planner.AddHeap(2, false);
+    planner.RemoveHeap(2);
+    CHECK(planner.Plan(kMaxDefragMovesPerFrame, true).m_SourceHeapId == 1);
+}
+
+TEST_CASE(TileDefragPlanner, ReleasesHeapsAsDemandDrops)
+{
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    MockHeaps heaps;
+    heaps.AddHeap(true);
+
+    auto freeRandomTile = [&]()
+    {
+        std::uniform_int_distribution<uint32_t> tileDist(0, heaps.GetNumTiles() - 1);
+        uint32_t tile = tileDist(rng);
+        for (uint32_t heapId = 0; heapId < heaps.m_NumTiles.size(); ++heapId)
+        {
+            if (tile < heaps.m_NumTiles[heapId])
+            {
+                heaps.Free(heapId);
+                return;
+            }
+            tile -= heaps.m_NumTiles[heapId];
+        }
+    };
+
+    // Fill ten heaps, then let the working set shrink to a quarter with churn
+    for (uint32_t i = 0; i < 10 * kHeapSizeInTiles; ++i)
+        heaps.Allocate();
+    const uint32_t peakHeaps = heaps.GetNumActiveHeaps();
+
+    uint32_t numMoves = 0;
+    uint32_t numOverBudget = 0;
+    uint32_t numOverflows = 0;
+    for (uint32_t frame = 0; frame < 1000; ++frame)
+    {
+        const uint32_t targetTiles = frame < 400 ? 10 * kHeapSizeInTiles - frame * 6 / 5 : 160;
+        while (heaps.GetNumTiles() > targetTiles)
+            freeRandomTile();
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            freeRandomTile();
+            heaps.Allocate();
+        }
+
+        const TileDefragPlan plan = heaps.m_Planner.Plan(kMaxDefragMovesPerFrame, false);
+        if (plan.m_NumTilesToMove > kMaxDefragMovesPerFrame)
+            numOverBudget++;
+        for (uint32_t i = 0; i < plan.m_NumTilesToMove; ++i)
+        {
+            const uint32_t numActiveHeaps = heaps.GetNumActiveHeaps();
+            heaps.Free(plan.m_SourceHeapId);
+            heaps.Allocate(plan.m_SourceHeapId);
+            if (heaps.GetNumActiveHeaps() != numActiveHeaps)
+                numOverflows++;
+        }
+        numMoves += plan.m_NumTilesToMove;
+        heaps.ReleaseEmptyHeaps();
+    }
+
+    const uint32_t minHeaps = (heaps.GetNumTiles() + kHeapSizeInTiles - 1) / kHeapSizeInTiles;
+    std::printf("  %u heaps at peak, %u at the end (%u needed), %u released, %u tiles moved\n",
+        peakHeaps, heaps.GetNumActiveHeaps(), minHeaps, heaps.m_NumHeapsReleased, numMoves);
+    CHECK(numOverBudget == 0);
+    CHECK(numOverflows == 0);
+    CHECK(heaps.GetNumActiveHeaps() <= minHeaps + 1);
+    // Only nearly empty heaps are evacuated
+    CHECK(numMoves <= heaps.m_NumHeapsReleased * kHeapSizeInTiles / 4);
+}
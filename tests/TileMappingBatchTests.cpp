@@ -0,0 +1,171 @@
+#include "TestFramework.h"
+
+#include "Streaming/TileMappingBatch.h"
+
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    // Tiles of a texture, numbered mip by mip in row-major order as TTM does
+    constexpr uint32_t kTilesPerMip[] = { 64, 16, 4, 1 };
+    constexpr uint32_t kNumMips = 4;
+
+    uint32_t GetMipLevel(uint32_t tileIndex)
+    {
+        uint32_t mip = 0;
+        for (; tileIndex >= kTilesPerMip[mip]; ++mip)
+            tileIndex -= kTilesPerMip[mip];
+        return mip;
+    }
+
+    uint32_t GetNumTiles()
+    {
+        uint32_t numTiles = 0;
+        for (uint32_t mip = 0; mip < kNumMips; ++mip)
+            numTiles += kTilesPerMip[mip];
+        return numTiles;
+    }
+
+    // (texture, tile) -> (heap, heap slot), the way updateTextureTileMappings leaves it:
+    // a region of N tiles covers the next N tiles of its mip and, when mapped, the next
+    // N slots of its heap
+    using TileMappings = std::map<std::pair<uint32_t, uint32_t>, std::pair<uint32_t, uint32_t>>;
+
+    struct MockDevice
+    {
+        TileMappings m_Mappings;
+        uint32_t     m_NumRegions = 0;
+        bool         m_bRegionLeftItsMip = false;
+
+        void Apply(std::span<const TileMappingRun> runs)
+        {
+            for (const TileMappingRun& run : runs)
+            {
+                m_NumRegions++;
+                const uint32_t mip = GetMipLevel(run.m_TileIndex);
+                for (uint32_t i = 0; i < run.m_NumTiles; ++i)
+                {
+                    const uint32_t tileIndex = run.m_TileIndex + i;
+                    if (GetMipLevel(tileIndex) != mip)
+                        m_bRegionLeftItsMip = true;
+                    if (run.m_HeapId == TileMappingBatch::kNoHeap)
+                        m_Mappings.erase({ run.m_TextureIdx, tileIndex });
+                    else
+                        m_Mappings[{ run.m_TextureIdx, tileIndex }] = { run.m_HeapId, run.m_HeapTileIndex + i };
+                }
+            }
+        }
+    };
+} // namespace
+
+TEST_CASE(TileMappingBatch, MergesNeighboursWithinAMipAndHeap)
+{
+    TileMappingBatch batch;
+    // Tiles 62..65 straddle mip 0 and mip 1, in consecutive slots of heap 3
+    for (uint32_t tileIndex = 62; tileIndex < 66; ++tileIndex)
+        batch.Add(0, tileIndex, GetMipLevel(tileIndex), 3, 100 + tileIndex);
+    // Tile 10 twice, then 11 in a slot that does not follow on
+    batch.Add(0, 10, 0, 3, 7);
+    batch.Add(0, 10, 0, 3, 7);
+    batch.Add(0, 11, 0, 3, 9);
+    // The same tiles of another texture, added before, unmapped
+    batch.AddUnmap(1, 66, 1);
+    batch.AddUnmap(1, 67, 1);
+    batch.AddUnmap(1, 68, 1);
+
+    const std::span<const TileMappingRun> runs = batch.Build();
+    REQUIRE(runs.size() == 5);
+
+    CHECK(runs[0].m_TextureIdx == 0 && runs[0].m_TileIndex == 10 && runs[0].m_NumTiles == 1);
+    CHECK(runs[1].m_TextureIdx == 0 && runs[1].m_TileIndex == 11 && runs[1].m_HeapTileIndex == 9 && runs[1].m_NumTiles == 1);
+    CHECK(runs[2].m_TileIndex == 62 && runs[2].m_HeapTileIndex == 162 && runs[2].m_NumTiles == 2);
+    CHECK(runs[3].m_TileIndex == 64 && runs[3].m_HeapTileIndex == 164 && runs[3].m_NumTiles == 2);
+    CHECK(runs[4].m_TextureIdx == 1 && runs[4].m_HeapId == TileMappingBatch::kNoHeap);
+    CHECK(runs[4].m_TileIndex == 66 && runs[4].m_NumTiles == 3);
+
+    // Cleared, the batch builds nothing
+    batch.Clear();
+    CHECK(batch.GetNumTiles() == 0);
+    CHECK(batch.Build().empty());
+}
+
+TEST_CASE(TileMappingBatch, MatchesMappingTilesOneByOne)
+{
+    constexpr uint32_t kNumTextures = 6;
+    constexpr uint32_t kNumHeaps    = 3;
+    constexpr uint32_t kNumFrames   = 200;
+    const uint32_t numTiles = GetNumTiles();
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> textureDist(0, kNumTextures - 1);
+    std::uniform_int_distribution<uint32_t> tileDist(0, numTiles - 1);
+    std::uniform_int_distribution<uint32_t> heapDist(0, kNumHeaps - 1);
+    std::uniform_int_distribution<uint32_t> slotDist(0, 255);
+    std::uniform_int_distribution<uint32_t> runLengthDist(1, 12);
+    std::uniform_int_distribution<uint32_t> kindDist(0, 3);
+
+    TileMappingBatch batch;
+    MockDevice device;
+    TileMappings expected;
+    uint32_t numTilesAdded = 0;
+
+    for (uint32_t frame = 0; frame < kNumFrames; ++frame)
+    {
+        // A frame either maps or unmaps a tile, as BeginFrame Step 6 and
+        // UpdateTileMappings never touch the same tile in one batch
+        std::map<std::pair<uint32_t, uint32_t>, bool> touched;
+        batch.Clear();
+
+        for (uint32_t span = 0; span < 20; ++span)
+        {
+            // Mostly runs of neighbouring tiles in neighbouring slots, as the
+            // scheduler and the heap allocator tend to produce
+            const uint32_t textureIdx = textureDist(rng);
+            const uint32_t firstTile = tileDist(rng);
+            const uint32_t length = runLengthDist(rng);
+            const uint32_t kind = kindDist(rng);
+            const uint32_t heapId = heapDist(rng);
+            uint32_t heapTileIndex = slotDist(rng);
+
+            for (uint32_t tileIndex = firstTile; tileIndex < firstTile + length && tileIndex < numTiles; ++tileIndex)
+            {
+                const bool bUnmap = kind == 0;
+                const auto key = std::make_pair(textureIdx, tileIndex);
+                const auto [it, bInserted] = touched.emplace(key, bUnmap);
+                if (!bInserted && it->second != bUnmap)
+                    continue;
+                if (!bInserted && !bUnmap)
+                    continue; // mapped to one slot per frame; the duplicate below covers re-adds
+
+                if (bUnmap)
+                {
+                    batch.AddUnmap(textureIdx, tileIndex, GetMipLevel(tileIndex));
+                    expected.erase(key);
+                }
+                else
+                {
+                    batch.Add(textureIdx, tileIndex, GetMipLevel(tileIndex), heapId, heapTileIndex);
+                    expected[key] = { heapId, heapTileIndex };
+                    if (kind == 1)
+                        batch.Add(textureIdx, tileIndex, GetMipLevel(tileIndex), heapId, heapTileIndex);
+                }
+                numTilesAdded++;
+
+                // Now and then the next slot is taken by something else
+                heapTileIndex += kind == 2 ? 2 : 1;
+            }
+        }
+
+        device.Apply(batch.Build());
+        CHECK(device.m_Mappings == expected);
+    }
+
+    std::printf("  %u tiles in %u regions\n", numTilesAdded, device.m_NumRegions);
+    CHECK(!device.m_bRegionLeftItsMip);
+    CHECK(device.m_NumRegions < numTilesAdded / 2);
+}
@@ -0,0 +1,269 @@
+#include "TestFramework.h"
+
+#include "Streaming/TilePrefetcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <numbers>
+#include <span>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    constexpr float kPi = std::numbers::pi_v<float>;
+
+    // 4096^2 with 64 KB tiles of 256x256 texels (1 byte per texel, as BC7):
+    // standard mips 4096..256, the rest packed
+    PrefetchTexture MakeTexture()
+    {
+        PrefetchTexture texture;
+        texture.m_Width              = 4096;
+        texture.m_Height             = 4096;
+        texture.m_NumStandardMips    = 5;
+        texture.m_TileWidthInTexels  = 256;
+        texture.m_TileHeightInTexels = 256;
+        return texture;
+    }
+
+    // Adds an instance with a material and a texture of its own, so every
+    // prediction is per instance
+    void AddInstance(PrefetchScene& scene, PrefetchVector3 center, float radius, float uvDensity)
+    {
+        PrefetchMaterial material;
+        material.m_UVDensity = uvDensity;
+        material.m_Textures.push_back((uint32_t)scene.m_Textures.size());
+        scene.m_Textures.push_back(MakeTexture());
+
+        PrefetchInstance instance;
+        instance.m_Center        = center;
+        instance.m_Radius        = radius;
+        instance.m_MaterialIndex = (uint32_t)scene.m_Materials.size();
+        scene.m_Materials.push_back(material);
+        scene.m_Instances.push_back(instance);
+    }
+
+    // A corridor along +Z lined with props every 5 m, and at its end a cross
+    // corridor along +X.  One UV unit per 2 m: 2048 texels per meter, so mip 0
+    // is needed within ~1 m and the standard mips end ~20 m away.
+    PrefetchScene MakeCorridorScene()
+    {
+        constexpr float kUVDensity = 0.5f;
+
+        PrefetchScene scene;
+        for (float z = 5.0f; z <= 40.0f; z += 5.0f)
+        {
+            AddInstance(scene, { -4.0f, 1.0f, z }, 1.5f, kUVDensity);
+            AddInstance(scene, { 4.0f, 1.0f, z }, 1.5f, kUVDensity);
+        }
+        for (float x = 10.0f; x <= 60.0f; x += 5.0f)
+        {
+            AddInstance(scene, { x, 1.0f, 36.0f }, 1.5f, kUVDensity);
+            AddInstance(scene, { x, 1.0f, 44.0f }, 1.5f, kUVDensity);
+        }
+        return scene;
+    }
+
+    // A recorded walk at 60 Hz: down the corridor at 6 m/s, a 90 degree turn
+    // into the cross corridor over a second, then along it
+    std::vector<CameraPose> MakeCorridorWalk()
+    {
+        constexpr double kDt    = 1.0 / 60.0;
+        constexpr float  kSpeed = 6.0f;
+
+        std::vector<CameraPose> path;
+        CameraPose pose;
+        pose.m_Position = { 0.0f, 1.7f, 0.0f };
+        for (uint32_t i = 0; i < 8 * 60; ++i)
+        {
+            pose.m_Time = i * kDt;
+
+            const float turn = std::clamp((float)(pose.m_Time - 6.0), 0.0f, 1.0f);
+            pose.m_Yaw = turn * turn * (3.0f - 2.0f * turn) * kPi / 2.0f;
+            path.push_back(pose);
+
+            pose.m_Position.x += std::sin(pose.m_Yaw) * kSpeed * (float)kDt;
+            pose.m_Position.z += std::cos(pose.m_Yaw) * kSpeed * (float)kDt;
+        }
+        return path;
+    }
+} // namespace
+
+TEST_CASE(TilePrefetcher, ExtrapolatesTheCameraMotion)
+{
+    TilePrefetcher prefetcher;
+    CameraPose pose;
+    CHECK(!prefetcher.Extrapolate(0.5f, pose));
+
+    // 2 m/s along +X, turning at 0.5 rad/s
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        CameraPose sample;
+        sample.m_Time       = i * 0.02;
+        sample.m_Position.x = (float)sample.m_Time * 2.0f;
+        sample.m_Yaw        = (float)sample.m_Time * 0.5f;
+        prefetcher.AddCameraSample(sample);
+    }
+    CHECK(prefetcher.HasVelocity());
+    REQUIRE(prefetcher.Extrapolate(0.5f, pose));
+    CHECK(std::abs(pose.m_Position.x - (0.18f + 0.5f) * 2.0f) < 1e-3f);
+    CHECK(std::abs(pose.m_Yaw - (0.18f + 0.5f) * 0.5f) < 1e-3f);
+    CHECK(std::abs(pose.m_Time - 0.68) < 1e-6);
+
+    // A hitch restarts the estimate: no prediction from a single sample
+    CameraPose late;
+    late.m_Time = 1.0;
+    prefetcher.AddCameraSample(late);
+    CHECK(!prefetcher.HasVelocity());
+
+    std::vector<uint8_t> mips;
+    prefetcher.Predict(MakeCorridorScene(), PrefetchView{}, mips);
+    CHECK(std::count(mips.begin(), mips.end(), kPrefetchMipNone) == (std::ptrdiff_t)mips.size());
+}
+
+TEST_CASE(TilePrefetcher, NeededMipFollowsDistanceAndView)
+{
+    PrefetchScene scene;
+    AddInstance(scene, { 0.0f, 0.0f, 10.0f }, 0.5f, 0.5f);
+    const PrefetchView view;
+
+    // 2048 texels per meter against 1303 pixels per meter at 1 m (1080p, 45 degrees):
+    // log2(2048 / 1303 * 9.5 m) = 3.9
+    std::vector<uint8_t> mips;
+    CameraPose pose;
+    AccumulateNeededMips(scene, view, pose, mips);
+    REQUIRE(mips.size() == 1);
+    CHECK(mips[0] == 3);
+
+    // Min-combined over poses: closer needs finer
+    pose.m_Position.z = 8.5f;
+    AccumulateNeededMips(scene, view, pose, mips);
+    CHECK(mips[0] == 0);
+
+    // Behind the camera, beside the view cone, and past the last standard mip
+    for (float yaw : { kPi, kPi / 2.0f })
+    {
+        mips.clear();
+        pose.m_Position.z = 0.0f;
+        pose.m_Yaw = yaw;
+        AccumulateNeededMips(scene, view, pose, mips);
+        CHECK(mips[0] == kPrefetchMipNone);
+    }
+    mips.clear();
+    pose = CameraPose{};
+    pose.m_Position.z = -40.0f;
+    AccumulateNeededMips(scene, view, pose, mips);
+    CHECK(mips[0] == kPrefetchMipNone);
+
+    // Without a measured density the bounding diameter (1 m) spans the UV range:
+    // twice the texels per meter, one mip coarser than the first pose
+    scene.m_Materials[0].m_UVDensity = 0.0f;
+    mips.clear();
+    pose = CameraPose{};
+    AccumulateNeededMips(scene, view, pose, mips);
+    CHECK(mips[0] == 4);
+}
+
+TEST_CASE(TilePrefetcher, TexelDensityAndWorldScale)
+{
+    // A 2 m x 2 m quad mapped to the whole [0, 1] UV range: 0.5 UV units per meter
+    TexelDensityEstimator estimator;
+    CHECK(estimator.GetUVDensity() == 0.0f);
+    estimator.AddTriangle({ { 0, 0, 0 }, { 2, 0, 0 }, { 2, 2, 0 } }, { { 0, 0 }, { 1, 0 }, { 1, 1 } });
+    estimator.AddTriangle({ { 0, 0, 0 }, { 2, 2, 0 }, { 0, 2, 0 } }, { { 0, 0 }, { 1, 1 }, { 0, 1 } });
+    CHECK(std::abs(estimator.GetUVDensity() - 0.5f) < 1e-6f);
+
+    // Area weighted: a 1 m x 1 m quad tiling the range 4 times adds 1 UV area per 1 m^2
+    estimator.AddTriangle({ { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 } }, { { 0, 0 }, { 2, 0 }, { 2, 2 } });
+    estimator.AddTriangle({ { 0, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } }, { { 0, 0 }, { 2, 2 }, { 0, 2 } });
+    CHECK(std::abs(estimator.GetUVDensity() - std::sqrt(5.0f / 5.0f)) < 1e-6f);
+
+    const float world[4][4] = {
+        { 0.0f, 3.0f, 0.0f, 0.0f },
+        { -1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 2.0f, 0.0f },
+        { 10.0f, 20.0f, 30.0f, 1.0f },
+    };
+    CHECK(std::abs(GetPrefetchWorldScale(world) - 3.0f) < 1e-6f);
+}
+
+TEST_CASE(TilePrefetcher, ReplaysARecordedWalkWithinThresholds)
+{
+    // Measured on this path: the straight part is predicted fully (0.4% of the
+    // predicted bytes wasted); over the whole path 70% hit and 8% wasted, the
+    // misses are the turn, which starts and ends faster than the smoothed velocity
+    // follows.  The thresholds leave room for float differences, not for a worse
+    // predictor.
+    constexpr double kMinStraightHitRate   = 0.98;
+    constexpr double kMaxStraightWasteRate = 0.05;
+    constexpr double kMinHitRate           = 0.65;
+    constexpr double kMaxWasteRate         = 0.15;
+
+    const PrefetchScene scene = MakeCorridorScene();
+    const PrefetchView view;
+
+    // Recorded the way --record-camera-path writes it, and replayed from the file
+    const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "HobbyRendererTests_TilePrefetcher.path";
+    const std::vector<CameraPose> recorded = MakeCorridorWalk();
+    REQUIRE(SaveCameraPath(filePath, recorded));
+    std::vector<CameraPose> path;
+    const bool bLoaded = LoadCameraPath(filePath, path);
+    std::error_code ec;
+    std::filesystem::remove(filePath, ec);
+    REQUIRE(bLoaded);
+    REQUIRE(path.size() == recorded.size());
+
+    // Up to the turn (the horizon of the last sample scored ends before it)
+    const PrefetchReplayStats straight = ReplayCameraPath(scene, view, std::span(path).first(5 * 60));
+    const PrefetchReplayStats stats = ReplayCameraPath(scene, view, path);
+    std::printf("  straight: hit rate %.1f%%, wasted %.1f%%\n", straight.GetHitRate() * 100.0, straight.GetWasteRate() * 100.0);
+    std::printf("  %u samples: hit rate %.1f%% (%.2f of %.2f MB needed), wasted %.2f MB (%.1f%% of %.2f MB predicted)\n",
+                stats.m_NumSamples, stats.GetHitRate() * 100.0, stats.m_HitBytes / 1048576.0, stats.m_NeededBytes / 1048576.0,
+                stats.m_WastedBytes / 1048576.0, stats.GetWasteRate() * 100.0, stats.m_PredictedBytes / 1048576.0);
+
+    // Every sample but the last has a horizon to score against
+    CHECK(stats.m_NumSamples + 1 == path.size());
+    CHECK(stats.m_NeededBytes > 0);
+    CHECK(stats.m_HitBytes + stats.m_WastedBytes == stats.m_PredictedBytes);
+    CHECK(straight.GetHitRate() >= kMinStraightHitRate);
+    CHECK(straight.GetWasteRate() <= kMaxStraightWasteRate);
+    CHECK(stats.GetHitRate() >= kMinHitRate);
+    CHECK(stats.GetWasteRate() <= kMaxWasteRate);
+
+    // A camera standing still needs nothing it does not already see, and nothing is predicted
+    std::vector<CameraPose> still(120, path.front());
+    for (size_t i = 0; i < still.size(); ++i)
+        still[i].m_Time = i / 60.0;
+    const PrefetchReplayStats stillStats = ReplayCameraPath(scene, view, still);
+    CHECK(stillStats.m_NeededBytes == 0);
+    CHECK(stillStats.m_PredictedBytes == 0);
+}
+
+TEST_CASE(TilePrefetcher, ReplaysAPanWithinThresholds)
+{
+    // Measured: 99.5% hit rate, 0.5% wasted
+    constexpr double kMinHitRate   = 0.95;
+    constexpr double kMaxWasteRate = 0.05;
+
+    // Standing in the corridor, turning around at 1.5 rad/s: only the yaw
+    // extrapolation brings the props about to rotate into view
+    std::vector<CameraPose> path;
+    for (uint32_t i = 0; i < 4 * 60; ++i)
+    {
+        CameraPose pose;
+        pose.m_Time     = i / 60.0;
+        pose.m_Position = { 0.0f, 1.7f, 20.0f };
+        pose.m_Yaw      = std::remainder(1.5f * (float)pose.m_Time, 2.0f * kPi);
+        path.push_back(pose);
+    }
+
+    const PrefetchReplayStats stats = ReplayCameraPath(MakeCorridorScene(), PrefetchView{}, path);
+    std::printf("  %u samples: hit rate %.1f%% (%.2f of %.2f MB needed), wasted %.1f%%\n",
+                stats.m_NumSamples, stats.GetHitRate() * 100.0, stats.m_HitBytes / 1048576.0, stats.m_NeededBytes / 1048576.0,
+                stats.GetWasteRate() * 100.0);
+    CHECK(stats.m_NeededBytes > 0);
+    CHECK(stats.GetHitRate() >= kMinHitRate);
+    CHECK(stats.GetWasteRate() <= kMaxWasteRate);
+}
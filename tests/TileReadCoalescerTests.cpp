@@ -0,0 +1,219 @@
+#include "TestFramework.h"
+
+#include "MemoryMappedDataReader.h"
+#include "Streaming/TileReadCoalescer.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    // BC7: 16-byte blocks, 256x256 texel (64 KB) tiles
+    constexpr uint32_t kBytesPerBlock = 16;
+    constexpr uint32_t kTileTexels    = 256;
+
+    // Coalescing only compares the source pointers; owned-data mode needs no file.
+    // The no-op deleter keeps the destructor from unmapping the bytes.
+    struct Sources
+    {
+        uint8_t                m_Bytes[16] = {};
+        MemoryMappedDataReader m_A{ m_Bytes, 8, [](void*) {} };
+        MemoryMappedDataReader m_B{ m_Bytes + 8, 8, [](void*) {} };
+    };
+
+    // Every span in exactly one read, inside it, and reads of one source in order
+    // without overlap
+    bool ReadsCoverSpans(const std::vector<TileReadSpan>& spans, const std::vector<TileRead>& reads)
+    {
+        uint32_t nextSpan = 0;
+        for (size_t i = 0; i < reads.size(); ++i)
+        {
+            const TileRead& read = reads[i];
+            if (read.m_FirstSpan != nextSpan || read.m_EndSpan <= read.m_FirstSpan)
+                return false;
+            nextSpan = read.m_EndSpan;
+
+            for (uint32_t s = read.m_FirstSpan; s < read.m_EndSpan; ++s)
+            {
+                if (spans[s].m_Source != read.m_Source || spans[s].m_SrcOffset < read.m_Offset ||
+                    spans[s].m_SrcOffset + spans[s].m_Size > read.m_Offset + read.m_Size)
+                {
+                    return false;
+                }
+            }
+
+            if (i > 0 && reads[i - 1].m_Source == read.m_Source && reads[i - 1].m_Offset + reads[i - 1].m_Size > read.m_Offset)
+                return false;
+        }
+        return nextSpan == spans.size();
+    }
+} // namespace
+
+TEST_CASE(TileReadCoalescer, LinearLayoutAddressesTheTileRows)
+{
+    // Tile (1, 2) of a 1024x1024 mip starting at byte 4096: 64 block rows of 64 blocks
+    const TileRowLayout layout = GetLinearTileRowLayout(4096, 1024, 256, 512, kTileTexels, kTileTexels, 4, kBytesPerBlock);
+    CHECK(layout.m_RowPitch == 256 * kBytesPerBlock);
+    CHECK(layout.m_RowBytes == 64 * kBytesPerBlock && layout.m_NumRows == 64);
+    CHECK(layout.m_FirstRowOffset == 4096 + 128 * layout.m_RowPitch + 64 * kBytesPerBlock);
+    CHECK(layout.m_StoredSize == 64 * 1024 && !layout.IsCompressed());
+
+    // A clipped edge tile of a 1000-texel mip: whole blocks, rounded up
+    const TileRowLayout edge = GetLinearTileRowLayout(0, 1000, 768, 0, 1000 - 768, 10, 4, kBytesPerBlock);
+    CHECK(edge.m_RowPitch == 250 * kBytesPerBlock);
+    CHECK(edge.m_RowBytes == 58 * kBytesPerBlock && edge.m_NumRows == 3);
+    CHECK(edge.m_FirstRowOffset == 192 * kBytesPerBlock);
+}
+
+TEST_CASE(TileReadCoalescer, SpansFollowTheRowsOrTheStoredTile)
+{
+    Sources sources;
+    const TileRowLayout layout = GetLinearTileRowLayout(0, 1024, 256, 0, kTileTexels, kTileTexels, 4, kBytesPerBlock);
+
+    // Padded destination rows; packed offsets stay rowBytes apart
+    std::vector<TileReadSpan> spans;
+    AppendTileReadSpans(&sources.m_A, layout, 2048, 7, spans);
+    REQUIRE(spans.size() == layout.m_NumRows);
+    CHECK(spans[3].m_SrcOffset == layout.m_FirstRowOffset + 3 * layout.m_RowPitch);
+    CHECK(spans[3].m_Size == layout.m_RowBytes);
+    CHECK(spans[3].m_DstOffset == 3 * 2048 && spans[3].m_PackedOffset == 3 * layout.m_RowBytes);
+    CHECK(spans[3].m_BatchIndex == 7 && !spans[3].m_bCompressed);
+
+    // A compressed .tdds tile is one span of its stored bytes
+    TileRowLayout stored;
+    stored.m_FirstRowOffset = 65536;
+    stored.m_RowBytes       = layout.m_RowBytes;
+    stored.m_RowPitch       = layout.m_RowBytes;
+    stored.m_NumRows        = layout.m_NumRows;
+    stored.m_StoredSize     = 12345;
+    spans.clear();
+    AppendTileReadSpans(&sources.m_B, stored, 2048, 2, spans);
+    REQUIRE(spans.size() == 1);
+    CHECK(spans[0].m_bCompressed && spans[0].m_Size == 12345 && spans[0].m_SrcOffset == 65536);
+}
+
+TEST_CASE(TileReadCoalescer, MergesNeighbouringTilesWithinTheLimits)
+{
+    Sources sources;
+
+    // Tiles (0, 0) and (1, 0) of a 1024-wide mip: each block row of the pair is
+    // 2 KB of contiguous bytes, 2 KB before the next
+    auto appendPair = [&](std::vector<TileReadSpan>& spans)
+    {
+        spans.clear();
+        for (uint32_t x = 0; x < 2; ++x)
+            AppendTileReadSpans(&sources.m_A, GetLinearTileRowLayout(0, 1024, x * kTileTexels, 0, kTileTexels, kTileTexels, 4, kBytesPerBlock), 1024, x, spans);
+    };
+
+    std::vector<TileReadSpan> spans;
+    std::vector<TileRead> reads;
+
+    // Gaps read through: one read from the first row to the end of the last
+    appendPair(spans);
+    CoalesceTileReads(spans, kTileReadMaxGapBytes, kTileReadMaxBytes, reads);
+    REQUIRE(reads.size() == 1);
+    CHECK(reads[0].m_Offset == 0 && reads[0].m_Size == 63 * 4096 + 2048);
+    CHECK(ReadsCoverSpans(spans, reads));
+
+    // Gaps too wide: the two rows of each block row still merge
+    appendPair(spans);
+    CoalesceTileReads(spans, 1024, kTileReadMaxBytes, reads);
+    CHECK(reads.size() == 64);
+    CHECK(reads[5].m_Offset == 5 * 4096 && reads[5].m_Size == 2048);
+    CHECK(ReadsCoverSpans(spans, reads));
+
+    // Read size capped: 16 KB holds four block rows and the gaps between them
+    appendPair(spans);
+    CoalesceTileReads(spans, kTileReadMaxGapBytes, 16 * 1024, reads);
+    CHECK(reads.size() == 16);
+    CHECK(reads[1].m_Offset == 4 * 4096 && reads[1].m_Size == 3 * 4096 + 2048);
+    CHECK(ReadsCoverSpans(spans, reads));
+
+    // Another source never joins the read, however close
+    appendPair(spans);
+    for (TileReadSpan& span : spans)
+    {
+        if (span.m_BatchIndex == 1)
+            span.m_Source = &sources.m_B;
+    }
+    CoalesceTileReads(spans, kTileReadMaxGapBytes, kTileReadMaxBytes, reads);
+    REQUIRE(reads.size() == 2);
+    CHECK(reads[0].m_Source != reads[1].m_Source);
+    CHECK(ReadsCoverSpans(spans, reads));
+
+    // A span inside the previous one does not pull the read's end back
+    spans.clear();
+    spans.push_back({ &sources.m_A, 0, 1000, 0 });
+    spans.push_back({ &sources.m_A, 100, 100, 1 });
+    spans.push_back({ &sources.m_A, 1500, 100, 2 });
+    CoalesceTileReads(spans, 1024, kTileReadMaxBytes, reads);
+    REQUIRE(reads.size() == 1);
+    CHECK(reads[0].m_Size == 1600);
+
+    // A span over the read size limit is read on its own
+    spans.clear();
+    spans.push_back({ &sources.m_A, 0, 100, 0 });
+    spans.push_back({ &sources.m_A, 200, 64 * 1024, 1 });
+    spans.push_back({ &sources.m_A, 200 + 64 * 1024, 100, 2 });
+    CoalesceTileReads(spans, kTileReadMaxGapBytes, 16 * 1024, reads);
+    REQUIRE(reads.size() == 3);
+    CHECK(reads[1].m_Offset == 200 && reads[1].m_Size == 64 * 1024);
+    CHECK(ReadsCoverSpans(spans, reads));
+}
+
+TEST_CASE(TileReadCoalescer, RandomBatchesAreCoveredByMaximalReads)
+{
+    Sources sources;
+    std::mt19937 rng(17);
+    std::vector<TileReadSpan> spans;
+    std::vector<TileRead> reads;
+    uint32_t numBadCover = 0;
+    uint32_t numOversized = 0;
+    uint32_t numMergeable = 0;
+    uint64_t numSpans = 0;
+
+    for (uint32_t batch = 0; batch < 200; ++batch)
+    {
+        // Random tiles of two sources, some overlapping, as a batch of rows
+        spans.clear();
+        const uint32_t numTiles = 1 + rng() % 32;
+        for (uint32_t i = 0; i < numTiles; ++i)
+        {
+            const MemoryMappedDataReader* source = (rng() % 2) ? &sources.m_A : &sources.m_B;
+            const uint32_t x = (rng() % 16) * kTileTexels;
+            const uint32_t y = (rng() % 16) * kTileTexels;
+            AppendTileReadSpans(source, GetLinearTileRowLayout(0, 4096, x, y, kTileTexels, kTileTexels, 4, kBytesPerBlock), 1024, i, spans);
+        }
+        numSpans += spans.size();
+
+        const size_t maxGap  = (rng() % 4) * 2048;
+        const size_t maxRead = (size_t)(1 + rng() % 64) * 4096;
+        CoalesceTileReads(spans, maxGap, maxRead, reads);
+
+        if (!ReadsCoverSpans(spans, reads))
+            numBadCover++;
+
+        for (size_t i = 0; i < reads.size(); ++i)
+        {
+            if (reads[i].m_Size > maxRead && reads[i].m_EndSpan - reads[i].m_FirstSpan > 1)
+                numOversized++;
+
+            // The next read starts a new one only when it had to
+            if (i + 1 < reads.size() && reads[i + 1].m_Source == reads[i].m_Source)
+            {
+                const TileReadSpan& next = spans[reads[i + 1].m_FirstSpan];
+                const size_t mergedEnd = std::max(reads[i].m_Offset + reads[i].m_Size, next.m_SrcOffset + next.m_Size);
+                if (next.m_SrcOffset <= reads[i].m_Offset + reads[i].m_Size + maxGap && mergedEnd - reads[i].m_Offset <= maxRead)
+                    numMergeable++;
+            }
+        }
+    }
+
+    std::printf("  %llu spans\n", (unsigned long long)numSpans);
+    CHECK(numBadCover == 0);
+    CHECK(numOversized == 0);
+    CHECK(numMergeable == 0);
+}
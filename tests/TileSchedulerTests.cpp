@@ -0,0 +1,177 @@
+#include "TestFramework.h"
+
+#include "Streaming/TileScheduler.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    constexpr uint32_t kNumTextures = 8;
+    constexpr uint32_t kNumTiles    = 256;
+
+    // Coverage per (texture, tile), changed only together with MarkTextureChanged.
+    // Age is left out so a full re-score every batch gives exactly the same order.
+    struct MockFeedback
+    {
+        std::vector<std::vector<float>> m_Coverage;
+        uint32_t m_NumCalls = 0;
+
+        TilePriorityInputs operator()(const ScheduledTile& tile)
+        {
+            m_NumCalls++;
+            TilePriorityInputs inputs;
+            inputs.m_Coverage = m_Coverage[tile.m_TextureIdx][tile.m_TileIndex];
+            return inputs;
+        }
+    };
+} // namespace
+
+TEST_CASE(TileScheduler, MatchesAFullRescoreEveryBatch)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<uint32_t> textureDist(0, kNumTextures - 1);
+    std::uniform_int_distribution<uint32_t> tileDist(0, kNumTiles - 1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    MockFeedback feedback;
+    feedback.m_Coverage.assign(kNumTextures, std::vector<float>(kNumTiles));
+    for (std::vector<float>& coverage : feedback.m_Coverage)
+        for (float& c : coverage)
+            c = unit(rng);
+
+    TileScheduler scheduler;
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> reference; // pending tile -> request frame
+    std::pmr::vector<ScheduledTile> popped;
+    uint32_t numPopped = 0;
+    uint32_t numMismatches = 0;
+
+    for (uint32_t frame = 1; frame <= 300; ++frame)
+    {
+        // Requests and cancellations
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            const uint32_t textureIdx = textureDist(rng);
+            std::vector<uint32_t> tiles;
+            const uint32_t firstTile = tileDist(rng);
+            for (uint32_t tileIndex = firstTile; tileIndex < std::min(firstTile + 16, kNumTiles); ++tileIndex)
+                tiles.push_back(tileIndex);
+
+            if (unit(rng) < 0.2f)
+            {
+                scheduler.Cancel(textureIdx, tiles);
+                for (uint32_t tileIndex : tiles)
+                    reference.erase({ textureIdx, tileIndex });
+            }
+            else
+            {
+                scheduler.Enqueue(textureIdx, tiles, frame);
+                for (uint32_t tileIndex : tiles)
+                    reference.emplace(std::make_pair(textureIdx, tileIndex), frame);
+            }
+        }
+
+        // New feedback for a couple of textures
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            const uint32_t textureIdx = textureDist(rng);
+            for (float& c : feedback.m_Coverage[textureIdx])
+                c = unit(rng);
+            scheduler.MarkTextureChanged(textureIdx);
+        }
+
+        // Reference: every pending tile, re-scored and sorted
+        std::vector<std::pair<float, std::pair<uint32_t, uint32_t>>> ranked;
+        for (const auto& [key, requestFrame] : reference)
+            ranked.push_back({ TileScheduler::ComputePriority({ feedback.m_Coverage[key.first][key.second] }), key });
+        std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        const uint32_t maxTiles = 24;
+        scheduler.PopBatch(maxTiles, feedback, popped);
+        REQUIRE(popped.size() == std::min<size_t>(maxTiles, ranked.size()));
+        for (size_t i = 0; i < popped.size(); ++i)
+        {
+            if (popped[i].m_TextureIdx != ranked[i].second.first || popped[i].m_TileIndex != ranked[i].second.second)
+                numMismatches++;
+            reference.erase({ popped[i].m_TextureIdx, popped[i].m_TileIndex });
+        }
+        numPopped += (uint32_t)popped.size();
+        CHECK(scheduler.GetNumPending() == reference.size());
+    }
+
+    std::printf("  %u tiles popped, %u scored, %u out of order\n", numPopped, feedback.m_NumCalls, numMismatches);
+    CHECK(numMismatches == 0);
+    CHECK(feedback.m_NumCalls == scheduler.GetNumScored());
+}
+
+TEST_CASE(TileScheduler, OnlyRescoresChangedTextures)
+{
+    MockFeedback feedback;
+    feedback.m_Coverage.assign(kNumTextures, std::vector<float>(kNumTiles, 0.5f));
+
+    TileScheduler scheduler;
+    std::vector<uint32_t> tiles(kNumTiles);
+    for (uint32_t tileIndex = 0; tileIndex < kNumTiles; ++tileIndex)
+        tiles[tileIndex] = tileIndex;
+    for (uint32_t textureIdx = 0; textureIdx < kNumTextures; ++textureIdx)
+        scheduler.Enqueue(textureIdx, tiles, 0);
+
+    // First batch scores every tile once
+    std::pmr::vector<ScheduledTile> popped;
+    scheduler.PopBatch(1, feedback, popped);
+    CHECK(feedback.m_NumCalls == kNumTextures * kNumTiles);
+
+    // Nothing changed: nothing re-scored
+    feedback.m_NumCalls = 0;
+    scheduler.PopBatch(1, feedback, popped);
+    CHECK(feedback.m_NumCalls == 0);
+
+    // Texture 3 is now fully covered: only its tiles are re-scored, and they go first
+    std::fill(feedback.m_Coverage[3].begin(), feedback.m_Coverage[3].end(), 1.0f);
+    scheduler.MarkTextureChanged(3);
+    scheduler.PopBatch(4, feedback, popped);
+    CHECK(feedback.m_NumCalls == kNumTiles);
+    REQUIRE(popped.size() == 4);
+    for (const ScheduledTile& tile : popped)
+        CHECK(tile.m_TextureIdx == 3);
+
+    // The age term is refreshed by a periodic full re-score
+    feedback.m_NumCalls = 0;
+    for (uint32_t batch = 0; batch < TileScheduler::kFullRescoreInterval; ++batch)
+        scheduler.PopBatch(0, feedback, popped);
+    CHECK(feedback.m_NumCalls == scheduler.GetNumPending());
+}
+
+TEST_CASE(TileScheduler, RemoveTextureShiftsLaterTextures)
+{
+    MockFeedback feedback;
+    feedback.m_Coverage.assign(kNumTextures, std::vector<float>(kNumTiles, 0.0f));
+    feedback.m_Coverage[1][7] = 1.0f;
+
+    TileScheduler scheduler;
+    scheduler.Enqueue(0, { 1, 2 }, 0);
+    scheduler.Enqueue(1, { 3 }, 0);
+    scheduler.Enqueue(2, { 7 }, 0);
+
+    std::pmr::vector<ScheduledTile> popped;
+    scheduler.PopBatch(0, feedback, popped);
+
+    // Texture 2 becomes texture 1
+    scheduler.RemoveTexture(1);
+    CHECK(scheduler.GetNumPending() == 3);
+    CHECK(scheduler.GetNumCancelled() == 1);
+
+    scheduler.PopBatch(1, feedback, popped);
+    REQUIRE(popped.size() == 1);
+    CHECK(popped[0].m_TextureIdx == 1 && popped[0].m_TileIndex == 7);
+
+    scheduler.Cancel(1, { 7 });
+    scheduler.PopBatch(8, feedback, popped);
+    CHECK(popped.size() == 2);
+    CHECK(scheduler.IsEmpty());
+}
@@ -0,0 +1,127 @@
+#include "TestFramework.h"
+
+#include "Streaming/TileStagingRing.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    constexpr uint64_t kTileBytes = 64 * 1024;
+}
+
+TEST_CASE(TileStagingRing, AlignsAndNeverStraddlesTheEnd)
+{
+    TileStagingRing ring(4 * kTileBytes);
+    CHECK(ring.GetCapacity() == 4 * kTileBytes);
+
+    // 1000 bytes round the next offset up to the placement alignment
+    TileStagingRing::Allocation small;
+    REQUIRE(ring.Reserve(1000, small));
+    CHECK(small.m_Offset == 0);
+
+    TileStagingRing::Allocation tiles[2];
+    for (TileStagingRing::Allocation& tile : tiles)
+    {
+        REQUIRE(ring.Reserve(kTileBytes, tile));
+        CHECK(tile.m_Offset % TileStagingRing::kPlacementAlignment == 0);
+    }
+    CHECK(tiles[0].m_Offset == 2 * TileStagingRing::kPlacementAlignment);
+
+    // Leaves less than a tile at the end of the buffer
+    TileStagingRing::Allocation last;
+    REQUIRE(ring.Reserve(kTileBytes, last));
+    CHECK(ring.GetCapacity() - (last.m_Offset + last.m_Size) < kTileBytes);
+    ring.MarkSubmitted(small, 1);
+    ring.MarkSubmitted(tiles[0], 1);
+    ring.Retire(1);
+
+    // The next tile wraps to offset 0 instead of straddling the end
+    TileStagingRing::Allocation wrapped;
+    REQUIRE(ring.Reserve(kTileBytes, wrapped));
+    CHECK(wrapped.m_Offset == 0);
+
+    // ... and the ring is full up to tiles[1], which is still live
+    TileStagingRing::Allocation upToLive;
+    REQUIRE(ring.Reserve(tiles[1].m_Offset - kTileBytes, upToLive));
+    CHECK(upToLive.m_Offset + upToLive.m_Size == tiles[1].m_Offset);
+
+    TileStagingRing::Allocation full;
+    CHECK(!ring.Reserve(TileStagingRing::kPlacementAlignment, full));
+    CHECK(ring.GetNumFailedReservations() == 1);
+}
+
+TEST_CASE(TileStagingRing, RetiresInOrderAfterTheGPUFrame)
+{
+    TileStagingRing ring(4 * kTileBytes);
+
+    TileStagingRing::Allocation a, b, c;
+    REQUIRE(ring.Reserve(kTileBytes, a));
+    REQUIRE(ring.Reserve(kTileBytes, b));
+    REQUIRE(ring.Reserve(kTileBytes, c));
+
+    // b and c are submitted, but a (still being written by a worker) holds them back
+    ring.MarkSubmitted(b, 10);
+    ring.MarkSubmitted(c, 11);
+    ring.Retire(11);
+    CHECK(ring.GetNumLiveAllocations() == 3);
+
+    ring.MarkSubmitted(a, 10);
+    ring.Retire(10);
+    CHECK(ring.GetNumLiveAllocations() == 1); // c's frame has not completed yet
+    CHECK(ring.GetUsedBytes() == kTileBytes);
+
+    ring.Retire(11);
+    CHECK(ring.GetNumLiveAllocations() == 0);
+    CHECK(ring.GetUsedBytes() == 0);
+
+    // An empty ring restarts at the beginning, so a full-capacity reservation fits
+    TileStagingRing::Allocation whole;
+    REQUIRE(ring.Reserve(ring.GetCapacity(), whole));
+    CHECK(whole.m_Offset == 0);
+}
+
+TEST_CASE(TileStagingRing, RejectsOversizedReservations)
+{
+    TileStagingRing ring(kTileBytes);
+    TileStagingRing::Allocation allocation;
+    CHECK(!ring.Reserve(kTileBytes + 1, allocation));
+    CHECK(!allocation.IsValid());
+    CHECK(ring.GetNumFailedReservations() == 1);
+}
+
+TEST_CASE(TileStagingRing, ConcurrentReservationsDoNotOverlap)
+{
+    constexpr uint32_t kNumThreads           = 4;
+    constexpr uint32_t kReservationsPerThread = 16;
+
+    TileStagingRing ring(kNumThreads * kReservationsPerThread * 8 * 1024);
+
+    std::vector<TileStagingRing::Allocation> allocations[kNumThreads];
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kNumThreads; ++t)
+    {
+        threads.emplace_back([&ring, &allocations, t]() {
+            for (uint32_t i = 0; i < kReservationsPerThread; ++i)
+            {
+                TileStagingRing::Allocation allocation;
+                if (ring.Reserve(4 * 1024 + i * 100, allocation))
+                    allocations[t].push_back(allocation);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::vector<TileStagingRing::Allocation> all;
+    for (const std::vector<TileStagingRing::Allocation>& perThread : allocations)
+        all.insert(all.end(), perThread.begin(), perThread.end());
+    CHECK(all.size() == kNumThreads * kReservationsPerThread);
+
+    std::sort(all.begin(), all.end(), [](const TileStagingRing::Allocation& x, const TileStagingRing::Allocation& y) { return x.m_Offset < y.m_Offset; });
+    for (size_t i = 1; i < all.size(); ++i)
+        CHECK(all[i - 1].m_Offset + all[i - 1].m_Size <= all[i].m_Offset);
+}
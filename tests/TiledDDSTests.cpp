@@ -0,0 +1,240 @@
+#include "TestFramework.h"
+
+#include "Streaming/TiledDDS.h"
+#include "TextureLoader.h"
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    // BC1: 8-byte 4x4 blocks, so a standard tile is 512x256 texels.  2100x1100 gives
+    // three standard mips with clipped edge tiles (5x5, 3x3 and 2x2 tiles) and nine
+    // packed ones.
+    constexpr uint32_t kWidth         = 2100;
+    constexpr uint32_t kHeight        = 1100;
+    constexpr uint32_t kBytesPerBlock = 8;
+
+    uint32_t GetNumMips(uint32_t width, uint32_t height)
+    {
+        uint32_t numMips = 1;
+        while ((std::max(width, height) >> numMips) > 0)
+            numMips++;
+        return numMips;
+    }
+
+    // Legacy 'DXT1' DDS.  Blocks in the left half of each mip are noise (stored raw even
+    // when compressing), the rest are one repeated byte (compress well).
+    std::vector<uint8_t> MakeDDS(uint32_t width, uint32_t height, uint32_t seed)
+    {
+        const uint32_t numMips = GetNumMips(width, height);
+
+        std::vector<uint8_t> dds(4 + 124);
+        uint32_t* header = reinterpret_cast<uint32_t*>(dds.data());
+        header[0]  = 0x20534444;          // 'DDS '
+        header[1]  = 124;                 // dwSize
+        header[2]  = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;
+        header[3]  = height;
+        header[4]  = width;
+        header[7]  = numMips;             // dwMipMapCount
+        header[19] = 32;                  // ddspf.dwSize
+        header[20] = 0x4;                 // DDPF_FOURCC
+        header[21] = 0x31545844;          // 'DXT1'
+        header[27] = 0x1000 | 0x400000 | 0x8;
+
+        std::mt19937 rng(seed);
+        for (uint32_t mip = 0; mip < numMips; ++mip)
+        {
+            const uint32_t blocksW = (std::max(width >> mip, 1u) + 3) / 4;
+            const uint32_t blocksH = (std::max(height >> mip, 1u) + 3) / 4;
+            for (uint32_t y = 0; y < blocksH; ++y)
+            {
+                for (uint32_t x = 0; x < blocksW; ++x)
+                {
+                    for (uint32_t i = 0; i < kBytesPerBlock; ++i)
+                        dds.push_back(x < blocksW / 2 ? (uint8_t)rng() : (uint8_t)(0x40 + mip));
+                }
+            }
+        }
+        return dds;
+    }
+
+    bool WriteFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes)
+    {
+        std::ofstream os(path, std::ios::binary | std::ios::trunc);
+        os.write(reinterpret_cast<const char*>(bytes.data()), (std::streamsize)bytes.size());
+        return (bool)os;
+    }
+
+    std::vector<uint8_t> ReadFile(const std::filesystem::path& path)
+    {
+        std::ifstream is(path, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+
+    struct TempFiles
+    {
+        std::filesystem::path m_DDS  = std::filesystem::temp_directory_path() / "HobbyRendererTests_TiledDDS.dds";
+        std::filesystem::path m_TDDS = std::filesystem::temp_directory_path() / "HobbyRendererTests_TiledDDS.tdds";
+
+        ~TempFiles()
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_DDS, ec);
+            std::filesystem::remove(m_TDDS, ec);
+        }
+    };
+
+    // Rewrites count bytes at offset of the .tdds and reports whether it still loads
+    bool LoadsAfterPatch(const TempFiles& files, const std::vector<uint8_t>& tdds, size_t offset, const void* bytes, size_t count)
+    {
+        std::vector<uint8_t> patched = tdds;
+        memcpy(patched.data() + offset, bytes, count);
+        WriteFile(files.m_TDDS, patched);
+
+        nvrhi::TextureDesc desc;
+        std::unique_ptr<MemoryMappedDataReader> data;
+        std::shared_ptr<const TiledDDSLayout> layout;
+        size_t mipOffsets[srrhi::CommonConsts::MAX_MIP_COUNT];
+        return LoadTiledDDS(files.m_TDDS.string(), desc, data, layout, mipOffsets);
+    }
+} // namespace
+
+TEST_CASE(TiledDDS, RoundTripsWithEveryCodec)
+{
+    TempFiles files;
+    const std::vector<uint8_t> source = MakeDDS(kWidth, kHeight, 1);
+    REQUIRE(WriteFile(files.m_DDS, source));
+    const uint8_t* sourcePixels = source.data() + 128;
+
+    for (TiledDDSCompression compression : { TiledDDSCompression::None, TiledDDSCompression::LZ4, TiledDDSCompression::Zstd })
+    {
+        REQUIRE(CookTiledDDS(files.m_DDS, files.m_TDDS, compression));
+        CHECK(VerifyTiledDDS(files.m_TDDS, files.m_DDS));
+
+        TiledDDSHeader header;
+        REQUIRE(ReadTiledDDSHeader(files.m_TDDS, header));
+        CHECK(header.m_NumStandardMips == 3 && header.m_NumTiles == 25 + 9 + 4);
+
+        nvrhi::TextureDesc desc;
+        std::unique_ptr<MemoryMappedDataReader> data;
+        std::shared_ptr<const TiledDDSLayout> layout;
+        size_t mipOffsets[srrhi::CommonConsts::MAX_MIP_COUNT];
+        REQUIRE(LoadTiledDDS(files.m_TDDS.string(), desc, data, layout, mipOffsets));
+        REQUIRE(desc.width == kWidth && desc.height == kHeight && desc.mipLevels == GetNumMips(kWidth, kHeight));
+
+        size_t linearOffsets[srrhi::CommonConsts::MAX_MIP_COUNT];
+        ComputeDDSMipOffsets(desc, linearOffsets);
+
+        // Every tile, found by texel position as AsyncTileIO does, holds the source's
+        // block rows once decoded
+        const uint8_t* file = static_cast<const uint8_t*>(data->GetData());
+        uint32_t numCompressed = 0;
+        uint32_t numMismatches = 0;
+        std::vector<uint8_t> decoded;
+        for (uint32_t mip = 0; mip < layout->m_NumStandardMips; ++mip)
+        {
+            const uint32_t mipWidth  = std::max(kWidth >> mip, 1u);
+            const uint32_t mipHeight = std::max(kHeight >> mip, 1u);
+            const uint32_t mipBlocksW = (mipWidth + 3) / 4;
+            for (uint32_t y = 0; y < mipHeight; y += layout->m_TileHeightInTexels)
+            {
+                for (uint32_t x = 0; x < mipWidth; x += layout->m_TileWidthInTexels)
+                {
+                    const TiledDDSTile* tile = layout->FindTile(mip, x, y);
+                    REQUIRE(tile);
+                    CHECK(tile->m_Offset % kTiledDDSTileAlignment == 0);
+
+                    const uint8_t* tileBytes = file + tile->m_Offset;
+                    if (tile->m_StoredSize < tile->m_Size)
+                    {
+                        numCompressed++;
+                        decoded.resize(tile->m_Size);
+                        CHECK(DecompressTiledDDSTile(layout->m_Compression, tileBytes, tile->m_StoredSize, decoded.data(), decoded.size()));
+                        tileBytes = decoded.data();
+                    }
+
+                    const uint32_t rowBytes = (std::min(x + layout->m_TileWidthInTexels, mipWidth) - x + 3) / 4 * kBytesPerBlock;
+                    const uint32_t numRows  = (std::min(y + layout->m_TileHeightInTexels, mipHeight) - y + 3) / 4;
+                    CHECK(tile->m_Size == rowBytes * numRows);
+                    for (uint32_t row = 0; row < numRows; ++row)
+                    {
+                        const uint8_t* expected = sourcePixels + linearOffsets[mip] + ((size_t)(y / 4 + row) * mipBlocksW + x / 4) * kBytesPerBlock;
+                        if (memcmp(tileBytes + (size_t)row * rowBytes, expected, rowBytes) != 0)
+                            numMismatches++;
+                    }
+                }
+            }
+        }
+        CHECK(numMismatches == 0);
+        CHECK(layout->FindTile(layout->m_NumStandardMips, 0, 0) == nullptr);
+        CHECK(layout->FindTile(0, kWidth + 512, 0) == nullptr);
+
+        // Packed mips are linear, straight from the source
+        const uint32_t firstPacked = layout->m_NumStandardMips;
+        CHECK(memcmp(file + mipOffsets[firstPacked], sourcePixels + linearOffsets[firstPacked], header.m_PackedMipSize) == 0);
+
+        std::printf("  %s: %u of %u tiles compressed, %.2f MB -> %.2f MB\n", GetTiledDDSCompressionName(compression),
+            numCompressed, header.m_NumTiles, BYTES_TO_MB(source.size()), BYTES_TO_MB(header.m_FileSize));
+        if (compression == TiledDDSCompression::None)
+            CHECK(numCompressed == 0);
+        else
+            CHECK(numCompressed > 0 && numCompressed < header.m_NumTiles);
+    }
+}
+
+TEST_CASE(TiledDDS, RejectsCorruptFiles)
+{
+    TempFiles files;
+    REQUIRE(WriteFile(files.m_DDS, MakeDDS(kWidth, kHeight, 2)));
+    REQUIRE(CookTiledDDS(files.m_DDS, files.m_TDDS, TiledDDSCompression::LZ4));
+    const std::vector<uint8_t> tdds = ReadFile(files.m_TDDS);
+    REQUIRE(tdds.size() > sizeof(TiledDDSHeader));
+
+    TiledDDSHeader header;
+    memcpy(&header, tdds.data(), sizeof(header));
+    const uint32_t oldVersion = kTiledDDSVersion - 1;
+    CHECK(!LoadsAfterPatch(files, tdds, offsetof(TiledDDSHeader, m_Version), &oldVersion, sizeof(oldVersion)));
+
+    const uint64_t wrongSize = header.m_FileSize + 1;
+    CHECK(!LoadsAfterPatch(files, tdds, offsetof(TiledDDSHeader, m_FileSize), &wrongSize, sizeof(wrongSize)));
+
+    // A tile table entry that overruns into the packed mips, or claims more than it decodes to
+    TiledDDSTile tile;
+    memcpy(&tile, tdds.data() + header.m_TileTableOffset, sizeof(tile));
+    TiledDDSTile badTile = tile;
+    badTile.m_Offset = header.m_PackedMipOffset;
+    CHECK(!LoadsAfterPatch(files, tdds, header.m_TileTableOffset, &badTile, sizeof(badTile)));
+    badTile = tile;
+    badTile.m_StoredSize = tile.m_Size + 1;
+    CHECK(!LoadsAfterPatch(files, tdds, header.m_TileTableOffset, &badTile, sizeof(badTile)));
+
+    // Truncated
+    {
+        WriteFile(files.m_TDDS, std::vector<uint8_t>(tdds.begin(), tdds.end() - 1));
+        nvrhi::TextureDesc desc;
+        std::unique_ptr<MemoryMappedDataReader> data;
+        std::shared_ptr<const TiledDDSLayout> layout;
+        size_t mipOffsets[srrhi::CommonConsts::MAX_MIP_COUNT];
+        CHECK(!LoadTiledDDS(files.m_TDDS.string(), desc, data, layout, mipOffsets));
+    }
+
+    // Damaged compressed data fails to decode rather than producing a short tile
+    std::vector<uint8_t> garbage(tile.m_Size, 0xFF);
+    std::vector<uint8_t> decoded(tile.m_Size);
+    CHECK(!DecompressTiledDDSTile(TiledDDSCompression::LZ4, garbage.data(), 64, decoded.data(), decoded.size()));
+    CHECK(!DecompressTiledDDSTile(TiledDDSCompression::Zstd, garbage.data(), 64, decoded.data(), decoded.size()));
+
+    // Smaller than one tile: nothing cooked, nothing left behind
+    std::error_code ec;
+    std::filesystem::remove(files.m_TDDS, ec);
+    REQUIRE(WriteFile(files.m_DDS, MakeDDS(256, 256, 3)));
+    CHECK(!CookTiledDDS(files.m_DDS, files.m_TDDS));
+    CHECK(!std::filesystem::exists(files.m_TDDS));
+}
@@ -0,0 +1,328 @@
+#include "TestFramework.h"
+
+#include "VRAMBudget.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    constexpr uint64_t kMB     = 1024ull * 1024;
+    constexpr uint64_t kBudget = 1000 * kMB;
+
+    // A pool (texture tile heaps, streamed geometry LODs, BLAS LODs) that grows to
+    // its demand up to a cap.  Reclaim lowers the cap; like a deferred heap release,
+    // the memory only goes m_ReleaseLatency frames later.  Restore lifts the cap.
+    struct PoolModel
+    {
+        uint64_t m_Demand         = 0;
+        uint64_t m_Minimum        = 0;
+        uint32_t m_ReleaseLatency = 3;
+
+        uint64_t m_Current            = 0;
+        uint64_t m_Cap                = UINT64_MAX;
+        uint32_t m_FramesUntilRelease = 0;
+        uint32_t m_NumReclaims        = 0;
+        uint32_t m_NumRestores        = 0;
+
+        VRAMBudgetGovernor::SubsystemDesc GetDesc(const char* name, uint32_t priority)
+        {
+            VRAMBudgetGovernor::SubsystemDesc desc;
+            desc.m_Name = name;
+            desc.m_EvictionPriority = priority;
+            desc.m_Reclaim = [this](uint64_t bytes)
+            {
+                m_NumReclaims++;
+                const uint64_t held = std::min(m_Current, m_Cap);
+                m_Cap = std::max(m_Minimum, held - std::min(held, bytes));
+                m_FramesUntilRelease = m_ReleaseLatency;
+                return held - m_Cap;
+            };
+            desc.m_Restore = [this]()
+            {
+                m_NumRestores++;
+                m_Cap = UINT64_MAX;
+            };
+            return desc;
+        }
+
+        void Step()
+        {
+            const uint64_t target = std::max(m_Minimum, std::min(m_Demand, m_Cap));
+            if (target > m_Current)
+                m_Current = target;
+            else if (target < m_Current && (m_FramesUntilRelease == 0 || --m_FramesUntilRelease == 0))
+                m_Current = target;
+        }
+    };
+
+    // Asked bytes are recorded, nothing is given back until the next report
+    struct RecordingSubsystem
+    {
+        std::vector<uint64_t> m_Requests;
+        uint64_t              m_PromiseLimit = UINT64_MAX;
+        uint32_t              m_NumRestores  = 0;
+
+        VRAMBudgetGovernor::SubsystemDesc GetDesc(const char* name, uint32_t priority)
+        {
+            VRAMBudgetGovernor::SubsystemDesc desc;
+            desc.m_Name = name;
+            desc.m_EvictionPriority = priority;
+            desc.m_Reclaim = [this](uint64_t bytes)
+            {
+                m_Requests.push_back(bytes);
+                return std::min(bytes, m_PromiseLimit);
+            };
+            desc.m_Restore = [this]() { m_NumRestores++; };
+            return desc;
+        }
+    };
+} // namespace
+
+TEST_CASE(VRAMBudget, NothingIsReclaimedBelowTheHighWatermark)
+{
+    VRAMBudgetGovernor governor;
+    RecordingSubsystem textures;
+    const auto id = governor.Register(textures.GetDesc("Textures", 0));
+
+    // No budget known yet: no policy, unlimited headroom
+    governor.ReportFootprint(id, 2 * kBudget, 0);
+    CHECK(governor.Update() == 0);
+    CHECK(governor.GetHeadroomBytes() == UINT64_MAX);
+
+    governor.SetBudget(kBudget);
+    governor.ReportFootprint(id, 900 * kMB, 0);
+    governor.ReportUntrackedBytes(40 * kMB);
+    CHECK(governor.Update() == 0);
+    CHECK(textures.m_Requests.empty());
+    CHECK(!governor.IsUnderPressure());
+    CHECK(governor.GetTotalBytes() == 940 * kMB);
+    CHECK(governor.GetHeadroomBytes() == (uint64_t)(kBudget * (double)VRAMBudgetGovernor::kHighWatermark) - 940 * kMB);
+}
+
+TEST_CASE(VRAMBudget, OverageIsReclaimedCheapestFirstDownToTheLowWatermark)
+{
+    VRAMBudgetGovernor governor;
+    governor.SetBudget(kBudget);
+    const uint64_t lowWatermark = (uint64_t)(kBudget * (double)VRAMBudgetGovernor::kLowWatermark);
+
+    RecordingSubsystem blas, textures, geometry;
+    const auto blasID     = governor.Register(blas.GetDesc("BLAS", 10));
+    const auto texturesID = governor.Register(textures.GetDesc("Textures", 0));
+    const auto geometryID = governor.Register(geometry.GetDesc("Geometry", 5));
+    const auto sceneID    = governor.Register({ .m_Name = "SceneBuffers", .m_EvictionPriority = 100 });
+
+    // 1100 MB: 250 MB over the low watermark; textures can give 150 MB (floor 100),
+    // geometry promises at most 40 MB, BLAS the rest
+    geometry.m_PromiseLimit = 40 * kMB;
+    governor.ReportFootprint(texturesID, 250 * kMB, 100 * kMB);
+    governor.ReportFootprint(geometryID, 150 * kMB, 0);
+    governor.ReportFootprint(blasID, 300 * kMB, 200 * kMB);
+    governor.ReportFootprint(sceneID, 400 * kMB, 400 * kMB);
+
+    CHECK(governor.Update() == 1100 * kMB - lowWatermark);
+    CHECK(governor.IsUnderPressure());
+    REQUIRE(textures.m_Requests.size() == 1 && geometry.m_Requests.size() == 1 && blas.m_Requests.size() == 1);
+    CHECK(textures.m_Requests[0] == 150 * kMB);
+    CHECK(geometry.m_Requests[0] == 1100 * kMB - lowWatermark - 150 * kMB);
+    CHECK(blas.m_Requests[0] == 1100 * kMB - lowWatermark - 190 * kMB);
+    CHECK(governor.GetTotalBytes() == lowWatermark);
+
+    CHECK(governor.GetSubsystemStats(texturesID).m_bDegraded && governor.GetSubsystemStats(blasID).m_bDegraded);
+    CHECK(governor.GetSubsystemStats(geometryID).m_ReclaimedBytes == 40 * kMB);
+    CHECK(!governor.GetSubsystemStats(sceneID).m_bDegraded);
+}
+
+TEST_CASE(VRAMBudget, PromisesAreNotRequestedAgainUntilTheySettle)
+{
+    VRAMBudgetGovernor governor;
+    governor.SetBudget(kBudget);
+    RecordingSubsystem textures;
+    const auto id = governor.Register(textures.GetDesc("Textures", 0));
+
+    governor.ReportFootprint(id, 1000 * kMB, 0);
+    const uint64_t requested = governor.Update();
+    REQUIRE(textures.m_Requests.size() == 1);
+
+    // The heaps are released a few frames later: the promise holds until then
+    for (uint32_t frame = 1; frame < VRAMBudgetGovernor::kReclaimSettleFrames; ++frame)
+    {
+        governor.ReportFootprint(id, 1000 * kMB, 0);
+        governor.Update();
+    }
+    CHECK(textures.m_Requests.size() == 1);
+
+    // A promise that never shows expires and is asked for again
+    governor.ReportFootprint(id, 1000 * kMB, 0);
+    CHECK(governor.Update() == requested);
+    CHECK(textures.m_Requests.size() == 2);
+
+    // A release that does show settles the promise
+    governor.ReportFootprint(id, 1000 * kMB - requested, 0);
+    CHECK(governor.GetTotalBytes() == 1000 * kMB - requested);
+    for (uint32_t frame = 0; frame < 2 * VRAMBudgetGovernor::kReclaimSettleFrames; ++frame)
+    {
+        governor.ReportFootprint(id, 1000 * kMB - requested, 0);
+        CHECK(governor.Update() == 0);
+    }
+    CHECK(textures.m_Requests.size() == 2);
+}
+
+TEST_CASE(VRAMBudget, FloorsAndTrackedSubsystemsAreNeverAsked)
+{
+    VRAMBudgetGovernor governor;
+    governor.SetBudget(kBudget);
+    RecordingSubsystem textures;
+    const auto texturesID    = governor.Register(textures.GetDesc("Textures", 0));
+    const auto renderGraphID = governor.Register({ .m_Name = "RenderGraph", .m_EvictionPriority = 100 });
+
+    governor.ReportFootprint(texturesID, 300 * kMB, 300 * kMB);
+    governor.ReportFootprint(renderGraphID, 900 * kMB, 900 * kMB);
+    CHECK(governor.Update() == 0);
+    CHECK(textures.m_Requests.empty());
+    CHECK(governor.IsUnderPressure());
+    CHECK(governor.GetHeadroomBytes() == 0);
+
+    // A minimum above the footprint is clamped to it
+    governor.ReportFootprint(texturesID, 100 * kMB, 300 * kMB);
+    CHECK(governor.GetSubsystemStats(texturesID).m_MinimumBytes == 100 * kMB);
+
+    // Unregistered subsystems drop out of the total and are not asked either
+    governor.Unregister(texturesID);
+    governor.ReportFootprint(renderGraphID, 1200 * kMB, 0);
+    CHECK(governor.GetTotalBytes() == 1200 * kMB);
+    governor.Update();
+    CHECK(textures.m_Requests.empty());
+}
+
+TEST_CASE(VRAMBudget, RestoresOneAtATimeAfterAQuietPeriod)
+{
+    VRAMBudgetGovernor governor;
+    governor.SetBudget(kBudget);
+    RecordingSubsystem textures, blas;
+    const auto texturesID = governor.Register(textures.GetDesc("Textures", 0));
+    const auto blasID     = governor.Register(blas.GetDesc("BLAS", 10));
+
+    governor.ReportFootprint(texturesID, 600 * kMB, 500 * kMB);
+    governor.ReportFootprint(blasID, 400 * kMB, 0);
+    governor.Update();
+    CHECK(governor.GetSubsystemStats(texturesID).m_bDegraded && governor.GetSubsystemStats(blasID).m_bDegraded);
+
+    auto runFrames = [&](uint32_t numFrames, uint64_t blasBytes)
+    {
+        for (uint32_t frame = 0; frame < numFrames; ++frame)
+        {
+            governor.ReportFootprint(texturesID, 500 * kMB, 500 * kMB);
+            governor.ReportFootprint(blasID, blasBytes, 0);
+            governor.Update();
+        }
+    };
+
+    // Between the restore and low watermarks: the hysteresis band, nothing moves
+    runFrames(4 * VRAMBudgetGovernor::kRestoreDelayFrames, 250 * kMB);
+    CHECK(textures.m_NumRestores == 0 && blas.m_NumRestores == 0);
+    CHECK(!governor.IsUnderPressure());
+
+    // Below it: the last to be degraded comes back first, the next one a full delay later
+    runFrames(VRAMBudgetGovernor::kRestoreDelayFrames - 1, 100 * kMB);
+    CHECK(blas.m_NumRestores == 0);
+    runFrames(1, 100 * kMB);
+    CHECK(blas.m_NumRestores == 1 && textures.m_NumRestores == 0);
+    CHECK(!governor.GetSubsystemStats(blasID).m_bDegraded && governor.GetSubsystemStats(blasID).m_ReclaimedBytes == 0);
+
+    runFrames(VRAMBudgetGovernor::kRestoreDelayFrames - 1, 100 * kMB);
+    CHECK(textures.m_NumRestores == 0);
+    runFrames(1, 100 * kMB);
+    CHECK(textures.m_NumRestores == 1 && blas.m_NumRestores == 1);
+
+    // Nothing left degraded
+    runFrames(4 * VRAMBudgetGovernor::kRestoreDelayFrames, 100 * kMB);
+    CHECK(textures.m_NumRestores == 1 && blas.m_NumRestores == 1);
+}
+
+TEST_CASE(VRAMBudget, SyntheticPressureScenario)
+{
+    // Texture tiles, streamed geometry LODs and BLAS LODs against fixed render graph
+    // heaps, with deferred releases.  Frame 100: the texture demand spikes.  Frame 600:
+    // the driver budget shrinks.  Frame 900: the budget comes back, the demand falls
+    // and the render graph shrinks (resolution change).
+    VRAMBudgetGovernor governor;
+    PoolModel textures{ 250 * kMB, 200 * kMB };
+    PoolModel geometry{ 150 * kMB, 0 };
+    PoolModel blas{ 200 * kMB, 100 * kMB };
+    uint64_t renderGraphBytes = 250 * kMB;
+
+    const auto texturesID    = governor.Register(textures.GetDesc("Textures", 0));
+    const auto geometryID    = governor.Register(geometry.GetDesc("Geometry", 5));
+    const auto blasID        = governor.Register(blas.GetDesc("BLAS", 10));
+    const auto renderGraphID = governor.Register({ .m_Name = "RenderGraph", .m_EvictionPriority = 100 });
+    governor.ReportUntrackedBytes(90 * kMB);
+
+    uint64_t budget = kBudget;
+    uint32_t numFramesOverBudget = 0;
+    uint32_t numPressureChanges = 0;
+    bool     bUnderPressure = false;
+    uint64_t peakDuringShrink = 0;
+
+    for (uint32_t frame = 0; frame < 2000; ++frame)
+    {
+        if (frame == 100)
+            textures.m_Demand = 700 * kMB;
+        if (frame == 600)
+            budget = 700 * kMB;
+        if (frame == 900)
+        {
+            budget = kBudget;
+            textures.m_Demand = 250 * kMB;
+            geometry.m_Demand = 50 * kMB;
+            renderGraphBytes = 100 * kMB;
+        }
+
+        textures.Step();
+        geometry.Step();
+        blas.Step();
+
+        governor.SetBudget(budget);
+        governor.ReportFootprint(texturesID, textures.m_Current, textures.m_Minimum);
+        governor.ReportFootprint(geometryID, geometry.m_Current, geometry.m_Minimum);
+        governor.ReportFootprint(blasID, blas.m_Current, blas.m_Minimum);
+        governor.ReportFootprint(renderGraphID, renderGraphBytes, renderGraphBytes);
+        governor.Update();
+
+        const uint64_t total = textures.m_Current + geometry.m_Current + blas.m_Current + renderGraphBytes + 90 * kMB;
+        if (total > budget)
+            numFramesOverBudget++;
+        if (frame >= 600 + 2 * VRAMBudgetGovernor::kReclaimSettleFrames && frame < 900)
+            peakDuringShrink = std::max(peakDuringShrink, total);
+        if (governor.IsUnderPressure() != bUnderPressure)
+        {
+            bUnderPressure = governor.IsUnderPressure();
+            numPressureChanges++;
+        }
+
+        // The spike is absorbed by the textures down to their floor, then by geometry
+        if (frame == 500)
+        {
+            CHECK(textures.m_Current == 200 * kMB && geometry.m_Current / kMB == 110 && blas.m_Current == 200 * kMB);
+            CHECK(blas.m_NumReclaims == 0);
+        }
+        // The smaller budget takes the rest of the geometry and BLAS down to its floor
+        if (frame == 899)
+            CHECK(geometry.m_Current == 0 && blas.m_Current == 100 * kMB);
+    }
+
+    std::printf("  %u frames over budget, %u pressure changes, %.0f MB peak under the shrunk budget\n",
+                numFramesOverBudget, numPressureChanges, peakDuringShrink / (double)kMB);
+
+    // Each event is over budget only until its deferred release lands
+    CHECK(numFramesOverBudget <= 2 * (textures.m_ReleaseLatency + 1));
+    CHECK(peakDuringShrink <= 700 * kMB);
+    // One pressure episode per event; restores never re-trigger it
+    CHECK(numPressureChanges == 4);
+    CHECK(!governor.IsUnderPressure());
+
+    // Everything restored once the demand fell, in one pass
+    CHECK(textures.m_NumRestores == 1 && geometry.m_NumRestores == 1 && blas.m_NumRestores == 1);
+    CHECK(textures.m_Current == 250 * kMB && geometry.m_Current == 50 * kMB && blas.m_Current == 200 * kMB);
+    CHECK(!governor.GetSubsystemStats(texturesID).m_bDegraded && !governor.GetSubsystemStats(blasID).m_bDegraded);
+}